@@ -21,11 +21,13 @@
  */
 
 #include <float.h>
+#include <string.h>
 #include <assert.h>
 
 #include "api/search_parameters.h"
 #include "solvers/funs/fun_solver.h"
 #include "solvers/simplex/simplex.h"
+#include "utils/hash_functions.h"
 #include "utils/string_utils.h"
 
 
@@ -66,12 +68,19 @@
  * - VAR_RANDOM_FACTOR = 0.02
  * - CLAUSE_DECAY_FACTOR = 0.999
  * - clause caching is disabled
+ * - chronological backtracking is disabled
+ * - local search for initial phases is disabled
+ * - Boolean preprocessing is disabled
  */
 #define DEFAULT_VAR_DECAY      VAR_DECAY_FACTOR
 #define DEFAULT_RANDOMNESS     VAR_RANDOM_FACTOR
 #define DEFAULT_CLAUSE_DECAY   CLAUSE_DECAY_FACTOR
 #define DEFAULT_CACHE_TCLAUSES false
 #define DEFAULT_TCLAUSE_SIZE   0
+#define DEFAULT_CHRONO_BACKTRACK false
+#define DEFAULT_CHRONO_THRESHOLD 100
+#define DEFAULT_SLS_FLIPS 0
+#define DEFAULT_BOOL_PREPROCESS false
 
 
 /*
@@ -122,6 +131,12 @@
  */
 
 
+/*
+ * No memory limit by default
+ */
+#define DEFAULT_MEMORY_LIMIT 0
+
+
 /*
  * All default parameters
  */
@@ -143,6 +158,10 @@ static const param_t default_settings = {
   DEFAULT_CLAUSE_DECAY,
   DEFAULT_CACHE_TCLAUSES,
   DEFAULT_TCLAUSE_SIZE,
+  DEFAULT_CHRONO_BACKTRACK,
+  DEFAULT_CHRONO_THRESHOLD,
+  DEFAULT_SLS_FLIPS,
+  DEFAULT_BOOL_PREPROCESS,
 
   DEFAULT_USE_DYN_ACK,
   DEFAULT_USE_BOOL_DYN_ACK,
@@ -164,6 +183,8 @@ static const param_t default_settings = {
 
   DEFAULT_MAX_UPDATE_CONFLICTS,
   DEFAULT_MAX_EXTENSIONALITY,
+
+  DEFAULT_MEMORY_LIMIT,
 };
 
 
@@ -199,6 +220,13 @@ typedef enum param_key {
   PARAM_CLAUSE_DECAY,
   PARAM_CACHE_TCLAUSES,
   PARAM_TCLAUSE_SIZE,
+  // chronological backtracking
+  PARAM_CHRONO_BACKTRACK,
+  PARAM_CHRONO_THRESHOLD,
+  // local search
+  PARAM_SLS_FLIPS,
+  // clause preprocessing
+  PARAM_BOOL_PREPROCESS,
   // egraph parameters
   PARAM_DYN_ACK,
   PARAM_DYN_BOOL_ACK,
@@ -220,19 +248,24 @@ typedef enum param_key {
   // array solver
   PARAM_MAX_UPDATE_CONFLICTS,
   PARAM_MAX_EXTENSIONALITY,
+  // resource limits
+  PARAM_MEMORY_LIMIT,
 } param_key_t;
 
-#define NUM_PARAM_KEYS (PARAM_MAX_EXTENSIONALITY+1)
+#define NUM_PARAM_KEYS (PARAM_MEMORY_LIMIT+1)
 
 // parameter names in lexicographic ordering
 static const char *const param_key_names[NUM_PARAM_KEYS] = {
   "aux-eq-quota",
   "aux-eq-ratio",
   "bland-threshold",
+  "bool-preprocess",
   "branching",
   "c-factor",
   "c-threshold",
   "cache-tclauses",
+  "chrono-backtrack",
+  "chrono-threshold",
   "clause-decay",
   "d-factor",
   "d-threshold",
@@ -248,6 +281,7 @@ static const char *const param_key_names[NUM_PARAM_KEYS] = {
   "max-extensionality",
   "max-interface-eqs",
   "max-update-conflicts",
+  "memory-limit",
   "optimistic-final-check",
   "prop-threshold",
   "r-factor",
@@ -257,6 +291,7 @@ static const char *const param_key_names[NUM_PARAM_KEYS] = {
   "randomness",
   "simplex-adjust",
   "simplex-prop",
+  "sls-flips",
   "tclause-size",
   "var-decay",
 };
@@ -266,10 +301,13 @@ static const int32_t param_code[NUM_PARAM_KEYS] = {
   PARAM_AUX_EQ_QUOTA,
   PARAM_AUX_EQ_RATIO,
   PARAM_BLAND_THRESHOLD,
+  PARAM_BOOL_PREPROCESS,
   PARAM_BRANCHING,
   PARAM_C_FACTOR,
   PARAM_C_THRESHOLD,
   PARAM_CACHE_TCLAUSES,
+  PARAM_CHRONO_BACKTRACK,
+  PARAM_CHRONO_THRESHOLD,
   PARAM_CLAUSE_DECAY,
   PARAM_D_FACTOR,
   PARAM_D_THRESHOLD,
@@ -285,6 +323,7 @@ static const int32_t param_code[NUM_PARAM_KEYS] = {
   PARAM_MAX_EXTENSIONALITY,
   PARAM_MAX_INTERFACE_EQS,
   PARAM_MAX_UPDATE_CONFLICTS,
+  PARAM_MEMORY_LIMIT,
   PARAM_OPTIMISTIC_FCHECK,
   PARAM_PROP_THRESHOLD,
   PARAM_R_FACTOR,
@@ -294,6 +333,7 @@ static const int32_t param_code[NUM_PARAM_KEYS] = {
   PARAM_RANDOMNESS,
   PARAM_SIMPLEX_ADJUST,
   PARAM_SIMPLEX_PROP,
+  PARAM_SLS_FLIPS,
   PARAM_TCLAUSE_SIZE,
   PARAM_VAR_DECAY,
 };
@@ -574,6 +614,28 @@ int32_t params_set_field(param_t *parameters, const char *key, const char *value
     }
     break;
 
+  case PARAM_CHRONO_BACKTRACK:
+    r = set_bool_param(value, &parameters->chrono_backtrack);
+    break;
+
+  case PARAM_CHRONO_THRESHOLD:
+    r = set_int32_param(value, &z, 0, INT32_MAX);
+    if (r == 0) {
+      parameters->chrono_threshold = (uint32_t) z;
+    }
+    break;
+
+  case PARAM_SLS_FLIPS:
+    r = set_int32_param(value, &z, 0, INT32_MAX);
+    if (r == 0) {
+      parameters->sls_flips = (uint32_t) z;
+    }
+    break;
+
+  case PARAM_BOOL_PREPROCESS:
+    r = set_bool_param(value, &parameters->bool_preprocess);
+    break;
+
   case PARAM_DYN_ACK:
     r = set_bool_param(value, &parameters->use_dyn_ack);
     break;
@@ -684,6 +746,13 @@ int32_t params_set_field(param_t *parameters, const char *key, const char *value
     }
     break;
 
+  case PARAM_MEMORY_LIMIT:
+    r = set_int32_param(value, &z, 0, INT32_MAX);
+    if (r == 0) {
+      parameters->memory_limit = (uint32_t) z;
+    }
+    break;
+
   default:
     assert(k == -1);
     r = -1;
@@ -701,3 +770,65 @@ int32_t params_set_field(param_t *parameters, const char *key, const char *value
 uint32_t params_default_random_seed(void) {
   return DEFAULT_RANDOM_SEED;
 }
+
+
+/*
+ * Digest: we hash the fields one by one so that padding is ignored
+ */
+static uint32_t mix_uint(uint32_t h, uint32_t x) {
+  return jenkins_hash_pair(x, 0, h);
+}
+
+static uint32_t mix_double(uint32_t h, double x) {
+  uint64_t b;
+
+  memcpy(&b, &x, sizeof(b));
+  return jenkins_hash_pair((uint32_t) b, (uint32_t) (b >> 32), h);
+}
+
+uint32_t params_digest(const param_t *parameters) {
+  uint32_t h;
+
+  h = 0x1fa2b3c4;
+  h = mix_uint(h, parameters->fast_restart);
+  h = mix_uint(h, parameters->c_threshold);
+  h = mix_uint(h, parameters->d_threshold);
+  h = mix_double(h, parameters->c_factor);
+  h = mix_double(h, parameters->d_factor);
+  h = mix_uint(h, parameters->r_threshold);
+  h = mix_double(h, parameters->r_fraction);
+  h = mix_double(h, parameters->r_factor);
+  h = mix_double(h, parameters->var_decay);
+  h = mix_double(h, parameters->randomness);
+  h = mix_uint(h, parameters->random_seed);
+  h = mix_uint(h, parameters->branching);
+  h = mix_double(h, parameters->clause_decay);
+  h = mix_uint(h, parameters->cache_tclauses);
+  h = mix_uint(h, parameters->tclause_size);
+  h = mix_uint(h, parameters->chrono_backtrack);
+  h = mix_uint(h, parameters->chrono_threshold);
+  h = mix_uint(h, parameters->sls_flips);
+  h = mix_uint(h, parameters->bool_preprocess);
+  h = mix_uint(h, parameters->use_dyn_ack);
+  h = mix_uint(h, parameters->use_bool_dyn_ack);
+  h = mix_uint(h, parameters->use_optimistic_fcheck);
+  h = mix_uint(h, parameters->max_ackermann);
+  h = mix_uint(h, parameters->max_boolackermann);
+  h = mix_uint(h, parameters->aux_eq_quota);
+  h = mix_double(h, parameters->aux_eq_ratio);
+  h = mix_uint(h, parameters->dyn_ack_threshold);
+  h = mix_uint(h, parameters->dyn_bool_ack_threshold);
+  h = mix_uint(h, parameters->max_interface_eqs);
+  h = mix_uint(h, parameters->use_simplex_prop);
+  h = mix_uint(h, parameters->adjust_simplex_model);
+  h = mix_uint(h, parameters->integer_check);
+  h = mix_uint(h, parameters->max_prop_row_size);
+  h = mix_uint(h, parameters->bland_threshold);
+  h = mix_uint(h, parameters->integer_check_period);
+  h = mix_uint(h, parameters->max_update_conflicts);
+  h = mix_uint(h, parameters->max_extensionality);
+  // memory_limit is not included: it doesn't change the result of a
+  // search that completes
+
+  return h;
+}
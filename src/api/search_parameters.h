@@ -95,6 +95,24 @@ struct param_s {
    *   in a conflict resolution
    * - parameter tclause_size controls the lemma size: only theory lemmas
    *   of size <= tclause_size are turned into learned clauses
+   *
+   * SMT Core chronological backtracking:
+   * - if chrono_backtrack is true, then the core backtracks by one level
+   *   after a conflict (instead of backjumping to the learned clause's
+   *   assertion level) if the backjump would skip more than
+   *   chrono_threshold decision levels.
+   *
+   * SMT Core local search:
+   * - if sls_flips is positive, then a ProbSAT-style local search is run
+   *   on the clauses before the search starts. Its best assignment
+   *   is used as the initial polarity of the boolean variables.
+   *   sls_flips bounds the number of flips in the local search.
+   *
+   * SMT Core preprocessing:
+   * - if bool_preprocess is true, then the clauses are simplified before
+   *   the first search (subsumption, equivalent literals, and bounded
+   *   variable elimination). This is done only in contexts that don't
+   *   support push/pop and don't include a bitvector solver.
    */
   double   var_decay;       // decay factor for variable activity
   float    randomness;      // probability of a random pick in select_unassigned_literal
@@ -103,6 +121,10 @@ struct param_s {
   float    clause_decay;    // decay factor for learned-clause activity
   bool     cache_tclauses;
   uint32_t tclause_size;
+  bool     chrono_backtrack;
+  uint32_t chrono_threshold;
+  uint32_t sls_flips;
+  bool     bool_preprocess;
 
   /*
    * EGRAPH PARAMETERS
@@ -170,6 +192,15 @@ struct param_s {
   uint32_t max_update_conflicts;
   uint32_t max_extensionality;
 
+  /*
+   * RESOURCE LIMITS
+   * - memory_limit: soft limit on the memory used by the context, in MB
+   *   (0 means no limit). If the estimated memory use exceeds this limit,
+   *   the search first tries to free memory (learned clauses and caches).
+   *   If that's not enough, it stops with status UNKNOWN.
+   */
+  uint32_t memory_limit;
+
 };
 
 
@@ -210,4 +241,11 @@ extern int32_t params_set_field(param_t *parameters, const char *key, const char
 extern uint32_t params_default_random_seed(void);
 
 
+/*
+ * Digest of all the fields in parameters: two records with the
+ * same settings have the same digest. The memory limit is ignored.
+ */
+extern uint32_t params_digest(const param_t *parameters);
+
+
 #endif /* __SEARCH_PARAMETERS_H */
@@ -67,6 +67,7 @@
 #include "api/yval.h"
 
 #include "context/context.h"
+#include "context/context_statistics.h"
 
 #include "frontend/yices/yices_parser.h"
 
@@ -3356,12 +3357,42 @@ EXPORTED term_t yices_power(term_t t1, uint32_t d) {
 }
 
 
+/*
+ * BULK CONSTRUCTION OF LARGE LINEAR SUMS
+ * - bulk_sum_applies(n, t) checks whether the sum of n terms t[0 ... n-1]
+ *   is large enough and linear
+ * - bulk_linear_sum(mono, n) builds the sum of the n monomials in mono,
+ *   then deletes mono (mono must be allocated with alloc_monarray)
+ */
+static bool bulk_sum_applies(uint32_t n, const term_t t[]) {
+  uint32_t i;
+
+  if (n < MIN_BULK_SUM_SIZE) return false;
+  for (i=0; i<n; i++) {
+    if (! arith_term_is_linear(&terms, t[i])) return false;
+  }
+  return true;
+}
+
+static term_t bulk_linear_sum(monomial_t *mono, uint32_t n) {
+  term_t s;
+
+  s = mk_arith_linear_sum(&manager, mono, n);
+  assert(s != NULL_TERM);
+  clear_monarray(mono, n);
+  safe_free(mono);
+
+  return s;
+}
+
+
 /*
  * Sum of n terms t[0] ... t[n-1]
  */
 EXPORTED term_t yices_sum(uint32_t n, const term_t t[]) {
   rba_buffer_t *b;
   term_table_t *tbl;
+  monomial_t *mono;
   uint32_t i;
 
   if (! check_good_terms(&manager, n, t) ||
@@ -3369,6 +3400,15 @@ EXPORTED term_t yices_sum(uint32_t n, const term_t t[]) {
     return NULL_TERM;
   }
 
+  if (bulk_sum_applies(n, t)) {
+    mono = alloc_monarray(n);
+    for (i=0; i<n; i++) {
+      mono[i].var = t[i];
+      q_set_one(&mono[i].coeff);
+    }
+    return bulk_linear_sum(mono, n);
+  }
+
   b = get_arith_buffer();
   tbl = &terms;
   reset_rba_buffer(b);
@@ -3533,6 +3573,7 @@ EXPORTED term_t yices_ceil(term_t t) {
 EXPORTED term_t yices_poly_int32(uint32_t n, const int32_t a[], const term_t t[]) {
   rba_buffer_t *b;
   term_table_t *tbl;
+  monomial_t *mono;
   uint32_t i;
 
   if (! check_good_terms(&manager, n, t) ||
@@ -3540,6 +3581,15 @@ EXPORTED term_t yices_poly_int32(uint32_t n, const int32_t a[], const term_t t[]
     return NULL_TERM;
   }
 
+  if (bulk_sum_applies(n, t)) {
+    mono = alloc_monarray(n);
+    for (i=0; i<n; i++) {
+      mono[i].var = t[i];
+      q_set32(&mono[i].coeff, a[i]);
+    }
+    return bulk_linear_sum(mono, n);
+  }
+
   b = get_arith_buffer();
   tbl = &terms;
   reset_rba_buffer(b);
@@ -3554,6 +3604,7 @@ EXPORTED term_t yices_poly_int32(uint32_t n, const int32_t a[], const term_t t[]
 EXPORTED term_t yices_poly_int64(uint32_t n, const int64_t a[], const term_t t[]) {
   rba_buffer_t *b;
   term_table_t *tbl;
+  monomial_t *mono;
   uint32_t i;
 
   if (! check_good_terms(&manager, n, t) ||
@@ -3561,6 +3612,15 @@ EXPORTED term_t yices_poly_int64(uint32_t n, const int64_t a[], const term_t t[]
     return NULL_TERM;
   }
 
+  if (bulk_sum_applies(n, t)) {
+    mono = alloc_monarray(n);
+    for (i=0; i<n; i++) {
+      mono[i].var = t[i];
+      q_set64(&mono[i].coeff, a[i]);
+    }
+    return bulk_linear_sum(mono, n);
+  }
+
   b = get_arith_buffer();
   tbl = &terms;
   reset_rba_buffer(b);
@@ -3585,6 +3645,7 @@ EXPORTED term_t yices_poly_int64(uint32_t n, const int64_t a[], const term_t t[]
 EXPORTED term_t yices_poly_rational32(uint32_t n, const int32_t num[], const uint32_t den[], const term_t t[]) {
   rba_buffer_t *b;
   term_table_t *tbl;
+  monomial_t *mono;
   uint32_t i;
 
   if (! check_good_terms(&manager, n, t) ||
@@ -3593,6 +3654,15 @@ EXPORTED term_t yices_poly_rational32(uint32_t n, const int32_t num[], const uin
     return NULL_TERM;
   }
 
+  if (bulk_sum_applies(n, t)) {
+    mono = alloc_monarray(n);
+    for (i=0; i<n; i++) {
+      mono[i].var = t[i];
+      q_set_int32(&mono[i].coeff, num[i], den[i]);
+    }
+    return bulk_linear_sum(mono, n);
+  }
+
   b = get_arith_buffer();
   tbl = &terms;
   reset_rba_buffer(b);
@@ -3607,6 +3677,7 @@ EXPORTED term_t yices_poly_rational32(uint32_t n, const int32_t num[], const uin
 EXPORTED term_t yices_poly_rational64(uint32_t n, const int64_t num[], const uint64_t den[], const term_t t[]) {
   rba_buffer_t *b;
   term_table_t *tbl;
+  monomial_t *mono;
   uint32_t i;
 
   if (! check_good_terms(&manager, n, t) ||
@@ -3615,6 +3686,15 @@ EXPORTED term_t yices_poly_rational64(uint32_t n, const int64_t num[], const uin
     return NULL_TERM;
   }
 
+  if (bulk_sum_applies(n, t)) {
+    mono = alloc_monarray(n);
+    for (i=0; i<n; i++) {
+      mono[i].var = t[i];
+      q_set_int64(&mono[i].coeff, num[i], den[i]);
+    }
+    return bulk_linear_sum(mono, n);
+  }
+
   b = get_arith_buffer();
   tbl = &terms;
   reset_rba_buffer(b);
@@ -3633,6 +3713,7 @@ EXPORTED term_t yices_poly_rational64(uint32_t n, const int64_t num[], const uin
 EXPORTED term_t yices_poly_mpz(uint32_t n, const mpz_t z[], const term_t t[]) {
   rba_buffer_t *b;
   term_table_t *tbl;
+  monomial_t *mono;
   uint32_t i;
 
   if (! check_good_terms(&manager, n, t) ||
@@ -3640,6 +3721,15 @@ EXPORTED term_t yices_poly_mpz(uint32_t n, const mpz_t z[], const term_t t[]) {
     return NULL_TERM;
   }
 
+  if (bulk_sum_applies(n, t)) {
+    mono = alloc_monarray(n);
+    for (i=0; i<n; i++) {
+      mono[i].var = t[i];
+      q_set_mpz(&mono[i].coeff, z[i]);
+    }
+    return bulk_linear_sum(mono, n);
+  }
+
   b = get_arith_buffer();
   tbl = &terms;
   reset_rba_buffer(b);
@@ -3657,6 +3747,7 @@ EXPORTED term_t yices_poly_mpz(uint32_t n, const mpz_t z[], const term_t t[]) {
 EXPORTED term_t yices_poly_mpq(uint32_t n, const mpq_t q[], const term_t t[]) {
   rba_buffer_t *b;
   term_table_t *tbl;
+  monomial_t *mono;
   uint32_t i;
 
   if (! check_good_terms(&manager, n, t) ||
@@ -3664,6 +3755,15 @@ EXPORTED term_t yices_poly_mpq(uint32_t n, const mpq_t q[], const term_t t[]) {
     return NULL_TERM;
   }
 
+  if (bulk_sum_applies(n, t)) {
+    mono = alloc_monarray(n);
+    for (i=0; i<n; i++) {
+      mono[i].var = t[i];
+      q_set_mpq(&mono[i].coeff, q[i]);
+    }
+    return bulk_linear_sum(mono, n);
+  }
+
   b = get_arith_buffer();
   tbl = &terms;
   reset_rba_buffer(b);
@@ -5338,6 +5438,291 @@ EXPORTED term_t yices_bvslt_atom(term_t t1, term_t t2) {
 
 
 
+
+/****************************
+ *  BULK TERM CONSTRUCTION  *
+ ***************************/
+
+/*
+ * Number of operands of op that are terms (the others are immediate)
+ * and constraints on the number of operands k:
+ * - the node is valid if min <= k <= max
+ */
+typedef struct opcode_arity_s {
+  uint32_t min;
+  uint32_t max;
+  bool immediate;
+} opcode_arity_t;
+
+static const opcode_arity_t opcode_arity[YICES_NUM_OPCODES] = {
+  { 1, 1, false },                  // YICES_OP_NOT
+  { 0, YICES_MAX_ARITY, false },    // YICES_OP_AND
+  { 0, YICES_MAX_ARITY, false },    // YICES_OP_OR
+  { 0, YICES_MAX_ARITY, false },    // YICES_OP_XOR
+  { 2, 2, false },                  // YICES_OP_IMPLIES
+  { 2, 2, false },                  // YICES_OP_IFF
+  { 3, 3, false },                  // YICES_OP_ITE
+  { 2, 2, false },                  // YICES_OP_EQ
+  { 2, 2, false },                  // YICES_OP_NEQ
+  { 1, YICES_MAX_ARITY, false },    // YICES_OP_DISTINCT
+  { 2, YICES_MAX_ARITY, false },    // YICES_OP_APP
+  { 1, 1, true },                   // YICES_OP_INT_CONST
+  { 1, YICES_MAX_ARITY, false },    // YICES_OP_ADD
+  { 2, 2, false },                  // YICES_OP_SUB
+  { 1, 1, false },                  // YICES_OP_NEG
+  { 1, YICES_MAX_ARITY, false },    // YICES_OP_MUL
+  { 2, 2, false },                  // YICES_OP_ARITH_GE
+  { 2, 2, false },                  // YICES_OP_ARITH_GT
+  { 2, 2, false },                  // YICES_OP_ARITH_LE
+  { 2, 2, false },                  // YICES_OP_ARITH_LT
+  { 3, 3, true },                   // YICES_OP_BV_CONST
+  { 1, YICES_MAX_ARITY, false },    // YICES_OP_BV_ADD
+  { 2, 2, false },                  // YICES_OP_BV_SUB
+  { 1, 1, false },                  // YICES_OP_BV_NEG
+  { 1, YICES_MAX_ARITY, false },    // YICES_OP_BV_MUL
+  { 1, 1, false },                  // YICES_OP_BV_NOT
+  { 1, YICES_MAX_ARITY, false },    // YICES_OP_BV_AND
+  { 1, YICES_MAX_ARITY, false },    // YICES_OP_BV_OR
+  { 1, YICES_MAX_ARITY, false },    // YICES_OP_BV_XOR
+  { 2, 2, false },                  // YICES_OP_BV_SHL
+  { 2, 2, false },                  // YICES_OP_BV_LSHR
+  { 2, 2, false },                  // YICES_OP_BV_ASHR
+  { 2, 2, false },                  // YICES_OP_BV_DIV
+  { 2, 2, false },                  // YICES_OP_BV_REM
+  { 1, YICES_MAX_ARITY, false },    // YICES_OP_BV_CONCAT
+  { 3, 3, true },                   // YICES_OP_BV_EXTRACT
+  { 2, 2, false },                  // YICES_OP_BV_GE
+  { 2, 2, false },                  // YICES_OP_BV_GT
+  { 2, 2, false },                  // YICES_OP_BV_LE
+  { 2, 2, false },                  // YICES_OP_BV_LT
+  { 2, 2, false },                  // YICES_OP_BV_SGE
+  { 2, 2, false },                  // YICES_OP_BV_SGT
+  { 2, 2, false },                  // YICES_OP_BV_SLE
+  { 2, 2, false },                  // YICES_OP_BV_SLT
+};
+
+
+/*
+ * Build the term for a node
+ * - op = opcode, x[0 ... k-1] = operands
+ * - a = array of k terms: a[i] = term for operand i (not used for
+ *   immediate operands)
+ */
+static term_t build_term_node(term_opcode_t op, uint32_t k, const int32_t *x, term_t *a) {
+  uint64_t c;
+
+  switch (op) {
+  case YICES_OP_NOT:
+    return yices_not(a[0]);
+
+  case YICES_OP_AND:
+    return yices_and(k, a);
+
+  case YICES_OP_OR:
+    return yices_or(k, a);
+
+  case YICES_OP_XOR:
+    return yices_xor(k, a);
+
+  case YICES_OP_IMPLIES:
+    return yices_implies(a[0], a[1]);
+
+  case YICES_OP_IFF:
+    return yices_iff(a[0], a[1]);
+
+  case YICES_OP_ITE:
+    return yices_ite(a[0], a[1], a[2]);
+
+  case YICES_OP_EQ:
+    return yices_eq(a[0], a[1]);
+
+  case YICES_OP_NEQ:
+    return yices_neq(a[0], a[1]);
+
+  case YICES_OP_DISTINCT:
+    return yices_distinct(k, a);
+
+  case YICES_OP_APP:
+    return yices_application(a[0], k - 1, a + 1);
+
+  case YICES_OP_INT_CONST:
+    return yices_int32(x[0]);
+
+  case YICES_OP_ADD:
+    return yices_sum(k, a);
+
+  case YICES_OP_SUB:
+    return yices_sub(a[0], a[1]);
+
+  case YICES_OP_NEG:
+    return yices_neg(a[0]);
+
+  case YICES_OP_MUL:
+    return yices_product(k, a);
+
+  case YICES_OP_ARITH_GE:
+    return yices_arith_geq_atom(a[0], a[1]);
+
+  case YICES_OP_ARITH_GT:
+    return yices_arith_gt_atom(a[0], a[1]);
+
+  case YICES_OP_ARITH_LE:
+    return yices_arith_leq_atom(a[0], a[1]);
+
+  case YICES_OP_ARITH_LT:
+    return yices_arith_lt_atom(a[0], a[1]);
+
+  case YICES_OP_BV_CONST:
+    c = (((uint64_t) (uint32_t) x[2]) << 32) | ((uint64_t) (uint32_t) x[1]);
+    return yices_bvconst_uint64((uint32_t) x[0], c);
+
+  case YICES_OP_BV_ADD:
+    return yices_bvsum(k, a);
+
+  case YICES_OP_BV_SUB:
+    return yices_bvsub(a[0], a[1]);
+
+  case YICES_OP_BV_NEG:
+    return yices_bvneg(a[0]);
+
+  case YICES_OP_BV_MUL:
+    return yices_bvproduct(k, a);
+
+  case YICES_OP_BV_NOT:
+    return yices_bvnot(a[0]);
+
+  case YICES_OP_BV_AND:
+    return yices_bvand(k, a);
+
+  case YICES_OP_BV_OR:
+    return yices_bvor(k, a);
+
+  case YICES_OP_BV_XOR:
+    return yices_bvxor(k, a);
+
+  case YICES_OP_BV_SHL:
+    return yices_bvshl(a[0], a[1]);
+
+  case YICES_OP_BV_LSHR:
+    return yices_bvlshr(a[0], a[1]);
+
+  case YICES_OP_BV_ASHR:
+    return yices_bvashr(a[0], a[1]);
+
+  case YICES_OP_BV_DIV:
+    return yices_bvdiv(a[0], a[1]);
+
+  case YICES_OP_BV_REM:
+    return yices_bvrem(a[0], a[1]);
+
+  case YICES_OP_BV_CONCAT:
+    return yices_bvconcat(k, a);
+
+  case YICES_OP_BV_EXTRACT:
+    return yices_bvextract(a[0], (uint32_t) x[1], (uint32_t) x[2]);
+
+  case YICES_OP_BV_GE:
+    return yices_bvge_atom(a[0], a[1]);
+
+  case YICES_OP_BV_GT:
+    return yices_bvgt_atom(a[0], a[1]);
+
+  case YICES_OP_BV_LE:
+    return yices_bvle_atom(a[0], a[1]);
+
+  case YICES_OP_BV_LT:
+    return yices_bvlt_atom(a[0], a[1]);
+
+  case YICES_OP_BV_SGE:
+    return yices_bvsge_atom(a[0], a[1]);
+
+  case YICES_OP_BV_SGT:
+    return yices_bvsgt_atom(a[0], a[1]);
+
+  case YICES_OP_BV_SLE:
+    return yices_bvsle_atom(a[0], a[1]);
+
+  case YICES_OP_BV_SLT:
+    return yices_bvslt_atom(a[0], a[1]);
+  }
+
+  assert(false);
+  return NULL_TERM;
+}
+
+
+/*
+ * Build the terms described by buffer[0 ... size-1]
+ * - store the term for node i in t[i]
+ * - return the number of nodes or -1 if there's an error
+ */
+EXPORTED int32_t yices_build_terms(uint32_t size, const int32_t buffer[], uint32_t n, term_t t[]) {
+  ivector_t args;
+  const int32_t *x;
+  int32_t op, r;
+  uint32_t i, j, k, nterms, nodes;
+  term_t u;
+
+  init_ivector(&args, 10);
+
+  nodes = 0;
+  i = 0;
+  while (i < size) {
+    // node: op, k, x[0 ... k-1]
+    if (nodes >= n || size - i < 2) {
+      error.code = INVALID_TERM_OP;
+      goto error;
+    }
+    op = buffer[i];
+    if (op < 0 || op >= YICES_NUM_OPCODES || buffer[i+1] < 0 || (uint32_t) buffer[i+1] > size - i - 2) {
+      error.code = INVALID_TERM_OP;
+      goto error;
+    }
+    k = buffer[i+1];
+    x = buffer + i + 2;
+    if (k < opcode_arity[op].min || k > opcode_arity[op].max) {
+      error.code = WRONG_NUMBER_OF_ARGUMENTS;
+      goto error;
+    }
+
+    // operands that are terms (for extract, only x[0])
+    nterms = k;
+    if (opcode_arity[op].immediate) {
+      nterms = (op == YICES_OP_BV_EXTRACT) ? 1 : 0;
+    }
+    ivector_reset(&args);
+    for (j=0; j<nterms; j++) {
+      r = x[j];
+      if (r < 0) {
+        // reference to node -r-1
+        if (-(r+1) >= (int32_t) nodes) {
+          error.code = INVALID_TERM;
+          error.term1 = r;
+          goto error;
+        }
+        r = t[-(r+1)];
+      }
+      ivector_push(&args, r);
+    }
+
+    u = build_term_node(op, k, x, args.data);
+    if (u == NULL_TERM) goto error;
+
+    t[nodes] = u;
+    nodes ++;
+    i += k + 2;
+  }
+
+  delete_ivector(&args);
+  return nodes;
+
+ error:
+  delete_ivector(&args);
+  return -1;
+}
+
+
+
 /*********************
  *  PRETTY PRINTING  *
  ********************/
@@ -6811,15 +7196,18 @@ typedef enum ctx_option {
   CTX_OPTION_VAR_ELIM,
   CTX_OPTION_ARITH_ELIM,
   CTX_OPTION_BVARITH_ELIM,
+  CTX_OPTION_BV_KNOWN_BITS,
   CTX_OPTION_FLATTEN,
   CTX_OPTION_LEARN_EQ,
   CTX_OPTION_BREAK_SYMMETRIES,
   CTX_OPTION_KEEP_ITE,
   CTX_OPTION_EAGER_ARITH_LEMMAS,
   CTX_OPTION_ASSERT_ITE_BOUNDS,
+  CTX_OPTION_QUERY_CACHE,
+  CTX_OPTION_ASSERTION_LOG,
 } ctx_option_t;
 
-#define NUM_CTX_OPTIONS (CTX_OPTION_ASSERT_ITE_BOUNDS+1)
+#define NUM_CTX_OPTIONS (CTX_OPTION_ASSERTION_LOG+1)
 
 
 /*
@@ -6828,12 +7216,15 @@ typedef enum ctx_option {
 static const char * const ctx_option_names[NUM_CTX_OPTIONS] = {
   "arith-elim",
   "assert-ite-bounds",
+  "assertion-log",
   "break-symmetries",
+  "bv-known-bits",
   "bvarith-elim",
   "eager-arith-lemmas",
   "flatten",
   "keep-ite",
   "learn-eq",
+  "query-cache",
   "var-elim",
 };
 
@@ -6844,12 +7235,15 @@ static const char * const ctx_option_names[NUM_CTX_OPTIONS] = {
 static const int32_t ctx_option_key[NUM_CTX_OPTIONS] = {
   CTX_OPTION_ARITH_ELIM,
   CTX_OPTION_ASSERT_ITE_BOUNDS,
+  CTX_OPTION_ASSERTION_LOG,
   CTX_OPTION_BREAK_SYMMETRIES,
+  CTX_OPTION_BV_KNOWN_BITS,
   CTX_OPTION_BVARITH_ELIM,
   CTX_OPTION_EAGER_ARITH_LEMMAS,
   CTX_OPTION_FLATTEN,
   CTX_OPTION_KEEP_ITE,
   CTX_OPTION_LEARN_EQ,
+  CTX_OPTION_QUERY_CACHE,
   CTX_OPTION_VAR_ELIM,
 };
 
@@ -6875,6 +7269,10 @@ EXPORTED int32_t yices_context_enable_option(context_t *ctx, const char *option)
     enable_bvarith_elimination(ctx);
     break;
 
+  case CTX_OPTION_BV_KNOWN_BITS:
+    enable_bv_known_bits(ctx);
+    break;
+
   case CTX_OPTION_FLATTEN:
     enable_diseq_and_or_flattening(ctx);
     break;
@@ -6899,6 +7297,14 @@ EXPORTED int32_t yices_context_enable_option(context_t *ctx, const char *option)
     enable_assert_ite_bounds(ctx);
     break;
 
+  case CTX_OPTION_QUERY_CACHE:
+    context_enable_query_cache(ctx);
+    break;
+
+  case CTX_OPTION_ASSERTION_LOG:
+    enable_assertion_log(ctx);
+    break;
+
   default:
     assert(k == -1);
     // not recognized
@@ -6932,6 +7338,10 @@ EXPORTED int32_t yices_context_disable_option(context_t *ctx, const char *option
     disable_bvarith_elimination(ctx);
     break;
 
+  case CTX_OPTION_BV_KNOWN_BITS:
+    disable_bv_known_bits(ctx);
+    break;
+
   case CTX_OPTION_FLATTEN:
     disable_diseq_and_or_flattening(ctx);
     break;
@@ -6956,6 +7366,14 @@ EXPORTED int32_t yices_context_disable_option(context_t *ctx, const char *option
     disable_assert_ite_bounds(ctx);
     break;
 
+  case CTX_OPTION_QUERY_CACHE:
+    context_disable_query_cache(ctx);
+    break;
+
+  case CTX_OPTION_ASSERTION_LOG:
+    disable_assertion_log(ctx);
+    break;
+
   default:
     assert(k == -1);
     // not recognized
@@ -7013,6 +7431,87 @@ EXPORTED int32_t yices_set_param(param_t *param, const char *name, const char *v
 
 
 
+/****************
+ *  STATISTICS  *
+ ***************/
+
+/*
+ * Get the value of a statistic
+ */
+EXPORTED int32_t yices_get_statistic(context_t *ctx, const char *name, uint64_t *val) {
+  ctx_stats_t stats;
+  bool found;
+
+  init_ctx_stats(&stats);
+  context_collect_statistics(ctx, &stats);
+  found = ctx_stats_get(&stats, name, val);
+  delete_ctx_stats(&stats);
+
+  if (! found) {
+    error.code = CTX_UNKNOWN_PARAMETER;
+    return -1;
+  }
+
+  return 0;
+}
+
+/*
+ * All statistics as a JSON object
+ */
+EXPORTED char *yices_statistics_to_string(context_t *ctx) {
+  ctx_stats_t stats;
+  string_buffer_t buffer;
+  char *str;
+  uint32_t len;
+
+  init_ctx_stats(&stats);
+  context_collect_statistics(ctx, &stats);
+  init_string_buffer(&buffer, 1024);
+  ctx_stats_to_json(&stats, &buffer);
+  str = string_buffer_export(&buffer, &len);
+  delete_string_buffer(&buffer);
+  delete_ctx_stats(&stats);
+
+  return str;
+}
+
+
+/*
+ * Write the event trace of ctx to f
+ */
+EXPORTED int32_t yices_dump_event_trace(context_t *ctx, FILE *f) {
+  if (ctx->core == NULL) {
+    error.code = CTX_OPERATION_NOT_SUPPORTED;
+    return -1;
+  }
+
+  if (write_event_trace(smt_event_trace(ctx->core), f) < 0) {
+    error.code = OUTPUT_ERROR;
+    return -1;
+  }
+
+  return 0;
+}
+
+EXPORTED int32_t yices_dump_event_trace_fd(context_t *ctx, int fd) {
+  FILE *tmp_fp;
+  int32_t retval;
+
+  tmp_fp = fd_2_tmp_fp(fd);
+
+  if (tmp_fp == NULL) {
+    return -1;
+  }
+
+  retval = yices_dump_event_trace(ctx, tmp_fp);
+
+  fclose(tmp_fp);
+
+  return retval;
+}
+
+
+
 /*************************
  *  CONTEXT OPERATIONS   *
  ************************/
@@ -7032,6 +7531,7 @@ static void context_set_default_options(context_t *ctx, smt_logic_t logic, conte
   enable_eq_abstraction(ctx);
   enable_arith_elimination(ctx);
   enable_bvarith_elimination(ctx);
+  enable_bv_known_bits(ctx);
 
   if (iflag) {
     enable_splx_periodic_icheck(ctx);
@@ -7488,6 +7988,65 @@ EXPORTED int32_t yices_assert_blocking_clause(context_t *ctx) {
 
 
 
+/*
+ * Clone ctx: create a new context with the same configuration,
+ * search options, push levels, and assertions as ctx.
+ * - the clone is independent of ctx: it can be checked, extended,
+ *   or popped without affecting ctx.
+ * - if ctx's status is UNSAT, the clone's status is also UNSAT.
+ *   Otherwise, the clone's status is IDLE.
+ * - ctx must have the assertion-log option enabled
+ *
+ * Return NULL if there's an error.
+ *
+ * Error report:
+ * if ctx's status is SEARCHING or INTERRUPTED
+ *    code = CTX_INVALID_OPERATION
+ * if ctx contains constraints that are not in the assertion log
+ *    code = CTX_INVALID_OPERATION
+ */
+EXPORTED context_t *yices_clone_context(context_t *ctx) {
+  context_t *clone;
+  int32_t code;
+
+  switch (context_status(ctx)) {
+  case STATUS_IDLE:
+  case STATUS_SAT:
+  case STATUS_UNKNOWN:
+  case STATUS_UNSAT:
+    break;
+
+  case STATUS_SEARCHING:
+  case STATUS_INTERRUPTED:
+    error.code = CTX_INVALID_OPERATION;
+    return NULL;
+
+  case STATUS_ERROR:
+  default:
+    error.code = INTERNAL_EXCEPTION;
+    return NULL;
+  }
+
+  if (ctx->log_taint_level != LOG_NO_TAINT) {
+    error.code = CTX_INVALID_OPERATION;
+    return NULL;
+  }
+
+  clone = alloc_context();
+  code = clone_context(clone, ctx);
+  if (code < 0) {
+    convert_internalization_error(code);
+    delete_context(clone);
+    free_context(clone);
+    return NULL;
+  }
+  assert(code == TRIVIALLY_UNSAT || code == CTX_NO_ERROR);
+
+  return clone;
+}
+
+
+
 /*
  * Set default search parameters based on architecture, logic, and mode
  * - the parameter settings are based on SMT-LIB2 benchmarks
@@ -7666,7 +8225,7 @@ EXPORTED smt_status_t yices_check_context(context_t *ctx, const param_t *params)
       yices_default_params_for_context(ctx, &default_params);
       params = &default_params;
     }
-    stat = check_context(ctx, params);
+    stat = check_context_with_cache(ctx, params);
     if (stat == STATUS_INTERRUPTED && context_supports_cleaninterrupt(ctx)) {
       context_cleanup(ctx);
     }
@@ -7705,6 +8264,263 @@ EXPORTED void yices_stop_search(context_t *ctx) {
 }
 
 
+/*
+ * Optimize objectives obj[0 ... n-1] in lexicographic order
+ * - maximize[i] != 0 means maximize obj[i], otherwise minimize it
+ * - result[i] = status of obj[i]
+ * - if model is non-NULL and the result is SAT, *model is set to an
+ *   optimal model
+ */
+EXPORTED smt_status_t yices_optimize_context(context_t *ctx, const param_t *params,
+                                             uint32_t n, const term_t obj[], const int32_t maximize[],
+                                             objective_status_t result[], model_t **model) {
+  param_t default_params;
+  term_table_t *tbl;
+  model_t *mdl;
+  bool *max;
+  smt_status_t stat;
+  uint32_t i;
+  int32_t code;
+
+  if (! context_supports_pushpop(ctx) || ctx->mcsat != NULL) {
+    error.code = CTX_OPERATION_NOT_SUPPORTED;
+    return STATUS_ERROR;
+  }
+
+  if (! check_good_terms(&manager, n, obj)) {
+    return STATUS_ERROR;
+  }
+
+  tbl = term_manager_get_terms(&manager);
+  for (i=0; i<n; i++) {
+    if (! is_arithmetic_term(tbl, obj[i]) && ! is_bitvector_term(tbl, obj[i])) {
+      error.code = ARITHTERM_REQUIRED;
+      error.term1 = obj[i];
+      return STATUS_ERROR;
+    }
+  }
+
+  switch (context_status(ctx)) {
+  case STATUS_UNKNOWN:
+  case STATUS_SAT:
+    context_clear(ctx);
+    assert(context_status(ctx) == STATUS_IDLE);
+    // fall-through intended
+  case STATUS_IDLE:
+    break;
+
+  case STATUS_UNSAT:
+    for (i=0; i<n; i++) {
+      result[i] = OBJECTIVE_UNKNOWN;
+    }
+    return STATUS_UNSAT;
+
+  case STATUS_SEARCHING:
+  case STATUS_INTERRUPTED:
+    error.code = CTX_INVALID_OPERATION;
+    return STATUS_ERROR;
+
+  case STATUS_ERROR:
+  default:
+    error.code = INTERNAL_EXCEPTION;
+    return STATUS_ERROR;
+  }
+
+  max = NULL;
+  if (n > 0) {
+    max = (bool *) safe_malloc(n * sizeof(bool));
+  }
+  for (i=0; i<n; i++) {
+    max[i] = (maximize[i] != 0);
+  }
+
+  if (params == NULL) {
+    yices_default_params_for_context(ctx, &default_params);
+    params = &default_params;
+  }
+
+  mdl = alloc_model();
+  init_model(mdl, &terms, false);
+  code = 0;
+  stat = optimize_context(ctx, params, n, obj, max, result, mdl, &code);
+  if (stat == STATUS_ERROR) {
+    convert_internalization_error(code);
+  }
+  if (stat == STATUS_INTERRUPTED && context_status(ctx) == STATUS_INTERRUPTED &&
+      context_supports_cleaninterrupt(ctx)) {
+    context_cleanup(ctx);
+  }
+
+  if (stat == STATUS_SAT && model != NULL) {
+    *model = mdl;
+  } else {
+    delete_model(mdl);
+    free_model(mdl);
+  }
+  safe_free(max);
+
+  return stat;
+}
+
+
+/*
+ * Enumerate the models of ctx projected on t[0 ... n-1]
+ * - the values of t[0 ... n-1] in each model are stored in v
+ */
+EXPORTED smt_status_t yices_enumerate_models(context_t *ctx, const param_t *params,
+                                             uint32_t n, const term_t t[], uint32_t max_models,
+                                             term_vector_t *v) {
+  param_t default_params;
+  term_table_t *tbl;
+  int32_t *map;
+  smt_status_t stat;
+  uint32_t i;
+  int32_t code;
+
+  if (! context_supports_multichecks(ctx) || ctx->mcsat != NULL) {
+    error.code = CTX_OPERATION_NOT_SUPPORTED;
+    return STATUS_ERROR;
+  }
+
+  if (! check_good_terms(&manager, n, t)) {
+    return STATUS_ERROR;
+  }
+
+  tbl = term_manager_get_terms(&manager);
+  for (i=0; i<n; i++) {
+    if (! is_boolean_term(tbl, t[i]) && ! is_arithmetic_term(tbl, t[i]) && ! is_bitvector_term(tbl, t[i])) {
+      error.code = TYPE_MISMATCH;
+      error.term1 = t[i];
+      error.type1 = term_type(tbl, t[i]);
+      return STATUS_ERROR;
+    }
+  }
+
+  switch (context_status(ctx)) {
+  case STATUS_UNKNOWN:
+  case STATUS_SAT:
+    context_clear(ctx);
+    assert(context_status(ctx) == STATUS_IDLE);
+    // fall-through intended
+  case STATUS_IDLE:
+    break;
+
+  case STATUS_UNSAT:
+    return STATUS_UNSAT;
+
+  case STATUS_SEARCHING:
+  case STATUS_INTERRUPTED:
+    error.code = CTX_INVALID_OPERATION;
+    return STATUS_ERROR;
+
+  case STATUS_ERROR:
+  default:
+    error.code = INTERNAL_EXCEPTION;
+    return STATUS_ERROR;
+  }
+
+  map = NULL;
+  if (n > 0) {
+    map = (int32_t *) safe_malloc(n * sizeof(int32_t));
+  }
+
+  // internalize the projection terms
+  stat = STATUS_ERROR;
+  for (i=0; i<n; i++) {
+    if (is_boolean_term(tbl, t[i])) {
+      code = context_internalize(ctx, t[i]);
+    } else {
+      code = context_internalize_to_thvar(ctx, t[i]);
+    }
+    if (code < 0) {
+      convert_internalization_error(code);
+      goto done;
+    }
+    map[i] = code;
+  }
+
+  if (params == NULL) {
+    yices_default_params_for_context(ctx, &default_params);
+    params = &default_params;
+  }
+
+  v->size = 0;
+  stat = enumerate_context(ctx, params, n, t, map, max_models, (ivector_t *) v);
+  if (stat == STATUS_INTERRUPTED && context_status(ctx) == STATUS_INTERRUPTED &&
+      context_supports_cleaninterrupt(ctx)) {
+    context_cleanup(ctx);
+  }
+
+ done:
+  safe_free(map);
+
+  return stat;
+}
+
+
+/*
+ * Cube and conquer
+ * - if model is non-NULL and the result is SAT, *model is set to a model
+ */
+EXPORTED smt_status_t yices_check_context_with_cubes(context_t *ctx, const param_t *params,
+                                                     uint32_t depth, uint32_t nworkers,
+                                                     uint64_t max_conflicts, model_t **model) {
+  param_t default_params;
+  model_t *mdl;
+  smt_status_t stat;
+
+  if (! context_supports_pushpop(ctx) || ctx->mcsat != NULL) {
+    error.code = CTX_OPERATION_NOT_SUPPORTED;
+    return STATUS_ERROR;
+  }
+
+  switch (context_status(ctx)) {
+  case STATUS_UNKNOWN:
+  case STATUS_SAT:
+    context_clear(ctx);
+    assert(context_status(ctx) == STATUS_IDLE);
+    // fall-through intended
+  case STATUS_IDLE:
+    break;
+
+  case STATUS_UNSAT:
+    return STATUS_UNSAT;
+
+  case STATUS_SEARCHING:
+  case STATUS_INTERRUPTED:
+    error.code = CTX_INVALID_OPERATION;
+    return STATUS_ERROR;
+
+  case STATUS_ERROR:
+  default:
+    error.code = INTERNAL_EXCEPTION;
+    return STATUS_ERROR;
+  }
+
+  if (params == NULL) {
+    yices_default_params_for_context(ctx, &default_params);
+    params = &default_params;
+  }
+
+  mdl = alloc_model();
+  init_model(mdl, &terms, true);
+  stat = cube_and_conquer_context(ctx, params, depth, nworkers, max_conflicts, mdl);
+  if (stat == STATUS_INTERRUPTED && context_status(ctx) == STATUS_INTERRUPTED &&
+      context_supports_cleaninterrupt(ctx)) {
+    context_cleanup(ctx);
+  }
+
+  if (stat == STATUS_SAT && model != NULL) {
+    *model = mdl;
+  } else {
+    delete_model(mdl);
+    free_model(mdl);
+  }
+
+  return stat;
+}
+
+
 /************
  *  MODELS  *
  ***********/
@@ -8988,6 +9804,164 @@ EXPORTED int32_t yices_term_array_value(model_t *mdl, uint32_t n, const term_t a
 }
 
 
+/*
+ * Values of terms a[0 ... n-1] in numeric arrays
+ * - the values are computed by evaluate_term_array in the buffer v
+ *   (which must have size n)
+ */
+static bool get_term_array_values(model_t *mdl, uint32_t n, const term_t a[], value_t v[]) {
+  int32_t eval_code;
+
+  eval_code = evaluate_term_array(mdl, n, a, v);
+  if (eval_code < 0) {
+    error.code = yices_eval_error(eval_code);
+    return false;
+  }
+  return true;
+}
+
+EXPORTED int32_t yices_get_bool_value_array(model_t *mdl, uint32_t n, const term_t a[], int32_t val[]) {
+  value_table_t *vtbl;
+  uint32_t i;
+
+  if (! check_good_terms(&manager, n, a) ||
+      ! check_boolean_args(&manager, n, a)) {
+    return -1;
+  }
+
+  // value_t and int32_t are the same so we can use val as buffer
+  if (! get_term_array_values(mdl, n, a, val)) {
+    return -1;
+  }
+
+  vtbl = model_get_vtbl(mdl);
+  for (i=0; i<n; i++) {
+    if (! object_is_boolean(vtbl, val[i])) {
+      error.code = INTERNAL_EXCEPTION;
+      return -1;
+    }
+    val[i] = boolobj_value(vtbl, val[i]);
+  }
+
+  return 0;
+}
+
+EXPORTED int32_t yices_get_int64_value_array(model_t *mdl, uint32_t n, const term_t a[], int64_t val[]) {
+  value_table_t *vtbl;
+  ivector_t v;
+  uint32_t i;
+  int32_t code;
+
+  if (! check_good_terms(&manager, n, a) ||
+      ! check_arithmetic_args(&manager, n, a)) {
+    return -1;
+  }
+
+  init_ivector(&v, n);
+  code = -1;
+  if (get_term_array_values(mdl, n, a, v.data)) {
+    vtbl = model_get_vtbl(mdl);
+    for (i=0; i<n; i++) {
+      if (object_is_algebraic(vtbl, v.data[i])) {
+        error.code = EVAL_CONVERSION_FAILED;
+        goto done;
+      }
+      if (! object_is_rational(vtbl, v.data[i])) {
+        error.code = INTERNAL_EXCEPTION;
+        goto done;
+      }
+      if (! q_get64(vtbl_rational(vtbl, v.data[i]), val + i)) {
+        error.code = EVAL_OVERFLOW;
+        goto done;
+      }
+    }
+    code = 0;
+  }
+
+ done:
+  delete_ivector(&v);
+  return code;
+}
+
+EXPORTED int32_t yices_get_double_value_array(model_t *mdl, uint32_t n, const term_t a[], double val[]) {
+  value_table_t *vtbl;
+  ivector_t v;
+  uint32_t i;
+  int32_t code;
+
+  if (! check_good_terms(&manager, n, a) ||
+      ! check_arithmetic_args(&manager, n, a)) {
+    return -1;
+  }
+
+  init_ivector(&v, n);
+  code = -1;
+  if (get_term_array_values(mdl, n, a, v.data)) {
+    vtbl = model_get_vtbl(mdl);
+    for (i=0; i<n; i++) {
+      if (object_is_rational(vtbl, v.data[i])) {
+        val[i] = q_get_double(vtbl_rational(vtbl, v.data[i]));
+#if HAVE_MCSAT
+      } else if (object_is_algebraic(vtbl, v.data[i])) {
+        val[i] = lp_algebraic_number_to_double(vtbl_algebraic_number(vtbl, v.data[i]));
+#endif
+      } else {
+        error.code = INTERNAL_EXCEPTION;
+        goto done;
+      }
+    }
+    code = 0;
+  }
+
+ done:
+  delete_ivector(&v);
+  return code;
+}
+
+EXPORTED int32_t yices_get_bv64_value_array(model_t *mdl, uint32_t n, const term_t a[], uint64_t val[]) {
+  value_table_t *vtbl;
+  value_bv_t *bv;
+  ivector_t v;
+  uint32_t i;
+  int32_t code;
+
+  if (! check_good_terms(&manager, n, a) ||
+      ! check_bitvector_args(&manager, n, a)) {
+    return -1;
+  }
+
+  for (i=0; i<n; i++) {
+    if (term_bitsize(&terms, a[i]) > 64) {
+      error.code = EVAL_OVERFLOW;
+      return -1;
+    }
+  }
+
+  init_ivector(&v, n);
+  code = -1;
+  if (get_term_array_values(mdl, n, a, v.data)) {
+    vtbl = model_get_vtbl(mdl);
+    for (i=0; i<n; i++) {
+      if (! object_is_bitvector(vtbl, v.data[i])) {
+        error.code = INTERNAL_EXCEPTION;
+        goto done;
+      }
+      bv = vtbl_bitvector(vtbl, v.data[i]);
+      assert(bv->nbits <= 64);
+      val[i] = bv->data[0];
+      if (bv->width > 1) {
+        val[i] |= ((uint64_t) bv->data[1]) << 32;
+      }
+    }
+    code = 0;
+  }
+
+ done:
+  delete_ivector(&v);
+  return code;
+}
+
+
 
 
 
@@ -494,6 +494,34 @@ class TestModels(unittest.TestCase):
         self.assertEqual(mdlstr, '(= i1 42)\n(= r1 13/131)\n(= bv1 0b10000110)')
         yices_free_model(mdl)
 
+    def test_bulk_terms_and_values(self):
+        bv_t = yices_bv_type(8)
+        i1 = define_const('i1', int_t)
+        bv1 = define_const('bv1', bv_t)
+        buf = make_int32_array([YICES_OP_INT_CONST, 1, 3,
+                                YICES_OP_ARITH_GT, 2, i1, -1,
+                                YICES_OP_BV_CONST, 3, 8, 1, 0,
+                                YICES_OP_BV_ADD, 2, bv1, -3])
+        t = make_term_array([0, 0, 0, 0])
+        self.assertEqual(yices_build_terms(16, buf, 4, t), 4)
+        self.assertEqual(t[1], yices_arith_gt_atom(i1, yices_int32(3)))
+        self.assertEqual(t[3], yices_bvadd(bv1, yices_bvconst_int32(8, 1)))
+        mdl = yices_model_from_map(2, make_term_array([i1, bv1]), make_term_array([yices_int32(5), yices_bvconst_int32(8, 255)]))
+        bvals = make_int32_array([0])
+        yices_get_bool_value_array(mdl, 1, make_term_array([t[1]]), bvals)
+        self.assertEqual(bvals[0], 1)
+        ivals = make_empty_int64_array(1)
+        yices_get_int64_value_array(mdl, 1, make_term_array([i1]), ivals)
+        self.assertEqual(ivals[0], 5)
+        dvals = make_empty_double_array(1)
+        yices_get_double_value_array(mdl, 1, make_term_array([i1]), dvals)
+        self.assertEqual(dvals[0], 5.0)
+        uvals = make_empty_uint64_array(2)
+        yices_get_bv64_value_array(mdl, 2, make_term_array([bv1, t[3]]), uvals)
+        self.assertEqual(uvals[0], 255)
+        self.assertEqual(uvals[1], 0)
+        yices_free_model(mdl)
+
     def test_implicant(self):
         i1 = define_const('i1', int_t)
         assert_formula('(and (> i1 2) (< i1 8) (/= i1 4))', self.ctx)
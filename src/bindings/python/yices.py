@@ -472,6 +472,52 @@ YICES_BV_SUM = 40
 YICES_ARITH_SUM = 41
 YICES_POWER_PRODUCT = 42
 
+#term_opcode_t (for yices_build_terms)
+YICES_OP_NOT = 0
+YICES_OP_AND = 1
+YICES_OP_OR = 2
+YICES_OP_XOR = 3
+YICES_OP_IMPLIES = 4
+YICES_OP_IFF = 5
+YICES_OP_ITE = 6
+YICES_OP_EQ = 7
+YICES_OP_NEQ = 8
+YICES_OP_DISTINCT = 9
+YICES_OP_APP = 10
+YICES_OP_INT_CONST = 11
+YICES_OP_ADD = 12
+YICES_OP_SUB = 13
+YICES_OP_NEG = 14
+YICES_OP_MUL = 15
+YICES_OP_ARITH_GE = 16
+YICES_OP_ARITH_GT = 17
+YICES_OP_ARITH_LE = 18
+YICES_OP_ARITH_LT = 19
+YICES_OP_BV_CONST = 20
+YICES_OP_BV_ADD = 21
+YICES_OP_BV_SUB = 22
+YICES_OP_BV_NEG = 23
+YICES_OP_BV_MUL = 24
+YICES_OP_BV_NOT = 25
+YICES_OP_BV_AND = 26
+YICES_OP_BV_OR = 27
+YICES_OP_BV_XOR = 28
+YICES_OP_BV_SHL = 29
+YICES_OP_BV_LSHR = 30
+YICES_OP_BV_ASHR = 31
+YICES_OP_BV_DIV = 32
+YICES_OP_BV_REM = 33
+YICES_OP_BV_CONCAT = 34
+YICES_OP_BV_EXTRACT = 35
+YICES_OP_BV_GE = 36
+YICES_OP_BV_GT = 37
+YICES_OP_BV_LE = 38
+YICES_OP_BV_LT = 39
+YICES_OP_BV_SGE = 40
+YICES_OP_BV_SGT = 41
+YICES_OP_BV_SLE = 42
+YICES_OP_BV_SLT = 43
+
 #yices_gen_mode_t
 YICES_GEN_DEFAULT = 0
 YICES_GEN_BY_SUBST = 1
@@ -646,6 +692,24 @@ def make_empty_yval_array(n):
     return retval
 
 
+def make_empty_double_array(n):
+    """Makes an empty C double array object of length n"""
+    retval = (c_double * n)()
+    return retval
+
+
+def make_empty_uint64_array(n):
+    """Makes an empty C uint64 array object of length n"""
+    retval = (c_uint64 * n)()
+    return retval
+
+
+def make_array_view(ctype, buf, n):
+    """Makes a C array object of n elements of type ctype that shares its memory with the writable buffer buf (e.g., an array.array or a numpy array), without copying"""
+    retval = (ctype * n).from_buffer(buf)
+    return retval
+
+
 
 
 #################################
@@ -3753,6 +3817,28 @@ def yices_bvslt_atom(t1, t2):
     return libyices.yices_bvslt_atom(t1, t2)
 
 
+##############################
+#  BULK TERM CONSTRUCTION    #
+##############################
+
+# int32_t yices_build_terms(uint32_t size, const int32_t buffer[], uint32_t n, term_t t[])
+libyices.yices_build_terms.restype = c_int32
+libyices.yices_build_terms.argtypes = [c_uint32, POINTER(c_int32), c_uint32, POINTER(term_t)]
+@catch_error(-1)
+def yices_build_terms(size, buf, n, t):
+    """Builds the terms described by the opcode buffer buf of length size, storing the term for node i in t[i], and returns the number of nodes, or -1 on error.
+
+    Each node is of the form op, k, x_1, ..., x_k where op is one of the
+    YICES_OP_ constants. An operand x >= 0 is a term, and x < 0 refers to
+    the term built for node -x - 1. The operands of YICES_OP_INT_CONST,
+    YICES_OP_BV_CONST, and the last two operands of YICES_OP_BV_EXTRACT
+    are used as is.
+
+    buf can be a C int32 array, or a view on a Python buffer (cf. make_array_view).
+    """
+    return libyices.yices_build_terms(size, buf, n, t)
+
+
 ################
 #  PARSING     #
 ################
@@ -4901,6 +4987,42 @@ def yices_term_array_value(mdl, n, a, b):
     assert(mdl is not None)
     return libyices.yices_term_array_value(mdl, n, a, b)
 
+# int32_t yices_get_bool_value_array(model_t *mdl, uint32_t n, const term_t a[], int32_t val[])
+libyices.yices_get_bool_value_array.restype = c_int32
+libyices.yices_get_bool_value_array.argtypes = [model_t, c_uint32, POINTER(term_t), POINTER(c_int32)]
+@catch_error(-1)
+def yices_get_bool_value_array(mdl, n, a, val):
+    """Stores the values of the n Boolean terms in a into the int32 array val (0 for false, 1 for true), returning 0 if successful, and -1 otherwise."""
+    assert(mdl is not None)
+    return libyices.yices_get_bool_value_array(mdl, n, a, val)
+
+# int32_t yices_get_int64_value_array(model_t *mdl, uint32_t n, const term_t a[], int64_t val[])
+libyices.yices_get_int64_value_array.restype = c_int32
+libyices.yices_get_int64_value_array.argtypes = [model_t, c_uint32, POINTER(term_t), POINTER(c_int64)]
+@catch_error(-1)
+def yices_get_int64_value_array(mdl, n, a, val):
+    """Stores the values of the n arithmetic terms in a into the int64 array val, returning 0 if successful, and -1 otherwise."""
+    assert(mdl is not None)
+    return libyices.yices_get_int64_value_array(mdl, n, a, val)
+
+# int32_t yices_get_double_value_array(model_t *mdl, uint32_t n, const term_t a[], double val[])
+libyices.yices_get_double_value_array.restype = c_int32
+libyices.yices_get_double_value_array.argtypes = [model_t, c_uint32, POINTER(term_t), POINTER(c_double)]
+@catch_error(-1)
+def yices_get_double_value_array(mdl, n, a, val):
+    """Stores the values of the n arithmetic terms in a into the double array val, returning 0 if successful, and -1 otherwise."""
+    assert(mdl is not None)
+    return libyices.yices_get_double_value_array(mdl, n, a, val)
+
+# int32_t yices_get_bv64_value_array(model_t *mdl, uint32_t n, const term_t a[], uint64_t val[])
+libyices.yices_get_bv64_value_array.restype = c_int32
+libyices.yices_get_bv64_value_array.argtypes = [model_t, c_uint32, POINTER(term_t), POINTER(c_uint64)]
+@catch_error(-1)
+def yices_get_bv64_value_array(mdl, n, a, val):
+    """Stores the values of the n bitvector terms in a (of at most 64 bits) into the uint64 array val, returning 0 if successful, and -1 otherwise."""
+    assert(mdl is not None)
+    return libyices.yices_get_bv64_value_array(mdl, n, a, val)
+
 #
 # IMPLICANTS
 #
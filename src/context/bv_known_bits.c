@@ -0,0 +1,665 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * KNOWN BITS AND INTERVALS FOR BITVECTOR VARIABLES
+ */
+
+#include <assert.h>
+
+#include "context/bv_known_bits.h"
+#include "terms/bv64_constants.h"
+#include "utils/memalloc.h"
+
+
+/*
+ * Bound on the number of propagation rounds: inequalities between
+ * variables may increase bounds one unit at a time (e.g., x >= y+1
+ * and y >= x+1), so we can't always wait for the fixpoint.
+ */
+#define BVKB_MAX_ROUNDS 64
+
+
+/*
+ * Initialization
+ */
+void init_bv_known_bits(bv_known_bits_t *kb, term_table_t *terms, intern_tbl_t *intern) {
+  uint32_t n;
+
+  n = DEF_BVKB_SIZE;
+  assert(n <= MAX_BVKB_SIZE);
+
+  kb->terms = terms;
+  init_term_manager(&kb->mngr, terms);
+  kb->intern = intern;
+  kb->var = (bvkb_var_t *) safe_malloc(n * sizeof(bvkb_var_t));
+  kb->nvars = 0;
+  kb->size = n;
+  init_int_hmap(&kb->map, 0);
+  init_ivector(&kb->ineq, 0);
+  init_ivector(&kb->diseq, 0);
+  kb->unsat = false;
+}
+
+
+/*
+ * Delete
+ */
+void delete_bv_known_bits(bv_known_bits_t *kb) {
+  delete_term_manager(&kb->mngr);
+  safe_free(kb->var);
+  kb->var = NULL;
+  delete_int_hmap(&kb->map);
+  delete_ivector(&kb->ineq);
+  delete_ivector(&kb->diseq);
+}
+
+
+/*
+ * Make room for one more variable
+ */
+static void extend_bvkb_vars(bv_known_bits_t *kb) {
+  uint32_t n;
+
+  n = kb->size + 1;
+  n += n>>1;
+  if (n > MAX_BVKB_SIZE) {
+    out_of_memory();
+  }
+  kb->var = (bvkb_var_t *) safe_realloc(kb->var, n * sizeof(bvkb_var_t));
+  kb->size = n;
+}
+
+
+
+/*
+ * TERM CLASSIFICATION
+ */
+
+/*
+ * Check whether t's root is a bitvector variable that we can track:
+ * - the root must be an uninterpreted term of at most 64 bits
+ * - it must be a free root, not mapped to anything yet
+ * - return the index of its record (create the record if needed)
+ * - return -1 otherwise
+ */
+static int32_t bvkb_var_of(bv_known_bits_t *kb, term_t t) {
+  term_table_t *terms;
+  int_hmap_pair_t *p;
+  bvkb_var_t *v;
+  uint32_t n, i;
+
+  terms = kb->terms;
+  t = intern_tbl_get_root(kb->intern, t);
+  if (term_kind(terms, t) != UNINTERPRETED_TERM || !is_bitvector_term(terms, t)) {
+    return -1;
+  }
+  n = term_bitsize(terms, t);
+  if (n > 64 || !intern_tbl_root_is_free(kb->intern, t) || intern_tbl_root_is_mapped(kb->intern, t)) {
+    return -1;
+  }
+
+  p = int_hmap_get(&kb->map, t);
+  if (p->val < 0) {
+    i = kb->nvars;
+    if (i == kb->size) {
+      extend_bvkb_vars(kb);
+    }
+    assert(i < kb->size);
+    v = kb->var + i;
+    v->term = t;
+    v->nbits = n;
+    v->mask = 0;
+    v->value = 0;
+    v->low = 0;
+    v->high = mask64(n);
+    kb->nvars = i+1;
+    p->val = i;
+  }
+
+  return p->val;
+}
+
+
+/*
+ * Check whether t's root is a constant of at most 64 bits
+ * - if so store its value in *c
+ */
+static bool bvkb_const_of(bv_known_bits_t *kb, term_t t, uint64_t *c) {
+  t = intern_tbl_get_root(kb->intern, t);
+  if (term_kind(kb->terms, t) == BV64_CONSTANT) {
+    *c = bvconst64_term_desc(kb->terms, t)->value;
+    return true;
+  }
+  return false;
+}
+
+
+
+/*
+ * REFINEMENT OF A VARIABLE RECORD
+ */
+
+/*
+ * All the functions below return true if the record changed.
+ * They set kb->unsat if they detect a conflict.
+ */
+
+/*
+ * Set bit k of var[i] to b
+ */
+static bool bvkb_set_bit(bv_known_bits_t *kb, uint32_t i, uint32_t k, bool b) {
+  bvkb_var_t *v;
+
+  v = kb->var + i;
+  assert(k < v->nbits);
+  if (tst_bit64(v->mask, k)) {
+    if (tst_bit64(v->value, k) != b) {
+      kb->unsat = true;
+    }
+    return false;
+  }
+  v->mask = set_bit64(v->mask, k);
+  if (b) {
+    v->value = set_bit64(v->value, k);
+  }
+  return true;
+}
+
+/*
+ * Assert var[i] >= c
+ */
+static bool bvkb_set_low(bv_known_bits_t *kb, uint32_t i, uint64_t c) {
+  bvkb_var_t *v;
+
+  v = kb->var + i;
+  assert(c == norm64(c, v->nbits));
+  if (c > v->low) {
+    v->low = c;
+    if (c > v->high) {
+      kb->unsat = true;
+    }
+    return true;
+  }
+  return false;
+}
+
+/*
+ * Assert var[i] <= c
+ */
+static bool bvkb_set_high(bv_known_bits_t *kb, uint32_t i, uint64_t c) {
+  bvkb_var_t *v;
+
+  v = kb->var + i;
+  assert(c == norm64(c, v->nbits));
+  if (c < v->high) {
+    v->high = c;
+    if (c < v->low) {
+      kb->unsat = true;
+    }
+    return true;
+  }
+  return false;
+}
+
+
+/*
+ * Mask for bits 0 to k (inclusive)
+ */
+static inline uint64_t low_bits_upto(uint32_t k) {
+  assert(k < 64);
+  return (k == 63) ? ~((uint64_t) 0) : (((uint64_t) 1) << (k+1)) - 1;
+}
+
+/*
+ * Smallest n-bit value v >= a such that (v & mask) == value
+ * - return false if there's no such v
+ * - value must be a subset of mask
+ */
+static bool next_consistent_value(uint64_t a, uint64_t mask, uint64_t value, uint32_t n, uint64_t *v) {
+  uint64_t diff, cand, low;
+  uint32_t i, j;
+
+  assert((value & ~mask) == 0);
+
+  diff = (a ^ value) & mask;
+  if (diff == 0) {
+    *v = a;
+    return true;
+  }
+
+  // i = highest bit where a disagrees with the known bits
+  i = 63;
+  while (! tst_bit64(diff, i)) {
+    i --;
+  }
+  low = low_bits_upto(i);
+
+  if (tst_bit64(value, i)) {
+    // bit i is 0 in a and 1 in value: keep a's prefix
+    *v = (a & ~low) | (value & low);
+    return true;
+  }
+
+  // bit i is 1 in a and 0 in value: we must set an unknown bit j > i
+  // that's 0 in a. We pick the lowest such bit.
+  cand = ~mask & ~a & mask64(n) & ~low;
+  if (cand == 0) {
+    return false;
+  }
+  j = i + 1;
+  while (! tst_bit64(cand, j)) {
+    j ++;
+  }
+  low = low_bits_upto(j);
+  *v = (a & ~low) | (((uint64_t) 1) << j) | (value & low);
+  return true;
+}
+
+/*
+ * Largest n-bit value v <= a such that (v & mask) == value
+ * - return false if there's no such value
+ */
+static bool prev_consistent_value(uint64_t a, uint64_t mask, uint64_t value, uint32_t n, uint64_t *v) {
+  uint64_t full, u;
+
+  full = mask64(n);
+  if (next_consistent_value(~a & full, mask, ~value & mask, n, &u)) {
+    *v = ~u & full;
+    return true;
+  }
+  return false;
+}
+
+
+/*
+ * Combine the interval and the known bits of var[i]
+ * - the common prefix of low and high is known
+ * - low and high are moved to the closest values consistent with the known bits
+ */
+static bool bvkb_normalize_var(bv_known_bits_t *kb, uint32_t i) {
+  bvkb_var_t *v;
+  uint64_t d, prefix, lo, hi;
+  bool changed;
+
+  v = kb->var + i;
+  changed = false;
+
+  for (;;) {
+    if (v->low > v->high) {
+      kb->unsat = true;
+      break;
+    }
+
+    // d = all bits up to the highest bit where low and high differ
+    d = v->low ^ v->high;
+    d |= d >> 1;
+    d |= d >> 2;
+    d |= d >> 4;
+    d |= d >> 8;
+    d |= d >> 16;
+    d |= d >> 32;
+    prefix = mask64(v->nbits) & ~d;
+    if (((v->low ^ v->value) & prefix & v->mask) != 0) {
+      kb->unsat = true;
+      break;
+    }
+    if ((prefix & ~v->mask) != 0) {
+      v->mask |= prefix;
+      v->value |= v->low & prefix;
+      changed = true;
+    }
+
+    if (!next_consistent_value(v->low, v->mask, v->value, v->nbits, &lo) ||
+	!prev_consistent_value(v->high, v->mask, v->value, v->nbits, &hi) ||
+	lo > hi) {
+      kb->unsat = true;
+      break;
+    }
+    if (lo == v->low && hi == v->high) {
+      break;
+    }
+    v->low = lo;
+    v->high = hi;
+    changed = true;
+  }
+
+  return changed;
+}
+
+
+
+/*
+ * COLLECT CONSTRAINTS
+ */
+
+/*
+ * Record (x >= y + d) between two variables
+ */
+static void bvkb_add_ineq(bv_known_bits_t *kb, int32_t x, int32_t y, uint32_t d) {
+  if (x == y) {
+    if (d > 0) kb->unsat = true;
+    return;
+  }
+  ivector_push(&kb->ineq, x);
+  ivector_push(&kb->ineq, y);
+  ivector_push(&kb->ineq, d);
+}
+
+/*
+ * Process (s >= t + d) (unsigned comparison)
+ * - d is 0 or 1
+ */
+static void bvkb_add_ge(bv_known_bits_t *kb, term_t s, term_t t, uint32_t d) {
+  int32_t x, y;
+  uint64_t c;
+
+  if (bvkb_const_of(kb, t, &c)) {
+    x = bvkb_var_of(kb, s);
+    if (x >= 0) {
+      // x >= c + d
+      c += d;
+      if (c > mask64(kb->var[x].nbits)) {
+	kb->unsat = true;
+      } else {
+	bvkb_set_low(kb, x, c);
+      }
+    }
+  } else if (bvkb_const_of(kb, s, &c)) {
+    y = bvkb_var_of(kb, t);
+    if (y >= 0) {
+      // c >= y + d
+      if (c < d) {
+	kb->unsat = true;
+      } else {
+	bvkb_set_high(kb, y, c - d);
+      }
+    }
+  } else {
+    x = bvkb_var_of(kb, s);
+    y = bvkb_var_of(kb, t);
+    if (x >= 0 && y >= 0) {
+      bvkb_add_ineq(kb, x, y, d);
+    }
+  }
+}
+
+/*
+ * Process (s >= t + d) (signed comparison)
+ * - this gives an unsigned interval only if the non-constant term is
+ *   forced to be non-negative or negative.
+ */
+static void bvkb_add_sge(bv_known_bits_t *kb, term_t s, term_t t, uint32_t d) {
+  int32_t x;
+  uint32_t n;
+  uint64_t c;
+
+  if (bvkb_const_of(kb, t, &c)) {
+    x = bvkb_var_of(kb, s);
+    if (x >= 0) {
+      // x >= c + d
+      n = kb->var[x].nbits;
+      if (d > 0) {
+	if (c == max_signed64(n)) {
+	  kb->unsat = true;
+	  return;
+	}
+	c = norm64(c + 1, n);
+      }
+      if (is_pos64(c, n)) {
+	// x is in [c, max_signed]
+	bvkb_set_low(kb, x, c);
+	bvkb_set_high(kb, x, max_signed64(n));
+      }
+    }
+  } else if (bvkb_const_of(kb, s, &c)) {
+    x = bvkb_var_of(kb, t);
+    if (x >= 0) {
+      // c >= x + d
+      n = kb->var[x].nbits;
+      if (d > 0) {
+	if (c == min_signed64(n)) {
+	  kb->unsat = true;
+	  return;
+	}
+	c = norm64(c - 1, n);
+      }
+      if (is_neg64(c, n)) {
+	// x is in [min_signed, c]
+	bvkb_set_low(kb, x, min_signed64(n));
+	bvkb_set_high(kb, x, c);
+      }
+    }
+  }
+}
+
+/*
+ * Process (not (s == t))
+ */
+static void bvkb_add_diseq(bv_known_bits_t *kb, term_t s, term_t t) {
+  int32_t x;
+  uint64_t c;
+
+  if (bvkb_const_of(kb, s, &c)) {
+    x = bvkb_var_of(kb, t);
+    t = s;
+  } else if (bvkb_const_of(kb, t, &c)) {
+    x = bvkb_var_of(kb, s);
+  } else {
+    return;
+  }
+
+  // t is now the constant
+  if (x >= 0) {
+    ivector_push(&kb->diseq, x);
+    ivector_push(&kb->diseq, intern_tbl_get_root(kb->intern, t));
+  }
+}
+
+
+/*
+ * Process atom a
+ */
+void bv_known_bits_add_atom(bv_known_bits_t *kb, term_t a) {
+  term_table_t *terms;
+  composite_term_t *d;
+  select_term_t *b;
+  int32_t x;
+  term_t t;
+  bool pos;
+
+  terms = kb->terms;
+  pos = is_pos_term(a);
+  t = unsigned_term(a);
+
+  switch (term_kind(terms, t)) {
+  case BIT_TERM:
+    b = bit_term_desc(terms, t);
+    x = bvkb_var_of(kb, b->arg);
+    if (x >= 0) {
+      bvkb_set_bit(kb, x, b->idx, pos);
+    }
+    break;
+
+  case BV_GE_ATOM:
+    d = bvge_atom_desc(terms, t);
+    if (pos) {
+      bvkb_add_ge(kb, d->arg[0], d->arg[1], 0);
+    } else {
+      bvkb_add_ge(kb, d->arg[1], d->arg[0], 1);
+    }
+    break;
+
+  case BV_SGE_ATOM:
+    d = bvsge_atom_desc(terms, t);
+    if (pos) {
+      bvkb_add_sge(kb, d->arg[0], d->arg[1], 0);
+    } else {
+      bvkb_add_sge(kb, d->arg[1], d->arg[0], 1);
+    }
+    break;
+
+  case BV_EQ_ATOM:
+    if (!pos) {
+      d = bveq_atom_desc(terms, t);
+      bvkb_add_diseq(kb, d->arg[0], d->arg[1]);
+    }
+    break;
+
+  default:
+    break;
+  }
+}
+
+
+
+/*
+ * PROPAGATION
+ */
+
+/*
+ * Propagate x >= y + d
+ */
+static bool bvkb_propagate_ineq(bv_known_bits_t *kb, uint32_t x, uint32_t y, uint32_t d) {
+  bool changed;
+
+  changed = false;
+  if (kb->var[y].low == mask64(kb->var[y].nbits) && d > 0) {
+    kb->unsat = true;
+  } else {
+    changed |= bvkb_set_low(kb, x, kb->var[y].low + d);
+  }
+  if (kb->var[x].high < d) {
+    kb->unsat = true;
+  } else {
+    changed |= bvkb_set_high(kb, y, kb->var[x].high - d);
+  }
+  return changed;
+}
+
+/*
+ * Propagate x /= c: this can only change the bounds
+ */
+static bool bvkb_propagate_diseq(bv_known_bits_t *kb, uint32_t x, term_t c) {
+  bvkb_var_t *v;
+  uint64_t val;
+
+  v = kb->var + x;
+  val = bvconst64_term_desc(kb->terms, c)->value;
+  if (val == v->low) {
+    if (val == v->high) {
+      kb->unsat = true;
+      return false;
+    }
+    v->low ++;
+    return true;
+  }
+  if (val == v->high) {
+    v->high --;
+    return true;
+  }
+  return false;
+}
+
+
+void bv_known_bits_propagate(bv_known_bits_t *kb) {
+  int32_t *a;
+  uint32_t i, n, rounds;
+  bool changed;
+
+  rounds = 0;
+  do {
+    changed = false;
+    n = kb->nvars;
+    for (i=0; i<n && !kb->unsat; i++) {
+      changed |= bvkb_normalize_var(kb, i);
+    }
+
+    a = kb->ineq.data;
+    n = kb->ineq.size;
+    for (i=0; i<n && !kb->unsat; i += 3) {
+      changed |= bvkb_propagate_ineq(kb, a[i], a[i+1], a[i+2]);
+    }
+
+    a = kb->diseq.data;
+    n = kb->diseq.size;
+    for (i=0; i<n && !kb->unsat; i += 2) {
+      changed |= bvkb_propagate_diseq(kb, a[i], a[i+1]);
+    }
+
+    rounds ++;
+  } while (changed && !kb->unsat && rounds < BVKB_MAX_ROUNDS);
+
+  // make sure low/high and the known bits agree
+  n = kb->nvars;
+  for (i=0; i<n && !kb->unsat; i++) {
+    bvkb_normalize_var(kb, i);
+  }
+}
+
+
+
+/*
+ * REPLACEMENT TERM
+ */
+term_t bv_known_bits_var_value(bv_known_bits_t *kb, uint32_t i) {
+  bvlogic_buffer_t *b;
+  bvkb_var_t *v;
+  type_table_t *types;
+  term_t y;
+  uint32_t j, k, n;
+  bool known;
+
+  assert(i < kb->nvars && kb->var[i].mask != 0);
+
+  v = kb->var + i;
+  n = v->nbits;
+  if (v->mask == mask64(n)) {
+    return bv64_constant(kb->terms, n, v->value);
+  }
+
+  types = kb->terms->types;
+  b = term_manager_get_bvlogic_buffer(&kb->mngr);
+
+  // each block [j, k) of known or unknown bits is added to the left of b
+  j = 0;
+  while (j < n) {
+    known = tst_bit64(v->mask, j);
+    k = j+1;
+    while (k < n && tst_bit64(v->mask, k) == known) {
+      k ++;
+    }
+    if (known) {
+      if (j == 0) {
+	bvlogic_buffer_set_constant64(b, k, v->value);
+      } else {
+	bvlogic_buffer_concat_left_constant64(b, k - j, v->value >> j);
+      }
+    } else {
+      y = new_uninterpreted_term(kb->terms, bv_type(types, k - j));
+      if (j == 0) {
+	bvlogic_buffer_set_term(b, kb->terms, y);
+      } else {
+	bvlogic_buffer_concat_left_term(b, kb->terms, y);
+      }
+    }
+    j = k;
+  }
+
+  return mk_bvlogic_term(&kb->mngr, b);
+}
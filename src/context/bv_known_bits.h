@@ -0,0 +1,155 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * KNOWN BITS AND INTERVALS FOR BITVECTOR VARIABLES
+ */
+
+/*
+ * This module collects constraints on bitvector variables from the
+ * top-level atoms of a context, before internalization. For each
+ * variable x of at most 64 bits, we keep two abstractions:
+ * - known bits: a mask and a value (bit i of x is known and equal
+ *   to bit i of value if bit i of mask is 1)
+ * - an unsigned interval [low, high] that contains x.
+ *
+ * The constraints we use are:
+ *   (bit i x)  (not (bit i x))
+ *   (bvge x c) (bvge c x) and their negations
+ *   (bvsge x c) (bvsge c x) and their negations (when they
+ *       reduce to an unsigned interval)
+ *   (not (bveq x c))  (to tighten the interval bounds)
+ *   (bvge x y) and (not (bvge x y)) where x and y are variables.
+ *
+ * The two domains are combined and propagated to a fixpoint:
+ * - the common prefix of low and high gives known high-order bits
+ * - known bits shrink the interval to the closest consistent values
+ * - inequalities between variables propagate bounds.
+ *
+ * If the fixpoint shows that the constraints are unsatisfiable, flag
+ * 'unsat' is set. Otherwise, the context can replace x by a constant
+ * (if all bits are known) or by a concatenation of constants and
+ * fresh, narrower, variables (if some bits are known).
+ */
+
+#ifndef __BV_KNOWN_BITS_H
+#define __BV_KNOWN_BITS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+
+#include "context/internalization_table.h"
+#include "terms/term_manager.h"
+#include "terms/terms.h"
+#include "utils/int_hash_map.h"
+#include "utils/int_vectors.h"
+
+
+/*
+ * Record for a variable:
+ * - term = the variable (a root in the internalization table)
+ * - nbits = number of bits (between 1 and 64)
+ * - mask/value = known bits
+ * - low/high = interval
+ * All constants are normalized modulo 2^nbits.
+ */
+typedef struct bvkb_var_s {
+  term_t term;
+  uint32_t nbits;
+  uint64_t mask;
+  uint64_t value;
+  uint64_t low;
+  uint64_t high;
+} bvkb_var_t;
+
+
+/*
+ * Analyzer:
+ * - terms = term table
+ * - mngr = term manager (to build the new terms)
+ * - intern = internalization table (to get roots)
+ * - var = array of variable records
+ * - nvars = number of records
+ * - size = size of the var array
+ * - map = map from variable term to its index in var
+ * - ineq = inequalities between variables, stored as triples
+ *   [x, y, d] for x >= y + d (where x and y are indices and d is 0 or 1)
+ * - diseq = disequalities, stored as pairs [x, c] for x /= c
+ *   (x is an index and c a bitvector constant term)
+ * - unsat = true if a contradiction was found
+ */
+typedef struct bv_known_bits_s {
+  term_table_t *terms;
+  term_manager_t mngr;
+  intern_tbl_t *intern;
+  bvkb_var_t *var;
+  uint32_t nvars;
+  uint32_t size;
+  int_hmap_t map;
+  ivector_t ineq;
+  ivector_t diseq;
+  bool unsat;
+} bv_known_bits_t;
+
+
+#define DEF_BVKB_SIZE 64
+#define MAX_BVKB_SIZE (UINT32_MAX/sizeof(bvkb_var_t))
+
+
+/*
+ * Initialize/delete
+ */
+extern void init_bv_known_bits(bv_known_bits_t *kb, term_table_t *terms, intern_tbl_t *intern);
+extern void delete_bv_known_bits(bv_known_bits_t *kb);
+
+
+/*
+ * Process atom a, which is asserted true
+ * - a is ignored if it's not one of the constraints listed above
+ * - kb->unsat is set if a is trivially false given the known facts
+ */
+extern void bv_known_bits_add_atom(bv_known_bits_t *kb, term_t a);
+
+
+/*
+ * Propagate until fixpoint (or kb->unsat becomes true)
+ */
+extern void bv_known_bits_propagate(bv_known_bits_t *kb);
+
+
+/*
+ * Check whether some bits of var[i] are known
+ */
+static inline bool bvkb_var_has_known_bits(bv_known_bits_t *kb, uint32_t i) {
+  assert(i < kb->nvars);
+  return kb->var[i].mask != 0;
+}
+
+
+/*
+ * Build a term equivalent to var[i] given its known bits:
+ * - if all bits are known, return a constant
+ * - otherwise, return a concatenation of constants and fresh
+ *   uninterpreted terms (one for each block of unknown bits).
+ * - var[i] must have some known bits
+ */
+extern term_t bv_known_bits_var_value(bv_known_bits_t *kb, uint32_t i);
+
+
+#endif /* __BV_KNOWN_BITS_H */
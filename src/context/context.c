@@ -5259,6 +5259,8 @@ static inline bool valid_arch(context_arch_t arch) {
  */
 void init_context(context_t *ctx, term_table_t *terms, smt_logic_t logic,
                   context_mode_t mode, context_arch_t arch, bool qflag) {
+  uint32_t i;
+
   assert(valid_mode(mode) && valid_arch(arch));
 
   /*
@@ -5303,6 +5305,9 @@ void init_context(context_t *ctx, term_table_t *terms, smt_logic_t logic,
   init_ivector(&ctx->top_atoms, CTX_DEFAULT_VECTOR_SIZE);
   init_ivector(&ctx->top_formulas, CTX_DEFAULT_VECTOR_SIZE);
   init_ivector(&ctx->top_interns, CTX_DEFAULT_VECTOR_SIZE);
+  init_ivector(&ctx->assertion_log, 0);
+  init_ivector(&ctx->assertion_marks, 0);
+  ctx->log_taint_level = LOG_NO_TAINT;
 
   /*
    * Force the internalization mapping for true and false
@@ -5331,6 +5336,7 @@ void init_context(context_t *ctx, term_table_t *terms, smt_logic_t logic,
   ctx->eq_cache = NULL;
   ctx->divmod_table = NULL;
   ctx->explorer = NULL;
+  ctx->qcache = NULL;
 
   ctx->dl_profile = NULL;
   ctx->arith_buffer = NULL;
@@ -5342,6 +5348,10 @@ void init_context(context_t *ctx, term_table_t *terms, smt_logic_t logic,
   init_bvconstant(&ctx->bv_buffer);
 
   ctx->trace = NULL;
+  for (i=0; i<NUM_CTX_TIMERS; i++) {
+    reset_cycle_timer(ctx->timer + i);
+  }
+  ctx->mem_limit_reached = false;
 
   // mcsat options default
   init_mcsat_options(&ctx->mcsat_options);
@@ -5403,6 +5413,8 @@ void delete_context(context_t *ctx) {
   delete_ivector(&ctx->top_atoms);
   delete_ivector(&ctx->top_formulas);
   delete_ivector(&ctx->top_interns);
+  delete_ivector(&ctx->assertion_log);
+  delete_ivector(&ctx->assertion_marks);
 
   delete_ivector(&ctx->subst_eqs);
   delete_ivector(&ctx->aux_eqs);
@@ -5420,6 +5432,7 @@ void delete_context(context_t *ctx) {
   context_free_eq_cache(ctx);
   context_free_divmod_table(ctx);
   context_free_explorer(ctx);
+  context_disable_query_cache(ctx);
 
   context_free_dl_profile(ctx);
   context_free_arith_buffer(ctx);
@@ -5436,9 +5449,15 @@ void delete_context(context_t *ctx) {
  * Reset: remove all assertions and clear all internalization tables
  */
 void reset_context(context_t *ctx) {
+  uint32_t i;
+
   ctx->base_level = 0;
 
   reset_smt_core(ctx->core); // this propagates reset to all solvers
+  for (i=0; i<NUM_CTX_TIMERS; i++) {
+    reset_cycle_timer(ctx->timer + i);
+  }
+  ctx->mem_limit_reached = false;
 
   if (ctx->mcsat != NULL) {
     mcsat_reset(ctx->mcsat);
@@ -5451,6 +5470,8 @@ void reset_context(context_t *ctx) {
   ivector_reset(&ctx->top_atoms);
   ivector_reset(&ctx->top_formulas);
   ivector_reset(&ctx->top_interns);
+  ivector_reset(&ctx->assertion_log);
+  ivector_reset(&ctx->assertion_marks);
 
   // Force the internalization mapping for true and false
   intern_tbl_map_root(&ctx->intern, true_term, bool2code(true));
@@ -5470,6 +5491,10 @@ void reset_context(context_t *ctx) {
   context_reset_eq_cache(ctx);
   context_reset_divmod_table(ctx);
   context_reset_explorer(ctx);
+  ctx->log_taint_level = LOG_NO_TAINT;
+  if (ctx->qcache != NULL) {
+    ctx->qcache->hit = NULL;
+  }
 
   context_free_arith_buffer(ctx);
   context_reset_poly_buffer(ctx);
@@ -5506,6 +5531,7 @@ void context_push(context_t *ctx) {
   intern_tbl_push(&ctx->intern);
   context_eq_cache_push(ctx);
   context_divmod_table_push(ctx);
+  ivector_push(&ctx->assertion_marks, ctx->assertion_log.size);
 
   ctx->base_level ++;
 }
@@ -5520,8 +5546,100 @@ void context_pop(context_t *ctx) {
   intern_tbl_pop(&ctx->intern);
   context_eq_cache_pop(ctx);
   context_divmod_table_pop(ctx);
+  ivector_shrink(&ctx->assertion_log, ivector_pop2(&ctx->assertion_marks));
 
   ctx->base_level --;
+
+  // the constraints that are not in the log may be gone
+  if (ctx->log_taint_level > ctx->base_level) {
+    ctx->log_taint_level = LOG_NO_TAINT;
+  }
+  assert(ctx->qcache == NULL || ctx->qcache->hit == NULL);
+}
+
+
+
+/*
+ * CLONING
+ */
+
+/*
+ * Copy the option flags of ctx into clone
+ * - the simplex options must go through the enable/disable functions
+ *   since they are propagated to the simplex solver if it exists
+ */
+static void copy_context_options(context_t *clone, const context_t *ctx) {
+  if (ctx->options & SPLX_EGRLMAS_OPTION_MASK) {
+    enable_splx_eager_lemmas(clone);
+  } else {
+    disable_splx_eager_lemmas(clone);
+  }
+  if (ctx->options & SPLX_ICHECK_OPTION_MASK) {
+    enable_splx_periodic_icheck(clone);
+  } else {
+    disable_splx_periodic_icheck(clone);
+  }
+  if (ctx->options & SPLX_EQPROP_OPTION_MASK) {
+    enable_splx_eqprop(clone);
+  } else {
+    disable_splx_eqprop(clone);
+  }
+  clone->options = ctx->options;
+  clone->mcsat_options = ctx->mcsat_options;
+}
+
+/*
+ * Assert the blocks stored in log[i ... end-1] into ctx
+ * - each block is [n, f[0] ... f[n-1]]
+ * - stop on the first block that's not CTX_NO_ERROR and return its code
+ */
+static int32_t replay_assertion_log(context_t *ctx, const ivector_t *log, uint32_t i, uint32_t end) {
+  uint32_t n;
+  int32_t code;
+
+  code = CTX_NO_ERROR;
+  while (i < end && code == CTX_NO_ERROR) {
+    n = log->data[i];
+    code = assert_formulas(ctx, n, log->data + i + 1);
+    i += n + 1;
+  }
+
+  return code;
+}
+
+/*
+ * Initialize clone as a copy of ctx
+ */
+int32_t clone_context(context_t *clone, context_t *ctx) {
+  uint32_t i, start, end;
+  int32_t code;
+
+  assert(ctx->log_taint_level == LOG_NO_TAINT);
+
+  init_context(clone, ctx->terms, ctx->logic, ctx->mode, ctx->arch, (ctx->theories & QUANT_MASK) != 0);
+  copy_context_options(clone, ctx);
+
+  start = 0;
+  for (i=0; i<ctx->base_level; i++) {
+    end = ctx->assertion_marks.data[i];
+    code = replay_assertion_log(clone, &ctx->assertion_log, start, end);
+    if (code != CTX_NO_ERROR) return code;
+    context_push(clone);
+    start = end;
+  }
+
+  if (context_status(ctx) == STATUS_UNSAT) {
+    /*
+     * The inconsistency may come from a search or from clauses added
+     * by the solvers. Replaying the top-level assertions would
+     * not reproduce it.
+     */
+    code = assert_formula(clone, false_term);
+  } else {
+    code = replay_assertion_log(clone, &ctx->assertion_log, start, ctx->assertion_log.size);
+  }
+
+  return code;
 }
 
 
@@ -5664,6 +5782,14 @@ static int32_t context_process_assertions(context_t *ctx, uint32_t n, const term
       break;
     }
 
+    /*
+     * Known bits/intervals for bitvector variables
+     */
+    if (context_has_bv_solver(ctx) && context_var_elim_enabled(ctx) &&
+        context_bv_known_bits_enabled(ctx)) {
+      process_bv_known_bits(ctx);
+    }
+
     /*
      * Sharing
      */
@@ -5776,13 +5902,24 @@ static int32_t context_process_assertions(context_t *ctx, uint32_t n, const term
  * - otherwise, the code is negative to report an error.
  */
 int32_t assert_formulas(context_t *ctx, uint32_t n, const term_t *f) {
+  uint64_t start;
   int32_t code;
 
   assert(ctx->arch == CTX_ARCH_AUTO_IDL ||
          ctx->arch == CTX_ARCH_AUTO_RDL ||
          smt_status(ctx->core) == STATUS_IDLE);
 
+  start = timer_start();
   code = context_process_assertions(ctx, n, f);
+  timer_stop(ctx->timer + CTX_TIMER_INTERNALIZE, start);
+  if (code >= 0) {
+    if (context_assertion_log_enabled(ctx) || ctx->qcache != NULL) {
+      ivector_push(&ctx->assertion_log, n);
+      ivector_add(&ctx->assertion_log, f, n);
+    } else {
+      context_taint_assertion_log(ctx);
+    }
+  }
   if (code == TRIVIALLY_UNSAT) {
     if (ctx->arch == CTX_ARCH_AUTO_IDL || ctx->arch == CTX_ARCH_AUTO_RDL) {
       // cleanup: reset arch/config to 'no theory'
@@ -5830,6 +5967,7 @@ int32_t assert_formula(context_t *ctx, term_t f) {
  * - return a literal (l >= 0) otherwise.
  */
 int32_t context_internalize(context_t *ctx, term_t t) {
+  uint64_t start;
   int code;
   literal_t l;
 
@@ -5840,6 +5978,7 @@ int32_t context_internalize(context_t *ctx, term_t t) {
   ivector_reset(&ctx->subst_eqs);
   ivector_reset(&ctx->aux_eqs);
 
+  start = timer_start();
   code = setjmp(ctx->env);
   if (code == 0) {
     l = internalize_to_literal(ctx, t);
@@ -5855,11 +5994,54 @@ int32_t context_internalize(context_t *ctx, term_t t) {
     context_free_marks(ctx);
     l = code;
   }
+  timer_stop(ctx->timer + CTX_TIMER_INTERNALIZE, start);
 
   return l;
 }
 
 
+/*
+ * Convert arithmetic or bitvector term t to a theory variable in ctx
+ * - return a negative code if there's an error
+ * - return a variable (x >= 0) otherwise
+ */
+int32_t context_internalize_to_thvar(context_t *ctx, term_t t) {
+  int code;
+  thvar_t x;
+
+  assert(is_arithmetic_term(ctx->terms, t) || is_bitvector_term(ctx->terms, t));
+
+  ivector_reset(&ctx->top_eqs);
+  ivector_reset(&ctx->top_atoms);
+  ivector_reset(&ctx->top_formulas);
+  ivector_reset(&ctx->top_interns);
+  ivector_reset(&ctx->subst_eqs);
+  ivector_reset(&ctx->aux_eqs);
+
+  code = setjmp(ctx->env);
+  if (code == 0) {
+    if (is_arithmetic_term(ctx->terms, t)) {
+      x = internalize_to_arith(ctx, t);
+    } else {
+      x = internalize_to_bv(ctx, t);
+    }
+  } else {
+    assert(code < 0);
+    /*
+     * Clean up
+     */
+    ivector_reset(&ctx->aux_vector);
+    reset_istack(&ctx->istack);
+    int_queue_reset(&ctx->queue);
+    context_free_subst(ctx);
+    context_free_marks(ctx);
+    x = code;
+  }
+
+  return x;
+}
+
+
 /*
  * PROVISIONAL: FOR TESTING/DEBUGGING
  */
@@ -5976,6 +6158,14 @@ int32_t context_process_formulas(context_t *ctx, uint32_t n, term_t *f) {
       break;
     }
 
+    /*
+     * Known bits/intervals for bitvector variables
+     */
+    if (context_has_bv_solver(ctx) && context_var_elim_enabled(ctx) &&
+        context_bv_known_bits_enabled(ctx)) {
+      process_bv_known_bits(ctx);
+    }
+
     /*
      * Sharing
      */
@@ -6039,6 +6229,11 @@ void context_cleanup(context_t *ctx) {
  */
 void context_clear(context_t *ctx) {
   assert(context_supports_multichecks(ctx));
+  if (ctx->qcache != NULL && ctx->qcache->hit != NULL) {
+    // the result came from the cache: the core is still idle
+    ctx->qcache->hit = NULL;
+    return;
+  }
   smt_clear(ctx->core);
 }
 
@@ -6055,6 +6250,9 @@ void context_clear(context_t *ctx) {
  *   in a state with core base level = context base level + 1.
  */
 void context_clear_unsat(context_t *ctx) {
+  if (ctx->qcache != NULL) {
+    ctx->qcache->hit = NULL;
+  }
   if (smt_base_level(ctx->core) > ctx->base_level) {
     assert(smt_base_level(ctx->core) == ctx->base_level + 1);
     smt_clear_unsat(ctx->core);
@@ -6082,6 +6280,19 @@ int32_t assert_blocking_clause(context_t *ctx) {
   ivector_t *v;
   uint32_t i, n;
   int32_t code;
+  smt_status_t stat;
+
+  if (ctx->qcache != NULL) {
+    if (ctx->qcache->hit != NULL) {
+      // the result came from the cache: we need a real assignment
+      ctx->qcache->hit = NULL;
+      stat = check_context(ctx, &ctx->qcache->params);
+      if (stat != STATUS_SAT && stat != STATUS_UNKNOWN) {
+        return (stat == STATUS_UNSAT) ? TRIVIALLY_UNSAT : CTX_NO_ERROR;
+      }
+    }
+  }
+  context_taint_assertion_log(ctx);
 
   assert(smt_status(ctx->core) == STATUS_SAT ||
          smt_status(ctx->core) == STATUS_UNKNOWN);
@@ -6134,6 +6345,25 @@ static void ctx_mark_eq(void *aux, const pmap2_rec_t *p) {
 }
 
 
+/*
+ * Mark all the terms in the assertion log
+ */
+static void ctx_mark_assertion_log(context_t *ctx) {
+  ivector_t *v;
+  uint32_t i, j, n;
+
+  v = &ctx->assertion_log;
+  i = 0;
+  while (i < v->size) {
+    n = v->data[i];
+    for (j=1; j<=n; j++) {
+      term_table_set_gc_mark(ctx->terms, index_of(v->data[i+j]));
+    }
+    i += n + 1;
+  }
+}
+
+
 /*
  * Go through all data structures in ctx and mark all terms and types
  * that they use.
@@ -6147,6 +6377,10 @@ void context_gc_mark(context_t *ctx) {
   }
 
   intern_tbl_gc_mark(&ctx->intern);
+  ctx_mark_assertion_log(ctx);
+  if (ctx->qcache != NULL) {
+    qcache_gc_mark(ctx->qcache, ctx->terms);
+  }
 
   // empty all the term vectors to be safe
   ivector_reset(&ctx->top_eqs);
@@ -71,6 +71,26 @@ extern void context_push(context_t *ctx);
 extern void context_pop(context_t *ctx);
 
 
+/*
+ * Initialize clone as a copy of ctx
+ * - clone gets the same logic, architecture, mode, and options as ctx
+ *   and it shares ctx's term table
+ * - the formulas asserted in ctx are asserted again in clone, with
+ *   the same push levels (so clone can be popped like ctx)
+ * - if ctx's status is UNSAT, the top-level assertions are replaced
+ *   by false (in clone)
+ * - learned clauses and solver state (e.g., the model or the heuristic
+ *   scores) are not copied
+ * - ctx's status must not be SEARCHING or INTERRUPTED
+ * - all the constraints of ctx must be in its assertion log
+ *   (i.e., ctx->log_taint_level must be LOG_NO_TAINT)
+ *
+ * Return code: as in assert_formulas (i.e., CTX_NO_ERROR, TRIVIALLY_UNSAT,
+ * or a negative error code). On error, clone must still be deleted.
+ */
+extern int32_t clone_context(context_t *clone, context_t *ctx);
+
+
 
 /*************
  *  OPTIONS  *
@@ -142,6 +162,14 @@ extern int32_t assert_formulas(context_t *ctx, uint32_t n, const term_t *f);
 extern int32_t context_internalize(context_t *ctx, term_t t);
 
 
+/*
+ * Convert arithmetic or bitvector term t to a theory variable in ctx
+ * - return a negative code if there's an error
+ * - return a variable (x >= 0) otherwise.
+ */
+extern int32_t context_internalize_to_thvar(context_t *ctx, term_t t);
+
+
 /*
  * Add the blocking clause to ctx
  * - ctx->status must be either SAT or UNKNOWN
@@ -169,6 +197,138 @@ extern int32_t assert_blocking_clause(context_t *ctx);
 extern smt_status_t check_context(context_t *ctx, const param_t *parameters);
 
 
+/*
+ * Variant of check_context with a bound on the number of conflicts
+ * - the bound is checked at every restart: if it's reached, the search
+ *   stops with status STATUS_UNKNOWN
+ * - MCSAT ignores the bound
+ */
+extern smt_status_t bounded_check_context(context_t *ctx, const param_t *parameters, uint64_t max_conflicts);
+
+
+/*
+ * Variant of check_context that uses the query cache (if enabled)
+ * - if the assertions (and parameters) answer a previous query, the
+ *   result is returned without search. The context status is then
+ *   the cached status until the next call to context_clear,
+ *   context_clear_unsat, context_pop, or reset_context. If the result
+ *   is SAT, context_build_model returns the cached model.
+ * - otherwise, this calls check_context and stores the result in the
+ *   cache if it's SAT or UNSAT.
+ * - the cache is not used if constraints that are not in the assertion
+ *   log are present (e.g., blocking clauses), or if ctx uses MCSAT.
+ */
+extern smt_status_t check_context_with_cache(context_t *ctx, const param_t *parameters);
+
+
+/*
+ * Enable/disable the query cache
+ * - enabling allocates an empty cache of QCACHE_DEFAULT_SIZE entries
+ *   (if the cache is already enabled, this does nothing)
+ * - disabling deletes the cache
+ * - the context status must not be SEARCHING or INTERRUPTED
+ */
+extern void context_enable_query_cache(context_t *ctx);
+extern void context_disable_query_cache(context_t *ctx);
+
+/*
+ * Record that constraints not in the assertion log are added at the
+ * current base level (e.g., blocking clauses): the cache can't be used
+ * and the context can't be cloned until these constraints are removed
+ * by pop.
+ */
+extern void context_taint_assertion_log(context_t *ctx);
+
+
+/*
+ * Optimize objectives obj[0 ... n-1] in lexicographic order
+ * - each obj[i] must be an arithmetic or bitvector term
+ * - maximize[i] is true to maximize obj[i], false to minimize it
+ *   (bitvector objectives are interpreted as unsigned integers)
+ * - ctx must support push/pop and its status must be IDLE
+ * - parameters = search parameters used for every check (or NULL)
+ *
+ * The optimization is done in a new push level, where the objectives
+ * are internalized. Then each improved
+ * solution is followed by a tighter bound on the current objective
+ * until the constraints become unsat. The optimal value is then fixed
+ * before moving on to the next objective. Once an objective is
+ * unbounded or its optimum is not attained, the remaining objectives
+ * are not optimized.
+ *
+ * On exit, the context is restored to its state before the call
+ * (with status IDLE), unless the search was interrupted and the
+ * context does not support clean interrupts.
+ *
+ * Return status:
+ * - STATUS_SAT: result[i] stores the status of each objective and
+ *   model stores the optimal solution (model must be initialized and empty)
+ * - STATUS_UNSAT: the assertions are unsat
+ * - STATUS_UNKNOWN or STATUS_INTERRUPTED: the optimization could not
+ *   be completed (the model is not built).
+ * - STATUS_ERROR: an objective could not be internalized. The
+ *   internalization code is stored in *error.
+ */
+extern smt_status_t optimize_context(context_t *ctx, const param_t *parameters, uint32_t n, const term_t *obj,
+                                     const bool *maximize, objective_status_t *result, model_t *model,
+                                     int32_t *error);
+
+
+/*
+ * Enumerate the models of ctx projected on terms t[0 ... n-1]
+ * - each t[i] must be a Boolean, arithmetic, or bitvector term already
+ *   internalized: map[i] is the literal mapped to t[i] if t[i] is Boolean,
+ *   or the theory variable mapped to t[i] otherwise
+ * - ctx must support multiple checks and its status must be IDLE
+ * - max_models = bound on the number of models (0 means no bound)
+ * - parameters = search parameters used for every check (or NULL)
+ *
+ * For each model found, the values of t[0 ... n-1] are added to v
+ * (as n constant terms) then a clause that blocks these values is
+ * added to ctx. The blocking clauses are kept in ctx on exit.
+ *
+ * Return status:
+ * - STATUS_UNSAT: all models were enumerated (the context status is UNSAT)
+ * - STATUS_SAT: max_models were found (the context status is IDLE)
+ * - STATUS_UNKNOWN or STATUS_INTERRUPTED: the enumeration could not
+ *   be completed.
+ */
+extern smt_status_t enumerate_context(context_t *ctx, const param_t *parameters, uint32_t n, const term_t *t,
+                                      const int32_t *map, uint32_t max_models, ivector_t *v);
+
+
+/*
+ * Cube-and-conquer check
+ * - ctx must support push/pop and its status must be IDLE
+ * - depth = maximal number of literals in the initial cubes (if depth
+ *   is 0, the search starts with a single empty cube)
+ * - nworkers = number of cubes solved in parallel (each in a forked
+ *   process); if nworkers <= 1 or fork is not available, the cubes are
+ *   solved one after the other in ctx
+ * - max_conflicts = conflict budget for each cube: a cube that's not
+ *   solved within this budget is split again (max_conflicts = 0 means
+ *   no budget)
+ * - parameters = search parameters used for every check (or NULL)
+ *
+ * The cubes are generated by smt_lookahead_cubes on the Boolean
+ * skeleton. Each cube is solved by asserting its literals in a new
+ * push level. The search stops on the first satisfiable cube.
+ *
+ * On exit, the context is restored to its state before the call
+ * (with status IDLE), except if the assertions are unsat at the base
+ * level (then the context status is UNSAT), or if the search is
+ * interrupted and clean interrupt is not supported.
+ *
+ * Return status:
+ * - STATUS_SAT: model stores a model of the assertions (model must be
+ *   initialized and empty)
+ * - STATUS_UNSAT: all cubes are unsat
+ * - STATUS_UNKNOWN or STATUS_INTERRUPTED: a cube could not be solved
+ */
+extern smt_status_t cube_and_conquer_context(context_t *ctx, const param_t *parameters, uint32_t depth,
+                                             uint32_t nworkers, uint64_t max_conflicts, model_t *model);
+
+
 /*
  * Build a model: the context's status must be STATUS_SAT or STATUS_UNKNOWN
  * - model must be initialized (and empty)
@@ -274,7 +434,9 @@ extern int32_t context_process_formulas(context_t *ctx, uint32_t n, term_t *f);
  *  STATUS_INTERRUPTED
  */
 static inline smt_status_t context_status(context_t *ctx) {
-  if (ctx->arch == CTX_ARCH_MCSAT) {
+  if (ctx->qcache != NULL && ctx->qcache->hit != NULL) {
+    return ctx->qcache->hit->status;
+  } else if (ctx->arch == CTX_ARCH_MCSAT) {
     return mcsat_status(ctx->mcsat);
   } else {
     return smt_status(ctx->core);
@@ -0,0 +1,707 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * CUBE AND CONQUER
+ *
+ * The cubes are conjunctions of literals of the smt_core, generated by
+ * lookahead on the Boolean skeleton (cf. smt_lookahead_cubes). Each
+ * cube is solved in a new push level L+1 of the context (where L is
+ * the base level on entry): its literals are added as unit clauses,
+ * then the context is checked with a conflict budget. A cube that's not
+ * solved within the budget is split again by lookahead under the cube,
+ * and the new cubes are added to the work queue.
+ *
+ * The cubes only contain literals of variables that exist at level L
+ * so they are not removed when a cube's level is popped.
+ *
+ * In parallel mode, each cube is solved in a forked process. The
+ * worker reports the result through a pipe. The parent doesn't rely
+ * on the exit status because the host program may ignore SIGCHLD or
+ * reap the children itself. When a worker finds a satisfiable cube,
+ * the other workers are killed and the cube is solved again in ctx
+ * to build the model.
+ */
+
+#include <assert.h>
+
+#ifndef MINGW
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "context/context.h"
+#include "context/context_utils.h"
+#include "utils/int_queues.h"
+#include "utils/int_vectors.h"
+#include "utils/memalloc.h"
+
+
+/*
+ * Number of literals added to a cube when it's split again,
+ * and bound on the cube size: larger cubes are solved without budget.
+ */
+#define RESPLIT_DEPTH 2
+#define MAX_CUBE_EXTENSION 16
+
+
+/*
+ * Result of solving a cube
+ */
+typedef enum cube_result {
+  CUBE_SAT,
+  CUBE_UNSAT,
+  CUBE_UNKNOWN,
+  CUBE_BUDGET,        // budget exhausted
+  CUBE_INTERRUPTED,
+} cube_result_t;
+
+
+/*
+ * Cube solver:
+ * - level = base level of ctx on entry
+ * - max_conflicts = budget per cube (0 means no budget)
+ * - max_size = cubes of this size or more are solved without budget
+ * - cubes = all the cubes: each cube is stored as its size,
+ *   followed by its literals
+ * - queue = index in cubes of the cubes to solve
+ * - aux = buffer for the lookahead
+ */
+typedef struct cube_solver_s {
+  context_t *ctx;
+  const param_t *params;
+  uint32_t level;
+  uint64_t max_conflicts;
+  uint32_t max_size;
+  ivector_t cubes;
+  int_queue_t queue;
+  ivector_t aux;
+} cube_solver_t;
+
+
+static void init_cube_solver(cube_solver_t *cs, context_t *ctx, const param_t *params,
+                             uint32_t depth, uint64_t max_conflicts) {
+  cs->ctx = ctx;
+  cs->params = params;
+  cs->level = context_base_level(ctx);
+  cs->max_conflicts = max_conflicts;
+  cs->max_size = depth + MAX_CUBE_EXTENSION;
+  init_ivector(&cs->cubes, 0);
+  init_int_queue(&cs->queue, 0);
+  init_ivector(&cs->aux, 0);
+}
+
+static void delete_cube_solver(cube_solver_t *cs) {
+  delete_ivector(&cs->cubes);
+  delete_int_queue(&cs->queue);
+  delete_ivector(&cs->aux);
+}
+
+
+/*
+ * Cube stored at index i in cs->cubes
+ */
+static inline uint32_t cube_size(cube_solver_t *cs, int32_t i) {
+  return cs->cubes.data[i];
+}
+
+static inline literal_t *cube_literals(cube_solver_t *cs, int32_t i) {
+  return cs->cubes.data + i + 1;
+}
+
+
+/*
+ * Add cubes: for each cube c in cs->aux, add the cube prefix + c
+ * to cs->cubes and to the queue.
+ * - prefix = literals of a cube of size n
+ * - prefix may point into cs->cubes: it must be copied first
+ */
+static void add_cubes(cube_solver_t *cs, uint32_t n, const literal_t *prefix) {
+  ivector_t *v;
+  literal_t *a;
+  uint32_t i, k;
+
+  a = NULL;
+  if (n > 0) {
+    a = (literal_t *) safe_malloc(n * sizeof(literal_t));
+    for (i=0; i<n; i++) a[i] = prefix[i];
+  }
+
+  v = &cs->aux;
+  i = 0;
+  while (i < v->size) {
+    k = v->data[i];
+    int_queue_push(&cs->queue, cs->cubes.size);
+    ivector_push(&cs->cubes, n + k);
+    ivector_add(&cs->cubes, a, n);
+    ivector_add(&cs->cubes, v->data + i + 1, k);
+    i += k + 1;
+  }
+
+  safe_free(a);
+}
+
+
+/*
+ * Restore ctx to its base level on entry
+ * - if the search was interrupted and clean interrupt is not supported,
+ *   we can't do anything: the context must be reset.
+ */
+static void restore_base_level(cube_solver_t *cs) {
+  context_t *ctx;
+
+  ctx = cs->ctx;
+  if (context_base_level(ctx) > cs->level) {
+    switch (context_status(ctx)) {
+    case STATUS_SAT:
+    case STATUS_UNKNOWN:
+      context_clear(ctx);
+      break;
+
+    case STATUS_UNSAT:
+      context_clear_unsat(ctx);
+      break;
+
+    case STATUS_INTERRUPTED:
+      if (! context_supports_cleaninterrupt(ctx)) return;
+      context_cleanup(ctx);
+      break;
+
+    default:
+      break;
+    }
+
+    while (context_base_level(ctx) > cs->level) {
+      context_pop(ctx);
+    }
+  }
+}
+
+
+/*
+ * Push a new level and assert the literals of cube i
+ * - return false if one of them is false at the base level
+ */
+static bool open_cube(cube_solver_t *cs, int32_t i) {
+  context_t *ctx;
+  literal_t *a;
+  uint32_t j, n;
+
+  ctx = cs->ctx;
+  assert(context_status(ctx) == STATUS_IDLE && context_base_level(ctx) == cs->level);
+
+  context_push(ctx);
+  internalization_start(ctx->core);
+
+  n = cube_size(cs, i);
+  a = cube_literals(cs, i);
+  for (j=0; j<n; j++) {
+    if (literal_value(ctx->core, a[j]) == VAL_FALSE) {
+      return false;
+    }
+  }
+  for (j=0; j<n; j++) {
+    add_unit_clause(ctx->core, a[j]);
+  }
+
+  return true;
+}
+
+
+/*
+ * Lookahead from the current base level of ctx
+ * - depth = maximal number of literals per cube
+ * - the cubes are stored in cs->aux
+ * - return STATUS_UNSAT if propagation or lookahead shows that the
+ *   assertions are unsat. If propagation alone finds the conflict,
+ *   the context status is UNSAT, otherwise it's IDLE.
+ * - return STATUS_UNKNOWN otherwise (the context status is IDLE)
+ * - return STATUS_INTERRUPTED if the search is interrupted
+ *
+ * Only variables that survive context_clear and context_pop are used
+ * for splitting. Variables created by start_search (e.g., by bit
+ * blasting) are kept if we're at the entry level and clean interrupt
+ * is disabled.
+ */
+static smt_status_t lookahead(cube_solver_t *cs, uint32_t depth) {
+  context_t *ctx;
+  smt_core_t *core;
+  smt_status_t stat;
+  uint32_t max_var, n;
+
+  ctx = cs->ctx;
+  core = ctx->core;
+  ivector_reset(&cs->aux);
+
+  max_var = num_vars(core);
+  start_search(core);
+  smt_process(core);
+  stat = smt_status(core);
+  if (stat == STATUS_SEARCHING) {
+    if (context_base_level(ctx) == cs->level && !context_supports_cleaninterrupt(ctx)) {
+      max_var = num_vars(core);
+    }
+    n = smt_lookahead_cubes(core, max_var, depth, DEF_LOOKAHEAD_CANDIDATES, &cs->aux);
+    end_search_unknown(core);
+    context_clear(ctx);
+    stat = (n == 0) ? STATUS_UNSAT : STATUS_UNKNOWN;
+  }
+
+  return stat;
+}
+
+
+/*
+ * Split cube i: lookahead under the cube then add the new cubes to the queue
+ */
+static smt_status_t split_cube(cube_solver_t *cs, int32_t i) {
+  smt_status_t stat;
+
+  stat = STATUS_UNSAT;
+  if (open_cube(cs, i)) {
+    stat = lookahead(cs, RESPLIT_DEPTH);
+    if (stat == STATUS_UNKNOWN) {
+      add_cubes(cs, cube_size(cs, i), cube_literals(cs, i));
+    }
+  }
+  restore_base_level(cs);
+
+  return stat;
+}
+
+
+/*
+ * Check whether cube i must be solved with a conflict budget
+ */
+static bool cube_is_bounded(cube_solver_t *cs, int32_t i) {
+  return cs->max_conflicts > 0 && cube_size(cs, i) < cs->max_size;
+}
+
+/*
+ * Solve cube i in ctx
+ * - bounded: true to use the conflict budget
+ * - if the result is CUBE_SAT, the context is left in the cube's push
+ *   level with status SAT. Otherwise, it's restored to cs->level.
+ */
+static cube_result_t solve_cube(cube_solver_t *cs, int32_t i, bool bounded) {
+  context_t *ctx;
+  smt_status_t stat;
+  cube_result_t r;
+
+  ctx = cs->ctx;
+  if (! open_cube(cs, i)) {
+    restore_base_level(cs);
+    return CUBE_UNSAT;
+  }
+
+  stat = bounded_check_context(ctx, cs->params, bounded ? cs->max_conflicts : UINT64_MAX);
+  switch (stat) {
+  case STATUS_SAT:
+    return CUBE_SAT;
+
+  case STATUS_UNSAT:
+    r = CUBE_UNSAT;
+    break;
+
+  case STATUS_UNKNOWN:
+    r = CUBE_UNKNOWN;
+    if (bounded && !ctx->mem_limit_reached && num_conflicts(ctx->core) >= cs->max_conflicts) {
+      r = CUBE_BUDGET;
+    }
+    break;
+
+  default:
+    assert(stat == STATUS_INTERRUPTED);
+    r = CUBE_INTERRUPTED;
+    break;
+  }
+
+  restore_base_level(cs);
+
+  return r;
+}
+
+
+/*
+ * Build the model for cube i
+ * - i must be a satisfiable cube
+ * - if solved is true, the context status is already SAT for this cube
+ * - return STATUS_SAT if the model is built, otherwise the status
+ *   of the check
+ */
+static smt_status_t build_cube_model(cube_solver_t *cs, int32_t i, bool solved, model_t *model) {
+  smt_status_t stat;
+
+  stat = STATUS_SAT;
+  if (! solved) {
+    switch (solve_cube(cs, i, false)) {
+    case CUBE_SAT: break;
+    case CUBE_INTERRUPTED: return STATUS_INTERRUPTED;
+    default: return STATUS_UNKNOWN;
+    }
+  }
+
+  assert(context_status(cs->ctx) == STATUS_SAT);
+  context_build_model(model, cs->ctx);
+  restore_base_level(cs);
+
+  return stat;
+}
+
+
+
+/*
+ * SEQUENTIAL CONQUER
+ */
+
+/*
+ * Solve the cubes in the queue one after the other
+ * - stop on the first satisfiable cube and build the model
+ */
+static smt_status_t conquer(cube_solver_t *cs, model_t *model) {
+  smt_status_t result, stat;
+  int32_t i;
+
+  result = STATUS_UNSAT;
+  while (! int_queue_is_empty(&cs->queue)) {
+    i = int_queue_pop(&cs->queue);
+    switch (solve_cube(cs, i, cube_is_bounded(cs, i))) {
+    case CUBE_SAT:
+      return build_cube_model(cs, i, true, model);
+
+    case CUBE_UNSAT:
+      break;
+
+    case CUBE_UNKNOWN:
+      result = STATUS_UNKNOWN;
+      break;
+
+    case CUBE_BUDGET:
+      stat = split_cube(cs, i);
+      if (stat == STATUS_INTERRUPTED) return stat;
+      break;
+
+    case CUBE_INTERRUPTED:
+      return STATUS_INTERRUPTED;
+    }
+  }
+
+  return result;
+}
+
+
+
+#ifndef MINGW
+
+/*
+ * PARALLEL CONQUER
+ */
+
+/*
+ * Worker slot:
+ * - pid = worker process id (or -1 if the slot is free)
+ * - cube = index of the cube solved by this worker
+ */
+typedef struct worker_s {
+  pid_t pid;
+  int32_t cube;
+} worker_t;
+
+/*
+ * Message sent by a worker to the parent when it's done
+ * - slot = index of the worker slot
+ * - result = the cube result
+ * This is smaller than PIPE_BUF so the write is atomic.
+ */
+typedef struct worker_msg_s {
+  uint32_t slot;
+  int32_t result;
+} worker_msg_t;
+
+
+/*
+ * Code executed by the worker for cube i
+ * - slot = index of the worker slot
+ * - fd = write end of the pipe
+ */
+static void run_worker(cube_solver_t *cs, uint32_t slot, int32_t i, int fd) {
+  worker_msg_t msg;
+  ssize_t w;
+
+  msg.slot = slot;
+  msg.result = CUBE_UNKNOWN;
+  switch (solve_cube(cs, i, cube_is_bounded(cs, i))) {
+  case CUBE_SAT: msg.result = CUBE_SAT; break;
+  case CUBE_UNSAT: msg.result = CUBE_UNSAT; break;
+  case CUBE_BUDGET: msg.result = CUBE_BUDGET; break;
+  default: break;
+  }
+
+  do {
+    w = write(fd, &msg, sizeof(msg));
+  } while (w < 0 && errno == EINTR);
+  // if the write failed, the parent treats this worker as lost
+
+  _exit(0);
+}
+
+
+/*
+ * Wait for process pid to terminate
+ * - if the process is not our child anymore (ECHILD), because SIGCHLD
+ *   is ignored or the host program reaped it, there's nothing to wait for
+ */
+static void reap_worker(pid_t pid) {
+  pid_t r;
+  int status;
+
+  do {
+    r = waitpid(pid, &status, 0);
+  } while (r < 0 && errno == EINTR);
+}
+
+
+/*
+ * Kill and wait for all the active workers
+ */
+static void kill_workers(worker_t *w, uint32_t n) {
+  uint32_t i;
+
+  for (i=0; i<n; i++) {
+    if (w[i].pid > 0) {
+      kill(w[i].pid, SIGKILL);
+      reap_worker(w[i].pid);
+      w[i].pid = -1;
+    }
+  }
+}
+
+
+/*
+ * Check whether there's something to read in fd, waiting at most timeout ms
+ */
+static bool pipe_ready(int fd, int timeout) {
+  struct pollfd p;
+
+  p.fd = fd;
+  p.events = POLLIN;
+  p.revents = 0;
+  return poll(&p, 1, timeout) > 0 && (p.revents & POLLIN);
+}
+
+
+/*
+ * Check whether worker pid has terminated
+ * - waitpid fails with ECHILD if the worker was reaped by someone else
+ *   (or automatically because SIGCHLD is ignored)
+ */
+static bool worker_is_gone(pid_t pid) {
+  pid_t r;
+  int status;
+
+  do {
+    r = waitpid(pid, &status, WNOHANG);
+  } while (r < 0 && errno == EINTR);
+
+  return r == pid || (r < 0 && errno == ECHILD);
+}
+
+
+/*
+ * Wait for a worker to finish
+ * - fd = read end of the pipe
+ * - return the index of the worker slot and store its result in *r
+ *
+ * A worker that terminates without sending a result (e.g., it crashed
+ * or was killed) is reported as CUBE_UNKNOWN. A worker writes its
+ * message before it exits, so if it's gone, the message (if any) is
+ * already in the pipe.
+ */
+static uint32_t wait_for_worker(worker_t *w, uint32_t n, int fd, cube_result_t *r) {
+  worker_msg_t msg;
+  uint32_t i;
+  ssize_t k;
+
+  for (;;) {
+    if (pipe_ready(fd, 100)) {
+      do {
+        k = read(fd, &msg, sizeof(msg));
+      } while (k < 0 && errno == EINTR);
+      if (k == sizeof(msg) && msg.slot < n && w[msg.slot].pid > 0) {
+        i = msg.slot;
+        reap_worker(w[i].pid);
+        w[i].pid = -1;
+        *r = (cube_result_t) msg.result;
+        return i;
+      }
+      continue;
+    }
+
+    // no message: check for workers that terminated without one
+    for (i=0; i<n; i++) {
+      if (w[i].pid > 0 && worker_is_gone(w[i].pid)) {
+        if (pipe_ready(fd, 0)) break; // read the pending messages first
+        w[i].pid = -1;
+        *r = CUBE_UNKNOWN;
+        return i;
+      }
+    }
+  }
+}
+
+
+/*
+ * Solve the cubes using at most nworkers processes
+ * - if fork fails, the cube is solved in ctx
+ */
+static smt_status_t parallel_conquer(cube_solver_t *cs, uint32_t nworkers, model_t *model) {
+  smt_status_t result, stat;
+  worker_t *w;
+  cube_result_t r;
+  uint32_t i, nactive;
+  int32_t cube;
+  pid_t pid;
+  int fd[2];
+  bool solved;
+
+  if (pipe(fd) < 0) {
+    return conquer(cs, model);
+  }
+
+  w = (worker_t *) safe_malloc(nworkers * sizeof(worker_t));
+  for (i=0; i<nworkers; i++) {
+    w[i].pid = -1;
+    w[i].cube = -1;
+  }
+  nactive = 0;
+  result = STATUS_UNSAT;
+
+  for (;;) {
+    // start new workers
+    i = 0;
+    while (nactive < nworkers && ! int_queue_is_empty(&cs->queue)) {
+      while (w[i].pid > 0) i ++;
+      cube = int_queue_pop(&cs->queue);
+      pid = fork();
+      if (pid == 0) {
+        close(fd[0]);
+        run_worker(cs, i, cube, fd[1]);
+      }
+      if (pid < 0) {
+        // put the cube back and wait for a worker or solve it here
+        int_queue_push(&cs->queue, cube);
+        break;
+      }
+      w[i].pid = pid;
+      w[i].cube = cube;
+      nactive ++;
+    }
+
+    if (nactive == 0) {
+      if (int_queue_is_empty(&cs->queue)) break;
+      // fork failed with no active workers
+      cube = int_queue_pop(&cs->queue);
+      r = solve_cube(cs, cube, cube_is_bounded(cs, cube));
+      solved = true;
+    } else {
+      i = wait_for_worker(w, nworkers, fd[0], &r);
+      nactive --;
+      cube = w[i].cube;
+      solved = false;
+    }
+
+    switch (r) {
+    case CUBE_SAT:
+      kill_workers(w, nworkers);
+      result = build_cube_model(cs, cube, solved, model);
+      goto done;
+
+    case CUBE_UNSAT:
+      break;
+
+    case CUBE_UNKNOWN:
+      result = STATUS_UNKNOWN;
+      break;
+
+    case CUBE_BUDGET:
+      stat = split_cube(cs, cube);
+      if (stat == STATUS_INTERRUPTED) {
+        kill_workers(w, nworkers);
+        result = stat;
+        goto done;
+      }
+      break;
+
+    case CUBE_INTERRUPTED:
+      kill_workers(w, nworkers);
+      result = STATUS_INTERRUPTED;
+      goto done;
+    }
+  }
+
+ done:
+  safe_free(w);
+  close(fd[0]);
+  close(fd[1]);
+
+  return result;
+}
+
+#endif
+
+
+
+/*
+ * MAIN FUNCTION
+ */
+smt_status_t cube_and_conquer_context(context_t *ctx, const param_t *parameters, uint32_t depth,
+                                      uint32_t nworkers, uint64_t max_conflicts, model_t *model) {
+  cube_solver_t cs;
+  smt_status_t stat;
+
+  assert(context_supports_pushpop(ctx) && ctx->mcsat == NULL);
+  assert(context_status(ctx) == STATUS_IDLE);
+
+  init_cube_solver(&cs, ctx, parameters, depth, max_conflicts);
+
+  // initial cubes: a base-level conflict is kept in ctx
+  stat = lookahead(&cs, depth);
+  if (stat == STATUS_UNKNOWN) {
+    add_cubes(&cs, 0, NULL);
+#ifndef MINGW
+    if (nworkers > 1) {
+      stat = parallel_conquer(&cs, nworkers, model);
+    } else {
+      stat = conquer(&cs, model);
+    }
+#else
+    stat = conquer(&cs, model);
+#endif
+    restore_base_level(&cs);
+  } else if (stat == STATUS_INTERRUPTED && context_supports_cleaninterrupt(ctx)) {
+    context_cleanup(ctx);
+  }
+
+  delete_cube_solver(&cs);
+
+  return stat;
+}
@@ -0,0 +1,258 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * ENUMERATION OF PROJECTED MODELS (ALL-SAT)
+ *
+ * Given projection terms t[0 ... n-1], we repeatedly check the context
+ * and, after each satisfying assignment, we block the values of
+ * t[0 ... n-1] by adding a clause directly to the core:
+ * - for a Boolean term t mapped to literal l, the clause contains l
+ *   if t is false and (not l) if t is true.
+ * - for an arithmetic or bitvector term t mapped to variable x, the
+ *   clause contains not (x == c) where c is the value of x.
+ * The clause is added at the current base level as a problem clause,
+ * so it's never deleted by the clause-database reduction. Learned
+ * clauses and the heuristic state are kept from one check to the next.
+ *
+ * Literals that are false at the base level are removed from the
+ * blocking clause: they can't be true in any later model.
+ */
+
+#include <assert.h>
+
+#include "context/context.h"
+#include "context/context_utils.h"
+#include "terms/bv_constants.h"
+#include "terms/rationals.h"
+
+
+/*
+ * Value of x in the current assignment, converted to a constant term
+ * - return NULL_TERM if the solver can't produce it
+ * - the arithmetic or bitvector model must be built
+ * - for bitvectors, t = term mapped to x
+ */
+static term_t arith_value_term(context_t *ctx, thvar_t x, rational_t *q) {
+  if (! ctx->arith.value_in_model(ctx->arith_solver, x, q)) {
+    return NULL_TERM;
+  }
+  q_normalize(q);
+  return arith_constant(ctx->terms, q);
+}
+
+static term_t bv_value_term(context_t *ctx, term_t t, thvar_t x, bvconstant_t *c) {
+  uint32_t n;
+
+  if (! ctx->bv.value_in_model(ctx->bv_solver, x, c)) {
+    return NULL_TERM;
+  }
+  n = term_bitsize(ctx->terms, t);
+  assert(c->bitsize == n);
+  bvconst_normalize(c->data, n);
+  if (n <= 32) {
+    return bv64_constant(ctx->terms, n, bvconst_get32(c->data));
+  }
+  if (n <= 64) {
+    return bv64_constant(ctx->terms, n, bvconst_get64(c->data));
+  }
+  return bvconst_term(ctx->terms, n, c->data);
+}
+
+
+/*
+ * Store the values of t[0 ... n-1] at the end of vector v
+ * - return false if a value is missing
+ */
+static bool collect_projected_values(context_t *ctx, uint32_t n, const term_t *t, const int32_t *map, ivector_t *v) {
+  term_table_t *terms;
+  rational_t q;
+  bvconstant_t c;
+  bool has_arith, has_bv, ok;
+  uint32_t i;
+  term_t a;
+
+  terms = ctx->terms;
+
+  has_arith = false;
+  has_bv = false;
+  for (i=0; i<n; i++) {
+    if (is_arithmetic_term(terms, t[i])) {
+      has_arith = true;
+    } else if (is_bitvector_term(terms, t[i])) {
+      has_bv = true;
+    }
+  }
+
+  if (has_arith) ctx->arith.build_model(ctx->arith_solver);
+  if (has_bv) ctx->bv.build_model(ctx->bv_solver);
+
+  q_init(&q);
+  init_bvconstant(&c);
+  ok = true;
+  for (i=0; i<n; i++) {
+    if (is_boolean_term(terms, t[i])) {
+      a = bool2term(literal_value(ctx->core, map[i]) == VAL_TRUE);
+    } else if (is_arithmetic_term(terms, t[i])) {
+      a = arith_value_term(ctx, map[i], &q);
+    } else {
+      assert(is_bitvector_term(terms, t[i]));
+      a = bv_value_term(ctx, t[i], map[i], &c);
+    }
+    if (a == NULL_TERM) {
+      ok = false;
+      break;
+    }
+    ivector_push(v, a);
+  }
+  delete_bvconstant(&c);
+  q_clear(&q);
+
+  if (has_arith) ctx->arith.free_model(ctx->arith_solver);
+  if (has_bv) ctx->bv.free_model(ctx->bv_solver);
+
+  return ok;
+}
+
+
+/*
+ * Literal for (x == c) where c is the constant term for the value of x
+ * - t = term mapped to x
+ */
+static literal_t arith_value_atom(context_t *ctx, term_t t, thvar_t x, term_t c) {
+  polynomial_t *p;
+  rational_t *q;
+  thvar_t map[2];
+  uint32_t i;
+
+  // p = -c + x
+  q = rational_term_desc(ctx->terms, c);
+  p = context_get_aux_poly(ctx, 3);
+  i = 0;
+  if (q_is_nonzero(q)) {
+    p->mono[0].var = const_idx;
+    q_set_neg(&p->mono[0].coeff, q);
+    map[0] = null_thvar;
+    i = 1;
+  }
+  p->mono[i].var = t;
+  q_set_one(&p->mono[i].coeff);
+  map[i] = x;
+  p->mono[i+1].var = max_idx;
+  p->nterms = i+1;
+
+  return ctx->arith.create_poly_eq_atom(ctx->arith_solver, p, map);
+}
+
+static literal_t bv_value_atom(context_t *ctx, thvar_t x, term_t c) {
+  thvar_t y;
+
+  if (term_kind(ctx->terms, c) == BV64_CONSTANT) {
+    y = ctx->bv.create_const64(ctx->bv_solver, bvconst64_term_desc(ctx->terms, c));
+  } else {
+    y = ctx->bv.create_const(ctx->bv_solver, bvconst_term_desc(ctx->terms, c));
+  }
+
+  return ctx->bv.create_eq_atom(ctx->bv_solver, x, y);
+}
+
+
+/*
+ * Build the blocking clause for values val[0 ... n-1] and add it to the core
+ * - the context must be ready for new assertions (status IDLE)
+ * - return false if the clause is empty (then the core status is set to UNSAT)
+ */
+static bool add_projected_blocking_clause(context_t *ctx, uint32_t n, const term_t *t, const int32_t *map, const term_t *val) {
+  term_table_t *terms;
+  ivector_t *v;
+  uint32_t i;
+  literal_t l;
+  bool empty;
+
+  terms = ctx->terms;
+  v = &ctx->aux_vector;
+  assert(v->size == 0);
+
+  for (i=0; i<n; i++) {
+    if (is_boolean_term(terms, t[i])) {
+      l = map[i];
+      if (val[i] == true_term) {
+        l = not(l);
+      }
+    } else if (is_arithmetic_term(terms, t[i])) {
+      l = not(arith_value_atom(ctx, t[i], map[i], val[i]));
+    } else {
+      l = not(bv_value_atom(ctx, map[i], val[i]));
+    }
+    if (literal_base_value(ctx->core, l) != VAL_FALSE) {
+      ivector_push(v, l);
+    }
+  }
+
+  empty = (v->size == 0);
+  if (empty) {
+    ctx->core->status = STATUS_UNSAT;
+  } else {
+    add_clause(ctx->core, v->size, v->data);
+  }
+  ivector_reset(v);
+
+  return !empty;
+}
+
+
+/*
+ * Enumerate the projected models
+ */
+smt_status_t enumerate_context(context_t *ctx, const param_t *parameters, uint32_t n, const term_t *t,
+                               const int32_t *map, uint32_t max_models, ivector_t *v) {
+  smt_status_t stat;
+  uint32_t count, k;
+
+  assert(context_status(ctx) == STATUS_IDLE);
+
+  count = 0;
+  for (;;) {
+    stat = check_context(ctx, parameters);
+    if (stat != STATUS_SAT) break;
+
+    k = v->size;
+    if (! collect_projected_values(ctx, n, t, map, v)) {
+      // can't get a value: give up
+      ivector_shrink(v, k);
+      stat = STATUS_UNKNOWN;
+      break;
+    }
+    count ++;
+
+    context_clear(ctx);
+    context_taint_assertion_log(ctx);
+    internalization_start(ctx->core);
+    if (! add_projected_blocking_clause(ctx, n, t, map, v->data + k)) {
+      stat = STATUS_UNSAT;
+      break;
+    }
+
+    if (count == max_models) {
+      assert(context_status(ctx) == STATUS_IDLE);
+      break;
+    }
+  }
+
+  return stat;
+}
@@ -0,0 +1,86 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * MEMORY ACCOUNTING
+ */
+
+#include "context/context.h"
+#include "context/context_memory.h"
+#include "solvers/bv/bvsolver.h"
+#include "solvers/egraph/egraph.h"
+#include "solvers/simplex/simplex.h"
+
+
+void context_mem_usage(context_t *ctx, ctx_mem_usage_t *u) {
+  u->core = 0;
+  u->egraph = 0;
+  u->simplex = 0;
+  u->bv = 0;
+  u->bitblaster = 0;
+  u->cache = 0;
+
+  if (ctx->core != NULL) {
+    u->core = smt_core_mem_size(ctx->core);
+  }
+  if (context_has_egraph(ctx)) {
+    u->egraph = egraph_mem_size(ctx->egraph);
+  }
+  if (context_has_simplex_solver(ctx)) {
+    u->simplex = simplex_mem_size(ctx->arith_solver);
+  }
+  if (context_has_bv_solver(ctx)) {
+    u->bv = bv_solver_mem_size(ctx->bv_solver);
+    u->bitblaster = bv_solver_blaster_mem_size(ctx->bv_solver);
+  }
+  if (ctx->qcache != NULL) {
+    u->cache = qcache_mem_size(ctx->qcache);
+  }
+
+  u->total = u->core + u->egraph + u->simplex + u->bv + u->bitblaster + u->cache;
+}
+
+
+uint64_t context_mem_size(context_t *ctx) {
+  ctx_mem_usage_t u;
+
+  context_mem_usage(ctx, &u);
+  return u.total;
+}
+
+
+void context_reduce_memory(context_t *ctx) {
+  if (ctx->core != NULL) {
+    purge_learned_clauses(ctx->core);
+  }
+  if (context_has_egraph(ctx)) {
+    egraph_flush_expl_cache(ctx->egraph);
+  }
+  if (ctx->qcache != NULL) {
+    qcache_clear(ctx->qcache);
+  }
+}
+
+
+bool context_over_memory_limit(context_t *ctx, uint64_t limit) {
+  if (context_mem_size(ctx) <= limit) {
+    return false;
+  }
+  context_reduce_memory(ctx);
+  return context_mem_size(ctx) > limit;
+}
@@ -0,0 +1,90 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * MEMORY ACCOUNTING
+ *
+ * Estimates of the memory used by the components of a context, and
+ * support for the soft memory limit (search parameter memory_limit).
+ *
+ * The estimates are computed from the sizes of the main arrays and
+ * tables in each component. They do not include GMP numbers, small
+ * auxiliary buffers, or the solvers that are not listed below (the
+ * difference-logic solvers, the array solver, and mcsat).
+ */
+
+#ifndef __CONTEXT_MEMORY_H
+#define __CONTEXT_MEMORY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "context/context_types.h"
+
+
+/*
+ * Memory usage (in bytes)
+ * - core = smt_core: clause database, variable and literal arrays
+ * - egraph = egraph: terms, classes, stacks, explanation cache
+ * - simplex = simplex solver: tableau, variables, atoms, bounds
+ * - bv = bitvector solver: variables, atoms, remap table
+ * - bitblaster = gate table of the bit-blaster
+ * - cache = query cache
+ * - total = sum of the above
+ *
+ * The fields of absent components are zero.
+ */
+typedef struct ctx_mem_usage_s {
+  uint64_t core;
+  uint64_t egraph;
+  uint64_t simplex;
+  uint64_t bv;
+  uint64_t bitblaster;
+  uint64_t cache;
+  uint64_t total;
+} ctx_mem_usage_t;
+
+
+/*
+ * Compute the memory usage of ctx and store it in *u
+ */
+extern void context_mem_usage(context_t *ctx, ctx_mem_usage_t *u);
+
+/*
+ * Total memory usage of ctx (i.e., u->total)
+ */
+extern uint64_t context_mem_size(context_t *ctx);
+
+/*
+ * Free memory in ctx:
+ * - delete the learned clauses that are not locked
+ * - empty the egraph's explanation cache and the query cache
+ */
+extern void context_reduce_memory(context_t *ctx);
+
+/*
+ * Check whether ctx is above its memory limit
+ * - limit = limit in bytes
+ * - if the memory usage is more than limit, call context_reduce_memory
+ *   then check again.
+ * - return true if the memory usage is still more than limit.
+ */
+extern bool context_over_memory_limit(context_t *ctx, uint64_t limit);
+
+
+#endif /* __CONTEXT_MEMORY_H */
@@ -0,0 +1,522 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * OPTIMIZATION OF ARITHMETIC AND BITVECTOR OBJECTIVES
+ *
+ * Objectives are optimized one after the other (lexicographic order).
+ * All the work is done in a new push level L of the context:
+ * - each candidate bound on the current objective is asserted in
+ *   level L+1 and checked; if it's sat, we get a better solution,
+ *   otherwise the previous solution was optimal.
+ * - once the optimum is known, it's asserted as a bound in level L
+ *   before moving on to the next objective.
+ *
+ * For arithmetic objectives, the simplex solver is used to optimize the
+ * objective in the current branch (i.e., for the bounds of the last
+ * satisfying assignment). The next candidate bound is the optimum in that
+ * branch, so each check either finds a strictly better branch or proves
+ * optimality. For integer objectives, the simplex is only used to
+ * detect unbounded objectives.
+ *
+ * For bitvector objectives (unsigned), we use binary search between
+ * the value in the last model and the bound computed by the bitvector
+ * solver.
+ */
+
+#include <assert.h>
+
+#include "context/context.h"
+#include "context/context_utils.h"
+#include "context/internalization_codes.h"
+#include "model/models.h"
+#include "solvers/bv/bvsolver.h"
+#include "solvers/simplex/simplex.h"
+#include "terms/bv_constants.h"
+#include "utils/memalloc.h"
+
+
+/*
+ * Optimization state
+ * - level = base level of the context on entry
+ * - the optimization level is level+1
+ * - candidate bounds are checked in level+2
+ */
+typedef struct optimizer_s {
+  context_t *ctx;
+  const param_t *params;
+  uint32_t level;
+} optimizer_t;
+
+
+/*
+ * Prepare for new assertions in level+2
+ * - clear the current status and pop the previous candidate level if any
+ * - create the optimization level if needed
+ * - if candidate is true, push a new level for a candidate bound
+ */
+static void optimizer_reset(optimizer_t *opt, bool candidate) {
+  context_t *ctx;
+
+  ctx = opt->ctx;
+  switch (context_status(ctx)) {
+  case STATUS_SAT:
+  case STATUS_UNKNOWN:
+    context_clear(ctx);
+    break;
+
+  case STATUS_UNSAT:
+    context_clear_unsat(ctx);
+    break;
+
+  default:
+    break;
+  }
+
+  while (context_base_level(ctx) > opt->level + 1) {
+    context_pop(ctx);
+  }
+  if (context_base_level(ctx) == opt->level) {
+    context_push(ctx);
+  }
+  if (candidate) {
+    context_push(ctx);
+  }
+  assert(context_status(ctx) == STATUS_IDLE);
+  internalization_start(ctx->core);
+}
+
+
+/*
+ * Restore the context to its state on entry
+ * - if the search was interrupted and clean interrupt is not supported,
+ *   we can't do anything: the context must be reset.
+ */
+static void optimizer_restore(optimizer_t *opt) {
+  context_t *ctx;
+
+  ctx = opt->ctx;
+  if (context_base_level(ctx) > opt->level) {
+    switch (context_status(ctx)) {
+    case STATUS_SAT:
+    case STATUS_UNKNOWN:
+      context_clear(ctx);
+      break;
+
+    case STATUS_UNSAT:
+      context_clear_unsat(ctx);
+      break;
+
+    case STATUS_INTERRUPTED:
+      if (! context_supports_cleaninterrupt(ctx)) return;
+      context_cleanup(ctx);
+      break;
+
+    default:
+      break;
+    }
+
+    while (context_base_level(ctx) > opt->level) {
+      context_pop(ctx);
+    }
+  }
+}
+
+
+/*
+ * Check the context
+ */
+static inline smt_status_t optimizer_check(optimizer_t *opt) {
+  return check_context(opt->ctx, opt->params);
+}
+
+
+
+/*
+ * ARITHMETIC OBJECTIVES
+ */
+
+/*
+ * Value of x in the current assignment
+ * - return false if the solver can't produce it
+ */
+static bool arith_objective_value(context_t *ctx, thvar_t x, rational_t *v) {
+  bool ok;
+
+  ctx->arith.build_model(ctx->arith_solver);
+  ok = ctx->arith.value_in_model(ctx->arith_solver, x, v);
+  ctx->arith.free_model(ctx->arith_solver);
+
+  return ok;
+}
+
+
+/*
+ * Assert a bound on x: t is the term mapped to x and c is the bound
+ * - upper = true means x <= c or x < c
+ * - upper = false means x >= c or x > c
+ * - strict = true means that the bound is strict
+ */
+static void assert_arith_bound(context_t *ctx, term_t t, thvar_t x, rational_t *c, bool upper, bool strict) {
+  polynomial_t *p;
+  thvar_t map[2];
+  uint32_t i;
+  bool tt;
+
+  /*
+   * Build p = (c - x) or (x - c) then assert p >= 0 or p < 0:
+   *  x <= c  <-->  c - x >= 0
+   *  x < c   <-->  x - c < 0
+   *  x >= c  <-->  x - c >= 0
+   *  x > c   <-->  c - x < 0
+   */
+  p = context_get_aux_poly(ctx, 3);
+  i = 0;
+  if (q_is_nonzero(c)) {
+    p->mono[0].var = const_idx;
+    q_set(&p->mono[0].coeff, c);
+    map[0] = null_thvar;
+    i = 1;
+  }
+  p->mono[i].var = t;
+  q_set_minus_one(&p->mono[i].coeff);
+  map[i] = x;
+  p->mono[i+1].var = max_idx;
+  p->nterms = i+1;
+
+  tt = !strict;
+  if (upper == strict) {
+    // p must be x - c
+    for (i=0; i<p->nterms; i++) {
+      q_neg(&p->mono[i].coeff);
+    }
+  }
+  ctx->arith.assert_poly_ge_axiom(ctx->arith_solver, p, map, tt);
+}
+
+
+/*
+ * Optimize arithmetic objective t (mapped to x)
+ * - the context status must be SAT
+ * - result = status of the objective
+ * - return the status of the last check
+ */
+static smt_status_t optimize_arith_objective(optimizer_t *opt, term_t t, thvar_t x, bool maximize,
+                                             objective_status_t *result) {
+  context_t *ctx;
+  rational_t c;
+  xrational_t v;
+  simplex_opt_code_t code;
+  smt_status_t stat;
+  bool is_int, attained, first;
+
+  ctx = opt->ctx;
+  is_int = is_integer_term(ctx->terms, t);
+
+  q_init(&c);
+  xq_init(&v);
+  first = true;
+
+  for (;;) {
+    assert(context_status(ctx) == STATUS_SAT);
+
+    if (! arith_objective_value(ctx, x, &c)) {
+      stat = STATUS_SAT;
+      *result = OBJECTIVE_UNKNOWN;
+      break;
+    }
+
+    /*
+     * c = value of x in the current model. We use the simplex to
+     * improve it if possible.
+     */
+    attained = true;
+    if (context_has_simplex_solver(ctx)) {
+      code = simplex_optimize_var(ctx->arith_solver, x, maximize, &v);
+      if (code == SIMPLEX_OPT_UNBOUNDED) {
+        stat = STATUS_SAT;
+        *result = OBJECTIVE_UNBOUNDED;
+        break;
+      }
+      if (code == SIMPLEX_OPT_BOUNDED && !is_int) {
+        // v = c + k.delta: the optimum is attained in this branch iff k == 0
+        q_set(&c, &v.main);
+        if (maximize ? q_is_neg(&v.delta) : q_is_pos(&v.delta)) {
+          attained = false;
+        }
+      }
+    }
+
+    /*
+     * Next candidate: x > c if c is attained, x >= c otherwise.
+     * (x < c or x <= c for minimization).
+     */
+    if (first && context_has_simplex_solver(ctx)) {
+      // attach an atom to x in the optimization level so that the
+      // simplex solver doesn't eliminate x
+      optimizer_reset(opt, false);
+      (void) ctx->arith.create_ge_atom(ctx->arith_solver, x);
+      first = false;
+    }
+    optimizer_reset(opt, true);
+    assert_arith_bound(ctx, t, x, &c, !maximize, attained);
+    stat = optimizer_check(opt);
+
+    if (stat == STATUS_UNSAT) {
+      /*
+       * c is the optimum: if it's attained, we fix it in the
+       * optimization level.
+       */
+      optimizer_reset(opt, false);
+      if (attained) {
+        assert_arith_bound(ctx, t, x, &c, !maximize, false);
+        *result = OBJECTIVE_OPTIMAL;
+      } else {
+        *result = OBJECTIVE_NOT_ATTAINED;
+      }
+      stat = optimizer_check(opt);
+      break;
+    }
+
+    if (stat != STATUS_SAT) break;
+  }
+
+  xq_clear(&v);
+  q_clear(&c);
+
+  return stat;
+}
+
+
+
+/*
+ * BITVECTOR OBJECTIVES
+ */
+
+/*
+ * Value of x in the current assignment
+ * - return false if the solver can't produce it
+ */
+static bool bv_objective_value(context_t *ctx, thvar_t x, bvconstant_t *v) {
+  bool ok;
+
+  ctx->bv.build_model(ctx->bv_solver);
+  ok = ctx->bv.value_in_model(ctx->bv_solver, x, v);
+  ctx->bv.free_model(ctx->bv_solver);
+
+  return ok;
+}
+
+/*
+ * Assert a bound on x: n = number of bits, c = bound (normalized)
+ * - upper/strict are as in assert_arith_bound
+ */
+static void assert_bv_bound(context_t *ctx, thvar_t x, uint32_t n, const uint32_t *c, bool upper, bool strict) {
+  bvconst64_term_t c64;
+  bvconst_term_t *cw;
+  uint32_t k;
+  thvar_t y;
+
+  if (n <= 64) {
+    c64.bitsize = n;
+    c64.value = (n <= 32) ? (uint64_t) c[0] : ((uint64_t) c[0] | (((uint64_t) c[1]) << 32));
+    y = ctx->bv.create_const64(ctx->bv_solver, &c64);
+  } else {
+    k = (n + 31) >> 5;
+    cw = (bvconst_term_t *) safe_malloc(sizeof(bvconst_term_t) + k * sizeof(uint32_t));
+    cw->bitsize = n;
+    bvconst_set(cw->data, k, c);
+    y = ctx->bv.create_const(ctx->bv_solver, cw);
+    safe_free(cw);
+  }
+
+  /*
+   *  x <= c  <-->  (bvge c x)
+   *  x < c   <-->  not (bvge x c)
+   *  x >= c  <-->  (bvge x c)
+   *  x > c   <-->  not (bvge c x)
+   */
+  if (upper == strict) {
+    ctx->bv.assert_ge_axiom(ctx->bv_solver, x, y, !strict);
+  } else {
+    ctx->bv.assert_ge_axiom(ctx->bv_solver, y, x, !strict);
+  }
+}
+
+/*
+ * Binary search between the value of x in the current model
+ * and the bound on x computed by the bitvector solver
+ * - the context status must be SAT
+ * - n = number of bits in x
+ */
+static smt_status_t optimize_bv_objective(optimizer_t *opt, thvar_t x, uint32_t n, bool maximize,
+                                          objective_status_t *result) {
+  context_t *ctx;
+  bvconstant_t lo, hi, mid, aux;
+  smt_status_t stat;
+  uint32_t k;
+  bool odd;
+
+  ctx = opt->ctx;
+  k = (n + 31) >> 5;
+
+  init_bvconstant(&lo);
+  init_bvconstant(&hi);
+  init_bvconstant(&mid);
+  init_bvconstant(&aux);
+
+  stat = STATUS_SAT;
+  if (! bv_objective_value(ctx, x, &aux)) {
+    *result = OBJECTIVE_UNKNOWN;
+    goto done;
+  }
+
+  optimizer_reset(opt, false);
+  bv_solver_bounds_u(ctx->bv_solver, x, &lo, &hi);
+  if (maximize) {
+    bvconstant_copy(&lo, n, aux.data);
+  } else {
+    bvconstant_copy(&hi, n, aux.data);
+  }
+  assert(bvconst_le(lo.data, hi.data, n));
+
+  while (bvconst_lt(lo.data, hi.data, n)) {
+    /*
+     * mid = lo + (hi - lo)/2 rounded up for maximization
+     * so that lo < mid <= hi when maximizing and lo <= mid < hi
+     * when minimizing.
+     */
+    bvconstant_copy(&mid, n, hi.data);
+    bvconst_sub(mid.data, k, lo.data);
+    odd = bvconst_tst_bit(mid.data, 0);
+    bvconst_shift_right(mid.data, n, 1, false);
+    if (maximize && odd) {
+      bvconst_add_one(mid.data, k);
+    }
+    bvconst_add(mid.data, k, lo.data);
+    bvconst_normalize(mid.data, n);
+
+    optimizer_reset(opt, true);
+    assert_bv_bound(ctx, x, n, mid.data, !maximize, false);
+    stat = optimizer_check(opt);
+    if (stat == STATUS_SAT) {
+      if (! bv_objective_value(ctx, x, &aux)) {
+        *result = OBJECTIVE_UNKNOWN;
+        goto done;
+      }
+      if (maximize) {
+        bvconstant_copy(&lo, n, aux.data);
+      } else {
+        bvconstant_copy(&hi, n, aux.data);
+      }
+    } else if (stat == STATUS_UNSAT) {
+      if (maximize) {
+        bvconstant_copy(&hi, n, mid.data);
+        bvconst_sub_one(hi.data, k);
+        bvconst_normalize(hi.data, n);
+      } else {
+        bvconstant_copy(&lo, n, mid.data);
+        bvconst_add_one(lo.data, k);
+        bvconst_normalize(lo.data, n);
+      }
+    } else {
+      goto done;
+    }
+  }
+
+  // fix the optimum
+  optimizer_reset(opt, false);
+  assert_bv_bound(ctx, x, n, lo.data, !maximize, false);
+  *result = OBJECTIVE_OPTIMAL;
+  stat = optimizer_check(opt);
+
+ done:
+  delete_bvconstant(&lo);
+  delete_bvconstant(&hi);
+  delete_bvconstant(&mid);
+  delete_bvconstant(&aux);
+
+  return stat;
+}
+
+
+/*
+ * MAIN LOOP
+ */
+smt_status_t optimize_context(context_t *ctx, const param_t *parameters, uint32_t n, const term_t *obj,
+                              const bool *maximize, objective_status_t *result, model_t *model,
+                              int32_t *error) {
+  optimizer_t opt;
+  thvar_t *var;
+  smt_status_t stat;
+  uint32_t i, nbits;
+  int32_t code;
+
+  assert(context_supports_pushpop(ctx) && ctx->mcsat == NULL);
+  assert(context_status(ctx) == STATUS_IDLE);
+
+  for (i=0; i<n; i++) {
+    result[i] = OBJECTIVE_UNKNOWN;
+  }
+
+  opt.ctx = ctx;
+  opt.params = parameters;
+  opt.level = context_base_level(ctx);
+
+  /*
+   * The objectives are internalized in the optimization level so
+   * that their definitions are removed on exit.
+   */
+  optimizer_reset(&opt, false);
+  var = NULL;
+  if (n > 0) {
+    var = (thvar_t *) safe_malloc(n * sizeof(thvar_t));
+  }
+  stat = STATUS_ERROR;
+  for (i=0; i<n; i++) {
+    code = context_internalize_to_thvar(ctx, obj[i]);
+    if (code < 0) {
+      *error = code;
+      goto done;
+    }
+    var[i] = code;
+  }
+
+  stat = optimizer_check(&opt);
+  for (i=0; i<n && stat == STATUS_SAT; i++) {
+    if (is_arithmetic_term(ctx->terms, obj[i])) {
+      stat = optimize_arith_objective(&opt, obj[i], var[i], maximize[i], result + i);
+    } else {
+      nbits = term_bitsize(ctx->terms, obj[i]);
+      stat = optimize_bv_objective(&opt, var[i], nbits, maximize[i], result + i);
+    }
+
+    // stop if the objective is unbounded or not attained
+    if (result[i] != OBJECTIVE_OPTIMAL) break;
+  }
+
+  if (stat == STATUS_SAT) {
+    context_build_model(model, ctx);
+  }
+
+ done:
+  optimizer_restore(&opt);
+  safe_free(var);
+
+  return stat;
+}
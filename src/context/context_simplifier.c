@@ -24,6 +24,7 @@
  * in context.c. Moved them to this new module created in February 2013.
  */
 
+#include "context/bv_known_bits.h"
 #include "context/conditional_definitions.h"
 #include "context/context_simplifier.h"
 #include "context/context_utils.h"
@@ -2868,3 +2869,54 @@ void process_conditional_definitions(context_t *ctx) {
     delete_cond_def_collector(&collect);
   }
 }
+
+
+
+/*********************************
+ *  KNOWN BITS FOR BITVECTORS    *
+ ********************************/
+
+/*
+ * Collect known bits and intervals from the top-level atoms then
+ * replace variables with known bits by constants or concatenations
+ * of constants and fresh (narrower) variables.
+ */
+void process_bv_known_bits(context_t *ctx) {
+  bv_known_bits_t kb;
+  ivector_t *v;
+  term_t x, t;
+  uint32_t i, n;
+
+  v = &ctx->top_atoms;
+  n = v->size;
+  if (n > 0) {
+    init_bv_known_bits(&kb, ctx->terms, &ctx->intern);
+    for (i=0; i<n && !kb.unsat; i++) {
+      bv_known_bits_add_atom(&kb, v->data[i]);
+    }
+    if (! kb.unsat) {
+      bv_known_bits_propagate(&kb);
+    }
+    if (kb.unsat) {
+      delete_bv_known_bits(&kb);
+      longjmp(ctx->env, TRIVIALLY_UNSAT);
+    }
+
+    n = kb.nvars;
+    for (i=0; i<n; i++) {
+      if (bvkb_var_has_known_bits(&kb, i)) {
+        x = kb.var[i].term;
+        assert(intern_tbl_is_root(&ctx->intern, x) && intern_tbl_root_is_free(&ctx->intern, x));
+        t = bv_known_bits_var_value(&kb, i);
+        if (is_constant_term(ctx->terms, t)) {
+          if (intern_tbl_valid_const_subst(&ctx->intern, x, t)) {
+            intern_tbl_add_subst(&ctx->intern, x, t);
+          }
+        } else {
+          intern_tbl_add_subst(&ctx->intern, x, t);
+        }
+      }
+    }
+    delete_bv_known_bits(&kb);
+  }
+}
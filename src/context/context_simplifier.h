@@ -265,6 +265,19 @@ extern void break_uf_symmetries(context_t *ctx);
 extern void process_conditional_definitions(context_t *ctx);
 
 
+/*
+ * Known bits and intervals for bitvector variables:
+ * - collect bounds and known bits from the top-level atoms
+ *   (bvge, bvsge, bit select, and disequalities with constants)
+ * - propagate to a fixpoint
+ * - replace every variable with known bits by a constant or by a
+ *   concatenation of constants and fresh variables of smaller width
+ * - raise an exception TRIVIALLY_UNSAT if the constraints are
+ *   inconsistent
+ */
+extern void process_bv_known_bits(context_t *ctx);
+
+
 
 /*
  * CONDITIONALS/FLATTENING OF NESTED IF-THEN-ELSE
@@ -30,8 +30,12 @@
 #include <stdio.h>
 
 #include "context/context.h"
+#include "context/context_memory.h"
 #include "context/internalization_codes.h"
+#include "model/map_to_model.h"
+#include "model/model_eval.h"
 #include "model/models.h"
+#include "model/val_to_term.h"
 #include "solvers/funs/fun_solver.h"
 #include "solvers/simplex/simplex.h"
 
@@ -305,15 +309,27 @@ static literal_t theory_or_pos_branch(smt_core_t *core, literal_t l) {
  * Full solver:
  * - params: heuristic parameters.
  *   If params is NULL, the default settings are used.
+ * - if params->memory_limit is positive, the memory usage is checked
+ *   at every restart. If it's above the limit after freeing what
+ *   can be freed, the search stops with status UNKNOWN and
+ *   ctx->mem_limit_reached is set.
+ * - max_conflicts: bound on the number of conflicts, also checked
+ *   at every restart. The search stops with status UNKNOWN if it's
+ *   reached.
  */
-static void solve(smt_core_t *core, const param_t *params) {
+static void solve(context_t *ctx, const param_t *params, uint64_t max_conflicts) {
+  smt_core_t *core;
   bool luby;
   uint32_t c_threshold, d_threshold; // Picosat-style
   uint32_t u, v, period;             // for Luby-style
   uint32_t reduce_threshold;
+  uint64_t mem_limit;
 
+  core = ctx->core;
   assert(smt_status(core) == STATUS_IDLE);
 
+  mem_limit = ((uint64_t) params->memory_limit) << 20; // MB to bytes
+
   c_threshold = params->c_threshold;
   d_threshold = c_threshold; // required by trace_start in slow_restart mode
   luby = false;
@@ -370,6 +386,17 @@ static void solve(smt_core_t *core, const param_t *params) {
       smt_restart(core);
       //      smt_partial_restart_var(core);
 
+      if (mem_limit > 0 && context_over_memory_limit(ctx, mem_limit)) {
+        ctx->mem_limit_reached = true;
+        end_search_unknown(core);
+        break;
+      }
+
+      if (num_conflicts(core) >= max_conflicts) {
+        end_search_unknown(core);
+        break;
+      }
+
       if (luby) {
 	// Luby-style restart
 	if ((u & -u) == v) {
@@ -403,6 +430,7 @@ static void solve(smt_core_t *core, const param_t *params) {
     }
   }
 
+  smt_log_event(core, ETRACE_END_SEARCH, smt_status(core), 0, 0);
   trace_done(core);
 }
 
@@ -413,8 +441,9 @@ static void solve(smt_core_t *core, const param_t *params) {
 /*
  * Initialize search parameters then call solve
  * - if ctx->status is not IDLE, return the status.
+ * - max_conflicts = conflict bound (ignored by MCSAT)
  */
-smt_status_t check_context(context_t *ctx, const param_t *params) {
+smt_status_t bounded_check_context(context_t *ctx, const param_t *params, uint64_t max_conflicts) {
   smt_status_t stat;
   smt_core_t *core;
   egraph_t *egraph;
@@ -435,6 +464,7 @@ smt_status_t check_context(context_t *ctx, const param_t *params) {
     /*
      * Clean state: search can proceed
      */
+    ctx->mem_limit_reached = false;
     if (params == NULL) {
       params = get_default_params();
     }
@@ -451,6 +481,25 @@ smt_status_t check_context(context_t *ctx, const param_t *params) {
     } else {
       disable_theory_cache(core);
     }
+    if (params->chrono_backtrack) {
+      enable_chrono_backtracking(core, params->chrono_threshold);
+    } else {
+      disable_chrono_backtracking(core);
+    }
+    if (params->sls_flips > 0) {
+      enable_sls_phases(core, params->sls_flips);
+    } else {
+      disable_sls_phases(core);
+    }
+    /*
+     * The bitvector solver reads the value of bit literals that
+     * have no atoms so these literals must not be eliminated.
+     */
+    if (params->bool_preprocess && !context_has_bv_solver(ctx)) {
+      enable_bool_preprocessing(core);
+    } else {
+      disable_bool_preprocessing(core);
+    }
 
     /*
      * Set egraph parameters
@@ -510,13 +559,165 @@ smt_status_t check_context(context_t *ctx, const param_t *params) {
       fun_solver_set_max_extensionality(fsolver, params->max_extensionality);
     }
 
-    solve(core, params);
+    solve(ctx, params, max_conflicts);
     stat = smt_status(core);
   }
 
   return stat;
 }
 
+smt_status_t check_context(context_t *ctx, const param_t *params) {
+  return bounded_check_context(ctx, params, UINT64_MAX);
+}
+
+
+
+/*
+ * QUERY CACHE
+ */
+
+/*
+ * Enable/disable the cache
+ */
+void context_enable_query_cache(context_t *ctx) {
+  query_cache_t *tmp;
+
+  if (ctx->qcache == NULL) {
+    tmp = (query_cache_t *) safe_malloc(sizeof(query_cache_t));
+    init_query_cache(tmp, QCACHE_DEFAULT_SIZE);
+    ctx->qcache = tmp;
+  }
+}
+
+void context_disable_query_cache(context_t *ctx) {
+  query_cache_t *tmp;
+
+  tmp = ctx->qcache;
+  if (tmp != NULL) {
+    delete_query_cache(tmp);
+    safe_free(tmp);
+    ctx->qcache = NULL;
+  }
+}
+
+void context_taint_assertion_log(context_t *ctx) {
+  if (ctx->base_level < ctx->log_taint_level) {
+    ctx->log_taint_level = ctx->base_level;
+  }
+}
+
+
+/*
+ * Copy all the terms of the assertion log into the cache's key
+ */
+static void collect_query_key(context_t *ctx, query_cache_t *cache) {
+  ivector_t *log;
+  uint32_t i, n;
+
+  log = &ctx->assertion_log;
+  ivector_reset(&cache->key);
+  i = 0;
+  while (i < log->size) {
+    n = log->data[i];
+    ivector_add(&cache->key, log->data + i + 1, n);
+    i += n + 1;
+  }
+}
+
+
+/*
+ * Store a SAT result in the cache
+ * - the model is converted to a map from uninterpreted terms to constants
+ * - only the terms internalized in ctx are considered
+ * - if a value can't be converted (e.g., a function), the entry is
+ *   stored without a model
+ */
+static void cache_sat_result(context_t *ctx, uint32_t hash, uint32_t digest) {
+  model_t mdl;
+  evaluator_t eval;
+  ivector_t var, map;
+  term_table_t *terms;
+  value_t v;
+  term_t t, c;
+  uint32_t i, n;
+
+  terms = ctx->terms;
+  init_model(&mdl, terms, true);
+  context_build_model(&mdl, ctx);
+  init_evaluator(&eval, &mdl);
+  init_ivector(&var, 10);
+  init_ivector(&map, 10);
+
+  n = intern_tbl_num_terms(&ctx->intern);
+  for (i=1; i<n; i++) {
+    if (good_term_idx(terms, i) && kind_for_idx(terms, i) == UNINTERPRETED_TERM) {
+      t = pos_occ(i);
+      if (intern_tbl_term_present(&ctx->intern, t)) {
+        v = eval_in_model(&eval, t);
+        if (v < 0) goto no_model;
+        c = convert_value_to_term(terms, model_get_vtbl(&mdl), v);
+        if (c < 0) goto no_model;
+        ivector_push(&var, t);
+        ivector_push(&map, c);
+      }
+    }
+  }
+
+  qcache_add(ctx->qcache, hash, digest, STATUS_SAT, var.size, var.data, map.data);
+  goto done;
+
+ no_model:
+  qcache_add(ctx->qcache, hash, digest, STATUS_SAT, 0, NULL, NULL);
+
+ done:
+  delete_ivector(&var);
+  delete_ivector(&map);
+  delete_evaluator(&eval);
+  delete_model(&mdl);
+}
+
+
+/*
+ * Check with the cache
+ */
+smt_status_t check_context_with_cache(context_t *ctx, const param_t *params) {
+  query_cache_t *cache;
+  qcache_entry_t *e;
+  smt_status_t stat;
+  uint32_t hash, digest;
+
+  cache = ctx->qcache;
+  if (cache == NULL || ctx->mcsat != NULL || smt_status(ctx->core) != STATUS_IDLE ||
+      ctx->log_taint_level <= ctx->base_level) {
+    return check_context(ctx, params);
+  }
+
+  assert(cache->hit == NULL);
+
+  if (params == NULL) {
+    params = get_default_params();
+  }
+  cache->params = *params;
+  digest = params_digest(params);
+
+  collect_query_key(ctx, cache);
+  hash = qcache_normalize_key(cache);
+  e = qcache_find(cache, hash, digest);
+  if (e != NULL) {
+    cache->hit = e;
+    return e->status;
+  }
+
+  stat = check_context(ctx, params);
+  if (stat == STATUS_UNSAT) {
+    qcache_add(cache, hash, digest, STATUS_UNSAT, 0, NULL, NULL);
+  } else if (stat == STATUS_SAT) {
+    cache_sat_result(ctx, hash, digest);
+  }
+
+  return stat;
+}
+
 
 
 /*
@@ -757,11 +958,28 @@ static void build_term_value(context_t *ctx, model_t *model, term_t t) {
  */
 void context_build_model(model_t *model, context_t *ctx) {
   term_table_t *terms;
+  qcache_entry_t *e;
+  uint64_t start;
   uint32_t i, n;
   term_t t;
 
+  // result from the query cache
+  if (ctx->qcache != NULL && ctx->qcache->hit != NULL) {
+    e = ctx->qcache->hit;
+    assert(e->status == STATUS_SAT);
+    if (e->has_model) {
+      build_model_from_map(model, e->nvars, e->var, e->map);
+      return;
+    }
+    // no model in the cache: redo the search to get one
+    ctx->qcache->hit = NULL;
+    check_context(ctx, &ctx->qcache->params);
+  }
+
   assert(smt_status(ctx->core) == STATUS_SAT || smt_status(ctx->core) == STATUS_UNKNOWN || mcsat_status(ctx->mcsat) == STATUS_SAT);
 
+  start = timer_start();
+
   /*
    * First build assignments in the satellite solvers
    * and get the val_in_model functions for the egraph
@@ -812,6 +1030,7 @@ void context_build_model(model_t *model, context_t *ctx) {
     egraph_free_model(ctx->egraph);
   }
 
+  timer_stop(ctx->timer + CTX_TIMER_MODEL, start);
 }
 
 
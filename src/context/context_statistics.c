@@ -22,14 +22,17 @@
 
 #include <stdint.h>
 #include <inttypes.h>
+#include <string.h>
 
 #include "context/context.h"
+#include "context/context_memory.h"
 #include "context/context_statistics.h"
 #include "solvers/bv/bvsolver.h"
 #include "solvers/floyd_warshall/idl_floyd_warshall.h"
 #include "solvers/floyd_warshall/rdl_floyd_warshall.h"
 #include "solvers/funs/fun_solver.h"
 #include "solvers/simplex/simplex.h"
+#include "utils/memalloc.h"
 
 
 /*
@@ -61,6 +64,11 @@ static void show_stats(FILE *f, dpll_stats_t *stat) {
   fprintf(f, " deleted pb. clauses     : %"PRIu64"\n", stat->prob_clauses_deleted);
   fprintf(f, " deleted learned clauses : %"PRIu64"\n", stat->learned_clauses_deleted);
   fprintf(f, " deleted binary clauses  : %"PRIu64"\n", stat->bin_clauses_deleted);
+  fprintf(f, " pp. subsumed clauses    : %"PRIu32"\n", stat->pp_subsumed);
+  fprintf(f, " pp. strengthened clauses: %"PRIu32"\n", stat->pp_strengthened);
+  fprintf(f, " pp. substituted vars    : %"PRIu32"\n", stat->pp_subst_vars);
+  fprintf(f, " pp. eliminated vars     : %"PRIu32"\n", stat->pp_elim_vars);
+  fprintf(f, " pp. restored vars       : %"PRIu32"\n", stat->pp_restored_vars);
 }
 
 /*
@@ -78,6 +86,7 @@ static void show_egraph_stats(FILE *f, egraph_stats_t *stat) {
   fprintf(f, " other dyn ack.lemmas    : %"PRIu32"\n", stat->ack_lemmas);
   fprintf(f, " final checks            : %"PRIu32"\n", stat->final_checks);
   fprintf(f, " interface equalities    : %"PRIu32"\n", stat->interface_eqs);
+  fprintf(f, " expl. cache hits        : %"PRIu32"\n", stat->expl_cache_hits);
 }
 
 /*
@@ -125,7 +134,14 @@ static void show_simplex_stats(FILE *f, simplex_stats_t *stat) {
     fprintf(f, "Integer arithmetic\n");
     fprintf(f, " make integer feasible   : %"PRIu32"\n", stat->num_make_intfeasible);
     fprintf(f, " branch atoms            : %"PRIu32"\n", stat->num_branch_atoms);
+    fprintf(f, " branch nodes            : %"PRIu32"\n", stat->num_branch_nodes);
+    fprintf(f, " pseudo-cost branches    : %"PRIu32"\n", stat->num_pcost_branches);
+    fprintf(f, " cube tests              : %"PRIu32"\n", stat->num_cube_tests);
+    fprintf(f, " cube successes          : %"PRIu32"\n", stat->num_cube_successes);
     fprintf(f, "bound strengthening\n");
+    fprintf(f, " presolve bounds         : %"PRIu32"\n", stat->num_presolve_bounds);
+    fprintf(f, " presolve conflicts      : %"PRIu32"\n", stat->num_presolve_conflicts);
+    fprintf(f, " rounds                  : %"PRIu32"\n", stat->num_strengthen_rounds);
     fprintf(f, " conflicts               : %"PRIu32"\n", stat->num_bound_conflicts);
     fprintf(f, " recheck conflicts       : %"PRIu32"\n", stat->num_bound_recheck_conflicts);
     fprintf(f, "integrality tests\n");
@@ -157,6 +173,8 @@ static void show_bvsolver_stats(FILE *f, bv_solver_t *solver) {
   fprintf(f, " equiv conflicts         : %"PRIu32"\n", solver->stats.equiv_conflicts);
   fprintf(f, " semi-equiv lemmas       : %"PRIu32"\n", solver->stats.half_equiv_lemmas);
   fprintf(f, " interface lemmas        : %"PRIu32"\n", solver->stats.interface_lemmas);
+  fprintf(f, " bound propagations      : %"PRIu32"\n", bv_solver_bound_propagations(solver));
+  fprintf(f, " bound conflicts         : %"PRIu32"\n", bv_solver_bound_conflicts(solver));
 }
 
 
@@ -225,3 +243,231 @@ void yices_show_statistics(FILE *f, context_t *ctx) {
 void yices_dump_context(FILE *f, context_t *ctx) {
   // NOT IMPLEMENTED
 }
+
+
+
+/*
+ * STRUCTURED STATISTICS
+ */
+void init_ctx_stats(ctx_stats_t *s) {
+  s->data = (ctx_stat_t *) safe_malloc(DEF_CTX_STATS_SIZE * sizeof(ctx_stat_t));
+  s->size = 0;
+  s->capacity = DEF_CTX_STATS_SIZE;
+}
+
+void delete_ctx_stats(ctx_stats_t *s) {
+  safe_free(s->data);
+  s->data = NULL;
+}
+
+static void ctx_stats_push(ctx_stats_t *s, const char *name, uint64_t value) {
+  uint32_t i, n;
+
+  i = s->size;
+  if (i == s->capacity) {
+    n = s->capacity + (s->capacity >> 1);
+    if (n > MAX_CTX_STATS_SIZE) {
+      out_of_memory();
+    }
+    s->data = (ctx_stat_t *) safe_realloc(s->data, n * sizeof(ctx_stat_t));
+    s->capacity = n;
+  }
+  s->data[i].name = name;
+  s->data[i].value = value;
+  s->size = i+1;
+}
+
+static void collect_timer(ctx_stats_t *s, const char *cycles, const char *calls, const cycle_timer_t *t) {
+  ctx_stats_push(s, cycles, t->cycles);
+  ctx_stats_push(s, calls, t->calls);
+}
+
+
+static void collect_core_stats(ctx_stats_t *s, smt_core_t *core) {
+  dpll_stats_t *stat;
+
+  stat = &core->stats;
+  ctx_stats_push(s, "core.boolean-variables", num_vars(core));
+  ctx_stats_push(s, "core.atoms", num_atoms(core));
+  ctx_stats_push(s, "core.clauses", num_clauses(core));
+  ctx_stats_push(s, "core.learned-clauses", num_learned_clauses(core));
+  ctx_stats_push(s, "core.restarts", stat->restarts);
+  ctx_stats_push(s, "core.simplify-db", stat->simplify_calls);
+  ctx_stats_push(s, "core.reduce-db", stat->reduce_calls);
+  ctx_stats_push(s, "core.decisions", stat->decisions);
+  ctx_stats_push(s, "core.random-decisions", stat->random_decisions);
+  ctx_stats_push(s, "core.propagations", stat->propagations);
+  ctx_stats_push(s, "core.conflicts", stat->conflicts);
+  ctx_stats_push(s, "core.chrono-backtracks", stat->chrono_backtracks);
+  ctx_stats_push(s, "core.theory-propagations", stat->th_props);
+  ctx_stats_push(s, "core.theory-conflicts", stat->th_conflicts);
+  ctx_stats_push(s, "core.learned-literals", stat->learned_literals);
+  ctx_stats_push(s, "core.subsumed-clauses", stat->pp_subsumed);
+  ctx_stats_push(s, "core.strengthened-clauses", stat->pp_strengthened);
+  ctx_stats_push(s, "core.substituted-vars", stat->pp_subst_vars);
+  ctx_stats_push(s, "core.eliminated-vars", stat->pp_elim_vars);
+  ctx_stats_push(s, "core.restored-vars", stat->pp_restored_vars);
+
+  if (CYCLE_TIMERS_ENABLED) {
+    collect_timer(s, "time.bcp.cycles", "time.bcp.calls", stat->timer + CORE_TIMER_BCP);
+    collect_timer(s, "time.theory-propagate.cycles", "time.theory-propagate.calls", stat->timer + CORE_TIMER_PROPAGATE);
+    collect_timer(s, "time.final-check.cycles", "time.final-check.calls", stat->timer + CORE_TIMER_FINAL_CHECK);
+    collect_timer(s, "time.theory-backtrack.cycles", "time.theory-backtrack.calls", stat->timer + CORE_TIMER_BACKTRACK);
+    collect_timer(s, "time.explain.cycles", "time.explain.calls", stat->timer + CORE_TIMER_EXPLAIN);
+  }
+}
+
+static void collect_egraph_stats(ctx_stats_t *s, egraph_t *egraph) {
+  egraph_stats_t *stat;
+
+  stat = &egraph->stats;
+  ctx_stats_push(s, "egraph.terms", egraph->terms.nterms);
+  ctx_stats_push(s, "egraph.eq-props", stat->eq_props);
+  ctx_stats_push(s, "egraph.app-reductions", stat->app_reductions);
+  ctx_stats_push(s, "egraph.propagations", stat->th_props);
+  ctx_stats_push(s, "egraph.conflicts", stat->th_conflicts);
+  ctx_stats_push(s, "egraph.ackermann-lemmas", stat->boolack_lemmas + stat->ack_lemmas);
+  ctx_stats_push(s, "egraph.final-checks", stat->final_checks);
+  ctx_stats_push(s, "egraph.interface-eqs", stat->interface_eqs);
+  ctx_stats_push(s, "egraph.explanation-cache-hits", stat->expl_cache_hits);
+}
+
+static void collect_funsolver_stats(ctx_stats_t *s, fun_solver_t *solver) {
+  fun_solver_stats_t *stat;
+
+  stat = &solver->stats;
+  ctx_stats_push(s, "arrays.vars", stat->num_init_vars);
+  ctx_stats_push(s, "arrays.edges", stat->num_init_edges);
+  ctx_stats_push(s, "arrays.update1-axioms", stat->num_update_axiom1);
+  ctx_stats_push(s, "arrays.update2-axioms", stat->num_update_axiom2);
+  ctx_stats_push(s, "arrays.extensionality-axioms", stat->num_extensionality_axiom);
+}
+
+static void collect_simplex_stats(ctx_stats_t *s, simplex_solver_t *solver) {
+  simplex_stats_t *stat;
+
+  simplex_collect_statistics(solver);
+  stat = &solver->stats;
+  ctx_stats_push(s, "simplex.init-vars", stat->num_init_vars);
+  ctx_stats_push(s, "simplex.init-rows", stat->num_init_rows);
+  ctx_stats_push(s, "simplex.atoms", stat->num_atoms);
+  ctx_stats_push(s, "simplex.rows", stat->num_end_rows);
+  ctx_stats_push(s, "simplex.make-feasible", stat->num_make_feasible);
+  ctx_stats_push(s, "simplex.pivots", stat->num_pivots);
+  ctx_stats_push(s, "simplex.propagations", stat->num_props);
+  ctx_stats_push(s, "simplex.bound-propagations", stat->num_bound_props);
+  ctx_stats_push(s, "simplex.conflicts", stat->num_conflicts);
+  ctx_stats_push(s, "simplex.interface-lemmas", stat->num_interface_lemmas);
+  ctx_stats_push(s, "simplex.make-integer-feasible", stat->num_make_intfeasible);
+  ctx_stats_push(s, "simplex.branch-atoms", stat->num_branch_atoms);
+  ctx_stats_push(s, "simplex.branch-nodes", stat->num_branch_nodes);
+  ctx_stats_push(s, "simplex.pcost-branches", stat->num_pcost_branches);
+  ctx_stats_push(s, "simplex.presolve-bounds", stat->num_presolve_bounds);
+  ctx_stats_push(s, "simplex.strengthen-rounds", stat->num_strengthen_rounds);
+  ctx_stats_push(s, "simplex.cube-tests", stat->num_cube_tests);
+  ctx_stats_push(s, "simplex.cube-successes", stat->num_cube_successes);
+  ctx_stats_push(s, "simplex.dioph-checks", stat->num_dioph_checks);
+  ctx_stats_push(s, "simplex.dioph-conflicts", stat->num_dioph_conflicts);
+
+  if (CYCLE_TIMERS_ENABLED) {
+    collect_timer(s, "time.simplex-intfeas.cycles", "time.simplex-intfeas.calls", &stat->intfeas_timer);
+  }
+}
+
+static void collect_bvsolver_stats(ctx_stats_t *s, bv_solver_t *solver) {
+  ctx_stats_push(s, "bv.vars", bv_solver_num_vars(solver));
+  ctx_stats_push(s, "bv.atoms", bv_solver_num_atoms(solver));
+  ctx_stats_push(s, "bv.equiv-lemmas", bv_solver_equiv_lemmas(solver));
+  ctx_stats_push(s, "bv.interface-lemmas", bv_solver_interface_lemmas(solver));
+  ctx_stats_push(s, "bv.bound-propagations", bv_solver_bound_propagations(solver));
+  ctx_stats_push(s, "bv.bound-conflicts", bv_solver_bound_conflicts(solver));
+}
+
+/*
+ * Memory estimates: the term table is shared by all contexts so
+ * it's not included in mem.context.
+ */
+static void collect_memory_stats(ctx_stats_t *s, context_t *ctx) {
+  ctx_mem_usage_t u;
+
+  context_mem_usage(ctx, &u);
+  ctx_stats_push(s, "mem.core", u.core);
+  ctx_stats_push(s, "mem.egraph", u.egraph);
+  ctx_stats_push(s, "mem.simplex", u.simplex);
+  ctx_stats_push(s, "mem.bv", u.bv);
+  ctx_stats_push(s, "mem.bitblaster", u.bitblaster);
+  ctx_stats_push(s, "mem.cache", u.cache);
+  ctx_stats_push(s, "mem.context", u.total);
+  ctx_stats_push(s, "mem.terms", term_table_mem_size(ctx->terms));
+  ctx_stats_push(s, "mem.limit-reached", ctx->mem_limit_reached);
+}
+
+
+void context_collect_statistics(context_t *ctx, ctx_stats_t *s) {
+  s->size = 0;
+
+  if (ctx->core != NULL) {
+    collect_core_stats(s, ctx->core);
+  }
+  if (context_has_egraph(ctx)) {
+    collect_egraph_stats(s, ctx->egraph);
+  }
+  if (context_has_fun_solver(ctx)) {
+    collect_funsolver_stats(s, ctx->fun_solver);
+  }
+  if (context_has_simplex_solver(ctx)) {
+    collect_simplex_stats(s, ctx->arith_solver);
+  } else if (context_has_idl_solver(ctx)) {
+    ctx_stats_push(s, "idl.vars", idl_num_vars(ctx->arith_solver));
+    ctx_stats_push(s, "idl.atoms", idl_num_atoms(ctx->arith_solver));
+  } else if (context_has_rdl_solver(ctx)) {
+    ctx_stats_push(s, "rdl.vars", rdl_num_vars(ctx->arith_solver));
+    ctx_stats_push(s, "rdl.atoms", rdl_num_atoms(ctx->arith_solver));
+  }
+  if (context_has_bv_solver(ctx)) {
+    collect_bvsolver_stats(s, ctx->bv_solver);
+  }
+  if (ctx->qcache != NULL) {
+    ctx_stats_push(s, "cache.lookups", ctx->qcache->lookups);
+    ctx_stats_push(s, "cache.hits", ctx->qcache->hits);
+    ctx_stats_push(s, "cache.subsumed", ctx->qcache->subsumed);
+  }
+  collect_memory_stats(s, ctx);
+
+  if (CYCLE_TIMERS_ENABLED) {
+    collect_timer(s, "time.internalize.cycles", "time.internalize.calls", ctx->timer + CTX_TIMER_INTERNALIZE);
+    collect_timer(s, "time.model.cycles", "time.model.calls", ctx->timer + CTX_TIMER_MODEL);
+  }
+}
+
+
+bool ctx_stats_get(const ctx_stats_t *s, const char *name, uint64_t *value) {
+  uint32_t i;
+
+  for (i=0; i<s->size; i++) {
+    if (strcmp(s->data[i].name, name) == 0) {
+      *value = s->data[i].value;
+      return true;
+    }
+  }
+  return false;
+}
+
+
+void ctx_stats_to_json(const ctx_stats_t *s, string_buffer_t *b) {
+  char aux[32];
+  uint32_t i;
+
+  string_buffer_append_char(b, '{');
+  for (i=0; i<s->size; i++) {
+    if (i > 0) {
+      string_buffer_append_string(b, ", ");
+    }
+    string_buffer_append_char(b, '"');
+    string_buffer_append_string(b, s->data[i].name);
+    string_buffer_append_string(b, "\": ");
+    snprintf(aux, sizeof(aux), "%"PRIu64, s->data[i].value);
+    string_buffer_append_string(b, aux);
+  }
+  string_buffer_append_char(b, '}');
+}
@@ -30,13 +30,67 @@
 #define __CONTEXT_STATISTICS_H
 
 #include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
 
 #include "context/context_types.h"
+#include "utils/string_buffers.h"
 
 extern void yices_print_presearch_stats(FILE *f, context_t *ctx);
 extern void yices_show_statistics(FILE *f, context_t *ctx);
 extern void yices_dump_context(FILE *f, context_t *ctx);
 
 
+/*
+ * STRUCTURED STATISTICS
+ *
+ * The statistics of a context as a list of (name, value) pairs.
+ * Names are static strings of the form "<component>.<counter>",
+ * e.g., "core.conflicts" or "simplex.pivots". Only the components
+ * present in the context are included.
+ *
+ * If the profiling timers are enabled (cf. utils/cycle_timers.h),
+ * each timer adds two entries: "time.<phase>.cycles" and
+ * "time.<phase>.calls".
+ *
+ * The memory estimates are reported as "mem.<component>" (cf.
+ * context_memory.h).
+ */
+typedef struct ctx_stat_s {
+  const char *name;
+  uint64_t value;
+} ctx_stat_t;
+
+typedef struct ctx_stats_s {
+  ctx_stat_t *data;
+  uint32_t size;
+  uint32_t capacity;
+} ctx_stats_t;
+
+#define DEF_CTX_STATS_SIZE 64
+#define MAX_CTX_STATS_SIZE (UINT32_MAX/sizeof(ctx_stat_t))
+
+extern void init_ctx_stats(ctx_stats_t *s);
+extern void delete_ctx_stats(ctx_stats_t *s);
+
+/*
+ * Collect all statistics of ctx into s (s is reset first)
+ */
+extern void context_collect_statistics(context_t *ctx, ctx_stats_t *s);
+
+/*
+ * Search for the statistic of the given name
+ * - if found, copy its value in *value and return true
+ * - otherwise, return false
+ */
+extern bool ctx_stats_get(const ctx_stats_t *s, const char *name, uint64_t *value);
+
+/*
+ * Print the statistics as a JSON object in buffer b:
+ *   { "core.decisions": 100, ... }
+ */
+extern void ctx_stats_to_json(const ctx_stats_t *s, string_buffer_t *b);
+
+
 
 #endif /* __CONTEXT_STATISTICS_H */
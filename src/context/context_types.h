@@ -32,6 +32,7 @@
 #include "context/divmod_table.h"
 #include "context/internalization_table.h"
 #include "context/pseudo_subst.h"
+#include "context/query_cache.h"
 #include "context/shared_terms.h"
 #include "io/tracer.h"
 #include "solvers/cdcl/gates_manager.h"
@@ -105,6 +106,8 @@ typedef enum {
  * - FLATTEN_ITE: avoid intermediate variables when converting nested
  *   if-then-else terms
  * - FACTOR_TOP_OR: extract common factors from top-level disjuncts
+ * - BVKNOWNBITS: compute known bits and intervals for bitvector variables
+ *   and substitute the known bits (requires VARELIM)
  *
  * BREAKSYM for QF_UF is based on the paper by Deharbe et al (CADE 2011)
  *
@@ -117,6 +120,9 @@ typedef enum {
  * (ite c 0 1), assert (0 <= t <= 1), and similar for nested
  * if-then-elses.
  *
+ * ASSERTION_LOG: keep a copy of all the asserted formulas so that
+ * the context can be cloned.
+ *
  * Options passed to the simplex solver when it's created
  * - EAGER_LEMMAS
  * - ENABLE_ICHECK
@@ -140,13 +146,20 @@ typedef enum {
 #define CONDITIONAL_DEF_OPTION_MASK     0x4000
 #define FLATTEN_ITE_OPTION_MASK         0x8000
 #define FACTOR_OR_OPTION_MASK           0x10000
+#define BVKNOWNBITS_OPTION_MASK         0x20000
 
 #define PREPROCESSING_OPTIONS_MASK \
  (VARELIM_OPTION_MASK|FLATTENOR_OPTION_MASK|FLATTENDISEQ_OPTION_MASK|\
   EQABSTRACT_OPTION_MASK|ARITHELIM_OPTION_MASK|KEEP_ITE_OPTION_MASK|\
   BVARITHELIM_OPTION_MASK|BREAKSYM_OPTION_MASK|PSEUDO_INVERSE_OPTION_MASK|\
   ITE_BOUNDS_OPTION_MASK|CONDITIONAL_DEF_OPTION_MASK|FLATTEN_ITE_OPTION_MASK|\
-  FACTOR_OR_OPTION_MASK)
+  FACTOR_OR_OPTION_MASK|BVKNOWNBITS_OPTION_MASK)
+
+// ASSERTION LOG (required for cloning)
+#define ASSERTION_LOG_OPTION_MASK 0x100000
+
+// no constraints outside the assertion log
+#define LOG_NO_TAINT UINT32_MAX
 
 // SIMPLEX OPTIONS
 #define SPLX_EGRLMAS_OPTION_MASK  0x1000000
@@ -615,6 +628,20 @@ typedef struct dl_data_s {
 } dl_data_t;
 
 
+/*
+ * Profiling timers for the context (cf. utils/cycle_timers.h)
+ * - INTERNALIZE = processing of assertions
+ * - MODEL = model construction
+ * The search timers are in the core's statistics record.
+ */
+typedef enum ctx_timer {
+  CTX_TIMER_INTERNALIZE,
+  CTX_TIMER_MODEL,
+} ctx_timer_t;
+
+#define NUM_CTX_TIMERS (CTX_TIMER_MODEL+1)
+
+
 
 
 
@@ -665,6 +692,19 @@ struct context_s {
   ivector_t top_formulas;
   ivector_t top_interns;
 
+  // log of assertions (used for cloning and by the query cache)
+  // - the log is kept only if ASSERTION_LOG is enabled or the query
+  //   cache exists
+  // - each successful call to assert_formulas is then stored as a block
+  //   [n, f[0], ..., f[n-1]] in assertion_log
+  // - assertion_marks[i] = size of the log when push was called at level i
+  // - log_taint_level = smallest base level where constraints that are
+  //   not in the log were added (e.g., blocking clauses, or assertions
+  //   made while the log was off). LOG_NO_TAINT means none.
+  ivector_t assertion_log;
+  ivector_t assertion_marks;
+  uint32_t log_taint_level;
+
   // auxiliary buffers and structures for internalization
   ivector_t subst_eqs;
   ivector_t aux_eqs;
@@ -688,6 +728,9 @@ struct context_s {
   divmod_tbl_t *divmod_table;
   bfs_explorer_t *explorer;
 
+  // cache of query results (NULL if disabled)
+  query_cache_t *qcache;
+
   // buffer to store difference-logic data
   dl_data_t *dl_profile;
 
@@ -707,6 +750,12 @@ struct context_s {
   // for verbose output (default NULL)
   tracer_t *trace;
 
+  // profiling timers
+  cycle_timer_t timer[NUM_CTX_TIMERS];
+
+  // set if the last search was stopped by the memory limit
+  bool mem_limit_reached;
+
   // options for the mcsat solver
   mcsat_options_t mcsat_options;
 };
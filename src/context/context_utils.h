@@ -408,6 +408,22 @@ static inline void disable_bvarith_elimination(context_t *ctx) {
   ctx->options &= ~BVARITHELIM_OPTION_MASK;
 }
 
+static inline void enable_bv_known_bits(context_t *ctx) {
+  ctx->options |= BVKNOWNBITS_OPTION_MASK;
+}
+
+static inline void disable_bv_known_bits(context_t *ctx) {
+  ctx->options &= ~BVKNOWNBITS_OPTION_MASK;
+}
+
+static inline void enable_assertion_log(context_t *ctx) {
+  ctx->options |= ASSERTION_LOG_OPTION_MASK;
+}
+
+static inline void disable_assertion_log(context_t *ctx) {
+  ctx->options &= ~ASSERTION_LOG_OPTION_MASK;
+}
+
 static inline void enable_symmetry_breaking(context_t *ctx) {
   ctx->options |= BREAKSYM_OPTION_MASK;
 }
@@ -489,6 +505,14 @@ static inline bool context_bvarith_elim_enabled(context_t *ctx) {
   return (ctx->options & BVARITHELIM_OPTION_MASK) != 0;
 }
 
+static inline bool context_bv_known_bits_enabled(context_t *ctx) {
+  return (ctx->options & BVKNOWNBITS_OPTION_MASK) != 0;
+}
+
+static inline bool context_assertion_log_enabled(context_t *ctx) {
+  return (ctx->options & ASSERTION_LOG_OPTION_MASK) != 0;
+}
+
 static inline bool context_breaksym_enabled(context_t *ctx) {
   return (ctx->options & BREAKSYM_OPTION_MASK) != 0;
 }
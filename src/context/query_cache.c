@@ -0,0 +1,305 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * CACHE OF QUERY RESULTS
+ */
+
+#include <assert.h>
+
+#include "context/query_cache.h"
+#include "utils/hash_functions.h"
+#include "utils/int_array_sort.h"
+#include "utils/memalloc.h"
+
+
+/*
+ * Initialize cache
+ */
+void init_query_cache(query_cache_t *cache, uint32_t size) {
+  assert(size > 0);
+
+  cache->entry = (qcache_entry_t **) safe_malloc(size * sizeof(qcache_entry_t *));
+  cache->nentries = 0;
+  cache->size = size;
+  cache->clock = 0;
+  cache->hit = NULL;
+  init_ivector(&cache->key, 0);
+
+  cache->lookups = 0;
+  cache->hits = 0;
+  cache->subsumed = 0;
+}
+
+
+/*
+ * Delete an entry
+ */
+static void free_entry(qcache_entry_t *e) {
+  safe_free(e->terms);
+  safe_free(e->var);
+  safe_free(e->map);
+  safe_free(e);
+}
+
+void delete_query_cache(query_cache_t *cache) {
+  uint32_t i;
+
+  for (i=0; i<cache->nentries; i++) {
+    free_entry(cache->entry[i]);
+  }
+  safe_free(cache->entry);
+  cache->entry = NULL;
+  cache->hit = NULL;
+  delete_ivector(&cache->key);
+}
+
+
+/*
+ * Remove all entries (the statistics are kept)
+ */
+void qcache_clear(query_cache_t *cache) {
+  uint32_t i;
+
+  for (i=0; i<cache->nentries; i++) {
+    free_entry(cache->entry[i]);
+  }
+  cache->nentries = 0;
+  cache->hit = NULL;
+}
+
+
+/*
+ * Memory used by the cache and its entries
+ */
+uint64_t qcache_mem_size(query_cache_t *cache) {
+  qcache_entry_t *e;
+  uint64_t size;
+  uint32_t i;
+
+  size = sizeof(query_cache_t) + (uint64_t) cache->size * sizeof(qcache_entry_t *);
+  for (i=0; i<cache->nentries; i++) {
+    e = cache->entry[i];
+    size += sizeof(qcache_entry_t) + (uint64_t) (e->nterms + 2 * e->nvars) * sizeof(term_t);
+  }
+
+  return size;
+}
+
+
+/*
+ * Normalize the key
+ */
+uint32_t qcache_normalize_key(query_cache_t *cache) {
+  ivector_t *v;
+  uint32_t i, j, n;
+  term_t t;
+
+  v = &cache->key;
+  int_array_sort(v->data, v->size);
+
+  n = v->size;
+  j = 0;
+  for (i=0; i<n; i++) {
+    t = v->data[i];
+    if (t != true_term && (j == 0 || v->data[j-1] != t)) {
+      v->data[j] = t;
+      j ++;
+    }
+  }
+  v->size = j;
+
+  return jenkins_hash_intarray(v->data, j);
+}
+
+
+/*
+ * Check whether a[0 ... n-1] is a subset of b[0 ... m-1]
+ * - both arrays must be sorted
+ */
+static bool sorted_subset(const term_t *a, uint32_t n, const term_t *b, uint32_t m) {
+  uint32_t i, j;
+
+  if (n > m) return false;
+
+  j = 0;
+  for (i=0; i<n; i++) {
+    while (j < m && b[j] < a[i]) {
+      j ++;
+    }
+    if (j == m || b[j] != a[i]) return false;
+    j ++;
+  }
+
+  return true;
+}
+
+
+/*
+ * Check whether entry e answers the query key[0 ... n-1]
+ * - return 1 for an exact match, 2 if e subsumes the key, 0 otherwise.
+ */
+static uint32_t entry_matches(const qcache_entry_t *e, uint32_t hash, const term_t *key, uint32_t n) {
+  uint32_t i;
+
+  if (e->hash == hash && e->nterms == n) {
+    for (i=0; i<n; i++) {
+      if (e->terms[i] != key[i]) break;
+    }
+    if (i == n) return 1;
+  }
+
+  if (e->status == STATUS_UNSAT) {
+    return sorted_subset(e->terms, e->nterms, key, n) ? 2 : 0;
+  } else {
+    return sorted_subset(key, n, e->terms, e->nterms) ? 2 : 0;
+  }
+}
+
+
+/*
+ * Search for an entry
+ * - exact matches are preferred over subsumption
+ */
+qcache_entry_t *qcache_find(query_cache_t *cache, uint32_t hash, uint32_t params) {
+  qcache_entry_t *e, *best;
+  uint32_t i, k;
+
+  cache->lookups ++;
+  cache->clock ++;
+
+  best = NULL;
+  for (i=0; i<cache->nentries; i++) {
+    e = cache->entry[i];
+    if (e->params == params) {
+      k = entry_matches(e, hash, cache->key.data, cache->key.size);
+      if (k == 1) {
+        best = e;
+        cache->hits ++;
+        goto found;
+      }
+      if (k == 2 && best == NULL) {
+        best = e;
+      }
+    }
+  }
+
+  if (best != NULL) {
+    cache->subsumed ++;
+  found:
+    best->stamp = cache->clock;
+  }
+
+  return best;
+}
+
+
+/*
+ * Copy of array a[0 ... n-1]
+ */
+static term_t *copy_terms(const term_t *a, uint32_t n) {
+  term_t *b;
+  uint32_t i;
+
+  b = NULL;
+  if (n > 0) {
+    b = (term_t *) safe_malloc(n * sizeof(term_t));
+    for (i=0; i<n; i++) {
+      b[i] = a[i];
+    }
+  }
+  return b;
+}
+
+
+/*
+ * Index of the least recently used entry
+ */
+static uint32_t lru_entry(query_cache_t *cache) {
+  uint32_t i, k;
+
+  assert(cache->nentries > 0);
+
+  k = 0;
+  for (i=1; i<cache->nentries; i++) {
+    if (cache->entry[i]->stamp < cache->entry[k]->stamp) {
+      k = i;
+    }
+  }
+  return k;
+}
+
+
+/*
+ * Add an entry
+ */
+void qcache_add(query_cache_t *cache, uint32_t hash, uint32_t params, smt_status_t status,
+                uint32_t n, const term_t *var, const term_t *map) {
+  qcache_entry_t *e;
+  uint32_t i;
+
+  assert(status == STATUS_SAT || status == STATUS_UNSAT);
+
+  e = (qcache_entry_t *) safe_malloc(sizeof(qcache_entry_t));
+  e->hash = hash;
+  e->params = params;
+  e->status = status;
+  e->has_model = (status == STATUS_SAT && var != NULL);
+  e->nterms = cache->key.size;
+  e->terms = copy_terms(cache->key.data, cache->key.size);
+  e->nvars = n;
+  e->var = copy_terms(var, n);
+  e->map = copy_terms(map, n);
+  e->stamp = cache->clock;
+
+  if (cache->nentries == cache->size) {
+    i = lru_entry(cache);
+    if (cache->hit == cache->entry[i]) {
+      cache->hit = NULL;
+    }
+    free_entry(cache->entry[i]);
+  } else {
+    i = cache->nentries;
+    cache->nentries ++;
+  }
+  cache->entry[i] = e;
+}
+
+
+/*
+ * Mark terms
+ */
+static void mark_terms(term_table_t *terms, const term_t *a, uint32_t n) {
+  uint32_t i;
+
+  for (i=0; i<n; i++) {
+    term_table_set_gc_mark(terms, index_of(a[i]));
+  }
+}
+
+void qcache_gc_mark(query_cache_t *cache, term_table_t *terms) {
+  qcache_entry_t *e;
+  uint32_t i;
+
+  for (i=0; i<cache->nentries; i++) {
+    e = cache->entry[i];
+    mark_terms(terms, e->terms, e->nterms);
+    mark_terms(terms, e->var, e->nvars);
+    mark_terms(terms, e->map, e->nvars);
+  }
+}
@@ -0,0 +1,154 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * CACHE OF QUERY RESULTS
+ *
+ * Terms are hash-consed so a set of assertions can be identified by
+ * the sorted array of its term indices. The cache maps such a key
+ * (plus a digest of the search parameters) to the result of a previous
+ * check: either UNSAT, or SAT with a model given as a map from
+ * uninterpreted terms to constant terms. If the model can't be
+ * represented this way (e.g., it assigns a value to a function
+ * symbol), a SAT entry is stored without a model.
+ *
+ * Lookups also use subsumption:
+ * - if the key includes the key of an UNSAT entry, the result is UNSAT
+ * - if the key is included in the key of a SAT entry, the result
+ *   is SAT and the entry's model is a model of the key.
+ *
+ * The number of entries is bounded. When the cache is full, the least
+ * recently used entry is removed.
+ */
+
+#ifndef __QUERY_CACHE_H
+#define __QUERY_CACHE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "api/search_parameters.h"
+#include "terms/terms.h"
+#include "utils/int_vectors.h"
+
+
+/*
+ * Cache entry
+ * - hash = hash of the key
+ * - params = digest of the search parameters
+ * - status = STATUS_SAT or STATUS_UNSAT
+ * - stamp = time of the last use
+ * - key = terms[0 ... nterms-1] sorted in increasing order
+ * - has_model: true if the model is stored
+ * - model (if status is SAT and has_model is true): var[i] := map[i] for i=0 ... nvars-1
+ */
+typedef struct qcache_entry_s {
+  uint32_t hash;
+  uint32_t params;
+  smt_status_t status;
+  bool has_model;
+  uint32_t nterms;
+  uint32_t nvars;
+  uint64_t stamp;
+  term_t *terms;
+  term_t *var;
+  term_t *map;
+} qcache_entry_t;
+
+
+/*
+ * Cache:
+ * - entry[0 ... nentries-1] = the entries
+ * - size = maximal number of entries
+ * - clock = counter incremented on every lookup
+ * - hit = entry that answered the last query (NULL if the last check
+ *   was not answered from the cache)
+ * - params = search parameters of the last query
+ * - key = buffer to build keys
+ * - statistics: number of lookups, of exact hits, and of hits by subsumption
+ */
+typedef struct query_cache_s {
+  qcache_entry_t **entry;
+  uint32_t nentries;
+  uint32_t size;
+  uint64_t clock;
+  qcache_entry_t *hit;
+  param_t params;
+  ivector_t key;
+
+  uint32_t lookups;
+  uint32_t hits;
+  uint32_t subsumed;
+} query_cache_t;
+
+#define QCACHE_DEFAULT_SIZE 64
+
+
+/*
+ * Initialize cache with the given size (size must be positive)
+ */
+extern void init_query_cache(query_cache_t *cache, uint32_t size);
+
+/*
+ * Delete all entries and free memory
+ */
+extern void delete_query_cache(query_cache_t *cache);
+
+/*
+ * Remove all entries
+ */
+extern void qcache_clear(query_cache_t *cache);
+
+/*
+ * Estimate of the memory used by the cache (in bytes)
+ */
+extern uint64_t qcache_mem_size(query_cache_t *cache);
+
+/*
+ * Prepare the key stored in cache->key
+ * - sort it and remove duplicates and true_term
+ * - return the key's hash
+ */
+extern uint32_t qcache_normalize_key(query_cache_t *cache);
+
+/*
+ * Search for an entry that answers the query defined by cache->key
+ * - hash = hash of the key (as returned by qcache_normalize_key)
+ * - params = digest of the search parameters
+ * - return NULL if there's no such entry
+ */
+extern qcache_entry_t *qcache_find(query_cache_t *cache, uint32_t hash, uint32_t params);
+
+/*
+ * Add a new entry for cache->key
+ * - status must be STATUS_SAT or STATUS_UNSAT
+ * - for STATUS_SAT, the model is var[i] := map[i] for i=0 ... n-1
+ *   (or var = NULL and n = 0 if the model can't be stored)
+ * - if the cache is full, the least recently used entry is removed
+ */
+extern void qcache_add(query_cache_t *cache, uint32_t hash, uint32_t params, smt_status_t status,
+                       uint32_t n, const term_t *var, const term_t *map);
+
+/*
+ * Mark all the terms stored in the cache (to preserve them during
+ * garbage collection)
+ */
+extern void qcache_gc_mark(query_cache_t *cache, term_table_t *terms);
+
+
+#endif /* __QUERY_CACHE_H */
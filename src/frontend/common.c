@@ -152,11 +152,14 @@ static const char * const param_names[NUM_PARAMETERS] = {
   "aux-eq-quota",
   "aux-eq-ratio",
   "bland-threshold",
+  "bool-preprocess",
   "branching",
   "bvarith-elim",
   "c-factor",
   "c-threshold",
   "cache-tclauses",
+  "chrono-backtrack",
+  "chrono-threshold",
   "clause-decay",
   "d-factor",
   "d-threshold",
@@ -183,6 +186,7 @@ static const char * const param_names[NUM_PARAMETERS] = {
   "max-update-conflicts",
   "mcsat-nra-mgcd",
   "mcsat-nra-nlsat",
+  "memory-limit",
   "optimistic-fcheck",
   "prop-threshold",
   "r-factor",
@@ -192,6 +196,7 @@ static const char * const param_names[NUM_PARAMETERS] = {
   "randomness",
   "simplex-adjust",
   "simplex-prop",
+  "sls-flips",
   "tclause-size",
   "var-decay",
   "var-elim",
@@ -203,11 +208,14 @@ static const yices_param_t param_code[NUM_PARAMETERS] = {
   PARAM_AUX_EQ_QUOTA,
   PARAM_AUX_EQ_RATIO,
   PARAM_BLAND_THRESHOLD,
+  PARAM_BOOL_PREPROCESS,
   PARAM_BRANCHING,
   PARAM_BVARITH_ELIM,
   PARAM_C_FACTOR,
   PARAM_C_THRESHOLD,
   PARAM_CACHE_TCLAUSES,
+  PARAM_CHRONO_BACKTRACK,
+  PARAM_CHRONO_THRESHOLD,
   PARAM_CLAUSE_DECAY,
   PARAM_D_FACTOR,
   PARAM_D_THRESHOLD,
@@ -234,6 +242,7 @@ static const yices_param_t param_code[NUM_PARAMETERS] = {
   PARAM_MAX_UPDATE_CONFLICTS,
   PARAM_MCSAT_NRA_MGCD,
   PARAM_MCSAT_NRA_NLSAT,
+  PARAM_MEMORY_LIMIT,
   PARAM_OPTIMISTIC_FCHECK,
   PARAM_PROP_THRESHOLD,
   PARAM_R_FACTOR,
@@ -243,6 +252,7 @@ static const yices_param_t param_code[NUM_PARAMETERS] = {
   PARAM_RANDOMNESS,
   PARAM_SIMPLEX_ADJUST,
   PARAM_SIMPLEX_PROP,
+  PARAM_SLS_FLIPS,
   PARAM_TCLAUSE_SIZE,
   PARAM_VAR_DECAY,
   PARAM_VAR_ELIM,
@@ -104,6 +104,10 @@ typedef enum yices_param {
   PARAM_CLAUSE_DECAY,
   PARAM_CACHE_TCLAUSES,
   PARAM_TCLAUSE_SIZE,
+  PARAM_CHRONO_BACKTRACK,
+  PARAM_CHRONO_THRESHOLD,
+  PARAM_SLS_FLIPS,
+  PARAM_BOOL_PREPROCESS,
   // egraph parameters
   PARAM_DYN_ACK,
   PARAM_DYN_BOOL_ACK,
@@ -126,6 +130,8 @@ typedef enum yices_param {
   // array solver parameters
   PARAM_MAX_UPDATE_CONFLICTS,
   PARAM_MAX_EXTENSIONALITY,
+  // resource limits
+  PARAM_MEMORY_LIMIT,
   // EF solver
   PARAM_EF_FLATTEN_IFF,
   PARAM_EF_FLATTEN_ITE,
@@ -1576,9 +1576,12 @@ static void show_core_stats(smt_core_t *core) {
   print_out(" :clause-db-simplify %"PRIu32"\n", num_simplify_calls(core));
   print_out(" :decisions %"PRIu64"\n", num_decisions(core));
   print_out(" :conflicts %"PRIu64"\n", num_conflicts(core));
+  print_out(" :chrono-backtracks %"PRIu64"\n", num_chrono_backtracks(core));
   print_out(" :theory-conflicts %"PRIu32"\n", num_theory_conflicts(core));
   print_out(" :boolean-propagations %"PRIu64"\n", num_propagations(core));
   print_out(" :theory-propagations %"PRIu32"\n", num_theory_propagations(core));
+  print_out(" :substituted-variables %"PRIu32"\n", num_subst_vars(core));
+  print_out(" :eliminated-variables %"PRIu32"\n", num_elim_vars(core));
 }
 
 static void show_egraph_stats(egraph_t *egraph) {
@@ -1588,6 +1591,7 @@ static void show_egraph_stats(egraph_t *egraph) {
   print_out(" :egraph-ackermann-lemmas %"PRIu32"\n", egraph_all_ackermann(egraph));
   print_out(" :egraph-final-checks %"PRIu32"\n", egraph_num_final_checks(egraph));
   print_out(" :egraph-interface-lemmas %"PRIu32"\n", egraph_num_interface_eqs(egraph));
+  print_out(" :egraph-explanation-cache-hits %"PRIu32"\n", egraph_num_expl_cache_hits(egraph));
 }
 
 static void show_funsolver_stats(fun_solver_t *solver) {
@@ -1613,7 +1617,13 @@ static void show_simplex_stats(simplex_solver_t *solver) {
       simplex_num_dioph_checks(solver) > 0) {
     print_out(" :simplex-integer-vars %"PRIu32"\n", simplex_num_integer_vars(solver));
     print_out(" :simplex-branch-and-bound %"PRIu32"\n", simplex_num_branch_and_bound(solver));
+    print_out(" :simplex-branch-nodes %"PRIu32"\n", simplex_num_branch_nodes(solver));
+    print_out(" :simplex-pcost-branches %"PRIu32"\n", simplex_num_pcost_branches(solver));
+    print_out(" :simplex-cube-tests %"PRIu32"\n", simplex_num_cube_tests(solver));
+    print_out(" :simplex-cube-successes %"PRIu32"\n", simplex_num_cube_successes(solver));
     // bound strenthening
+    print_out(" :simplex-presolve-bounds %"PRIu32"\n", simplex_num_presolve_bounds(solver));
+    print_out(" :simplex-strengthen-rounds %"PRIu32"\n", simplex_num_strengthen_rounds(solver));
     print_out(" :simplex-bound-conflicts %"PRIu32"\n", simplex_num_bound_conflicts(solver));
     print_out(" :simplex-bound-recheck-conflicts %"PRIu32"\n", simplex_num_bound_recheck_conflicts(solver));
     // integrality test
@@ -1634,6 +1644,8 @@ static void show_bvsolver_stats(bv_solver_t *solver) {
   print_out(" :bvsolver-atoms %"PRIu32"\n", bv_solver_num_atoms(solver));
   print_out(" :bvsolver-equiv-lemmas %"PRIu32"\n", bv_solver_equiv_lemmas(solver));
   print_out(" :bvsolver-interface-lemmas %"PRIu32"\n", bv_solver_interface_lemmas(solver));
+  print_out(" :bvsolver-bound-propagations %"PRIu32"\n", bv_solver_bound_propagations(solver));
+  print_out(" :bvsolver-bound-conflicts %"PRIu32"\n", bv_solver_bound_conflicts(solver));
 }
 
 static void show_idl_fw_stats(idl_solver_t *solver) {
@@ -1686,17 +1698,24 @@ static void show_ctx_stats(context_t *ctx) {
  * Global state
  */
 static void show_statistics(smt2_globals_t *g) {
-  double time, mem;
+  double time, mem, peak;
 
   time = get_cpu_time();
   mem = mem_size() / (1024*1024);
+  peak = peak_mem_size() / (1024*1024);
 
   print_out("(:num-terms %"PRIu32"\n", yices_num_terms());
   print_out(" :num-types %"PRIu32"\n", yices_num_types());
   print_out(" :total-run-time %.3f\n", time);
+  print_out(" :internalization-time %.3f\n", g->internalization_time);
+  print_out(" :search-time %.3f\n", g->search_time);
+  print_out(" :model-time %.3f\n", g->model_time);
   if (mem > 0) {
     print_out(" :mem-usage %.3f\n", mem);
   }
+  if (peak > 0) {
+    print_out(" :peak-mem-usage %.3f\n", peak);
+  }
   if (g->ctx != NULL) {
     show_ctx_stats(g->ctx);
   }
@@ -2393,16 +2412,39 @@ static void timeout_handler(void *data) {
   }
 }
 
+/*
+ * Write the event trace of g->ctx to g->event_trace_file
+ */
+static void dump_event_trace(smt2_globals_t *g) {
+  FILE *f;
+
+  if (g->ctx->core == NULL) return;
+
+  f = fopen(g->event_trace_file, "w");
+  if (f == NULL) {
+    perror(g->event_trace_file);
+    return;
+  }
+  if (write_event_trace(smt_event_trace(g->ctx->core), f) < 0) {
+    perror(g->event_trace_file);
+  }
+  fclose(f);
+}
+
 /*
  * Call check_context with the given search parameters.
  * - if g->timeout is positive, set a timeout first
  */
 static smt_status_t check_context_with_timeout(smt2_globals_t *g, const param_t *params) {
   smt_status_t stat;
+  double start;
 
+  start = get_cpu_time();
   if (g->timeout == 0) {
     // no timeout
-    return check_context(g->ctx, params);
+    stat = check_context(g->ctx, params);
+    g->search_time += get_cpu_time() - start;
+    return stat;
   }
 
   /*
@@ -2417,6 +2459,7 @@ static smt_status_t check_context_with_timeout(smt2_globals_t *g, const param_t
   start_timeout(g->timeout, timeout_handler, g);
   stat = check_context(g->ctx, params);
   clear_timeout();
+  g->search_time += get_cpu_time() - start;
 
   /*
    * Attempt to cleanly recover from interrupt
@@ -2424,6 +2467,9 @@ static smt_status_t check_context_with_timeout(smt2_globals_t *g, const param_t
   if (stat == STATUS_INTERRUPTED) {
     trace_printf(g->tracer, 2, "(check_sat: interrupted)\n");
     g->interrupted = true;
+    if (g->event_trace_file != NULL) {
+      dump_event_trace(g);
+    }
     if (context_get_mode(g->ctx) == CTX_MODE_INTERACTIVE) {
       context_cleanup(g->ctx);
       assert(context_status(g->ctx) == STATUS_IDLE);
@@ -2655,6 +2701,7 @@ static void add_delayed_assertion(smt2_globals_t *g, term_t t) {
 static void check_delayed_assertions(smt2_globals_t *g) {
   int32_t code;
   smt_status_t status;
+  double start;
 
   // set frozen to true to disable more assertions
   g->frozen = true;
@@ -2675,7 +2722,9 @@ static void check_delayed_assertions(smt2_globals_t *g) {
     }
     init_smt2_context(g);
 #if 1
+    start = get_cpu_time();
     code = yices_assert_formulas(g->ctx, g->assertions.size, g->assertions.data);
+    g->internalization_time += get_cpu_time() - start;
     if (code < 0) {
       // error during assertion processing
       print_yices_error(true);
@@ -2779,6 +2828,7 @@ static void show_delayed_assertions(smt2_globals_t *g) {
  * - t is known to be a Boolean term here
  */
 static void add_assertion(smt2_globals_t *g, term_t t) {
+  double start;
   int32_t code;
 
   assert(g->ctx != NULL && context_supports_pushpop(g->ctx));
@@ -2796,7 +2846,9 @@ static void add_assertion(smt2_globals_t *g, term_t t) {
     // fall-through intended
 
   case STATUS_IDLE:
+    start = get_cpu_time();
     code = assert_formula(g->ctx, t);
+    g->internalization_time += get_cpu_time() - start;
     if (code < 0) {
       yices_internalization_error(code);
       print_yices_error(true);
@@ -2949,6 +3001,7 @@ static void ctx_pop(smt2_globals_t *g) {
  */
 static model_t *get_model(smt2_globals_t *g) {
   model_t *mdl;
+  double start;
 
   mdl = g->model;
   if (mdl == NULL) {
@@ -2972,7 +3025,9 @@ static model_t *get_model(smt2_globals_t *g) {
       switch (context_status(g->ctx)) {
       case STATUS_UNKNOWN:
       case STATUS_SAT:
+	start = get_cpu_time();
 	mdl = yices_get_model(g->ctx, true);
+	g->model_time += get_cpu_time() - start;
 	break;
 
       case STATUS_UNSAT:
@@ -3196,6 +3251,8 @@ static void show_assignment(smt2_globals_t *g) {
 /*
  * If global_decls is false and the push/pop stack is not empty, push a
  * name onto a name stack so that we can remove the declaration on pop.
+ * In a server session, all names are pushed so that we can remove them
+ * when the session ends.
  *
  * NOTE: s is cloned twice: once to be stored in the term/type/macro
  * symbol tables and once more here. Maybe we could optimize this.
@@ -3203,7 +3260,7 @@ static void show_assignment(smt2_globals_t *g) {
 static void save_name(smt2_globals_t *g, smt2_name_stack_t *name_stack, const char *s) {
   char *clone;
 
-  if (!g->global_decls && smt2_stack_is_nonempty(&g->stack)) {
+  if (g->session || (!g->global_decls && smt2_stack_is_nonempty(&g->stack))) {
     clone = clone_string(s);
     smt2_push_name(name_stack, clone);
   }
@@ -3292,6 +3349,8 @@ static void explain_unknown_status(smt2_globals_t *g) {
       case STATUS_UNKNOWN:
 	if (g->interrupted) {
 	  print_kw_symbol_pair(":reason-unknown", "timeout");
+	} else if (g->ctx->mem_limit_reached) {
+	  print_kw_symbol_pair(":reason-unknown", "memout");
 	} else {
 	  print_kw_symbol_pair(":reason-unknown", "incomplete");
 	}
@@ -3360,6 +3419,7 @@ static void init_smt2_globals(smt2_globals_t *g) {
   g->timeout = 0;
   g->timeout_initialized = false;
   g->interrupted = false;
+  g->event_trace_file = NULL;
   g->avtbl = NULL;
   g->info = NULL;
   g->ctx = NULL;
@@ -3390,6 +3450,10 @@ static void init_smt2_globals(smt2_globals_t *g) {
   init_ivector(&g->assertions, 0);
   g->trivially_unsat = false;
   g->frozen = false;
+  g->session = false;
+  g->internalization_time = 0.0;
+  g->search_time = 0.0;
+  g->model_time = 0.0;
 }
 
 
@@ -3488,6 +3552,14 @@ void smt2_enable_trace_tag(const char* tag) {
 }
 
 
+/*
+ * File for the event trace
+ */
+void smt2_set_event_trace_file(const char *filename) {
+  __smt2_globals.event_trace_file = filename;
+}
+
+
 /*
  * Display all statistics
  */
@@ -3505,6 +3577,30 @@ void delete_smt2(void) {
 }
 
 
+/*
+ * Server session
+ */
+void init_smt2_session(bool benchmark, uint32_t timeout) {
+  init_smt2(benchmark, timeout, false);
+  __smt2_globals.session = true;
+}
+
+void delete_smt2_session(void) {
+  smt2_globals_t *g;
+
+  g = &__smt2_globals;
+  assert(g->session);
+
+  smt2_pop_term_names(&g->term_names, 0);
+  smt2_pop_type_names(&g->type_names, 0);
+  smt2_pop_macro_names(&g->macro_names, 0);
+  delete_smt2();
+
+  // the terms and types created by this session are now unreachable
+  yices_garbage_collect(NULL, 0, NULL, 0, true);
+}
+
+
 /*
  * Check whether the smt2 solver is ready
  * - this must be true after init_smt2()
@@ -3777,6 +3873,22 @@ static bool yices_get_option(const smt2_globals_t *g, yices_param_t p) {
     print_uint32_value(g->parameters.tclause_size);
     break;
 
+  case PARAM_CHRONO_BACKTRACK:
+    print_boolean_value(g->parameters.chrono_backtrack);
+    break;
+
+  case PARAM_CHRONO_THRESHOLD:
+    print_uint32_value(g->parameters.chrono_threshold);
+    break;
+
+  case PARAM_SLS_FLIPS:
+    print_uint32_value(g->parameters.sls_flips);
+    break;
+
+  case PARAM_BOOL_PREPROCESS:
+    print_boolean_value(g->parameters.bool_preprocess);
+    break;
+
   case PARAM_DYN_ACK:
     print_boolean_value(g->parameters.use_dyn_ack);
     break;
@@ -3853,6 +3965,10 @@ static bool yices_get_option(const smt2_globals_t *g, yices_param_t p) {
     print_uint32_value(g->parameters.max_extensionality);
     break;
 
+  case PARAM_MEMORY_LIMIT:
+    print_uint32_value(g->parameters.memory_limit);
+    break;
+
   case PARAM_EF_FLATTEN_IFF:
     print_boolean_value(g->ef_client.ef_parameters.flatten_iff);
     break;
@@ -4280,6 +4396,30 @@ static void yices_set_option(smt2_globals_t *g, const char *param, const param_v
     }
     break;
 
+  case PARAM_CHRONO_BACKTRACK:
+    if (param_val_to_bool(param, val, &tt, &reason)) {
+      g->parameters.chrono_backtrack = tt;
+    }
+    break;
+
+  case PARAM_CHRONO_THRESHOLD:
+    if (param_val_to_nonneg32(param, val, &n, &reason)) {
+      g->parameters.chrono_threshold = n;
+    }
+    break;
+
+  case PARAM_SLS_FLIPS:
+    if (param_val_to_nonneg32(param, val, &n, &reason)) {
+      g->parameters.sls_flips = n;
+    }
+    break;
+
+  case PARAM_BOOL_PREPROCESS:
+    if (param_val_to_bool(param, val, &tt, &reason)) {
+      g->parameters.bool_preprocess = tt;
+    }
+    break;
+
   case PARAM_DYN_ACK:
     if (param_val_to_bool(param, val, &tt, &reason)) {
       g->parameters.use_dyn_ack = tt;
@@ -4410,6 +4550,12 @@ static void yices_set_option(smt2_globals_t *g, const char *param, const param_v
     }
     break;
 
+  case PARAM_MEMORY_LIMIT:
+    if (param_val_to_nonneg32(param, val, &n, &reason)) {
+      g->parameters.memory_limit = n;
+    }
+    break;
+
   case PARAM_EF_FLATTEN_IFF:
     if (param_val_to_bool(param, val, &tt, &reason)) {
       g->ef_client.ef_parameters.flatten_iff = tt;
@@ -4766,10 +4912,12 @@ void smt2_pop(uint32_t n) {
 	  r = smt2_stack_top(&g->stack);
 	  m += r->multiplicity;
 
-	  // remove declarations: this has no effect if g->global_decls is true
-	  smt2_pop_term_names(&g->term_names, r->term_decls);
-	  smt2_pop_type_names(&g->type_names, r->type_decls);
-	  smt2_pop_macro_names(&g->macro_names, r->macro_decls);
+	  // remove declarations: global declarations are kept
+	  if (! g->global_decls) {
+	    smt2_pop_term_names(&g->term_names, r->term_decls);
+	    smt2_pop_type_names(&g->type_names, r->type_decls);
+	    smt2_pop_macro_names(&g->macro_names, r->macro_decls);
+	  }
 
 	  // remove the named booleans and named assertions
 	  pop_named_terms(&g->named_bools, r->named_bools);
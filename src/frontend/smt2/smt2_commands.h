@@ -390,6 +390,7 @@ typedef struct smt2_globals_s {
   uint32_t timeout;           // default = 0 (no timeout)
   bool timeout_initialized;   // initially false. true once init_timeout is called
   bool interrupted;           // true if the most recent call to check_sat timed out
+  const char *event_trace_file; // if non-NULL: where to write the event trace on timeout
 
   // internals
   attr_vtbl_t *avtbl;        // global attribute table
@@ -428,6 +429,24 @@ typedef struct smt2_globals_s {
   ivector_t assertions;
   bool trivially_unsat;
   bool frozen;
+
+  /*
+   * Server sessions: if this flag is true, all declarations are
+   * recorded in the name stacks so that they can be removed when
+   * the session ends (cf. delete_smt2_session).
+   */
+  bool session;
+
+  /*
+   * CPU time spent in each phase (in seconds):
+   * - processing of assertions (internalization)
+   * - search (check-sat)
+   * - model construction
+   * Parsing and everything else is the rest of the total run time.
+   */
+  double internalization_time;
+  double search_time;
+  double model_time;
 } smt2_globals_t;
 
 
@@ -458,6 +477,14 @@ extern void smt2_enable_mcsat(void);
  */
 extern void smt2_set_verbosity(uint32_t k);
 
+/*
+ * Write the context's event trace to the given file if a
+ * check-sat times out (cf. yices_dump_event_trace).
+ * - the file is overwritten on every timeout
+ * - must be called after init_smt2
+ */
+extern void smt2_set_event_trace_file(const char *filename);
+
 /*
  * Enable a trace tag for tracing.
  * - must be called after init_smt2
@@ -478,6 +505,20 @@ extern void smt2_show_stats(void);
 extern void delete_smt2(void);
 
 
+/*
+ * Server sessions: process several scripts in the same process
+ * - init_smt2_session does the same thing as init_smt2 but it records
+ *   all declarations (including global ones)
+ * - delete_smt2_session removes all the term, type, and macro names
+ *   declared in the session, deletes all internal structures, then
+ *   calls the garbage collector.
+ * The global term and type tables are kept so there's no need to call
+ * yices_exit/yices_init between sessions.
+ */
+extern void init_smt2_session(bool benchmark, uint32_t timeout);
+extern void delete_smt2_session(void);
+
+
 /*
  * Check whether the smt2 solver is ready
  * - this must be true after init_smt2()
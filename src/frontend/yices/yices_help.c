@@ -1576,11 +1576,68 @@ static const help_record_t help_data[] = {
     "The atom (is-int x) is true iff x is an integer.\n",
     NULL },
 
-  // END MARKER: index 158
+  // chrono-backtrack: index 158
+  { HPARAM,
+    "(set-param chrono-backtrack [boolean])",
+    "Enable/disable chronological backtracking",
+    "By default, after a conflict, the SAT solver backjumps to the level\n"
+    "where the learned clause becomes unit. If chrono-backtrack is true,\n"
+    "the solver may instead backtrack by a single decision level and\n"
+    "keep most of its current assignment.\n",
+    NULL },
+
+  // chrono-threshold: index 159
+  { HPARAM,
+    "(set-param chrono-threshold [integer])",
+    "Threshold for chronological backtracking",
+    "   [integer] must be non-negative\n"
+    "\n"
+    "If chrono-backtrack is true, the solver backtracks chronologically\n"
+    "when a backjump would skip more than 'chrono-threshold' decision levels.\n",
+    NULL },
+
+  // sls-flips: index 160
+  { HPARAM,
+    "(set-param sls-flips [integer])",
+    "Local search for the initial polarity",
+    "   [integer] must be non-negative\n"
+    "\n"
+    "If sls-flips is positive, a local search is run on the clauses\n"
+    "before the search starts, with at most 'sls-flips' flips. The best\n"
+    "assignment found is used as the initial polarity of the boolean\n"
+    "variables. Local search is disabled if sls-flips is 0 (default).\n",
+    NULL },
+
+  // memory-limit: index 161
+  { HPARAM,
+    "(set-param memory-limit [integer])",
+    "Soft limit on the memory used by the context",
+    "   [integer] must be non-negative (in megabytes)\n"
+    "\n"
+    "If the memory used by the context exceeds this limit during the\n"
+    "search, the solver deletes its learned clauses and caches. If that's\n"
+    "not enough, the search stops and the result is 'unknown'.\n"
+    "There's no limit if memory-limit is 0 (default).\n",
+    NULL },
+
+  // bool-preprocess: index 162
+  { HPARAM,
+    "(set-param bool-preprocess [boolean])",
+    "Simplification of the clauses before the search",
+    "   [boolean] must be either true or false\n"
+    "\n"
+    "If bool-preprocess is true, the clauses are simplified before the\n"
+    "first search by subsumption, substitution of equivalent literals,\n"
+    "and elimination of variables that are not attached to atoms.\n"
+    "This is done only in one-shot and multi-checks contexts without\n"
+    "bitvectors. It's disabled by default.\n",
+    NULL },
+
+  // END MARKER: index 163
   { HMISC, NULL, NULL, NULL, NULL },
 };
 
-#define END_HELP_DATA 158
+#define END_HELP_DATA 163
 
 
 
@@ -1934,6 +1991,7 @@ static const help_index_t help_index[] = {
   { "bitvectors", "Bitvector Operators", HBITVECTOR, help_for_category },
   { "bland-threshold", NULL, 134, help_basic },
   { "bool", NULL, 23, help_basic },
+  { "bool-preprocess", NULL, 162, help_basic },
   { "bool-to-bv", NULL, 142, help_basic },
   { "booleans", "Boolean Operators", HBOOLEAN, help_for_category },
   { "branching", NULL, 117, help_basic },
@@ -1986,6 +2044,8 @@ static const help_index_t help_index[] = {
   { "cache-tclauses", NULL, 119, help_basic },
   { "ceil", NULL, 153, help_basic },
   { "check", NULL, 5, help_basic },
+  { "chrono-backtrack", NULL, 158, help_basic },
+  { "chrono-threshold", NULL, 159, help_basic },
   { "clause-decay", NULL, 118, help_basic },
   { "commands", "Command Summary", HCOMMAND, help_for_category },
   { "d-factor", NULL, 110, help_basic },
@@ -2031,6 +2091,7 @@ static const help_index_t help_index[] = {
   { "max-extensionality", NULL, 138, help_basic },
   { "max-interface-eqs", NULL, 129, help_basic },
   { "max-update-conflicts", NULL, 137, help_basic },
+  { "memory-limit", NULL, 161, help_basic },
   { "mk-bv", NULL, 57, help_basic },
   { "mk-tuple", NULL, 35, help_basic },
   { "mod", NULL, 155, help_basic },
@@ -2061,6 +2122,7 @@ static const help_index_t help_index[] = {
   { "show-timeout", NULL, 19, help_basic },
   { "simplex-adjust", NULL, 133, help_basic },
   { "simplex-prop", NULL, 131, help_basic },
+  { "sls-flips", NULL, 160, help_basic },
   { "syntax", syntax_summary, 0, help_special },
   { "tclause-size", NULL, 120, help_basic },
   { "true", NULL, 39, help_basic },
@@ -1070,6 +1070,22 @@ static void show_param(yices_param_t p, uint32_t n) {
     show_pos32_param(param2string[p], parameters.tclause_size, n);
     break;
 
+  case PARAM_CHRONO_BACKTRACK:
+    show_bool_param(param2string[p], parameters.chrono_backtrack, n);
+    break;
+
+  case PARAM_CHRONO_THRESHOLD:
+    show_pos32_param(param2string[p], parameters.chrono_threshold, n);
+    break;
+
+  case PARAM_SLS_FLIPS:
+    show_pos32_param(param2string[p], parameters.sls_flips, n);
+    break;
+
+  case PARAM_BOOL_PREPROCESS:
+    show_bool_param(param2string[p], parameters.bool_preprocess, n);
+    break;
+
   case PARAM_DYN_ACK:
     show_bool_param(param2string[p], parameters.use_dyn_ack, n);
     break;
@@ -1146,6 +1162,10 @@ static void show_param(yices_param_t p, uint32_t n) {
     show_pos32_param(param2string[p], parameters.max_extensionality, n);
     break;
 
+  case PARAM_MEMORY_LIMIT:
+    show_pos32_param(param2string[p], parameters.memory_limit, n);
+    break;
+
   case PARAM_EF_FLATTEN_IFF:
     show_bool_param(param2string[p], ef_client_globals.ef_parameters.flatten_iff, n);
     break;
@@ -1422,6 +1442,34 @@ static void yices_setparam_cmd(const char *param, const param_val_t *val) {
     }
     break;
 
+  case PARAM_CHRONO_BACKTRACK:
+    if (param_val_to_bool(param, val, &tt, &reason)) {
+      parameters.chrono_backtrack = tt;
+      print_ok();
+    }
+    break;
+
+  case PARAM_CHRONO_THRESHOLD:
+    if (param_val_to_nonneg32(param, val, &n, &reason)) {
+      parameters.chrono_threshold = n;
+      print_ok();
+    }
+    break;
+
+  case PARAM_SLS_FLIPS:
+    if (param_val_to_nonneg32(param, val, &n, &reason)) {
+      parameters.sls_flips = n;
+      print_ok();
+    }
+    break;
+
+  case PARAM_BOOL_PREPROCESS:
+    if (param_val_to_bool(param, val, &tt, &reason)) {
+      parameters.bool_preprocess = tt;
+      print_ok();
+    }
+    break;
+
   case PARAM_DYN_ACK:
     if (param_val_to_bool(param, val, &tt, &reason)) {
       parameters.use_dyn_ack = tt;
@@ -1569,6 +1617,13 @@ static void yices_setparam_cmd(const char *param, const param_val_t *val) {
     }
     break;
 
+  case PARAM_MEMORY_LIMIT:
+    if (param_val_to_nonneg32(param, val, &n, &reason)) {
+      parameters.memory_limit = n;
+      print_ok();
+    }
+    break;
+
   case PARAM_EF_FLATTEN_IFF:
     if (param_val_to_bool(param, val, &tt, &reason)) {
       ef_client_globals.ef_parameters.flatten_iff = tt;
@@ -1683,6 +1738,7 @@ static void show_egraph_stats(egraph_stats_t *stat) {
   printf(" other dyn ack.lemmas    : %"PRIu32"\n", stat->ack_lemmas);
   printf(" final checks            : %"PRIu32"\n", stat->final_checks);
   printf(" interface equalities    : %"PRIu32"\n", stat->interface_eqs);
+  printf(" expl. cache hits        : %"PRIu32"\n", stat->expl_cache_hits);
 }
 
 static void show_funsolver_stats(fun_solver_stats_t *stat) {
@@ -1724,7 +1780,14 @@ static void show_simplex_stats(simplex_stats_t *stat) {
     printf("Integer arithmetic\n");
     printf(" make integer feasible   : %"PRIu32"\n", stat->num_make_intfeasible);
     printf(" branch atoms            : %"PRIu32"\n", stat->num_branch_atoms);
+    printf(" branch nodes            : %"PRIu32"\n", stat->num_branch_nodes);
+    printf(" pseudo-cost branches    : %"PRIu32"\n", stat->num_pcost_branches);
+    printf(" cube tests              : %"PRIu32"\n", stat->num_cube_tests);
+    printf(" cube successes          : %"PRIu32"\n", stat->num_cube_successes);
     printf("bound strengthening\n");
+    printf(" presolve bounds         : %"PRIu32"\n", stat->num_presolve_bounds);
+    printf(" presolve conflicts      : %"PRIu32"\n", stat->num_presolve_conflicts);
+    printf(" rounds                  : %"PRIu32"\n", stat->num_strengthen_rounds);
     printf(" conflicts               : %"PRIu32"\n", stat->num_bound_conflicts);
     printf(" recheck conflicts       : %"PRIu32"\n", stat->num_bound_recheck_conflicts);
     printf("integrality tests\n");
@@ -1750,6 +1813,8 @@ static void show_bvsolver_stats(bv_solver_t *solver) {
   printf(" sge atoms               : %"PRIu32"\n", bv_solver_num_sge_atoms(solver));
   printf(" equiv lemmas            : %"PRIu32"\n", solver->stats.equiv_lemmas);
   printf(" interface lemmas        : %"PRIu32"\n", solver->stats.interface_lemmas);
+  printf(" bound propagations      : %"PRIu32"\n", bv_solver_bound_propagations(solver));
+  printf(" bound conflicts         : %"PRIu32"\n", bv_solver_bound_conflicts(solver));
 }
 
 
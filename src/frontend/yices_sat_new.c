@@ -426,6 +426,11 @@ static bool var_elim_skip_given;
 static bool res_clause_limit_given;
 static bool simplify_interval_given;
 static bool simplify_bin_delta_given;
+static bool search_mode_given;
+static bool mode_interval_given;
+static bool stable_restart_unit_given;
+static bool rephase_interval_given;
+static bool walk_flips_given;
 
 static double var_decay;
 static double clause_decay;
@@ -441,6 +446,11 @@ static uint32_t var_elim_skip;
 static uint32_t res_clause_limit;
 static uint32_t simplify_interval;
 static uint32_t simplify_bin_delta;
+static nsat_search_mode_t search_mode;
+static uint32_t mode_interval;
+static uint32_t stable_restart_unit;
+static uint32_t rephase_interval;
+static uint32_t walk_flips;
 
 enum {
   version_flag,
@@ -466,6 +476,11 @@ enum {
   res_clause_limit_opt,
   simplify_interval_opt,
   simplify_bin_delta_opt,
+  search_mode_opt,
+  mode_interval_opt,
+  stable_restart_unit_opt,
+  rephase_interval_opt,
+  walk_flips_opt,
   data_flag,
 };
 
@@ -495,6 +510,11 @@ static option_desc_t options[NUM_OPTIONS] = {
   { "res-clause-limit", '\0', MANDATORY_INT, res_clause_limit_opt },
   { "simplify-interval", '\0', MANDATORY_INT,  simplify_interval_opt },
   { "simplify-bin-delta", '\0', MANDATORY_INT, simplify_bin_delta_opt },
+  { "search-mode", '\0', MANDATORY_STRING, search_mode_opt },
+  { "mode-interval", '\0', MANDATORY_INT, mode_interval_opt },
+  { "stable-restart-unit", '\0', MANDATORY_INT, stable_restart_unit_opt },
+  { "rephase-interval", '\0', MANDATORY_INT, rephase_interval_opt },
+  { "walk-flips", '\0', MANDATORY_INT, walk_flips_opt },
 
   { "data", '\0', FLAG_OPTION, data_flag },
 };
@@ -527,6 +547,11 @@ static void print_help(char *progname) {
 	 "   --seed=<int>, -s <int>  Set the prng seed\n"
 	 "   --stats                 Print statistics at the end of the search\n"
 	 "   --data                  Store conflict data in 'xxxx.data'\n"
+	 "   --search-mode=<mode>    Search mode: 'focused', 'stable', or 'alternate'\n"
+	 "   --mode-interval=<int>   Conflicts before the first mode switch in alternate mode\n"
+	 "   --stable-restart-unit=<int>  Unit of the Luby restart sequence in stable mode\n"
+	 "   --rephase-interval=<int>     Conflicts between two rephases\n"
+	 "   --walk-flips=<int>      Enable local search with at most <int> flips per walk\n"
          "\n"
          "For bug reporting and other information, please see http://yices.csl.sri.com/\n");
   fflush(stdout);
@@ -573,6 +598,11 @@ static void parse_command_line(int argc, char *argv[]) {
   res_clause_limit_given = false;
   simplify_interval_given = false;
   simplify_bin_delta_given = false;
+  search_mode_given = false;
+  mode_interval_given = false;
+  stable_restart_unit_given = false;
+  rephase_interval_given = false;
+  walk_flips_given = false;
 
   init_cmdline_parser(&parser, options, NUM_OPTIONS, argv, argc);
 
@@ -753,6 +783,56 @@ static void parse_command_line(int argc, char *argv[]) {
 	simplify_bin_delta = elem.i_value;
 	break;
 
+      case search_mode_opt:
+	if (strcmp(elem.s_value, "focused") == 0) {
+	  search_mode = NSAT_FOCUSED_MODE;
+	} else if (strcmp(elem.s_value, "stable") == 0) {
+	  search_mode = NSAT_STABLE_MODE;
+	} else if (strcmp(elem.s_value, "alternate") == 0) {
+	  search_mode = NSAT_ALTERNATE_MODE;
+	} else {
+	  fprintf(stderr, "search-mode must be 'focused', 'stable', or 'alternate'.\n");
+	  goto bad_usage;
+	}
+	search_mode_given = true;
+	break;
+
+      case mode_interval_opt:
+	if (elem.i_value <= 0) {
+	  fprintf(stderr, "mode-interval must be positive.\n");
+	  goto bad_usage;
+	}
+	mode_interval_given = true;
+	mode_interval = elem.i_value;
+	break;
+
+      case stable_restart_unit_opt:
+	if (elem.i_value <= 0) {
+	  fprintf(stderr, "stable-restart-unit must be positive.\n");
+	  goto bad_usage;
+	}
+	stable_restart_unit_given = true;
+	stable_restart_unit = elem.i_value;
+	break;
+
+      case rephase_interval_opt:
+	if (elem.i_value <= 0) {
+	  fprintf(stderr, "rephase-interval must be positive.\n");
+	  goto bad_usage;
+	}
+	rephase_interval_given = true;
+	rephase_interval = elem.i_value;
+	break;
+
+      case walk_flips_opt:
+	if (elem.i_value < 0) {
+	  fprintf(stderr, "walk-flips must be non-negative.\n");
+	  goto bad_usage;
+	}
+	walk_flips_given = true;
+	walk_flips = elem.i_value;
+	break;
+
       case data_flag:
 	data = true;
 	break;
@@ -935,6 +1015,11 @@ static void show_stats(sat_solver_t *solver) {
   write_line_and_uint(2, "c  reduce db               : ", stat->reduce_calls);
   write_line_and_uint(2, "c  scc calls               : ", stat->scc_calls);
   write_line_and_uint(2, "c  apply subst calls       : ", stat->subst_calls);
+  write_line_and_uint(2, "c  mode switches           : ", stat->mode_switches);
+  write_line_and_uint(2, "c  rephases                : ", stat->rephases);
+  write_line_and_uint(2, "c  walks                   : ", stat->walks);
+  write_line_and_uint(2, "c  walk models             : ", stat->walk_models);
+  write_line_and_uint(2, "c  walk flips              : ", stat->walk_flips);
   write_line_and_uint(2, "c  substituted vars        : ", stat->subst_vars);
   write_line_and_uint(2, "c  decisions               : ", stat->decisions);
   write_line_and_uint(2, "c  random decisions        : ", stat->random_decisions);
@@ -1138,6 +1223,21 @@ int main(int argc, char* argv[]) {
     if (simplify_bin_delta_given) {
       nsat_set_simplify_bin_delta(&solver, simplify_bin_delta);
     }
+    if (search_mode_given) {
+      nsat_set_search_mode(&solver, search_mode);
+    }
+    if (mode_interval_given) {
+      nsat_set_mode_interval(&solver, mode_interval);
+    }
+    if (stable_restart_unit_given) {
+      nsat_set_stable_restart_unit(&solver, stable_restart_unit);
+    }
+    if (rephase_interval_given) {
+      nsat_set_rephase_interval(&solver, rephase_interval);
+    }
+    if (walk_flips_given) {
+      nsat_set_walk_flips(&solver, walk_flips);
+    }
     verb = verbose ? 2 : stats ? 1 : 0;
     nsat_set_verbosity(&solver, verb);
 
@@ -1157,7 +1157,14 @@ static void show_simplex_stats(simplex_stats_t *stat) {
     printf("Integer arithmetic\n");
     printf(" make integer feasible   : %"PRIu32"\n", stat->num_make_intfeasible);
     printf(" branch atoms            : %"PRIu32"\n", stat->num_branch_atoms);
+    printf(" branch nodes            : %"PRIu32"\n", stat->num_branch_nodes);
+    printf(" pseudo-cost branches    : %"PRIu32"\n", stat->num_pcost_branches);
+    printf(" cube tests              : %"PRIu32"\n", stat->num_cube_tests);
+    printf(" cube successes          : %"PRIu32"\n", stat->num_cube_successes);
     printf("bound strengthening\n");
+    printf(" presolve bounds         : %"PRIu32"\n", stat->num_presolve_bounds);
+    printf(" presolve conflicts      : %"PRIu32"\n", stat->num_presolve_conflicts);
+    printf(" rounds                  : %"PRIu32"\n", stat->num_strengthen_rounds);
     printf(" conflicts               : %"PRIu32"\n", stat->num_bound_conflicts);
     printf(" recheck conflicts       : %"PRIu32"\n", stat->num_bound_recheck_conflicts);
     printf("integrality tests\n");
@@ -1978,6 +1985,7 @@ static int process_benchmark(char *filename) {
   }
   if (bvarith_elim) {
     enable_bvarith_elimination(&context);
+    enable_bv_known_bits(&context);
   }
   if (keep_ite) {
     enable_keep_ite(&context);
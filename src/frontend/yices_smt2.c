@@ -28,6 +28,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <stdbool.h>
 #include <signal.h>
 #include <errno.h>
@@ -36,11 +37,18 @@
 // EXPERIMENT
 #include <locale.h>
 
+#ifndef MINGW
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#endif
+
 #include "frontend/smt2/smt2_commands.h"
 #include "frontend/smt2/smt2_lexer.h"
 #include "frontend/smt2/smt2_parser.h"
 #include "frontend/smt2/smt2_term_stack.h"
 #include "utils/command_line.h"
+#include "utils/memalloc.h"
 
 #include "yices.h"
 #include "yices_exit_codes.h"
@@ -59,6 +67,12 @@
  * - timeout: command-line option
  *
  * - filename = name of the input file (NULL means read stdin)
+ *
+ * - server: if this flag is true, we read framed requests on stdin
+ *   (or from the input file if filename is non-NULL)
+ * - socket_path: if non-NULL, we listen for connections on this
+ *   Unix-domain socket.
+ *   In both cases, each request is processed in a separate session.
  */
 static lexer_t lexer;
 static parser_t parser;
@@ -71,6 +85,9 @@ static int32_t verbosity;
 static uint32_t timeout;
 static char *filename;
 
+static bool server;
+static char *socket_path;
+
 // mcsat options
 static bool mcsat;
 static bool mcsat_nra_mgcd;
@@ -78,6 +95,9 @@ static bool mcsat_nra_nlsat;
 
 static pvector_t trace_tags;
 
+// file for the event trace (NULL means no trace)
+static char *event_trace_file;
+
 
 /****************************
  *  COMMAND-LINE ARGUMENTS  *
@@ -95,9 +115,12 @@ typedef enum optid {
   mcsat_nra_mgcd_opt,     // use the mgcd instead psc in projection
   mcsat_nra_nlsat_opt,    // use the nlsat projection instead of brown single-cell
   trace_opt,              // enable a trace tag
+  server_opt,             // process framed requests from stdin
+  socket_opt,             // process requests from a Unix-domain socket
+  event_trace_opt,        // dump the event trace on timeout
 } optid_t;
 
-#define NUM_OPTIONS (trace_opt+1)
+#define NUM_OPTIONS (event_trace_opt+1)
 
 /*
  * Option descriptors
@@ -114,6 +137,9 @@ static option_desc_t options[NUM_OPTIONS] = {
   { "mcsat-nra-mgcd", '\0', FLAG_OPTION, mcsat_nra_mgcd_opt },
   { "mcsat-nra-nlsat", '\0', FLAG_OPTION, mcsat_nra_nlsat_opt },
   { "trace", 't', MANDATORY_STRING, trace_opt },
+  { "server", '\0', FLAG_OPTION, server_opt },
+  { "socket", '\0', MANDATORY_STRING, socket_opt },
+  { "event-trace", '\0', MANDATORY_STRING, event_trace_opt },
 };
 
 
@@ -143,8 +169,14 @@ static void print_help(const char *progname) {
 	 "    --timeout=<timeout>     Set a timeout in seconds (default = no timeout)\n"
 	 "           -t <timeout>\n"
 	 "    --stats, -s             Print statistics once all commands have been processed\n"
+	 "    --event-trace=<file>    Write the solver's event trace to <file> when check-sat times out\n"
 	 "    --incremental           Enable support for push/pop\n"
 	 "    --interactive           Run in interactive mode (ignored if a filename is given)\n"
+	 "    --server                Process a sequence of framed requests read from stdin\n"
+	 "                            (or from filename if given)\n"
+#ifndef MINGW
+	 "    --socket=<path>         Process requests sent to a Unix-domain socket\n"
+#endif
 #if HAVE_MCSAT
          "    --mcsat                 Use the MCSat solver\n"
          "    --mcsat-nra-mgcd        Use model-based GCD instead of PSC for projection\n"
@@ -185,6 +217,10 @@ static void parse_command_line(int argc, char *argv[]) {
   mcsat_nra_mgcd = false;
   mcsat_nra_nlsat = false;
 
+  server = false;
+  socket_path = NULL;
+  event_trace_file = NULL;
+
   init_pvector(&trace_tags, 5);
 
   init_cmdline_parser(&parser, options, NUM_OPTIONS, argv, argc);
@@ -286,6 +322,24 @@ static void parse_command_line(int argc, char *argv[]) {
       case trace_opt:
         pvector_push(&trace_tags, elem.s_value);
         break;
+
+      case server_opt:
+	server = true;
+	break;
+
+      case socket_opt:
+#ifndef MINGW
+	socket_path = elem.s_value;
+#else
+	fprintf(stderr, "%s: Unix-domain sockets are not supported on this platform\n", parser.command_name);
+	code = YICES_EXIT_USAGE;
+	goto exit;
+#endif
+	break;
+
+      case event_trace_opt:
+	event_trace_file = elem.s_value;
+	break;
       }
       break;
 
@@ -305,6 +359,22 @@ static void parse_command_line(int argc, char *argv[]) {
     goto exit;
   }
 
+  // server mode: the scripts come from the requests
+  if (server || socket_path != NULL) {
+    if (socket_path != NULL && filename != NULL) {
+      fprintf(stderr, "%s: no input file allowed with --socket\n", parser.command_name);
+      print_usage(parser.command_name);
+      code = YICES_EXIT_USAGE;
+      goto exit;
+    }
+    if (server && socket_path != NULL) {
+      fprintf(stderr, "%s: options --server and --socket are incompatible\n", parser.command_name);
+      code = YICES_EXIT_USAGE;
+      goto exit;
+    }
+    interactive = false;
+  }
+
   // force interactive to false if there's a filename
   if (filename != NULL) {
     interactive = false;
@@ -336,6 +406,25 @@ static void setup_mcsat(void) {
   }
 }
 
+/*
+ * Apply the command-line options: must be called after init_smt2
+ */
+static void setup_smt2(void) {
+  uint32_t i;
+
+  if (verbosity > 0) {
+    smt2_set_verbosity(verbosity);
+  }
+  for (i=0; i<trace_tags.size; i++) {
+    smt2_enable_trace_tag(trace_tags.data[i]);
+  }
+  if (event_trace_file != NULL) {
+    smt2_set_event_trace_file(event_trace_file);
+  }
+
+  setup_mcsat();
+}
+
 
 /********************
  *  SIGNAL HANDLER  *
@@ -381,7 +470,13 @@ static void write_signum(int signum) {
 }
 
 /*
- * We call exit on SIGINT/ABORT and XCPU
+ * Path of the socket created in server mode (NULL if none)
+ * - it's removed by the signal handler
+ */
+static const char *bound_socket = NULL;
+
+/*
+ * We call exit on SIGINT/ABORT and XCPU (and SIGTERM in socket mode)
  * - we could try to handle SIGINT more gracefully in interactive mode
  * - this will do for now.
  */
@@ -389,6 +484,9 @@ static void default_handler(int signum) {
   if (verbosity > 0) {
     write_signum(signum);
   }
+  if (bound_socket != NULL) {
+    unlink(bound_socket);
+  }
   _exit(YICES_EXIT_INTERRUPTED);
 }
 
@@ -413,11 +511,308 @@ static void reset_handlers(void) {
   signal(SIGABRT, SIG_DFL);
 #ifndef MINGW
   signal(SIGXCPU, SIG_DFL);
+  signal(SIGTERM, SIG_DFL);
 #endif
 }
 
 
 
+/*****************
+ *  SERVER MODE  *
+ ****************/
+
+/*
+ * In server mode, the global tables are initialized once by yices_init
+ * and each request is processed in its own session. A session is
+ * a fresh smt2 state (options, logic, context). When the session
+ * ends, all its declarations are removed and the garbage collector
+ * deletes the terms and types it created (cf. delete_smt2_session).
+ *
+ * Two transports are supported:
+ * - with --server, requests are read from stdin or from the input
+ *   file if one is given on the command line. Each request is
+ *   a decimal length n on a line by itself followed by n bytes of
+ *   SMT-LIB 2 commands. For each request, we write a response in
+ *   the same format: a length m on a line followed by m bytes of
+ *   output (regular and diagnostic output are both included).
+ *   The server stops on end-of-file.
+ * - with --socket=<path>, we listen for connections on a Unix-domain
+ *   socket. Each connection is a session: the commands are read from
+ *   the socket as they arrive and the output is written back to the
+ *   socket. The session ends on (exit) or when the client closes its
+ *   side of the connection. A stale socket file left by a previous
+ *   server is removed before binding, and the socket file is removed
+ *   when the server is killed by SIGINT or SIGTERM.
+ */
+
+/*
+ * Redirect stdout and stderr to file descriptor fd
+ * - the original descriptors are saved in saved[0] and saved[1]
+ */
+static void redirect_output(int fd, int saved[2]) {
+  fflush(stdout);
+  fflush(stderr);
+  saved[0] = dup(1);
+  saved[1] = dup(2);
+  if (saved[0] < 0 || saved[1] < 0 || dup2(fd, 1) < 0 || dup2(fd, 2) < 0) {
+    perror("yices_smt2");
+    exit(YICES_EXIT_SYSTEM_ERROR);
+  }
+}
+
+static void restore_output(int saved[2]) {
+  fflush(stdout);
+  fflush(stderr);
+  if (dup2(saved[0], 1) < 0 || dup2(saved[1], 2) < 0) {
+    _exit(YICES_EXIT_SYSTEM_ERROR);
+  }
+  close(saved[0]);
+  close(saved[1]);
+}
+
+
+/*
+ * Process all commands from the lexer in a new session
+ */
+static void run_session(void) {
+  init_smt2_session(!incremental, timeout);
+  init_smt2_tstack(&stack);
+  init_parser(&parser, &lexer, &stack);
+  setup_smt2();
+
+  while (smt2_active()) {
+    if (parse_smt2_command(&parser) < 0) {
+      // syntax error: end the session
+      break;
+    }
+  }
+
+  if (show_stats) {
+    smt2_show_stats();
+  }
+
+  delete_parser(&parser);
+  delete_tstack(&stack);
+  delete_smt2_session();
+}
+
+
+/*
+ * Read a request header from in
+ * - return the length or -1 on end-of-file or if the header is malformed
+ * - *eof is set to true if there's no more request
+ */
+static int64_t read_header(FILE *in, bool *eof) {
+  int64_t n;
+  int c;
+
+  c = getc(in);
+  *eof = (c == EOF);
+  if (c < '0' || c > '9') {
+    return -1;
+  }
+
+  n = 0;
+  do {
+    n = 10 * n + (c - '0');
+    if (n > UINT32_MAX) return -1;
+    c = getc(in);
+  } while ('0' <= c && c <= '9');
+
+  if (c == '\r') {
+    c = getc(in);
+  }
+
+  return (c == '\n') ? n : -1;
+}
+
+/*
+ * Copy the content of tmp to stdout, preceded by its length
+ */
+static void write_response(FILE *tmp) {
+  char buffer[4096];
+  long n;
+  size_t r;
+
+  fseek(tmp, 0, SEEK_END);
+  n = ftell(tmp);
+  rewind(tmp);
+  printf("%ld\n", n);
+  do {
+    r = fread(buffer, 1, sizeof(buffer), tmp);
+    fwrite(buffer, 1, r, stdout);
+  } while (r == sizeof(buffer));
+  fflush(stdout);
+}
+
+/*
+ * Framed requests read from in
+ */
+static int32_t serve_requests(FILE *in) {
+  char *data;
+  FILE *tmp;
+  int64_t n;
+  int saved[2];
+  bool eof;
+
+  for (;;) {
+    n = read_header(in, &eof);
+    if (n < 0) {
+      if (eof) break;
+      fprintf(stderr, "yices_smt2: invalid request header\n");
+      return YICES_EXIT_ERROR;
+    }
+
+    data = (char *) safe_malloc(n + 1);
+    if (fread(data, 1, n, in) != (size_t) n) {
+      fprintf(stderr, "yices_smt2: truncated request\n");
+      safe_free(data);
+      return YICES_EXIT_ERROR;
+    }
+    data[n] = '\0';
+
+    tmp = tmpfile();
+    if (tmp == NULL) {
+      perror("yices_smt2");
+      safe_free(data);
+      return YICES_EXIT_SYSTEM_ERROR;
+    }
+
+    redirect_output(fileno(tmp), saved);
+    init_smt2_string_lexer(&lexer, data, "request");
+    run_session();
+    close_lexer(&lexer);
+    restore_output(saved);
+
+    write_response(tmp);
+    fclose(tmp);
+    safe_free(data);
+  }
+
+  return YICES_EXIT_SUCCESS;
+}
+
+/*
+ * Framed requests from the input file or from stdin
+ */
+static int32_t serve_input(void) {
+  FILE *in;
+  int32_t code;
+
+  if (filename == NULL) {
+    return serve_requests(stdin);
+  }
+
+  in = fopen(filename, "r");
+  if (in == NULL) {
+    perror(filename);
+    return YICES_EXIT_FILE_NOT_FOUND;
+  }
+  code = serve_requests(in);
+  fclose(in);
+
+  return code;
+}
+
+
+#ifndef MINGW
+
+/*
+ * Remove the socket file left at addr by a server that's no longer running
+ * - the file is removed only if it's a socket and no server accepts
+ *   connections on it
+ */
+static void remove_stale_socket(struct sockaddr_un *addr) {
+  struct stat sb;
+  int fd;
+
+  if (lstat(addr->sun_path, &sb) == 0 && S_ISSOCK(sb.st_mode)) {
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd >= 0) {
+      if (connect(fd, (struct sockaddr *) addr, sizeof(*addr)) < 0 && errno == ECONNREFUSED) {
+        unlink(addr->sun_path);
+      }
+      close(fd);
+    }
+  }
+}
+
+/*
+ * Connections on a Unix-domain socket
+ */
+static int32_t serve_socket(const char *path) {
+  struct sockaddr_un addr;
+  FILE *f;
+  int fd, c;
+  int saved[2];
+
+  if (strlen(path) >= sizeof(addr.sun_path)) {
+    fprintf(stderr, "yices_smt2: socket path is too long: %s\n", path);
+    return YICES_EXIT_USAGE;
+  }
+
+  fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0) {
+    perror("yices_smt2: socket");
+    return YICES_EXIT_SYSTEM_ERROR;
+  }
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strcpy(addr.sun_path, path);
+  remove_stale_socket(&addr);
+  if (bind(fd, (struct sockaddr *) &addr, sizeof(addr)) < 0) {
+    perror(path);
+    close(fd);
+    return YICES_EXIT_SYSTEM_ERROR;
+  }
+
+  // remove the socket file if we're killed
+  bound_socket = path;
+  signal(SIGTERM, default_handler);
+
+  if (listen(fd, 8) < 0) {
+    perror(path);
+    close(fd);
+    unlink(path);
+    bound_socket = NULL;
+    return YICES_EXIT_SYSTEM_ERROR;
+  }
+
+  // a client that disconnects early must not kill the server
+  signal(SIGPIPE, SIG_IGN);
+
+  for (;;) {
+    c = accept(fd, NULL, NULL);
+    if (c < 0) {
+      if (errno == EINTR) continue;
+      perror("yices_smt2: accept");
+      break;
+    }
+
+    f = fdopen(c, "r");
+    if (f == NULL) {
+      close(c);
+      continue;
+    }
+
+    redirect_output(c, saved);
+    init_smt2_stream_lexer(&lexer, f, path);
+    run_session();
+    restore_output(saved);
+    close_lexer(&lexer); // this closes c
+  }
+
+  close(fd);
+  unlink(path);
+  bound_socket = NULL;
+
+  return YICES_EXIT_SYSTEM_ERROR;
+}
+
+#endif
+
+
 /**********
  *  MAIN  *
  *********/
@@ -463,11 +858,32 @@ static void force_utf8(void) {
 
 int main(int argc, char *argv[]) {
   int32_t code;
-  uint32_t i;
 
   parse_command_line(argc, argv);
   force_utf8();
 
+  if (server || socket_path != NULL) {
+    init_handlers();
+    yices_init();
+    init_parameter_name_table();
+
+#ifndef MINGW
+    if (socket_path != NULL) {
+      code = serve_socket(socket_path);
+    } else {
+      code = serve_input();
+    }
+#else
+    code = serve_input();
+#endif
+
+    delete_pvector(&trace_tags);
+    yices_exit();
+    reset_handlers();
+
+    return code;
+  }
+
   if (filename != NULL) {
     // read from file
     if (init_smt2_file_lexer(&lexer, filename) < 0) {
@@ -487,17 +903,7 @@ int main(int argc, char *argv[]) {
   init_parser(&parser, &lexer, &stack);
 
   init_parameter_name_table();
-  
-  if (verbosity > 0) {
-    smt2_set_verbosity(verbosity);
-  }
-  if (trace_tags.size > 0) {
-    for (i = 0; i < trace_tags.size; ++ i) {
-      smt2_enable_trace_tag(trace_tags.data[i]);
-    }
-  }
-
-  setup_mcsat();
+  setup_smt2();
 
   while (smt2_active()) {
     if (interactive) {
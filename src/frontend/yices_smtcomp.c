@@ -642,7 +642,14 @@ static void show_simplex_stats(simplex_stats_t *stat) {
     fprintf(stderr, "Integer arithmetic\n");
     fprintf(stderr, " make integer feasible   : %"PRIu32"\n", stat->num_make_intfeasible);
     fprintf(stderr, " branch atoms            : %"PRIu32"\n", stat->num_branch_atoms);
+    fprintf(stderr, " branch nodes            : %"PRIu32"\n", stat->num_branch_nodes);
+    fprintf(stderr, " pseudo-cost branches    : %"PRIu32"\n", stat->num_pcost_branches);
+    fprintf(stderr, " cube tests              : %"PRIu32"\n", stat->num_cube_tests);
+    fprintf(stderr, " cube successes          : %"PRIu32"\n", stat->num_cube_successes);
     fprintf(stderr, "bound strengthening\n");
+    fprintf(stderr, " presolve bounds         : %"PRIu32"\n", stat->num_presolve_bounds);
+    fprintf(stderr, " presolve conflicts      : %"PRIu32"\n", stat->num_presolve_conflicts);
+    fprintf(stderr, " rounds                  : %"PRIu32"\n", stat->num_strengthen_rounds);
     fprintf(stderr, " conflicts               : %"PRIu32"\n", stat->num_bound_conflicts);
     fprintf(stderr, " recheck conflicts       : %"PRIu32"\n", stat->num_bound_recheck_conflicts);
     fprintf(stderr, "integrality tests\n");
@@ -1132,6 +1139,7 @@ static int process_benchmark(void) {
     //    enable_diseq_and_or_flattening(&context);  flatten makes things worse
     enable_variable_elimination(&context);
     enable_bvarith_elimination(&context);
+    enable_bv_known_bits(&context);
     params.fast_restart = true;
     params.c_factor = 1.1;
     params.d_factor = 1.1;
@@ -1179,6 +1187,7 @@ static int process_benchmark(void) {
     enable_diseq_and_or_flattening(&context);
     enable_variable_elimination(&context);
     enable_bvarith_elimination(&context);
+    enable_bv_known_bits(&context);
     params.fast_restart = true;
     params.c_factor = 1.1;
     params.d_factor = 1.1;
@@ -1940,6 +1940,53 @@ __YICES_DLLSPEC__ extern term_t yices_bvslt_atom(term_t t1, term_t t2);  // t1 <
 
 
 
+/*
+ * BULK TERM CONSTRUCTION
+ */
+
+/*
+ * Build many terms in a single call. The terms are described by an
+ * array of 32bit integers, which is a sequence of nodes:
+ * - each node is of the form op, k, x_1, ..., x_k where op is a
+ *   term_opcode_t (cf. yices_types.h) and x_1 ... x_k are the k operands
+ * - an operand x denotes the term x if x >= 0, and the term built for
+ *   the node of index (-x - 1) if x < 0 (nodes are indexed from 0 in
+ *   the order they appear in the buffer)
+ * - the only exceptions are the immediate operands of YICES_OP_INT_CONST,
+ *   YICES_OP_BV_CONST, and YICES_OP_BV_EXTRACT, which are used as is.
+ *
+ * For example, (and (> x 0) (< x 10)) is described by
+ *   YICES_OP_INT_CONST, 1, 0,
+ *   YICES_OP_ARITH_GT, 2, x, -1,
+ *   YICES_OP_INT_CONST, 1, 10,
+ *   YICES_OP_ARITH_LT, 2, x, -3,
+ *   YICES_OP_AND, 2, -2, -4
+ *
+ * Each node is built as by the corresponding term constructor (e.g.,
+ * yices_and for YICES_OP_AND, yices_sum for YICES_OP_ADD, yices_bvextract
+ * for YICES_OP_BV_EXTRACT).
+ *
+ * - size = number of integers in buffer
+ * - the term built for node i is stored in t[i]
+ * - n = size of array t
+ *
+ * The function returns the number of nodes built, or -1 if there's an error.
+ *
+ * Error report:
+ * if a node is truncated, or there are more than n nodes, or op is not
+ * a valid operator:
+ *    code = INVALID_TERM_OP
+ * if k is not a valid number of operands for op
+ *    code = WRONG_NUMBER_OF_ARGUMENTS
+ * if x < 0 does not refer to a node that was built before
+ *    code = INVALID_TERM
+ *    term1 = x
+ * + any error reported by the term constructors
+ */
+__YICES_DLLSPEC__ extern int32_t yices_build_terms(uint32_t size, const int32_t buffer[], uint32_t n, term_t t[]);
+
+
+
 
 /**************
  *  PARSING   *
@@ -2900,6 +2947,32 @@ __YICES_DLLSPEC__ extern context_t *yices_new_context(const ctx_config_t *config
 __YICES_DLLSPEC__ extern void yices_free_context(context_t *ctx);
 
 
+/*
+ * Clone a context
+ * - this creates a new context with the same configuration, the same
+ *   options, the same push levels, and the same assertions as ctx.
+ * - the clone and ctx are independent: assertions, checks, push and pop
+ *   on one of them do not affect the other.
+ * - if ctx's status is STATUS_UNSAT, the clone's status is also STATUS_UNSAT,
+ *   otherwise, the clone's status is STATUS_IDLE.
+ * - the clone is built by asserting ctx's formulas again, so learned
+ *   clauses and models of ctx are not copied.
+ * - this requires the option "assertion-log" to be enabled in ctx before
+ *   formulas are asserted (cf. yices_context_enable_option).
+ *
+ * Return NULL if there's an error.
+ *
+ * Error report:
+ * if ctx's status is STATUS_SEARCHING or STATUS_INTERRUPTED
+ *    code = CTX_INVALID_OPERATION
+ * if ctx contains constraints that are not in its assertion log
+ * (formulas asserted while "assertion-log" was disabled, or blocking
+ * clauses added by yices_assert_blocking_clause and not removed by pop)
+ *    code = CTX_INVALID_OPERATION
+ */
+__YICES_DLLSPEC__ extern context_t *yices_clone_context(context_t *ctx);
+
+
 /*
  * Get status: return the context's status flag
  * - return one of the codes defined in yices_types.h,
@@ -2966,6 +3039,10 @@ __YICES_DLLSPEC__ extern int32_t yices_pop(context_t *ctx);
  *
  *   bvarith-elim: more variable elimination for bitvector arithmetic
  *
+ *   bv-known-bits: compute known bits and unsigned intervals for bitvector
+ *   variables and replace the known bits by constants (this has an effect
+ *   only if var-elim is also enabled)
+ *
  *   eager-arith-lemmas: if enabled and the simplex solver is used, the simplex
  *   solver will eagerly generate lemmas such as (x >= 1) => (x >= 0) (i.e.,
  *   the lemmas that involve two inequalities on the same variable x).
@@ -2987,6 +3064,16 @@ __YICES_DLLSPEC__ extern int32_t yices_pop(context_t *ctx);
  *   (ite c 10 (ite d 3 20)), then the context with include the assertion
  *   3 <= t <= 20.
  *
+ *   query-cache: keep the results of previous calls to yices_check_context
+ *   and reuse them when the same set of assertions is checked again (or
+ *   when the answer follows from a previous UNSAT or SAT result).
+ *   This option is disabled by default. The cache is not used while the
+ *   context contains formulas asserted before the cache was enabled.
+ *
+ *   assertion-log: keep a copy of the formulas asserted in the context.
+ *   This is required by yices_clone_context and should be enabled before
+ *   any formula is asserted. This option is disabled by default.
+ *
  * The parameter must be given as a string. For example, to disable var-elim,
  * call  yices_context_disable_option(ctx, "var-elim")
  *
@@ -3117,6 +3204,141 @@ __YICES_DLLSPEC__ extern int32_t yices_assert_blocking_clause(context_t *ctx);
 __YICES_DLLSPEC__ extern void yices_stop_search(context_t *ctx);
 
 
+/*
+ * Optimize objectives obj[0 ... n-1] in lexicographic order
+ * - each obj[i] must be an arithmetic or bitvector term
+ * - maximize[i] != 0 means maximize obj[i], maximize[i] == 0 means minimize it
+ *   (bitvector objectives are interpreted as unsigned integers)
+ * - params is an optional structure of search parameters (as in yices_check_context)
+ * - result must be an array of size n: result[i] stores the status of obj[i]
+ * - if model is non-NULL and the assertions are satisfiable, *model stores
+ *   an optimal solution. This model must be deleted with yices_free_model.
+ *
+ * The context must support push and pop. The objectives are optimized one
+ * after the other: once the optimum of obj[i] is found, it's kept fixed
+ * while optimizing obj[i+1]. If obj[i] is unbounded or its optimum is not
+ * attained, the objectives obj[i+1 ... n-1] are not optimized (their status
+ * is OBJECTIVE_UNKNOWN).
+ *
+ * The function returns STATUS_SAT if the optimization succeeded,
+ * STATUS_UNSAT if the assertions are unsat, or STATUS_UNKNOWN or
+ * STATUS_INTERRUPTED if the optimization could not be completed.
+ * The context is then left in the same state as before the call (with
+ * status IDLE): the objectives are internalized in a temporary push level
+ * and all their definitions and the bounds used for optimization are
+ * removed on exit. The only exception is an interrupted search in a
+ * context that doesn't support clean interrupts.
+ *
+ * Error report: STATUS_ERROR is returned in the following cases
+ * - if ctx does not support push/pop or uses MCSAT:
+ *   code = CTX_OPERATION_NOT_SUPPORTED
+ * - if ctx's status is not IDLE, SAT, UNSAT, or UNKNOWN:
+ *   code = CTX_INVALID_OPERATION
+ * - if obj[i] is not valid:
+ *   code = INVALID_TERM
+ *   term1 = obj[i]
+ * - if obj[i] is not an arithmetic or bitvector term
+ *   code = ARITHTERM_REQUIRED
+ *   term1 = obj[i]
+ * - other error codes are possible if obj[i] can't be internalized
+ *   (as in yices_assert_formula)
+ */
+__YICES_DLLSPEC__ extern smt_status_t yices_optimize_context(context_t *ctx, const param_t *params,
+                                                             uint32_t n, const term_t obj[], const int32_t maximize[],
+                                                             objective_status_t result[], model_t **model);
+
+
+/*
+ * Enumerate the models of ctx projected on terms t[0 ... n-1]
+ * - each t[i] must be a Boolean, arithmetic, or bitvector term
+ * - params is an optional structure of search parameters (as in yices_check_context)
+ * - max_models = bound on the number of models to enumerate (0 means no bound)
+ * - v must be an initialized term vector: it's reset, then the values of
+ *   t[0 ... n-1] in each model are added to v, as constant terms. After the
+ *   call, v contains k * n terms where k is the number of models found.
+ *
+ * Two models are distinct if they give different values to at least one
+ * t[i]. After each model, a clause that blocks its values is added directly
+ * to ctx (no new assertion is needed) and the search continues from the
+ * same context, keeping all learned clauses. The blocking clauses are kept
+ * in ctx after the call. To remove them, call yices_push before
+ * yices_enumerate_models, and yices_pop after.
+ *
+ * The function returns:
+ * - STATUS_UNSAT if all the models were enumerated. The context status is
+ *   then STATUS_UNSAT (because all the models are blocked).
+ * - STATUS_SAT if max_models were found before the end. The context status
+ *   is STATUS_IDLE and a later call to yices_enumerate_models continues
+ *   the enumeration.
+ * - STATUS_UNKNOWN or STATUS_INTERRUPTED if the enumeration could not be
+ *   completed. The models found so far are in v.
+ *
+ * Error report: STATUS_ERROR is returned in the following cases
+ * - if ctx does not support multiple checks or uses MCSAT:
+ *   code = CTX_OPERATION_NOT_SUPPORTED
+ * - if ctx's status is not IDLE, SAT, UNSAT, or UNKNOWN:
+ *   code = CTX_INVALID_OPERATION
+ * - if t[i] is not valid:
+ *   code = INVALID_TERM
+ *   term1 = t[i]
+ * - if t[i] is not a Boolean, arithmetic, or bitvector term:
+ *   code = TYPE_MISMATCH
+ *   term1 = t[i]
+ *   type1 = type of t[i]
+ * - other error codes are possible if t[i] can't be internalized
+ *   (as in yices_assert_formula)
+ */
+__YICES_DLLSPEC__ extern smt_status_t yices_enumerate_models(context_t *ctx, const param_t *params,
+                                                             uint32_t n, const term_t t[], uint32_t max_models,
+                                                             term_vector_t *v);
+
+
+/*
+ * Check ctx by cube and conquer
+ * - params is an optional structure of search parameters (as in yices_check_context)
+ * - depth = maximal number of literals in the initial cubes
+ * - nworkers = number of cubes solved in parallel
+ * - max_conflicts = conflict budget per cube (0 means no budget)
+ * - if model is non-NULL and the assertions are satisfiable, *model stores
+ *   a model. This model must be deleted with yices_free_model.
+ *
+ * The assertions are split into cubes (i.e., conjunctions of literals)
+ * by lookahead: the splitting literals are chosen by the number of
+ * literals they imply by propagation. Each cube is then checked in a
+ * new push level. A cube that's not solved within max_conflicts
+ * conflicts is split again and the new cubes are checked later. If
+ * depth is 0, the search starts with the assertions as a single cube.
+ *
+ * If nworkers > 1, up to nworkers cubes are checked at the same time,
+ * each in a separate process created by fork. The first satisfiable
+ * cube stops all the workers. In this mode, yices_stop_search does not
+ * interrupt the workers. On Windows, the cubes are always checked one
+ * after the other.
+ *
+ * WARNING: with nworkers > 1, this function calls fork() from inside
+ * the library. This is not safe if the calling program is multithreaded
+ * (the child process contains only the calling thread, and locks held
+ * by other threads stay locked). Use nworkers = 1 in that case. The
+ * workers report their results through a pipe, so the function works
+ * if the program ignores SIGCHLD or reaps its children in a handler.
+ *
+ * The context must support push and pop. The function returns STATUS_SAT,
+ * STATUS_UNSAT, or STATUS_UNKNOWN or STATUS_INTERRUPTED if a cube could
+ * not be solved. The context is then left in the same state as before the
+ * call (with status IDLE), except if the assertions are found unsat by
+ * propagation at the base level (then the context status is STATUS_UNSAT).
+ *
+ * Error report: STATUS_ERROR is returned in the following cases
+ * - if ctx does not support push/pop or uses MCSAT:
+ *   code = CTX_OPERATION_NOT_SUPPORTED
+ * - if ctx's status is not IDLE, SAT, UNSAT, or UNKNOWN:
+ *   code = CTX_INVALID_OPERATION
+ */
+__YICES_DLLSPEC__ extern smt_status_t yices_check_context_with_cubes(context_t *ctx, const param_t *params,
+                                                                     uint32_t depth, uint32_t nworkers,
+                                                                     uint64_t max_conflicts, model_t **model);
+
+
 
 
 /*
@@ -3179,6 +3401,97 @@ __YICES_DLLSPEC__ extern void yices_free_param_record(param_t *param);
 
 
 
+/*
+ * STATISTICS
+ */
+
+/*
+ * The statistics of a context are named counters of the form
+ * "<component>.<counter>". For example:
+ *
+ *   core.decisions        number of decisions
+ *   core.conflicts        number of conflicts
+ *   core.propagations     number of Boolean propagations
+ *   egraph.conflicts      number of conflicts found by the egraph
+ *   simplex.pivots        number of pivoting steps in the simplex solver
+ *   simplex.branch-nodes  number of branch & bound nodes (integer arithmetic)
+ *   bv.atoms              number of bitvector atoms
+ *
+ * Only the solvers used by the context report statistics.
+ *
+ * If the query cache is enabled, "cache.lookups" is the number of
+ * checks that searched the cache, "cache.hits" the number of exact
+ * hits, and "cache.subsumed" the number of hits by subsumption.
+ *
+ * If Yices is compiled with profiling timers (make ENABLE_STATS_TIMERS=yes),
+ * there are also counters "time.<phase>.cycles" and "time.<phase>.calls"
+ * for the phases internalize, bcp, theory-propagate, final-check,
+ * theory-backtrack, explain, and model, and for the integer feasibility
+ * checks in the simplex solver (simplex-intfeas). The node throughput
+ * of branch & bound is simplex.branch-nodes over time.simplex-intfeas.cycles.
+ * The cycles are read from the CPU's
+ * time-stamp counter on x86 (nanoseconds on other architectures).
+ *
+ * Memory estimates (in bytes) are given by "mem.core", "mem.egraph",
+ * "mem.simplex", "mem.bv", "mem.bitblaster", "mem.cache" (query cache),
+ * and "mem.context" (sum of the previous ones). "mem.terms" is the
+ * memory used by the global term table. If the search parameter
+ * "memory-limit" is set and the last call to yices_check_context
+ * returned STATUS_UNKNOWN because of this limit, then
+ * "mem.limit-reached" is 1. Otherwise, it's 0.
+ */
+
+/*
+ * Get the value of the statistic of the given name.
+ * - the value is stored in *val.
+ *
+ * Return -1 if there's an error, 0 otherwise.
+ *
+ * Error code:
+ * - CTX_UNKNOWN_PARAMETER if name is not the name of a statistic of ctx
+ */
+__YICES_DLLSPEC__ extern int32_t yices_get_statistic(context_t *ctx, const char *name, uint64_t *val);
+
+/*
+ * Return all the statistics of ctx as a JSON object:
+ *   {"core.boolean-variables": 10, "core.atoms": 4, ...}
+ *
+ * The returned string must be deleted by calling yices_free_string.
+ */
+__YICES_DLLSPEC__ extern char *yices_statistics_to_string(context_t *ctx);
+
+
+/*
+ * EVENT TRACE
+ *
+ * Each context keeps a trace of the most recent search events (in a
+ * fixed-size ring buffer): start and end of search, restarts, clause
+ * database reductions and simplifications, conflicts with the LBD and
+ * size of the learned clause, conflicts reported by each theory solver,
+ * final-check rounds, and garbage collection of Boolean variables.
+ *
+ * The following functions write this trace to a file in a compact
+ * binary format. The file can be decoded with the decode_events tool
+ * (source in utils/decode_events.c).
+ *
+ * Return 0 if the trace is written, -1 if there's an error.
+ *
+ * Error report:
+ * - if ctx does not have an event trace (e.g., it uses the MCSAT solver)
+ *     code = CTX_OPERATION_NOT_SUPPORTED
+ * - if writing to the file fails
+ *     code = OUTPUT_ERROR
+ *   in this case, errno, perror, strerror can be used for diagnosis.
+ */
+__YICES_DLLSPEC__ extern int32_t yices_dump_event_trace(context_t *ctx, FILE *f);
+
+/*
+ * Variant: write the trace to a file descriptor
+ */
+__YICES_DLLSPEC__ extern int32_t yices_dump_event_trace_fd(context_t *ctx, int fd);
+
+
+
 
 
 /**************
@@ -3721,6 +4034,39 @@ __YICES_DLLSPEC__ extern term_t yices_get_value_as_term(model_t *mdl, term_t t);
 __YICES_DLLSPEC__ extern int32_t yices_term_array_value(model_t *mdl, uint32_t n, const term_t a[], term_t b[]);
 
 
+/*
+ * Get the values of terms a[0 .. n-1] in mdl into a numeric array
+ * - a must be an array of n terms
+ * - val must be large enough to store n elements
+ *
+ * These functions are equivalent to calling the corresponding
+ * yices_get_..._value function on every a[i], but they share the
+ * evaluation of common subterms.
+ *
+ * yices_get_bool_value_array: all terms must be Boolean.
+ *   val[i] = 0 if a[i] is false in mdl, 1 if a[i] is true in mdl
+ *
+ * yices_get_int64_value_array: all terms must be arithmetic terms
+ *   and their values must be integers that fit in 64 bits.
+ *
+ * yices_get_double_value_array: all terms must be arithmetic terms.
+ *   val[i] = value of a[i] converted to a double
+ *
+ * yices_get_bv64_value_array: all terms must be bitvectors of at most
+ *   64 bits. val[i] = value of a[i] as an unsigned integer.
+ *
+ * The functions return 0 if there's no error or -1 otherwise.
+ * The error codes are the same as for the single-term functions.
+ * In addition, yices_get_bv64_value_array reports
+ *   code = EVAL_OVERFLOW
+ * if some a[i] has more than 64 bits.
+ */
+__YICES_DLLSPEC__ extern int32_t yices_get_bool_value_array(model_t *mdl, uint32_t n, const term_t a[], int32_t val[]);
+__YICES_DLLSPEC__ extern int32_t yices_get_int64_value_array(model_t *mdl, uint32_t n, const term_t a[], int64_t val[]);
+__YICES_DLLSPEC__ extern int32_t yices_get_double_value_array(model_t *mdl, uint32_t n, const term_t a[], double val[]);
+__YICES_DLLSPEC__ extern int32_t yices_get_bv64_value_array(model_t *mdl, uint32_t n, const term_t a[], uint64_t val[]);
+
+
 
 
 /*
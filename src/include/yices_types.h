@@ -85,6 +85,23 @@ typedef enum smt_status {
 } smt_status_t;
 
 
+/*
+ * Status of an objective after optimization
+ * - OBJECTIVE_OPTIMAL: the optimum is attained
+ * - OBJECTIVE_UNBOUNDED: the objective can be arbitrarily large
+ *   (for maximization) or small (for minimization)
+ * - OBJECTIVE_NOT_ATTAINED: the supremum (or infimum) is finite but
+ *   it's not attained (because of strict inequalities)
+ * - OBJECTIVE_UNKNOWN: the objective was not optimized
+ */
+typedef enum objective_status {
+  OBJECTIVE_OPTIMAL,
+  OBJECTIVE_UNBOUNDED,
+  OBJECTIVE_NOT_ATTAINED,
+  OBJECTIVE_UNKNOWN
+} objective_status_t;
+
+
 
 
 
@@ -190,6 +207,67 @@ typedef enum term_constructor {
 } term_constructor_t;
 
 
+/*
+ * Operators for bulk term construction (cf. yices_build_terms).
+ * The comments give the expected operands.
+ */
+typedef enum term_opcode {
+  // boolean operators
+  YICES_OP_NOT,              // (not t)
+  YICES_OP_AND,              // (and t_1 ... t_k)
+  YICES_OP_OR,               // (or t_1 ... t_k)
+  YICES_OP_XOR,              // (xor t_1 ... t_k)
+  YICES_OP_IMPLIES,          // (=> t_1 t_2)
+  YICES_OP_IFF,              // (<=> t_1 t_2)
+
+  // generic operators
+  YICES_OP_ITE,              // (ite c t_1 t_2)
+  YICES_OP_EQ,               // (= t_1 t_2)
+  YICES_OP_NEQ,              // (/= t_1 t_2)
+  YICES_OP_DISTINCT,         // (distinct t_1 ... t_k)
+  YICES_OP_APP,              // (f t_1 ... t_k): the function f is the first operand
+
+  // arithmetic
+  YICES_OP_INT_CONST,        // integer constant: one immediate operand (the value)
+  YICES_OP_ADD,              // (+ t_1 ... t_k)
+  YICES_OP_SUB,              // (- t_1 t_2)
+  YICES_OP_NEG,              // (- t)
+  YICES_OP_MUL,              // (* t_1 ... t_k)
+  YICES_OP_ARITH_GE,         // (>= t_1 t_2)
+  YICES_OP_ARITH_GT,         // (> t_1 t_2)
+  YICES_OP_ARITH_LE,         // (<= t_1 t_2)
+  YICES_OP_ARITH_LT,         // (< t_1 t_2)
+
+  // bitvectors
+  YICES_OP_BV_CONST,         // constant: three immediate operands (n, low 32 bits, high 32 bits)
+  YICES_OP_BV_ADD,           // (bvadd t_1 ... t_k)
+  YICES_OP_BV_SUB,           // (bvsub t_1 t_2)
+  YICES_OP_BV_NEG,           // (bvneg t)
+  YICES_OP_BV_MUL,           // (bvmul t_1 ... t_k)
+  YICES_OP_BV_NOT,           // (bvnot t)
+  YICES_OP_BV_AND,           // (bvand t_1 ... t_k)
+  YICES_OP_BV_OR,            // (bvor t_1 ... t_k)
+  YICES_OP_BV_XOR,           // (bvxor t_1 ... t_k)
+  YICES_OP_BV_SHL,           // (bvshl t_1 t_2)
+  YICES_OP_BV_LSHR,          // (bvlshr t_1 t_2)
+  YICES_OP_BV_ASHR,          // (bvashr t_1 t_2)
+  YICES_OP_BV_DIV,           // (bvudiv t_1 t_2)
+  YICES_OP_BV_REM,           // (bvurem t_1 t_2)
+  YICES_OP_BV_CONCAT,        // (bvconcat t_1 ... t_k)
+  YICES_OP_BV_EXTRACT,       // (bvextract t i j): i and j are immediate operands
+  YICES_OP_BV_GE,            // (bvge t_1 t_2)
+  YICES_OP_BV_GT,            // (bvgt t_1 t_2)
+  YICES_OP_BV_LE,            // (bvle t_1 t_2)
+  YICES_OP_BV_LT,            // (bvlt t_1 t_2)
+  YICES_OP_BV_SGE,           // (bvsge t_1 t_2)
+  YICES_OP_BV_SGT,           // (bvsgt t_1 t_2)
+  YICES_OP_BV_SLE,           // (bvsle t_1 t_2)
+  YICES_OP_BV_SLT            // (bvslt t_1 t_2)
+} term_opcode_t;
+
+#define YICES_NUM_OPCODES (YICES_OP_BV_SLT + 1)
+
+
 /**********************
  *  VALUES IN MODELS  *
  *********************/
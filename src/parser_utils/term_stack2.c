@@ -3558,9 +3558,128 @@ static void check_mk_add(tstack_t *stack, stack_elem_t *f, uint32_t n) {
   check_size(stack, n>=1);
 }
 
+/*
+ * Bulk construction of large linear sums:
+ * - linear_sum_elem_size(e) returns the number of monomials in e if e
+ *   is a rational, a linear arithmetic term, or a linear arithmetic buffer.
+ *   It returns -1 otherwise.
+ * - linear_sum_add_elem(e, a, k) stores the monomials of e in a[k ...]
+ *   and returns the index after the last monomial stored.
+ */
+static int32_t linear_sum_elem_size(stack_elem_t *e) {
+  rba_buffer_t *b;
+  pprod_t *r;
+  uint32_t i;
+
+  switch (e->tag) {
+  case TAG_RATIONAL:
+    return 1;
+
+  case TAG_TERM:
+    if (is_arithmetic_term(__yices_globals.terms, e->val.term) &&
+        arith_term_is_linear(__yices_globals.terms, e->val.term)) {
+      return 1;
+    }
+    break;
+
+  case TAG_ARITH_BUFFER:
+    // the nodes with a non-zero coefficient are the monomials of b
+    b = e->val.arith_buffer;
+    for (i=1; i<b->num_nodes; i++) {
+      r = b->mono[i].prod;
+      if (q_is_nonzero(&b->mono[i].coeff) && !pp_is_empty(r) && !pp_is_var(r)) {
+        return -1;
+      }
+    }
+    return b->nterms;
+
+  default:
+    break;
+  }
+
+  return -1;
+}
+
+static uint32_t linear_sum_add_elem(stack_elem_t *e, monomial_t *a, uint32_t k) {
+  rba_buffer_t *b;
+  pprod_t *r;
+  uint32_t i;
+
+  switch (e->tag) {
+  case TAG_RATIONAL:
+    a[k].var = const_idx;
+    q_set(&a[k].coeff, &e->val.rational);
+    k ++;
+    break;
+
+  case TAG_TERM:
+    a[k].var = e->val.term;
+    q_set_one(&a[k].coeff);
+    k ++;
+    break;
+
+  default:
+    assert(e->tag == TAG_ARITH_BUFFER);
+    b = e->val.arith_buffer;
+    for (i=1; i<b->num_nodes; i++) {
+      if (q_is_nonzero(&b->mono[i].coeff)) {
+        r = b->mono[i].prod;
+        a[k].var = pp_is_empty(r) ? const_idx : var_of_pp(r);
+        q_set(&a[k].coeff, &b->mono[i].coeff);
+        k ++;
+      }
+    }
+    break;
+  }
+
+  return k;
+}
+
+/*
+ * Try to build the sum f[0] + ... + f[n-1] using mk_arith_linear_sum
+ * - return NULL_TERM if that's not possible (the sum is small or not linear)
+ */
+static term_t mk_bulk_linear_sum(stack_elem_t *f, uint32_t n) {
+  monomial_t *a;
+  uint32_t i, k, m;
+  int32_t s;
+  term_t t;
+
+  if (n < MIN_BULK_SUM_SIZE) return NULL_TERM;
+
+  m = 0;
+  for (i=0; i<n; i++) {
+    s = linear_sum_elem_size(f + i);
+    if (s < 0) return NULL_TERM;
+    m += s;
+  }
+
+  a = alloc_monarray(m);
+  k = 0;
+  for (i=0; i<n; i++) {
+    k = linear_sum_add_elem(f + i, a, k);
+  }
+  assert(k == m);
+
+  t = mk_arith_linear_sum(__yices_globals.manager, a, m);
+  assert(t != NULL_TERM);
+  clear_monarray(a, m);
+  safe_free(a);
+
+  return t;
+}
+
 static void eval_mk_add(tstack_t *stack, stack_elem_t *f, uint32_t n) {
   uint32_t i;
   rba_buffer_t *b;
+  term_t t;
+
+  t = mk_bulk_linear_sum(f, n);
+  if (t != NULL_TERM) {
+    tstack_pop_frame(stack);
+    set_term_result(stack, t);
+    return;
+  }
 
   b = tstack_get_abuffer(stack);
   for (i=0; i<n; i++) {
@@ -484,6 +484,21 @@ void reset_bit_blaster(bit_blaster_t *s) {
 }
 
 
+/*
+ * Estimate: gates are counted as if they had four literals
+ * (the real size depends on the gate's arity)
+ */
+uint64_t bit_blaster_mem_size(bit_blaster_t *s) {
+  uint64_t size;
+
+  size = sizeof(bit_blaster_t);
+  size += (uint64_t) s->htbl.htbl.size * sizeof(boolgate_t *);
+  size += (uint64_t) s->htbl.htbl.nelems * (sizeof(lnkgate_t) + 4 * sizeof(literal_t));
+
+  return size;
+}
+
+
 
 
 
@@ -2931,11 +2946,27 @@ static void bit_blaster_partial_product(bit_blaster_t *s, literal_t *sum, litera
 
 
 /*
- * Assert u = (bvmul a b)
+ * Assert u[i] = l
+ * - u[i] must be a pseudo literal
+ */
+static void bit_blaster_assign_output(bit_blaster_t *s, literal_t u, literal_t l) {
+  literal_t f;
+
+  f = remap_table_find(s->remap, u);
+  if (f == null_literal) {
+    remap_table_assign(s->remap, u, l);
+  } else {
+    bit_blaster_eq(s, f, l);
+  }
+}
+
+
+/*
+ * Array multiplier: assert u = (bvmul a b)
  * - a and b must be arrays of n literals
  * - u must be an array of n non-null pseudo literals
  */
-void bit_blaster_make_bvmul(bit_blaster_t *s, literal_t *a, literal_t *b, literal_t *u, uint32_t n) {
+static void bit_blaster_make_array_mul(bit_blaster_t *s, literal_t *a, literal_t *b, literal_t *u, uint32_t n) {
   ivector_t *v;
   literal_t *aux;
   uint32_t i;
@@ -2963,6 +2994,147 @@ void bit_blaster_make_bvmul(bit_blaster_t *s, literal_t *a, literal_t *b, litera
 }
 
 
+/*
+ * Check whether all elements of a are constant literals
+ */
+static bool bit_array_is_constant(literal_t *a, uint32_t n) {
+  uint32_t i;
+
+  for (i=0; i<n; i++) {
+    if (a[i] != true_literal && a[i] != false_literal) return false;
+  }
+  return true;
+}
+
+
+/*
+ * Digits of the non-adjacent form (canonical signed digits) of a
+ * constant c, modulo 2^n.
+ * - c is an array of n constant literals
+ * - carry = carry from the previous digit (initially 0)
+ * - return the digit for bit i (-1, 0, or +1) and update carry
+ */
+static int32_t csd_digit(literal_t *c, uint32_t n, uint32_t i, uint32_t *carry) {
+  uint32_t v, next;
+
+  v = (c[i] == true_literal) + *carry;
+  if (v == 1) {
+    next = (i+1 < n) && (c[i+1] == true_literal);
+    if (next) {
+      *carry = 1;
+      return -1;
+    }
+    *carry = 0;
+    return 1;
+  }
+  *carry = (v == 2);
+  return 0;
+}
+
+
+/*
+ * Add (a * 2^k) to sum or subtract it from sum (if sub is true)
+ * - sum and a must be arrays of n literals
+ * - k must satisfy 0 <= k < n
+ * The low-order bits of sum (below k) do not change.
+ */
+static void bit_blaster_add_shifted(bit_blaster_t *s, literal_t *sum, literal_t *a, uint32_t n, uint32_t k, bool sub) {
+  uint32_t i;
+  literal_t p, c0, s0, d0;
+
+  assert(k < n);
+
+  // for subtraction: sum - x = sum + (bvnot x) + 1
+  c0 = sub ? true_literal : false_literal;
+  for (i=k; i<n; i++) {
+    p = sub ? not(a[i-k]) : a[i-k];
+    find_full_add(s, sum[i], p, c0, &s0, &d0);
+    if (s0 == null_literal) {
+      assert(d0 == null_literal);
+      s0 = bit_blaster_fresh_literal(s);
+      d0 = bit_blaster_fresh_literal(s);
+      make_full_add(s, sum[i], p, c0, s0, d0);
+    }
+    sum[i] = s0;
+    c0 = d0;
+  }
+}
+
+
+/*
+ * Multiplication by a constant: assert u = (bvmul a c)
+ * - c must be an array of n constant literals
+ * - a must be an array of n literals
+ * - u must be an array of n non-null pseudo literals
+ *
+ * We add or subtract one shifted copy of a per non-zero digit of c.
+ * The digits are the canonical signed digits of c if that has fewer
+ * non-zero digits than the binary representation. For example, if c
+ * is 0b01111000 then we compute (a * 2^7 - a * 2^3).
+ */
+static void bit_blaster_make_const_mul(bit_blaster_t *s, literal_t *a, literal_t *c, literal_t *u, uint32_t n) {
+  ivector_t *v;
+  literal_t *sum;
+  uint32_t i, carry, nbin, ncsd;
+  int32_t d;
+  bool csd;
+
+  assert(bit_array_is_constant(c, n));
+
+  nbin = 0;
+  ncsd = 0;
+  carry = 0;
+  for (i=0; i<n; i++) {
+    nbin += (c[i] == true_literal);
+    ncsd += (csd_digit(c, n, i, &carry) != 0);
+  }
+  csd = ncsd < nbin;
+
+  v = &s->aux_vector2;
+  resize_ivector(v, n);
+  ivector_reset(v);
+  sum = v->data;
+  for (i=0; i<n; i++) {
+    sum[i] = false_literal;
+  }
+
+  carry = 0;
+  for (i=0; i<n; i++) {
+    if (csd) {
+      d = csd_digit(c, n, i, &carry);
+    } else {
+      d = (c[i] == true_literal);
+    }
+    if (d != 0) {
+      bit_blaster_add_shifted(s, sum, a, n, i, d < 0);
+    }
+  }
+
+  for (i=0; i<n; i++) {
+    bit_blaster_assign_output(s, u[i], sum[i]);
+  }
+}
+
+
+/*
+ * Assert u = (bvmul a b)
+ * - a and b must be arrays of n literals
+ * - u must be an array of n non-null pseudo literals
+ *
+ * If a or b is a constant, we use shift-and-add/subtract. Otherwise,
+ * we use the array multiplier.
+ */
+void bit_blaster_make_bvmul(bit_blaster_t *s, literal_t *a, literal_t *b, literal_t *u, uint32_t n) {
+  if (bit_array_is_constant(b, n)) {
+    bit_blaster_make_const_mul(s, a, b, u, n);
+  } else if (bit_array_is_constant(a, n)) {
+    bit_blaster_make_const_mul(s, b, a, u, n);
+  } else {
+    bit_blaster_make_array_mul(s, a, b, u, n);
+  }
+}
+
+
 
 
 
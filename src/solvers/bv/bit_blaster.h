@@ -143,6 +143,12 @@ extern void delete_bit_blaster(bit_blaster_t *blaster);
 extern void reset_bit_blaster(bit_blaster_t *blaster);
 
 
+/*
+ * Estimate of the memory used by the gate table (in bytes)
+ */
+extern uint64_t bit_blaster_mem_size(bit_blaster_t *blaster);
+
+
 /*
  * Push/pop just apply to the internal gate table
  */
@@ -526,6 +532,10 @@ extern void bit_blaster_make_bvmux(bit_blaster_t *blaster, literal_t c, literal_
  * ARITHMETIC CIRCUITS
  * - a and b must be literal arrays of size n
  * - u must be a pseudo literal array of size n
+ *
+ * For bvmul: if a or b is constant, the product is encoded as a sum of
+ * shifted copies of the other operand (using canonical signed digits).
+ * Otherwise, we use a shift-and-add array multiplier.
  */
 extern void bit_blaster_make_bvadd(bit_blaster_t *blaster, literal_t *a, literal_t *b, literal_t *u, uint32_t n);
 extern void bit_blaster_make_bvsub(bit_blaster_t *blaster, literal_t *a, literal_t *b, literal_t *u, uint32_t n);
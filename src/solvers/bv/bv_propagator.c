@@ -0,0 +1,508 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * WORD-LEVEL BOUND PROPAGATION FOR THE BITVECTOR SOLVER
+ */
+
+#include <assert.h>
+
+#include "solvers/bv/bv_propagator.h"
+#include "terms/bv64_constants.h"
+#include "utils/index_vectors.h"
+#include "utils/memalloc.h"
+
+
+/*
+ * UNDO STACK
+ */
+static void init_bv_prop_stack(bv_prop_stack_t *stack) {
+  stack->data = NULL;
+  stack->top = 0;
+  stack->size = 0;
+}
+
+static void delete_bv_prop_stack(bv_prop_stack_t *stack) {
+  safe_free(stack->data);
+  stack->data = NULL;
+}
+
+static void bv_prop_stack_push(bv_prop_stack_t *stack, int32_t tag, literal_t l, uint64_t bound) {
+  uint32_t i, n;
+
+  i = stack->top;
+  if (i == stack->size) {
+    n = stack->size;
+    if (n == 0) {
+      n = DEF_BV_PROP_STACK_SIZE;
+    } else {
+      n += n>>1;
+      if (n > MAX_BV_PROP_STACK_SIZE) {
+        out_of_memory();
+      }
+    }
+    stack->data = (bv_prop_undo_t *) safe_realloc(stack->data, n * sizeof(bv_prop_undo_t));
+    stack->size = n;
+  }
+  assert(i < stack->size);
+  stack->data[i].tag = tag;
+  stack->data[i].lit = l;
+  stack->data[i].bound = bound;
+  stack->top = i+1;
+}
+
+
+
+/*
+ * INITIALIZATION
+ */
+void init_bv_prop(bv_prop_t *prop, smt_core_t *core, bv_vartable_t *vtbl, bv_atomtable_t *atbl) {
+  prop->core = core;
+  prop->vtbl = vtbl;
+  prop->atbl = atbl;
+
+  prop->active = false;
+  prop->nvars = 0;
+  prop->natoms = 0;
+  prop->nbound_atoms = 0;
+  prop->lb = NULL;
+  prop->ub = NULL;
+  prop->lb_lit = NULL;
+  prop->ub_lit = NULL;
+  prop->atoms = NULL;
+  prop->inqueue = NULL;
+
+  init_bv_prop_stack(&prop->stack);
+  init_ivector(&prop->mark, 0);
+  init_ivector(&prop->queue, 0);
+  prop->antecedent = null_literal;
+
+  prop->props = 0;
+  prop->conflicts = 0;
+}
+
+
+/*
+ * Free the arrays
+ */
+static void bv_prop_free_arrays(bv_prop_t *prop) {
+  uint32_t i, n;
+
+  if (prop->atoms != NULL) {
+    n = prop->nvars;
+    for (i=0; i<n; i++) {
+      delete_index_vector(prop->atoms[i]);
+    }
+  }
+  safe_free(prop->lb);
+  safe_free(prop->ub);
+  safe_free(prop->lb_lit);
+  safe_free(prop->ub_lit);
+  safe_free(prop->atoms);
+  safe_free(prop->inqueue);
+  prop->lb = NULL;
+  prop->ub = NULL;
+  prop->lb_lit = NULL;
+  prop->ub_lit = NULL;
+  prop->atoms = NULL;
+  prop->inqueue = NULL;
+  prop->nvars = 0;
+  prop->natoms = 0;
+  prop->nbound_atoms = 0;
+}
+
+
+void delete_bv_prop(bv_prop_t *prop) {
+  bv_prop_free_arrays(prop);
+  delete_bv_prop_stack(&prop->stack);
+  delete_ivector(&prop->mark);
+  delete_ivector(&prop->queue);
+}
+
+
+void bv_prop_deactivate(bv_prop_t *prop) {
+  bv_prop_free_arrays(prop);
+  prop->stack.top = 0;
+  ivector_reset(&prop->queue);
+  prop->active = false;
+}
+
+
+void reset_bv_prop(bv_prop_t *prop) {
+  bv_prop_deactivate(prop);
+  ivector_reset(&prop->mark);
+  prop->props = 0;
+  prop->conflicts = 0;
+}
+
+
+
+/*
+ * BOUND ATOMS
+ */
+typedef enum bv_prop_atom_kind {
+  BV_PROP_NONE,  // not a bound atom
+  BV_PROP_GE,    // (bvge x c)
+  BV_PROP_LE,    // (bvge c x)
+  BV_PROP_EQ,    // (bveq x c) or (bveq c x)
+} bv_prop_atom_kind_t;
+
+
+/*
+ * Check whether atom i is a bound atom on a variable x < prop->nvars
+ * - if so store x in *x and the constant in *c
+ */
+static bv_prop_atom_kind_t bv_prop_atom_kind(bv_prop_t *prop, int32_t i, thvar_t *x, uint64_t *c) {
+  bv_vartable_t *vtbl;
+  bvatm_t *a;
+  bv_prop_atom_kind_t k;
+  thvar_t y;
+
+  vtbl = prop->vtbl;
+  a = bvatom_desc(prop->atbl, i);
+  if (a->lit == null_literal || var_of(a->lit) == const_bvar) {
+    return BV_PROP_NONE;
+  }
+
+  if (bvvar_tag(vtbl, a->right) == BVTAG_CONST64) {
+    y = a->left;
+    *c = bvvar_val64(vtbl, a->right);
+    k = bvatm_is_ge(a) ? BV_PROP_GE : BV_PROP_EQ;
+  } else if (bvvar_tag(vtbl, a->left) == BVTAG_CONST64) {
+    y = a->right;
+    *c = bvvar_val64(vtbl, a->left);
+    k = bvatm_is_ge(a) ? BV_PROP_LE : BV_PROP_EQ;
+  } else {
+    return BV_PROP_NONE;
+  }
+
+  if (bvatm_is_sge(a) || y >= prop->nvars || bvvar_tag(vtbl, y) == BVTAG_CONST64) {
+    return BV_PROP_NONE;
+  }
+
+  *x = y;
+  return k;
+}
+
+
+/*
+ * Add x to the propagation queue
+ */
+static void bv_prop_push_var(bv_prop_t *prop, thvar_t x) {
+  if (! prop->inqueue[x]) {
+    prop->inqueue[x] = true;
+    ivector_push(&prop->queue, x);
+  }
+}
+
+
+/*
+ * Set lower bound on x to c, explained by l
+ * - return false if that's inconsistent with the upper bound
+ *   (then the conflict is (l and ub_lit[x]) and ub_lit[x] is stored in prop->antecedent)
+ */
+static bool bv_prop_set_lb(bv_prop_t *prop, thvar_t x, uint64_t c, literal_t l) {
+  if (c > prop->lb[x]) {
+    if (c > prop->ub[x]) {
+      assert(prop->ub_lit[x] != null_literal);
+      prop->antecedent = prop->ub_lit[x];
+      return false;
+    }
+    bv_prop_stack_push(&prop->stack, 2 * x, prop->lb_lit[x], prop->lb[x]);
+    prop->lb[x] = c;
+    prop->lb_lit[x] = l;
+    bv_prop_push_var(prop, x);
+  }
+  return true;
+}
+
+
+/*
+ * Set upper bound on x to c, explained by l
+ */
+static bool bv_prop_set_ub(bv_prop_t *prop, thvar_t x, uint64_t c, literal_t l) {
+  if (c < prop->ub[x]) {
+    if (c < prop->lb[x]) {
+      assert(prop->lb_lit[x] != null_literal);
+      prop->antecedent = prop->lb_lit[x];
+      return false;
+    }
+    bv_prop_stack_push(&prop->stack, 2 * x + 1, prop->ub_lit[x], prop->ub[x]);
+    prop->ub[x] = c;
+    prop->ub_lit[x] = l;
+    bv_prop_push_var(prop, x);
+  }
+  return true;
+}
+
+
+/*
+ * Update the bounds when atom i is assigned to l
+ * - return false if there's a conflict
+ */
+static bool bv_prop_update_bounds(bv_prop_t *prop, int32_t i, literal_t l) {
+  bv_prop_atom_kind_t k;
+  thvar_t x;
+  uint64_t c;
+  bool pos;
+
+  k = bv_prop_atom_kind(prop, i, &x, &c);
+  pos = (l == bvatom_desc(prop->atbl, i)->lit);
+
+  switch (k) {
+  case BV_PROP_GE:
+    // l is (x >= c) or (x <= c - 1)
+    if (pos) {
+      return bv_prop_set_lb(prop, x, c, l);
+    } else if (c > 0) {
+      return bv_prop_set_ub(prop, x, c - 1, l);
+    }
+    break;
+
+  case BV_PROP_LE:
+    // l is (x <= c) or (x >= c + 1)
+    if (pos) {
+      return bv_prop_set_ub(prop, x, c, l);
+    } else if (c < mask64(bvvar_bitsize(prop->vtbl, x))) {
+      return bv_prop_set_lb(prop, x, c + 1, l);
+    }
+    break;
+
+  case BV_PROP_EQ:
+    if (pos) {
+      return bv_prop_set_lb(prop, x, c, l) && bv_prop_set_ub(prop, x, c, l);
+    }
+    break;
+
+  case BV_PROP_NONE:
+    break;
+  }
+
+  return true;
+}
+
+
+bool bv_prop_assert_atom(bv_prop_t *prop, int32_t i, literal_t l) {
+  if (prop->active && i < prop->natoms && !bv_prop_update_bounds(prop, i, l)) {
+    smt_log_theory_conflict(prop->core, ETRACE_BV, 2);
+    record_binary_theory_conflict(prop->core, not(l), not(prop->antecedent));
+    prop->conflicts ++;
+    return false;
+  }
+  return true;
+}
+
+
+/*
+ * Build the index and the initial bounds
+ */
+bool bv_prop_activate(bv_prop_t *prop) {
+  bv_vartable_t *vtbl;
+  bv_atomtable_t *atbl;
+  literal_t l;
+  thvar_t x;
+  uint64_t c;
+  uint32_t i, n, k;
+  bval_t v;
+
+  bv_prop_deactivate(prop);
+
+  vtbl = prop->vtbl;
+  atbl = prop->atbl;
+  n = vtbl->nvars;
+  prop->nvars = n;
+  prop->natoms = atbl->natoms;
+  if (n == 0) {
+    return true;
+  }
+
+  prop->lb = (uint64_t *) safe_malloc(n * sizeof(uint64_t));
+  prop->ub = (uint64_t *) safe_malloc(n * sizeof(uint64_t));
+  prop->lb_lit = (literal_t *) safe_malloc(n * sizeof(literal_t));
+  prop->ub_lit = (literal_t *) safe_malloc(n * sizeof(literal_t));
+  prop->atoms = (int32_t **) safe_malloc(n * sizeof(int32_t *));
+  prop->inqueue = (uint8_t *) safe_malloc(n * sizeof(uint8_t));
+  for (i=0; i<n; i++) {
+    k = bvvar_bitsize(vtbl, i);
+    prop->lb[i] = 0;
+    prop->ub[i] = (0 < k && k <= 64) ? mask64(k) : 0;
+    prop->lb_lit[i] = null_literal;
+    prop->ub_lit[i] = null_literal;
+    prop->atoms[i] = NULL;
+    prop->inqueue[i] = false;
+  }
+
+  n = prop->natoms;
+  for (i=0; i<n; i++) {
+    if (bv_prop_atom_kind(prop, i, &x, &c) != BV_PROP_NONE) {
+      add_index_to_vector(prop->atoms + x, i);
+      prop->nbound_atoms ++;
+    }
+  }
+
+  // the undo stack is empty: reset all marks
+  n = prop->mark.size;
+  for (i=0; i<n; i++) {
+    prop->mark.data[i] = 0;
+  }
+  prop->active = true;
+
+  // atoms assigned before the search
+  n = prop->natoms;
+  for (i=0; i<n; i++) {
+    l = bvatom_desc(atbl, i)->lit;
+    if (l != null_literal && bv_prop_atom_kind(prop, i, &x, &c) != BV_PROP_NONE) {
+      v = literal_value(prop->core, l);
+      if (! bval_is_undef(v)) {
+        if (! bv_prop_update_bounds(prop, i, (v == VAL_TRUE) ? l : not(l))) {
+          return false;
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+
+/*
+ * Propagate the bound atoms on x that are implied by its bounds
+ */
+static void bv_prop_propagate_var(bv_prop_t *prop, thvar_t x) {
+  bvatm_t *a;
+  int32_t *v;
+  literal_t l, implied, antecedent;
+  uint64_t c;
+  uint32_t i, n;
+  thvar_t y;
+
+  v = prop->atoms[x];
+  if (v == NULL) return;
+
+  n = iv_len(v);
+  for (i=0; i<n; i++) {
+    a = bvatom_desc(prop->atbl, v[i]);
+    l = a->lit;
+    if (literal_is_assigned(prop->core, l)) continue;
+
+    implied = null_literal;
+    antecedent = null_literal;
+    switch (bv_prop_atom_kind(prop, v[i], &y, &c)) {
+    case BV_PROP_GE:
+      assert(y == x);
+      if (prop->lb[x] >= c) {
+        implied = l;
+        antecedent = prop->lb_lit[x];
+      } else if (prop->ub[x] < c) {
+        implied = not(l);
+        antecedent = prop->ub_lit[x];
+      }
+      break;
+
+    case BV_PROP_LE:
+      assert(y == x);
+      if (prop->ub[x] <= c) {
+        implied = l;
+        antecedent = prop->ub_lit[x];
+      } else if (prop->lb[x] > c) {
+        implied = not(l);
+        antecedent = prop->lb_lit[x];
+      }
+      break;
+
+    case BV_PROP_EQ:
+      assert(y == x);
+      if (c < prop->lb[x]) {
+        implied = not(l);
+        antecedent = prop->lb_lit[x];
+      } else if (c > prop->ub[x]) {
+        implied = not(l);
+        antecedent = prop->ub_lit[x];
+      }
+      break;
+
+    case BV_PROP_NONE:
+      assert(false);
+      break;
+    }
+
+    if (antecedent != null_literal) {
+      propagate_literal(prop->core, implied, mk_i32_expl(antecedent));
+      prop->props ++;
+    }
+  }
+}
+
+
+void bv_prop_propagate(bv_prop_t *prop) {
+  uint32_t i, n;
+  thvar_t x;
+
+  n = prop->queue.size;
+  for (i=0; i<n; i++) {
+    x = prop->queue.data[i];
+    prop->inqueue[x] = false;
+    bv_prop_propagate_var(prop, x);
+  }
+  ivector_reset(&prop->queue);
+}
+
+
+
+/*
+ * DECISION LEVELS
+ */
+void bv_prop_increase_level(bv_prop_t *prop) {
+  ivector_push(&prop->mark, prop->stack.top);
+}
+
+
+void bv_prop_backtrack(bv_prop_t *prop, uint32_t k) {
+  bv_prop_undo_t *u;
+  uint32_t i, n;
+  thvar_t x;
+
+  if (k >= prop->mark.size) return;
+
+  n = prop->mark.data[k];
+  i = prop->stack.top;
+  if (prop->active) {
+    while (i > n) {
+      i --;
+      u = prop->stack.data + i;
+      x = u->tag >> 1;
+      if (u->tag & 1) {
+        prop->ub[x] = u->bound;
+        prop->ub_lit[x] = u->lit;
+      } else {
+        prop->lb[x] = u->bound;
+        prop->lb_lit[x] = u->lit;
+      }
+    }
+
+    n = prop->queue.size;
+    for (i=0; i<n; i++) {
+      prop->inqueue[prop->queue.data[i]] = false;
+    }
+  }
+  if (prop->stack.top > prop->mark.data[k]) {
+    prop->stack.top = prop->mark.data[k];
+  }
+  ivector_reset(&prop->queue);
+  ivector_shrink(&prop->mark, k);
+}
@@ -0,0 +1,190 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * WORD-LEVEL BOUND PROPAGATION FOR THE BITVECTOR SOLVER
+ */
+
+/*
+ * After bit-blasting, the atoms (bvge x c), (bvge c x), and (bveq x c)
+ * where c is a constant of at most 64 bits are still attached to
+ * boolean variables in the core. This module keeps track of the
+ * unsigned lower and upper bounds on x implied by the atoms assigned
+ * so far, and uses them during the search to:
+ * - detect conflicts between two bound atoms on the same variable
+ * - propagate the other bound atoms on x that are implied by the
+ *   current bounds.
+ * Conflicts and propagations are explained by a single literal, so
+ * they are found before unit propagation goes through the gates of
+ * the bit-blasted comparators.
+ *
+ * For each variable x:
+ * - lb[x] = lower bound, lb_lit[x] = literal that implies x >= lb[x]
+ * - ub[x] = upper bound, ub_lit[x] = literal that implies x <= ub[x]
+ * - atoms[x] = index vector of the bound atoms on x
+ * The initial bounds are [0, 2^n-1] and are explained by null_literal.
+ *
+ * Bound changes are saved in an undo stack. For each decision level
+ * k, mark[k] stores the size of the undo stack when the solver moves
+ * from level k to level k+1.
+ */
+
+#ifndef __BV_PROPAGATOR_H
+#define __BV_PROPAGATOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "solvers/bv/bv_atomtable.h"
+#include "solvers/bv/bv_vartable.h"
+#include "solvers/cdcl/smt_core.h"
+#include "utils/int_vectors.h"
+
+
+/*
+ * Element of the undo stack: old bound on a variable
+ * - tag = 2x for a lower bound on x, 2x+1 for an upper bound
+ * - lit = old explanation
+ * - bound = old bound
+ */
+typedef struct bv_prop_undo_s {
+  int32_t tag;
+  literal_t lit;
+  uint64_t bound;
+} bv_prop_undo_t;
+
+typedef struct bv_prop_stack_s {
+  bv_prop_undo_t *data;
+  uint32_t top;
+  uint32_t size;
+} bv_prop_stack_t;
+
+#define DEF_BV_PROP_STACK_SIZE 100
+#define MAX_BV_PROP_STACK_SIZE (UINT32_MAX/sizeof(bv_prop_undo_t))
+
+
+/*
+ * Propagator:
+ * - core, vtbl, atbl = attached core, variable and atom tables
+ * - active = true once the bounds have been built for the current search
+ * - nvars = number of variables when the bounds were built
+ * - natoms = number of atoms when the bounds were built
+ * - nbound_atoms = number of bound atoms in the index
+ * - lb, ub, lb_lit, ub_lit, atoms = arrays of size nvars (NULL if nvars = 0)
+ * - stack = undo stack
+ * - mark = undo stack size for each decision level
+ * - queue = variables whose bounds have changed since the last
+ *   propagation (with a mark in inqueue)
+ * - antecedent = other literal in a conflict
+ * - statistics: number of propagated literals and conflicts
+ */
+typedef struct bv_prop_s {
+  smt_core_t *core;
+  bv_vartable_t *vtbl;
+  bv_atomtable_t *atbl;
+
+  bool active;
+  uint32_t nvars;
+  uint32_t natoms;
+  uint32_t nbound_atoms;
+  uint64_t *lb;
+  uint64_t *ub;
+  literal_t *lb_lit;
+  literal_t *ub_lit;
+  int32_t **atoms;
+  uint8_t *inqueue;
+
+  bv_prop_stack_t stack;
+  ivector_t mark;
+  ivector_t queue;
+  literal_t antecedent;
+
+  uint32_t props;
+  uint32_t conflicts;
+} bv_prop_t;
+
+
+/*
+ * Initialize: no variables and no atoms
+ */
+extern void init_bv_prop(bv_prop_t *prop, smt_core_t *core, bv_vartable_t *vtbl, bv_atomtable_t *atbl);
+
+/*
+ * Delete all memory used
+ */
+extern void delete_bv_prop(bv_prop_t *prop);
+
+/*
+ * Disable the propagator and remove all bounds (keep the statistics)
+ * - this must be called when new atoms or variables are added
+ */
+extern void bv_prop_deactivate(bv_prop_t *prop);
+
+/*
+ * Reset: deactivate, clear statistics and decision level marks
+ */
+extern void reset_bv_prop(bv_prop_t *prop);
+
+/*
+ * Build the bound-atom index for all variables and atoms, and
+ * initialize the bounds from the atoms already assigned.
+ * - this must be called at the start of search (at the base level)
+ * - return false if the assigned atoms are inconsistent
+ */
+extern bool bv_prop_activate(bv_prop_t *prop);
+
+/*
+ * Process the assignment of atom i to l (l is the atom literal or its negation)
+ * - return false if that causes a conflict (the conflict is recorded in the core)
+ * - nothing is done if the propagator is not active
+ */
+extern bool bv_prop_assert_atom(bv_prop_t *prop, int32_t i, literal_t l);
+
+/*
+ * Propagate the bound atoms implied by the new bounds
+ */
+extern void bv_prop_propagate(bv_prop_t *prop);
+
+/*
+ * Decision level changes
+ * - increase_level must be called when the solver's decision level
+ *   is increased from k to k+1 (including on push)
+ * - backtrack(k) must be called when the solver backtracks to level k
+ */
+extern void bv_prop_increase_level(bv_prop_t *prop);
+extern void bv_prop_backtrack(bv_prop_t *prop, uint32_t k);
+
+
+/*
+ * Check whether there are bound atoms to propagate
+ */
+static inline bool bv_prop_has_bound_atoms(bv_prop_t *prop) {
+  return prop->nbound_atoms > 0;
+}
+
+
+/*
+ * Explanation for a propagated literal: the antecedent literal
+ * is stored in the expl pointer.
+ */
+static inline literal_t bv_prop_antecedent(void *expl) {
+  return i32_of_expl(expl);
+}
+
+
+#endif /* __BV_PROPAGATOR_H */
@@ -531,6 +531,31 @@ static inline void reset_bv_stats(bv_stats_t *s) {
 
 
 
+
+/******************
+ *  MEMORY USAGE  *
+ *****************/
+
+uint64_t bv_solver_mem_size(bv_solver_t *solver) {
+  uint64_t size;
+
+  size = sizeof(bv_solver_t);
+  size += (uint64_t) solver->vtbl.size * (sizeof(uint32_t) + sizeof(uint8_t) + sizeof(bvvar_desc_t) +
+                                          sizeof(eterm_t) + sizeof(literal_t *));
+  size += (uint64_t) solver->atbl.size * sizeof(bvatm_t);
+  if (solver->remap != NULL) {
+    size += (uint64_t) solver->remap->size * sizeof(literal_t);
+  }
+
+  return size;
+}
+
+uint64_t bv_solver_blaster_mem_size(bv_solver_t *solver) {
+  return (solver->blaster != NULL) ? bit_blaster_mem_size(solver->blaster) : 0;
+}
+
+
+
 /**************
  *  MARKING   *
  *************/
@@ -6324,6 +6349,37 @@ thvar_t bv_solver_var_compiles_to(bv_solver_t *solver, thvar_t x) {
 }
 
 
+/*
+ * Unsigned bounds on x (used for optimization)
+ * - the bounds are computed from x's definition and the
+ *   bounds asserted at the base level
+ * - the result is stored in low and high (both are resized
+ *   to the bitsize of x)
+ */
+void bv_solver_bounds_u(bv_solver_t *solver, thvar_t x, bvconstant_t *low, bvconstant_t *high) {
+  bv64_interval_t intv;
+  bv_interval_t *bounds;
+  uint32_t n;
+
+  x = mtbl_get_root(&solver->mtbl, x);
+  n = bvvar_bitsize(&solver->vtbl, x);
+
+  if (n <= 64) {
+    bvvar_bounds_u64(solver, x, n, MAX_RECUR_DEPTH, &intv);
+    bvconstant_copy64(low, n, intv.low);
+    bvconstant_copy64(high, n, intv.high);
+  } else {
+    alloc_bv_interval_stack(&solver->intv_stack);
+    bounds = get_bv_interval(&solver->intv_stack);
+    assert(bounds != NULL);
+    bvvar_bounds_u(solver, x, n, MAX_RECUR_DEPTH, bounds);
+    bvconstant_copy(low, n, bounds->low);
+    bvconstant_copy(high, n, bounds->high);
+    release_all_bv_intervals(&solver->intv_stack);
+  }
+}
+
+
 
 
 
@@ -6725,6 +6781,7 @@ static void bv_solver_add_conflict(bv_solver_t *solver, ivector_t *v) {
   }
 
   ivector_push(v, null_literal); // end marker
+  smt_log_theory_conflict(solver->core, ETRACE_BV, v->size - 1);
   record_theory_conflict(solver->core, v->data);
 }
 
@@ -6901,6 +6958,7 @@ thvar_t bv_solver_create_on_the_fly_var(bv_solver_t *solver, uint32_t n) {
  */
 void bv_solver_start_internalization(bv_solver_t *solver) {
   solver->bitblasted = false;
+  bv_prop_deactivate(&solver->bprop);
 }
 
 
@@ -6924,6 +6982,27 @@ void bv_solver_start_search(bv_solver_t *solver) {
     return;
   }
 
+  /*
+   * Bound propagation: the bounds implied by atoms assigned
+   * at the base level may be inconsistent.
+   */
+  if (! bv_prop_activate(&solver->bprop)) {
+    add_empty_clause(solver->core);
+    return;
+  }
+
+  /*
+   * Without an egraph, the core skips theory propagation (bool_only
+   * flag set by the context). We need it if there are bound atoms.
+   */
+  if (solver->egraph == NULL) {
+    if (bv_prop_has_bound_atoms(&solver->bprop)) {
+      smt_core_clear_bool_only(solver->core);
+    } else {
+      smt_core_set_bool_only(solver->core);
+    }
+  }
+
   if (solver->egraph != NULL) {
     propagate_strong_equalities(solver);
   }
@@ -6936,6 +7015,7 @@ void bv_solver_start_search(bv_solver_t *solver) {
  * - return true otherwise
  */
 bool bv_solver_propagate(bv_solver_t *solver) {
+  bv_prop_propagate(&solver->bprop);
   if (eassertion_queue_is_nonempty(&solver->egraph_queue)) {
     assert(solver->bitblasted);
     return bv_solver_process_egraph_assertions(solver);
@@ -6956,6 +7036,7 @@ void bv_solver_clear(bv_solver_t *solver) {
 
 void bv_solver_increase_decision_level(bv_solver_t *solver) {
   solver->decision_level ++;
+  bv_prop_increase_level(&solver->bprop);
 
 #if DUMP
   if (solver->core->stats.decisions == 1) {
@@ -6967,6 +7048,7 @@ void bv_solver_increase_decision_level(bv_solver_t *solver) {
 void bv_solver_backtrack(bv_solver_t *solver, uint32_t backlevel) {
   assert(solver->base_level <= backlevel && backlevel < solver->decision_level);
   reset_eassertion_queue(&solver->egraph_queue);
+  bv_prop_backtrack(&solver->bprop, backlevel);
   solver->decision_level = backlevel;
 }
 
@@ -6979,19 +7061,20 @@ void bv_solver_backtrack(bv_solver_t *solver, uint32_t backlevel) {
  * - if l is negative (i.e., neg_lit(v)), assert its negation
  * Return false if that causes a conflict, true otherwise.
  *
- * Do nothing (although we could try more simplification if
- * this is called before start_search).
+ * Only bound atoms are used (to update the bounds in solver->bprop).
+ * Nothing is done if this is called before start_search.
  */
 bool bv_solver_assert_atom(bv_solver_t *solver, void *a, literal_t l) {
-  return true;
+  return bv_prop_assert_atom(&solver->bprop, bvatom_tagged_ptr2idx(a), l);
 }
 
 
 /*
- * This function should never be called.
+ * Explanation for a literal propagated by solver->bprop:
+ * the antecedent literal is stored in expl.
  */
 void bv_solver_expand_explanation(bv_solver_t *solver, literal_t l, void *expl, ivector_t *v) {
-  assert(false);
+  ivector_push(v, bv_prop_antecedent(expl));
 }
 
 
@@ -7027,6 +7110,7 @@ void init_bv_solver(bv_solver_t *solver, smt_core_t *core, egraph_t *egraph) {
   init_bvexp_table(&solver->etbl, &solver->vtbl);
   init_mtbl(&solver->mtbl);
   init_bv_bound_queue(&solver->bqueue);
+  init_bv_prop(&solver->bprop, core, &solver->vtbl, &solver->atbl);
 
   solver->compiler = NULL;
   solver->blaster = NULL;
@@ -7082,6 +7166,7 @@ void delete_bv_solver(bv_solver_t *solver) {
   delete_bv_atomtable(&solver->atbl);
   delete_mtbl(&solver->mtbl);
   delete_bv_bound_queue(&solver->bqueue);
+  delete_bv_prop(&solver->bprop);
 
   if (solver->compiler != NULL) {
     delete_bv_compiler(solver->compiler);
@@ -7318,6 +7403,7 @@ void bv_solver_pop(bv_solver_t *solver) {
   bvexp_table_remove_vars(&solver->etbl, top->nvars);
 
   bv_solver_remove_bounds(solver, top->nbounds);
+  bv_prop_deactivate(&solver->bprop);
   bv_vartable_remove_vars(&solver->vtbl, top->nvars);
   bv_atomtable_remove_atoms(&solver->atbl, top->natoms);
   bv_solver_remove_dead_eterms(solver);
@@ -7352,6 +7438,7 @@ void bv_solver_reset(bv_solver_t *solver) {
   reset_bv_atomtable(&solver->atbl);
   reset_mtbl(&solver->mtbl);
   reset_bv_bound_queue(&solver->bqueue);
+  reset_bv_prop(&solver->bprop);
 
   if (solver->compiler != NULL) {
     delete_bv_compiler(solver->compiler);
@@ -199,6 +199,15 @@ extern eterm_t bv_solver_eterm_of_var(bv_solver_t *solver, thvar_t x);
 extern thvar_t bv_solver_var_compiles_to(bv_solver_t *solver, thvar_t x);
 
 
+/*
+ * Unsigned bounds on x: low <= x <= high
+ * - the bounds are derived from x's definition and the bounds
+ *   asserted at the base level
+ * - low and high are resized to the bitsize of x
+ */
+extern void bv_solver_bounds_u(bv_solver_t *solver, thvar_t x, bvconstant_t *low, bvconstant_t *high);
+
+
 
 /****************
  *  STATISTICS  *
@@ -268,6 +277,24 @@ static inline uint32_t bv_solver_interface_lemmas(bv_solver_t *solver) {
   return solver->stats.interface_lemmas;
 }
 
+static inline uint32_t bv_solver_bound_propagations(bv_solver_t *solver) {
+  return solver->bprop.props;
+}
+
+static inline uint32_t bv_solver_bound_conflicts(bv_solver_t *solver) {
+  return solver->bprop.conflicts;
+}
+
+
+/*
+ * Memory estimates (in bytes)
+ * - bv_solver_mem_size: variable and atom tables, and remap table
+ * - bv_solver_blaster_mem_size: gate table of the bit-blaster
+ *   (0 if the bit-blaster is not allocated)
+ */
+extern uint64_t bv_solver_mem_size(bv_solver_t *solver);
+extern uint64_t bv_solver_blaster_mem_size(bv_solver_t *solver);
+
 
 
 /************************
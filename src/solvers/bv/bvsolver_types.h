@@ -49,6 +49,7 @@
 #include "solvers/bv/bit_blaster.h"
 #include "solvers/bv/bv_atomtable.h"
 #include "solvers/bv/bv_intervals.h"
+#include "solvers/bv/bv_propagator.h"
 #include "solvers/bv/bv_vartable.h"
 #include "solvers/bv/bvconst_hmap.h"
 #include "solvers/bv/bvexp_table.h"
@@ -321,6 +322,11 @@ typedef struct bv_solver_s {
    */
   bv_bound_queue_t bqueue;
 
+  /*
+   * Bound propagation during the search
+   */
+  bv_prop_t bprop;
+
   /*
    * Data structures for bit-blasting: all are allocated as needed
    */
@@ -22,10 +22,12 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <inttypes.h>
 #include <float.h>
 
 #include "solvers/cdcl/new_sat_solver.h"
+#include "solvers/cdcl/sls_walker.h"
 #include "utils/cputime.h"
 #include "utils/memalloc.h"
 #include "utils/uint_array_sort.h"
@@ -290,6 +292,21 @@ static inline void export_last_conflict(sat_solver_t *solver) { }
  */
 #define RESTART_INTERVAL 10
 
+/*
+ * Stable mode and rephasing:
+ * - MODE_INTERVAL = number of conflicts in the first focused phase
+ * - STABLE_RESTART_UNIT = unit for the Luby sequence in stable mode
+ * - REPHASE_INTERVAL = base interval between two rephases
+ */
+#define MODE_INTERVAL 1000
+#define STABLE_RESTART_UNIT 1024
+#define REPHASE_INTERVAL 1000
+
+/*
+ * Local search: disabled by default
+ */
+#define WALK_FLIPS 0
+
 /*
  * Parameters to control preprocessing
  *
@@ -2151,6 +2168,11 @@ static void init_stats(solver_stats_t *stat) {
   stat->reduce_calls = 0;
   stat->subst_calls = 0;
   stat->scc_calls = 0;
+  stat->mode_switches = 0;
+  stat->rephases = 0;
+  stat->walks = 0;
+  stat->walk_models = 0;
+  stat->walk_flips = 0;
   stat->subst_vars = 0;
   stat->pp_pure_lits = 0;
   stat->pp_unit_lits = 0;
@@ -2176,6 +2198,12 @@ static void init_params(solver_param_t *params) {
   params->reduce_delta = REDUCE_DELTA;
   params->restart_interval = RESTART_INTERVAL;
 
+  params->search_mode = NSAT_FOCUSED_MODE;
+  params->mode_interval = MODE_INTERVAL;
+  params->stable_restart_unit = STABLE_RESTART_UNIT;
+  params->rephase_interval = REPHASE_INTERVAL;
+  params->walk_flips = WALK_FLIPS;
+
   params->var_elim_skip = VAR_ELIM_SKIP;
   params->subsume_skip = SUBSUME_SKIP;
   params->res_clause_limit = RES_CLAUSE_LIMIT;
@@ -2222,6 +2250,8 @@ void init_nsat_solver(sat_solver_t *solver, uint32_t sz, bool pp) {
   solver->ante_data = (uint32_t *) safe_malloc(n * sizeof(uint32_t));
   solver->level = (uint32_t *) safe_malloc(n * sizeof(uint32_t));
   solver->watch = (watch_t **) safe_malloc(n * 2 * sizeof(watch_t *));
+  solver->target = (uint8_t *) safe_malloc(n * sizeof(uint8_t));
+  solver->best = (uint8_t *) safe_malloc(n * sizeof(uint8_t));
 
   solver->occ = NULL;
   if (solver->preprocess) {
@@ -2238,6 +2268,8 @@ void init_nsat_solver(sat_solver_t *solver, uint32_t sz, bool pp) {
   solver->level[0] = 0;
   solver->watch[0] = NULL;
   solver->watch[1] = NULL;
+  solver->target[0] = BVAL_UNDEF_FALSE;
+  solver->best[0] = BVAL_UNDEF_FALSE;
 
   init_heap(&solver->heap, n);
   init_stack(&solver->stack, n);
@@ -2251,6 +2283,10 @@ void init_nsat_solver(sat_solver_t *solver, uint32_t sz, bool pp) {
 
   solver->conflict_tag = CTAG_NONE;
 
+  solver->stable = false;
+  solver->target_assigned = 0;
+  solver->best_assigned = 0;
+
   init_params(&solver->params);
 
   init_stats(&solver->stats);
@@ -2296,6 +2332,8 @@ void delete_nsat_solver(sat_solver_t *solver) {
   safe_free(solver->level);
   delete_watch_vectors(solver->watch, solver->nliterals);
   safe_free(solver->watch);
+  safe_free(solver->target);
+  safe_free(solver->best);
 
   if (solver->preprocess) {
     safe_free(solver->occ);
@@ -2306,6 +2344,8 @@ void delete_nsat_solver(sat_solver_t *solver) {
   solver->ante_data = NULL;
   solver->level = NULL;
   solver->watch = NULL;
+  solver->target = NULL;
+  solver->best = NULL;
 
   delete_heap(&solver->heap);
   delete_stack(&solver->stack);
@@ -2363,6 +2403,10 @@ void reset_nsat_solver(sat_solver_t *solver) {
 
   solver->conflict_tag = CTAG_NONE;
 
+  solver->stable = false;
+  solver->target_assigned = 0;
+  solver->best_assigned = 0;
+
   init_stats(&solver->stats);
 
   safe_free(solver->cidx_array);
@@ -2471,6 +2515,45 @@ void nsat_set_restart_interval(sat_solver_t *solver, uint32_t n) {
   solver->params.restart_interval = n;
 }
 
+/*
+ * Search mode
+ */
+void nsat_set_search_mode(sat_solver_t *solver, nsat_search_mode_t mode) {
+  assert(mode <= NSAT_ALTERNATE_MODE);
+  solver->params.search_mode = mode;
+}
+
+/*
+ * Number of conflicts before the first mode switch
+ */
+void nsat_set_mode_interval(sat_solver_t *solver, uint32_t n) {
+  assert(n > 0);
+  solver->params.mode_interval = n;
+}
+
+/*
+ * Unit for the Luby sequence in stable mode
+ */
+void nsat_set_stable_restart_unit(sat_solver_t *solver, uint32_t n) {
+  assert(n > 0);
+  solver->params.stable_restart_unit = n;
+}
+
+/*
+ * Base interval between two rephases
+ */
+void nsat_set_rephase_interval(sat_solver_t *solver, uint32_t n) {
+  assert(n > 0);
+  solver->params.rephase_interval = n;
+}
+
+/*
+ * Bound on the number of flips per walk
+ */
+void nsat_set_walk_flips(sat_solver_t *solver, uint32_t n) {
+  solver->params.walk_flips = n;
+}
+
 /*
  * Stack clause threshold: learned clauses of LBD greater than threshold are
  * treated as temporary clauses (not stored in the clause database).
@@ -2541,6 +2624,8 @@ static void sat_solver_extend(sat_solver_t *solver, uint32_t new_size) {
   solver->ante_data = (uint32_t *) safe_realloc(solver->ante_data, new_size * sizeof(uint32_t));
   solver->level = (uint32_t *) safe_realloc(solver->level, new_size * sizeof(uint32_t));
   solver->watch = (watch_t **) safe_realloc(solver->watch, new_size * 2 * sizeof(watch_t *));
+  solver->target = (uint8_t *) safe_realloc(solver->target, new_size * sizeof(uint8_t));
+  solver->best = (uint8_t *) safe_realloc(solver->best, new_size * sizeof(uint8_t));
 
   if (solver->preprocess) {
     solver->occ = (uint32_t *) safe_realloc(solver->occ, new_size * 2 * sizeof(uint32_t));
@@ -2581,6 +2666,8 @@ void nsat_solver_add_vars(sat_solver_t *solver, uint32_t n) {
     solver->level[i] = UINT32_MAX;
     solver->watch[pos(i)] = NULL;
     solver->watch[neg(i)] = NULL;
+    solver->target[i] = BVAL_UNDEF_FALSE;
+    solver->best[i] = BVAL_UNDEF_FALSE;
   }
 
   if (solver->preprocess) {
@@ -6554,6 +6641,58 @@ static void full_restart(sat_solver_t *solver) {
 }
 
 
+/*****************************
+ *  TARGET AND BEST PHASES   *
+ ****************************/
+
+/*
+ * Copy the current value of the first n literals of the trail into a
+ * - a must be either solver->target or solver->best
+ * - for a literal l on the trail, value[pos(var_of(l))] is either
+ *   BVAL_TRUE or BVAL_FALSE
+ */
+static void copy_trail_phases(sat_solver_t *solver, uint8_t *a, uint32_t n) {
+  uint32_t i;
+  bvar_t x;
+
+  assert(n <= solver->stack.top);
+
+  for (i=0; i<n; i++) {
+    x = var_of(solver->stack.lit[i]);
+    assert(var_is_assigned(solver, x));
+    a[x] = solver->value[pos(x)];
+  }
+}
+
+/*
+ * Update the target and best phases
+ * - n = number of literals at the start of the trail that are known
+ *   to be conflict free
+ * - the target phase is updated only in stable mode
+ * - nothing is done in focused mode (neither target nor best are used).
+ */
+static void update_target_and_best(sat_solver_t *solver, uint32_t n) {
+  if (solver->params.search_mode == NSAT_FOCUSED_MODE) return;
+
+  if (solver->stable && n > solver->target_assigned) {
+    copy_trail_phases(solver, solver->target, n);
+    solver->target_assigned = n;
+  }
+  if (n > solver->best_assigned) {
+    copy_trail_phases(solver, solver->best, n);
+    solver->best_assigned = n;
+  }
+}
+
+/*
+ * Forget the target phase
+ */
+static void clear_target_phase(sat_solver_t *solver) {
+  memset(solver->target, BVAL_UNDEF_FALSE, solver->nvars * sizeof(uint8_t));
+  solver->target_assigned = 0;
+}
+
+
 /*******************************************************
  *  CONFLICT ANALYSIS AND CREATION OF LEARNED CLAUSES  *
  ******************************************************/
@@ -7071,6 +7210,9 @@ static void resolve_conflict(sat_solver_t *solver) {
   // Collect data if compiled with DATA=1
   export_conflict_data(solver, d);
 
+  // all levels below the conflict level are conflict free
+  update_target_and_best(solver, solver->stack.level_index[solver->decision_level]);
+
   backtrack(solver, solver->backtrack_level);
   solver->conflict_tag = CTAG_NONE;
 
@@ -7291,6 +7433,32 @@ static void extend_assignment(sat_solver_t *solver) {
  * - changed K to (1 - 1/2^4 - 1/2^5) = 0.90625
  */
 
+/*
+ * In stable mode, we use the reluctant doubling sequence (Knuth's
+ * formulation of the Luby sequence). The state is a pair (u, v):
+ * - initially (u, v) = (1, 1)
+ * - next: if (u & -u) == v then (u+1, 1) else (u, 2v)
+ * The successive values of v are 1, 1, 2, 1, 1, 2, 4, 1, 1, 2, 1, 1, 2, 4, 8, ...
+ * and the restart interval is v * stable_restart_unit.
+ */
+static void reset_luby(sat_solver_t *solver) {
+  solver->luby_u = 1;
+  solver->luby_v = 1;
+}
+
+static void next_luby(sat_solver_t *solver) {
+  uint32_t u, v;
+
+  u = solver->luby_u;
+  v = solver->luby_v;
+  if ((u & -u) == v) {
+    solver->luby_u = u + 1;
+    solver->luby_v = 1;
+  } else {
+    solver->luby_v = v << 1;
+  }
+}
+
 /*
  * Initialize the restart counters
  */
@@ -7299,9 +7467,30 @@ static void init_restart(sat_solver_t *solver) {
   solver->fast_ema = 0;
   solver->blocking_ema = 0;
   solver->level_ema = 0;
-  solver->restart_next = solver->params.restart_interval;
   solver->fast_count = 0;
   solver->blocking_count = 0;
+
+  reset_luby(solver);
+  solver->stable = (solver->params.search_mode == NSAT_STABLE_MODE);
+  if (solver->stable) {
+    solver->restart_next = solver->params.stable_restart_unit;
+  } else {
+    solver->restart_next = solver->params.restart_interval;
+  }
+
+  solver->mode_inc = solver->params.mode_interval;
+  solver->mode_next = UINT64_MAX;
+  if (solver->params.search_mode == NSAT_ALTERNATE_MODE) {
+    solver->mode_next = solver->mode_inc;
+  }
+
+  solver->rephase_next = UINT64_MAX;
+  if (solver->params.search_mode != NSAT_FOCUSED_MODE) {
+    solver->rephase_next = solver->params.rephase_interval;
+  }
+
+  clear_target_phase(solver);
+  solver->best_assigned = 0;
 }
 
 /*
@@ -7322,6 +7511,15 @@ static void glucose_blocking(sat_solver_t *solver) {
 static bool need_restart(sat_solver_t *solver) {
   uint64_t aux;
 
+  if (solver->stats.conflicts >= solver->mode_next) {
+    // time to switch mode
+    return true;
+  }
+
+  if (solver->stable) {
+    return solver->stats.conflicts >= solver->restart_next;
+  }
+
   if (solver->stats.conflicts >= solver->restart_next &&
       solver->decision_level >= (uint32_t) (solver->fast_ema >> 32)) {
     aux = solver->fast_ema;
@@ -7336,7 +7534,242 @@ static bool need_restart(sat_solver_t *solver) {
 }
 
 static void done_restart(sat_solver_t *solver) {
-  solver->restart_next = solver->stats.conflicts + solver->params.restart_interval;
+  if (solver->stable) {
+    solver->restart_next = solver->stats.conflicts + (uint64_t) solver->luby_v * solver->params.stable_restart_unit;
+    next_luby(solver);
+  } else {
+    solver->restart_next = solver->stats.conflicts + solver->params.restart_interval;
+  }
+}
+
+
+/*
+ * MODE SWITCHING
+ */
+
+/*
+ * In alternate mode: check whether it's time to switch between
+ * focused and stable mode.
+ */
+static inline bool need_mode_switch(const sat_solver_t *solver) {
+  return solver->stats.conflicts >= solver->mode_next;
+}
+
+/*
+ * Switch mode:
+ * - the length of the next phase is doubled when we leave stable mode
+ * - the Luby sequence restarts from 1 on entry to stable mode
+ * - the target phase is reset
+ */
+static void switch_search_mode(sat_solver_t *solver) {
+  assert(solver->params.search_mode == NSAT_ALTERNATE_MODE);
+
+  solver->stats.mode_switches ++;
+  if (solver->stable) {
+    solver->stable = false;
+    solver->mode_inc <<= 1;
+    report(solver, "foc");
+  } else {
+    solver->stable = true;
+    reset_luby(solver);
+    clear_target_phase(solver);
+    report(solver, "stb");
+  }
+  solver->mode_next = solver->stats.conflicts + solver->mode_inc;
+}
+
+
+/*
+ * REPHASING
+ */
+
+/*
+ * Rephasing resets the saved phase of all variables. We cycle through
+ * the following sequence: B O B I B R where
+ *   B = best phase (from the largest trail seen since the previous B)
+ *   O = original phase (all false)
+ *   I = inverted phase (all true)
+ *   R = random phase
+ * If local search is enabled, every B is followed by a walk that starts
+ * from the best phase.
+ * This must be called at decision level 0.
+ */
+static inline bool need_rephase(const sat_solver_t *solver) {
+  return solver->stats.conflicts >= solver->rephase_next;
+}
+
+// set the saved phase of variable x: val must be either 0 (false) or 1 (true)
+static inline void set_saved_phase(sat_solver_t *solver, bvar_t x, uint8_t val) {
+  assert(var_is_unassigned(solver, x) && val <= 1);
+  solver->value[pos(x)] = val;
+  solver->value[neg(x)] = val ^ 1;
+}
+
+/*
+ * LOCAL SEARCH
+ */
+
+/*
+ * Add clause a[0 ... n-1] to walker w:
+ * - skip the clause if it's true at level 0 and remove the false literals
+ * - solver->buffer is used as a temporary buffer
+ */
+static void walker_add_clause(sat_solver_t *solver, sls_walker_t *w, uint32_t n, const literal_t *a) {
+  uint32_t i;
+
+  reset_vector(&solver->buffer);
+  for (i=0; i<n; i++) {
+    switch (lit_value(solver, a[i])) {
+    case BVAL_TRUE:
+      reset_vector(&solver->buffer);
+      return;
+
+    case BVAL_FALSE:
+      break;
+
+    default:
+      vector_push(&solver->buffer, a[i]);
+      break;
+    }
+  }
+
+  if (solver->buffer.size > 0) {
+    sls_walker_add_clause(w, solver->buffer.size, (int32_t *) solver->buffer.data);
+  }
+  reset_vector(&solver->buffer);
+}
+
+/*
+ * Copy the binary and problem clauses into w
+ * - a binary clause {l0, l1} occurs in watch[l0] and watch[l1]
+ *   so we add it only once (when l0 < l1)
+ */
+static void walker_add_clauses(sat_solver_t *solver, sls_walker_t *w) {
+  literal_t aux[2];
+  watch_t *v;
+  uint32_t i, k;
+  literal_t l0, l1;
+  cidx_t cidx;
+
+  for (l0=0; l0<solver->nliterals; l0++) {
+    v = solver->watch[l0];
+    if (v != NULL) {
+      i = 0;
+      while (i < v->size) {
+        k = v->data[i];
+        if (idx_is_literal(k)) {
+          l1 = idx2lit(k);
+          if (l0 < l1) {
+            aux[0] = l0;
+            aux[1] = l1;
+            walker_add_clause(solver, w, 2, aux);
+          }
+          i ++;
+        } else {
+          i += 2;
+        }
+      }
+    }
+  }
+
+  cidx = clause_pool_first_clause(&solver->pool);
+  while (cidx < solver->pool.learned) {
+    walker_add_clause(solver, w, clause_length(&solver->pool, cidx), clause_literals(&solver->pool, cidx));
+    cidx = clause_pool_next_clause(&solver->pool, cidx);
+  }
+}
+
+/*
+ * Run a local search starting from the saved phases then replace
+ * the saved phases by the best assignment found.
+ * - this must be called at decision level 0
+ * - if the walk finds a model, the next search follows it
+ *   and doesn't need any conflict.
+ */
+static void walk(sat_solver_t *solver) {
+  sls_walker_t w;
+  uint32_t i, n;
+
+  assert(solver->decision_level == 0 && solver->params.walk_flips > 0);
+
+  n = solver->nvars;
+  init_sls_walker(&w, n);
+  sls_walker_set_seed(&w, random_uint32(solver));
+  walker_add_clauses(solver, &w);
+  for (i=1; i<n; i++) {
+    if (var_is_active(solver, i)) {
+      sls_walker_set_value(&w, i, solver->value[pos(i)] & 1);
+    }
+  }
+
+  if (sls_walk(&w, solver->params.walk_flips) == 0) {
+    solver->stats.walk_models ++;
+  }
+  solver->stats.walks ++;
+  solver->stats.walk_flips += w.flips;
+
+  for (i=1; i<n; i++) {
+    if (var_is_active(solver, i)) {
+      set_saved_phase(solver, i, sls_walker_best_value(&w, i));
+    }
+  }
+  delete_sls_walker(&w);
+
+  report(solver, "w");
+}
+
+static void rephase(sat_solver_t *solver) {
+  uint32_t i, n, k;
+  uint8_t val;
+
+  assert(solver->decision_level == 0);
+
+  k = solver->stats.rephases;
+  solver->stats.rephases ++;
+
+  n = solver->nvars;
+  if ((k & 1) == 0) {
+    // best phase
+    if (solver->best_assigned > 0) {
+      for (i=1; i<n; i++) {
+        val = solver->best[i];
+        if (var_is_unassigned(solver, i) && !is_unassigned_val(val)) {
+          set_saved_phase(solver, i, val & 1);
+        }
+      }
+    }
+    solver->best_assigned = 0;
+    report(solver, "rb");
+    if (solver->params.walk_flips > 0) {
+      walk(solver);
+    }
+  } else {
+    switch ((k >> 1) % 3) {
+    case 0: // original phase
+      for (i=1; i<n; i++) {
+        if (var_is_unassigned(solver, i)) set_saved_phase(solver, i, 0);
+      }
+      report(solver, "ro");
+      break;
+
+    case 1: // inverted phase
+      for (i=1; i<n; i++) {
+        if (var_is_unassigned(solver, i)) set_saved_phase(solver, i, 1);
+      }
+      report(solver, "ri");
+      break;
+
+    default: // random phase
+      for (i=1; i<n; i++) {
+        if (var_is_unassigned(solver, i)) set_saved_phase(solver, i, random_uint32(solver) & 1);
+      }
+      report(solver, "rr");
+      break;
+    }
+  }
+
+  clear_target_phase(solver);
+  solver->rephase_next = solver->stats.conflicts + (uint64_t) solver->params.rephase_interval * solver->stats.rephases;
 }
 
 /*
@@ -7542,6 +7975,24 @@ static inline literal_t preferred_literal(const sat_solver_t *solver, bvar_t x)
   return l;
 }
 
+/*
+ * Decision literal for x:
+ * - in stable mode, we use the target phase of x if it's set
+ * - otherwise, we use the saved phase
+ */
+static inline literal_t decision_literal(const sat_solver_t *solver, bvar_t x) {
+  uint8_t val;
+
+  if (solver->stable) {
+    val = solver->target[x];
+    if (! is_unassigned_val(val)) {
+      // pos(x) if val is BVAL_TRUE, neg(x) if val is BVAL_FALSE
+      return pos(x) ^ 1 ^ (val & 1);
+    }
+  }
+  return preferred_literal(solver, x);
+}
+
 
 /*
  * Search until we get sat/unsat or we restart
@@ -7574,7 +8025,7 @@ static void sat_search(sat_solver_t *solver) {
         solver->status = STAT_SAT;
         break;
       }
-      nsat_decide_literal(solver, preferred_literal(solver, x));
+      nsat_decide_literal(solver, decision_literal(solver, x));
     } else {
       // Conflict
       if (solver->decision_level == 0) {
@@ -7656,6 +8107,11 @@ solver_status_t nsat_solve(sat_solver_t *solver) {
     done_simplify(solver);
   }
 
+  // local search before the first restart
+  if (solver->params.walk_flips > 0 && !solver->has_empty_clause) {
+    walk(solver);
+  }
+
   // main loop: simplification may detect unsat
   // and set has_empty_clause to true
   while (! solver->has_empty_clause) {
@@ -7663,6 +8119,16 @@ solver_status_t nsat_solve(sat_solver_t *solver) {
     sat_search(solver);
     if (solver->status != STAT_UNKNOWN) break;
 
+    // the trail is conflict free here
+    update_target_and_best(solver, solver->stack.top);
+    if (need_mode_switch(solver)) {
+      switch_search_mode(solver);
+    }
+    if (need_rephase(solver)) {
+      full_restart(solver);
+      rephase(solver);
+    }
+
     if (need_simplify(solver)) {
       full_restart(solver);
       done_restart(solver);
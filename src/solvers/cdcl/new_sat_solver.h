@@ -609,12 +609,17 @@ typedef struct solver_stats_s {
   uint64_t prob_clauses_deleted;     // number of problem clauses deleted
   uint64_t learned_clauses_deleted;  // number of learned clauses deleted
   uint64_t subsumed_literals;        // removed from learned clause (cf. simplify_learned_clause)
+  uint64_t walk_flips;               // total number of flips in local search
 
   uint32_t starts;                   // 1 + number of restarts
   uint32_t simplify_calls;           // number of calls to simplify_clause_database
   uint32_t reduce_calls;             // number of calls to reduce_learned_clause_set
   uint32_t scc_calls;                // number of calls to try_scc_simplification
   uint32_t subst_calls;              // number of calls to apply_substitution
+  uint32_t mode_switches;            // number of switches between focused and stable mode
+  uint32_t rephases;                 // number of calls to rephase
+  uint32_t walks;                    // number of calls to walk (local search)
+  uint32_t walk_models;              // number of walks that found a model
 
   // Substitutions
   uint32_t subst_vars;               // number of variables eliminated by substitution
@@ -635,6 +640,32 @@ typedef struct solver_stats_s {
  *  HEURISTIC PARAMETERS  *
  *************************/
 
+/*
+ * Search modes:
+ * - NSAT_FOCUSED_MODE: frequent restarts driven by the LBD moving averages
+ *   (Glucose-style restarts). This is the default.
+ * - NSAT_STABLE_MODE: few restarts following the reluctant doubling
+ *   (Luby) sequence. Decisions use the target phase (i.e., the phase of
+ *   the largest conflict-free trail seen since the last rephase).
+ * - NSAT_ALTERNATE_MODE: switch between focused and stable mode. The
+ *   first focused phase lasts mode_interval conflicts; the length of
+ *   each mode phase is doubled after every stable phase.
+ *
+ * In stable and alternate modes, the saved phases are also reset
+ * periodically (rephasing) to the best phase, the original phase,
+ * the inverted phase, or a random phase.
+ *
+ * If walk_flips is positive, the solver also runs a ProbSAT-style local
+ * search (cf. sls_walker.h) before the search starts and after every
+ * rephase to the best phase. Each walk is bounded by walk_flips flips.
+ * The best assignment found by the walk replaces the saved phases.
+ */
+typedef enum nsat_search_mode {
+  NSAT_FOCUSED_MODE,
+  NSAT_STABLE_MODE,
+  NSAT_ALTERNATE_MODE,
+} nsat_search_mode_t;
+
 typedef struct solver_param_s {
   /*
    * Search/restart/reduce heuristics
@@ -649,6 +680,15 @@ typedef struct solver_param_s {
   uint32_t reduce_delta;       // Adjustment to reduce_interval
   uint32_t restart_interval;   // Minimal number of conflicts between two restarts
 
+  /*
+   * Stable mode and rephasing
+   */
+  nsat_search_mode_t search_mode;  // Focused, stable, or alternate
+  uint32_t mode_interval;          // Number of conflicts before the first mode switch
+  uint32_t stable_restart_unit;    // Unit for the Luby sequence in stable mode
+  uint32_t rephase_interval;       // Base number of conflicts between two rephases
+  uint32_t walk_flips;             // Bound on the number of flips per walk (0 means no walk)
+
   /*
    * Heuristics/parameters for preprocessing
    * (these have no effect if the 'preprocess' flag is false)
@@ -847,6 +887,30 @@ typedef struct sat_solver_s {
   uint32_t fast_count;
   uint32_t blocking_count;
 
+  /*
+   * Stable mode and phase heuristics:
+   * - stable is true when the solver is in stable mode
+   * - target[x] = target phase of x (used for decisions in stable mode)
+   * - best[x] = best phase of x (used by rephase)
+   *   both are BVAL_TRUE or BVAL_FALSE if set, or BVAL_UNDEF_FALSE if not set
+   * - target_assigned = size of the trail from which target was copied
+   * - best_assigned = size of the trail from which best was copied
+   * - mode_next = number of conflicts before the next mode switch
+   * - mode_inc = length of the current mode phase
+   * - luby_u, luby_v = state for the reluctant doubling sequence
+   * - rephase_next = number of conflicts before the next rephase
+   */
+  bool stable;
+  uint8_t *target;
+  uint8_t *best;
+  uint32_t target_assigned;
+  uint32_t best_assigned;
+  uint64_t mode_next;
+  uint32_t mode_inc;
+  uint32_t luby_u;
+  uint32_t luby_v;
+  uint64_t rephase_next;
+
   /*
    * Statistics record
    */
@@ -1024,6 +1088,35 @@ extern void nsat_set_reduce_delta(sat_solver_t *solver, uint32_t d);
  */
 extern void nsat_set_restart_interval(sat_solver_t *solver, uint32_t n);
 
+/*
+ * Search mode: focused, stable, or alternate (cf. nsat_search_mode_t)
+ */
+extern void nsat_set_search_mode(sat_solver_t *solver, nsat_search_mode_t mode);
+
+/*
+ * Number of conflicts before the first switch between focused and stable mode
+ * (used only in alternate mode). n must be positive.
+ */
+extern void nsat_set_mode_interval(sat_solver_t *solver, uint32_t n);
+
+/*
+ * Unit for stable-mode restarts: the number of conflicts between two
+ * restarts is unit * luby(i). n must be positive.
+ */
+extern void nsat_set_stable_restart_unit(sat_solver_t *solver, uint32_t n);
+
+/*
+ * Base interval for rephasing: the i-th rephase happens
+ * n * i conflicts after the previous one. n must be positive.
+ */
+extern void nsat_set_rephase_interval(sat_solver_t *solver, uint32_t n);
+
+/*
+ * Local search: maximal number of flips per walk.
+ * n = 0 disables local search.
+ */
+extern void nsat_set_walk_flips(sat_solver_t *solver, uint32_t n);
+
 /*
  * PREPROCESSING PARAMETERS
  */
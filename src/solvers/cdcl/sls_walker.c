@@ -0,0 +1,421 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * STOCHASTIC LOCAL SEARCH ON CLAUSES (PROBSAT)
+ */
+
+#include <string.h>
+
+#include "solvers/cdcl/sls_walker.h"
+#include "utils/memalloc.h"
+
+
+/*
+ * PSEUDO RANDOM NUMBERS
+ *
+ * Same linear congruence as in the CDCL solvers. We drop the
+ * 8 low-order bits, which are not very random.
+ */
+#define SLS_PRNG_MULTIPLIER 1664525
+#define SLS_PRNG_CONSTANT   1013904223
+
+static inline uint32_t sls_random(sls_walker_t *w) {
+  uint32_t x;
+
+  x = w->prng;
+  w->prng = x * ((uint32_t) SLS_PRNG_MULTIPLIER) + ((uint32_t) SLS_PRNG_CONSTANT);
+  return x >> 8;
+}
+
+// random integer between 0 and n-1
+static inline uint32_t sls_random_uint(sls_walker_t *w, uint32_t n) {
+  assert(n > 0);
+  return sls_random(w) % n;
+}
+
+// random number in [0, 1)
+static inline double sls_random_fraction(sls_walker_t *w) {
+  return ((double) sls_random(w)) / ((double) 0x1000000);
+}
+
+
+
+/*
+ * INITIALIZATION/DELETION
+ */
+void init_sls_walker(sls_walker_t *w, uint32_t nvars) {
+  assert(nvars > 0);
+
+  w->nvars = nvars;
+  w->nclauses = 0;
+  init_ivector(&w->cstart, 0);
+  init_ivector(&w->lit, 0);
+  ivector_push(&w->cstart, 0);
+  w->max_len = 0;
+  w->occ_start = NULL;
+  w->occ = NULL;
+  w->ntrue = NULL;
+  w->unsat = NULL;
+  w->upos = NULL;
+  w->nunsat = 0;
+  w->val = (uint8_t *) safe_malloc(nvars * sizeof(uint8_t));
+  w->best = (uint8_t *) safe_malloc(nvars * sizeof(uint8_t));
+  memset(w->val, 0, nvars * sizeof(uint8_t));
+  memset(w->best, 0, nvars * sizeof(uint8_t));
+  w->best_unsat = UINT32_MAX;
+  init_ivector(&w->trail, 0);
+  w->trail_ok = true;
+  w->score = NULL;
+  w->flips = 0;
+  w->prng = SLS_DEFAULT_SEED;
+}
+
+void delete_sls_walker(sls_walker_t *w) {
+  delete_ivector(&w->cstart);
+  delete_ivector(&w->lit);
+  safe_free(w->occ_start);
+  safe_free(w->occ);
+  safe_free(w->ntrue);
+  safe_free(w->unsat);
+  safe_free(w->upos);
+  safe_free(w->val);
+  safe_free(w->best);
+  delete_ivector(&w->trail);
+  safe_free(w->score);
+  w->occ_start = NULL;
+  w->occ = NULL;
+  w->ntrue = NULL;
+  w->unsat = NULL;
+  w->upos = NULL;
+  w->val = NULL;
+  w->best = NULL;
+  w->score = NULL;
+}
+
+
+/*
+ * Add clause a[0 ... n-1]
+ */
+void sls_walker_add_clause(sls_walker_t *w, uint32_t n, const int32_t *a) {
+  uint32_t i;
+
+  assert(n > 0 && w->occ == NULL);
+
+  for (i=0; i<n; i++) {
+    assert(0 <= a[i] && a[i] < 2 * w->nvars);
+    ivector_push(&w->lit, a[i]);
+  }
+  ivector_push(&w->cstart, w->lit.size);
+  w->nclauses ++;
+  if (n > w->max_len) {
+    w->max_len = n;
+  }
+}
+
+
+
+/*
+ * OCCURRENCE LISTS
+ */
+
+/*
+ * Build the occurrence lists and allocate the arrays indexed by clauses
+ * - this is done once, when the first walk starts
+ */
+static void sls_build_occurrences(sls_walker_t *w) {
+  uint32_t i, j, n, nlits;
+  uint32_t *count;
+  int32_t *a;
+
+  assert(w->occ == NULL);
+
+  nlits = 2 * w->nvars;
+  count = (uint32_t *) safe_malloc((nlits + 1) * sizeof(uint32_t));
+  memset(count, 0, (nlits + 1) * sizeof(uint32_t));
+
+  a = w->lit.data;
+  n = w->lit.size;
+  for (i=0; i<n; i++) {
+    count[a[i]] ++;
+  }
+
+  // convert to end positions: count[l] = end of l's list
+  for (i=1; i<=nlits; i++) {
+    count[i] += count[i-1];
+  }
+
+  w->occ = (uint32_t *) safe_malloc((n + 1) * sizeof(uint32_t));
+  for (i=0; i<w->nclauses; i++) {
+    for (j=w->cstart.data[i]; j<w->cstart.data[i+1]; j++) {
+      count[a[j]] --;
+      w->occ[count[a[j]]] = i;
+    }
+  }
+  // now count[l] = start of l's list
+  w->occ_start = count;
+
+  n = w->nclauses;
+  w->ntrue = (uint32_t *) safe_malloc((n + 1) * sizeof(uint32_t));
+  w->unsat = (uint32_t *) safe_malloc((n + 1) * sizeof(uint32_t));
+  w->upos = (uint32_t *) safe_malloc((n + 1) * sizeof(uint32_t));
+  w->score = (double *) safe_malloc((w->max_len + 1) * sizeof(double));
+}
+
+
+/*
+ * PROBABILITY TABLE
+ */
+
+/*
+ * The probability of picking a variable of break count b is
+ * proportional to cb^(-b). The base cb depends on the average
+ * clause length. These values are for uniform random k-SAT from
+ * Balint and Schoening's ProbSAT paper, k=3 to 7.
+ */
+static const double sls_cb_values[5] = {
+  2.5, 2.85, 3.7, 5.1, 7.4,
+};
+
+static double sls_base(const sls_walker_t *w) {
+  double avg, d;
+  uint32_t k;
+
+  if (w->nclauses == 0) return sls_cb_values[0];
+
+  avg = ((double) w->lit.size) / w->nclauses;
+  if (avg <= 3.0) return sls_cb_values[0];
+  if (avg >= 7.0) return sls_cb_values[4];
+
+  // linear interpolation between avg's neighbors
+  k = (uint32_t) avg;
+  d = avg - k;
+  return sls_cb_values[k-3] + d * (sls_cb_values[k-2] - sls_cb_values[k-3]);
+}
+
+static void sls_init_prob(sls_walker_t *w) {
+  double cb;
+  uint32_t i;
+
+  cb = sls_base(w);
+  w->prob[0] = 1.0;
+  for (i=1; i<SLS_MAX_BREAK; i++) {
+    w->prob[i] = w->prob[i-1]/cb;
+  }
+}
+
+
+
+/*
+ * SEARCH STATE
+ */
+
+// value of literal l in the current assignment (0 or 1)
+static inline uint32_t sls_lit_value(const sls_walker_t *w, int32_t l) {
+  return w->val[l >> 1] ^ (l & 1);
+}
+
+static inline void sls_add_unsat(sls_walker_t *w, uint32_t c) {
+  w->upos[c] = w->nunsat;
+  w->unsat[w->nunsat] = c;
+  w->nunsat ++;
+}
+
+static inline void sls_remove_unsat(sls_walker_t *w, uint32_t c) {
+  uint32_t i, d;
+
+  assert(w->nunsat > 0 && w->unsat[w->upos[c]] == c);
+
+  w->nunsat --;
+  i = w->upos[c];
+  d = w->unsat[w->nunsat];
+  w->unsat[i] = d;
+  w->upos[d] = i;
+}
+
+/*
+ * Compute ntrue and unsat for the current assignment
+ */
+static void sls_init_state(sls_walker_t *w) {
+  uint32_t i, j, k;
+  int32_t *a;
+
+  a = w->lit.data;
+  w->nunsat = 0;
+  for (i=0; i<w->nclauses; i++) {
+    k = 0;
+    for (j=w->cstart.data[i]; j<w->cstart.data[i+1]; j++) {
+      k += sls_lit_value(w, a[j]);
+    }
+    w->ntrue[i] = k;
+    if (k == 0) {
+      sls_add_unsat(w, i);
+    }
+  }
+}
+
+
+/*
+ * Number of clauses that become false if l becomes false
+ * - l must be true
+ */
+static uint32_t sls_break_count(const sls_walker_t *w, int32_t l) {
+  uint32_t i, n, b;
+
+  assert(sls_lit_value(w, l) == 1);
+
+  b = 0;
+  n = w->occ_start[l+1];
+  for (i=w->occ_start[l]; i<n; i++) {
+    b += (w->ntrue[w->occ[i]] == 1);
+  }
+  return b;
+}
+
+/*
+ * Flip variable x
+ */
+static void sls_flip(sls_walker_t *w, uint32_t x) {
+  uint32_t i, n, c;
+  int32_t t, f;
+
+  t = (x << 1) | (w->val[x] ^ 1); // literal of x that's true
+  f = t ^ 1;                      // literal of x that's false
+
+  n = w->occ_start[t+1];
+  for (i=w->occ_start[t]; i<n; i++) {
+    c = w->occ[i];
+    assert(w->ntrue[c] > 0);
+    w->ntrue[c] --;
+    if (w->ntrue[c] == 0) {
+      sls_add_unsat(w, c);
+    }
+  }
+
+  n = w->occ_start[f+1];
+  for (i=w->occ_start[f]; i<n; i++) {
+    c = w->occ[i];
+    w->ntrue[c] ++;
+    if (w->ntrue[c] == 1) {
+      sls_remove_unsat(w, c);
+    }
+  }
+
+  w->val[x] ^= 1;
+  w->flips ++;
+}
+
+/*
+ * Pick a variable to flip in clause c (which must be false)
+ */
+static uint32_t sls_pick_var(sls_walker_t *w, uint32_t c) {
+  uint32_t i, n, b;
+  int32_t *a;
+  double sum, r;
+
+  assert(w->ntrue[c] == 0);
+
+  a = w->lit.data + w->cstart.data[c];
+  n = w->cstart.data[c+1] - w->cstart.data[c];
+  assert(n > 0);
+
+  sum = 0.0;
+  for (i=0; i<n; i++) {
+    b = sls_break_count(w, a[i] ^ 1);
+    if (b >= SLS_MAX_BREAK) b = SLS_MAX_BREAK - 1;
+    w->score[i] = w->prob[b];
+    sum += w->score[i];
+  }
+
+  r = sum * sls_random_fraction(w);
+  for (i=0; i<n-1; i++) {
+    r -= w->score[i];
+    if (r < 0.0) break;
+  }
+
+  return (uint32_t) (a[i] >> 1);
+}
+
+
+/*
+ * Save the current assignment as the best one
+ * - if trail_ok is true, best differs from val only on the variables in trail
+ */
+static void sls_save_best(sls_walker_t *w) {
+  uint32_t i, x;
+
+  if (w->trail_ok) {
+    for (i=0; i<w->trail.size; i++) {
+      x = w->trail.data[i];
+      w->best[x] = w->val[x];
+    }
+  } else {
+    memcpy(w->best, w->val, w->nvars * sizeof(uint8_t));
+    w->trail_ok = true;
+  }
+  ivector_reset(&w->trail);
+  w->best_unsat = w->nunsat;
+}
+
+/*
+ * Record that x was flipped
+ * - we give up on the trail when it gets longer than nvars
+ */
+static void sls_push_trail(sls_walker_t *w, uint32_t x) {
+  if (w->trail_ok) {
+    if (w->trail.size < w->nvars) {
+      ivector_push(&w->trail, x);
+    } else {
+      ivector_reset(&w->trail);
+      w->trail_ok = false;
+    }
+  }
+}
+
+
+
+/*
+ * WALK
+ */
+uint32_t sls_walk(sls_walker_t *w, uint64_t max_flips) {
+  uint32_t c, x;
+
+  if (w->occ == NULL) {
+    sls_build_occurrences(w);
+  }
+  sls_init_prob(w);
+  sls_init_state(w);
+
+  memcpy(w->best, w->val, w->nvars * sizeof(uint8_t));
+  w->best_unsat = w->nunsat;
+  ivector_reset(&w->trail);
+  w->trail_ok = true;
+  w->flips = 0;
+
+  while (w->nunsat > 0 && w->flips < max_flips) {
+    c = w->unsat[sls_random_uint(w, w->nunsat)];
+    x = sls_pick_var(w, c);
+    sls_flip(w, x);
+    sls_push_trail(w, x);
+    if (w->nunsat < w->best_unsat) {
+      sls_save_best(w);
+    }
+  }
+
+  return w->best_unsat;
+}
@@ -0,0 +1,172 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * STOCHASTIC LOCAL SEARCH ON CLAUSES (PROBSAT)
+ *
+ * This is used by the CDCL solvers to initialize or reset their saved
+ * phases. A walk starts from the current phases and searches for an
+ * assignment that satisfies all the clauses, using the ProbSAT
+ * heuristic:
+ * - pick a random false clause C
+ * - flip a variable of C, chosen randomly with probability proportional
+ *   to cb^(-break(x)), where break(x) is the number of clauses that
+ *   become false if x is flipped.
+ * The walk stops when all clauses are true or after a given number
+ * of flips. The best assignment seen (i.e., the one that falsifies the
+ * fewest clauses) is kept in the walker.
+ *
+ * Literals use the same encoding as the CDCL solvers: the positive
+ * literal of variable x is 2x and the negative literal is 2x+1.
+ *
+ * Usage:
+ * - init_sls_walker(w, nvars)
+ * - add the clauses: sls_walker_add_clause(w, n, a). The caller
+ *   must remove literals that are known to be false and skip clauses
+ *   that are known to be true.
+ * - set the initial assignment: sls_walker_set_value(w, x, v)
+ * - call sls_walk(w, max_flips)
+ * - read the best assignment: sls_walker_best_value(w, x)
+ * - delete_sls_walker(w)
+ */
+
+#ifndef __SLS_WALKER_H
+#define __SLS_WALKER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+
+#include "utils/int_vectors.h"
+
+
+/*
+ * Maximal break count in the probability table:
+ * variables with a larger break count get the same probability as
+ * SLS_MAX_BREAK - 1.
+ */
+#define SLS_MAX_BREAK 64
+
+/*
+ * Walker:
+ * - nvars = number of variables
+ * - nclauses = number of clauses
+ * - clauses are stored in vector lit: clause i is
+ *   lit[cstart[i] ... cstart[i+1] - 1]
+ * - max_len = length of the largest clause
+ * - occ_start/occ = occurrence lists: the clauses that contain
+ *   literal l are occ[occ_start[l] ... occ_start[l+1] - 1]
+ * - ntrue[i] = number of true literals in clause i
+ * - unsat = array of false clauses, nunsat = its size
+ * - upos[i] = position of clause i in unsat (if clause i is false)
+ * - val[x] = current value of x (0 or 1)
+ * - best[x] = value of x in the best assignment
+ * - best_unsat = number of false clauses in the best assignment
+ * - trail = variables flipped since best was last updated
+ *   (if trail_ok is false, the trail is too large and best must
+ *    be copied from val on the next update)
+ * - score = buffer to store the probabilities of a clause's literals
+ * - prob = probability table
+ * - flips = number of flips in the last walk
+ * - prng = state of the pseudo-random number generator
+ */
+typedef struct sls_walker_s {
+  uint32_t nvars;
+  uint32_t nclauses;
+  ivector_t cstart;
+  ivector_t lit;
+  uint32_t max_len;
+  uint32_t *occ_start;
+  uint32_t *occ;
+  uint32_t *ntrue;
+  uint32_t *unsat;
+  uint32_t *upos;
+  uint32_t nunsat;
+  uint8_t *val;
+  uint8_t *best;
+  uint32_t best_unsat;
+  ivector_t trail;
+  bool trail_ok;
+  double *score;
+  double prob[SLS_MAX_BREAK];
+  uint64_t flips;
+  uint32_t prng;
+} sls_walker_t;
+
+#define SLS_DEFAULT_SEED 0x7a2bc381
+
+
+/*
+ * Initialize walker w for variables 0 ... nvars - 1
+ * - there are no clauses and all variables are false
+ */
+extern void init_sls_walker(sls_walker_t *w, uint32_t nvars);
+
+/*
+ * Delete w
+ */
+extern void delete_sls_walker(sls_walker_t *w);
+
+/*
+ * Add clause a[0 ... n-1]
+ * - n must be positive
+ * - all literals must be between 0 and 2 * nvars - 1
+ */
+extern void sls_walker_add_clause(sls_walker_t *w, uint32_t n, const int32_t *a);
+
+/*
+ * Run the local search from the current assignment
+ * - max_flips = bound on the number of flips
+ * - return the number of clauses that are false in the best assignment
+ *   (0 means that a model was found).
+ */
+extern uint32_t sls_walk(sls_walker_t *w, uint64_t max_flips);
+
+
+/*
+ * Initial value of variable x: v must be 0 (false) or 1 (true)
+ */
+static inline void sls_walker_set_value(sls_walker_t *w, uint32_t x, uint8_t v) {
+  assert(x < w->nvars && v <= 1);
+  w->val[x] = v;
+}
+
+/*
+ * Value of x in the best assignment (0 or 1)
+ */
+static inline uint8_t sls_walker_best_value(const sls_walker_t *w, uint32_t x) {
+  assert(x < w->nvars);
+  return w->best[x];
+}
+
+/*
+ * Number of clauses
+ */
+static inline uint32_t sls_walker_num_clauses(const sls_walker_t *w) {
+  return w->nclauses;
+}
+
+/*
+ * Seed for the pseudo-random number generator
+ */
+static inline void sls_walker_set_seed(sls_walker_t *w, uint32_t seed) {
+  w->prng = seed;
+}
+
+
+#endif /* __SLS_WALKER_H */
@@ -23,11 +23,15 @@
 #include <assert.h>
 #include <stddef.h>
 #include <float.h>
+#include <string.h>
 
 #include "solvers/cdcl/smt_core.h"
+#include "solvers/cdcl/sls_walker.h"
 #include "utils/gcd.h"
 #include "utils/int_array_sort.h"
+#include "utils/int_array_sort2.h"
 #include "utils/memalloc.h"
+#include "utils/ptr_vectors.h"
 
 
 #define TRACE 0
@@ -195,14 +199,16 @@ static uint32_t clause_length(clause_t *cl) {
  * Allocate and initialize a new clause (not a learned clause)
  * \param len = number of literals
  * \param lit = array of len literals
+ * \param level = base level of the clause
  * The watched pointers are not initialized
  */
-static clause_t *new_clause(uint32_t len, literal_t *lit) {
+static clause_t *new_clause(uint32_t len, literal_t *lit, uint32_t level) {
   clause_t *result;
   uint32_t i;
 
   result = (clause_t *) safe_malloc(sizeof(clause_t) + sizeof(literal_t) +
                                     len * sizeof(literal_t));
+  result->level = level;
 
   for (i=0; i<len; i++) {
     result->cl[i] = lit[i];
@@ -224,10 +230,11 @@ static inline void delete_clause(clause_t *cl) {
  * Allocate and initialize a new learned clause
  * \param len = number of literals
  * \param lit = array of len literals
+ * \param level = highest base level the clause depends on
  * The watched pointers are not initialized.
  * The activity is initialized to 0.0
  */
-static clause_t *new_learned_clause(uint32_t len, literal_t *lit) {
+static clause_t *new_learned_clause(uint32_t len, literal_t *lit, uint32_t level) {
   learned_clause_t *tmp;
   clause_t *result;
   uint32_t i;
@@ -236,6 +243,7 @@ static clause_t *new_learned_clause(uint32_t len, literal_t *lit) {
                                          len * sizeof(literal_t));
   tmp->activity = 0.0;
   result = &(tmp->clause);
+  result->level = level;
 
   for (i=0; i<len; i++) {
     result->cl[i] = lit[i];
@@ -812,9 +820,11 @@ static void init_trail_stack(trail_stack_t *stack) {
  * - p = number of (non-unit and non-binary) problem clauses
  * - b_ptr = boolean propagation pointer
  * - t_ptr = theory propagation pointer
+ * - lu = size of the learned_units vector
+ * - lb = size of the learned_binaries vector
  */
 static void trail_stack_save(trail_stack_t *stack, uint32_t v, uint32_t u, uint32_t b, uint32_t p,
-                             uint32_t b_ptr, uint32_t t_ptr) {
+                             uint32_t b_ptr, uint32_t t_ptr, uint32_t lu, uint32_t lb) {
   uint32_t i, n;
 
   i = stack->top;
@@ -837,6 +847,8 @@ static void trail_stack_save(trail_stack_t *stack, uint32_t v, uint32_t u, uint3
   stack->data[i].nclauses = p;
   stack->data[i].prop_ptr = b_ptr;
   stack->data[i].theory_ptr = t_ptr;
+  stack->data[i].nlunits = lu;
+  stack->data[i].nlbins = lb;
 
   stack->top = i + 1;
 }
@@ -1257,6 +1269,115 @@ static inline void reset_checkpoint_stack(checkpoint_stack_t *stack) {
 
 
 
+/***************************
+ *  ELIMINATION STACK      *
+ **************************/
+
+/*
+ * Initialize: empty stack, no eliminated variables
+ */
+static void init_elim_stack(elim_stack_t *e) {
+  init_ivector(&e->data, 0);
+  init_ivector(&e->order, 0);
+  init_ivector(&e->assigned, 0);
+  init_ivector(&e->aux, 0);
+  e->start = NULL;
+  e->elim = NULL;
+  e->nvars = 0;
+  e->num_elim = 0;
+}
+
+/*
+ * Allocate the variable-indexed arrays for n variables
+ * - all variables are marked as not eliminated
+ */
+static void elim_stack_alloc_vars(elim_stack_t *e, uint32_t n) {
+  assert(e->start == NULL && e->elim == NULL);
+  e->start = (uint32_t *) safe_malloc(n * sizeof(uint32_t));
+  e->elim = (uint8_t *) safe_malloc(n * sizeof(uint8_t));
+  memset(e->elim, 0, n * sizeof(uint8_t));
+  e->nvars = n;
+}
+
+/*
+ * Delete
+ */
+static void delete_elim_stack(elim_stack_t *e) {
+  delete_ivector(&e->data);
+  delete_ivector(&e->order);
+  delete_ivector(&e->assigned);
+  delete_ivector(&e->aux);
+  safe_free(e->start);
+  safe_free(e->elim);
+  e->start = NULL;
+  e->elim = NULL;
+}
+
+/*
+ * Reset: remove everything
+ */
+static void reset_elim_stack(elim_stack_t *e) {
+  ivector_reset(&e->data);
+  ivector_reset(&e->order);
+  ivector_reset(&e->assigned);
+  ivector_reset(&e->aux);
+  safe_free(e->start);
+  safe_free(e->elim);
+  e->start = NULL;
+  e->elim = NULL;
+  e->nvars = 0;
+  e->num_elim = 0;
+}
+
+/*
+ * Start a block for variable x
+ * - return the index of the block header
+ */
+static uint32_t elim_stack_open_block(elim_stack_t *e, bvar_t x) {
+  uint32_t i;
+
+  assert(0 <= x && x < e->nvars && !e->elim[x]);
+
+  i = e->data.size;
+  ivector_push(&e->data, 0); // header: fixed in elim_stack_close_block
+  e->start[x] = i;
+  return i;
+}
+
+/*
+ * Add clause a[0 ... n-1] to the current block
+ */
+static void elim_stack_save_clause(elim_stack_t *e, uint32_t n, const literal_t *a) {
+  uint32_t i;
+
+  ivector_push(&e->data, n);
+  for (i=0; i<n; i++) {
+    ivector_push(&e->data, a[i]);
+  }
+}
+
+/*
+ * Close the block for x: i = index returned by open_block
+ * - mark x as eliminated
+ */
+static void elim_stack_close_block(elim_stack_t *e, bvar_t x, uint32_t i) {
+  assert(e->start[x] == i && i < e->data.size);
+
+  e->data.data[i] = e->data.size - i - 1;
+  e->elim[x] = 1;
+  e->num_elim ++;
+  ivector_push(&e->order, x);
+}
+
+/*
+ * Restore the eliminated variables that occur in a[0 ... n-1]
+ * (defined after the clause-addition functions)
+ */
+static void restore_eliminated_vars(smt_core_t *s, uint32_t n, const literal_t *a);
+
+
+
+
 
 
 /************************
@@ -1268,6 +1389,8 @@ static inline void reset_checkpoint_stack(checkpoint_stack_t *stack) {
  * Initialize a statistics record
  */
 static void init_statistics(dpll_stats_t *stat) {
+  uint32_t i;
+
   stat->restarts = 0;
   stat->simplify_calls = 0;
   stat->reduce_calls = 0;
@@ -1276,6 +1399,7 @@ static void init_statistics(dpll_stats_t *stat) {
   stat->random_decisions = 0;
   stat->propagations = 0;
   stat->conflicts = 0;
+  stat->chrono_backtracks = 0;
   stat->th_props = 0;
   stat->th_prop_lemmas = 0;
   stat->th_conflicts = 0;
@@ -1287,6 +1411,14 @@ static void init_statistics(dpll_stats_t *stat) {
   stat->bin_clauses_deleted = 0;
   stat->literals_before_simpl = 0;
   stat->subsumed_literals = 0;
+  stat->pp_subsumed = 0;
+  stat->pp_strengthened = 0;
+  stat->pp_subst_vars = 0;
+  stat->pp_elim_vars = 0;
+  stat->pp_restored_vars = 0;
+  for (i=0; i<NUM_CORE_TIMERS; i++) {
+    reset_cycle_timer(stat->timer + i);
+  }
 }
 
 
@@ -1517,6 +1649,17 @@ void init_smt_core(smt_core_t *s, uint32_t n, void *th,
   s->th_cache_enabled = false;
   s->th_cache_cl_size = 0;
 
+  // chronological backtracking: disabled initially
+  s->chrono_enabled = false;
+  s->chrono_threshold = 0;
+
+  // local search: disabled initially
+  s->sls_flips = 0;
+
+  // preprocessing: disabled initially
+  s->preprocess = false;
+  s->preprocessed = false;
+
   // conflict data: no need to initialize conflict_buffer
   s->inconsistent = false;
   s->theory_conflict = false;
@@ -1532,6 +1675,8 @@ void init_smt_core(smt_core_t *s, uint32_t n, void *th,
   s->problem_clauses = new_clause_vector(DEF_CLAUSE_VECTOR_SIZE);
   s->learned_clauses = new_clause_vector(DEF_CLAUSE_VECTOR_SIZE);
   init_ivector(&s->binary_clauses, 0);
+  init_ivector(&s->learned_units, 0);
+  init_ivector(&s->learned_binaries, 0);
 
 
   /*
@@ -1545,6 +1690,7 @@ void init_smt_core(smt_core_t *s, uint32_t n, void *th,
   s->antecedent = (antecedent_t *) safe_malloc(n * sizeof(antecedent_t));
   s->level = (uint32_t *) safe_malloc((n + 1) * sizeof(uint32_t)) + 1;
   s->mark = allocate_bitvector(n);
+  s->dlevel = (uint32_t *) safe_malloc(n * sizeof(uint32_t));
   s->level[-1] = UINT32_MAX;
   s->value[-1] = VAL_UNDEF_FALSE;
 
@@ -1553,12 +1699,14 @@ void init_smt_core(smt_core_t *s, uint32_t n, void *th,
    */
   s->bin = (literal_t **) safe_malloc(lsize * sizeof(literal_t *));
   s->watch = (link_t *) safe_malloc(lsize * sizeof(link_t));
+  s->blevel = (uint32_t *) safe_malloc(lsize * sizeof(uint32_t));
 
   /*
    * Initialize data structures for true_literal and false_literal
    */
   assert(const_bvar == 0 && true_literal == 0 && false_literal == 1 && s->nvars > 0);
   s->level[const_bvar] = 0;
+  s->dlevel[const_bvar] = 0;
   s->value[const_bvar] = VAL_TRUE;
   set_bit(s->mark, const_bvar);
   assert(literal_value(s, true_literal) == VAL_TRUE &&
@@ -1568,15 +1716,22 @@ void init_smt_core(smt_core_t *s, uint32_t n, void *th,
   s->bin[false_literal] = NULL;
   s->watch[true_literal] = NULL_LINK;
   s->watch[false_literal] = NULL_LINK;
+  s->blevel[true_literal] = 0;
+  s->blevel[false_literal] = 0;
 
   init_stack(&s->stack, n);
   init_heap(&s->heap, n);
   init_lemma_queue(&s->lemmas);
   init_statistics(&s->stats);
+  init_event_trace(&s->etrace, 0);
+  s->level_stamp = NULL;
+  s->level_stamp_size = 0;
+  s->lbd_stamp = 0;
   init_atom_table(&s->atoms);
   init_trail_stack(&s->trail_stack);
   init_checkpoint_stack(&s->checkpoints);
   s->cp_flag = false;
+  init_elim_stack(&s->elim);
 
   s->etable = NULL;
   s->trace = NULL;
@@ -1623,12 +1778,15 @@ void delete_smt_core(smt_core_t *s) {
   delete_clause_vector(cl);
 
   delete_ivector(&s->binary_clauses);
+  delete_ivector(&s->learned_units);
+  delete_ivector(&s->learned_binaries);
 
   // var-indexed arrays
   safe_free(s->value - 1);
   safe_free(s->antecedent);
   safe_free(s->level - 1);
   delete_bitvector(s->mark);
+  safe_free(s->dlevel);
 
   // literal-indexed arrays
   n = s->nlits;
@@ -1637,13 +1795,18 @@ void delete_smt_core(smt_core_t *s) {
   }
   safe_free(s->bin);
   safe_free(s->watch);
+  safe_free(s->blevel);
 
   delete_stack(&s->stack);
   delete_heap(&s->heap);
   delete_lemma_queue(&s->lemmas);
+  delete_event_trace(&s->etrace);
+  safe_free(s->level_stamp);
+  s->level_stamp = NULL;
   delete_atom_table(&s->atoms);
   delete_trail_stack(&s->trail_stack);
   delete_checkpoint_stack(&s->checkpoints);
+  delete_elim_stack(&s->elim);
 
   // EXPERIMENTAL
   //  delete_etable(s);
@@ -1677,6 +1840,8 @@ void reset_smt_core(smt_core_t *s) {
   reset_clause_vector(cl);
 
   ivector_reset(&s->binary_clauses);
+  ivector_reset(&s->learned_units);
+  ivector_reset(&s->learned_binaries);
 
   // delete binary-watched literal vectors
   n = s->nlits;
@@ -1688,10 +1853,13 @@ void reset_smt_core(smt_core_t *s) {
   reset_heap(&s->heap);
   reset_lemma_queue(&s->lemmas);
   reset_statistics(&s->stats);
+  reset_event_trace(&s->etrace);
   reset_atom_table(&s->atoms);
   reset_trail_stack(&s->trail_stack);
   reset_checkpoint_stack(&s->checkpoints);
   s->cp_flag = false;
+  reset_elim_stack(&s->elim);
+  s->preprocessed = false;
 
   // reset all counters
   s->nvars = 1;
@@ -1748,9 +1916,11 @@ static void extend_smt_core(smt_core_t *s, uint32_t n) {
   s->antecedent = (antecedent_t *) safe_realloc(s->antecedent, n * sizeof(antecedent_t));
   s->level = (uint32_t *) safe_realloc(s->level - 1, (n + 1) * sizeof(uint32_t)) + 1;
   s->mark = extend_bitvector(s->mark, n);
+  s->dlevel = (uint32_t *) safe_realloc(s->dlevel, n * sizeof(uint32_t));
 
   s->bin = (literal_t **) safe_realloc(s->bin, lsize * sizeof(literal_t *));
   s->watch = (link_t *) safe_realloc(s->watch, lsize * sizeof(link_t));
+  s->blevel = (uint32_t *) safe_realloc(s->blevel, lsize * sizeof(uint32_t));
 
   extend_heap(&s->heap, n);
   extend_stack(&s->stack, n);
@@ -1808,6 +1978,7 @@ void smt_core_set_trace(smt_core_t *s, tracer_t *tracer) {
  * Initialize all arrays for a new variable x
  * - antecedent[x] = NULL
  * - level[x] = UINT32_MAX
+ * - dlevel[x] = 0
  * - mark[x] = 0
  * - value[x] = VAL_UNDEF_FALSE (negative polarity preferred)
  * - activity[x] = 0 (in heap)
@@ -1815,6 +1986,7 @@ void smt_core_set_trace(smt_core_t *s, tracer_t *tracer) {
  * For l=pos_lit(x) and neg_lit(x):
  * - bin[l] = NULL
  * - watch[l] = NULL
+ * - blevel[l] = 0
  */
 static void init_variable(smt_core_t *s, bvar_t x) {
   literal_t l0, l1;
@@ -1823,6 +1995,7 @@ static void init_variable(smt_core_t *s, bvar_t x) {
   s->value[x] = VAL_UNDEF_FALSE;
   s->antecedent[x] = mk_literal_antecedent(null_literal);
   s->level[x] = UINT32_MAX;
+  s->dlevel[x] = 0;
 
   // HACK for testing initial order
   //  assert(s->heap.heap_index[x] < 0);
@@ -1842,6 +2015,8 @@ static void init_variable(smt_core_t *s, bvar_t x) {
   s->bin[l1] = NULL;
   s->watch[l0] = NULL_LINK;
   s->watch[l1] = NULL_LINK;
+  s->blevel[l0] = 0;
+  s->blevel[l1] = 0;
 }
 
 /*
@@ -1901,6 +2076,12 @@ void add_boolean_variables(smt_core_t *s, uint32_t n) {
  */
 void attach_atom_to_bvar(smt_core_t *s, bvar_t x, void *atom) {
   atom_table_t *tbl;
+  literal_t l;
+
+  if (bvar_is_eliminated(s, x)) {
+    l = pos_lit(x);
+    restore_eliminated_vars(s, 1, &l);
+  }
 
   tbl = &s->atoms;
   if (tbl->size <= x) {
@@ -1971,6 +2152,67 @@ void set_bvar_activity(smt_core_t *s, bvar_t x, double a) {
  *  VARIABLE ASSIGNMENTS  *
  *************************/
 
+/*
+ * Upper bound on the level of binary clause {l1, l2}
+ * - blevel[l] may be larger than the base level after pop
+ *   so we also bound the result by the base level.
+ */
+static inline uint32_t binary_clause_level(smt_core_t *s, literal_t l1, literal_t l2) {
+  uint32_t k1, k2;
+
+  k1 = s->blevel[l1];
+  k2 = s->blevel[l2];
+  if (k2 < k1) k1 = k2;
+  return (k1 < s->base_level) ? k1 : s->base_level;
+}
+
+/*
+ * Dependency level of a literal l implied at the base level
+ * - a = antecedent of l
+ * - all the other literals in a are false at the base level
+ */
+static uint32_t antecedent_dlevel(smt_core_t *s, literal_t l, antecedent_t a) {
+  literal_t *c;
+  literal_t l1;
+  uint32_t i, k, q;
+
+  switch (antecedent_tag(a)) {
+  case clause0_tag:
+  case clause1_tag:
+    k = clause_antecedent(a)->level;
+    c = clause_antecedent(a)->cl;
+    i = 0;
+    l1 = c[0];
+    while (l1 >= 0) {
+      if (l1 != l) {
+        q = s->dlevel[var_of(l1)];
+        if (q > k) k = q;
+      }
+      i ++;
+      l1 = c[i];
+    }
+    break;
+
+  case literal_tag:
+    l1 = literal_antecedent(a);
+    assert(l1 >= 0);
+    k = binary_clause_level(s, l, l1);
+    q = s->dlevel[var_of(l1)];
+    if (q > k) k = q;
+    break;
+
+  default:
+    // theory propagation
+    k = s->base_level;
+    break;
+  }
+
+  assert(k <= s->base_level);
+
+  return k;
+}
+
+
 /*
  * Assign literal l at the base level
  */
@@ -1992,6 +2234,7 @@ static void assign_literal(smt_core_t *s, literal_t l) {
   v = var_of(l);
   s->value[v] = (VAL_TRUE ^ sign_of_lit(l));
   s->level[v] = s->base_level;
+  s->dlevel[v] = s->base_level;
   s->antecedent[v] = mk_literal_antecedent(null_literal);
   set_bit(s->mark, v); // assigned at (or below) base_level
 
@@ -2043,18 +2286,22 @@ void decide_literal(smt_core_t *s, literal_t l) {
 
 
 /*
- * Assign literal l to true with the given antecedent
- * - s->mark[v] is set if decision level = base level
+ * Assign literal l to true with the given antecedent and level k
+ * - k must be either the current decision level or a level
+ *   between base_level + 1 and the decision level (if l is assigned
+ *   out of order, when chronological backtracking is enabled).
+ * - s->mark[v] is set if k = base level
  */
-static void implied_literal(smt_core_t *s, literal_t l, antecedent_t a) {
+static void implied_literal_at_level(smt_core_t *s, literal_t l, antecedent_t a, uint32_t k) {
   bvar_t v;
 
   assert(literal_is_unassigned(s, l));
+  assert(k == s->decision_level || (s->base_level < k && k < s->decision_level));
 
 #if TRACE
   printf("---> DPLL:   Implied literal ");
   print_literal(stdout, l);
-  printf(", decision level = %"PRIu32"\n", s->decision_level);
+  printf(", level = %"PRIu32", decision level = %"PRIu32"\n", k, s->decision_level);
   fflush(stdout);
 #endif
 
@@ -2064,16 +2311,24 @@ static void implied_literal(smt_core_t *s, literal_t l, antecedent_t a) {
 
   v = var_of(l);
   s->value[v] = (VAL_TRUE ^ sign_of_lit(l));
-  s->level[v] = s->decision_level;
+  s->level[v] = k;
   s->antecedent[v] = a;
-  if (s->decision_level == s->base_level) {
+  if (k == s->base_level) {
     set_bit(s->mark, v);
     s->nb_unit_clauses ++;
+    s->dlevel[v] = antecedent_dlevel(s, l, a);
   }
 
   assert(literal_value(s, l) == VAL_TRUE && literal_value(s, not(l)) == VAL_FALSE);
 }
 
+/*
+ * Assign literal l to true with the given antecedent at the current decision level
+ */
+static inline void implied_literal(smt_core_t *s, literal_t l, antecedent_t a) {
+  implied_literal_at_level(s, l, a, s->decision_level);
+}
+
 
 void propagate_literal(smt_core_t *s, literal_t l, void *expl) {
   bvar_t v;
@@ -2100,6 +2355,7 @@ void propagate_literal(smt_core_t *s, literal_t l, void *expl) {
   if (s->decision_level == s->base_level) {
     set_bit(s->mark, v);
     s->nb_unit_clauses ++;
+    s->dlevel[v] = s->base_level;
   }
 
   assert(literal_value(s, l) == VAL_TRUE && literal_value(s, not(l)) == VAL_FALSE);
@@ -2131,7 +2387,7 @@ literal_t select_unassigned_literal(smt_core_t *s) {
     if (rnd < s->scaled_random) {
       x = random_uint(s, s->nvars);
       assert(0 <= x && x < s->nvars);
-      if (bval_is_undef(v[x])) {
+      if (bval_is_undef(v[x]) && !bvar_is_eliminated(s, x)) {
 #if TRACE
 	printf("---> DPLL:   Random selection: variable ");
 	print_bvar(stdout, x);
@@ -2203,7 +2459,7 @@ bvar_t select_random_bvar(smt_core_t *s) {
   x = random_uint(s, n); // 0 ... n-1
   assert(0 <= x && x < n);
 
-  if (bval_is_undef(v[x])) return x;
+  if (bval_is_undef(v[x]) && !bvar_is_eliminated(s, x)) return x;
 
   if (all_variables_assigned(s)) return null_bvar;
 
@@ -2217,7 +2473,7 @@ bvar_t select_random_bvar(smt_core_t *s) {
     y += d;
     if (y > n) y -= n;
     assert(x != y); // don't loop
-  } while (bval_is_def(v[y]));
+  } while (bval_is_def(v[y]) || bvar_is_eliminated(s, y));
 
   return y;
 }
@@ -2300,13 +2556,17 @@ static void increase_clause_activity(smt_core_t *s, clause_t *cl) {
 /*
  * Backtrack core to decision level back_level
  * - undo all literal assignments of level >= back_level + 1
+ * - literals assigned out of order (i.e., after the start of level
+ *   back_level + 1 but with a level <= back_level) are kept. They are
+ *   moved down the stack, and they will be propagated again (to both
+ *   the clauses and the theory solver).
  * - requires decision_level > back_level >= base_level
  * Also clear conflict data and sets cp_flag if deletion of atoms is enabled
  *
  * NOTE: this function does not force the theory solver to backtrack.
  */
 static void backtrack(smt_core_t *s, uint32_t back_level) {
-  uint32_t i, k;
+  uint32_t i, j, k, n, kept;
   literal_t *u, l;
   bvar_t x;
 
@@ -2319,25 +2579,45 @@ static void backtrack(smt_core_t *s, uint32_t back_level) {
 
   u = s->stack.lit;
   k = s->stack.level_index[back_level + 1];
-  i = s->stack.top;
+  n = s->stack.top;
+  kept = 0;
+  i = n;
   while (i > k) {
     i --;
     l = u[i];
 
     assert(literal_value(s, l) == VAL_TRUE);
-    assert(s->level[var_of(l)] > back_level);
 
-    // clear assignment of x, keep polarity bit
     x = var_of(l);
-    s->value[x] &= 1;
-    heap_insert(&s->heap, x);
+    if (s->level[x] <= back_level) {
+      // l was assigned out of order: keep it
+      kept ++;
+    } else {
+      // clear assignment of x, keep polarity bit
+      s->value[x] &= 1;
+      heap_insert(&s->heap, x);
+
+      assert(literal_value(s, l) == VAL_UNDEF_TRUE);
+    }
+  }
 
-    assert(literal_value(s, l) == VAL_UNDEF_TRUE);
+  if (kept > 0) {
+    // move the kept literals down, preserving their order
+    j = k;
+    for (i=k; i<n; i++) {
+      l = u[i];
+      if (literal_value(s, l) == VAL_TRUE) {
+        u[j] = l;
+        j ++;
+      }
+    }
+    assert(j == k + kept);
+    i = j;
   }
 
   s->stack.top = i;
-  s->stack.prop_ptr = i;
-  s->stack.theory_ptr = i;
+  s->stack.prop_ptr = k;
+  s->stack.theory_ptr = k;
   s->decision_level = back_level;
 
   // Update the cp_flag: the deletion of atoms is enabled if there's a checkpoint
@@ -2348,13 +2628,24 @@ static void backtrack(smt_core_t *s, uint32_t back_level) {
 
 
 
+/*
+ * Call the theory solver's backtrack function
+ */
+static void theory_backtrack(smt_core_t *s, uint32_t back_level) {
+  uint64_t start;
+
+  start = timer_start();
+  s->th_ctrl.backtrack(s->th_solver, back_level);
+  timer_stop(s->stats.timer + CORE_TIMER_BACKTRACK, start);
+}
+
 /*
  * Cause both s and the theory solver to backtrack
  */
 static void backtrack_to_level(smt_core_t *s, uint32_t back_level) {
   if (back_level < s->decision_level) {
     backtrack(s, back_level);
-    s->th_ctrl.backtrack(s->th_solver, back_level);
+    theory_backtrack(s, back_level);
   }
 }
 
@@ -2507,6 +2798,49 @@ static inline bval_t lit_val(uint8_t *v, literal_t l) {
   return v[var_of(l)] ^ sign_of_lit(l);
 }
 
+/*
+ * Level of a literal implied by boolean propagation when chronological
+ * backtracking is enabled:
+ * - k = highest level of the false literals in the clause
+ * - the result is clamped to [base_level + 1, decision_level] so that
+ *   literals assigned out of order are never mistaken for base-level
+ *   literals.
+ */
+static uint32_t chrono_level(smt_core_t *s, uint32_t k) {
+  if (k <= s->base_level) {
+    k = s->base_level + 1;
+  }
+  if (k > s->decision_level) {
+    k = s->decision_level;
+  }
+  return k;
+}
+
+/*
+ * Highest level of the literals in clause cl, except cl->cl[i]
+ * - all literals of cl other than cl->cl[i] must be false
+ */
+static uint32_t clause_implied_level(smt_core_t *s, clause_t *cl, uint32_t i) {
+  literal_t *c, l;
+  uint32_t j, k, q;
+
+  c = cl->cl;
+  k = 0;
+  j = 0;
+  l = c[0];
+  while (l >= 0) {
+    if (j != i) {
+      assert(literal_value(s, l) == VAL_FALSE);
+      q = s->level[var_of(l)];
+      if (q > k) k = q;
+    }
+    j ++;
+    l = c[j];
+  }
+
+  return k;
+}
+
 /*
  * Propagation via binary clauses:
  * - val = literal value array (must be s->value)
@@ -2534,7 +2868,11 @@ static bool propagation_via_bin_vector(smt_core_t *s, uint8_t *val, literal_t l0
     if (l1 < 0) break; // end_marker
 
     if (bval_is_undef(v1)) {
-      implied_literal(s, l1, mk_literal_antecedent(l0));
+      if (s->chrono_enabled) {
+        implied_literal_at_level(s, l1, mk_literal_antecedent(l0), chrono_level(s, s->level[var_of(l0)]));
+      } else {
+        implied_literal(s, l1, mk_literal_antecedent(l0));
+      }
     } else {
       record_binary_conflict(s, l0, l1);
       return false;
@@ -2613,7 +2951,12 @@ static bool propagation_via_watched_list(smt_core_t *s, uint8_t *val, literal_t
          */
 	if (bval_is_undef(v1)) {
           // l1 is implied
-          implied_literal(s, l1, mk_clause_antecedent(cl, i^1));
+          if (s->chrono_enabled) {
+            implied_literal_at_level(s, l1, mk_clause_antecedent(cl, i^1),
+                                     chrono_level(s, clause_implied_level(s, cl, i^1)));
+          } else {
+            implied_literal(s, l1, mk_clause_antecedent(cl, i^1));
+          }
 
           // move to the next clause
           *list = link;
@@ -2666,7 +3009,10 @@ static bool boolean_propagation(smt_core_t *s) {
   s->stack.prop_ptr = i;
 
 #if DEBUG
-  check_propagation(s);
+  // with chronological backtracking, some implications may be missed
+  if (! s->chrono_enabled) {
+    check_propagation(s);
+  }
 #endif
 
   return true;
@@ -2684,12 +3030,14 @@ static bool boolean_propagation(smt_core_t *s) {
  * - return false otherwise
  */
 static bool theory_propagation(smt_core_t *s) {
+  uint64_t start;
   uint32_t i, n;
   byte_t *has_atom;
   void **atom;
   literal_t *queue;
   literal_t l;
   bvar_t x;
+  bool code;
 
   /*
    * IMPORTANT: make sure the theory_solver does not
@@ -2700,6 +3048,7 @@ static bool theory_propagation(smt_core_t *s) {
   atom = s->atoms.atom;
   queue = s->stack.lit;
 
+  start = timer_start();
   for (i = s->stack.theory_ptr; i < s->stack.top; i++) {
     l = queue[i];
     x = var_of(l);
@@ -2712,6 +3061,7 @@ static bool theory_propagation(smt_core_t *s) {
          * rather than create a theory conflict.
          */
         assert(s->inconsistent);
+        timer_stop(s->stats.timer + CORE_TIMER_PROPAGATE, start);
         return false;
       }
     }
@@ -2726,7 +3076,10 @@ static bool theory_propagation(smt_core_t *s) {
    * s->inconsistent to true.  So we must check for s->inconsistent
    * here.
    */
-  return s->th_ctrl.propagate(s->th_solver) && !s->inconsistent;
+  code = s->th_ctrl.propagate(s->th_solver) && !s->inconsistent;
+  timer_stop(s->stats.timer + CORE_TIMER_PROPAGATE, start);
+
+  return code;
 }
 
 
@@ -2741,17 +3094,28 @@ static bool theory_propagation(smt_core_t *s) {
  * - return false if a conflict is detected
  * - return true otherwise
  */
+static bool timed_boolean_propagation(smt_core_t *s) {
+  uint64_t start;
+  bool code;
+
+  start = timer_start();
+  code = boolean_propagation(s);
+  timer_stop(s->stats.timer + CORE_TIMER_BCP, start);
+
+  return code;
+}
+
 static bool smt_propagation(smt_core_t *s) {
   bool code;
   uint32_t n;
 
   if (s->bool_only) {
     // purely boolean problem
-    return boolean_propagation(s);
+    return timed_boolean_propagation(s);
   }
 
   do {
-    code = boolean_propagation(s);
+    code = timed_boolean_propagation(s);
     if (! code) break;
     n = s->stack.top;
     code = theory_propagation(s);
@@ -2819,9 +3183,10 @@ static inline uint32_t d_level(smt_core_t *s, literal_t l) {
 /*
  * Auxiliary function: add { l1, l2} as a binary clause
  * - l1 and l2 must be distinct (and not complementary)
+ * - k = level of the clause (no more than the base level)
  * - we put the function here because it's used by add_learned_clause
  */
-static void direct_binary_clause(smt_core_t *s, literal_t l1, literal_t l2) {
+static void direct_binary_clause(smt_core_t *s, literal_t l1, literal_t l2, uint32_t k) {
 #if TRACE
   printf("---> DPLL:   Add binary clause: { ");
   print_literal(stdout, l1);
@@ -2840,6 +3205,27 @@ static void direct_binary_clause(smt_core_t *s, literal_t l1, literal_t l2) {
     ivector_push(&s->binary_clauses, l1);
     ivector_push(&s->binary_clauses, l2);
   }
+
+  assert(k <= s->base_level);
+  if (s->blevel[l1] < k) s->blevel[l1] = k;
+  if (s->blevel[l2] < k) s->blevel[l2] = k;
+}
+
+
+/*
+ * Check whether we should backtrack chronologically after a conflict
+ * - k = assertion level of the learned clause
+ * - return true if chronological backtracking is enabled and
+ *   backjumping to k would skip more than chrono_threshold levels
+ */
+static bool use_chrono_backtrack(smt_core_t *s, uint32_t k) {
+  assert(s->base_level < k && k < s->decision_level);
+
+  if (s->chrono_enabled && s->decision_level - k > s->chrono_threshold) {
+    s->stats.chrono_backtracks ++;
+    return true;
+  }
+  return false;
 }
 
 
@@ -2851,8 +3237,14 @@ static void direct_binary_clause(smt_core_t *s, literal_t l1, literal_t l2) {
  *   a lower assignment level than a[0].
  * - backtrack to the decision_level where a[0] is implied, then
  *   add a[0] to the propagation queue
- */
-static void add_learned_clause(smt_core_t *s, uint32_t n, literal_t *a) {
+ * - if chronological backtracking is used, we backtrack by one level
+ *   only and a[0] is assigned out of order at the level where it's implied.
+ * - lvl = level of the clause (highest base level it depends on)
+ * - if lvl < base level, learned units and binary clauses are
+ *   recorded in learned_units/learned_binaries so that they can be
+ *   restored on pop.
+ */
+static void add_learned_clause(smt_core_t *s, uint32_t n, literal_t *a, uint32_t lvl) {
   clause_t *cl;
   uint32_t i, j, k, q;
   literal_t l0, l1;
@@ -2887,6 +3279,11 @@ static void add_learned_clause(smt_core_t *s, uint32_t n, literal_t *a) {
 #endif
       assign_literal(s, l0);
       s->nb_unit_clauses ++;
+      s->dlevel[var_of(l0)] = lvl;
+      if (lvl < s->base_level) {
+        ivector_push(&s->learned_units, l0);
+        ivector_push(&s->learned_units, lvl);
+      }
     }
 
   } else if (n == 2) {
@@ -2895,9 +3292,19 @@ static void add_learned_clause(smt_core_t *s, uint32_t n, literal_t *a) {
     k = s->level[var_of(l1)];
     assert(k < s->level[var_of(l0)]);
 
-    direct_binary_clause(s, l0, l1);
-    backtrack_to_level(s, k);
-    implied_literal(s, l0, mk_literal_antecedent(l1));
+    direct_binary_clause(s, l0, l1, lvl);
+    if (lvl < s->base_level) {
+      ivector_push(&s->learned_binaries, l0);
+      ivector_push(&s->learned_binaries, l1);
+      ivector_push(&s->learned_binaries, lvl);
+    }
+    if (use_chrono_backtrack(s, k)) {
+      backtrack_to_level(s, s->decision_level - 1);
+      implied_literal_at_level(s, l0, mk_literal_antecedent(l1), k);
+    } else {
+      backtrack_to_level(s, k);
+      implied_literal(s, l0, mk_literal_antecedent(l1));
+    }
 
   } else {
 
@@ -2921,7 +3328,7 @@ static void add_learned_clause(smt_core_t *s, uint32_t n, literal_t *a) {
     l1 = a[j]; a[j] = a[1]; a[1] = l1;
 
     // create the new clause with l0 and l1 as watched literals
-    cl = new_learned_clause(n, a);
+    cl = new_learned_clause(n, a, lvl);
     add_clause_to_vector(&s->learned_clauses, cl);
     increase_clause_activity(s, cl);
 
@@ -2934,9 +3341,13 @@ static void add_learned_clause(smt_core_t *s, uint32_t n, literal_t *a) {
 
     // backtrack and assert l0
     assert(k < s->level[var_of(l0)]);
-    backtrack_to_level(s, k);
-
-    implied_literal(s, l0, mk_clause0_antecedent(cl));
+    if (use_chrono_backtrack(s, k)) {
+      backtrack_to_level(s, s->decision_level - 1);
+      implied_literal_at_level(s, l0, mk_clause0_antecedent(cl), k);
+    } else {
+      backtrack_to_level(s, k);
+      implied_literal(s, l0, mk_clause0_antecedent(cl));
+    }
   }
 }
 
@@ -2958,7 +3369,7 @@ static bool try_cache_theory_clause(smt_core_t *s, uint32_t n, literal_t *a) {
   if (n == 2) {
     // add as binary clause
     if (d_level(s, a[0]) == d && d_level(s, a[1]) == d) {
-      direct_binary_clause(s, a[0], a[1]);
+      direct_binary_clause(s, a[0], a[1], s->base_level);
 
 #if TRACE
       printf("---> DPLL: cached theory clause: { ");
@@ -3014,7 +3425,7 @@ static bool try_cache_theory_clause(smt_core_t *s, uint32_t n, literal_t *a) {
 #endif
 
     // create the new clause with l0 and l1 as watched literals
-    cl = new_learned_clause(n, a);
+    cl = new_learned_clause(n, a, s->base_level);
     add_clause_to_vector(&s->learned_clauses, cl);
     increase_clause_activity(s, cl);
 
@@ -3123,11 +3534,15 @@ static void try_cache_theory_implication(smt_core_t *s, uint32_t n, literal_t *a
  * must be before l in the assignment/propagation stack.
  */
 static void explain_antecedent(smt_core_t *s, literal_t l, antecedent_t a) {
+  uint64_t start;
+
   assert(literal_value(s, l) == VAL_TRUE && a == s->antecedent[var_of(l)] &&
          antecedent_tag(a) == generic_tag);
 
   ivector_reset(&s->explanation);
+  start = timer_start();
   s->th_smt.expand_explanation(s->th_solver, l, generic_antecedent(a), &s->explanation);
+  timer_stop(s->stats.timer + CORE_TIMER_EXPLAIN, start);
 
 #if DEBUG
   check_theory_explanation(s, l);
@@ -3159,6 +3574,18 @@ static inline bool check_level(smt_core_t *s, literal_t l, uint32_t sgn) {
 }
 
 
+/*
+ * Update the dependency level *k for a marked variable x
+ * - if x is assigned at the base level, then its value
+ *   depends on level dlevel[x]
+ */
+static inline void update_dlevel(smt_core_t *s, bvar_t x, uint32_t *k) {
+  if (s->level[x] <= s->base_level && s->dlevel[x] > *k) {
+    *k = s->dlevel[x];
+  }
+}
+
+
 /*
  * Analyze literal antecedents of not(l) to check whether l is subsumed.
  * - sgn = signature of the learned clause
@@ -3169,8 +3596,9 @@ static inline bool check_level(smt_core_t *s, literal_t l, uint32_t sgn) {
  * - returns true otherwise.
  *
  * Unmarked antecedents are marked and pushed into sol->buffer2.
+ * The dependency level of the antecedents is added to *k.
  */
-static bool analyze_antecedents(smt_core_t *s, literal_t l, uint32_t sgn) {
+static bool analyze_antecedents(smt_core_t *s, literal_t l, uint32_t sgn, uint32_t *k) {
   bvar_t x;
   antecedent_t a;
   literal_t l1;
@@ -3188,6 +3616,9 @@ static bool analyze_antecedents(smt_core_t *s, literal_t l, uint32_t sgn) {
   switch (antecedent_tag(a)) {
   case clause0_tag:
   case clause1_tag:
+    if (clause_antecedent(a)->level > *k) {
+      *k = clause_antecedent(a)->level;
+    }
     c = clause_antecedent(a)->cl;
     i = clause_index(a);
     assert(c[i] == not(l));
@@ -3197,6 +3628,8 @@ static bool analyze_antecedents(smt_core_t *s, literal_t l, uint32_t sgn) {
       // l1 has the same decision level as l so there's no need to call check_level
       set_lit_mark(s, l1);
       ivector_push(b, l1);
+    } else {
+      update_dlevel(s, var_of(l1), k);
     }
     // rest of the clause
     i = 2;
@@ -3209,6 +3642,8 @@ static bool analyze_antecedents(smt_core_t *s, literal_t l, uint32_t sgn) {
         } else {
           return false;
         }
+      } else {
+        update_dlevel(s, var_of(l1), k);
       }
       i ++;
       l1 = c[i];
@@ -3217,9 +3652,15 @@ static bool analyze_antecedents(smt_core_t *s, literal_t l, uint32_t sgn) {
 
   case literal_tag:
     l1 = literal_antecedent(a);
+    i = binary_clause_level(s, not(l), l1);
+    if (i > *k) {
+      *k = i;
+    }
     if (is_lit_unmarked(s, l1)) {
       set_lit_mark(s, l1);
       ivector_push(b, l1);
+    } else {
+      update_dlevel(s, var_of(l1), k);
     }
     break;
 
@@ -3229,6 +3670,7 @@ static bool analyze_antecedents(smt_core_t *s, literal_t l, uint32_t sgn) {
      * makes a difference here.
      */
     if (false) {
+      *k = s->base_level;
       explain_antecedent(s, not(l), a);
       c = s->explanation.data;
       // (and c[0] ... c[n-1]) implies (not l)
@@ -3256,20 +3698,24 @@ static bool analyze_antecedents(smt_core_t *s, literal_t l, uint32_t sgn) {
 /*
  * Check whether literal l is subsumed by other marked literals
  * - sgn = signature of the learned clause (in which l occurs)
+ * - if l is subsumed, *lvl is updated to include the dependency level
+ *   of all the antecedents used
  * s->buffer2 is used as a queue
  */
-static bool subsumed(smt_core_t *s, literal_t l, uint32_t sgn) {
-  uint32_t i, n;
+static bool subsumed(smt_core_t *s, literal_t l, uint32_t sgn, uint32_t *lvl) {
+  uint32_t i, n, k;
   ivector_t *b;
 
   b = &s->buffer2;
   n = b->size;
   i = n;
-  while (analyze_antecedents(s, l, sgn)) {
+  k = *lvl;
+  while (analyze_antecedents(s, l, sgn, &k)) {
     if (i < b->size) {
       l = b->data[i];
       i ++;
     } else {
+      *lvl = k;
       return true;
     }
   }
@@ -3288,8 +3734,10 @@ static bool subsumed(smt_core_t *s, literal_t l, uint32_t sgn) {
  * Simplification of a learned clause
  * - the clause is stored in s->buffer as an array of literals
  * - s->buffer[0] is the implied literal
+ * - *lvl = dependency level of the clause: it's updated if
+ *   literals are removed
  */
-static void simplify_learned_clause(smt_core_t *s) {
+static void simplify_learned_clause(smt_core_t *s, uint32_t *lvl) {
   uint32_t hash;
   literal_t *b;
   literal_t l;
@@ -3315,7 +3763,7 @@ static void simplify_learned_clause(smt_core_t *s) {
   j = 1;
   for (i=1; i<n; i++) {
     l = b[i];
-    if (subsumed(s, l, hash)) {
+    if (subsumed(s, l, hash, lvl)) {
       // Hack: move l to buffer2 to clear its mark later
       ivector_push(&s->buffer2, l);
     } else {
@@ -3386,6 +3834,62 @@ static uint32_t get_conflict_level(smt_core_t *s, literal_t *a) {
 
 
 
+/*
+ * Make sure the level_stamp array has room for levels 0 ... s->decision_level
+ * - the new elements are set to 0
+ */
+static void resize_level_stamps(smt_core_t *s) {
+  uint32_t i, n;
+
+  n = s->level_stamp_size;
+  if (n <= s->decision_level) {
+    n += (n >> 1) + 1;
+    if (n <= s->decision_level) {
+      n = s->decision_level + 1;
+    }
+    s->level_stamp = (uint32_t *) safe_realloc(s->level_stamp, n * sizeof(uint32_t));
+    for (i=s->level_stamp_size; i<n; i++) {
+      s->level_stamp[i] = 0;
+    }
+    s->level_stamp_size = n;
+  }
+}
+
+/*
+ * LBD of a learned clause = number of distinct decision levels
+ * among its literals (capped to UINT16_MAX for the event trace)
+ * - n = number of literals
+ * - a = array of n literals (all assigned at levels <= s->decision_level)
+ */
+static uint16_t learned_clause_lbd(smt_core_t *s, uint32_t n, const literal_t *a) {
+  uint32_t i, k, r, stamp;
+
+  resize_level_stamps(s);
+
+  stamp = s->lbd_stamp + 1;
+  if (stamp == 0) {
+    // wrap around: clear all stamps
+    for (i=0; i<s->level_stamp_size; i++) {
+      s->level_stamp[i] = 0;
+    }
+    stamp = 1;
+  }
+  s->lbd_stamp = stamp;
+
+  r = 0;
+  for (i=0; i<n; i++) {
+    k = s->level[var_of(a[i])];
+    assert(k <= s->decision_level);
+    if (s->level_stamp[k] != stamp) {
+      s->level_stamp[k] = stamp;
+      r ++;
+    }
+  }
+
+  return r < UINT16_MAX ? r : UINT16_MAX;
+}
+
+
 /*
  * Search for first UIP and build the learned clause
  * d = solver state
@@ -3408,12 +3912,14 @@ do {                                          \
     } else {                                  \
       unresolved ++;                          \
     }                                         \
+  } else {                                    \
+    update_dlevel(s, x, &lvl);                \
   }                                           \
 } while(0)
 
 
 static void resolve_conflict(smt_core_t *s) {
-  uint32_t i, j, conflict_level, unresolved;
+  uint32_t i, j, k, conflict_level, unresolved, lvl;
   literal_t l, b;
   bvar_t x;
   literal_t *c,  *stack;
@@ -3422,7 +3928,8 @@ static void resolve_conflict(smt_core_t *s) {
   ivector_t *buffer;
 
   assert(s->inconsistent);
-  assert(s->theory_conflict || get_conflict_level(s, s->conflict) == s->decision_level);
+  assert(s->theory_conflict || s->chrono_enabled ||
+         get_conflict_level(s, s->conflict) == s->decision_level);
 
   s->stats.conflicts ++;
 
@@ -3431,7 +3938,8 @@ static void resolve_conflict(smt_core_t *s) {
 
   /*
    * adjust conflict_level and backtrack to that level if the conflict
-   * was reported by the theory solver.
+   * was reported by the theory solver, or if literals may have been
+   * assigned out of order (chronological backtracking).
    */
   if (s->theory_conflict) {
     conflict_level = get_conflict_level(s, c);
@@ -3443,6 +3951,11 @@ static void resolve_conflict(smt_core_t *s) {
     if (s->th_cache_enabled) {
       try_cache_theory_conflict(s, s->th_conflict_size, c);
     }
+  } else if (s->chrono_enabled) {
+    conflict_level = get_conflict_level(s, c);
+    assert(s->base_level <= conflict_level && conflict_level <= s->decision_level);
+    backtrack_to_level(s, conflict_level);
+    assert(s->decision_level == conflict_level);
   }
 
   if (conflict_level == s->base_level) {
@@ -3450,6 +3963,20 @@ static void resolve_conflict(smt_core_t *s) {
     return;
   }
 
+  /*
+   * lvl = dependency level of the learned clause:
+   * initialized to the level of the conflict clause
+   */
+  if (s->theory_conflict) {
+    lvl = s->base_level;
+  } else if (c == s->conflict_buffer) {
+    assert(c[0] >= 0 && c[1] >= 0 && c[2] < 0);
+    lvl = binary_clause_level(s, c[0], c[1]);
+  } else {
+    assert(s->false_clause != NULL && c == s->false_clause->cl);
+    lvl = s->false_clause->level;
+  }
+
 #if DEBUG
   check_marks(s);
 #endif
@@ -3493,14 +4020,16 @@ static void resolve_conflict(smt_core_t *s) {
    * antecedent of all marked literals:
    * - all the literals processed have decision_level == conflict_level
    * - the code works if unresolved == 1 (which may happen for theory conflicts)
+   * - literals of lower levels may occur on the stack if they were
+   *   assigned out of order: they are skipped
    */
   stack = s->stack.lit;
   j = s->stack.top;
   for (;;) {
     j --;
     b = stack[j];
-    assert(d_level(s, b) == conflict_level);
-    if (is_lit_marked(s, b)) {
+    assert(s->chrono_enabled || d_level(s, b) == conflict_level);
+    if (is_lit_marked(s, b) && d_level(s, b) == conflict_level) {
       if (unresolved == 1) {
         // not b is the implied literal; we're done.
         buffer->data[0] = not(b);
@@ -3520,6 +4049,7 @@ static void resolve_conflict(smt_core_t *s) {
           i = clause_index(a);
           c = cl->cl;
           assert(c[i] == b);
+          if (cl->level > lvl) lvl = cl->level;
           // process other watched literal
           l = c[i^1];
           process_literal(l);
@@ -3538,10 +4068,13 @@ static void resolve_conflict(smt_core_t *s) {
 
         case literal_tag:
           l = literal_antecedent(a);
+          k = binary_clause_level(s, b, l);
+          if (k > lvl) lvl = k;
           process_literal(l);
           break;
 
         case generic_tag:
+          lvl = s->base_level;
           explain_antecedent(s, b, a);
           c = s->explanation.data;
           // explanation is c[0] ... c[n-1] where ((and c[0] ... c[n-1]) implies b)
@@ -3571,7 +4104,7 @@ static void resolve_conflict(smt_core_t *s) {
   /*
    * Simplify the learned clause and clear the marks
    */
-  simplify_learned_clause(s);
+  simplify_learned_clause(s, &lvl);
 
 #if DEBUG
   check_marks(s);
@@ -3583,11 +4116,13 @@ static void resolve_conflict(smt_core_t *s) {
   s->inconsistent = false;
   s->theory_conflict = false;
 
+  smt_log_event(s, ETRACE_CONFLICT, 0, learned_clause_lbd(s, s->buffer.size, s->buffer.data), s->buffer.size);
+
   /*
    * Add the learned clause: this causes backtracking
    * and assert the implied literal
    */
-  add_learned_clause(s, s->buffer.size, s->buffer.data);
+  add_learned_clause(s, s->buffer.size, s->buffer.data, lvl);
 }
 
 
@@ -3665,7 +4200,7 @@ static clause_t *new_problem_clause(smt_core_t *s, uint32_t n, literal_t *a) {
   fflush(stdout);
 #endif
 
-  cl = new_clause(n, a);
+  cl = new_clause(n, a, s->base_level);
   add_clause_to_vector(&s->problem_clauses, cl);
 
   // add cl at the start of watch lists
@@ -3712,7 +4247,7 @@ static void add_simplified_binary_clause(smt_core_t *s, literal_t l0, literal_t
   uint32_t k0, k1;
   bval_t v0, v1;
 
-  direct_binary_clause(s, l0, l1); // add the clause
+  direct_binary_clause(s, l0, l1, s->base_level); // add the clause
 
   if (s->base_level == s->decision_level) {
     assert(literal_is_unassigned(s, l0) && literal_is_unassigned(s, l1));
@@ -3992,6 +4527,10 @@ void add_empty_clause(smt_core_t *s) {
  * Add a unit clause
  */
 void add_unit_clause(smt_core_t *s, literal_t l) {
+  if (s->elim.num_elim > 0) {
+    restore_eliminated_vars(s, 1, &l);
+  }
+
   if (on_the_fly(s) && s->decision_level > s->base_level) {
 #if DEBUG
     check_lemma(s, 1, &l);
@@ -4032,6 +4571,10 @@ void add_unit_clause(smt_core_t *s, literal_t l) {
  * - this modifies array a
  */
 void add_clause_unsafe(smt_core_t *s, uint32_t n, literal_t *a) {
+  if (s->elim.num_elim > 0) {
+    restore_eliminated_vars(s, n, a);
+  }
+
   if (on_the_fly(s)) {
 #if DEBUG
     check_lemma(s, n, a);
@@ -4046,7 +4589,7 @@ void add_clause_unsafe(smt_core_t *s, uint32_t n, literal_t *a) {
       new_problem_clause(s, n, a);
     } else if (n == 2) {
       //      add_simplified_binary_clause(s, a[0], a[1]);
-      direct_binary_clause(s, a[0], a[1]);
+      direct_binary_clause(s, a[0], a[1], s->base_level);
     } else if (n == 1) {
       add_simplified_unit_clause(s, a[0]);
     } else {
@@ -4068,6 +4611,10 @@ void add_clause_unsafe(smt_core_t *s, uint32_t n, literal_t *a) {
 void add_clause(smt_core_t *s, uint32_t n, literal_t *a) {
   ivector_t *v;
 
+  if (s->elim.num_elim > 0) {
+    restore_eliminated_vars(s, n, a);
+  }
+
   if (on_the_fly(s)) {
 #if DEBUG
     check_lemma(s, n, a);
@@ -4090,7 +4637,7 @@ void add_clause(smt_core_t *s, uint32_t n, literal_t *a) {
       new_problem_clause(s, n, a);
     } else if (n == 2) {
       //      add_simplified_binary_clause(s, a[0], a[1]);
-      direct_binary_clause(s, a[0], a[1]);
+      direct_binary_clause(s, a[0], a[1], s->base_level);
     } else if (n == 1) {
       add_simplified_unit_clause(s, a[0]);
     } else {
@@ -4131,43 +4678,201 @@ void add_ternary_clause(smt_core_t *s, literal_t l1, literal_t l2, literal_t l3)
 
 
 
-
-/********************************
- *  DEAL WITH THE LEMMA QUEUE   *
- *******************************/
+/**************************************
+ *  RESTORE/EXTEND ELIMINATED VARIABLES *
+ *************************************/
 
 /*
- * Find the length of a lemma a:
- * - a must be terminated by null_literal (or any negative end marker)
+ * Add x to vector v if x is eliminated and clear its elim flag
  */
-static uint32_t lemma_length(literal_t *a) {
-  uint32_t n;
-
-  n = 0;
-  while (*a >= 0) {
-    a ++;
-    n ++;
+static void collect_var_to_restore(smt_core_t *s, ivector_t *v, bvar_t x) {
+  if (bvar_is_eliminated(s, x)) {
+    s->elim.elim[x] = 0;
+    s->elim.num_elim --;
+    ivector_push(v, x);
   }
-  return n;
 }
 
-
 /*
- * Add lemma: similar to add_clause but does more work
- * - n = length of the lemma
- * - a = array of literals (lemma is a[0] ... a[n-1])
+ * Restore all the eliminated variables that occur in a[0 ... n-1]:
+ * - a variable x is restored by adding back the clauses saved in its block
+ * - these clauses may contain other eliminated variables (eliminated
+ *   after x) so we restore them too.
+ * - all the variables to restore are collected first, so that the
+ *   calls to add_clause below don't restore anything.
+ * - if this is called during the search, the clauses are added to the
+ *   lemma queue (as any clause added on the fly).
  */
-static void add_lemma(smt_core_t *s, uint32_t n, literal_t *a) {
-  if (preprocess_clause(s, &n, a)) {
-    if (n > 2) {
-      add_simplified_clause(s, n, a);
-    } else if (n == 2) {
-      add_simplified_binary_clause(s, a[0], a[1]);
-    } else if (n == 1) {
-      add_simplified_unit_clause(s, a[0]);
-    } else {
-      backtrack_to_base_level(s);
-      record_empty_conflict(s);
+static void restore_eliminated_vars(smt_core_t *s, uint32_t n, const literal_t *a) {
+  elim_stack_t *e;
+  ivector_t *v;
+  int32_t *d;
+  uint32_t i, j, k, end;
+  bvar_t x;
+
+  for (i=0; i<n; i++) {
+    if (bvar_is_eliminated(s, var_of(a[i]))) break;
+  }
+  if (i == n) return;
+
+  e = &s->elim;
+  v = &e->aux;
+  assert(v->size == 0);
+
+  for (i=0; i<n; i++) {
+    collect_var_to_restore(s, v, var_of(a[i]));
+  }
+
+  // close v under the 'occurs in a saved clause' relation
+  d = e->data.data;
+  for (i=0; i<v->size; i++) {
+    x = v->data[i];
+    j = e->start[x];
+    end = j + d[j] + 1;
+    j ++;
+    while (j < end) {
+      k = d[j];
+      for (j++; k>0; k--, j++) {
+        collect_var_to_restore(s, v, var_of(d[j]));
+      }
+    }
+  }
+
+  // add the saved clauses
+  for (i=0; i<v->size; i++) {
+    x = v->data[i];
+    assert(bvar_is_unassigned(s, x));
+    heap_insert(&s->heap, x);
+    j = e->start[x];
+    end = j + d[j] + 1;
+    j ++;
+    while (j < end) {
+      k = d[j];
+      add_clause(s, k, d + j + 1);
+      j += k + 1;
+    }
+  }
+
+  s->stats.pp_restored_vars += v->size;
+  ivector_reset(v);
+}
+
+
+/*
+ * Extend the current assignment to the eliminated variables
+ * - this is called when the search returns SAT: all other variables
+ *   are assigned.
+ * - the variables are processed in reverse order of elimination.
+ *   For x, we check whether one of its saved clauses is of the form
+ *   (C \/ x) with C false. If so x := true, otherwise x := false.
+ * - the variables are not pushed on the stack, they are stored in
+ *   vector assigned so that smt_clear can unassign them.
+ */
+static void extend_assignment(smt_core_t *s) {
+  elim_stack_t *e;
+  int32_t *d;
+  uint32_t i, j, k, end;
+  literal_t l;
+  bvar_t x;
+  bval_t v;
+  bool false_clause;
+
+  e = &s->elim;
+  d = e->data.data;
+  i = e->order.size;
+  while (i > 0) {
+    i --;
+    x = e->order.data[i];
+    if (! e->elim[x]) continue; // restored
+
+    v = VAL_FALSE;
+    j = e->start[x];
+    end = j + d[j] + 1;
+    j ++;
+    while (j < end && v == VAL_FALSE) {
+      k = d[j];
+      false_clause = false;
+      if (var_of(d[j+1]) == x && is_pos(d[j+1])) {
+        // the first literal of a saved clause is the eliminated one
+        false_clause = true;
+        for (j += 2, k --; k>0; k--, j++) {
+          l = d[j];
+          assert(literal_is_assigned(s, l));
+          if (literal_value(s, l) != VAL_FALSE) {
+            false_clause = false;
+          }
+        }
+      } else {
+        j += k + 1;
+      }
+      if (false_clause) v = VAL_TRUE;
+    }
+
+    s->value[x] = v;
+    s->level[x] = s->base_level;
+    ivector_push(&e->assigned, x);
+  }
+}
+
+
+/*
+ * Unassign the variables assigned by extend_assignment
+ * - keep their value as preferred polarity
+ */
+static void clear_extended_assignment(smt_core_t *s) {
+  ivector_t *v;
+  uint32_t i;
+  bvar_t x;
+
+  v = &s->elim.assigned;
+  for (i=0; i<v->size; i++) {
+    x = v->data[i];
+    s->value[x] &= 1;
+    assert(bvar_is_unassigned(s, x));
+  }
+  ivector_reset(v);
+}
+
+
+
+
+
+/********************************
+ *  DEAL WITH THE LEMMA QUEUE   *
+ *******************************/
+
+/*
+ * Find the length of a lemma a:
+ * - a must be terminated by null_literal (or any negative end marker)
+ */
+static uint32_t lemma_length(literal_t *a) {
+  uint32_t n;
+
+  n = 0;
+  while (*a >= 0) {
+    a ++;
+    n ++;
+  }
+  return n;
+}
+
+
+/*
+ * Add lemma: similar to add_clause but does more work
+ * - n = length of the lemma
+ * - a = array of literals (lemma is a[0] ... a[n-1])
+ */
+static void add_lemma(smt_core_t *s, uint32_t n, literal_t *a) {
+  if (preprocess_clause(s, &n, a)) {
+    if (n > 2) {
+      add_simplified_clause(s, n, a);
+    } else if (n == 2) {
+      add_simplified_binary_clause(s, a[0], a[1]);
+    } else if (n == 1) {
+      add_simplified_unit_clause(s, a[0]);
+    } else {
+      backtrack_to_base_level(s);
+      record_empty_conflict(s);
     }
   }
 #if TRACE
@@ -4404,6 +5109,7 @@ void reduce_clause_database(smt_core_t *s) {
 
   delete_learned_clauses(s);
   s->stats.reduce_calls ++;
+  smt_log_event(s, ETRACE_REDUCE, 0, 0, get_cv_size(v));
 }
 
 
@@ -4466,6 +5172,30 @@ void remove_irrelevant_learned_clauses(smt_core_t *s) {
 
   delete_learned_clauses(s);
   s->stats.remove_calls ++;
+  smt_log_event(s, ETRACE_REDUCE, 0, 0, get_cv_size(v));
+}
+
+
+/*
+ * Delete all learned clauses that are not locked
+ */
+void purge_learned_clauses(smt_core_t *s) {
+  uint32_t i, n;
+  clause_t **v;
+
+  v = s->learned_clauses;
+  n = get_cv_size(v);
+  if (n == 0) return;
+
+  for (i=0; i<n; i++) {
+    if (! clause_is_locked(s, v[i])) {
+      mark_for_removal(v[i]);
+    }
+  }
+
+  delete_learned_clauses(s);
+  s->stats.reduce_calls ++;
+  smt_log_event(s, ETRACE_REDUCE, 0, 0, get_cv_size(v));
 }
 
 
@@ -4625,12 +5355,15 @@ static void simplify_clause_set(smt_core_t *s) {
     s->nb_prob_clauses = s->aux_clauses;
 
     // mark the true learned clauses
+    // - we keep the clauses of lower level: they may be useful after pop
     s->aux_literals = 0;
     v = s->learned_clauses;
     n = get_cv_size(v);
     for (i=0; i<n; i++) {
       assert(! is_clause_to_be_removed(v[i]));
-      if (! clause_is_locked(s, v[i])) {
+      if (v[i]->level < s->base_level) {
+        s->aux_literals += clause_length(v[i]);
+      } else if (! clause_is_locked(s, v[i])) {
         mark_true_clause(s, v[i]);
       }
     }
@@ -4781,6 +5514,7 @@ static void simplify_clause_database(smt_core_t *s) {
   }
 
   s->stats.simplify_calls ++;
+  smt_log_event(s, ETRACE_SIMPLIFY, 0, 0, get_cv_size(s->problem_clauses));
 
   /*
    * The next call to simplify_clause_database is enabled when
@@ -4841,7 +5575,8 @@ void smt_push(smt_core_t *s) {
   trail_stack_save(&s->trail_stack,
                    s->nvars, s->nb_unit_clauses, s->binary_clauses.size,
                    get_cv_size(s->problem_clauses),
-                   s->stack.prop_ptr, s->stack.theory_ptr);
+                   s->stack.prop_ptr, s->stack.theory_ptr,
+                   s->learned_units.size, s->learned_binaries.size);
 
   /*
    * Notify the theory solver
@@ -4863,17 +5598,37 @@ void smt_push(smt_core_t *s) {
 
 
 /*
- * Mark all learned clauses for removal
+ * Check whether clause cl contains a literal >= max
+ */
+static bool clause_has_dead_literal(clause_t *cl, literal_t max) {
+  literal_t *a;
+
+  a = cl->cl;
+  while (*a >= 0) {
+    if (*a >= max) return true;
+    a ++;
+  }
+  return false;
+}
+
+/*
+ * Mark the learned clauses that depend on the current base level
+ * for removal, and the clauses that contain variables >= nvars.
  */
-static void remove_all_learned_clauses(smt_core_t *s) {
+static void remove_learned_clauses(smt_core_t *s, uint32_t nvars) {
   uint32_t i, n;
   clause_t **v;
+  literal_t max;
 
+  max = pos_lit(nvars);
   v = s->learned_clauses;
   n = get_cv_size(v);
 
   for (i=0; i<n; i++) {
-    mark_for_removal(v[i]);
+    assert(v[i]->level <= s->base_level);
+    if (v[i]->level == s->base_level || clause_has_dead_literal(v[i], max)) {
+      mark_for_removal(v[i]);
+    }
   }
 }
 
@@ -4913,17 +5668,19 @@ static void reset_watch_lists(smt_core_t *s) {
 
 /*
  * Restore all non-binary/non-unit clauses (to previous base-level)
- * Also restore stats.prob_literals
+ * Also restore stats.prob_literals and stats.learned_literals
  * - n = number of problem clauses at the start of the current base level
+ * - nvars = number of variables at the start of the current base level
+ * The learned clauses that don't depend on the current base level are kept.
  */
-static void restore_clauses(smt_core_t *s, uint32_t n) {
-  uint32_t i, m, nlits;
+static void restore_clauses(smt_core_t *s, uint32_t n, uint32_t nvars) {
+  uint32_t i, j, m, nlits;
   clause_t **v;
   clause_t *cl;
   literal_t l;
 
   // mark clauses for removal
-  remove_all_learned_clauses(s);
+  remove_learned_clauses(s, nvars);
   remove_problem_clauses(s, n);
 
   // empty the watch lists
@@ -4932,10 +5689,16 @@ static void restore_clauses(smt_core_t *s, uint32_t n) {
   // do the real deletion
   v = s->learned_clauses;
   m = get_cv_size(v);
+  j = 0;
   for (i=0; i<m; i++) {
-    delete_learned_clause(v[i]);
+    if (is_clause_to_be_removed(v[i])) {
+      delete_learned_clause(v[i]);
+    } else {
+      v[j] = v[i];
+      j ++;
+    }
   }
-  reset_clause_vector(v);
+  set_cv_size(v, j);
 
   v = s->problem_clauses;
   m = get_cv_size(v);
@@ -4964,12 +5727,26 @@ static void restore_clauses(smt_core_t *s, uint32_t n) {
     l = cl->cl[1];
     s->watch[l] = cons(1, cl, s->watch[l]);
   }
+  s->stats.prob_literals = nlits;
+
+  // put the learned clauses back into the watch lists
+  v = s->learned_clauses;
+  m = get_cv_size(v);
+  nlits = 0;
+  for (i=0; i<m; i++) {
+    cl = v[i];
+    nlits += clause_length(cl);
+
+    l = cl->cl[0];
+    s->watch[l] = cons(0, cl, s->watch[l]);
 
+    l = cl->cl[1];
+    s->watch[l] = cons(1, cl, s->watch[l]);
+  }
 
-  s->nb_clauses = n;
+  s->nb_clauses = n + m;
   s->nb_prob_clauses = n;
-  s->stats.prob_literals = nlits;
-  s->stats.learned_literals = 0;
+  s->stats.learned_literals = nlits;
 }
 
 
@@ -4978,7 +5755,7 @@ static void restore_clauses(smt_core_t *s, uint32_t n) {
  * Remove the ones in binary_clauses[n ... ]
  */
 static void restore_binary_clauses(smt_core_t *s, uint32_t n) {
-  uint32_t i;
+  uint32_t i, k;
   literal_t l0, l1;
   literal_t *bin_clauses;
 
@@ -4989,6 +5766,8 @@ static void restore_binary_clauses(smt_core_t *s, uint32_t n) {
   // number of clauses removed = (i - n)/2
   s->nb_bin_clauses -= (i - n)/2;
 
+  // all remaining binary clauses have level < base_level
+  k = s->base_level - 1;
   while (i > n) {
     i --;
     l0 = bin_clauses[i];
@@ -4998,6 +5777,8 @@ static void restore_binary_clauses(smt_core_t *s, uint32_t n) {
     assert(last_lv_elem(s->bin[l0]) == l1 && last_lv_elem(s->bin[l1]) == l0);
     literal_vector_pop(s->bin[l0]);
     literal_vector_pop(s->bin[l1]);
+    if (s->blevel[l0] > k) s->blevel[l0] = k;
+    if (s->blevel[l1] > k) s->blevel[l1] = k;
   }
 
   ivector_shrink(&s->binary_clauses, n);
@@ -5038,6 +5819,75 @@ static void restore_variables(smt_core_t *s, uint32_t n) {
 }
 
 
+/*
+ * Restore the learned binary clauses that don't depend on the
+ * popped level.
+ * - s->learned_binaries[b ... ] = clauses learned at the popped level
+ * - must be called after the base level is decremented and after
+ *   restore_variables
+ * - the clauses of level < base_level are kept in s->learned_binaries
+ *   (since they must be restored again if base_level is popped)
+ */
+static void restore_learned_binary_clauses(smt_core_t *s, uint32_t b) {
+  ivector_t *v;
+  uint32_t i, j, n, k;
+  literal_t l0, l1, max;
+
+  max = pos_lit(s->nvars);
+  v = &s->learned_binaries;
+  n = v->size;
+  j = b;
+  for (i=b; i<n; i += 3) {
+    l0 = v->data[i];
+    l1 = v->data[i+1];
+    k = v->data[i+2];
+    if (k <= s->base_level && l0 < max && l1 < max) {
+      direct_binary_clause(s, l0, l1, k);
+      if (k < s->base_level) {
+        v->data[j] = l0;
+        v->data[j+1] = l1;
+        v->data[j+2] = k;
+        j += 3;
+      }
+    }
+  }
+  ivector_shrink(v, j);
+}
+
+
+/*
+ * Restore the learned unit clauses that don't depend on the popped level
+ * - s->learned_units[u ...] = units learned at the popped level
+ * - must be called after restore_learned_binary_clauses
+ * - literals that are already assigned are skipped
+ */
+static void restore_learned_units(smt_core_t *s, uint32_t u) {
+  ivector_t *v;
+  uint32_t i, j, n, k;
+  literal_t l, max;
+
+  max = pos_lit(s->nvars);
+  v = &s->learned_units;
+  n = v->size;
+  j = u;
+  for (i=u; i<n; i += 2) {
+    l = v->data[i];
+    k = v->data[i+1];
+    if (k <= s->base_level && l < max && literal_is_unassigned(s, l)) {
+      assign_literal(s, l);
+      s->nb_unit_clauses ++;
+      s->dlevel[var_of(l)] = k;
+      if (k < s->base_level) {
+        v->data[j] = l;
+        v->data[j+1] = k;
+        j += 2;
+      }
+    }
+  }
+  ivector_shrink(v, j);
+}
+
+
 /*
  * Remove the mark of all variables assigned at the current base_level
  */
@@ -5080,7 +5930,7 @@ void smt_pop(smt_core_t *s) {
 
   clear_base_level_marks(s);
   top = trail_stack_top(&s->trail_stack);
-  restore_clauses(s, top->nclauses);
+  restore_clauses(s, top->nclauses, top->nvars);
   restore_binary_clauses(s, top->nbins);
 
   s->base_level --;
@@ -5089,6 +5939,10 @@ void smt_pop(smt_core_t *s) {
 
   restore_variables(s, top->nvars);
 
+  // add back the learned units and binary clauses that are still valid
+  restore_learned_binary_clauses(s, top->nlbins);
+  restore_learned_units(s, top->nlunits);
+
   // restore the propagation pointers
   s->stack.prop_ptr = top->prop_ptr;
   s->stack.theory_ptr = top->theory_ptr;
@@ -5122,6 +5976,9 @@ void smt_clear(smt_core_t *s) {
   // Give a chance to the theory solver to cleanup its own state
   s->th_ctrl.clear(s->th_solver);
 
+  // unassign the eliminated variables
+  clear_extended_assignment(s);
+
   /*
    * In clean-interrupt mode, we restore the state to what it was
    * before the search started. This also backtracks to the base_level
@@ -5306,6 +6163,38 @@ static void remove_garbage_bin_clauses(smt_core_t *s, uint32_t old_nvars) {
 
 
 
+/*
+ * Invalidate the learned units and binary clauses that contain
+ * removed variables: their level is set to INT32_MAX so that they're
+ * never restored.
+ * - we can't remove them from the vectors since the trail stack
+ *   stores indices in these vectors.
+ */
+static void remove_garbage_learned_facts(smt_core_t *s) {
+  ivector_t *v;
+  uint32_t i, n;
+  literal_t max;
+
+  max = pos_lit(s->nvars);
+
+  v = &s->learned_units;
+  n = v->size;
+  for (i=0; i<n; i += 2) {
+    if (v->data[i] >= max) {
+      v->data[i+1] = INT32_MAX;
+    }
+  }
+
+  v = &s->learned_binaries;
+  n = v->size;
+  for (i=0; i<n; i += 3) {
+    if (v->data[i] >= max || v->data[i+1] >= max) {
+      v->data[i+2] = INT32_MAX;
+    }
+  }
+}
+
+
 /*
  * Check whether clause cl contains literals >= max
  * If it does, mark it for deletion.
@@ -5424,9 +6313,11 @@ static void delete_irrelevant_variables(smt_core_t *s) {
   }
 
   if (dflag) {
+    smt_log_event(s, ETRACE_GC, 0, 0, old_nvars - s->nvars);
     s->th_smt.end_atom_deletion(s->th_solver);
     remove_garbage_clauses(s);
     remove_garbage_bin_clauses(s, old_nvars);
+    remove_garbage_learned_facts(s);
   }
 }
 
@@ -5539,62 +6430,1225 @@ bool base_propagate(smt_core_t *s) {
   return false;
 }
 
+/*****************************
+ *  BOOLEAN PREPROCESSING    *
+ ****************************/
+
 /*
- * Prepare for the search:
- * - initialize variable heap
- * - set status to searching
- * - if clean_interrupt is enabled, save the current state to
- *   enable cleanup after interrupt (this uses push)
- */
-void start_search(smt_core_t *s) {
-  assert(s->status == STATUS_IDLE && s->decision_level == s->base_level);
+ * Before the first search, the problem clauses (including the binary
+ * clauses) are copied into a separate clause set with occurrence
+ * lists. This set is simplified then copied back into the clause
+ * database. The simplifications are the same as in new_sat_solver:
+ * - equivalent-literal substitution: each strongly connected component
+ *   of the binary implication graph is a class of equivalent literals,
+ *   and all literals in the class are replaced by a representative.
+ * - subsumption and strengthening (self-subsuming resolution).
+ * - bounded variable elimination: x is eliminated if replacing all the
+ *   clauses that contain x by their non-trivial resolvents does not
+ *   increase the number of clauses.
+ * Units found along the way are assigned at level 0.
+ *
+ * Variables attached to atoms are frozen: they are never substituted
+ * or eliminated. The clauses of the other eliminated variables are
+ * saved in s->elim.
+ */
+
+/*
+ * Limits:
+ * - a variable with more than PP_MAX_OCCS positive occurrences and
+ *   more than PP_MAX_OCCS negative occurrences is not eliminated
+ * - a variable is not eliminated if this produces a resolvent with
+ *   more than PP_MAX_RESOLVENT literals
+ * - occurrence lists with more than PP_SUBSUME_SKIP elements are skipped
+ *   in subsumption
+ * - PP_EFFORT bounds the number of literals visited by subsumption and
+ *   by variable elimination
+ */
+#define PP_MAX_OCCS       10
+#define PP_MAX_RESOLVENT  20
+#define PP_SUBSUME_SKIP   3000
+#define PP_EFFORT         20000000
+
+
+/*
+ * Clause in the preprocessor: lit[0 ... len-1]
+ * - the clause is removed if dead is true
+ */
+typedef struct pp_clause_s {
+  uint32_t len;
+  bool dead;
+  literal_t lit[0];
+} pp_clause_t;
+
+/*
+ * Preprocessor state:
+ * - clauses = all clauses (pp_clause_t *)
+ * - occ[l] = vector of clause indices (NULL if empty)
+ *   if clause i contains l then i is in occ[l], but occ[l] may also
+ *   contain dead clauses and clauses from which l was removed.
+ * - mark[l] = literal marks
+ * - frozen[x] = true if x can't be eliminated
+ * - subst[x] = literal equivalent to pos_lit(x) if x is substituted
+ *   (null_literal otherwise)
+ * - units = literals assigned by the preprocessor
+ *   units_ptr = index of the first unit to propagate
+ * - queue = clauses to check for subsumption
+ * - buffer = to build clauses
+ * - effort = work counter
+ * - unsat = true if the empty clause was found
+ */
+typedef struct preprocessor_s {
+  smt_core_t *core;
+  pvector_t clauses;
+  literal_t **occ;
+  uint8_t *mark;
+  uint8_t *frozen;
+  literal_t *subst;
+  ivector_t units;
+  uint32_t units_ptr;
+  ivector_t queue;
+  ivector_t buffer;
+  uint64_t effort;
+  bool unsat;
+} preprocessor_t;
+
+
+/*
+ * Initialize pp for core s: nothing is frozen except the constant
+ * and the variables that have atoms.
+ */
+static void init_preprocessor(preprocessor_t *pp, smt_core_t *s) {
+  uint32_t i, n;
 
-#if TRACE
-  printf("\n---> DPLL START\n");
-  fflush(stdout);
-#endif
+  pp->core = s;
+  init_pvector(&pp->clauses, 0);
 
-  if ((s->option_flag & CLEAN_INTERRUPT_MASK) != 0) {
-    /*
-     * in clean-interrupt mode, save the current state so
-     * that it can be restored after a call to stop_search.
-     */
-    smt_push(s);
+  n = s->nlits;
+  pp->occ = (literal_t **) safe_malloc(n * sizeof(literal_t *));
+  pp->mark = (uint8_t *) safe_malloc(n * sizeof(uint8_t));
+  for (i=0; i<n; i++) {
+    pp->occ[i] = NULL;
+    pp->mark[i] = 0;
   }
 
-  s->status = STATUS_SEARCHING;
-  s->inconsistent = false;
-  s->theory_conflict = false;
-  s->conflict = NULL;
-  s->false_clause = NULL;
+  n = s->nvars;
+  pp->frozen = (uint8_t *) safe_malloc(n * sizeof(uint8_t));
+  pp->subst = (literal_t *) safe_malloc(n * sizeof(literal_t));
+  for (i=0; i<n; i++) {
+    pp->frozen[i] = (i == const_bvar || bvar_has_atom(s, i));
+    pp->subst[i] = null_literal;
+  }
 
-  s->stats.restarts = 0;
-  s->stats.simplify_calls = 0;
-  s->stats.reduce_calls = 0;
-  s->stats.decisions = 0;
-  s->stats.random_decisions = 0;
-  s->stats.conflicts = 0;
-  s->simplify_bottom = 0;
-  s->simplify_props = 0;
-  s->simplify_threshold = 0;
+  init_ivector(&pp->units, 0);
+  pp->units_ptr = 0;
+  init_ivector(&pp->queue, 0);
+  init_ivector(&pp->buffer, 0);
+  pp->effort = 0;
+  pp->unsat = false;
+}
 
-  /*
-   * Allow theory solver to do whatever initializations it needs
-   */
-  s->th_ctrl.start_search(s->th_solver);
+/*
+ * Delete pp
+ */
+static void delete_preprocessor(preprocessor_t *pp) {
+  uint32_t i, n;
 
-#if DEBUG
-  check_heap_content(s);
-  check_heap(s);
-#endif
+  n = pp->clauses.size;
+  for (i=0; i<n; i++) {
+    safe_free(pp->clauses.data[i]);
+  }
+  delete_pvector(&pp->clauses);
+
+  n = pp->core->nlits;
+  for (i=0; i<n; i++) {
+    delete_literal_vector(pp->occ[i]);
+  }
+  safe_free(pp->occ);
+  safe_free(pp->mark);
+  safe_free(pp->frozen);
+  safe_free(pp->subst);
+  delete_ivector(&pp->units);
+  delete_ivector(&pp->queue);
+  delete_ivector(&pp->buffer);
 }
 
 
 /*
- * Stop the search: set status to interrupted
- * - this can be called from a signal handler to interrupt the solver
- * - if clean_interrupt is enabled,  the state at start_search can be restored by
- *   calling smt_cleanup(s)
+ * Clause of index i
+ */
+static inline pp_clause_t *pp_clause(preprocessor_t *pp, uint32_t i) {
+  assert(i < pp->clauses.size);
+  return (pp_clause_t *) pp->clauses.data[i];
+}
+
+/*
+ * Number of elements in occ[l]
+ */
+static inline uint32_t pp_occ_size(preprocessor_t *pp, literal_t l) {
+  return pp->occ[l] == NULL ? 0 : get_lv_size(pp->occ[l]);
+}
+
+/*
+ * Check whether clause c contains l
+ */
+static bool pp_clause_has_literal(pp_clause_t *c, literal_t l) {
+  uint32_t i;
+
+  for (i=0; i<c->len; i++) {
+    if (c->lit[i] == l) return true;
+  }
+  return false;
+}
+
+/*
+ * Remove literal l from clause c (l must occur in c)
+ */
+static void pp_clause_remove_literal(pp_clause_t *c, literal_t l) {
+  uint32_t i;
+
+  for (i=0; c->lit[i] != l; i++) {
+    assert(i+1 < c->len);
+  }
+  c->len --;
+  c->lit[i] = c->lit[c->len];
+}
+
+
+/*
+ * Assign unit literal l at level 0
+ */
+static void pp_add_unit(preprocessor_t *pp, literal_t l) {
+  smt_core_t *s;
+
+  s = pp->core;
+  switch (literal_value(s, l)) {
+  case VAL_FALSE:
+    pp->unsat = true;
+    break;
+
+  case VAL_UNDEF_FALSE:
+  case VAL_UNDEF_TRUE:
+    assign_literal(s, l);
+    ivector_push(&pp->units, l);
+    break;
+
+  case VAL_TRUE:
+    break;
+  }
+}
+
+
+/*
+ * Add clause a[0 ... n-1]
+ * - the clause must be normalized (cf. preprocess_clause)
+ * - the new clause is added to the subsumption queue
+ */
+static void pp_add_clause(preprocessor_t *pp, uint32_t n, const literal_t *a) {
+  pp_clause_t *c;
+  uint32_t i, k;
+
+  if (n == 0) {
+    pp->unsat = true;
+  } else if (n == 1) {
+    pp_add_unit(pp, a[0]);
+  } else {
+    c = (pp_clause_t *) safe_malloc(sizeof(pp_clause_t) + n * sizeof(literal_t));
+    c->len = n;
+    c->dead = false;
+    k = pp->clauses.size;
+    for (i=0; i<n; i++) {
+      c->lit[i] = a[i];
+      add_literal_to_vector(pp->occ + a[i], k);
+    }
+    pvector_push(&pp->clauses, c);
+    ivector_push(&pp->queue, k);
+  }
+}
+
+/*
+ * Normalize then add the clause stored in pp->buffer
+ */
+static void pp_add_buffer_clause(preprocessor_t *pp) {
+  ivector_t *v;
+  uint32_t n;
+
+  v = &pp->buffer;
+  n = v->size;
+  if (preprocess_clause(pp->core, &n, v->data)) {
+    pp_add_clause(pp, n, v->data);
+  }
+  ivector_reset(v);
+}
+
+
+/*
+ * Propagate the units:
+ * - remove the clauses that contain a true literal
+ * - remove the false literals from all other clauses
+ */
+static void pp_propagate_units(preprocessor_t *pp) {
+  pp_clause_t *c;
+  literal_t *w;
+  uint32_t i, n;
+  literal_t l;
+
+  while (pp->units_ptr < pp->units.size && !pp->unsat) {
+    l = pp->units.data[pp->units_ptr];
+    pp->units_ptr ++;
+
+    w = pp->occ[l];
+    n = pp_occ_size(pp, l);
+    for (i=0; i<n; i++) {
+      pp_clause(pp, w[i])->dead = true;
+    }
+
+    w = pp->occ[not(l)];
+    n = pp_occ_size(pp, not(l));
+    for (i=0; i<n; i++) {
+      c = pp_clause(pp, w[i]);
+      if (!c->dead && pp_clause_has_literal(c, not(l))) {
+        pp_clause_remove_literal(c, not(l));
+        if (c->len == 1) {
+          c->dead = true;
+          pp_add_unit(pp, c->lit[0]);
+        } else {
+          ivector_push(&pp->queue, w[i]);
+        }
+      }
+    }
+
+    delete_literal_vector(pp->occ[l]);
+    delete_literal_vector(pp->occ[not(l)]);
+    pp->occ[l] = NULL;
+    pp->occ[not(l)] = NULL;
+  }
+}
+
+
+/*
+ * Copy all problem clauses and binary clauses into pp then
+ * empty the clause database.
+ */
+static void pp_collect_clauses(preprocessor_t *pp) {
+  smt_core_t *s;
+  ivector_t *v;
+  clause_t **cv;
+  literal_t *bin;
+  uint32_t i, n;
+  literal_t l1, l2;
+  bvar_t x;
+
+  s = pp->core;
+  v = &pp->buffer;
+
+  cv = s->problem_clauses;
+  n = get_cv_size(cv);
+  for (i=0; i<n; i++) {
+    if (! is_clause_to_be_removed(cv[i])) {
+      ivector_copy(v, cv[i]->cl, clause_length(cv[i]));
+      pp_add_buffer_clause(pp);
+    }
+    delete_clause(cv[i]);
+  }
+  reset_clause_vector(cv);
+  reset_watch_lists(s);
+
+  n = s->nlits;
+  for (l1=0; l1<n; l1++) {
+    bin = s->bin[l1];
+    if (bin != NULL) {
+      for (;;) {
+        l2 = *bin ++;
+        if (l2 < 0) break;
+        if (l1 < l2) {
+          ivector_push(v, l1);
+          ivector_push(v, l2);
+          pp_add_buffer_clause(pp);
+        }
+      }
+      delete_literal_vector(s->bin[l1]);
+      s->bin[l1] = NULL;
+    }
+  }
+
+  s->nb_clauses = 0;
+  s->nb_prob_clauses = 0;
+  s->nb_bin_clauses = 0;
+  s->stats.prob_literals = 0;
+
+  /*
+   * The antecedents of literals assigned at level 0 may be deleted
+   * clauses. These antecedents are not used, but we reset them to be safe.
+   */
+  for (i=0; i<s->stack.top; i++) {
+    x = var_of(s->stack.lit[i]);
+    if (antecedent_tag(s->antecedent[x]) <= clause1_tag) {
+      s->antecedent[x] = mk_literal_antecedent(null_literal);
+    }
+  }
+}
+
+
+/*
+ * SUBSUMPTION
+ */
+
+/*
+ * Key for subsuming clause c: literal of c with fewest occurrences
+ * of its variable.
+ */
+static literal_t pp_key_literal(preprocessor_t *pp, pp_clause_t *c) {
+  uint32_t i, k, best;
+  literal_t l, key;
+
+  key = c->lit[0];
+  best = pp_occ_size(pp, key) + pp_occ_size(pp, not(key));
+  for (i=1; i<c->len; i++) {
+    l = c->lit[i];
+    k = pp_occ_size(pp, l) + pp_occ_size(pp, not(l));
+    if (k < best) {
+      best = k;
+      key = l;
+    }
+  }
+  return key;
+}
+
+/*
+ * Check whether the marked clause c subsumes or strengthens clause d
+ * - the literals of c are marked in pp->mark
+ * - d is removed if c subsumes it
+ * - if c \/ l and d \/ not(l) where c subsumes d, then
+ *   not(l) is removed from d.
+ */
+static void pp_try_subsume(preprocessor_t *pp, pp_clause_t *c, uint32_t di) {
+  pp_clause_t *d;
+  uint32_t i, k;
+  literal_t l, neg;
+
+  d = pp_clause(pp, di);
+  if (d->dead || d->len < c->len) return;
+
+  pp->effort += d->len;
+  k = 0;
+  neg = null_literal;
+  for (i=0; i<d->len; i++) {
+    l = d->lit[i];
+    if (pp->mark[l]) {
+      k ++;
+    } else if (pp->mark[not(l)]) {
+      if (neg != null_literal) return;
+      neg = l;
+      k ++;
+    }
+  }
+
+  if (k < c->len) return;
+
+  if (neg == null_literal) {
+    d->dead = true;
+    pp->core->stats.pp_subsumed ++;
+  } else {
+    pp_clause_remove_literal(d, neg);
+    pp->core->stats.pp_strengthened ++;
+    if (d->len == 1) {
+      d->dead = true;
+      pp_add_unit(pp, d->lit[0]);
+    } else {
+      ivector_push(&pp->queue, di);
+    }
+  }
+}
+
+/*
+ * Backward subsumption and strengthening from clause ci
+ * - the candidates are the clauses that contain the key literal or its negation
+ */
+static void pp_subsume_from_clause(preprocessor_t *pp, uint32_t ci) {
+  pp_clause_t *c;
+  literal_t *w;
+  uint32_t i, j, n;
+  literal_t key, l;
+
+  c = pp_clause(pp, ci);
+  if (c->dead) return;
+
+  for (i=0; i<c->len; i++) {
+    pp->mark[c->lit[i]] = 1;
+  }
+
+  key = pp_key_literal(pp, c);
+  for (j=0; j<2; j++) {
+    l = (j == 0) ? key : not(key);
+    w = pp->occ[l];
+    n = pp_occ_size(pp, l);
+    if (n <= PP_SUBSUME_SKIP) {
+      for (i=0; i<n; i++) {
+        if (w[i] != ci) {
+          pp_try_subsume(pp, c, w[i]);
+        }
+      }
+    }
+  }
+
+  for (i=0; i<c->len; i++) {
+    pp->mark[c->lit[i]] = 0;
+  }
+}
+
+/*
+ * Process all clauses in the subsumption queue
+ */
+static void pp_subsumption(preprocessor_t *pp) {
+  uint32_t i;
+
+  pp->effort = 0;
+  for (i=0; i<pp->queue.size; i++) {
+    if (pp->unsat || pp->effort > PP_EFFORT) break;
+    pp_subsume_from_clause(pp, pp->queue.data[i]);
+    pp_propagate_units(pp);
+  }
+  ivector_reset(&pp->queue);
+}
+
+
+/*
+ * EQUIVALENT LITERALS
+ */
+
+/*
+ * Next successor of literal u in the binary implication graph
+ * - clause { not(u), v } gives the edge u --> v
+ * - *i = index in occ[not(u)] where to start the search (updated)
+ * - return null_literal if there are no more successors
+ */
+static literal_t pp_next_successor(preprocessor_t *pp, literal_t u, uint32_t *i) {
+  pp_clause_t *c;
+  literal_t *w;
+  uint32_t j, n;
+
+  w = pp->occ[not(u)];
+  n = pp_occ_size(pp, not(u));
+  for (j = *i; j<n; j++) {
+    c = pp_clause(pp, w[j]);
+    if (!c->dead && c->len == 2) {
+      if (c->lit[0] == not(u)) {
+        *i = j+1;
+        return c->lit[1];
+      }
+      if (c->lit[1] == not(u)) {
+        *i = j+1;
+        return c->lit[0];
+      }
+    }
+  }
+  *i = n;
+  return null_literal;
+}
+
+/*
+ * Process a strongly connected component a[0 ... n-1]
+ * - the component of the negated literals is processed too: we
+ *   skip the second of these two components.
+ * - the representative is a frozen literal if possible
+ */
+static void pp_process_scc(preprocessor_t *pp, uint32_t n, const literal_t *a) {
+  uint32_t i;
+  literal_t r, l;
+  bvar_t x;
+
+  if (n == 1) return;
+
+  // check for complementary literals
+  for (i=0; i<n; i++) {
+    pp->mark[a[i]] = 2;
+  }
+  for (i=0; i<n; i++) {
+    if (pp->mark[not(a[i])] == 2) {
+      pp->unsat = true;
+    }
+  }
+  for (i=0; i<n; i++) {
+    pp->mark[a[i]] = 0;
+  }
+  if (pp->unsat) return;
+
+  r = null_literal;
+  for (i=0; i<n; i++) {
+    l = a[i];
+    x = var_of(l);
+    if (!pp->frozen[x] && pp->subst[x] != null_literal) return; // dual component
+    if (r == null_literal || (pp->frozen[x] && !pp->frozen[var_of(r)]) ||
+        (pp->frozen[x] == pp->frozen[var_of(r)] && l < r)) {
+      r = l;
+    }
+  }
+
+  for (i=0; i<n; i++) {
+    l = a[i];
+    x = var_of(l);
+    if (l != r && !pp->frozen[x]) {
+      pp->subst[x] = is_pos(l) ? r : not(r);
+    }
+  }
+}
+
+/*
+ * Compute the strongly connected components (Tarjan's algorithm, iterative version)
+ * - label[l] = visit index of l (-1 if not visited yet)
+ * - low[l] = lowest index reachable from l
+ * - mark[l] = 1 if l is on the Tarjan stack
+ */
+static void pp_compute_sccs(preprocessor_t *pp) {
+  ivector_t tstack, dfs;
+  int32_t *label, *low;
+  uint32_t i, n, k, top, counter;
+  literal_t l0, u, v;
+
+  n = pp->core->nlits;
+  label = (int32_t *) safe_malloc(n * sizeof(int32_t));
+  low = (int32_t *) safe_malloc(n * sizeof(int32_t));
+  for (i=0; i<n; i++) {
+    label[i] = -1;
+  }
+  init_ivector(&tstack, 0);
+  init_ivector(&dfs, 0);
+  counter = 0;
+
+  for (l0=2; l0<n && !pp->unsat; l0++) {
+    if (label[l0] >= 0 || pp_occ_size(pp, not(l0)) == 0) continue;
+
+    label[l0] = counter;
+    low[l0] = counter;
+    counter ++;
+    ivector_push(&tstack, l0);
+    pp->mark[l0] = 1;
+    ivector_push(&dfs, l0);
+    ivector_push(&dfs, 0);
+
+    while (dfs.size > 0) {
+      top = dfs.size - 2;
+      u = dfs.data[top];
+      k = dfs.data[top + 1];
+      v = pp_next_successor(pp, u, &k);
+      dfs.data[top + 1] = k;
+
+      if (v != null_literal) {
+        if (label[v] < 0) {
+          // visit v
+          label[v] = counter;
+          low[v] = counter;
+          counter ++;
+          ivector_push(&tstack, v);
+          pp->mark[v] = 1;
+          ivector_push(&dfs, v);
+          ivector_push(&dfs, 0);
+        } else if (pp->mark[v] && label[v] < low[u]) {
+          low[u] = label[v];
+        }
+
+      } else {
+        // done with u
+        dfs.size = top;
+        if (low[u] == label[u]) {
+          // u is the root of a component: pop it from tstack
+          i = tstack.size;
+          do {
+            i --;
+            pp->mark[tstack.data[i]] = 0;
+          } while (tstack.data[i] != u);
+          pp_process_scc(pp, tstack.size - i, tstack.data + i);
+          tstack.size = i;
+        }
+        if (dfs.size > 0) {
+          v = dfs.data[dfs.size - 2];
+          if (low[u] < low[v]) low[v] = low[u];
+        }
+      }
+    }
+  }
+
+  // cleanup marks (if we exited early)
+  for (i=0; i<tstack.size; i++) {
+    pp->mark[tstack.data[i]] = 0;
+  }
+
+  delete_ivector(&tstack);
+  delete_ivector(&dfs);
+  safe_free(label);
+  safe_free(low);
+}
+
+/*
+ * Rebuild all occurrence lists from scratch
+ */
+static void pp_rebuild_occ_lists(preprocessor_t *pp) {
+  pp_clause_t *c;
+  uint32_t i, j, n;
+
+  n = pp->core->nlits;
+  for (i=0; i<n; i++) {
+    delete_literal_vector(pp->occ[i]);
+    pp->occ[i] = NULL;
+  }
+
+  n = pp->clauses.size;
+  for (i=0; i<n; i++) {
+    c = pp_clause(pp, i);
+    if (!c->dead) {
+      for (j=0; j<c->len; j++) {
+        add_literal_to_vector(pp->occ + c->lit[j], i);
+      }
+    }
+  }
+}
+
+/*
+ * Replace each substituted variable by its representative in all clauses
+ * and save the equivalences x == subst[x] in the elimination stack.
+ */
+static void pp_apply_substitution(preprocessor_t *pp) {
+  smt_core_t *s;
+  pp_clause_t *c;
+  ivector_t *v;
+  uint32_t i, j, n, k;
+  literal_t l, r, a[2];
+  bvar_t x;
+
+  s = pp->core;
+  v = &pp->buffer;
+
+  n = pp->clauses.size;
+  for (i=0; i<n; i++) {
+    c = pp_clause(pp, i);
+    if (c->dead) continue;
+    for (j=0; j<c->len; j++) {
+      l = c->lit[j];
+      r = pp->subst[var_of(l)];
+      ivector_push(v, (r == null_literal) ? l : r ^ sign_of_lit(l));
+    }
+    k = v->size;
+    if (! preprocess_clause(s, &k, v->data)) {
+      c->dead = true; // true clause
+    } else if (k < 2) {
+      c->dead = true;
+      if (k == 0) {
+        pp->unsat = true;
+      } else {
+        pp_add_unit(pp, v->data[0]);
+      }
+    } else {
+      for (j=0; j<k; j++) {
+        c->lit[j] = v->data[j];
+      }
+      c->len = k;
+    }
+    ivector_reset(v);
+  }
+
+  pp_rebuild_occ_lists(pp);
+
+  n = s->nvars;
+  for (x=0; x<n; x++) {
+    r = pp->subst[x];
+    if (r != null_literal) {
+      // save x == r as (x \/ not(r)) and (not(x) \/ r)
+      k = elim_stack_open_block(&s->elim, x);
+      a[0] = pos_lit(x);
+      a[1] = not(r);
+      elim_stack_save_clause(&s->elim, 2, a);
+      a[0] = neg_lit(x);
+      a[1] = r;
+      elim_stack_save_clause(&s->elim, 2, a);
+      elim_stack_close_block(&s->elim, x, k);
+      s->stats.pp_subst_vars ++;
+    }
+  }
+}
+
+/*
+ * Substitution of equivalent literals
+ */
+static void pp_equivalences(preprocessor_t *pp) {
+  uint32_t i, n;
+
+  pp_compute_sccs(pp);
+  if (pp->unsat) return;
+
+  n = pp->core->nvars;
+  for (i=0; i<n; i++) {
+    if (pp->subst[i] != null_literal) break;
+  }
+  if (i < n) {
+    pp_apply_substitution(pp);
+    pp_propagate_units(pp);
+  }
+}
+
+
+/*
+ * VARIABLE ELIMINATION
+ */
+
+/*
+ * Remove the dead clauses and the clauses that don't contain l from occ[l]
+ * - return the new size of occ[l]
+ */
+static uint32_t pp_cleanup_occ(preprocessor_t *pp, literal_t l) {
+  pp_clause_t *c;
+  literal_t *w;
+  uint32_t i, j, n;
+
+  w = pp->occ[l];
+  n = pp_occ_size(pp, l);
+  j = 0;
+  for (i=0; i<n; i++) {
+    c = pp_clause(pp, w[i]);
+    pp->effort += c->len;
+    if (!c->dead && pp_clause_has_literal(c, l)) {
+      w[j] = w[i];
+      j ++;
+    }
+  }
+  if (w != NULL) {
+    w[j] = null_literal;
+    set_lv_size(w, j);
+  }
+  return j;
+}
+
+/*
+ * Length of the resolvent of clauses c1 and c2 on pivot x
+ * - c1 contains pos_lit(x), c2 contains neg_lit(x)
+ * - return -1 if the resolvent is a tautology
+ */
+static int32_t pp_resolvent_length(preprocessor_t *pp, pp_clause_t *c1, pp_clause_t *c2, bvar_t x) {
+  uint32_t i, n;
+  literal_t l;
+
+  pp->effort += c1->len + c2->len;
+  for (i=0; i<c1->len; i++) {
+    pp->mark[c1->lit[i]] = 1;
+  }
+
+  n = c1->len - 1;
+  for (i=0; i<c2->len; i++) {
+    l = c2->lit[i];
+    if (var_of(l) != x) {
+      if (pp->mark[not(l)]) {
+        n = UINT32_MAX;
+        break;
+      }
+      n += 1 - pp->mark[l];
+    }
+  }
+
+  for (i=0; i<c1->len; i++) {
+    pp->mark[c1->lit[i]] = 0;
+  }
+
+  return (n == UINT32_MAX) ? -1 : (int32_t) n;
+}
+
+/*
+ * Store the resolvent of c1 and c2 (on x) in pp->buffer
+ */
+static void pp_build_resolvent(preprocessor_t *pp, pp_clause_t *c1, pp_clause_t *c2, bvar_t x) {
+  uint32_t i;
+  literal_t l;
+
+  assert(pp->buffer.size == 0);
+  for (i=0; i<c1->len; i++) {
+    l = c1->lit[i];
+    if (var_of(l) != x) ivector_push(&pp->buffer, l);
+  }
+  for (i=0; i<c2->len; i++) {
+    l = c2->lit[i];
+    if (var_of(l) != x) ivector_push(&pp->buffer, l);
+  }
+}
+
+/*
+ * Save clause c in the elimination stack, with the literal of x first
+ */
+static void pp_save_clause(preprocessor_t *pp, pp_clause_t *c, bvar_t x) {
+  ivector_t *v;
+  uint32_t i;
+
+  v = &pp->buffer;
+  assert(v->size == 0);
+  for (i=0; i<c->len; i++) {
+    if (var_of(c->lit[i]) == x) {
+      ivector_push(v, c->lit[i]);
+    }
+  }
+  for (i=0; i<c->len; i++) {
+    if (var_of(c->lit[i]) != x) {
+      ivector_push(v, c->lit[i]);
+    }
+  }
+  elim_stack_save_clause(&pp->core->elim, v->size, v->data);
+  ivector_reset(v);
+}
+
+/*
+ * Try to eliminate variable x
+ */
+static void pp_try_eliminate(preprocessor_t *pp, bvar_t x) {
+  elim_stack_t *e;
+  literal_t *wp, *wn;
+  uint32_t i, j, np, nn, nres, k;
+  int32_t len;
+
+  np = pp_cleanup_occ(pp, pos_lit(x));
+  nn = pp_cleanup_occ(pp, neg_lit(x));
+  if (np + nn == 0) return; // x does not occur in any clause
+  if (np > PP_MAX_OCCS && nn > PP_MAX_OCCS) return;
+
+  wp = pp->occ[pos_lit(x)];
+  wn = pp->occ[neg_lit(x)];
+
+  // count the non-trivial resolvents
+  nres = 0;
+  for (i=0; i<np; i++) {
+    for (j=0; j<nn; j++) {
+      len = pp_resolvent_length(pp, pp_clause(pp, wp[i]), pp_clause(pp, wn[j]), x);
+      if (len > PP_MAX_RESOLVENT) return;
+      if (len >= 0) {
+        nres ++;
+        if (nres > np + nn) return;
+      }
+    }
+  }
+
+  // save the clauses of x
+  e = &pp->core->elim;
+  k = elim_stack_open_block(e, x);
+  for (i=0; i<np; i++) {
+    pp_save_clause(pp, pp_clause(pp, wp[i]), x);
+  }
+  for (j=0; j<nn; j++) {
+    pp_save_clause(pp, pp_clause(pp, wn[j]), x);
+  }
+  elim_stack_close_block(e, x, k);
+
+  // add the resolvents (this does not modify wp or wn)
+  for (i=0; i<np; i++) {
+    for (j=0; j<nn; j++) {
+      pp_build_resolvent(pp, pp_clause(pp, wp[i]), pp_clause(pp, wn[j]), x);
+      pp_add_buffer_clause(pp);
+    }
+  }
+
+  // remove the clauses of x
+  for (i=0; i<np; i++) {
+    pp_clause(pp, wp[i])->dead = true;
+  }
+  for (j=0; j<nn; j++) {
+    pp_clause(pp, wn[j])->dead = true;
+  }
+  delete_literal_vector(wp);
+  delete_literal_vector(wn);
+  pp->occ[pos_lit(x)] = NULL;
+  pp->occ[neg_lit(x)] = NULL;
+
+  pp->core->stats.pp_elim_vars ++;
+  pp_propagate_units(pp);
+}
+
+/*
+ * Ordering of elimination candidates: cost[x] = product of the number of
+ * positive and negative occurrences of x
+ */
+static bool pp_cheaper_var(void *data, int32_t x, int32_t y) {
+  uint64_t *cost;
+
+  cost = (uint64_t *) data;
+  return cost[x] < cost[y] || (cost[x] == cost[y] && x < y);
+}
+
+/*
+ * Bounded variable elimination
+ */
+static void pp_eliminate_vars(preprocessor_t *pp) {
+  smt_core_t *s;
+  ivector_t candidates;
+  uint64_t *cost;
+  uint32_t i, n;
+  bvar_t x;
+
+  s = pp->core;
+  n = s->nvars;
+  cost = (uint64_t *) safe_malloc(n * sizeof(uint64_t));
+  init_ivector(&candidates, 0);
+
+  for (x=0; x<n; x++) {
+    if (!pp->frozen[x] && bvar_is_unassigned(s, x) && !bvar_is_eliminated(s, x)) {
+      cost[x] = ((uint64_t) pp_occ_size(pp, pos_lit(x))) * pp_occ_size(pp, neg_lit(x));
+      ivector_push(&candidates, x);
+    }
+  }
+  int_array_sort2(candidates.data, candidates.size, cost, pp_cheaper_var);
+
+  pp->effort = 0;
+  for (i=0; i<candidates.size; i++) {
+    if (pp->unsat || pp->effort > PP_EFFORT) break;
+    x = candidates.data[i];
+    if (bvar_is_unassigned(s, x)) {
+      pp_try_eliminate(pp, x);
+    }
+  }
+
+  delete_ivector(&candidates);
+  safe_free(cost);
+}
+
+
+/*
+ * Copy the simplified clauses back into the clause database
+ * and remove the eliminated variables from the heap.
+ */
+static void pp_restore_clauses(preprocessor_t *pp) {
+  smt_core_t *s;
+  pp_clause_t *c;
+  uint32_t i, n;
+
+  s = pp->core;
+  n = pp->clauses.size;
+  for (i=0; i<n; i++) {
+    c = pp_clause(pp, i);
+    if (!c->dead) {
+      assert(c->len >= 2);
+      if (c->len == 2) {
+        direct_binary_clause(s, c->lit[0], c->lit[1], 0);
+      } else {
+        new_problem_clause(s, c->len, c->lit);
+      }
+    }
+  }
+
+  n = s->elim.order.size;
+  for (i=0; i<n; i++) {
+    heap_remove(&s->heap, s->elim.order.data[i]);
+  }
+}
+
+
+/*
+ * Preprocessing: called by start_search when it's enabled
+ * - all lemmas are added to the clause database first and we do
+ *   one round of Boolean propagation
+ * - s->preprocessed is set to true, so this is done once
+ */
+static void bool_preprocessing(smt_core_t *s) {
+  preprocessor_t pp;
+
+  assert(s->base_level == 0 && s->decision_level == 0 && s->elim.nvars == 0);
+
+  s->preprocessed = true;
+
+  if (! empty_lemma_queue(&s->lemmas)) {
+    add_all_lemmas(s);
+  }
+  if (s->inconsistent || ! boolean_propagation(s)) {
+    return;
+  }
+
+  elim_stack_alloc_vars(&s->elim, s->nvars);
+  init_preprocessor(&pp, s);
+
+  pp_collect_clauses(&pp);
+  pp_propagate_units(&pp);
+  if (! pp.unsat) pp_equivalences(&pp);
+  if (! pp.unsat) pp_subsumption(&pp);
+  if (! pp.unsat) pp_eliminate_vars(&pp);
+  if (! pp.unsat) pp_subsumption(&pp);
+
+  if (pp.unsat) {
+    record_empty_conflict(s);
+  } else {
+    pp_restore_clauses(&pp);
+  }
+
+  delete_preprocessor(&pp);
+}
+
+
+
+/*
+ * LOCAL SEARCH FOR INITIAL PHASES
+ */
+
+/*
+ * Add clause a[0 ... n-1] to walker w:
+ * - skip the clause if it's true at the base level and remove the
+ *   literals that are false at the base level
+ * - s->buffer is used as a temporary buffer
+ */
+static void walker_add_clause(smt_core_t *s, sls_walker_t *w, uint32_t n, const literal_t *a) {
+  ivector_t *v;
+  uint32_t i;
+
+  v = &s->buffer;
+  ivector_reset(v);
+  for (i=0; i<n; i++) {
+    switch (literal_value(s, a[i])) {
+    case VAL_TRUE:
+      ivector_reset(v);
+      return;
+
+    case VAL_FALSE:
+      break;
+
+    default:
+      ivector_push(v, a[i]);
+      break;
+    }
+  }
+
+  if (v->size > 0) {
+    sls_walker_add_clause(w, v->size, v->data);
+  }
+  ivector_reset(v);
+}
+
+/*
+ * Copy the binary clauses and the problem clauses into w
+ * - a binary clause {l1, l2} is stored in both bin[l1] and bin[l2]
+ *   so we add it once (when l1 <= l2)
+ * - clauses that are being removed are skipped
+ */
+static void walker_add_clauses(smt_core_t *s, sls_walker_t *w) {
+  literal_t aux[2];
+  clause_t **v;
+  literal_t *bin;
+  uint32_t i, n;
+  literal_t l1, l2;
+
+  n = s->nlits;
+  for (l1=0; l1<n; l1++) {
+    bin = s->bin[l1];
+    if (bin != NULL) {
+      for (;;) {
+        l2 = *bin ++;
+        if (l2 < 0) break;
+        if (l1 <= l2) {
+          aux[0] = l1;
+          aux[1] = l2;
+          walker_add_clause(s, w, 2, aux);
+        }
+      }
+    }
+  }
+
+  v = s->problem_clauses;
+  n = get_cv_size(v);
+  for (i=0; i<n; i++) {
+    if (! is_clause_to_be_removed(v[i])) {
+      walker_add_clause(s, w, clause_length(v[i]), v[i]->cl);
+    }
+  }
+}
+
+/*
+ * Run the local search and copy the best assignment into the preferred
+ * polarity of all unassigned variables.
+ */
+static void sls_initial_phases(smt_core_t *s) {
+  sls_walker_t w;
+  uint32_t i, n;
+
+  assert(s->decision_level == s->base_level && s->sls_flips > 0);
+
+  n = s->nvars;
+  if (n == 0) return;
+
+  init_sls_walker(&w, n);
+  sls_walker_set_seed(&w, random_uint32(s));
+  walker_add_clauses(s, &w);
+  for (i=0; i<n; i++) {
+    sls_walker_set_value(&w, i, s->value[i] & 1);
+  }
+
+  (void) sls_walk(&w, s->sls_flips);
+
+  for (i=0; i<n; i++) {
+    if (bval_is_undef(s->value[i])) {
+      s->value[i] = sls_walker_best_value(&w, i);
+    }
+  }
+  delete_sls_walker(&w);
+}
+
+
+/*
+ * Prepare for the search:
+ * - initialize variable heap
+ * - set status to searching
+ * - if clean_interrupt is enabled, save the current state to
+ *   enable cleanup after interrupt (this uses push)
+ */
+void start_search(smt_core_t *s) {
+  assert(s->status == STATUS_IDLE && s->decision_level == s->base_level);
+
+#if TRACE
+  printf("\n---> DPLL START\n");
+  fflush(stdout);
+#endif
+
+  if ((s->option_flag & CLEAN_INTERRUPT_MASK) != 0) {
+    /*
+     * in clean-interrupt mode, save the current state so
+     * that it can be restored after a call to stop_search.
+     */
+    smt_push(s);
+  }
+
+  s->status = STATUS_SEARCHING;
+  s->inconsistent = false;
+  s->theory_conflict = false;
+  s->conflict = NULL;
+  s->false_clause = NULL;
+
+  s->stats.restarts = 0;
+  s->stats.simplify_calls = 0;
+  s->stats.reduce_calls = 0;
+  s->stats.decisions = 0;
+  s->stats.random_decisions = 0;
+  s->stats.conflicts = 0;
+  s->stats.chrono_backtracks = 0;
+  s->simplify_bottom = 0;
+  s->simplify_props = 0;
+  s->simplify_threshold = 0;
+
+  smt_log_event(s, ETRACE_START_SEARCH, 0, 0, s->nvars);
+
+  /*
+   * Allow theory solver to do whatever initializations it needs
+   */
+  s->th_ctrl.start_search(s->th_solver);
+
+  if (s->preprocess && !s->preprocessed && s->base_level == 0 &&
+      (s->option_flag & PUSH_POP_MASK) == 0 && get_cv_size(s->learned_clauses) == 0) {
+    bool_preprocessing(s);
+  }
+
+  if (s->sls_flips > 0) {
+    sls_initial_phases(s);
+  }
+
+#if DEBUG
+  check_heap_content(s);
+  check_heap(s);
+#endif
+}
+
+
+/*
+ * Stop the search: set status to interrupted
+ * - this can be called from a signal handler to interrupt the solver
+ * - if clean_interrupt is enabled,  the state at start_search can be restored by
+ *   calling smt_cleanup(s)
  */
 void stop_search(smt_core_t *s) {
   if (s->status == STATUS_SEARCHING) {
@@ -5692,10 +7746,18 @@ bool smt_bounded_process(smt_core_t *s, uint64_t max_conflicts) {
  *   is done.
  */
 void smt_final_check(smt_core_t *s) {
+  fcheck_code_t code;
+  uint64_t start;
+
   assert(s->status == STATUS_SEARCHING || s->status == STATUS_INTERRUPTED);
 
   if (s->status == STATUS_SEARCHING) {
-    switch (s->th_ctrl.final_check(s->th_solver)) {
+    start = timer_start();
+    code = s->th_ctrl.final_check(s->th_solver);
+    timer_stop(s->stats.timer + CORE_TIMER_FINAL_CHECK, start);
+    smt_log_event(s, ETRACE_FINAL_CHECK, code, 0, 0);
+
+    switch (code) {
     case FCHECK_CONTINUE:
       /*
        * deal with conflicts or lemmas if any.
@@ -5708,6 +7770,9 @@ void smt_final_check(smt_core_t *s) {
        */
     case FCHECK_SAT:
       s->status = STATUS_SAT;
+      if (s->elim.num_elim > 0) {
+        extend_assignment(s);
+      }
       break;
     case FCHECK_UNKNOWN:
       s->status = STATUS_UNKNOWN;
@@ -5777,7 +7842,8 @@ static bool level_has_lower_activity(smt_core_t *s, double ax, uint32_t k) {
 
   while (i < n) {
     x = var_of(stack->lit[i]);
-    assert(bvar_is_assigned(s, x) && s->level[x] == k);
+    // level[x] < k is possible with chronological backtracking
+    assert(bvar_is_assigned(s, x) && s->level[x] <= k);
     if (s->heap.activity[x] >= ax) {
       return false;
     }
@@ -5794,7 +7860,7 @@ static bool level_has_lower_activity(smt_core_t *s, double ax, uint32_t k) {
 static void full_restart(smt_core_t *s) {
   assert(s->base_level < s->decision_level);
   backtrack(s, s->base_level);
-  s->th_ctrl.backtrack(s->th_solver, s->base_level);
+  theory_backtrack(s, s->base_level);
   // clear the checkpoints
   if (s->cp_flag) {
     purge_all_dynamic_atoms(s);
@@ -5808,7 +7874,7 @@ static void partial_restart(smt_core_t *s, uint32_t k) {
   assert(s->base_level <= k && k < s->decision_level);
 
   backtrack(s, k);
-  s->th_ctrl.backtrack(s->th_solver, k);
+  theory_backtrack(s, k);
 }
 
 
@@ -5823,6 +7889,7 @@ void smt_restart(smt_core_t *s) {
   printf("\n---> DPLL RESTART\n");
 #endif
   s->stats.restarts ++;
+  smt_log_event(s, ETRACE_RESTART, 0, 0, s->decision_level);
   if (s->base_level < s->decision_level) {
     full_restart(s);
   }
@@ -5846,6 +7913,7 @@ void smt_partial_restart(smt_core_t *s) {
 #endif
 
   s->stats.restarts ++;
+  smt_log_event(s, ETRACE_RESTART, 0, 0, s->decision_level);
 
   if (s->base_level < s->decision_level) {
     cleanup_heap(s);
@@ -5898,6 +7966,7 @@ void smt_partial_restart_var(smt_core_t *s) {
 #endif
 
   s->stats.restarts ++;
+  smt_log_event(s, ETRACE_RESTART, 0, 0, s->decision_level);
   if (s->base_level < s->decision_level) {
     cleanup_heap(s);
     if (heap_is_empty(&s->heap)) {
@@ -5923,6 +7992,302 @@ void smt_partial_restart_var(smt_core_t *s) {
 
 
 
+/***************
+ *  LOOKAHEAD  *
+ **************/
+
+/*
+ * Lookahead state
+ * - max_var = bound on the splitting variables
+ * - ncands = number of variables probed per node
+ * - cands = candidate variables at the current node
+ * - cube = literals decided so far (from the root to the current node)
+ * - out = vector where cubes are stored
+ * - ncubes = number of cubes added to out
+ */
+typedef struct lookahead_s {
+  uint32_t max_var;
+  uint32_t ncands;
+  ivector_t cands;
+  ivector_t cube;
+  ivector_t *out;
+  uint32_t ncubes;
+} lookahead_t;
+
+
+/*
+ * Clear the conflict after a failed probe: this must be followed by backtracking.
+ */
+static void clear_lookahead_conflict(smt_core_t *s) {
+  s->inconsistent = false;
+  s->theory_conflict = false;
+  s->conflict = NULL;
+  s->false_clause = NULL;
+}
+
+/*
+ * Probe literal l: assign l as a decision, propagate, then backtrack
+ * - l must be unassigned and there must be no conflict
+ * - return the number of literals implied by l, or -1 if l is failed
+ *   (i.e., propagation causes a conflict)
+ */
+static int32_t probe_literal(smt_core_t *s, literal_t l) {
+  uint32_t k, top;
+  int32_t n;
+
+  assert(literal_is_unassigned(s, l) && !s->inconsistent);
+
+  k = s->decision_level;
+  top = s->stack.top;
+  decide_literal(s, l);
+  if (smt_propagation(s)) {
+    n = s->stack.top - top - 1;
+  } else {
+    clear_lookahead_conflict(s);
+    n = -1;
+  }
+  backtrack_to_level(s, k);
+
+  return n;
+}
+
+
+/*
+ * Number of binary clauses that contain x or not x
+ */
+static uint32_t bin_occurrences(smt_core_t *s, bvar_t x) {
+  uint32_t n;
+
+  n = 0;
+  if (s->bin[pos_lit(x)] != NULL) n += get_lv_size(s->bin[pos_lit(x)]);
+  if (s->bin[neg_lit(x)] != NULL) n += get_lv_size(s->bin[neg_lit(x)]);
+  return n;
+}
+
+/*
+ * Ordering for the candidates: x before y if x has higher activity,
+ * or the same activity and more binary clauses
+ */
+static bool lookahead_precedes(smt_core_t *s, bvar_t x, bvar_t y) {
+  double ax, ay;
+
+  ax = s->heap.activity[x];
+  ay = s->heap.activity[y];
+  return ax > ay || (ax == ay && bin_occurrences(s, x) > bin_occurrences(s, y));
+}
+
+/*
+ * Collect the candidates for the current node: the la->ncands best
+ * unassigned variables (kept in la->cands, sorted by insertion).
+ */
+static void collect_lookahead_candidates(smt_core_t *s, lookahead_t *la) {
+  ivector_t *v;
+  uint32_t i, j, n;
+  bvar_t x;
+
+  v = &la->cands;
+  ivector_reset(v);
+  n = la->max_var;
+  if (n > s->nvars) n = s->nvars;
+  for (x=1; x<n; x++) { // skip const_bvar
+    if (bvar_is_unassigned(s, x)) {
+      if (v->size < la->ncands) {
+        ivector_push(v, x);
+      } else if (lookahead_precedes(s, x, v->data[v->size - 1])) {
+        v->data[v->size - 1] = x;
+      } else {
+        continue;
+      }
+      // move x to its position
+      j = v->size - 1;
+      while (j > 0 && lookahead_precedes(s, x, v->data[j-1])) {
+        v->data[j] = v->data[j-1];
+        j --;
+      }
+      v->data[j] = x;
+    }
+  }
+
+  for (i=0; i<v->size; i++) {
+    assert(bvar_is_unassigned(s, v->data[i]));
+  }
+}
+
+/*
+ * Select the splitting variable for the current node
+ * - return null_bvar if there are no candidates
+ * - set *refuted to true if both literals of a candidate are failed
+ * - a variable with a failed literal is selected immediately
+ */
+static bvar_t select_lookahead_var(smt_core_t *s, lookahead_t *la, bool *refuted) {
+  uint32_t i;
+  int32_t n0, n1;
+  uint64_t score, best_score;
+  bvar_t x, best;
+
+  *refuted = false;
+  collect_lookahead_candidates(s, la);
+
+  best = null_bvar;
+  best_score = 0;
+  for (i=0; i<la->cands.size; i++) {
+    // x may have been assigned by a theory solver at a lower level
+    // (this can happen with chronological backtracking)
+    x = la->cands.data[i];
+    if (bvar_is_assigned(s, x)) continue;
+    n0 = probe_literal(s, pos_lit(x));
+    if (bvar_is_assigned(s, x)) continue;
+    n1 = probe_literal(s, neg_lit(x));
+    if (n0 < 0 && n1 < 0) {
+      *refuted = true;
+      return null_bvar;
+    }
+    if (n0 < 0 || n1 < 0) {
+      return x;
+    }
+    score = ((uint64_t) n0 + 1) * ((uint64_t) n1 + 1);
+    if (best == null_bvar || score > best_score) {
+      best = x;
+      best_score = score;
+    }
+  }
+
+  return best;
+}
+
+/*
+ * Store the current cube into la->out
+ */
+static void add_lookahead_cube(lookahead_t *la) {
+  ivector_push(la->out, la->cube.size);
+  ivector_add(la->out, la->cube.data, la->cube.size);
+  la->ncubes ++;
+}
+
+/*
+ * Explore the current node
+ * - depth = number of literals that can still be added to the cube
+ */
+static void lookahead_node(smt_core_t *s, lookahead_t *la, uint32_t depth) {
+  literal_t l[2];
+  uint32_t i, k;
+  bvar_t x;
+  bool refuted;
+
+  if (depth == 0) {
+    add_lookahead_cube(la);
+    return;
+  }
+
+  x = select_lookahead_var(s, la, &refuted);
+  if (refuted) return;
+  if (x == null_bvar) {
+    // nothing left to split on
+    add_lookahead_cube(la);
+    return;
+  }
+
+  l[0] = pos_lit(x);
+  l[1] = neg_lit(x);
+  k = s->decision_level;
+  for (i=0; i<2; i++) {
+    if (literal_is_unassigned(s, l[i])) {
+      decide_literal(s, l[i]);
+      if (smt_propagation(s)) {
+        ivector_push(&la->cube, l[i]);
+        lookahead_node(s, la, depth - 1);
+        ivector_pop(&la->cube);
+      } else {
+        clear_lookahead_conflict(s);
+      }
+      backtrack_to_level(s, k);
+    } else if (literal_value(s, l[i]) == VAL_TRUE) {
+      // l[i] was implied at a lower level after the first branch
+      ivector_push(&la->cube, l[i]);
+      lookahead_node(s, la, depth - 1);
+      ivector_pop(&la->cube);
+    }
+  }
+}
+
+
+uint32_t smt_lookahead_cubes(smt_core_t *s, uint32_t max_var, uint32_t depth, uint32_t ncands, ivector_t *v) {
+  lookahead_t la;
+
+  assert(s->status == STATUS_SEARCHING && s->decision_level == s->base_level && !s->inconsistent);
+
+  la.max_var = max_var;
+  la.ncands = ncands;
+  init_ivector(&la.cands, ncands);
+  init_ivector(&la.cube, depth);
+  la.out = v;
+  la.ncubes = 0;
+
+  lookahead_node(s, &la, depth);
+
+  delete_ivector(&la.cands);
+  delete_ivector(&la.cube);
+
+  assert(s->decision_level == s->base_level && !s->inconsistent);
+
+  return la.ncubes;
+}
+
+
+
+
+
+/******************
+ *  MEMORY USAGE  *
+ *****************/
+
+/*
+ * Bytes used by a clause vector v and the clauses it contains
+ * - nlits = total number of literals in these clauses
+ * - hsize = size of the clause header
+ * - each clause also has an end marker
+ */
+static uint64_t clause_vector_mem_size(clause_t **v, uint64_t nlits, size_t hsize) {
+  return sizeof(clause_vector_t) + (uint64_t) get_cv_capacity(v) * sizeof(clause_t *) +
+    (uint64_t) get_cv_size(v) * (hsize + sizeof(literal_t)) + nlits * sizeof(literal_t);
+}
+
+/*
+ * This ignores the atom table, the trail stack, and the auxiliary buffers.
+ */
+uint64_t smt_core_mem_size(smt_core_t *s) {
+  uint64_t size;
+
+  size = sizeof(smt_core_t);
+
+  // variable-indexed arrays, heap, and propagation stack
+  size += (uint64_t) s->vsize * (sizeof(uint8_t) + sizeof(antecedent_t) + 2 * sizeof(uint32_t) +
+                                 sizeof(double) + sizeof(bvar_t) + sizeof(int32_t) +
+                                 sizeof(literal_t) + sizeof(uint32_t));
+  size += s->vsize >> 3;
+
+  // literal-indexed arrays and binary clauses
+  size += (uint64_t) s->lsize * (sizeof(literal_t *) + sizeof(link_t) + sizeof(uint32_t));
+  size += (uint64_t) s->nb_bin_clauses * 2 * sizeof(literal_t);
+
+  // clause database
+  size += clause_vector_mem_size(s->problem_clauses, s->stats.prob_literals, sizeof(clause_t));
+  size += clause_vector_mem_size(s->learned_clauses, s->stats.learned_literals, sizeof(learned_clause_t));
+
+  // event trace
+  size += (uint64_t) s->etrace.size * sizeof(etrace_event_t);
+  size += (uint64_t) s->level_stamp_size * sizeof(uint32_t);
+
+  // eliminated variables
+  size += (uint64_t) s->elim.nvars * (sizeof(uint32_t) + sizeof(uint8_t));
+  size += (uint64_t) s->elim.data.capacity * sizeof(int32_t);
+
+  return size;
+}
+
+
+
+
 /*******************
  *  CHECK CLAUSES  *
  ******************/
@@ -6179,7 +8544,7 @@ static void check_heap_content(smt_core_t *s) {
   }
 
   for (x=0; x<s->nvars; x++) {
-    if (bval_is_undef(s->value[x]) && s->heap.heap_index[x] < 0) {
+    if (bval_is_undef(s->value[x]) && !bvar_is_eliminated(s, x) && s->heap.heap_index[x] < 0) {
       printf("ERROR: incorrect heap: unassigned variable %"PRIu32" is not in the heap\n", x);
       fflush(stdout);
     }
@@ -6454,7 +8819,7 @@ static bool check_precedence(smt_core_t *s, literal_t l0, literal_t l) {
   for (;;) {
     assert(i < s->stack.top);
     l1 = s->stack.lit[i];
-    assert(d_level(s, l1) == k);
+    assert(s->chrono_enabled || d_level(s, l1) == k);
     if (l1 == l0) return true;
     if (l1 == l) return false;
     i ++;
@@ -56,6 +56,8 @@
 #include "io/tracer.h"
 #include "solvers/cdcl/smt_core_base_types.h"
 #include "utils/bitvectors.h"
+#include "utils/cycle_timers.h"
+#include "utils/event_trace.h"
 #include "utils/int_vectors.h"
 
 #include "yices_types.h"
@@ -76,6 +78,11 @@
  *   (a negative number).
  * - the first two literals stored in cl[0] and cl[1]
  *   are the watched literals.
+ * - level = the highest base level the clause depends on:
+ *   for a problem clause, this is the base level at which the clause
+ *   was added. For a learned clause, this is computed during conflict
+ *   resolution. The clause can be kept on smt_pop as long as its level
+ *   is no more than the new base level.
  * Learned clauses have the same components as a clause
  * and an activity, i.e., a float used by the clause-deletion
  * heuristic. (Because of alignment and padding, this wastes 32bits
@@ -112,6 +119,7 @@ typedef uintptr_t link_t;
 
 struct clause_s {
   link_t link[2];
+  uint32_t level;
   literal_t cl[0];
 };
 
@@ -419,6 +427,7 @@ typedef struct var_heap_s {
  * - on entry to the first search, no boolean propagation has been done yet, prop_ptr = 0
  * - after pop, we need to restore prop_ptr to 0, otherwise anything implied by
  *   the unit clause l1 may be missed
+ * - we also keep the size of the learned_units and learned_binaries vectors
  */
 typedef struct trail_s {
   uint32_t nvars;
@@ -427,6 +436,8 @@ typedef struct trail_s {
   uint32_t nclauses;
   uint32_t prop_ptr;
   uint32_t theory_ptr;
+  uint32_t nlunits;
+  uint32_t nlbins;
 } trail_t;
 
 typedef struct trail_stack_s {
@@ -771,6 +782,25 @@ typedef struct checkpoint_stack_s {
  *  STATISTICS RECORD  *
  **********************/
 
+/*
+ * Profiling timers (cf. utils/cycle_timers.h):
+ * - BCP = boolean propagation
+ * - PROPAGATE = propagation to the theory solver (assert_atom + propagate)
+ * - FINAL_CHECK = theory solver's final check
+ * - BACKTRACK = theory solver's backtrack
+ * - EXPLAIN = expansion of theory explanations during conflict resolution
+ */
+typedef enum core_timer {
+  CORE_TIMER_BCP,
+  CORE_TIMER_PROPAGATE,
+  CORE_TIMER_FINAL_CHECK,
+  CORE_TIMER_BACKTRACK,
+  CORE_TIMER_EXPLAIN,
+} core_timer_t;
+
+#define NUM_CORE_TIMERS (CORE_TIMER_EXPLAIN+1)
+
+
 /*
  * Search statistics
  */
@@ -784,6 +814,7 @@ typedef struct dpll_stats_s {
   uint64_t random_decisions; // number of random decisions
   uint64_t propagations;     // number of boolean propagations
   uint64_t conflicts;        // number of conflicts/backtrackings
+  uint64_t chrono_backtracks; // number of chronological backtrackings
 
   uint32_t th_props;         // number of theory propagation
   uint32_t th_prop_lemmas;   // number of propagation/explanation turned into clauses
@@ -799,10 +830,67 @@ typedef struct dpll_stats_s {
 
   uint64_t literals_before_simpl;
   uint64_t subsumed_literals;
+
+  uint32_t pp_subsumed;       // clauses removed by subsumption in preprocessing
+  uint32_t pp_strengthened;   // literals removed by strengthening in preprocessing
+  uint32_t pp_subst_vars;     // variables eliminated by substitution
+  uint32_t pp_elim_vars;      // variables eliminated by resolution
+  uint32_t pp_restored_vars;  // eliminated variables restored after preprocessing
+
+  cycle_timer_t timer[NUM_CORE_TIMERS];
 } dpll_stats_t;
 
 
 
+/*************************
+ *  ELIMINATED VARIABLES  *
+ ************************/
+
+/*
+ * Boolean preprocessing (cf. smt_core.c) may eliminate variables
+ * by substitution or by resolution. We keep a copy of all the clauses
+ * that contained an eliminated variable x. This is used for two things:
+ * - extend a model to x: if a saved clause of x is of the form (C \/ x)
+ *   and C is false in the model, then x := true, otherwise x := false.
+ *   This is the same rule as in new_sat_solver. For this to work, the
+ *   variables are processed in the reverse order of elimination.
+ * - restore x if it's used again after preprocessing (e.g., if a theory
+ *   solver creates a lemma or an atom that contains x). The saved clauses
+ *   are then added back.
+ *
+ * The saved clauses of x form a block in vector data:
+ *
+ *   --------------------------------------------------------------
+ *     previous block | n | k_1 C_1 | k_2 C_2 | ... | next block
+ *   --------------------------------------------------------------
+ *
+ * where n = number of integers that follow in the block, and each
+ * clause C_i is stored as its length k_i followed by its literals.
+ *
+ * Other components:
+ * - order = eliminated variables in the order of elimination
+ * - start[x] = index of x's block in data
+ * - elim[x] = 1 if x is eliminated, 0 otherwise
+ * - nvars = size of arrays start and elim (number of variables when
+ *   preprocessing was done, variables created later are never eliminated)
+ * - num_elim = number of variables that are currently eliminated
+ * - assigned = variables whose value was set when extending a model
+ *   (their value is cleared by smt_clear)
+ * - aux = buffer used to collect variables to restore
+ */
+typedef struct elim_stack_s {
+  ivector_t data;
+  ivector_t order;
+  ivector_t assigned;
+  ivector_t aux;
+  uint32_t *start;
+  uint8_t *elim;
+  uint32_t nvars;
+  uint32_t num_elim;
+} elim_stack_t;
+
+
+
 /*********************
  *  SMT SOLVER CORE  *
  ********************/
@@ -922,6 +1010,53 @@ typedef enum smt_mode {
  * - if th_cache is true, th_cache_cl_size specifies which
  *   conflicts/explanations are considered (i.e., if they contain at most
  *   th_cache_cl_size literals, they are turned into clauses).
+ *
+ * Chronological backtracking:
+ * - if chrono_enabled is true, then conflict resolution may backtrack
+ *   to the previous decision level instead of the assertion level of the
+ *   learned clause. This happens when the backjump would skip more
+ *   than chrono_threshold levels.
+ * - the implied literal is then assigned out of order: its level is the
+ *   assertion level, which is smaller than the current decision level.
+ *   To support this, boolean propagation assigns implied literals
+ *   at the highest level of the clause's false literals, and backtracking
+ *   keeps all literals whose level is no more than the backtrack level.
+ *
+ * Dependency levels (to keep learned clauses on pop):
+ * - each clause has a level (see clause_t).
+ * - for a variable x assigned at the base level, dlevel[x] is the
+ *   highest base level that x's value depends on. This may be smaller
+ *   than level[x] if x was propagated after a push.
+ * - binary clauses don't have a level field. For a literal l,
+ *   blevel[l] is an upper bound on the level of all the binary clauses
+ *   that contain l. The level of clause {l1, l2} is then bounded by
+ *   min(blevel[l1], blevel[l2]).
+ * - theory conflicts and explanations depend on the whole theory
+ *   state so they are given the current base level.
+ * - learned units and learned binary clauses are removed on pop
+ *   together with all other base-level literals and binary clauses.
+ *   To keep them, the learned units and binary clauses whose level is
+ *   less than the base level are also stored in vectors learned_units
+ *   (as pairs [literal, level]) and learned_binaries (as triples
+ *   [l1, l2, level]). They are added back after pop if their level is
+ *   no more than the new base level.
+ *
+ * Local search for initial phases:
+ * - if sls_flips is positive, then start_search runs a ProbSAT-style
+ *   local search on the clauses (cf. sls_walker.h), with at most sls_flips
+ *   flips. The best assignment found is used as the preferred polarity of
+ *   all unassigned variables. Theory atoms are treated as plain boolean
+ *   variables by the local search.
+ *
+ * Boolean preprocessing:
+ * - if preprocess is true, then the first call to start_search simplifies
+ *   the problem clauses by equivalent-literal substitution, subsumption,
+ *   strengthening, and bounded variable elimination. This is done only
+ *   at base level 0, if push/pop is not supported, and if there are no
+ *   learned clauses.
+ * - variables attached to atoms are frozen: they are never eliminated.
+ *   Other variables that a theory solver or the context uses after
+ *   preprocessing are restored on the fly (cf. elim_stack_t).
  */
 typedef struct smt_core_s {
   /* Theory solver */
@@ -971,6 +1106,17 @@ typedef struct smt_core_s {
   bool th_cache_enabled;      // true means caching enabled
   uint32_t th_cache_cl_size;  // max. size of cached clauses
 
+  /* Chronological backtracking */
+  bool chrono_enabled;        // true means enabled
+  uint32_t chrono_threshold;  // max number of levels for a non-chronological backjump
+
+  /* Local search for initial phases */
+  uint32_t sls_flips;         // bound on the number of flips (0 means disabled)
+
+  /* Boolean preprocessing */
+  bool preprocess;            // true means enabled
+  bool preprocessed;          // true once preprocessing has been attempted
+
   /* Conflict data */
   bool inconsistent;
   bool theory_conflict;
@@ -992,15 +1138,21 @@ typedef struct smt_core_s {
 
   ivector_t binary_clauses;  // Keeps a copy of binary clauses added at base_levels>0
 
+  /* Learned units and binary clauses to restore on pop */
+  ivector_t learned_units;
+  ivector_t learned_binaries;
+
   /* Variable-indexed arrays (of size vsize) */
   uint8_t *value;
   antecedent_t *antecedent;
   uint32_t *level;
   byte_t *mark;        // bitvector: for conflict resolution
+  uint32_t *dlevel;    // dependency level of base-level assignments
 
   /* Literal-indexed arrays (of size lsize) */
   literal_t **bin;   // array of literal vectors
   link_t *watch;     // array of watch lists
+  uint32_t *blevel;  // bound on the level of binary clauses
 
   /* Stack/propagation queue */
   prop_stack_t stack;
@@ -1014,6 +1166,16 @@ typedef struct smt_core_s {
   /* Statistics */
   dpll_stats_t stats;
 
+  /*
+   * Event trace + level stamps to compute the LBD of learned clauses
+   * - level_stamp[k] = lbd_stamp if level k was seen in the current clause
+   * - level_stamp_size = size of the level_stamp array
+   */
+  event_trace_t etrace;
+  uint32_t *level_stamp;
+  uint32_t level_stamp_size;
+  uint32_t lbd_stamp;
+
   /* Atom table */
   atom_table_t atoms;
 
@@ -1024,6 +1186,9 @@ typedef struct smt_core_s {
   checkpoint_stack_t checkpoints;
   bool cp_flag;  // set true when backtracking. false when checkpoints are added
 
+  /* Saved clauses of eliminated variables */
+  elim_stack_t elim;
+
   /* EXPERIMENTAL (default to NULL) */
   booleq_table_t *etable;
 
@@ -1115,6 +1280,14 @@ static inline void smt_core_set_bool_only(smt_core_t *s) {
   s->bool_only = true;
 }
 
+/*
+ * Clear the bool_only flag: used by the bitvector solver if it needs
+ * to see atom assignments during the search.
+ */
+static inline void smt_core_clear_bool_only(smt_core_t *s) {
+  s->bool_only = false;
+}
+
 /*
  * Replace the theory solver and interface descriptors
  * - this can used provided no atom/clause has been added yet
@@ -1172,8 +1345,10 @@ extern void smt_push(smt_core_t *s);
 
 /*
  * Restore to the saved state on top of the trail_stack
- * - remove all learned_clauses
  * - remove all clauses, variable, and atoms created at the current base_level
+ * - remove the learned clauses that depend on the current base level
+ *   (i.e., whose level is equal to the current base level). The other
+ *   learned clauses are kept.
  * - reset status to IDLE
  * - must not be called if the trail_stack is empty (no push) or if
  *   status is SEARCHING or INTERRUPTED
@@ -1219,6 +1394,53 @@ static inline void disable_theory_cache(smt_core_t *s) {
 }
 
 
+/*
+ * Activate chronological backtracking
+ * - threshold = max number of levels that a conflict can skip:
+ *   if the learned clause's assertion level is more than threshold
+ *   levels below the conflict level, then we backtrack by one level only.
+ */
+static inline void enable_chrono_backtracking(smt_core_t *s, uint32_t threshold) {
+  s->chrono_enabled = true;
+  s->chrono_threshold = threshold;
+}
+
+/*
+ * Disable chronological backtracking
+ */
+static inline void disable_chrono_backtracking(smt_core_t *s) {
+  s->chrono_enabled = false;
+}
+
+
+/*
+ * Activate local search for initial phases
+ * - flips = bound on the number of flips (0 disables local search)
+ */
+static inline void enable_sls_phases(smt_core_t *s, uint32_t flips) {
+  s->sls_flips = flips;
+}
+
+/*
+ * Disable local search for initial phases
+ */
+static inline void disable_sls_phases(smt_core_t *s) {
+  s->sls_flips = 0;
+}
+
+
+/*
+ * Enable/disable Boolean preprocessing
+ */
+static inline void enable_bool_preprocessing(smt_core_t *s) {
+  s->preprocess = true;
+}
+
+static inline void disable_bool_preprocessing(smt_core_t *s) {
+  s->preprocess = false;
+}
+
+
 /*
  * Read the current decision level
  */
@@ -1293,6 +1515,10 @@ static inline uint64_t num_conflicts(smt_core_t *s) {
   return s->stats.conflicts;
 }
 
+static inline uint64_t num_chrono_backtracks(smt_core_t *s) {
+  return s->stats.chrono_backtracks;
+}
+
 static inline uint32_t num_theory_conflicts(smt_core_t *s) {
   return s->stats.th_conflicts;
 }
@@ -1301,6 +1527,14 @@ static inline uint32_t num_theory_propagations(smt_core_t *s) {
   return s->stats.th_props;
 }
 
+static inline uint32_t num_subst_vars(smt_core_t *s) {
+  return s->stats.pp_subst_vars;
+}
+
+static inline uint32_t num_elim_vars(smt_core_t *s) {
+  return s->stats.pp_elim_vars;
+}
+
 
 /*
  * Read the size statistics
@@ -1400,6 +1634,15 @@ extern void remove_bvar_atom(smt_core_t *s, bvar_t x);
 extern bool bvar_has_atom(smt_core_t *s, bvar_t x);
 
 
+/*
+ * Check whether x was eliminated by preprocessing (and not restored)
+ * - an eliminated variable is not assigned during the search
+ */
+static inline bool bvar_is_eliminated(const smt_core_t *s, bvar_t x) {
+  return (uint32_t) x < s->elim.nvars && s->elim.elim[x] != 0;
+}
+
+
 /*
  * Get the atom attached to x (NULL if x has no atom attached)
  */
@@ -1674,6 +1917,48 @@ extern void reduce_clause_database(smt_core_t *s);
  */
 extern void remove_irrelevant_learned_clauses(smt_core_t *s);
 
+/*
+ * Remove all the learned clauses that are not locked (i.e., that are
+ * not the antecedent of an assigned literal). This is used to free
+ * memory when the context is close to its memory limit.
+ */
+extern void purge_learned_clauses(smt_core_t *s);
+
+/*
+ * Estimate of the memory used by s (in bytes): variable and literal
+ * arrays, clause database, assignment stack, and event trace.
+ */
+extern uint64_t smt_core_mem_size(smt_core_t *s);
+
+
+/*
+ * Lookahead cube generation (for cube-and-conquer)
+ * - s must be searching, at the base level, after propagation
+ *   (i.e., after start_search and smt_process with no conflict)
+ * - max_var: only variables of index < max_var are used for splitting
+ * - depth: maximal number of literals in a cube
+ * - ncands: number of variables probed at each node
+ *
+ * At each node of the lookahead tree, the ncands unassigned variables
+ * with the highest activity are probed (ties are broken by number of
+ * binary clauses): each literal is assigned as a decision and
+ * propagated (Boolean and theory propagation), and the number of
+ * implied literals is recorded. The node is split on the
+ * variable x that maximizes (1 + n(x)) * (1 + n(not x)), where n(l)
+ * is the number of literals implied by l. A literal whose propagation
+ * causes a conflict is failed: its branch is pruned.
+ *
+ * The cubes are added to vector v: each cube is stored as its
+ * number of literals followed by the literals.
+ *
+ * On exit, s is back at the base level with no conflict. The function
+ * returns the number of cubes added to v. It returns 0 if all branches
+ * are pruned: then the clauses and theory constraints are unsat.
+ */
+extern uint32_t smt_lookahead_cubes(smt_core_t *s, uint32_t max_var, uint32_t depth, uint32_t ncands, ivector_t *v);
+
+#define DEF_LOOKAHEAD_CANDIDATES 32
+
 
 /*
  * Set a checkpoint: this records the current decision_level and
@@ -1783,6 +2068,26 @@ extern void record_binary_theory_conflict(smt_core_t *s, literal_t l1, literal_t
 extern void record_ternary_theory_conflict(smt_core_t *s, literal_t l1, literal_t l2, literal_t l3);
 
 
+/*
+ * Event trace: the core logs restarts, conflicts, etc. in s->etrace.
+ * A theory solver can also log events, in particular it should call
+ * smt_log_theory_conflict when it records a conflict.
+ * - the event stamp is the current number of conflicts
+ * - n = number of literals in the conflict
+ */
+static inline void smt_log_event(smt_core_t *s, etrace_kind_t kind, uint8_t arg8, uint16_t arg16, uint32_t arg32) {
+  etrace_log(&s->etrace, kind, s->stats.conflicts, arg8, arg16, arg32);
+}
+
+static inline void smt_log_theory_conflict(smt_core_t *s, etrace_solver_t solver, uint32_t n) {
+  smt_log_event(s, ETRACE_TH_CONFLICT, solver, 0, n);
+}
+
+static inline event_trace_t *smt_event_trace(smt_core_t *s) {
+  return &s->etrace;
+}
+
+
 /*
  * Close the search: mark s as either SAT or UNKNOWN
  */
@@ -1800,8 +2105,8 @@ static inline void end_search_unknown(smt_core_t *s) {
 /*
  * If the search was interrupted, this function
  * restores s to what it was at the start of the search.
- * - remove all learned clauses and all the lemmas, variables, and atoms created
- *   during the search.
+ * - remove all the lemmas, variables, and atoms created during the search,
+ *   and the learned clauses that depend on them (as in smt_pop).
  * - reset s->status to IDLE
  * - this must not be called if clean_interrupt is disabled.
  */
@@ -1821,8 +2126,8 @@ extern void smt_clear(smt_core_t *s);
  * Cleanup after the search returned unsat
  * - s->status must be UNSAT.
  * - if clean_interrupt is enabled, this restores s to its state
- *   before the search: learned clauses are deleted, lemmas, variables
- *   and atoms created during the search are deleted.
+ *   before the search: lemmas, variables and atoms created during the
+ *   search are deleted, and so are the learned clauses that depend on them.
  * - if clean_interrupt is disabled, this does nothing.
  */
 extern void smt_clear_unsat(smt_core_t *s);
@@ -1867,8 +2172,8 @@ extern bvar_t select_random_bvar(smt_core_t *s);
  * Check whether all variables are assigned
  */
 static inline bool all_variables_assigned(smt_core_t *s) {
-  assert(s->stack.top <= s->nvars);
-  return s->nvars == s->stack.top;
+  assert(s->stack.top + s->elim.num_elim <= s->nvars);
+  return s->nvars == s->stack.top + s->elim.num_elim;
 }
 
 
@@ -24,6 +24,7 @@
 #include <stdbool.h>
 #include <assert.h>
 #include <inttypes.h>
+#include <string.h>
 
 #include "io/tracer.h"
 #include "solvers/egraph/composites.h"
@@ -566,6 +567,7 @@ static void init_egraph_stack(egraph_stack_t *stack, uint32_t n, uint32_t m) {
   stack->etag = (unsigned char *) safe_malloc(n * sizeof(unsigned char));
   stack->edata = (expl_data_t *) safe_malloc(n * sizeof(expl_data_t));
   stack->mark = allocate_bitvector(n);
+  stack->cache = (int32_t *) safe_malloc(n * sizeof(int32_t));
   stack->top = 0;
   stack->prop_ptr = 0;
   stack->size = n;
@@ -593,6 +595,7 @@ static void extend_egraph_stack(egraph_stack_t *stack) {
   stack->etag = (unsigned char *) safe_realloc(stack->etag, n * sizeof(unsigned char));
   stack->edata = (expl_data_t *) safe_realloc(stack->edata, n * sizeof(expl_data_t));
   stack->mark = extend_bitvector(stack->mark, n);
+  stack->cache = (int32_t *) safe_realloc(stack->cache, n * sizeof(int32_t));
   stack->size = n;
 }
 
@@ -629,6 +632,7 @@ static int32_t egraph_stack_push_eq(egraph_stack_t *stack, occ_t t1, occ_t t2) {
     extend_egraph_stack(stack);
   }
   clr_bit(stack->mark, i);
+  stack->cache[i] = EXPL_CACHE_NONE;
   stack->top = i+1;
   stack->eq[i].lhs = t1;
   stack->eq[i].rhs = t2;
@@ -645,12 +649,14 @@ static void delete_egraph_stack(egraph_stack_t *stack) {
   safe_free(stack->eq);
   safe_free(stack->etag);
   safe_free(stack->edata);
+  safe_free(stack->cache);
   safe_free(stack->level_index);
   delete_bitvector(stack->mark);
 
   stack->eq = NULL;
   stack->etag = NULL;
   stack->edata = NULL;
+  stack->cache = NULL;
   stack->level_index = NULL;
   stack->mark = NULL;
 }
@@ -669,6 +675,77 @@ static void reset_egraph_stack(egraph_stack_t *stack) {
 
 
 
+/***********************
+ *  EXPLANATION CACHE  *
+ **********************/
+
+static void init_expl_cache(expl_cache_t *cache) {
+  init_ivector(&cache->lits, 0);
+  init_ivector(&cache->log, 0);
+  init_ivector(&cache->queue, 0);
+  init_ivector(&cache->buffer, 0);
+  cache->mark = NULL;
+  cache->msize = 0;
+  cache->busy = false;
+}
+
+static void delete_expl_cache(expl_cache_t *cache) {
+  delete_ivector(&cache->lits);
+  delete_ivector(&cache->log);
+  delete_ivector(&cache->queue);
+  delete_ivector(&cache->buffer);
+  delete_bitvector(cache->mark);
+  cache->mark = NULL;
+}
+
+/*
+ * Remove all records (the stack must be reset too)
+ */
+static void reset_expl_cache(expl_cache_t *cache) {
+  ivector_reset(&cache->lits);
+  ivector_reset(&cache->log);
+}
+
+/*
+ * Remove the records of edges that are no longer in the stack
+ * - this is called after backtracking: we compact the log only if
+ *   it has many more records than there are edges in the stack
+ */
+static void backtrack_expl_cache(expl_cache_t *cache, egraph_stack_t *stack) {
+  ivector_t *log, *lits;
+  uint32_t i, j, k, n, start, len;
+  int32_t e;
+
+  log = &cache->log;
+  n = log->size/3;
+  if (n <= 2 * stack->top + 64) return;
+
+  lits = &cache->lits;
+  j = 0;
+  k = 0;
+  for (i=0; i<n; i++) {
+    e = log->data[3 * i];
+    if (e < (int32_t) stack->top && stack->cache[e] == (int32_t) i) {
+      // live record: move it to position j
+      start = log->data[3 * i + 1];
+      len = log->data[3 * i + 2];
+      assert(k <= start);
+      memmove(lits->data + k, lits->data + start, len * sizeof(int32_t));
+      log->data[3 * j] = e;
+      log->data[3 * j + 1] = k;
+      log->data[3 * j + 2] = len;
+      stack->cache[e] = j;
+      j ++;
+      k += len;
+    }
+  }
+  log->size = 3 * j;
+  lits->size = k;
+}
+
+
+
+
 /****************
  *  UNDO STACK  *
  ***************/
@@ -909,6 +986,8 @@ static void init_egraph_stats(egraph_stats_t *s) {
 
   s->final_checks = 0;
   s->interface_eqs = 0;
+
+  s->expl_cache_hits = 0;
 }
 
 /*
@@ -4594,6 +4673,7 @@ void egraph_reset(egraph_t *egraph) {
   reset_class_table(&egraph->classes);
   reset_eterm_table(&egraph->terms);
   reset_egraph_stack(&egraph->stack);
+  reset_expl_cache(&egraph->expl_cache);
   reset_undo_stack(&egraph->undo);
   reset_distinct_table(&egraph->dtable);
   reset_congruence_table(&egraph->ctable);
@@ -4906,10 +4986,11 @@ static void egraph_local_backtrack(egraph_t *egraph, uint32_t back_level) {
   assert(i == k);
   egraph->undo.top = k;
 
-  // Cleanup the propagation stack
+  // Cleanup the propagation stack and the explanation cache
   k = egraph->stack.level_index[back_level + 1];
   egraph->stack.top = k;
   egraph->stack.prop_ptr = k;
+  backtrack_expl_cache(&egraph->expl_cache, &egraph->stack);
 
   // delete all temporary data in the arena
   n = egraph->decision_level;
@@ -5191,6 +5272,7 @@ bool egraph_propagate(egraph_t *egraph) {
         conflict->data[i] = not(conflict->data[i]);
       }
       ivector_push(conflict, null_literal); // end marker
+      smt_log_theory_conflict(egraph->core, ETRACE_EGRAPH, conflict->size - 1);
       record_theory_conflict(egraph->core, conflict->data);
 
       egraph->stats.th_conflicts ++;
@@ -6744,6 +6826,7 @@ void init_egraph(egraph_t *egraph, type_table_t *ttbl) {
   init_arena(&egraph->arena);
   init_ivector(&egraph->expl_queue, DEFAULT_EXPL_VECTOR_SIZE);
   init_ivector(&egraph->expl_vector, DEFAULT_EXPL_VECTOR_SIZE);
+  init_expl_cache(&egraph->expl_cache);
   init_pvector(&egraph->cmp_vector, DEFAULT_CMP_VECTOR_SIZE);
   init_ivector(&egraph->aux_buffer, 0);
   init_istack(&egraph->istack);
@@ -6877,6 +6960,7 @@ void delete_egraph(egraph_t *egraph) {
   delete_istack(&egraph->istack);
   delete_ivector(&egraph->aux_buffer);
   delete_pvector(&egraph->cmp_vector);
+  delete_expl_cache(&egraph->expl_cache);
   delete_ivector(&egraph->expl_vector);
   delete_ivector(&egraph->expl_queue);
   delete_arena(&egraph->arena);
@@ -7810,3 +7894,97 @@ void egraph_free_model(egraph_t *egraph) {
   reset_egraph_model(&egraph->mdl);
 }
 
+
+
+
+
+/******************
+ *  MEMORY USAGE  *
+ *****************/
+
+/*
+ * Bytes used by the terms and their composites
+ */
+static uint64_t eterm_table_mem_size(eterm_table_t *tbl) {
+  composite_t *cmp;
+  uint64_t size;
+  uint32_t i, n;
+
+  size = (uint64_t) tbl->size * (sizeof(composite_t *) + sizeof(elabel_t) + sizeof(occ_t) +
+                                 sizeof(int32_t) + sizeof(thvar_t) + sizeof(type_t));
+  size += tbl->size >> 3;
+
+  n = tbl->nterms;
+  for (i=0; i<n; i++) {
+    cmp = tbl->body[i];
+    if (composite_body(cmp)) {
+      // children + hooks
+      size += sizeof(composite_t) + 2 * composite_arity(cmp) * sizeof(int32_t);
+    }
+  }
+
+  return size;
+}
+
+/*
+ * Bytes used by the classes and the parent vectors
+ */
+static uint64_t class_table_mem_size(class_table_t *tbl) {
+  uint64_t size;
+  uint32_t i, n;
+
+  size = (uint64_t) tbl->size * (sizeof(occ_t) + sizeof(uint32_t) + sizeof(use_vector_t) +
+                                 sizeof(unsigned char) + sizeof(thvar_t));
+  n = tbl->nclasses;
+  for (i=0; i<n; i++) {
+    size += (uint64_t) tbl->parents[i].size * sizeof(void *);
+  }
+
+  return size;
+}
+
+static inline uint64_t ivector_mem_size(ivector_t *v) {
+  return (uint64_t) v->capacity * sizeof(int32_t);
+}
+
+/*
+ * Estimate: this includes the main tables (terms, classes, propagation
+ * and undo stacks, congruence table) and the explanation cache.
+ */
+uint64_t egraph_mem_size(egraph_t *egraph) {
+  uint64_t size;
+
+  size = sizeof(egraph_t);
+  size += eterm_table_mem_size(&egraph->terms);
+  size += class_table_mem_size(&egraph->classes);
+  size += (uint64_t) egraph->stack.size * (sizeof(equeue_elem_t) + sizeof(unsigned char) +
+                                           sizeof(expl_data_t) + sizeof(int32_t));
+  size += egraph->stack.size >> 3;
+  size += (uint64_t) egraph->undo.size * (sizeof(unsigned char) + sizeof(undo_t));
+  size += (uint64_t) egraph->ctable.size * sizeof(composite_t *);
+  size += ivector_mem_size(&egraph->expl_cache.lits) + ivector_mem_size(&egraph->expl_cache.log);
+
+  return size;
+}
+
+
+/*
+ * Empty the explanation cache and free its memory
+ */
+void egraph_flush_expl_cache(egraph_t *egraph) {
+  expl_cache_t *cache;
+  uint32_t i, n;
+
+  cache = &egraph->expl_cache;
+  assert(! cache->busy);
+
+  n = egraph->stack.top;
+  for (i=0; i<n; i++) {
+    egraph->stack.cache[i] = EXPL_CACHE_NONE;
+  }
+
+  delete_ivector(&cache->lits);
+  delete_ivector(&cache->log);
+  init_ivector(&cache->lits, 0);
+  init_ivector(&cache->log, 0);
+}
@@ -604,6 +604,23 @@ extern void egraph_free_model(egraph_t *egraph);
 
 
 
+/******************
+ *  MEMORY USAGE  *
+ *****************/
+
+/*
+ * Estimate of the memory used by the egraph (in bytes)
+ */
+extern uint64_t egraph_mem_size(egraph_t *egraph);
+
+/*
+ * Remove all cached explanations and free the cache's memory
+ * - the cache is rebuilt as explanations are computed
+ */
+extern void egraph_flush_expl_cache(egraph_t *egraph);
+
+
+
 /****************
  *  STATISTICS  *
  ***************/
@@ -665,6 +682,10 @@ static inline uint32_t egraph_num_interface_eqs(egraph_t *egraph) {
   return egraph->stats.interface_eqs; // interface equalities or lemmas created by final check
 }
 
+static inline uint32_t egraph_num_expl_cache_hits(egraph_t *egraph) {
+  return egraph->stats.expl_cache_hits;
+}
+
 
 
 #endif /* __EGRAPH_H */
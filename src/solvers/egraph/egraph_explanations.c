@@ -46,6 +46,10 @@
  * same explanation to be reconstructed when edge i is expanded later.
  * In particular, the expansion should not introduce any equalities
  * asserted after i.
+ *
+ * Since the expansion of a congruence edge i depends only on edges
+ * that precede i, it can be computed once and kept in the explanation
+ * cache until edge i is removed from the stack.
  */
 
 
@@ -59,6 +63,7 @@
 #include "solvers/egraph/egraph_utils.h"
 #include "solvers/egraph/theory_explanations.h"
 #include "utils/bit_tricks.h"
+#include "utils/bitvectors.h"
 #include "utils/int_vectors.h"
 #include "utils/memalloc.h"
 
@@ -921,148 +926,346 @@ static void explain_theory_equality(egraph_t *egraph, expl_tag_t id, eterm_t t1,
  */
 
 /*
- * Expand the marked edges into a vector of literals
- * - v = result vector: literals are added to it (v is not reset)
+ * Explain edge i: add literals to v and edges to the explanation queue
  */
-static void build_explanation_vector(egraph_t *egraph, ivector_t *v) {
+static void explain_edge(egraph_t *egraph, int32_t i, ivector_t *v) {
   equeue_elem_t *eq;
-  byte_t *mark;
-  ivector_t *queue;
   unsigned char *etag;
   expl_data_t *edata;
   composite_t **body;
   eterm_t t1, t2;
-  uint32_t k;
-  int32_t i;
 
   eq = egraph->stack.eq;
-  mark = egraph->stack.mark;
   etag = egraph->stack.etag;
   edata = egraph->stack.edata;
   body = egraph->terms.body;
-  queue = &egraph->expl_queue;
 
-  for (k = 0; k < queue->size; k++) {
-    i = queue->data[k];
-    assert(i >= 0 && tst_bit(mark, i));
-    switch (etag[i]) {
-    case EXPL_AXIOM:
-      break;
+  switch (etag[i]) {
+  case EXPL_AXIOM:
+    break;
+
+  case EXPL_ASSERT:
+    ivector_push(v, edata[i].lit);
+    break;
+
+  case EXPL_EQ:
+    explain_eq(egraph, edata[i].t[0], edata[i].t[1], v);
+    break;
+
+  case EXPL_DISTINCT0:
+    explain_diseq_via_constants(egraph, edata[i].t[0], edata[i].t[1], v);
+    break;
+
+  case EXPL_DISTINCT1:
+  case EXPL_DISTINCT2:
+  case EXPL_DISTINCT3:
+  case EXPL_DISTINCT4:
+  case EXPL_DISTINCT5:
+  case EXPL_DISTINCT6:
+  case EXPL_DISTINCT7:
+  case EXPL_DISTINCT8:
+  case EXPL_DISTINCT9:
+  case EXPL_DISTINCT10:
+  case EXPL_DISTINCT11:
+  case EXPL_DISTINCT12:
+  case EXPL_DISTINCT13:
+  case EXPL_DISTINCT14:
+  case EXPL_DISTINCT15:
+  case EXPL_DISTINCT16:
+  case EXPL_DISTINCT17:
+  case EXPL_DISTINCT18:
+  case EXPL_DISTINCT19:
+  case EXPL_DISTINCT20:
+  case EXPL_DISTINCT21:
+  case EXPL_DISTINCT22:
+  case EXPL_DISTINCT23:
+  case EXPL_DISTINCT24:
+  case EXPL_DISTINCT25:
+  case EXPL_DISTINCT26:
+  case EXPL_DISTINCT27:
+  case EXPL_DISTINCT28:
+  case EXPL_DISTINCT29:
+  case EXPL_DISTINCT30:
+  case EXPL_DISTINCT31:
+    explain_diseq_via_dmasks(egraph, edata[i].t[0], edata[i].t[1], (uint32_t) (etag[i] - EXPL_DISTINCT0), i, v);
+    break;
+
+  case EXPL_SIMP_OR:
+    // eq[i].lhs = (or ...), rhs == false or term occurrence
+    t1 = term_of_occ(eq[i].lhs);
+    assert(composite_body(body[t1]));
+    if (eq[i].rhs == false_occ) {
+      explain_simp_or_false(egraph, body[t1], v);
+    } else {
+      explain_simp_or(egraph, body[t1], eq[i].rhs, v);
+    }
+    break;
+
+  case EXPL_BASIC_CONGRUENCE:
+    t1 = term_of_occ(eq[i].lhs);
+    t2 = term_of_occ(eq[i].rhs);
+    explain_congruence(egraph, body[t1], body[t2], v);
+    break;
+
+  case EXPL_EQ_CONGRUENCE1:
+    t1 = term_of_occ(eq[i].lhs);
+    t2 = term_of_occ(eq[i].rhs);
+    explain_eq_congruence1(egraph, body[t1], body[t2], v);
+    break;
+
+  case EXPL_EQ_CONGRUENCE2:
+    t1 = term_of_occ(eq[i].lhs);
+    t2 = term_of_occ(eq[i].rhs);
+    explain_eq_congruence2(egraph, body[t1], body[t2], v);
+    break;
+
+  case EXPL_ITE_CONGRUENCE1:
+    t1 = term_of_occ(eq[i].lhs);
+    t2 = term_of_occ(eq[i].rhs);
+    explain_ite_congruence1(egraph, body[t1], body[t2], v);
+    break;
+
+  case EXPL_ITE_CONGRUENCE2:
+    t1 = term_of_occ(eq[i].lhs);
+    t2 = term_of_occ(eq[i].rhs);
+    explain_ite_congruence2(egraph, body[t1], body[t2], v);
+    break;
+
+  case EXPL_OR_CONGRUENCE:
+    t1 = term_of_occ(eq[i].lhs);
+    t2 = term_of_occ(eq[i].rhs);
+    explain_or_congruence(egraph, body[t1], body[t2], edata[i].ptr, v);
+    break;
+
+  case EXPL_DISTINCT_CONGRUENCE:
+    t1 = term_of_occ(eq[i].lhs);
+    t2 = term_of_occ(eq[i].rhs);
+    explain_distinct_congruence(egraph, body[t1], body[t2], edata[i].ptr, v);
+    break;
+
+  case EXPL_ARITH_PROPAGATION:
+  case EXPL_BV_PROPAGATION:
+  case EXPL_FUN_PROPAGATION:
+    t1 = term_of_occ(eq[i].lhs);
+    t2 = term_of_occ(eq[i].rhs);
+    explain_theory_equality(egraph, etag[i], t1, t2, edata[i].ptr, v);
+    break;
+
+  case EXPL_RECONCILE:
+    assert(false);
+    break;
+  }
+}
 
-    case EXPL_ASSERT:
-      ivector_push(v, edata[i].lit);
-      break;
 
-    case EXPL_EQ:
-      explain_eq(egraph, edata[i].t[0], edata[i].t[1], v);
-      break;
+/*
+ * EXPLANATION CACHE
+ */
 
-    case EXPL_DISTINCT0:
-      explain_diseq_via_constants(egraph, edata[i].t[0], edata[i].t[1], v);
-      break;
+/*
+ * Check whether edge i is a congruence edge
+ */
+static bool congruence_edge(egraph_t *egraph, int32_t i) {
+  switch (egraph->stack.etag[i]) {
+  case EXPL_BASIC_CONGRUENCE:
+  case EXPL_EQ_CONGRUENCE1:
+  case EXPL_EQ_CONGRUENCE2:
+  case EXPL_ITE_CONGRUENCE1:
+  case EXPL_ITE_CONGRUENCE2:
+  case EXPL_OR_CONGRUENCE:
+  case EXPL_DISTINCT_CONGRUENCE:
+    return true;
 
-    case EXPL_DISTINCT1:
-    case EXPL_DISTINCT2:
-    case EXPL_DISTINCT3:
-    case EXPL_DISTINCT4:
-    case EXPL_DISTINCT5:
-    case EXPL_DISTINCT6:
-    case EXPL_DISTINCT7:
-    case EXPL_DISTINCT8:
-    case EXPL_DISTINCT9:
-    case EXPL_DISTINCT10:
-    case EXPL_DISTINCT11:
-    case EXPL_DISTINCT12:
-    case EXPL_DISTINCT13:
-    case EXPL_DISTINCT14:
-    case EXPL_DISTINCT15:
-    case EXPL_DISTINCT16:
-    case EXPL_DISTINCT17:
-    case EXPL_DISTINCT18:
-    case EXPL_DISTINCT19:
-    case EXPL_DISTINCT20:
-    case EXPL_DISTINCT21:
-    case EXPL_DISTINCT22:
-    case EXPL_DISTINCT23:
-    case EXPL_DISTINCT24:
-    case EXPL_DISTINCT25:
-    case EXPL_DISTINCT26:
-    case EXPL_DISTINCT27:
-    case EXPL_DISTINCT28:
-    case EXPL_DISTINCT29:
-    case EXPL_DISTINCT30:
-    case EXPL_DISTINCT31:
-      explain_diseq_via_dmasks(egraph, edata[i].t[0], edata[i].t[1], (uint32_t) (etag[i] - EXPL_DISTINCT0), i, v);
-      break;
+  default:
+    return false;
+  }
+}
 
-    case EXPL_SIMP_OR:
-      // eq[i].lhs = (or ...), rhs == false or term occurrence
-      t1 = term_of_occ(eq[i].lhs);
-      assert(composite_body(body[t1]));
-      if (eq[i].rhs == false_occ) {
-        explain_simp_or_false(egraph, body[t1], v);
-      } else {
-        explain_simp_or(egraph, body[t1], eq[i].rhs, v);
-      }
-      break;
+/*
+ * Check whether edge i's explanation depends on a satellite solver
+ */
+static bool theory_edge(egraph_t *egraph, int32_t i) {
+  switch (egraph->stack.etag[i]) {
+  case EXPL_ARITH_PROPAGATION:
+  case EXPL_BV_PROPAGATION:
+  case EXPL_FUN_PROPAGATION:
+  case EXPL_RECONCILE:
+    return true;
 
-    case EXPL_BASIC_CONGRUENCE:
-      t1 = term_of_occ(eq[i].lhs);
-      t2 = term_of_occ(eq[i].rhs);
-      explain_congruence(egraph, body[t1], body[t2], v);
-      break;
+  default:
+    return false;
+  }
+}
 
-    case EXPL_EQ_CONGRUENCE1:
-      t1 = term_of_occ(eq[i].lhs);
-      t2 = term_of_occ(eq[i].rhs);
-      explain_eq_congruence1(egraph, body[t1], body[t2], v);
-      break;
+/*
+ * Add the cached explanation of edge i to v
+ * - i must have a cached explanation
+ */
+static void push_cached_explanation(egraph_t *egraph, int32_t i, ivector_t *v) {
+  expl_cache_t *cache;
+  int32_t k, start, n;
+
+  cache = &egraph->expl_cache;
+  k = egraph->stack.cache[i];
+  assert(k >= 0 && cache->log.data[3 * k] == i);
+  start = cache->log.data[3 * k + 1];
+  n = cache->log.data[3 * k + 2];
+  assert(0 <= n && start + n <= (int32_t) cache->lits.size);
+  ivector_add(v, cache->lits.data + start, n);
+}
 
-    case EXPL_EQ_CONGRUENCE2:
-      t1 = term_of_occ(eq[i].lhs);
-      t2 = term_of_occ(eq[i].rhs);
-      explain_eq_congruence2(egraph, body[t1], body[t2], v);
-      break;
+/*
+ * Add a record for edge i to the log
+ * - i's explanation must be in cache->buffer
+ */
+static void log_cached_explanation(egraph_t *egraph, int32_t i) {
+  expl_cache_t *cache;
+
+  cache = &egraph->expl_cache;
+  egraph->stack.cache[i] = cache->log.size/3;
+  ivector_push(&cache->log, i);
+  ivector_push(&cache->log, cache->lits.size);
+  ivector_push(&cache->log, cache->buffer.size);
+  ivector_add(&cache->lits, cache->buffer.data, cache->buffer.size);
+}
 
-    case EXPL_ITE_CONGRUENCE1:
-      t1 = term_of_occ(eq[i].lhs);
-      t2 = term_of_occ(eq[i].rhs);
-      explain_ite_congruence1(egraph, body[t1], body[t2], v);
-      break;
+/*
+ * Swap the explanation queue and marks with the cache's queue and marks
+ */
+static void swap_expl_queues(egraph_t *egraph) {
+  expl_cache_t *cache;
+  ivector_t aux;
+  byte_t *mark;
 
-    case EXPL_ITE_CONGRUENCE2:
-      t1 = term_of_occ(eq[i].lhs);
-      t2 = term_of_occ(eq[i].rhs);
-      explain_ite_congruence2(egraph, body[t1], body[t2], v);
-      break;
+  cache = &egraph->expl_cache;
+  aux = egraph->expl_queue;
+  egraph->expl_queue = cache->queue;
+  cache->queue = aux;
 
-    case EXPL_OR_CONGRUENCE:
-      t1 = term_of_occ(eq[i].lhs);
-      t2 = term_of_occ(eq[i].rhs);
-      explain_or_congruence(egraph, body[t1], body[t2], edata[i].ptr, v);
-      break;
+  mark = egraph->stack.mark;
+  egraph->stack.mark = cache->mark;
+  cache->mark = mark;
+}
 
-    case EXPL_DISTINCT_CONGRUENCE:
-      t1 = term_of_occ(eq[i].lhs);
-      t2 = term_of_occ(eq[i].rhs);
-      explain_distinct_congruence(egraph, body[t1], body[t2], edata[i].ptr, v);
-      break;
+/*
+ * Compute the explanation of congruence edge i in isolation and store it in the cache
+ * - we use the cache's queue and marks, so that the edges marked in the
+ *   main explanation queue are not affected
+ * - short cuts are allowed only if they don't depend on edge i or
+ *   later edges, so that the result is valid as long as i is in the stack
+ * - we give up if i's explanation depends on a satellite solver or
+ *   if it's too large
+ */
+static void cache_explanation(egraph_t *egraph, int32_t i) {
+  expl_cache_t *cache;
+  ivector_t *queue, *buffer;
+  byte_t *mark;
+  int32_t saved_top_id, j;
+  uint32_t k;
+  bool ok;
 
-    case EXPL_ARITH_PROPAGATION:
-    case EXPL_BV_PROPAGATION:
-    case EXPL_FUN_PROPAGATION:
-      t1 = term_of_occ(eq[i].lhs);
-      t2 = term_of_occ(eq[i].rhs);
-      explain_theory_equality(egraph, etag[i], t1, t2, edata[i].ptr, v);
-      break;
+  cache = &egraph->expl_cache;
+  assert(! cache->busy && egraph->stack.cache[i] == EXPL_CACHE_SEEN && congruence_edge(egraph, i));
 
-    case EXPL_RECONCILE:
-      assert(false);
+  if (cache->msize < egraph->stack.size) {
+    cache->mark = extend_bitvector0(cache->mark, egraph->stack.size, cache->msize);
+    cache->msize = egraph->stack.size;
+  }
+
+  cache->busy = true;
+  saved_top_id = egraph->top_id;
+  egraph->top_id = i;
+  swap_expl_queues(egraph);
+
+  queue = &egraph->expl_queue;
+  mark = egraph->stack.mark;
+  buffer = &cache->buffer;
+  assert(queue->size == 0 && buffer->size == 0);
+
+  ok = true;
+  enqueue_edge(queue, mark, i);
+  for (k=0; k<queue->size; k++) {
+    j = queue->data[k];
+    if (theory_edge(egraph, j)) {
+      ok = false;
       break;
     }
+    if (egraph->stack.cache[j] >= 0) {
+      push_cached_explanation(egraph, j, buffer);
+    } else {
+      explain_edge(egraph, j, buffer);
+    }
+    if (queue->size > EXPL_CACHE_MAX_EDGES || buffer->size > EXPL_CACHE_MAX_LITS) {
+      ok = false;
+      break;
+    }
+  }
+
+  for (k=0; k<queue->size; k++) {
+    j = queue->data[k];
+    assert(tst_bit(mark, j));
+    clr_bit(mark, j);
+  }
+  ivector_reset(queue);
+
+  swap_expl_queues(egraph);
+  egraph->top_id = saved_top_id;
+  cache->busy = false;
+
+  if (ok) {
+    ivector_remove_duplicates(buffer);
+    log_cached_explanation(egraph, i);
+  } else {
+    egraph->stack.cache[i] = EXPL_CACHE_FAILED;
+  }
+  ivector_reset(buffer);
+}
+
+
+/*
+ * Expand the marked edges into a vector of literals
+ * - v = result vector: literals are added to it (v is not reset)
+ * - the explanations of congruence edges are taken from the cache
+ *   (or added to the cache if the edge is used for the second time)
+ */
+static void build_explanation_vector(egraph_t *egraph, ivector_t *v) {
+  byte_t *mark;
+  ivector_t *queue;
+  uint32_t k;
+  int32_t i;
+
+  queue = &egraph->expl_queue;
+
+  for (k = 0; k < queue->size; k++) {
+    i = queue->data[k];
+    assert(i >= 0 && tst_bit(egraph->stack.mark, i));
+    if (congruence_edge(egraph, i)) {
+      switch (egraph->stack.cache[i]) {
+      case EXPL_CACHE_NONE:
+        egraph->stack.cache[i] = EXPL_CACHE_SEEN;
+        break;
+
+      case EXPL_CACHE_SEEN:
+        cache_explanation(egraph, i);
+        break;
+
+      case EXPL_CACHE_FAILED:
+        break;
+
+      default:
+        egraph->stats.expl_cache_hits ++;
+        break;
+      }
+      if (egraph->stack.cache[i] >= 0) {
+        push_cached_explanation(egraph, i, v);
+        continue;
+      }
+    }
+    explain_edge(egraph, i, v);
   }
 
   // clear all the marks
+  mark = egraph->stack.mark;
   for (k=0; k<queue->size; k++) {
     i = queue->data[k];
     assert(i >= 0 && tst_bit(mark, i));
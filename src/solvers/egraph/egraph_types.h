@@ -548,6 +548,8 @@ typedef struct update_graph_s update_graph_t;
  *   so eq[prop_ptr ... top-1] = all assertions not yet processed.
  * - size = size of arrays eq, expl, saved_class
  * - mark = bitvector for constructing explanations
+ * - cache = index of the cached explanation for each edge
+ *   (cf. explanation cache below)
  *
  * Assertions are organized in levels:
  * - level_index[k] = index of the first assertion added at level k
@@ -564,6 +566,7 @@ typedef struct egraph_stack_s {
   unsigned char *etag;
   expl_data_t *edata;
   byte_t *mark;
+  int32_t *cache;
 
   uint32_t top;
   uint32_t prop_ptr;
@@ -587,6 +590,61 @@ enum {
 
 
 
+/***********************
+ *  EXPLANATION CACHE  *
+ **********************/
+
+/*
+ * The explanation for a congruence edge i (i.e., the set of literals
+ * that imply c1 == c2 when edge i is (c1 == c2) by congruence) does
+ * not change as long as edge i is in the stack. The explanation cache
+ * stores these sets so that they can be reused when the same edge
+ * occurs in several explanations.
+ *
+ * For each edge i, stack.cache[i] is either
+ * - EXPL_CACHE_NONE: i has not been used in an explanation yet
+ * - EXPL_CACHE_SEEN: i has been used once (we cache i's explanation
+ *   the second time it's used)
+ * - EXPL_CACHE_FAILED: i's explanation is too large to be cached
+ * - an index k >= 0 in the log: log[3k] = i, log[3k+1] = start of i's
+ *   explanation in lits, log[3k+2] = number of literals.
+ *
+ * stack.cache[i] is reset to EXPL_CACHE_NONE when edge i is pushed, so
+ * records for edges removed on backtracking are ignored. They are
+ * deleted when the log is compacted.
+ *
+ * Auxiliary components to compute an explanation in isolation:
+ * - queue = queue of edges
+ * - buffer = literals
+ * - mark = bitvector for the edges in queue
+ * - msize = size of the mark bitvector
+ * - busy = true while an explanation is being computed
+ */
+enum {
+  EXPL_CACHE_NONE = -1,
+  EXPL_CACHE_SEEN = -2,
+  EXPL_CACHE_FAILED = -3,
+};
+
+typedef struct expl_cache_s {
+  ivector_t lits;
+  ivector_t log;
+  ivector_t queue;
+  ivector_t buffer;
+  byte_t *mark;
+  uint32_t msize;
+  bool busy;
+} expl_cache_t;
+
+/*
+ * Limits: we give up if the explanation requires more than
+ * EXPL_CACHE_MAX_EDGES edges or more than EXPL_CACHE_MAX_LITS literals.
+ */
+#define EXPL_CACHE_MAX_EDGES 64
+#define EXPL_CACHE_MAX_LITS  32
+
+
+
 
 /****************
  *  UNDO STACK  *
@@ -1273,6 +1331,9 @@ typedef struct egraph_stats_s {
   uint32_t final_checks;     // number of calls to final check
   uint32_t interface_eqs;    // number of interface equalities generated
 
+  // explanation cache
+  uint32_t expl_cache_hits;  // number of explanations found in the cache
+
 } egraph_stats_t;
 
 
@@ -1397,6 +1458,7 @@ struct egraph_s {
   arena_t arena;              // stack-based allocation
   ivector_t expl_queue;       // vector used as a queue of edges (explanation queue)
   ivector_t expl_vector;      // vector of literals for conflict/explanations
+  expl_cache_t expl_cache;    // cached explanations for congruence edges
   pvector_t cmp_vector;       // generic vector to store composites
   ivector_t aux_buffer;       // generic buffer used in term construction
   int_stack_t istack;         // generic stack for recursive processing
@@ -1409,6 +1409,7 @@ static bool idl_add_edge(idl_solver_t *solver, int32_t x, int32_t y, int32_t d,
       v->data[i] = not(v->data[i]);
     }
     ivector_push(v, null_literal); // end marker
+    smt_log_theory_conflict(solver->core, ETRACE_IDL, v->size - 1);
     record_theory_conflict(solver->core, v->data);
 
     return false;
@@ -1663,6 +1663,7 @@ static bool rdl_add_edge(rdl_solver_t *solver, int32_t x, int32_t y, rdl_const_t
         v->data[i] = not(v->data[i]);
       }
       ivector_push(v, null_literal); // end marker
+      smt_log_theory_conflict(solver->core, ETRACE_RDL, v->size - 1);
       record_theory_conflict(solver->core, v->data);
 
       return false;
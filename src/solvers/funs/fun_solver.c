@@ -32,6 +32,11 @@
  * - When we check for conflict or extensionality instances, we
  *   don't need to consider (apply f t_1 ... t_n)  if there's
  *   no composite that may conflict with it.
+ *
+ * - For update conflicts, we also skip the classes of composites
+ *   that are not weakly equivalent: (apply f t_1 ... t_n) and
+ *   (apply g u_1 ... u_n) can't conflict if every path from f to g
+ *   goes through an update at t_1 ... t_n (cf. fun_forest_t).
  */
 
 #include <inttypes.h>
@@ -218,6 +223,8 @@ static void init_fun_vartable(fun_vartable_t *table) {
   table->base = (int32_t *) safe_malloc(n * sizeof(int32_t));
   table->app = (void ***) safe_malloc(n * sizeof(void **));
   table->mark = allocate_bitvector(n);
+  table->visit = (uint32_t *) safe_malloc(n * sizeof(uint32_t));
+  table->stamp = 1;
 }
 
 
@@ -244,6 +251,7 @@ static void extend_fun_vartable(fun_vartable_t *table) {
   table->base = (int32_t *) safe_realloc(table->base, n * sizeof(int32_t));
   table->app = (void ***) safe_realloc(table->app, n * sizeof(void **));
   table->mark = extend_bitvector(table->mark, n);
+  table->visit = (uint32_t *) safe_realloc(table->visit, n * sizeof(uint32_t));
   table->size = n;
 }
 
@@ -268,6 +276,7 @@ static void shrink_fun_vartable(fun_vartable_t *table, uint32_t n) {
  */
 static void reset_fun_vartable(fun_vartable_t *table) {
   shrink_fun_vartable(table, 0);
+  table->stamp = 1;
 }
 
 
@@ -288,6 +297,7 @@ static void delete_fun_vartable(fun_vartable_t *table) {
   safe_free(table->base);
   safe_free(table->app);
   delete_bitvector(table->mark);
+  safe_free(table->visit);
 
   table->type = NULL;
   table->arity = NULL;
@@ -300,6 +310,7 @@ static void delete_fun_vartable(fun_vartable_t *table) {
   table->base = NULL;
   table->app = NULL;
   table->mark = NULL;
+  table->visit = NULL;
 }
 
 
@@ -445,6 +456,120 @@ static thvar_t fun_queue_pop(fun_queue_t *queue) {
 
 
 
+/************
+ *  FOREST  *
+ ***********/
+
+/*
+ * Initialization: the arrays are allocated on the first call to resize
+ */
+static void init_fun_forest(fun_forest_t *forest) {
+  forest->vsize = 0;
+  forest->esize = 0;
+  forest->tin = NULL;
+  forest->tout = NULL;
+  forest->top = NULL;
+  forest->uf = NULL;
+  forest->first = NULL;
+  forest->round = NULL;
+  forest->child = NULL;
+  forest->key = NULL;
+  forest->sorted = NULL;
+  forest->nedges = 0;
+  forest->current = 0;
+  init_ivector(&forest->nontree, 10);
+  init_ivector(&forest->cuts, 10);
+  init_ivector(&forest->enclosing, 10);
+  init_ivector(&forest->reps, 10);
+  init_ivector(&forest->stack, 30);
+}
+
+
+/*
+ * Make sure the arrays are large enough for nv variables and ne edges
+ */
+static void resize_fun_forest(fun_forest_t *forest, uint32_t nv, uint32_t ne) {
+  uint32_t i, n;
+
+  if (nv > forest->vsize) {
+    n = forest->vsize + 1;
+    n += n>>1;
+    if (n < nv) n = nv;
+    if (n >= MAX_FUN_FOREST_SIZE) {
+      out_of_memory();
+    }
+    forest->tin = (int32_t *) safe_realloc(forest->tin, n * sizeof(int32_t));
+    forest->tout = (int32_t *) safe_realloc(forest->tout, n * sizeof(int32_t));
+    forest->top = (thvar_t *) safe_realloc(forest->top, n * sizeof(thvar_t));
+    forest->uf = (thvar_t *) safe_realloc(forest->uf, n * sizeof(thvar_t));
+    forest->first = (int32_t *) safe_realloc(forest->first, n * sizeof(int32_t));
+    forest->round = (uint32_t *) safe_realloc(forest->round, n * sizeof(uint32_t));
+    for (i=forest->vsize; i<n; i++) {
+      forest->round[i] = 0;
+    }
+    forest->vsize = n;
+  }
+
+  if (ne > forest->esize) {
+    n = forest->esize + 1;
+    n += n>>1;
+    if (n < ne) n = ne;
+    if (n >= MAX_FUN_FOREST_SIZE) {
+      out_of_memory();
+    }
+    forest->child = (thvar_t *) safe_realloc(forest->child, n * sizeof(thvar_t));
+    forest->key = (uint32_t *) safe_realloc(forest->key, n * sizeof(uint32_t));
+    forest->sorted = (int32_t *) safe_realloc(forest->sorted, n * sizeof(int32_t));
+    forest->esize = n;
+  }
+}
+
+
+/*
+ * Delete
+ */
+static void delete_fun_forest(fun_forest_t *forest) {
+  safe_free(forest->tin);
+  safe_free(forest->tout);
+  safe_free(forest->top);
+  safe_free(forest->uf);
+  safe_free(forest->first);
+  safe_free(forest->round);
+  safe_free(forest->child);
+  safe_free(forest->key);
+  safe_free(forest->sorted);
+  forest->tin = NULL;
+  forest->tout = NULL;
+  forest->top = NULL;
+  forest->uf = NULL;
+  forest->first = NULL;
+  forest->round = NULL;
+  forest->child = NULL;
+  forest->key = NULL;
+  forest->sorted = NULL;
+  delete_ivector(&forest->nontree);
+  delete_ivector(&forest->cuts);
+  delete_ivector(&forest->enclosing);
+  delete_ivector(&forest->reps);
+  delete_ivector(&forest->stack);
+}
+
+
+/*
+ * Reset: empty the buffers
+ */
+static void reset_fun_forest(fun_forest_t *forest) {
+  forest->nedges = 0;
+  ivector_reset(&forest->nontree);
+  ivector_reset(&forest->cuts);
+  ivector_reset(&forest->enclosing);
+  ivector_reset(&forest->reps);
+  ivector_reset(&forest->stack);
+}
+
+
+
+
 /*********************
  *   PUSH/POP STACK  *
  ********************/
@@ -1633,33 +1758,47 @@ static void fun_solver_add_axiom2(fun_solver_t *solver, thvar_t x, thvar_t z, co
 
 
 /*
- * Propagate c = (apply f i_1 ... i_n) to all root variables z reachable from
- * x via a non-masking path and check for conflict. A conflict is found if
- * there's d = (apply g j_1 ... j_n) such that
+ * Search for an update conflict involving c = (apply f i_1 ... i_n).
+ * A conflict is found if there's d = (apply g j_1 ... j_n) such that
  *  1) g is in the class of a variable z, reachable from x via a non-masking path
  *  2) j_1 ... j_n are equal to i_1 ... i_n in the egraph.
+ *  3) c and d are not equal in the egraph
+ * The search stops at any variable z /= x whose class contains such a d.
  *
  * Input:
  * - x must be a root variable
  * - c = (apply f ...) where f belongs to the class of x
+ * - apps = vector of applications with the same arguments as c
+ * - base = stamp of the search for apps[0]
+ * - if reuse is true, the search for apps[j] must have been done
+ *   (without conflict) for all j such that base + j < vtbl->stamp.
+ *
+ * Every variable z explored is marked with visit[z] = vtbl->stamp.
+ *
+ * If reuse is true and we reach a variable z (with no matching d) that was
+ * explored by the search for apps[j], then all the applications
+ * reachable from z are equal to apps[j] (otherwise, there would have been a
+ * conflict in that search). So we don't need to explore z again if c is
+ * equal to apps[j]. If c is not equal to apps[j], there's a conflict:
+ * we return -1 and let the caller redo the search with reuse = false
+ * to get the path for the lemma.
  *
  * Result:
- * - return true if there's a conflict, false otherwise
- * - if there's no conflict, c is added to vtbl->app[z] for all root variables z
- * - if there's a conflict, c may be added to vtbl->app[z] for some z's
+ * - return 1 if there's a conflict, 0 otherwise, -1 if the search must be redone
  * - if a conflict is found, then an instance of the generalized update axiom 2
  *   is added to the core.
  */
-static bool update_conflict_for_application(fun_solver_t *solver, thvar_t x, composite_t *c) {
+static int32_t update_conflict_for_application(fun_solver_t *solver, thvar_t x, composite_t *c,
+                                               void **apps, uint32_t base, bool reuse) {
   fun_queue_t *queue;
   egraph_t *egraph;
   fun_vartable_t *vtbl;
   composite_t *d;
   int32_t *edges;
   thvar_t y, z;
-  uint32_t n, i;
+  uint32_t n, i, stamp;
   int32_t k;
-  bool result;
+  int32_t result;
 
   egraph = solver->egraph;
   vtbl = &solver->vtbl;
@@ -1667,6 +1806,8 @@ static bool update_conflict_for_application(fun_solver_t *solver, thvar_t x, com
   queue = &solver->queue;
   assert(queue->top == 0 && queue->ptr == 0);
 
+  stamp = vtbl->stamp;
+  assert(base <= stamp);
 
   fun_queue_push(queue, x);
   // mark that x is the source
@@ -1684,16 +1825,24 @@ static bool update_conflict_for_application(fun_solver_t *solver, thvar_t x, com
       if (! egraph_equal_apps(egraph, c, d)) {
         // conflict: add an instance of the update axiom
         fun_solver_add_axiom2(solver, x, z, c, d);
-        result = true;
+        result = 1;
+        goto done;
+      }
+    } else if (reuse && z != x && base <= vtbl->visit[z] && vtbl->visit[z] < stamp) {
+      /*
+       * z was explored by the search for apps[j]
+       */
+      d = apps[vtbl->visit[z] - base];
+      if (! egraph_equal_apps(egraph, c, d)) {
+        result = -1;
         goto done;
       }
     } else {
       /*
        * No conflict and no matching composite in z's class
-       * - add c to app[z]
        * - explore the neighbors of all nodes in the class of z
        */
-      add_ptr_to_vector(vtbl->app + z, c); // We could do this only after checking for conflicts
+      vtbl->visit[z] = stamp;
       do {
         // edges incident to node z
         edges = vtbl->edges[z];
@@ -1714,7 +1863,7 @@ static bool update_conflict_for_application(fun_solver_t *solver, thvar_t x, com
     }
   }
 
-  result = false;
+  result = 0;
 
  done:
   // reset pre[y] to null for all y in the queue
@@ -1730,6 +1879,41 @@ static bool update_conflict_for_application(fun_solver_t *solver, thvar_t x, com
 }
 
 
+/*
+ * Check whether all applications in v are equal in the egraph
+ * - if so, there can't be an update conflict between them
+ */
+static bool equal_applications(egraph_t *egraph, void **v) {
+  uint32_t i, n;
+
+  n = ppv_size(v);
+  for (i=1; i<n; i++) {
+    if (! egraph_equal_apps(egraph, v[0], v[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+
+/*
+ * Reserve n stamps for the searches on a class of n applications
+ * - return the stamp for the first search
+ * - if the counter would overflow, clear visit[x] for all variables
+ */
+static uint32_t reserve_visit_stamps(fun_vartable_t *vtbl, uint32_t n) {
+  uint32_t i;
+
+  if (vtbl->stamp > UINT32_MAX - n) {
+    for (i=0; i<vtbl->nvars; i++) {
+      vtbl->visit[i] = 0;
+    }
+    vtbl->stamp = 1;
+  }
+  return vtbl->stamp;
+}
+
+
 /*
  * Get the root variable for f in c = (apply f ....)
  */
@@ -1742,6 +1926,328 @@ static thvar_t root_app_var(egraph_t *egraph, composite_t *c) {
 }
 
 
+/*
+ * Hash code for the labels of the indices of edge k
+ */
+static uint32_t edge_key(fun_solver_t *solver, int32_t k) {
+  fun_edge_t *e;
+  uint32_t i, n, h;
+
+  e = get_edge(&solver->etbl, k);
+  n = solver->vtbl.arity[e->source];
+  h = n;
+  for (i=0; i<n; i++) {
+    h = jenkins_hash_pair(egraph_label(solver->egraph, e->index[i]), h, 0x1d3a8b5e);
+  }
+  return h;
+}
+
+/*
+ * Hash code for the labels of i_1 ... i_n in c = (apply f i_1 ... i_n)
+ * - this is equal to edge_key(k) if edge k is masking for c
+ */
+static uint32_t app_key(egraph_t *egraph, composite_t *c) {
+  uint32_t i, n, h;
+
+  assert(composite_kind(c) == COMPOSITE_APPLY && composite_arity(c) > 0);
+  n = composite_arity(c) - 1;
+  h = n;
+  for (i=0; i<n; i++) {
+    h = jenkins_hash_pair(egraph_label(egraph, composite_child(c, i+1)), h, 0x1d3a8b5e);
+  }
+  return h;
+}
+
+/*
+ * Check whether edge k is masking for c when k may be an edge of a different type
+ */
+static bool masking_edge_any_type(fun_solver_t *solver, int32_t k, composite_t *c) {
+  fun_edge_t *e;
+
+  e = get_edge(&solver->etbl, k);
+  return solver->vtbl.arity[e->source] == composite_arity(c) - 1 && masking_edge(solver, k, c);
+}
+
+/*
+ * Ordering for sorting the edges and the cuts
+ */
+static bool edge_key_lt(void *data, int32_t k1, int32_t k2) {
+  fun_forest_t *forest;
+
+  forest = data;
+  return forest->key[k1] < forest->key[k2];
+}
+
+static bool tin_lt(void *data, thvar_t x, thvar_t y) {
+  fun_forest_t *forest;
+
+  forest = data;
+  return forest->tin[x] < forest->tin[y];
+}
+
+
+/*
+ * Build the spanning forest
+ * - the equivalence classes and roots must be set
+ * - the forest is built by a depth-first exploration from every root variable
+ *   not visited yet. Each element of the stack is a triple [z, y, i] where
+ *   z is a root variable, y is in the class of z, and i is the index of
+ *   the next edge to explore in vtbl->edges[y].
+ */
+static void build_fun_forest(fun_solver_t *solver) {
+  fun_forest_t *forest;
+  fun_vartable_t *vtbl;
+  ivector_t *stack;
+  int32_t *edges;
+  uint32_t i, j, n, ne, nv;
+  int32_t k, counter;
+  thvar_t x, y, z, w;
+
+  forest = &solver->forest;
+  vtbl = &solver->vtbl;
+  nv = vtbl->nvars;
+  ne = solver->etbl.nedges;
+  resize_fun_forest(forest, nv, ne);
+
+  forest->nedges = ne;
+  for (i=0; i<ne; i++) {
+    forest->child[i] = null_thvar;
+    forest->key[i] = edge_key(solver, i);
+    forest->sorted[i] = i;
+  }
+  int_array_sort2(forest->sorted, ne, forest, edge_key_lt);
+
+  for (i=0; i<nv; i++) {
+    forest->tin[i] = -1;
+  }
+
+  ivector_reset(&forest->nontree);
+  stack = &forest->stack;
+  assert(stack->size == 0);
+  counter = 0;
+
+  for (j=0; j<nv; j++) {
+    x = j;
+    if (vtbl->root[x] == x && forest->tin[x] < 0) {
+      forest->tin[x] = counter ++;
+      forest->top[x] = x;
+      ivector_push(stack, x);
+      ivector_push(stack, x);
+      ivector_push(stack, 0);
+
+      while (stack->size > 0) {
+        n = stack->size;
+        z = stack->data[n-3];
+        y = stack->data[n-2];
+        i = stack->data[n-1];
+        if (y == null_thvar) {
+          // done with z
+          forest->tout[z] = counter;
+          stack->size = n - 3;
+          continue;
+        }
+        edges = vtbl->edges[y];
+        if (edges == NULL || i >= iv_size(edges)) {
+          // move to the next element in z's class
+          stack->data[n-2] = vtbl->next[y];
+          stack->data[n-1] = 0;
+          continue;
+        }
+        stack->data[n-1] = i+1;
+        k = edges[i];
+        if (forest->child[k] != null_thvar) continue;
+
+        w = adjacent_root(solver, y, k);
+        if (w == z) {
+          forest->child[k] = -2;
+        } else if (forest->tin[w] < 0) {
+          // tree edge z ---> w
+          forest->child[k] = w;
+          forest->tin[w] = counter ++;
+          forest->top[w] = forest->top[x];
+          ivector_push(stack, w);
+          ivector_push(stack, w);
+          ivector_push(stack, 0);
+        } else {
+          forest->child[k] = -2;
+          ivector_push(&forest->nontree, k);
+        }
+      }
+    }
+  }
+}
+
+
+/*
+ * Union-find on pieces: the pieces are identified by root variables
+ */
+static thvar_t forest_find(fun_forest_t *forest, thvar_t x) {
+  thvar_t y;
+
+  if (forest->round[x] != forest->current) {
+    forest->round[x] = forest->current;
+    forest->uf[x] = x;
+    forest->first[x] = -1;
+    return x;
+  }
+
+  for (;;) {
+    y = forest->uf[x];
+    if (y == x) break;
+    forest->uf[x] = forest->uf[y];
+    x = y;
+  }
+  return x;
+}
+
+static void forest_union(fun_forest_t *forest, thvar_t x, thvar_t y) {
+  x = forest_find(forest, x);
+  y = forest_find(forest, y);
+  if (x != y) {
+    forest->uf[x] = y;
+  }
+}
+
+
+/*
+ * Piece of root variable x: lowest cut above x or the root of x's tree
+ * - cuts must be sorted by increasing tin
+ * - enclosing[i] = index of the lowest cut above cuts[i] (or -1)
+ */
+static thvar_t forest_piece(fun_forest_t *forest, thvar_t x) {
+  int32_t *cuts;
+  int32_t i, j, h, t;
+
+  cuts = forest->cuts.data;
+  t = forest->tin[x];
+
+  // find the last cut i such that tin[cuts[i]] <= t
+  i = -1;
+  j = forest->cuts.size;
+  while (j - i > 1) {
+    h = (i + j)/2;
+    if (forest->tin[cuts[h]] <= t) {
+      i = h;
+    } else {
+      j = h;
+    }
+  }
+
+  while (i >= 0 && t >= forest->tout[cuts[i]]) {
+    i = forest->enclosing.data[i];
+  }
+
+  return (i >= 0) ? cuts[i] : forest->top[x];
+}
+
+
+/*
+ * Split the forest into pieces for the arguments of the applications in v
+ * - all applications in v have the same arguments
+ * - on exit: reps.data[j] = piece of v[j] and first[reps.data[j]] is -2
+ *   if there are two applications not equal in the egraph in that piece
+ * - return true if there's such a piece
+ */
+static bool weak_equivalence_conflicts(fun_solver_t *solver, void **v) {
+  fun_forest_t *forest;
+  egraph_t *egraph;
+  composite_t *c;
+  ivector_t *cuts;
+  ivector_t *stack;
+  fun_edge_t *e;
+  uint32_t i, j, n, m, h;
+  int32_t k;
+  thvar_t x, r;
+  bool result;
+
+  forest = &solver->forest;
+  egraph = solver->egraph;
+  c = v[0];
+
+  if (forest->current == UINT32_MAX) {
+    for (i=0; i<forest->vsize; i++) {
+      forest->round[i] = 0;
+    }
+    forest->current = 0;
+  }
+  forest->current ++;
+
+  /*
+   * Cuts: lower endpoints of the tree edges that are masking for c
+   */
+  cuts = &forest->cuts;
+  ivector_reset(cuts);
+  h = app_key(egraph, c);
+  n = forest->nedges;
+  i = 0;
+  j = n;
+  while (i < j) {
+    m = (i + j)/2;
+    if (forest->key[forest->sorted[m]] < h) {
+      i = m+1;
+    } else {
+      j = m;
+    }
+  }
+  while (i < n && forest->key[forest->sorted[i]] == h) {
+    k = forest->sorted[i];
+    if (forest->child[k] >= 0 && masking_edge_any_type(solver, k, c)) {
+      ivector_push(cuts, forest->child[k]);
+    }
+    i ++;
+  }
+  int_array_sort2(cuts->data, cuts->size, forest, tin_lt);
+
+  // enclosing cuts
+  stack = &forest->stack;
+  assert(stack->size == 0);
+  ivector_reset(&forest->enclosing);
+  n = cuts->size;
+  for (i=0; i<n; i++) {
+    x = cuts->data[i];
+    while (stack->size > 0 && forest->tin[x] >= forest->tout[cuts->data[ivector_last(stack)]]) {
+      ivector_pop(stack);
+    }
+    ivector_push(&forest->enclosing, (stack->size > 0) ? ivector_last(stack) : -1);
+    ivector_push(stack, i);
+  }
+  ivector_reset(stack);
+
+  /*
+   * Merge the pieces connected by non-tree edges that are not masking
+   */
+  n = forest->nontree.size;
+  for (i=0; i<n; i++) {
+    k = forest->nontree.data[i];
+    if (! masking_edge_any_type(solver, k, c)) {
+      e = get_edge(&solver->etbl, k);
+      forest_union(forest, forest_piece(forest, solver->vtbl.root[e->source]),
+                   forest_piece(forest, solver->vtbl.root[e->target]));
+    }
+  }
+
+  /*
+   * Check the applications in each piece
+   */
+  result = false;
+  ivector_reset(&forest->reps);
+  m = ppv_size(v);
+  for (j=0; j<m; j++) {
+    r = forest_find(forest, forest_piece(forest, root_app_var(egraph, v[j])));
+    ivector_push(&forest->reps, r);
+    k = forest->first[r];
+    if (k == -1) {
+      forest->first[r] = j;
+    } else if (k >= 0 && !egraph_equal_apps(egraph, v[k], v[j])) {
+      forest->first[r] = -2;
+      result = true;
+    }
+  }
+
+  return result;
+}
+
+
 /*
  * Collect all applications and check for update conflicts
  * - the equivalence classes and roots must be set first
@@ -1752,9 +2258,10 @@ static bool update_conflicts(fun_solver_t *solver) {
   ppart_t *pp;
   void **v;
   composite_t *c;
-  uint32_t i, j, n, m;
+  uint32_t i, j, n, m, base;
+  int32_t k;
   thvar_t x;
-  bool result;
+  bool result, forest_ready;
   uint32_t num_updates;
 
   assert(solver->vtbl.nvars > 0);
@@ -1762,6 +2269,7 @@ static bool update_conflicts(fun_solver_t *solver) {
   // build the classes of relevant composites in the egraph
   egraph = solver->egraph;
   egraph_build_arg_partition(egraph);
+  forest_ready = false;
 
   // limit: one conflict per class
   result = false;
@@ -1775,10 +2283,34 @@ static bool update_conflicts(fun_solver_t *solver) {
     v = pp->classes[i];
     m = ppv_size(v);
     assert(m >= 2);
+    if (equal_applications(egraph, v)) continue;
+    if (! forest_ready) {
+      build_fun_forest(solver);
+      forest_ready = true;
+    }
+    if (! weak_equivalence_conflicts(solver, v)) continue;
+
+    /*
+     * Search only from the applications in a piece that has a conflict.
+     * The applications in v have the same arguments so they
+     * see the same masking edges: the search for v[j] can stop
+     * at any variable already explored for v[0] ... v[j-1].
+     */
+    base = reserve_visit_stamps(&solver->vtbl, m);
     for (j=0; j<m; j++) {
+      if (solver->forest.first[solver->forest.reps.data[j]] != -2) {
+        solver->vtbl.stamp ++;
+        continue;
+      }
       c = v[j];
       x = root_app_var(egraph, c);
-      if (update_conflict_for_application(solver, x, c)) {
+      k = update_conflict_for_application(solver, x, c, v, base, true);
+      if (k < 0) {
+        k = update_conflict_for_application(solver, x, c, v, base, false);
+        assert(k > 0);
+      }
+      solver->vtbl.stamp ++;
+      if (k > 0) {
         result = true;
         num_updates ++;
         // exit if max_update_conflicts is reached
@@ -1801,7 +2333,7 @@ static bool update_conflicts(fun_solver_t *solver) {
         congruence_table_is_root(&egraph->ctable, c, egraph->terms.label) &&
         ptr_partition_get_index(pp, c) >= 0) {
       x = root_app_var(egraph, c);
-      if (update_conflict_for_application(solver, x, c)) {
+      if (update_conflict_for_application(solver, x, c, NULL, 0, false) > 0) {
         result = true;
         num_updates ++;
         // exit if max_update_conflicts is reached
@@ -1868,6 +2400,7 @@ void init_fun_solver(fun_solver_t *solver, smt_core_t *core,
   init_fun_vartable(&solver->vtbl);
   init_edge_table(&solver->etbl);
   init_fun_queue(&solver->queue);
+  init_fun_forest(&solver->forest);
   init_diseq_stack(&solver->dstack);
   init_fun_trail_stack(&solver->trail_stack);
 
@@ -1897,6 +2430,7 @@ void delete_fun_solver(fun_solver_t *solver) {
   delete_fun_vartable(&solver->vtbl);
   delete_edge_table(&solver->etbl);
   delete_fun_queue(&solver->queue);
+  delete_fun_forest(&solver->forest);
   delete_diseq_stack(&solver->dstack);
   delete_fun_trail_stack(&solver->trail_stack);
 
@@ -1933,6 +2467,7 @@ void fun_solver_reset(fun_solver_t *solver) {
   reset_fun_vartable(&solver->vtbl);
   reset_edge_table(&solver->etbl);
   reset_fun_queue(&solver->queue);
+  reset_fun_forest(&solver->forest);
   reset_diseq_stack(&solver->dstack);
   reset_fun_trail_stack(&solver->trail_stack);
 
@@ -2148,6 +2683,7 @@ void fun_solver_clear(fun_solver_t *solver) {
  * - app[x] = NULL
  * - base[x] = -1;
  * - mark[x] = 0
+ * - visit[x] = 0
  * - root[x] and next[x] are not initialized
  */
 thvar_t fun_solver_create_var(fun_solver_t *solver, type_t tau) {
@@ -2167,6 +2703,7 @@ thvar_t fun_solver_create_var(fun_solver_t *solver, type_t tau) {
   vtbl->base[x] = -1;
   vtbl->app[x] = NULL;
   clr_bit(vtbl->mark, x);
+  vtbl->visit[x] = 0;
 
   return x;
 }
@@ -113,6 +113,12 @@ enum {
  *              that x and y are connected in the graph
  *     app[x] = if x is a root, vector of composite terms (used for model construction)
  *    mark[x] = bit used in propagation
+ *   visit[x] = stamp of the last search for update conflicts that explored x
+ *
+ * The stamps are used to share the weak-equivalence components between the
+ * searches for applications with the same arguments (cf. update_conflicts).
+ * The counter stamp is incremented on each search and visit[x] < stamp
+ * for all x outside of update_conflicts.
  */
 typedef struct fun_vartable_s {
   uint32_t size;
@@ -130,6 +136,8 @@ typedef struct fun_vartable_s {
   int32_t *base;
   void ***app;
   byte_t *mark;
+  uint32_t *visit;
+  uint32_t stamp;
 } fun_vartable_t;
 
 
@@ -159,6 +167,65 @@ typedef struct fun_queue_s {
 
 
 
+/*
+ * WEAK EQUIVALENCE
+ */
+
+/*
+ * Two applications c = (apply f i_1 ... i_n) and d = (apply g j_1 ... j_n)
+ * with the same arguments may conflict only if f and g are connected
+ * by a path that doesn't contain an edge labeled by [i_1 ... i_n].
+ * To find the argument tuples for which this may happen, we use a spanning
+ * forest of the graph whose vertices are the root variables:
+ * - removing the tree edges labeled by [i_1 ... i_n] splits the trees
+ *   into pieces. A piece is identified by the lower endpoint of the
+ *   removed edge or by the root of the tree.
+ * - the pieces are then merged using the other (non-tree) edges
+ *   that are not labeled by [i_1 ... i_n].
+ * If all the applications in the same piece are equal, there's no
+ * update conflict for this argument tuple.
+ *
+ * Forest: built at the beginning of update_conflicts
+ * - for a root variable x:
+ *     tin[x], tout[x] = interval of x in a depth-first numbering:
+ *                       y is in the subtree of x iff tin[x] <= tin[y] < tout[x]
+ *     top[x] = root of x's tree
+ *     uf[x], first[x], round[x] = used to merge the pieces for
+ *                       one argument tuple: uf[x] and first[x] are valid
+ *                       only if round[x] = current
+ * - for an edge k:
+ *     child[k] = lower endpoint if k is a tree edge,
+ *                null_thvar if k is not in the forest yet
+ *                -2 if k is a non-tree edge or a self loop
+ *     key[k] = hash code of the labels of k's indices
+ * - sorted = all edges sorted by key
+ * - nontree = non-tree edges
+ * - cuts, enclosing, reps, stack = buffers
+ */
+typedef struct fun_forest_s {
+  uint32_t vsize;
+  uint32_t esize;
+  int32_t *tin;
+  int32_t *tout;
+  thvar_t *top;
+  thvar_t *uf;
+  int32_t *first;
+  uint32_t *round;
+  thvar_t *child;
+  uint32_t *key;
+  int32_t *sorted;
+  uint32_t nedges;
+  uint32_t current;
+  ivector_t nontree;
+  ivector_t cuts;
+  ivector_t enclosing;
+  ivector_t reps;
+  ivector_t stack;
+} fun_forest_t;
+
+#define MAX_FUN_FOREST_SIZE (UINT32_MAX/8)
+
+
 /*
  * PUSH/POP STACK
  */
@@ -236,6 +303,7 @@ typedef struct fun_solver_s {
   fun_vartable_t vtbl;
   fun_edgetable_t etbl;
   fun_queue_t queue;
+  fun_forest_t forest;
   diseq_stack_t dstack;
 
   /*
@@ -1043,6 +1043,35 @@ void matrix_shrink(matrix_t *matrix, uint32_t n, uint32_t m) {
 
 
 
+/*
+ * Memory used by the rows and columns (not counting GMP numbers)
+ */
+uint64_t matrix_mem_size(matrix_t *matrix) {
+  uint64_t size;
+  uint32_t i, n;
+
+  size = (uint64_t) matrix->row_cap * (sizeof(row_t *) + sizeof(int32_t));
+  size += (uint64_t) matrix->column_cap * (sizeof(column_t *) + 2 * sizeof(int32_t));
+
+  n = matrix->nrows;
+  for (i=0; i<n; i++) {
+    if (matrix->row[i] != NULL) {
+      size += sizeof(row_t) + (uint64_t) matrix->row[i]->capacity * sizeof(row_elem_t);
+    }
+  }
+
+  n = matrix->ncolumns;
+  for (i=0; i<n; i++) {
+    if (matrix->column[i] != NULL) {
+      size += sizeof(column_t) + (uint64_t) matrix->column[i]->capacity * sizeof(col_elem_t);
+    }
+  }
+
+  return size;
+}
+
+
+
 /*
  * REMOVAL OF FIXED VARIABLES
  */
@@ -401,6 +401,11 @@ extern void matrix_add_tableau_eq(matrix_t *matrix, int32_t x, monomial_t *a, ui
  */
 extern void matrix_shrink(matrix_t *matrix, uint32_t n, uint32_t m);
 
+/*
+ * Estimate of the memory used by the matrix (in bytes)
+ */
+extern uint64_t matrix_mem_size(matrix_t *matrix);
+
 
 /*
  * ACCESS TO MATRIX COMPONENTS
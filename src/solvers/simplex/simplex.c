@@ -594,6 +594,100 @@ static void delete_saved_rows(pvector_t *v, uint32_t n) {
 }
 
 
+/*************************
+ *  BRANCH PSEUDO-COSTS  *
+ ************************/
+
+/*
+ * Initialize: use the default size
+ */
+static void init_branch_pcost(branch_pcost_t *pc) {
+  uint32_t n;
+
+  n = DEF_BRANCH_PCOST_SIZE;
+  assert(n < MAX_BRANCH_PCOST_SIZE);
+
+  pc->size = n;
+  pc->nvars = 0;
+  pc->count = (uint32_t *) safe_malloc(n * sizeof(uint32_t));
+  pc->gain = (double *) safe_malloc(n * sizeof(double));
+  pc->total_gain = 0.0;
+  pc->total_count = 0;
+  pc->last_var = null_thvar;
+  pc->last_ninvalid = 0;
+}
+
+
+/*
+ * Make sure the arrays are valid for variables 0 to n-1
+ * - the counters of all new variables are set to zero
+ */
+static void branch_pcost_resize(branch_pcost_t *pc, uint32_t n) {
+  uint32_t i, new_size;
+
+  if (n > pc->size) {
+    new_size = pc->size + 1;
+    new_size += new_size >> 1;
+    if (new_size < n) new_size = n;
+
+    if (new_size >= MAX_BRANCH_PCOST_SIZE) {
+      out_of_memory();
+    }
+
+    pc->count = (uint32_t *) safe_realloc(pc->count, new_size * sizeof(uint32_t));
+    pc->gain = (double *) safe_realloc(pc->gain, new_size * sizeof(double));
+    pc->size = new_size;
+  }
+
+  for (i=pc->nvars; i<n; i++) {
+    pc->count[i] = 0;
+    pc->gain[i] = 0.0;
+  }
+  if (n > pc->nvars) {
+    pc->nvars = n;
+  }
+}
+
+
+/*
+ * Forget the pseudo-costs of variables n, n+1, ...
+ * - this must be called when these variables are deleted (on pop)
+ */
+static void branch_pcost_remove_vars(branch_pcost_t *pc, uint32_t n) {
+  if (n < pc->nvars) {
+    pc->nvars = n;
+  }
+  if (pc->last_var >= (int32_t) n) {
+    pc->last_var = null_thvar;
+  }
+}
+
+
+/*
+ * Empty the table
+ */
+static void reset_branch_pcost(branch_pcost_t *pc) {
+  pc->nvars = 0;
+  pc->total_gain = 0.0;
+  pc->total_count = 0;
+  pc->last_var = null_thvar;
+  pc->last_ninvalid = 0;
+}
+
+
+/*
+ * Delete
+ */
+static void delete_branch_pcost(branch_pcost_t *pc) {
+  safe_free(pc->count);
+  safe_free(pc->gain);
+  pc->count = NULL;
+  pc->gain = NULL;
+}
+
+
+
+
 /***********************
  *  STATISTICS RECORD  *
  **********************/
@@ -640,6 +734,14 @@ static void init_simplex_statistics(simplex_stats_t *stat) {
   stat->num_dioph_recheck_conflicts = 0;
 
   stat->num_branch_atoms = 0;
+  stat->num_branch_nodes = 0;
+  stat->num_pcost_branches = 0;
+  stat->num_presolve_bounds = 0;
+  stat->num_presolve_conflicts = 0;
+  stat->num_strengthen_rounds = 0;
+  stat->num_cube_tests = 0;
+  stat->num_cube_successes = 0;
+  reset_cycle_timer(&stat->intfeas_timer);
 }
 
 
@@ -1594,6 +1696,7 @@ void init_simplex_solver(simplex_solver_t *solver, smt_core_t *core, gate_manage
   solver->check_counter = 0;
   solver->check_period = SIMPLEX_DEFAULT_CHECK_PERIOD;
   solver->last_branch_atom = null_bvar;
+  init_branch_pcost(&solver->pcost);
   solver->dsolver = NULL;     // allocated later if needed
 
   solver->cache = NULL;       // allocated later if needed
@@ -4495,6 +4598,7 @@ static void simplex_report_conflict(simplex_solver_t *solver) {
 #endif
   // record expl_vector as a conflict (first add the null-literal terminator)
   ivector_push(v, null_literal);
+  smt_log_theory_conflict(solver->core, ETRACE_SIMPLEX, v->size - 1);
   record_theory_conflict(solver->core, v->data);
 
   solver->stats.num_conflicts ++;
@@ -4726,6 +4830,7 @@ static void record_simple_conflict(simplex_solver_t *solver, int32_t k, literal_
 #endif
   // add the end marker
   ivector_push(v, null_literal);
+  smt_log_theory_conflict(solver->core, ETRACE_SIMPLEX, v->size - 1);
   record_theory_conflict(solver->core, v->data);
 
   solver->stats.num_conflicts ++;
@@ -5224,6 +5329,7 @@ static void record_derived_conflict(simplex_solver_t *solver, int32_t j, ivector
 
   convert_expl_to_clause(v);
   ivector_push(v, null_literal);
+  smt_log_theory_conflict(solver->core, ETRACE_SIMPLEX, v->size - 1);
   record_theory_conflict(solver->core, v->data);
 
   solver->stats.num_conflicts ++;
@@ -5847,24 +5953,21 @@ static bool simplex_strengthen_bounds_on_basic_vars(simplex_solver_t *solver) {
  * - one pass for the non-basic variables + one pass for the basic variables
  */
 static bool simplex_strengthen_bounds(simplex_solver_t *solver) {
+  solver->stats.num_strengthen_rounds ++;
   return simplex_strengthen_bounds_on_non_basic_vars(solver) && simplex_strengthen_bounds_on_basic_vars(solver);
 }
 
 
-#if 0
-
-// NOT USED
 /*
  * Several rounds of strengthening
- * - MAX_STRENGTHEN_ITERS  = maximal number of rounds
+ * - max_rounds = maximal number of rounds
+ * - we stop earlier if a round doesn't find any new bound (fix-point)
  * - the function returns false if bound strengthening caused a conflict
  */
-#define MAX_STRENGTHEN_ITERS 2
-
-static bool simplex_strengthen_bounds_iter(simplex_solver_t *solver) {
+static bool simplex_strengthen_bounds_rounds(simplex_solver_t *solver, uint32_t max_rounds) {
   uint32_t nb, i;
 
-  for (i=0; i<MAX_STRENGTHEN_ITERS; i++) {
+  for (i=0; i<max_rounds; i++) {
     nb = solver->bstack.top;
     if (!simplex_strengthen_bounds(solver)) return false;
     // quit if the last round didn't find any new bound
@@ -5874,7 +5977,16 @@ static bool simplex_strengthen_bounds_iter(simplex_solver_t *solver) {
   return true;
 }
 
-#endif
+
+/*
+ * Rounds of strengthening during integer solving
+ * - MAX_STRENGTHEN_ITERS  = maximal number of rounds
+ */
+#define MAX_STRENGTHEN_ITERS 2
+
+static bool simplex_strengthen_bounds_iter(simplex_solver_t *solver) {
+  return simplex_strengthen_bounds_rounds(solver, MAX_STRENGTHEN_ITERS);
+}
 
 
 /******************************
@@ -7048,6 +7160,215 @@ static bool simplex_try_naive_integer_search(simplex_solver_t *solver) {
 
 
 
+/*
+ * CUBE TEST
+ */
+
+/*
+ * The largest-cube test looks for a solution p of the relaxation such
+ * that the unit cube centered on p fits in the polyhedron. Then rounding
+ * p to the nearest integer point gives an integer solution. We use a
+ * cheap version of this test: p is the current assignment and we check
+ * directly whether rounding p gives a solution.
+ *
+ * Rounding is done on the free integer variables (i.e., variables
+ * that don't have a polynomial definition). The value of a variable x
+ * defined by a polynomial is then recomputed from x's definition. The
+ * result is a solution if it satisfies all the rows and all the bounds.
+ *
+ * We give up if some variable is a product or if a definition depends
+ * on a variable that was eliminated from the tableau (the value of an
+ * eliminated variable is computed when the model is built).
+ */
+
+/*
+ * Compute the candidate assignment in array val
+ * - elim = bitvector: elim[x] is set if x is eliminated
+ * - return false if we give up
+ */
+static bool cube_test_assignment(simplex_solver_t *solver, byte_t *elim, xrational_t *val) {
+  arith_vartable_t *vtbl;
+  polynomial_t *p;
+  rational_t *half;
+  uint32_t i, j, n, m;
+  thvar_t y;
+
+  vtbl = &solver->vtbl;
+  half = &solver->aux;
+  q_set_int32(half, 1, 2);
+
+  assert(xq_is_one(arith_var_value(vtbl, const_idx)));
+  xq_set_one(val + const_idx);
+
+  n = vtbl->nvars;
+  for (i=1; i<n; i++) {
+    if (tst_bit(elim, i)) continue;
+
+    switch (arith_var_kind(vtbl, i)) {
+    case AVAR_FREE:
+      xq_set(val + i, arith_var_value(vtbl, i));
+      if (arith_var_is_int(vtbl, i)) {
+        // round to the nearest integer
+        xq_add_q(val + i, half);
+        xq_floor(val + i);
+      }
+      break;
+
+    case AVAR_POLY:
+      // the definition of x only contains variables smaller than x
+      p = arith_var_poly_def(vtbl, i);
+      xq_clear(val + i);
+      m = p->nterms;
+      for (j=0; j<m; j++) {
+        y = p->mono[j].var;
+        assert(y < i);
+        if (tst_bit(elim, y)) return false;
+        xq_addmul(val + i, val + y, &p->mono[j].coeff);
+      }
+      break;
+
+    default:
+      return false;
+    }
+  }
+
+  return true;
+}
+
+
+/*
+ * Check whether the assignment in val satisfies all the rows and bounds
+ * and gives an integer value to all the integer variables.
+ */
+static bool cube_test_check(simplex_solver_t *solver, byte_t *elim, xrational_t *val) {
+  arith_vartable_t *vtbl;
+  matrix_t *matrix;
+  xrational_t *sum;
+  row_t *row;
+  uint32_t i, j, n, m;
+  int32_t k;
+  thvar_t x;
+
+  vtbl = &solver->vtbl;
+  n = vtbl->nvars;
+  for (i=1; i<n; i++) {
+    if (tst_bit(elim, i)) continue;
+
+    if (arith_var_is_int(vtbl, i) && !xq_is_integer(val + i)) {
+      return false;
+    }
+    k = arith_var_lower_index(vtbl, i);
+    if (k >= 0 && xq_lt(val + i, solver->bstack.bound + k)) {
+      return false;
+    }
+    k = arith_var_upper_index(vtbl, i);
+    if (k >= 0 && xq_gt(val + i, solver->bstack.bound + k)) {
+      return false;
+    }
+  }
+
+  sum = &solver->xq0;
+  matrix = &solver->matrix;
+  n = matrix->nrows;
+  for (i=0; i<n; i++) {
+    row = matrix->row[i];
+    xq_clear(sum);
+    m = row->size;
+    for (j=0; j<m; j++) {
+      x = row->data[j].c_idx;
+      if (x >= 0) {
+        xq_addmul(sum, val + x, &row->data[j].coeff);
+      }
+    }
+    if (! xq_is_zero(sum)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+
+/*
+ * Copy the assignment in val into the variable table
+ * - the assignment must be feasible
+ * - we must also update the bound tags on the non-basic variables
+ */
+static void cube_test_install(simplex_solver_t *solver, byte_t *elim, xrational_t *val) {
+  arith_vartable_t *vtbl;
+  uint32_t i, n;
+
+  vtbl = &solver->vtbl;
+  n = vtbl->nvars;
+  for (i=1; i<n; i++) {
+    if (tst_bit(elim, i)) continue;
+
+    set_arith_var_value(vtbl, i, val + i);
+    if (matrix_is_nonbasic_var(&solver->matrix, i)) {
+      if (variable_at_lower_bound(solver, i)) {
+        set_arith_var_lb(vtbl, i);
+      } else {
+        clear_arith_var_lb(vtbl, i);
+      }
+      if (variable_at_upper_bound(solver, i)) {
+        set_arith_var_ub(vtbl, i);
+      } else {
+        clear_arith_var_ub(vtbl, i);
+      }
+    }
+  }
+}
+
+
+/*
+ * Cube test: return true if an integer solution is found
+ * - the solution is stored as the current assignment
+ */
+static bool simplex_cube_test(simplex_solver_t *solver) {
+  xrational_t *val;
+  byte_t *elim;
+  uint32_t i, n;
+  bool ok;
+
+  solver->stats.num_cube_tests ++;
+
+  n = solver->vtbl.nvars;
+  elim = allocate_bitvector0(n);
+  n = solver->elim.nrows;
+  for (i=0; i<n; i++) {
+    set_bit(elim, solver->elim.base_var[i]);
+  }
+
+  n = solver->vtbl.nvars;
+  val = (xrational_t *) safe_malloc(n * sizeof(xrational_t));
+  for (i=0; i<n; i++) {
+    xq_init(val + i);
+  }
+
+  ok = cube_test_assignment(solver, elim, val) && cube_test_check(solver, elim, val);
+  if (ok) {
+    assert(int_heap_is_empty(&solver->infeasible_vars));
+    cube_test_install(solver, elim, val);
+    solver->stats.num_cube_successes ++;
+
+#if DEBUG
+    check_assignment(solver);
+    check_vartags(solver);
+#endif
+    assert(simplex_assignment_integer_valid(solver));
+  }
+
+  for (i=0; i<n; i++) {
+    xq_clear(val + i);
+  }
+  safe_free(val);
+  delete_bitvector(elim);
+
+  return ok;
+}
+
+
+
 /*
  * BRANCHING
  */
@@ -7316,14 +7637,66 @@ static uint32_t simplex_branch_score(simplex_solver_t *solver, thvar_t x) {
 #endif
 
 
+/*
+ * Pseudo-costs: record the gain of the last branch
+ * - ninvalid = number of integer-infeasible variables now
+ *   (0 if the branch led to a conflict or to an integer solution)
+ */
+static void record_branch_gain(simplex_solver_t *solver, uint32_t ninvalid) {
+  branch_pcost_t *pc;
+  double gain;
+  thvar_t x;
+
+  pc = &solver->pcost;
+  x = pc->last_var;
+  if (x != null_thvar) {
+    assert(pc->last_ninvalid > 0);
+    gain = 0.0;
+    if (ninvalid < pc->last_ninvalid) {
+      gain = ((double) (pc->last_ninvalid - ninvalid))/pc->last_ninvalid;
+    }
+    branch_pcost_resize(pc, solver->vtbl.nvars);
+    pc->count[x] ++;
+    pc->gain[x] += gain;
+    pc->total_count ++;
+    pc->total_gain += gain;
+    pc->last_var = null_thvar;
+  }
+}
+
+
+/*
+ * Pseudo-cost of x: average gain of the branches on x
+ * - this is reliable if we have PCOST_RELIABILITY samples or more
+ * - otherwise, we use the average over all variables
+ */
+#define PCOST_RELIABILITY 4
+
+static inline bool reliable_pcost(branch_pcost_t *pc, thvar_t x) {
+  return (uint32_t) x < pc->nvars && pc->count[x] >= PCOST_RELIABILITY;
+}
+
+static double branch_pcost(branch_pcost_t *pc, thvar_t x) {
+  if (reliable_pcost(pc, x)) {
+    return pc->gain[x]/pc->count[x];
+  }
+  if (pc->total_count > 0) {
+    return pc->total_gain/pc->total_count;
+  }
+  return 0.0;
+}
+
+
 /*
  * Select a branch variable of v: pick the one with smallest score.
- * Break ties randomly.
+ * Break ties using pseudo-costs (pick the variable with the largest
+ * expected gain) then randomly.
  * - return the selected variable
  * - score its score in *var_score
  */
 static thvar_t select_branch_variable(simplex_solver_t *solver, ivector_t *v, uint32_t *var_score) {
   uint32_t i, n, best_score, score, k;
+  double best_pcost, pcost;
   thvar_t x, best_var;
 
 #if TRACE_INTFEAS
@@ -7337,6 +7710,7 @@ static thvar_t select_branch_variable(simplex_solver_t *solver, ivector_t *v, ui
 #endif
 
   best_score = MAX_BRANCH_SCORE;
+  best_pcost = 0.0;
   best_var = null_thvar;
   k = 0;
 
@@ -7344,19 +7718,25 @@ static thvar_t select_branch_variable(simplex_solver_t *solver, ivector_t *v, ui
   for (i=0; i<n; i++) {
     x = v->data[i];
     score = simplex_branch_score(solver, x);
-    if (score < best_score) {
+    pcost = branch_pcost(&solver->pcost, x);
+    if (score < best_score || (score == best_score && pcost > best_pcost) || best_var < 0) {
       best_score = score;
+      best_pcost = pcost;
       best_var = x;
       k = 1;
-    } else if (score == best_score) {
+    } else if (score == best_score && pcost == best_pcost) {
       // break ties randomly
       k ++;
-      if (best_var < 0 || random_uint(solver, k) == 0) {
+      if (random_uint(solver, k) == 0) {
         best_var = x;
       }
     }
   }
 
+  if (reliable_pcost(&solver->pcost, best_var)) {
+    solver->stats.num_pcost_branches ++;
+  }
+
   *var_score = best_score;
   return best_var;
 }
@@ -7450,6 +7830,7 @@ static void build_gcd_conflict(simplex_solver_t *solver, row_t *row) {
   ivector_push(v, null_literal);
 
   // record v as a conflict
+  smt_log_theory_conflict(solver->core, ETRACE_SIMPLEX, v->size - 1);
   record_theory_conflict(solver->core, v->data);
 
   solver->stats.num_dioph_gcd_conflicts ++;
@@ -7481,6 +7862,7 @@ static void build_dsolver_conflict(simplex_solver_t *solver, ivector_t *v) {
   convert_expl_to_clause(w);
   ivector_push(w, null_literal);
 
+  smt_log_theory_conflict(solver->core, ETRACE_SIMPLEX, w->size - 1);
   record_theory_conflict(solver->core, w->data);
 
   solver->stats.num_dioph_conflicts ++;
@@ -7919,6 +8301,7 @@ static void build_integrality_conflict(simplex_solver_t *solver, thvar_t *a, uin
   ivector_push(v, null_literal);
 
   // record v as a conflict
+  smt_log_theory_conflict(solver->core, ETRACE_SIMPLEX, v->size - 1);
   record_theory_conflict(solver->core, v->data);
 }
 
@@ -8839,15 +9222,12 @@ static bool simplex_intfeas_diophantine_check(simplex_solver_t *solver) {
   return intfeas_wrapper(solver, "diophantine solver", simplex_dsolver_check);
 }
 
-#if 0
-// NOT USED
 /*
  * Iterated bound strengthening
  */
 static bool simplex_intfeas_iter_strengthening(simplex_solver_t *solver) {
-  return intfeas_wrapper(solver, "strengthening", simplex_strengthen_bounds_iter);
+  return intfeas_wrapper(solver, "iterated strengthening", simplex_strengthen_bounds_iter);
 }
-#endif
 
 /*
  * Check whether the current set of constraints is integer feasible
@@ -8872,6 +9252,7 @@ static bool simplex_make_integer_feasible(simplex_solver_t *solver) {
 #endif
 
   if (simplex_assignment_integer_valid(solver)) {
+    record_branch_gain(solver, 0);
     return true;
   }
 
@@ -8896,10 +9277,10 @@ static bool simplex_make_integer_feasible(simplex_solver_t *solver) {
    * Try bound strengthening + integrality test + diophantine check
    */
   nbounds = solver->bstack.top;
-  if (! simplex_intfeas_strengthening(solver)) return false;
-  if (! simplex_intfeas_integrality_constraints(solver)) return false;
-  if (! simplex_intfeas_diophantine_check(solver)) return false;
-  if (! simplex_intfeas_strengthening(solver)) return false;
+  if (! simplex_intfeas_strengthening(solver)) goto conflict;
+  if (! simplex_intfeas_integrality_constraints(solver)) goto conflict;
+  if (! simplex_intfeas_diophantine_check(solver)) goto conflict;
+  if (! simplex_intfeas_strengthening(solver)) goto conflict;
 
   /*
    * TRY OUR LUCK
@@ -8907,16 +9288,27 @@ static bool simplex_make_integer_feasible(simplex_solver_t *solver) {
   if (underconstrained(solver)) {
     if (simplex_try_naive_integer_search(solver)) {
       trace_printf(solver->core->trace, 10, "(feasible by naive search)\n");
+      record_branch_gain(solver, 0);
       return true;
     }
   }
 
   /*
    * If we've learned new bounds in the previous phases,
-   * try more rounds of bound strengthening.
+   * try more rounds of bound strengthening (until a fix-point
+   * or MAX_STRENGTHEN_ITERS rounds).
    */
-  if (solver->bstack.top > nbounds && !simplex_intfeas_strengthening(solver)) {
-    return false;
+  if (solver->bstack.top > nbounds && !simplex_intfeas_iter_strengthening(solver)) {
+    goto conflict;
+  }
+
+  /*
+   * Cube test: rounding may give an integer solution
+   */
+  if (simplex_cube_test(solver)) {
+    trace_printf(solver->core->trace, 10, "(feasible by cube test)\n");
+    record_branch_gain(solver, 0);
+    return true;
   }
 
 
@@ -8934,17 +9326,22 @@ static bool simplex_make_integer_feasible(simplex_solver_t *solver) {
   assert(v->size == 0);
   collect_non_integer_basic_vars(solver, v);
   if (v->size == 0) {
+    record_branch_gain(solver, 0);
     return true;
   }
 
   /*
    * Create a branch atom or add gomory cuts
    */
+  record_branch_gain(solver, v->size);
   x = select_branch_variable(solver, v, &bb_score);
   trace_printf(solver->core->trace, 10,
 	       "(branch & bound: %"PRIu32" candidates, branch variable = i!%"PRIu32", score = %"PRIu32")\n",
 	       v->size, x, bb_score);
   create_branch_atom(solver, x);
+  solver->stats.num_branch_nodes ++;
+  solver->pcost.last_var = x;
+  solver->pcost.last_ninvalid = v->size;
 
 #if TRACE_INTFEAS
   print_branch_candidates(stdout, solver, v);
@@ -8957,6 +9354,10 @@ static bool simplex_make_integer_feasible(simplex_solver_t *solver) {
   assert(x != null_thvar);
 
   return false;
+
+ conflict:
+  record_branch_gain(solver, 0);
+  return false;
 }
 
 
@@ -8998,6 +9399,7 @@ static void record_egraph_eq_conflict(simplex_solver_t *solver, int32_t k, thvar
   printf("\n---> SIMPLEX CONFLICT on g!%"PRId32" == g!%"PRId32" (conflict with bound)\n",
 	 arith_var_eterm(&solver->vtbl, x1), arith_var_eterm(&solver->vtbl, x2));
 #endif
+  smt_log_theory_conflict(solver->core, ETRACE_SIMPLEX, v->size - 1);
   record_theory_conflict(solver->core, v->data);
 
   solver->stats.num_conflicts ++;
@@ -9552,6 +9954,40 @@ void simplex_start_internalization(simplex_solver_t *solver) {
  *  START SEARCH  *
  *****************/
 
+/*
+ * Presolve for integer problems: tighten the bounds by propagation
+ * - we run rounds of bound strengthening until a fix-point is reached
+ *   or after MAX_PRESOLVE_ROUNDS rounds
+ * - the new bounds are derived at the base level so they are kept
+ *   for the whole search
+ * - return false if a conflict is detected
+ */
+#define MAX_PRESOLVE_ROUNDS 10
+
+static bool simplex_presolve_bounds(simplex_solver_t *solver) {
+  uint32_t nbounds;
+
+  nbounds = solver->bstack.top;
+  solver->recheck = false;
+  if (! simplex_strengthen_bounds_rounds(solver, MAX_PRESOLVE_ROUNDS)) {
+    trace_printf(solver->core->trace, 10, "(unsat by presolve)\n");
+    solver->stats.num_presolve_conflicts ++;
+    return false;
+  }
+
+  solver->stats.num_presolve_bounds += solver->bstack.top - nbounds;
+  trace_printf(solver->core->trace, 10, "(presolve: %"PRIu32" new bounds)\n", solver->bstack.top - nbounds);
+
+  if (solver->recheck) {
+    simplex_fix_nonbasic_assignment(solver);
+    return simplex_make_feasible(solver);
+  }
+
+  solver->bstack.fix_ptr = solver->bstack.top;
+  return true;
+}
+
+
 /*
  * Start search:
  * - simplify the matrix
@@ -9635,6 +10071,13 @@ void simplex_start_search(simplex_solver_t *solver) {
   if (! feasible) goto done;
 
   solver->last_conflict_row = -1;
+  solver->pcost.last_var = null_thvar;
+
+  // tighten the bounds on integer variables
+  if (simplex_has_integer_vars(solver)) {
+    feasible = simplex_presolve_bounds(solver);
+    if (! feasible) goto done;
+  }
 
   // integer solving flags
   // enable_dfeas is used in simplex_dsolver_check
@@ -9881,6 +10324,9 @@ bool simplex_propagate(simplex_solver_t *solver) {
  * Check for integer feasibility
  */
 fcheck_code_t simplex_final_check(simplex_solver_t *solver) {
+  uint64_t start;
+  bool feasible;
+
 #if DEBUG
   check_assignment(solver);
   check_integer_bounds(solver);
@@ -9895,7 +10341,10 @@ fcheck_code_t simplex_final_check(simplex_solver_t *solver) {
 #endif
 
   if (simplex_has_integer_vars(solver)) {
-    if (simplex_make_integer_feasible(solver)) {
+    start = timer_start();
+    feasible = simplex_make_integer_feasible(solver);
+    timer_stop(&solver->stats.intfeas_timer, start);
+    if (feasible) {
       return FCHECK_SAT;
     } else {
       //      printf("---> not integer feasible\n");
@@ -10336,6 +10785,7 @@ void simplex_pop(simplex_solver_t *solver) {
   top = arith_trail_top(&solver->trail_stack);
   delete_saved_rows(&solver->saved_rows, top->nsaved_rows);
   arith_vartable_remove_vars(&solver->vtbl, top->nvars);
+  branch_pcost_remove_vars(&solver->pcost, top->nvars);
   simplex_detach_dead_atoms(solver, top->natoms);
   arith_atomtable_remove_atoms(&solver->atbl, top->natoms);
   simplex_remove_dead_eterms(solver);
@@ -10404,6 +10854,7 @@ void simplex_reset(simplex_solver_t *solver) {
 
   reset_arith_atomtable(&solver->atbl);
   reset_arith_vartable(&solver->vtbl);
+  reset_branch_pcost(&solver->pcost);
 
   reset_matrix(&solver->matrix);
   solver->tableau_ready = false;
@@ -10646,6 +11097,7 @@ void delete_simplex_solver(simplex_solver_t *solver) {
 
   delete_arith_atomtable(&solver->atbl);
   delete_arith_vartable(&solver->vtbl);
+  delete_branch_pcost(&solver->pcost);
 
   if (solver->eqprop != NULL) {
     simplex_delete_eqprop(solver);
@@ -12450,6 +12902,319 @@ bool simplex_var_is_integer(simplex_solver_t *solver, int32_t x) {
 
 
 
+/******************
+ *  OPTIMIZATION  *
+ *****************/
+
+/*
+ * Ratio test for a non-basic variable y that moves in direction dir
+ * (dir > 0 means that y increases, dir < 0 means that y decreases).
+ * - the step is limited by the bound on y and by the bounds on
+ *   all basic variables that depend on y
+ * - if there's no limit, the function returns false
+ * - otherwise, it returns true and stores the maximal step in *t
+ *   and the blocking variable in *z. If several variables block
+ *   the step first, *z is the one with smallest index (Bland's rule).
+ *   If *z is a basic variable, *r is its row, otherwise *r = -1.
+ */
+static bool simplex_ratio_test(simplex_solver_t *solver, thvar_t y, int32_t dir, xrational_t *t,
+                               thvar_t *z, int32_t *r) {
+  arith_vartable_t *vtbl;
+  matrix_t *matrix;
+  column_t *col;
+  rational_t *a;
+  xrational_t *ratio;
+  uint32_t i, n;
+  int32_t k, row;
+  thvar_t u;
+  bool bounded, up;
+
+  assert(matrix_is_nonbasic_var(&solver->matrix, y) && dir != 0);
+
+  vtbl = &solver->vtbl;
+  matrix = &solver->matrix;
+  ratio = &solver->xq0;
+
+  bounded = false;
+  *z = null_thvar;
+  *r = -1;
+
+  // bound on y
+  k = (dir > 0) ? arith_var_upper_index(vtbl, y) : arith_var_lower_index(vtbl, y);
+  if (k >= 0) {
+    xq_set(t, solver->bstack.bound + k);
+    xq_sub(t, arith_var_value(vtbl, y));
+    if (dir < 0) xq_neg(t);
+    *z = y;
+    bounded = true;
+  }
+
+  col = matrix->column[y];
+  if (col != NULL) {
+    n = col->size;
+    for (i=0; i<n; i++) {
+      row = col->data[i].r_idx;
+      if (row >= 0) {
+        u = matrix_basic_var(matrix, row);
+        a = matrix_coeff(matrix, row, col->data[i].r_ptr);
+        /*
+         * row is u + ... + a.y + ... = 0 so u changes by -a * (change of y)
+         */
+        up = (dir > 0) ? q_is_neg(a) : q_is_pos(a);
+        k = up ? arith_var_upper_index(vtbl, u) : arith_var_lower_index(vtbl, u);
+        if (k >= 0) {
+          // ratio = (bound - value[u]) / (-a * dir)
+          xq_set(ratio, solver->bstack.bound + k);
+          xq_sub(ratio, arith_var_value(vtbl, u));
+          xq_div(ratio, a);
+          if (dir > 0) xq_neg(ratio);
+          assert(xq_sgn(ratio) >= 0);
+
+          if (!bounded || xq_lt(ratio, t) || (xq_eq(ratio, t) && u < *z)) {
+            xq_set(t, ratio);
+            *z = u;
+            *r = row;
+            bounded = true;
+          }
+        }
+      }
+    }
+  }
+
+  return bounded;
+}
+
+
+/*
+ * Move the non-basic variable y by dir * t and pivot if needed
+ * - z and r are the blocking variable and row returned by the ratio test
+ * - if z is a basic variable, y enters the basis and z leaves it
+ *   (z is then at its bound).
+ */
+static void simplex_opt_step(simplex_solver_t *solver, thvar_t y, int32_t dir, thvar_t z, int32_t r) {
+  matrix_t *matrix;
+  column_t *col;
+  uint32_t i, n;
+  int32_t k;
+  bool up;
+
+  matrix = &solver->matrix;
+
+  if (z == y) {
+    // y stays non-basic: move it to its bound
+    if (dir > 0) {
+      update_to_upper_bound(solver, y);
+    } else {
+      update_to_lower_bound(solver, y);
+    }
+    return;
+  }
+
+  assert(r >= 0 && matrix_basic_var(matrix, r) == z);
+
+  // find the position of y in row r
+  col = matrix->column[y];
+  n = col->size;
+  k = -1;
+  for (i=0; i<n; i++) {
+    if (col->data[i].r_idx == r) {
+      k = col->data[i].r_ptr;
+      break;
+    }
+  }
+  assert(k >= 0);
+
+  // z moves up iff the coefficient of y and dir have opposite signs
+  up = (dir > 0) ? q_is_neg(matrix_coeff(matrix, r, k)) : q_is_pos(matrix_coeff(matrix, r, k));
+
+  /*
+   * Pivot then move z to its bound. This takes care of updating
+   * the value of y and of all the basic variables.
+   */
+  matrix_pivot(matrix, r, k);
+  if (up) {
+    update_to_upper_bound(solver, z);
+  } else {
+    update_to_lower_bound(solver, z);
+  }
+  solver->stats.num_pivots ++;
+}
+
+
+/*
+ * Search for a non-basic variable in row that can move x in direction dir
+ * - x = basic variable of that row
+ * - return the index in row of the smallest such variable (Bland's rule)
+ *   or -1 if there's none.
+ */
+static int32_t find_improving_var(simplex_solver_t *solver, row_t *row, thvar_t x, int32_t dir) {
+  arith_vartable_t *vtbl;
+  uint32_t i, n;
+  thvar_t y, best;
+  int32_t best_i;
+  bool ok;
+
+  vtbl = &solver->vtbl;
+  best = null_thvar;
+  best_i = -1;
+  n = row->size;
+  for (i=0; i<n; i++) {
+    y = row->data[i].c_idx;
+    if (y >= 0 && y != x && (best_i < 0 || y < best)) {
+      if (dir > 0) {
+        ok = possible_entering_var_for_increase(vtbl, y, &row->data[i].coeff);
+      } else {
+        ok = possible_entering_var_for_decrease(vtbl, y, &row->data[i].coeff);
+      }
+      if (ok) {
+        best = y;
+        best_i = i;
+      }
+    }
+  }
+
+  return best_i;
+}
+
+
+/*
+ * Primal simplex on the current tableau for variable x
+ * - dir > 0 means maximize x, dir < 0 means minimize x
+ * - the current assignment must be feasible
+ */
+static simplex_opt_code_t simplex_primal_optimize(simplex_solver_t *solver, thvar_t x, int32_t dir) {
+  arith_vartable_t *vtbl;
+  matrix_t *matrix;
+  row_t *row;
+  xrational_t t;
+  thvar_t y, z;
+  int32_t r, k, ydir;
+  simplex_opt_code_t code;
+
+  vtbl = &solver->vtbl;
+  matrix = &solver->matrix;
+
+  /*
+   * If x is not basic and doesn't have atoms or bounds, it may
+   * have been eliminated from the matrix. We can't optimize it then.
+   */
+  if (matrix_is_nonbasic_var(matrix, x) && arith_var_num_atoms(vtbl, x) == 0 &&
+      simplex_free_variable(solver, x)) {
+    return SIMPLEX_OPT_UNKNOWN;
+  }
+
+  xq_init(&t);
+  code = SIMPLEX_OPT_UNKNOWN;
+
+  for (;;) {
+    if (solver->interrupted) {
+      code = SIMPLEX_OPT_UNKNOWN;
+      break;
+    }
+
+    r = matrix_basic_row(matrix, x);
+    if (r < 0) {
+      // x is non-basic: try to move x directly
+      if ((dir > 0 && variable_at_upper_bound(solver, x)) ||
+          (dir < 0 && variable_at_lower_bound(solver, x))) {
+        code = SIMPLEX_OPT_BOUNDED;
+        break;
+      }
+      y = x;
+      ydir = dir;
+    } else {
+      row = matrix_row(matrix, r);
+      k = find_improving_var(solver, row, x, dir);
+      if (k < 0) {
+        code = SIMPLEX_OPT_BOUNDED;
+        break;
+      }
+      y = row->data[k].c_idx;
+      // x changes by -a * (change of y) where a = coefficient of y
+      ydir = q_is_pos(&row->data[k].coeff) ? -dir : dir;
+    }
+
+    if (! simplex_ratio_test(solver, y, ydir, &t, &z, &r)) {
+      code = SIMPLEX_OPT_UNBOUNDED;
+      break;
+    }
+    simplex_opt_step(solver, y, ydir, z, r);
+  }
+
+  xq_clear(&t);
+
+  assert(solver->infeasible_vars.nelems == 0);
+
+  return code;
+}
+
+
+/*
+ * Optimize x in the current branch
+ * - this must be called after a search that returned SAT (before the
+ *   context is cleared) so that the current assignment is feasible.
+ * - maximize is true to maximize x, false to minimize x
+ * - the assignment is updated in place; the bounds are unchanged
+ *
+ * Return code:
+ * - SIMPLEX_OPT_BOUNDED: the optimal value of x for the current bounds
+ *   is stored in v (v may include a delta part if the optimum is
+ *   on a strict bound)
+ * - SIMPLEX_OPT_UNBOUNDED: x can be made arbitrarily large (or small)
+ * - SIMPLEX_OPT_UNKNOWN: x is not in the tableau or the search was
+ *   interrupted.
+ */
+simplex_opt_code_t simplex_optimize_var(simplex_solver_t *solver, thvar_t x, bool maximize, xrational_t *v) {
+  arith_vartable_t *vtbl;
+  polynomial_t *p;
+  simplex_opt_code_t code;
+  uint32_t i;
+  thvar_t y;
+  int32_t dir;
+
+  vtbl = &solver->vtbl;
+  assert(valid_arith_var(vtbl, x));
+
+  dir = maximize ? 1 : -1;
+
+  if (x == const_idx) {
+    xq_set_one(v);
+    return SIMPLEX_OPT_BOUNDED;
+  }
+
+  if (arith_var_def_is_rational(vtbl, x)) {
+    xq_set_q(v, arith_var_rational_def(vtbl, x));
+    return SIMPLEX_OPT_BOUNDED;
+  }
+
+  if (arith_var_def_is_poly(vtbl, x) && trivial_variable(vtbl, x)) {
+    /*
+     * x is not in the matrix. Its definition is (c + b.y) or c or b.y
+     * so we optimize y instead.
+     */
+    p = arith_var_poly_def(vtbl, x);
+    xq_clear(v);
+    code = SIMPLEX_OPT_BOUNDED;
+    for (i=0; i<p->nterms; i++) {
+      y = p->mono[i].var;
+      if (y == const_idx) {
+        xq_add_q(v, &p->mono[i].coeff);
+      } else {
+        code = simplex_primal_optimize(solver, y, q_is_pos(&p->mono[i].coeff) ? dir : -dir);
+        xq_addmul(v, arith_var_value(vtbl, y), &p->mono[i].coeff);
+      }
+    }
+    return code;
+  }
+
+  code = simplex_primal_optimize(solver, x, dir);
+  xq_set(v, arith_var_value(vtbl, x));
+
+  return code;
+}
+
+
+
 /****************
  *  STATISTICS  *
  ***************/
@@ -12463,6 +13228,25 @@ void simplex_collect_statistics(simplex_solver_t *solver) {
 }
 
 
+/*
+ * Memory estimate: tableau + variable, atom, and bound tables
+ */
+uint64_t simplex_mem_size(simplex_solver_t *solver) {
+  uint64_t size;
+
+  size = sizeof(simplex_solver_t);
+  size += matrix_mem_size(&solver->matrix);
+  size += (uint64_t) solver->vtbl.size * (sizeof(void *) + sizeof(int32_t *) + sizeof(eterm_t) + sizeof(uint8_t) +
+                                          sizeof(xrational_t) + 2 * sizeof(int32_t));
+  size += (uint64_t) solver->atbl.size * sizeof(arith_atom_t);
+  size += (uint64_t) solver->pcost.size * (sizeof(uint32_t) + sizeof(double));
+  size += (uint64_t) solver->bstack.size * (sizeof(xrational_t) + sizeof(thvar_t) + sizeof(arith_expl_t) +
+                                            sizeof(int32_t) + sizeof(uint8_t));
+
+  return size;
+}
+
+
 
 /******************************
  *  INTERFACE TO THE CONTEXT  *
@@ -400,6 +400,31 @@ extern void simplex_free_model(simplex_solver_t *solver);
 
 
 
+/*
+ * Optimization: this is used by the context to optimize an objective
+ * after a check that returned SAT.
+ * - x = variable to optimize, maximize = true to maximize x, false to minimize it
+ * - the current assignment must be feasible (i.e., this must be called
+ *   before the context is cleared)
+ * - the function runs the primal simplex on the current tableau
+ *   and bounds, starting from the current assignment
+ *
+ * Return code:
+ * - SIMPLEX_OPT_BOUNDED: the optimal value of x is stored in v
+ *   (v may include a delta part if the optimum is on a strict bound)
+ * - SIMPLEX_OPT_UNBOUNDED: x is unbounded in the optimization direction
+ * - SIMPLEX_OPT_UNKNOWN: x is not in the tableau or the search was interrupted
+ */
+typedef enum simplex_opt_code {
+  SIMPLEX_OPT_BOUNDED,
+  SIMPLEX_OPT_UNBOUNDED,
+  SIMPLEX_OPT_UNKNOWN,
+} simplex_opt_code_t;
+
+extern simplex_opt_code_t simplex_optimize_var(simplex_solver_t *solver, thvar_t x, bool maximize, xrational_t *v);
+
+
+
 /*********************
  *  GET STATISTICS   *
  ********************/
@@ -411,6 +436,13 @@ extern void simplex_free_model(simplex_solver_t *solver);
  */
 extern void simplex_collect_statistics(simplex_solver_t *solver);
 
+/*
+ * Estimate of the memory used by the solver (in bytes)
+ * - this includes the tableau, and the variable, atom, and bound tables
+ * - it does not count the GMP numbers
+ */
+extern uint64_t simplex_mem_size(simplex_solver_t *solver);
+
 
 /*
  * Statistics on problem size (at the start of search)
@@ -480,6 +512,30 @@ static inline uint32_t simplex_num_branch_and_bound(simplex_solver_t *solver) {
   return solver->stats.num_branch_atoms;
 }
 
+static inline uint32_t simplex_num_branch_nodes(simplex_solver_t *solver) {
+  return solver->stats.num_branch_nodes;
+}
+
+static inline uint32_t simplex_num_pcost_branches(simplex_solver_t *solver) {
+  return solver->stats.num_pcost_branches;
+}
+
+static inline uint32_t simplex_num_presolve_bounds(simplex_solver_t *solver) {
+  return solver->stats.num_presolve_bounds;
+}
+
+static inline uint32_t simplex_num_strengthen_rounds(simplex_solver_t *solver) {
+  return solver->stats.num_strengthen_rounds;
+}
+
+static inline uint32_t simplex_num_cube_tests(simplex_solver_t *solver) {
+  return solver->stats.num_cube_tests;
+}
+
+static inline uint32_t simplex_num_cube_successes(simplex_solver_t *solver) {
+  return solver->stats.num_cube_successes;
+}
+
 static inline uint32_t simplex_num_bound_conflicts(simplex_solver_t *solver) {
   return solver->stats.num_bound_conflicts;
 }
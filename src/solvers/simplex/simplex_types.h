@@ -152,6 +152,7 @@
 #include "utils/arena.h"
 #include "utils/bitvectors.h"
 #include "utils/cache.h"
+#include "utils/cycle_timers.h"
 #include "utils/int_heap.h"
 #include "utils/int_vectors.h"
 #include "utils/ptr_vectors.h"
@@ -653,10 +654,48 @@ typedef struct simplex_stats_s {
   uint32_t num_dioph_recheck_conflicts; // unsat after dioph bounds + recheck
 
   uint32_t num_branch_atoms;            // new branch&bound atoms created
+  uint32_t num_branch_nodes;            // branching steps (size of the branch&bound tree)
+  uint32_t num_pcost_branches;          // branch variables chosen by pseudo-costs
+  uint32_t num_presolve_bounds;         // bounds derived by the presolve
+  uint32_t num_presolve_conflicts;      // unsat by the presolve
+  uint32_t num_strengthen_rounds;       // rounds of bound strengthening
+  uint32_t num_cube_tests;              // calls to the cube test
+  uint32_t num_cube_successes;          // integer solutions found by the cube test
+  cycle_timer_t intfeas_timer;          // time spent in make_integer_feasible
 
 } simplex_stats_t;
 
 
+/*
+ * Pseudo-costs for branching
+ * - each time we branch on a variable x, we record x and the number
+ *   of integer-infeasible basic variables at that point
+ * - the next call to make_integer_feasible computes the gain of that
+ *   branch: the relative decrease in the number of integer-infeasible
+ *   variables (1.0 if the branch led to a conflict or to an integer
+ *   solution)
+ * - for each variable x: count[x] = number of gains recorded for x
+ *   and gain[x] = sum of these gains
+ * - the arrays are valid for variables 0 to nvars-1 (nvars <= size)
+ * - total_gain and total_count are the sums over all variables
+ * - last_var = last branch variable (or null_thvar)
+ * - last_ninvalid = number of infeasible variables when last_var was selected
+ */
+typedef struct branch_pcost_s {
+  uint32_t size;
+  uint32_t nvars;
+  uint32_t *count;
+  double *gain;
+  double total_gain;
+  uint32_t total_count;
+  thvar_t last_var;
+  uint32_t last_ninvalid;
+} branch_pcost_t;
+
+#define DEF_BRANCH_PCOST_SIZE 100
+#define MAX_BRANCH_PCOST_SIZE (UINT32_MAX/sizeof(double))
+
+
 
 
 
@@ -720,6 +759,7 @@ typedef struct simplex_solver_s {
   int32_t check_counter;
   int32_t check_period;
   bvar_t last_branch_atom;
+  branch_pcost_t pcost;
 
   /*
    * Optional subsolver for integer arithmetic: allocated when needed
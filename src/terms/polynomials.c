@@ -153,6 +153,80 @@ void sort_monarray(monomial_t *a, uint32_t n) {
 }
 
 
+/*
+ * Radix sort: one pass per 8-bit digit of the variables, up to the
+ * most significant non-zero digit of the largest variable
+ * - this is stable and linear in n, so it's better than quick sort for
+ *   large arrays
+ * - small arrays (fewer than MONARRAY_RADIX_MIN elements) are sorted
+ *   with quick sort
+ * - all variables must be non-negative
+ */
+#define MONARRAY_RADIX_BITS 8
+#define MONARRAY_RADIX_SIZE (1u << MONARRAY_RADIX_BITS)
+#define MONARRAY_RADIX_MASK (MONARRAY_RADIX_SIZE - 1)
+#define MONARRAY_RADIX_MIN 64
+
+// copy a[0 ... n-1] into b, ordered by the digit of a[i].var at the given shift
+static void radix_pass_monarray(monomial_t *a, monomial_t *b, uint32_t n, uint32_t shift) {
+  uint32_t count[MONARRAY_RADIX_SIZE];
+  uint32_t i, d, s, c;
+
+  for (d=0; d<MONARRAY_RADIX_SIZE; d++) {
+    count[d] = 0;
+  }
+  for (i=0; i<n; i++) {
+    d = (((uint32_t) a[i].var) >> shift) & MONARRAY_RADIX_MASK;
+    count[d] ++;
+  }
+  s = 0;
+  for (d=0; d<MONARRAY_RADIX_SIZE; d++) {
+    c = count[d];
+    count[d] = s;
+    s += c;
+  }
+  for (i=0; i<n; i++) {
+    d = (((uint32_t) a[i].var) >> shift) & MONARRAY_RADIX_MASK;
+    b[count[d]] = a[i];
+    count[d] ++;
+  }
+}
+
+void radix_sort_monarray(monomial_t *a, uint32_t n) {
+  monomial_t *b, *src, *dst, *aux;
+  uint32_t i, shift, max;
+
+  assert(a[n].var == max_idx);
+  if (n < MONARRAY_RADIX_MIN) {
+    sort_monarray(a, n);
+    return;
+  }
+
+  max = 0;
+  for (i=0; i<n; i++) {
+    assert(a[i].var >= 0);
+    if ((uint32_t) a[i].var > max) max = a[i].var;
+  }
+
+  b = (monomial_t *) safe_malloc(n * sizeof(monomial_t));
+  src = a;
+  dst = b;
+  shift = 0;
+  do {
+    radix_pass_monarray(src, dst, n, shift);
+    aux = src; src = dst; dst = aux;
+    shift += MONARRAY_RADIX_BITS;
+  } while (shift < 32 && (max >> shift) != 0);
+
+  if (src != a) {
+    for (i=0; i<n; i++) {
+      a[i] = src[i];
+    }
+  }
+  safe_free(b);
+}
+
+
 /*
  * SORT: CUSTOM ORDERING
  */
@@ -123,6 +123,15 @@ extern void clear_monarray(monomial_t *a, uint32_t n);
 extern void sort_monarray(monomial_t *a, uint32_t n);
 
 
+/*
+ * Same thing using a radix sort: better for large arrays
+ * (small arrays are sorted with sort_monarray)
+ * - a must be terminated by the end-marker max_idx
+ * - n = number of monomials in a excluding the end marker
+ */
+extern void radix_sort_monarray(monomial_t *a, uint32_t n);
+
+
 /*
  * Sort array a in an order defined by cmp.
  * - a must be terminated by the end-marker max_idx
@@ -835,6 +835,138 @@ term_t mk_direct_arith_term(term_table_t *tbl, rba_buffer_t *b) {
 
 
 
+/*
+ * BULK CONSTRUCTION OF LINEAR SUMS
+ */
+
+/*
+ * Check whether t is linear: all arithmetic terms are linear except
+ * power products and polynomials that contain power products.
+ */
+bool arith_term_is_linear(term_table_t *tbl, term_t t) {
+  polynomial_t *p;
+  uint32_t i, n;
+
+  assert(is_arithmetic_term(tbl, t));
+
+  switch (term_kind(tbl, t)) {
+  case POWER_PRODUCT:
+    return false;
+
+  case ARITH_POLY:
+    p = poly_term_desc(tbl, t);
+    n = p->nterms;
+    for (i=0; i<n; i++) {
+      if (p->mono[i].var != const_idx && term_kind(tbl, p->mono[i].var) == POWER_PRODUCT) {
+        return false;
+      }
+    }
+    return true;
+
+  default:
+    return true;
+  }
+}
+
+
+/*
+ * Number of monomials needed for c * t
+ */
+static uint32_t linear_sum_size(term_table_t *tbl, term_t t) {
+  return t != const_idx && term_kind(tbl, t) == ARITH_POLY ? poly_term_desc(tbl, t)->nterms : 1;
+}
+
+/*
+ * Store the monomials of c * t into b[k ...]
+ * - return the index after the last monomial stored
+ */
+static uint32_t linear_sum_add_term(term_table_t *tbl, monomial_t *b, uint32_t k, rational_t *c, term_t t) {
+  polynomial_t *p;
+  uint32_t i, n;
+
+  if (t == const_idx) {
+    b[k].var = const_idx;
+    q_set(&b[k].coeff, c);
+    return k+1;
+  }
+
+  switch (term_kind(tbl, t)) {
+  case ARITH_CONSTANT:
+    b[k].var = const_idx;
+    q_set(&b[k].coeff, c);
+    q_mul(&b[k].coeff, rational_term_desc(tbl, t));
+    k ++;
+    break;
+
+  case ARITH_POLY:
+    p = poly_term_desc(tbl, t);
+    n = p->nterms;
+    for (i=0; i<n; i++) {
+      b[k].var = p->mono[i].var;
+      q_set(&b[k].coeff, c);
+      q_mul(&b[k].coeff, &p->mono[i].coeff);
+      k ++;
+    }
+    break;
+
+  default:
+    b[k].var = t;
+    q_set(&b[k].coeff, c);
+    k ++;
+    break;
+  }
+
+  return k;
+}
+
+term_t mk_arith_linear_sum(term_manager_t *manager, monomial_t *a, uint32_t n) {
+  term_table_t *tbl;
+  monomial_t *b;
+  uint32_t i, k, m;
+  term_t t;
+
+  tbl = manager->terms;
+
+  m = 0;
+  for (i=0; i<n; i++) {
+    if (a[i].var != const_idx && ! arith_term_is_linear(tbl, a[i].var)) {
+      return NULL_TERM;
+    }
+    m += linear_sum_size(tbl, a[i].var);
+  }
+
+  b = alloc_monarray(m + 1);
+  k = 0;
+  for (i=0; i<n; i++) {
+    k = linear_sum_add_term(tbl, b, k, &a[i].coeff, a[i].var);
+  }
+  assert(k == m);
+  b[m].var = max_idx;
+
+  radix_sort_monarray(b, m);
+  k = normalize_monarray(b, m);
+
+  /*
+   * Same simplifications as arith_buffer_to_term
+   */
+  if (k == 0) {
+    t = zero_term;
+  } else if (k == 1 && b[0].var == const_idx) {
+    t = arith_constant(tbl, &b[0].coeff);
+  } else if (k == 1 && q_is_one(&b[0].coeff)) {
+    t = b[0].var;
+  } else {
+    t = arith_poly_from_monarray(tbl, b, k);
+  }
+
+  clear_monarray(b, m + 1);
+  safe_free(b);
+
+  return t;
+}
+
+
+
 /*********************************
  *   BOOLEAN-TERM CONSTRUCTORS   *
  ********************************/
@@ -350,6 +350,30 @@ extern term_t mk_arith_term(term_manager_t *manager, rba_buffer_t *b);
 extern term_t mk_direct_arith_term(term_table_t *tbl, rba_buffer_t *b);
 
 
+/*
+ * BULK CONSTRUCTION OF LINEAR SUMS
+ *
+ * For large sums, adding monomials one by one to an rba_buffer costs
+ * one tree insertion per monomial. Instead, the monomials are copied
+ * into a flat array, sorted by variable, merged, and the polynomial
+ * is hash-consed in one step.
+ *
+ * - a must be an array of n monomials: a[i].var is either const_idx
+ *   or an arithmetic term and a[i].coeff is its coefficient
+ * - the result is the same term as the one built by adding
+ *   a[i].coeff * a[i].var to an rba_buffer then calling mk_arith_term
+ * - return NULL_TERM if one of the terms a[i].var is not linear
+ *   (i.e., a power product or a polynomial that contains power products)
+ * - a is not modified
+ *
+ * Use this for sums of at least MIN_BULK_SUM_SIZE terms.
+ */
+#define MIN_BULK_SUM_SIZE 16
+
+extern bool arith_term_is_linear(term_table_t *tbl, term_t t);
+extern term_t mk_arith_linear_sum(term_manager_t *manager, monomial_t *a, uint32_t n);
+
+
 /*
  * Create an arithmetic atom from the content of buffer b:
  * - b->ptbl must be equal to manager->pprods
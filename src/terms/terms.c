@@ -804,6 +804,18 @@ typedef struct {
   int32_t *v;
 } poly_term_hobj_t;
 
+/*
+ * Polynomial built from a normalized monomial array a of n monomials
+ * (all variables of a are terms)
+ */
+typedef struct {
+  int_hobj_t m;
+  term_table_t *tbl;
+  type_t tau;
+  monomial_t *a;
+  uint32_t n;
+} monarray_term_hobj_t;
+
 
 /*
  * Bit-vector polynomials
@@ -904,6 +916,10 @@ static uint32_t hash_poly_hobj(poly_term_hobj_t *o) {
   return hash_rba_buffer(o->b, o->v);
 }
 
+static uint32_t hash_monarray_hobj(monarray_term_hobj_t *o) {
+  return hash_monarray(o->a, o->n);
+}
+
 static uint32_t hash_bvpoly_hobj(bvpoly_term_hobj_t *o) {
   return hash_bvarith_buffer(o->b, o->v);
 }
@@ -1078,6 +1094,18 @@ static bool eq_poly_hobj(poly_term_hobj_t *o, int32_t i) {
     rba_buffer_equal_poly(o->b, o->v, table->desc[i].ptr);
 }
 
+static bool eq_monarray_hobj(monarray_term_hobj_t *o, int32_t i) {
+  term_table_t *table;
+  polynomial_t *p;
+
+  table = o->tbl;
+  assert(good_term_idx(table, i));
+
+  if (table->kind[i] != ARITH_POLY) return false;
+  p = table->desc[i].ptr;
+  return p->nterms == o->n && equal_monarrays(p->mono, o->a);
+}
+
 static bool eq_bvpoly_hobj(bvpoly_term_hobj_t *o, int32_t i) {
   term_table_t *table;
 
@@ -1202,6 +1230,13 @@ static int32_t build_poly_hobj(poly_term_hobj_t *o) {
   return new_ptr_term(o->tbl, ARITH_POLY, o->tau, p);
 }
 
+static int32_t build_monarray_hobj(monarray_term_hobj_t *o) {
+  polynomial_t *p;
+
+  p = monarray_get_poly(o->a, o->n);
+  return new_ptr_term(o->tbl, ARITH_POLY, o->tau, p);
+}
+
 static int32_t build_bvpoly_hobj(bvpoly_term_hobj_t *o) {
   bvpoly_t *p;
 
@@ -1319,6 +1354,13 @@ static poly_term_hobj_t poly_hobj = {
   0, NULL, NULL,
 };
 
+static monarray_term_hobj_t monarray_hobj = {
+  { (hobj_hash_t) hash_monarray_hobj, (hobj_eq_t) eq_monarray_hobj,
+    (hobj_build_t) build_monarray_hobj },
+  NULL,
+  0, NULL, 0,
+};
+
 static bvpoly_term_hobj_t bvpoly_hobj = {
   { (hobj_hash_t) hash_bvpoly_hobj, (hobj_eq_t) eq_bvpoly_hobj,
     (hobj_build_t) build_bvpoly_hobj },
@@ -2859,6 +2901,47 @@ term_t arith_poly(term_table_t *table, rba_buffer_t *b) {
 }
 
 
+/*
+ * Arithmetic polynomial from a monomial array
+ * - a must be normalized and terminated by max_idx
+ * - n = number of monomials in a (excluding the end marker)
+ * - all variables of a must be const_idx or arithmetic terms
+ *   that are not power products
+ *
+ * SIDE EFFECT: a's coefficients are cleared if a new term is created
+ */
+term_t arith_poly_from_monarray(term_table_t *table, monomial_t *a, uint32_t n) {
+  type_t tau;
+  int32_t i;
+  uint32_t j;
+  bool all_int;
+
+  assert(a[n].var == max_idx);
+
+  all_int = true;
+  for (j=0; j<n; j++) {
+    assert(a[j].var == const_idx || term_kind(table, a[j].var) != POWER_PRODUCT);
+    if (! q_is_integer(&a[j].coeff) ||
+        (a[j].var != const_idx && is_real_term(table, a[j].var))) {
+      all_int = false;
+      break;
+    }
+  }
+
+  tau = all_int ? int_type(table->types) : real_type(table->types);
+
+  // hash consing
+  monarray_hobj.tbl = table;
+  monarray_hobj.tau = tau;
+  monarray_hobj.a = a;
+  monarray_hobj.n = n;
+
+  i = int_htbl_get_obj(&table->htbl, &monarray_hobj.m);
+
+  return pos_term(i);
+}
+
+
 /*
  * Bitvector polynomials are constructed from a buffer b
  * - all variables of b must be bitvector terms defined in table
@@ -3638,3 +3721,80 @@ void term_table_gc(term_table_t *table, bool keep_named) {
   // clear the marks
   clear_bitvector(table->mark, table->size);
 }
+
+
+
+
+/******************
+ *  MEMORY USAGE  *
+ *****************/
+
+/*
+ * Size of the descriptor of term i (not counting the desc array)
+ */
+static uint64_t term_desc_mem_size(const term_table_t *table, int32_t i) {
+  bvpoly_t *p;
+
+  switch (table->kind[i]) {
+  case ITE_TERM:
+  case ITE_SPECIAL:
+  case APP_TERM:
+  case UPDATE_TERM:
+  case TUPLE_TERM:
+  case EQ_TERM:
+  case DISTINCT_TERM:
+  case FORALL_TERM:
+  case LAMBDA_TERM:
+  case OR_TERM:
+  case XOR_TERM:
+  case ARITH_BINEQ_ATOM:
+  case ARITH_RDIV:
+  case ARITH_IDIV:
+  case ARITH_MOD:
+  case ARITH_DIVIDES_ATOM:
+  case BV_ARRAY:
+  case BV_DIV:
+  case BV_REM:
+  case BV_SDIV:
+  case BV_SREM:
+  case BV_SMOD:
+  case BV_SHL:
+  case BV_LSHR:
+  case BV_ASHR:
+  case BV_EQ_ATOM:
+  case BV_GE_ATOM:
+  case BV_SGE_ATOM:
+    return sizeof(composite_term_t) + (uint64_t) composite_for_idx(table, i)->arity * sizeof(term_t);
+
+  case ARITH_POLY:
+    return sizeof(polynomial_t) + (uint64_t) (polynomial_for_idx(table, i)->nterms + 1) * sizeof(monomial_t);
+
+  case BV64_POLY:
+    return sizeof(bvpoly64_t) + (uint64_t) (bvpoly64_for_idx(table, i)->nterms + 1) * sizeof(bvmono64_t);
+
+  case BV_POLY:
+    p = bvpoly_for_idx(table, i);
+    return sizeof(bvpoly_t) + (uint64_t) (p->nterms + 1) * (sizeof(bvmono_t) + p->width * sizeof(uint32_t));
+
+  default:
+    return 0;
+  }
+}
+
+uint64_t term_table_mem_size(const term_table_t *table) {
+  uint64_t size;
+  uint32_t i, n;
+
+  size = (uint64_t) table->size * (sizeof(uint8_t) + sizeof(term_desc_t) + sizeof(type_t));
+  size += table->size >> 3;
+
+  n = table->nelems;
+  for (i=0; i<n; i++) {
+    if (table->kind[i] > RESERVED_TERM) {
+      size += term_desc_mem_size(table, i);
+    }
+  }
+
+  return size;
+}
+
@@ -657,6 +657,20 @@ extern term_t arith_constant(term_table_t *table, rational_t *a);
 extern term_t arith_poly(term_table_t *table, rba_buffer_t *b);
 
 
+/*
+ * Arithmetic polynomial from a monomial array a
+ * - a must be normalized and terminated by the end marker max_idx
+ * - n = number of monomials in a (excluding the end marker)
+ * - all variables of a must be const_idx or arithmetic terms that
+ *   are not power products (i.e., a must be linear)
+ * - this returns the same term as arith_poly applied to a buffer
+ *   equal to a
+ *
+ * SIDE EFFECT: a's coefficients are cleared if a new term is created
+ */
+extern term_t arith_poly_from_monarray(term_table_t *table, monomial_t *a, uint32_t n);
+
+
 /*
  * Atom (t == 0)
  * - t must be an arithmetic term
@@ -1714,4 +1728,17 @@ static inline bool term_idx_is_marked(const term_table_t *table, int32_t i) {
 extern void term_table_gc(term_table_t *table, bool keep_named);
 
 
+
+/*
+ * MEMORY USAGE
+ */
+
+/*
+ * Estimate of the memory used by the table (in bytes)
+ * - this includes the descriptors of composite terms and polynomials
+ *   but not the GMP numbers, the hash tables, or the symbol table
+ */
+extern uint64_t term_table_mem_size(const term_table_t *table);
+
+
 #endif /* __TERMS_H */
@@ -0,0 +1,121 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * CHEAP TIMERS FOR PROFILING
+ *
+ * A timer accumulates the number of cycles spent in a piece of code
+ * and the number of times that code was executed:
+ *
+ *    uint64_t start = timer_start();
+ *    ...
+ *    timer_stop(&timer, start);
+ *
+ * The timers are enabled if HAVE_STATS_TIMERS is defined (compile
+ * with 'make ENABLE_STATS_TIMERS=yes'). Otherwise, timer_start and
+ * timer_stop do nothing and are compiled out.
+ *
+ * On x86, cycles are read from the time-stamp counter. On other
+ * architectures, they are nanoseconds read from a monotonic clock.
+ * The counter itself (read_cycle_counter) is always available.
+ */
+
+#ifndef __CYCLE_TIMERS_H
+#define __CYCLE_TIMERS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <time.h>
+#endif
+
+
+typedef struct cycle_timer_s {
+  uint64_t cycles;
+  uint64_t calls;
+} cycle_timer_t;
+
+
+static inline void reset_cycle_timer(cycle_timer_t *t) {
+  t->cycles = 0;
+  t->calls = 0;
+}
+
+
+/*
+ * Current value of the cycle counter
+ * - CYCLE_COUNTER_IS_TSC is true if that's the x86 time-stamp counter
+ * - otherwise, the counter is in nanoseconds (or always 0 if there's
+ *   no monotonic clock)
+ */
+#if defined(__x86_64__) || defined(__i386__)
+
+#define CYCLE_COUNTER_IS_TSC true
+
+static inline uint64_t read_cycle_counter(void) {
+  return __rdtsc();
+}
+
+#else
+
+#define CYCLE_COUNTER_IS_TSC false
+
+static inline uint64_t read_cycle_counter(void) {
+#ifdef CLOCK_MONOTONIC
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((uint64_t) ts.tv_sec) * 1000000000 + (uint64_t) ts.tv_nsec;
+#else
+  return 0;
+#endif
+}
+
+#endif
+
+
+#ifdef HAVE_STATS_TIMERS
+
+#define CYCLE_TIMERS_ENABLED true
+
+static inline uint64_t timer_start(void) {
+  return read_cycle_counter();
+}
+
+static inline void timer_stop(cycle_timer_t *t, uint64_t start) {
+  t->cycles += read_cycle_counter() - start;
+  t->calls ++;
+}
+
+#else
+
+#define CYCLE_TIMERS_ENABLED false
+
+static inline uint64_t timer_start(void) {
+  return 0;
+}
+
+static inline void timer_stop(cycle_timer_t *t, uint64_t start) {
+}
+
+#endif
+
+#endif /* __CYCLE_TIMERS_H */
@@ -0,0 +1,95 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * BINARY EVENT TRACE
+ */
+
+#include <string.h>
+
+#include "utils/event_trace.h"
+#include "utils/memalloc.h"
+
+
+/*
+ * Initialize: size = smallest power of two >= n
+ */
+void init_event_trace(event_trace_t *trace, uint32_t n) {
+  uint32_t size;
+
+  if (n == 0) {
+    n = DEF_ETRACE_SIZE;
+  }
+  if (n > MAX_ETRACE_SIZE) {
+    out_of_memory();
+  }
+
+  size = 1;
+  while (size < n) {
+    size <<= 1;
+  }
+
+  trace->data = (etrace_event_t *) safe_malloc(size * sizeof(etrace_event_t));
+  trace->size = size;
+  trace->mask = size - 1;
+  trace->count = 0;
+}
+
+
+void delete_event_trace(event_trace_t *trace) {
+  safe_free(trace->data);
+  trace->data = NULL;
+}
+
+
+/*
+ * Write n records starting from trace->data[i]
+ */
+static bool write_events(const event_trace_t *trace, uint32_t i, uint32_t n, FILE *f) {
+  return n == 0 || fwrite(trace->data + i, sizeof(etrace_event_t), n, f) == n;
+}
+
+int32_t write_event_trace(const event_trace_t *trace, FILE *f) {
+  etrace_header_t header;
+  uint32_t n, first;
+
+  n = event_trace_nevents(trace);
+
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, ETRACE_MAGIC, 4);
+  header.version = ETRACE_VERSION;
+  header.event_size = sizeof(etrace_event_t);
+  header.clock = CYCLE_COUNTER_IS_TSC ? 0 : 1;
+  header.capacity = trace->size;
+  header.nevents = n;
+  header.total = trace->count;
+
+  if (fwrite(&header, sizeof(header), 1, f) != 1) {
+    return -1;
+  }
+
+  // the oldest event is at index first
+  first = (n < trace->size) ? 0 : (uint32_t) (trace->count & trace->mask);
+  if (! write_events(trace, first, n - first, f) ||
+      ! write_events(trace, 0, first, f) ||
+      fflush(f) != 0) {
+    return -1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,198 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * BINARY EVENT TRACE
+ *
+ * A fixed-size ring buffer of compact event records. Logging an event
+ * costs a few stores and a read of the cycle counter so the trace can
+ * be left on all the time. When the buffer is full, the oldest events
+ * are overwritten.
+ *
+ * The trace can be written to a file in a binary format and decoded
+ * offline with utils/decode_events.c. The file format is:
+ * - a header (etrace_header_t)
+ * - followed by header.nevents records of type etrace_event_t,
+ *   oldest first.
+ * Everything is written in the native byte order. The decoder checks
+ * the magic number and the version to detect mismatches.
+ */
+
+#ifndef __EVENT_TRACE_H
+#define __EVENT_TRACE_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "utils/cycle_timers.h"
+
+
+/*
+ * Event kinds and the meaning of the arguments
+ * - stamp is the number of conflicts when the event is logged
+ *
+ * START_SEARCH:   arg32 = number of Boolean variables
+ * END_SEARCH:     arg8 = status (as defined in smt_status_t)
+ * RESTART:        arg32 = decision level before the restart
+ * REDUCE:         arg32 = number of learned clauses after reduction
+ * SIMPLIFY:       arg32 = number of problem clauses after simplification
+ * CONFLICT:       arg16 = LBD of the learned clause (capped at UINT16_MAX)
+ *                 arg32 = number of literals in the learned clause
+ * TH_CONFLICT:    arg8 = solver (etrace_solver_t)
+ *                 arg32 = number of literals in the conflict
+ * FINAL_CHECK:    arg8 = result (as defined in fcheck_code_t)
+ * GC:             arg32 = number of Boolean variables removed
+ */
+typedef enum etrace_kind {
+  ETRACE_START_SEARCH,
+  ETRACE_END_SEARCH,
+  ETRACE_RESTART,
+  ETRACE_REDUCE,
+  ETRACE_SIMPLIFY,
+  ETRACE_CONFLICT,
+  ETRACE_TH_CONFLICT,
+  ETRACE_FINAL_CHECK,
+  ETRACE_GC,
+} etrace_kind_t;
+
+#define NUM_ETRACE_KINDS (ETRACE_GC+1)
+
+/*
+ * Theory solvers that report conflicts
+ */
+typedef enum etrace_solver {
+  ETRACE_EGRAPH,
+  ETRACE_SIMPLEX,
+  ETRACE_IDL,
+  ETRACE_RDL,
+  ETRACE_BV,
+} etrace_solver_t;
+
+#define NUM_ETRACE_SOLVERS (ETRACE_BV+1)
+
+
+/*
+ * Event record: 24 bytes
+ * - time = value of the cycle counter
+ */
+typedef struct etrace_event_s {
+  uint64_t time;
+  uint64_t stamp;
+  uint32_t arg32;
+  uint16_t arg16;
+  uint8_t arg8;
+  uint8_t kind;
+} etrace_event_t;
+
+
+/*
+ * File header
+ * - magic = ETRACE_MAGIC
+ * - version = ETRACE_VERSION
+ * - event_size = sizeof(etrace_event_t)
+ * - clock = 0 if the time is in TSC cycles, 1 if it's in nanoseconds
+ * - capacity = size of the ring buffer
+ * - nevents = number of events that follow
+ * - total = number of events logged since the trace was created or reset
+ *   (if total > nevents, the oldest events were lost)
+ */
+typedef struct etrace_header_s {
+  char magic[4];
+  uint32_t version;
+  uint32_t event_size;
+  uint32_t clock;
+  uint32_t capacity;
+  uint32_t nevents;
+  uint64_t total;
+} etrace_header_t;
+
+#define ETRACE_MAGIC "YEVT"
+#define ETRACE_VERSION 1
+
+
+/*
+ * Ring buffer
+ * - size = capacity (a power of two)
+ * - mask = size - 1
+ * - count = total number of events logged
+ * - the next event is stored in data[count & mask]
+ */
+typedef struct event_trace_s {
+  etrace_event_t *data;
+  uint32_t size;
+  uint32_t mask;
+  uint64_t count;
+} event_trace_t;
+
+#define DEF_ETRACE_SIZE 2048
+#define MAX_ETRACE_SIZE (UINT32_MAX/sizeof(etrace_event_t))
+
+
+/*
+ * Initialize a trace of size n
+ * - n is rounded up to a power of two
+ * - if n is 0, the default size is used
+ */
+extern void init_event_trace(event_trace_t *trace, uint32_t n);
+
+/*
+ * Delete the trace
+ */
+extern void delete_event_trace(event_trace_t *trace);
+
+/*
+ * Remove all events
+ */
+static inline void reset_event_trace(event_trace_t *trace) {
+  trace->count = 0;
+}
+
+/*
+ * Number of events currently stored
+ */
+static inline uint32_t event_trace_nevents(const event_trace_t *trace) {
+  return trace->count < trace->size ? (uint32_t) trace->count : trace->size;
+}
+
+/*
+ * Add an event
+ */
+static inline void etrace_log(event_trace_t *trace, etrace_kind_t kind, uint64_t stamp,
+                              uint8_t arg8, uint16_t arg16, uint32_t arg32) {
+  etrace_event_t *e;
+
+  e = trace->data + (trace->count & trace->mask);
+  e->time = read_cycle_counter();
+  e->stamp = stamp;
+  e->arg32 = arg32;
+  e->arg16 = arg16;
+  e->arg8 = arg8;
+  e->kind = kind;
+  trace->count ++;
+}
+
+/*
+ * Write the trace to file f (in binary)
+ * - return 0 if this works, -1 if there's a write error
+ *   (errno is set by the failed call to fwrite)
+ */
+extern int32_t write_event_trace(const event_trace_t *trace, FILE *f);
+
+
+#endif /* __EVENT_TRACE_H */
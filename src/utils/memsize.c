@@ -89,6 +89,10 @@ end:
   return (double) total_size;
 }
 
+double peak_mem_size(void) {
+  return 0.0;
+}
+
 #elif defined(SOLARIS)
 
 /*
@@ -123,6 +127,10 @@ double mem_size(void) {
   return size;
 }
 
+double peak_mem_size(void) {
+  return 0.0;
+}
+
 
 #elif defined(LINUX) || defined(CYGWIN)
 
@@ -167,6 +175,25 @@ double mem_size(void) {
   return (double)(getpagesize() * get_pages());
 }
 
+/*
+ * Peak resident set size: line 'VmHWM: <size> kB' in /proc/self/status
+ */
+double peak_mem_size(void) {
+  FILE *f;
+  char line[100];
+  unsigned long kb;
+
+  kb = 0;
+  f = fopen("/proc/self/status", "r");
+  if (f != NULL) {
+    while (fgets(line, sizeof(line), f) != NULL) {
+      if (sscanf(line, "VmHWM: %lu", &kb) == 1) break;
+    }
+    fclose(f);
+  }
+  return ((double) kb) * 1024;
+}
+
 
 #elif defined(FREEBSD)
 
@@ -213,6 +240,10 @@ double mem_size(void) {
   return vsize;
 }
 
+double peak_mem_size(void) {
+  return 0.0;
+}
+
 
 #else
 
@@ -224,5 +255,9 @@ double mem_size(void) {
   return 0.0;
 }
 
+double peak_mem_size(void) {
+  return 0.0;
+}
+
 #endif
 
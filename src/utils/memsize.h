@@ -29,5 +29,11 @@
  */
 extern double mem_size(void);
 
+/*
+ * Return the peak resident memory of the current process, in bytes.
+ * - this is implemented on Linux only: return 0 on other systems
+ */
+extern double peak_mem_size(void);
+
 
 #endif /* __MEM_SIZE_H */
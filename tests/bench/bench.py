@@ -0,0 +1,317 @@
+#!/usr/bin/env python3
+
+#
+#  This file is part of the Yices SMT Solver.
+#  Copyright (C) 2017 SRI International.
+#
+#  Yices is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published by
+#  the Free Software Foundation, either version 3 of the License, or
+#  (at your option) any later version.
+#
+#  Yices is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+#
+
+#
+# Run benchmarks
+#
+# Usage: bench.py [options] <instance-list> <bin-dir> <output.json>
+#
+# instance-list is a file with one '<logic> <file>' pair per line
+# (cf. instances.txt). Each instance is solved by yices_smt2 several
+# times, with a fixed random seed. For each run, we record:
+# - the wall-clock and CPU time, and the peak resident memory (as
+#   reported by Yices if available, from getrusage otherwise)
+# - the search statistics (decisions, conflicts, propagations)
+# - the CPU time spent in each phase: parsing, internalization, search,
+#   and model construction.
+#
+# The results are written in JSON. If a baseline (i.e., the JSON output
+# of a previous run) is given, the times of each instance are compared
+# with the baseline using a permutation test. A change is reported if
+# it's larger than --min-change and its p-value is less than --alpha.
+# (With n runs on each side, the smallest possible p-value is
+# 2/binomial(2n, n), so at least 4 runs are needed for alpha = 0.05.)
+# The exit code is 1 if there's a significant slowdown or if an
+# instance gives a different answer than in the baseline.
+#
+# From the top-level directory, 'make bench' runs this script on
+# tests/bench/instances.txt. Options can be given in BENCH_OPTIONS:
+#
+#   make bench MODE=release BENCH_OPTIONS='--baseline old.json --runs 10'
+#
+
+import argparse
+import itertools
+import json
+import os
+import platform
+import random
+import re
+import subprocess
+import sys
+import tempfile
+import threading
+import time
+
+
+#
+# Statistics from 'yices_smt2 --stats' that we keep
+#
+STATS = {
+    'total-run-time': 'total_time',
+    'internalization-time': 'internalization_time',
+    'search-time': 'search_time',
+    'model-time': 'model_time',
+    'peak-mem-usage': 'peak_mem_mb',
+    'decisions': 'decisions',
+    'conflicts': 'conflicts',
+    'boolean-propagations': 'propagations',
+    'theory-propagations': 'theory_propagations',
+}
+
+STAT_RE = re.compile(r'^\s*\(?:([a-z-]+) ([0-9.]+)')
+RESULTS = ('sat', 'unsat', 'unknown')
+
+
+def read_instances(filename, pattern):
+    instances = []
+    with open(filename) as f:
+        for line in f:
+            line = line.split('#', 1)[0].split()
+            if len(line) == 0:
+                continue
+            if len(line) != 2:
+                sys.exit('{0}: bad line: {1}'.format(filename, ' '.join(line)))
+            logic, path = line
+            if pattern is None or re.search(pattern, path):
+                instances.append((logic, path))
+    return instances
+
+
+def peak_rss_kb(rusage):
+    # ru_maxrss is in bytes on Darwin and in kilobytes elsewhere
+    if platform.system() == 'Darwin':
+        return rusage.ru_maxrss // 1024
+    return rusage.ru_maxrss
+
+
+#
+# Run yices_smt2 once on file
+# - the seed is set by an option command before the file's content
+# - return a dictionary or None if the run times out or fails
+#
+def run_once(binary, path, seed, timeout):
+    options = []
+    if os.path.exists(path + '.options'):
+        with open(path + '.options') as f:
+            options = f.read().split()
+
+    with tempfile.TemporaryFile() as inp, tempfile.TemporaryFile() as out:
+        inp.write('(set-option :random-seed {0})\n'.format(seed).encode())
+        with open(path, 'rb') as f:
+            inp.write(f.read())
+        inp.seek(0)
+
+        start = time.time()
+        proc = subprocess.Popen([binary, '--stats'] + options,
+                                stdin=inp, stdout=out, stderr=subprocess.STDOUT)
+        timer = threading.Timer(timeout, proc.kill)
+        timer.start()
+        _, status, rusage = os.wait4(proc.pid, 0)
+        timer.cancel()
+        proc.returncode = status
+        wall = time.time() - start
+
+        if status != 0:
+            return None
+
+        out.seek(0)
+        lines = out.read().decode(errors='replace').splitlines()
+
+    run = {
+        'result': 'none',
+        'wall_time': wall,
+        'cpu_time': rusage.ru_utime + rusage.ru_stime,
+        'peak_rss_kb': peak_rss_kb(rusage),
+    }
+    for line in lines:
+        line = line.strip()
+        if line in RESULTS and run['result'] == 'none':
+            run['result'] = line
+            continue
+        m = STAT_RE.match(line)
+        if m and m.group(1) in STATS:
+            run[STATS[m.group(1)]] = float(m.group(2))
+
+    # ru_maxrss may include the memory of this script (copied at fork)
+    if 'peak_mem_mb' in run:
+        run['peak_rss_kb'] = int(run.pop('peak_mem_mb') * 1024)
+
+    phases = ('internalization_time', 'search_time', 'model_time')
+    if 'total_time' in run and all(p in run for p in phases):
+        run['parse_time'] = max(0.0, run['total_time'] - sum(run[p] for p in phases))
+    return run
+
+
+def median(values):
+    v = sorted(values)
+    n = len(v)
+    if n % 2 == 1:
+        return v[n // 2]
+    return (v[n // 2 - 1] + v[n // 2]) / 2.0
+
+
+def mean(values):
+    return sum(values) / float(len(values))
+
+
+def bench_instance(binary, logic, path, args):
+    samples = {}
+    result = None
+    for i in range(args.runs):
+        run = run_once(binary, path, args.seed, args.timeout)
+        if run is None:
+            return {'logic': logic, 'file': path, 'result': 'error'}
+        result = run.pop('result')
+        for key, val in run.items():
+            samples.setdefault(key, []).append(val)
+
+    return {
+        'logic': logic,
+        'file': path,
+        'result': result,
+        'samples': samples,
+        'median': dict((key, median(val)) for key, val in samples.items()),
+    }
+
+
+#
+# Two-sided permutation test on the difference of means
+# - exact if the number of splits is small, sampled otherwise
+#
+def permutation_pvalue(a, b, rounds=20000):
+    pooled = a + b
+    n = len(a)
+    observed = abs(mean(a) - mean(b))
+    total = sum(pooled)
+
+    def extreme(chosen):
+        s = sum(chosen)
+        return abs(s / n - (total - s) / float(len(b))) >= observed - 1e-12
+
+    count = 0
+    trials = 0
+    splits = 1
+    for k in range(n):
+        splits = splits * (len(pooled) - k) // (k + 1)
+    if splits <= rounds:
+        for chosen in itertools.combinations(pooled, n):
+            trials += 1
+            count += extreme(chosen)
+    else:
+        rng = random.Random(0)
+        for _ in range(rounds):
+            trials += 1
+            count += extreme(rng.sample(pooled, n))
+
+    return count / float(trials)
+
+
+def compare(report, baseline, args):
+    base = dict((r['file'], r) for r in baseline['instances'])
+    bad = False
+
+    print('\n=== Comparison with {0} ==='.format(args.baseline))
+    for r in report['instances']:
+        old = base.get(r['file'])
+        if old is None or 'samples' not in old or 'samples' not in r:
+            continue
+        name = os.path.basename(r['file'])
+
+        if old['result'] != r['result']:
+            print('{0}: DIFFERENT RESULT ({1} -> {2})'.format(name, old['result'], r['result']))
+            bad = True
+            continue
+
+        a = old['samples'][args.metric]
+        b = r['samples'][args.metric]
+        change = (mean(b) - mean(a)) / max(mean(a), 1e-6)
+        p = permutation_pvalue(a, b)
+        if abs(change) >= args.min_change and p < args.alpha:
+            verdict = 'SLOWER' if change > 0 else 'FASTER'
+            bad = bad or change > 0
+        else:
+            verdict = 'same'
+        print('{0}: {1:.3f} -> {2:.3f} ({3:+.1%}, p={4:.3f}) {5}'.format(
+            name, mean(a), mean(b), change, p, verdict))
+
+        # with a fixed seed, the search is deterministic
+        c0 = old['median'].get('conflicts')
+        c1 = r['median'].get('conflicts')
+        if c0 != c1:
+            print('  search changed: conflicts {0} -> {1}'.format(c0, c1))
+
+    return bad
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Run Yices benchmarks')
+    parser.add_argument('instances', help='instance list')
+    parser.add_argument('bindir', help='directory that contains yices_smt2')
+    parser.add_argument('output', help='JSON output file')
+    parser.add_argument('--runs', type=int, default=5, help='runs per instance (default: 5)')
+    parser.add_argument('--seed', type=int, default=12345, help='random seed (default: 12345)')
+    parser.add_argument('--timeout', type=float, default=300, help='timeout per run in seconds (default: 300)')
+    parser.add_argument('--filter', default=None, help='only run instances whose path matches this regex')
+    parser.add_argument('--baseline', default=None, help='JSON output of a previous run')
+    parser.add_argument('--metric', default='cpu_time', help='metric to compare (default: cpu_time)')
+    parser.add_argument('--alpha', type=float, default=0.05, help='significance level (default: 0.05)')
+    parser.add_argument('--min-change', type=float, default=0.03,
+                        help='smallest relative change reported (default: 0.03)')
+    args = parser.parse_args()
+
+    binary = os.path.join(args.bindir, 'yices_smt2')
+    if not os.access(binary, os.X_OK):
+        sys.exit('{0}: not found'.format(binary))
+
+    report = {
+        'version': 1,
+        'binary': binary,
+        'host': platform.node(),
+        'date': time.strftime('%Y-%m-%d %H:%M:%S'),
+        'runs': args.runs,
+        'seed': args.seed,
+        'instances': [],
+    }
+
+    for logic, path in read_instances(args.instances, args.filter):
+        r = bench_instance(binary, logic, path, args)
+        report['instances'].append(r)
+        if 'median' in r:
+            m = r['median']
+            print('{0:<9} {1} {2} [{3:.3f} s, {4} KB]'.format(
+                logic, path, r['result'], m['cpu_time'], int(m['peak_rss_kb'])))
+        else:
+            print('{0:<9} {1} ERROR'.format(logic, path))
+        sys.stdout.flush()
+
+    with open(args.output, 'w') as f:
+        json.dump(report, f, indent=1, sort_keys=True)
+    print('Results written to {0}'.format(args.output))
+
+    if args.baseline is not None:
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+        if compare(report, baseline, args):
+            sys.exit(1)
+
+
+if __name__ == '__main__':
+    main()
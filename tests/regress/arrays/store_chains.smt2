@@ -0,0 +1,97 @@
+; two store chains over the same stores in different orders
+;  a0 = b0 implies a24 = b24
+(set-logic QF_AX)
+(declare-sort I 0)
+(declare-sort E 0)
+(declare-fun a0 () (Array I E))
+(declare-fun b0 () (Array I E))
+(declare-fun i0 () I)
+(declare-fun i1 () I)
+(declare-fun i2 () I)
+(declare-fun i3 () I)
+(declare-fun i4 () I)
+(declare-fun i5 () I)
+(declare-fun i6 () I)
+(declare-fun i7 () I)
+(declare-fun e0 () E)
+(declare-fun e1 () E)
+(declare-fun e2 () E)
+(declare-fun e3 () E)
+(declare-fun e4 () E)
+(declare-fun e5 () E)
+(declare-fun e6 () E)
+(declare-fun e7 () E)
+(declare-fun e8 () E)
+(declare-fun e9 () E)
+(declare-fun e10 () E)
+(declare-fun e11 () E)
+(declare-fun e12 () E)
+(declare-fun e13 () E)
+(declare-fun e14 () E)
+(declare-fun e15 () E)
+(declare-fun e16 () E)
+(declare-fun e17 () E)
+(declare-fun e18 () E)
+(declare-fun e19 () E)
+(declare-fun e20 () E)
+(declare-fun e21 () E)
+(declare-fun e22 () E)
+(declare-fun e23 () E)
+(define-fun a1 () (Array I E) (store a0 i0 e0))
+(define-fun a2 () (Array I E) (store a1 i1 e1))
+(define-fun a3 () (Array I E) (store a2 i2 e2))
+(define-fun a4 () (Array I E) (store a3 i3 e3))
+(define-fun a5 () (Array I E) (store a4 i4 e4))
+(define-fun a6 () (Array I E) (store a5 i5 e5))
+(define-fun a7 () (Array I E) (store a6 i6 e6))
+(define-fun a8 () (Array I E) (store a7 i7 e7))
+(define-fun a9 () (Array I E) (store a8 i0 e8))
+(define-fun a10 () (Array I E) (store a9 i1 e9))
+(define-fun a11 () (Array I E) (store a10 i2 e10))
+(define-fun a12 () (Array I E) (store a11 i3 e11))
+(define-fun a13 () (Array I E) (store a12 i4 e12))
+(define-fun a14 () (Array I E) (store a13 i5 e13))
+(define-fun a15 () (Array I E) (store a14 i6 e14))
+(define-fun a16 () (Array I E) (store a15 i7 e15))
+(define-fun a17 () (Array I E) (store a16 i0 e16))
+(define-fun a18 () (Array I E) (store a17 i1 e17))
+(define-fun a19 () (Array I E) (store a18 i2 e18))
+(define-fun a20 () (Array I E) (store a19 i3 e19))
+(define-fun a21 () (Array I E) (store a20 i4 e20))
+(define-fun a22 () (Array I E) (store a21 i5 e21))
+(define-fun a23 () (Array I E) (store a22 i6 e22))
+(define-fun a24 () (Array I E) (store a23 i7 e23))
+(define-fun b1 () (Array I E) (store b0 i3 e3))
+(define-fun b2 () (Array I E) (store b1 i6 e6))
+(define-fun b3 () (Array I E) (store b2 i1 e1))
+(define-fun b4 () (Array I E) (store b3 i5 e5))
+(define-fun b5 () (Array I E) (store b4 i7 e7))
+(define-fun b6 () (Array I E) (store b5 i0 e0))
+(define-fun b7 () (Array I E) (store b6 i4 e4))
+(define-fun b8 () (Array I E) (store b7 i2 e2))
+(define-fun b9 () (Array I E) (store b8 i2 e10))
+(define-fun b10 () (Array I E) (store b9 i6 e14))
+(define-fun b11 () (Array I E) (store b10 i4 e12))
+(define-fun b12 () (Array I E) (store b11 i0 e8))
+(define-fun b13 () (Array I E) (store b12 i1 e9))
+(define-fun b14 () (Array I E) (store b13 i3 e11))
+(define-fun b15 () (Array I E) (store b14 i5 e13))
+(define-fun b16 () (Array I E) (store b15 i7 e15))
+(define-fun b17 () (Array I E) (store b16 i2 e18))
+(define-fun b18 () (Array I E) (store b17 i5 e21))
+(define-fun b19 () (Array I E) (store b18 i1 e17))
+(define-fun b20 () (Array I E) (store b19 i7 e23))
+(define-fun b21 () (Array I E) (store b20 i0 e16))
+(define-fun b22 () (Array I E) (store b21 i4 e20))
+(define-fun b23 () (Array I E) (store b22 i3 e19))
+(define-fun b24 () (Array I E) (store b23 i6 e22))
+(assert (= a0 b0))
+(assert (distinct i0 i1 i2 i3 i4 i5 i6 i7))
+(check-sat)
+(push 1)
+(assert (not (= a24 b24)))
+(check-sat)
+(pop 1)
+(assert (not (= (select a24 i3) (select b0 i3))))
+(check-sat)
+(exit)
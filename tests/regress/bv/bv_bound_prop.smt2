@@ -0,0 +1,69 @@
+(set-logic QF_BV)
+(declare-fun x0 () (_ BitVec 16))
+(declare-fun x1 () (_ BitVec 16))
+(declare-fun x2 () (_ BitVec 16))
+(declare-fun x3 () (_ BitVec 16))
+(declare-fun x4 () (_ BitVec 16))
+(declare-fun x5 () (_ BitVec 16))
+(assert (or (bvuge x1 (_ bv33432 16)) (bvule x0 (_ bv58915 16)) (bvule x3 (_ bv27519 16))))
+(assert (or (bvule x0 (_ bv3715 16)) (bvule x3 (_ bv276 16)) (bvule x5 (_ bv34908 16))))
+(assert (or (bvuge x5 (_ bv13399 16)) (bvuge x2 (_ bv2925 16)) (bvuge x0 (_ bv49965 16))))
+(assert (or (bvuge x5 (_ bv55327 16)) (bvuge x5 (_ bv29057 16)) (bvule x3 (_ bv30550 16))))
+(assert (or (bvuge x2 (_ bv28676 16)) (bvule x3 (_ bv2816 16)) (bvuge x3 (_ bv24367 16))))
+(assert (or (bvule x5 (_ bv15845 16)) (bvule x5 (_ bv55326 16)) (bvuge x4 (_ bv39763 16))))
+(assert (or (bvule x2 (_ bv51557 16)) (bvuge x4 (_ bv62944 16)) (bvule x1 (_ bv54304 16))))
+(assert (or (bvuge x5 (_ bv48119 16)) (bvule x4 (_ bv11333 16)) (bvuge x3 (_ bv21456 16))))
+(assert (or (bvule x4 (_ bv48565 16)) (bvuge x3 (_ bv61514 16)) (bvule x0 (_ bv51589 16))))
+(assert (or (bvuge x5 (_ bv22097 16)) (bvuge x4 (_ bv1612 16)) (bvuge x1 (_ bv53012 16))))
+(assert (or (bvule x4 (_ bv46304 16)) (bvule x3 (_ bv748 16)) (bvuge x3 (_ bv26933 16))))
+(assert (or (bvuge x3 (_ bv63058 16)) (bvuge x2 (_ bv54185 16)) (bvule x3 (_ bv54319 16))))
+(assert (or (bvuge x2 (_ bv43402 16)) (bvuge x3 (_ bv30094 16)) (bvuge x5 (_ bv23695 16))))
+(assert (or (bvule x0 (_ bv4254 16)) (bvuge x5 (_ bv10909 16)) (bvule x0 (_ bv1908 16))))
+(assert (or (bvuge x2 (_ bv35211 16)) (bvuge x0 (_ bv45144 16)) (bvuge x2 (_ bv21950 16))))
+(assert (or (bvule x1 (_ bv22039 16)) (bvule x5 (_ bv38599 16)) (bvule x3 (_ bv65076 16))))
+(assert (or (bvuge x3 (_ bv3097 16)) (bvule x2 (_ bv45002 16)) (bvuge x3 (_ bv33871 16))))
+(assert (or (bvule x0 (_ bv27405 16)) (bvule x4 (_ bv2728 16)) (bvuge x1 (_ bv52076 16))))
+(assert (or (bvuge x1 (_ bv21001 16)) (bvule x3 (_ bv28914 16)) (bvule x5 (_ bv29254 16))))
+(assert (or (bvuge x4 (_ bv51760 16)) (bvule x5 (_ bv55875 16)) (bvule x0 (_ bv16473 16))))
+(assert (or (bvuge x1 (_ bv40158 16)) (bvuge x0 (_ bv40679 16)) (bvuge x2 (_ bv54548 16))))
+(assert (or (bvule x4 (_ bv17090 16)) (bvuge x0 (_ bv28520 16)) (bvule x4 (_ bv22481 16))))
+(assert (or (bvuge x5 (_ bv49541 16)) (bvule x1 (_ bv12979 16)) (bvule x1 (_ bv25443 16))))
+(assert (or (bvuge x3 (_ bv51126 16)) (bvule x2 (_ bv2254 16)) (bvule x2 (_ bv36877 16))))
+(assert (or (bvuge x0 (_ bv26326 16)) (bvuge x2 (_ bv44445 16)) (bvuge x3 (_ bv34935 16))))
+(assert (or (bvuge x5 (_ bv49706 16)) (bvule x4 (_ bv63504 16)) (bvuge x4 (_ bv8561 16))))
+(assert (or (bvuge x5 (_ bv11099 16)) (bvuge x1 (_ bv21830 16)) (bvuge x4 (_ bv35128 16))))
+(assert (or (bvule x2 (_ bv48248 16)) (bvule x2 (_ bv14930 16)) (bvuge x2 (_ bv64067 16))))
+(assert (or (bvuge x1 (_ bv42038 16)) (bvule x0 (_ bv9593 16)) (bvuge x3 (_ bv16386 16))))
+(assert (or (bvuge x2 (_ bv49550 16)) (bvuge x0 (_ bv10714 16)) (bvule x2 (_ bv38738 16))))
+(assert (or (bvuge x4 (_ bv60000 16)) (bvuge x2 (_ bv5996 16)) (bvuge x2 (_ bv1906 16))))
+(assert (or (bvule x0 (_ bv15086 16)) (bvuge x0 (_ bv31409 16)) (bvule x4 (_ bv21236 16))))
+(assert (or (bvule x0 (_ bv21939 16)) (bvuge x5 (_ bv20833 16)) (bvuge x5 (_ bv57029 16))))
+(assert (or (bvule x3 (_ bv33214 16)) (bvule x5 (_ bv41216 16)) (bvuge x0 (_ bv41604 16))))
+(assert (or (bvuge x0 (_ bv1377 16)) (bvule x2 (_ bv58962 16)) (bvule x3 (_ bv52239 16))))
+(assert (or (bvuge x0 (_ bv41595 16)) (bvule x4 (_ bv14596 16)) (bvuge x2 (_ bv61462 16))))
+(assert (or (bvule x5 (_ bv33958 16)) (bvuge x1 (_ bv40281 16)) (bvuge x1 (_ bv47246 16))))
+(assert (or (bvule x0 (_ bv11719 16)) (bvuge x3 (_ bv44418 16)) (bvule x1 (_ bv40210 16))))
+(assert (or (bvule x0 (_ bv24485 16)) (bvule x2 (_ bv32223 16)) (bvuge x2 (_ bv12064 16))))
+(assert (or (bvuge x1 (_ bv2670 16)) (bvule x1 (_ bv9480 16)) (bvuge x2 (_ bv9847 16))))
+(assert (or (bvuge x0 (_ bv38118 16)) (bvule x2 (_ bv61451 16)) (bvuge x1 (_ bv43003 16))))
+(assert (or (bvuge x0 (_ bv23536 16)) (bvuge x1 (_ bv41914 16)) (bvuge x2 (_ bv38468 16))))
+(assert (or (bvuge x1 (_ bv18570 16)) (bvuge x4 (_ bv41427 16)) (bvuge x4 (_ bv23351 16))))
+(assert (or (bvule x2 (_ bv20695 16)) (bvuge x0 (_ bv33107 16)) (bvule x0 (_ bv56383 16))))
+(assert (or (bvule x4 (_ bv57592 16)) (bvule x4 (_ bv1424 16)) (bvule x3 (_ bv22481 16))))
+(assert (or (bvule x2 (_ bv3199 16)) (bvule x5 (_ bv2478 16)) (bvule x0 (_ bv18125 16))))
+(assert (or (bvuge x4 (_ bv18152 16)) (bvule x2 (_ bv52140 16)) (bvule x4 (_ bv22567 16))))
+(assert (or (bvuge x4 (_ bv30609 16)) (bvuge x3 (_ bv23275 16)) (bvule x4 (_ bv57451 16))))
+(assert (or (bvuge x5 (_ bv31244 16)) (bvule x2 (_ bv62760 16)) (bvule x1 (_ bv44164 16))))
+(assert (or (bvule x4 (_ bv28766 16)) (bvuge x0 (_ bv48324 16)) (bvuge x1 (_ bv40868 16))))
+(assert (or (bvule x2 (_ bv48708 16)) (bvule x1 (_ bv11137 16)) (bvule x0 (_ bv23104 16))))
+(assert (or (bvule x1 (_ bv55935 16)) (bvuge x1 (_ bv64884 16)) (bvule x5 (_ bv45610 16))))
+(assert (or (bvuge x3 (_ bv5335 16)) (bvuge x4 (_ bv33447 16)) (bvuge x5 (_ bv35065 16))))
+(assert (or (bvuge x5 (_ bv18235 16)) (bvuge x4 (_ bv58334 16)) (bvule x1 (_ bv56743 16))))
+(assert (or (bvuge x3 (_ bv42659 16)) (bvuge x3 (_ bv63958 16)) (bvuge x1 (_ bv56526 16))))
+(assert (or (bvule x4 (_ bv15478 16)) (bvule x5 (_ bv36395 16)) (bvule x1 (_ bv525 16))))
+(assert (or (bvule x1 (_ bv2757 16)) (bvuge x0 (_ bv34130 16)) (bvuge x1 (_ bv37326 16))))
+(assert (or (bvuge x1 (_ bv35812 16)) (bvule x2 (_ bv58510 16)) (bvule x1 (_ bv64331 16))))
+(assert (or (bvuge x3 (_ bv27386 16)) (bvule x4 (_ bv26846 16)) (bvuge x2 (_ bv3165 16))))
+(assert (or (bvuge x0 (_ bv38851 16)) (bvuge x5 (_ bv9854 16)) (bvule x4 (_ bv40796 16))))
+(assert (= (bvadd x0 x1 x2) (bvmul x3 x4)))
+(check-sat)
@@ -0,0 +1,99 @@
+(set-logic QF_BV)
+(declare-fun x0 () (_ BitVec 16))
+(declare-fun x1 () (_ BitVec 16))
+(declare-fun x2 () (_ BitVec 16))
+(declare-fun x3 () (_ BitVec 16))
+(declare-fun x4 () (_ BitVec 16))
+(declare-fun x5 () (_ BitVec 16))
+(assert (or (bvule x3 (_ bv5306 16)) (bvule x2 (_ bv53075 16))))
+(assert (or (bvule x2 (_ bv46930 16)) (bvuge x4 (_ bv18254 16))))
+(assert (or (bvuge x2 (_ bv12429 16)) (bvule x4 (_ bv19262 16))))
+(assert (or (bvuge x2 (_ bv9665 16)) (bvule x5 (_ bv61884 16))))
+(assert (or (bvuge x4 (_ bv46372 16)) (bvule x3 (_ bv26801 16))))
+(assert (or (bvule x4 (_ bv58024 16)) (bvule x4 (_ bv8163 16))))
+(assert (or (bvuge x4 (_ bv12225 16)) (bvule x5 (_ bv149 16))))
+(assert (or (bvule x4 (_ bv43664 16)) (bvule x1 (_ bv8255 16))))
+(assert (or (bvuge x1 (_ bv31275 16)) (bvule x1 (_ bv11955 16))))
+(assert (or (bvule x0 (_ bv64131 16)) (bvule x0 (_ bv38153 16))))
+(assert (or (bvuge x5 (_ bv43614 16)) (bvuge x4 (_ bv37703 16))))
+(assert (or (bvuge x3 (_ bv50449 16)) (bvuge x2 (_ bv38054 16))))
+(assert (or (bvuge x1 (_ bv24475 16)) (bvule x0 (_ bv62459 16))))
+(assert (or (bvuge x0 (_ bv17068 16)) (bvuge x1 (_ bv10518 16))))
+(assert (or (bvule x5 (_ bv36127 16)) (bvuge x4 (_ bv28206 16))))
+(assert (or (bvule x5 (_ bv36072 16)) (bvule x3 (_ bv46840 16))))
+(assert (or (bvule x0 (_ bv15119 16)) (bvule x3 (_ bv24953 16))))
+(assert (or (bvuge x1 (_ bv35525 16)) (bvuge x0 (_ bv48766 16))))
+(assert (or (bvule x1 (_ bv55853 16)) (bvuge x0 (_ bv19183 16))))
+(assert (or (bvuge x5 (_ bv5928 16)) (bvuge x4 (_ bv3499 16))))
+(assert (or (bvuge x0 (_ bv15688 16)) (bvuge x3 (_ bv48514 16))))
+(assert (or (bvuge x0 (_ bv2835 16)) (bvuge x1 (_ bv16239 16))))
+(assert (or (bvuge x3 (_ bv8006 16)) (bvuge x5 (_ bv55786 16))))
+(assert (or (bvuge x4 (_ bv34068 16)) (bvuge x0 (_ bv9433 16))))
+(assert (or (bvule x5 (_ bv45913 16)) (bvuge x3 (_ bv8000 16))))
+(assert (or (bvule x4 (_ bv5161 16)) (bvuge x4 (_ bv51285 16))))
+(assert (or (bvule x1 (_ bv46996 16)) (bvule x5 (_ bv22206 16))))
+(assert (or (bvuge x5 (_ bv7608 16)) (bvuge x5 (_ bv21227 16))))
+(assert (or (bvule x2 (_ bv15363 16)) (bvule x4 (_ bv22913 16))))
+(assert (or (bvule x0 (_ bv53727 16)) (bvule x4 (_ bv46812 16))))
+(assert (or (bvule x3 (_ bv20108 16)) (bvuge x4 (_ bv60024 16))))
+(assert (or (bvuge x5 (_ bv44029 16)) (bvuge x5 (_ bv36815 16))))
+(assert (or (bvuge x1 (_ bv63154 16)) (bvule x2 (_ bv47081 16))))
+(assert (or (bvuge x4 (_ bv40671 16)) (bvule x3 (_ bv10580 16))))
+(assert (or (bvuge x0 (_ bv43830 16)) (bvuge x1 (_ bv29241 16))))
+(assert (or (bvule x5 (_ bv49630 16)) (bvule x5 (_ bv4134 16))))
+(assert (or (bvule x3 (_ bv6131 16)) (bvule x1 (_ bv8373 16))))
+(assert (or (bvuge x2 (_ bv58505 16)) (bvule x4 (_ bv9 16))))
+(assert (or (bvule x0 (_ bv42722 16)) (bvule x2 (_ bv6534 16))))
+(assert (or (bvuge x3 (_ bv10940 16)) (bvuge x5 (_ bv1930 16))))
+(assert (or (bvule x3 (_ bv41441 16)) (bvuge x0 (_ bv1873 16))))
+(assert (or (bvuge x5 (_ bv12816 16)) (bvuge x1 (_ bv26019 16))))
+(assert (or (bvule x2 (_ bv23884 16)) (bvule x0 (_ bv51995 16))))
+(assert (or (bvuge x5 (_ bv2863 16)) (bvule x2 (_ bv15175 16))))
+(assert (or (bvuge x2 (_ bv45488 16)) (bvuge x0 (_ bv36491 16))))
+(assert (or (bvuge x0 (_ bv5329 16)) (bvule x1 (_ bv41250 16))))
+(assert (or (bvuge x2 (_ bv64813 16)) (bvule x5 (_ bv57074 16))))
+(assert (or (bvuge x2 (_ bv27242 16)) (bvule x3 (_ bv1166 16))))
+(assert (or (bvuge x1 (_ bv35569 16)) (bvule x2 (_ bv48129 16))))
+(assert (or (bvuge x5 (_ bv44335 16)) (bvuge x4 (_ bv5400 16))))
+(assert (or (bvuge x2 (_ bv19584 16)) (bvule x4 (_ bv47304 16))))
+(assert (or (bvuge x3 (_ bv38457 16)) (bvule x0 (_ bv31418 16))))
+(assert (or (bvule x0 (_ bv23538 16)) (bvuge x4 (_ bv39671 16))))
+(assert (or (bvule x3 (_ bv39220 16)) (bvuge x3 (_ bv13028 16))))
+(assert (or (bvule x4 (_ bv62128 16)) (bvule x2 (_ bv16295 16))))
+(assert (or (bvuge x3 (_ bv65239 16)) (bvuge x3 (_ bv39571 16))))
+(assert (or (bvuge x2 (_ bv21830 16)) (bvule x5 (_ bv11393 16))))
+(assert (or (bvuge x0 (_ bv25957 16)) (bvuge x5 (_ bv8015 16))))
+(assert (or (bvuge x3 (_ bv12855 16)) (bvule x3 (_ bv58791 16))))
+(assert (or (bvuge x3 (_ bv55448 16)) (bvule x0 (_ bv28853 16))))
+(assert (or (bvuge x2 (_ bv56521 16)) (bvule x1 (_ bv15074 16))))
+(assert (or (bvuge x0 (_ bv59193 16)) (bvuge x5 (_ bv15585 16))))
+(assert (or (bvule x3 (_ bv33617 16)) (bvuge x1 (_ bv28297 16))))
+(assert (or (bvuge x4 (_ bv13714 16)) (bvule x1 (_ bv49549 16))))
+(assert (or (bvuge x2 (_ bv13729 16)) (bvule x4 (_ bv19451 16))))
+(assert (or (bvule x4 (_ bv55474 16)) (bvule x4 (_ bv42265 16))))
+(assert (or (bvule x3 (_ bv26475 16)) (bvuge x4 (_ bv1272 16))))
+(assert (or (bvule x2 (_ bv42182 16)) (bvuge x0 (_ bv33670 16))))
+(assert (or (bvuge x4 (_ bv49676 16)) (bvule x4 (_ bv61660 16))))
+(assert (or (bvuge x0 (_ bv5166 16)) (bvuge x0 (_ bv17104 16))))
+(assert (or (bvule x0 (_ bv2003 16)) (bvule x3 (_ bv21061 16))))
+(assert (or (bvule x1 (_ bv48669 16)) (bvule x4 (_ bv4406 16))))
+(assert (or (bvuge x4 (_ bv10008 16)) (bvule x5 (_ bv27014 16))))
+(assert (or (bvule x2 (_ bv63204 16)) (bvuge x3 (_ bv2684 16))))
+(assert (or (bvuge x5 (_ bv23851 16)) (bvule x2 (_ bv43605 16))))
+(assert (or (bvule x0 (_ bv34341 16)) (bvule x2 (_ bv50352 16))))
+(assert (or (bvuge x3 (_ bv21468 16)) (bvuge x5 (_ bv31319 16))))
+(assert (or (bvule x2 (_ bv7278 16)) (bvule x0 (_ bv54770 16))))
+(assert (or (bvule x1 (_ bv10698 16)) (bvuge x5 (_ bv46238 16))))
+(assert (or (bvuge x3 (_ bv61116 16)) (bvule x3 (_ bv6164 16))))
+(assert (or (bvule x0 (_ bv19840 16)) (bvuge x0 (_ bv17393 16))))
+(assert (or (bvule x5 (_ bv13800 16)) (bvule x5 (_ bv25555 16))))
+(assert (or (bvule x3 (_ bv14548 16)) (bvule x0 (_ bv44284 16))))
+(assert (or (bvuge x5 (_ bv38847 16)) (bvule x1 (_ bv38509 16))))
+(assert (or (bvuge x5 (_ bv24789 16)) (bvule x0 (_ bv58271 16))))
+(assert (or (bvuge x2 (_ bv59699 16)) (bvuge x2 (_ bv5851 16))))
+(assert (or (bvule x0 (_ bv33473 16)) (bvuge x0 (_ bv30101 16))))
+(assert (or (bvule x0 (_ bv40017 16)) (bvuge x0 (_ bv55832 16))))
+(assert (or (bvule x4 (_ bv11014 16)) (bvule x0 (_ bv8247 16))))
+(assert (or (bvule x0 (_ bv20467 16)) (bvuge x5 (_ bv58552 16))))
+(assert (= (bvadd x0 x1 x2) (bvmul x3 x4)))
+(check-sat)
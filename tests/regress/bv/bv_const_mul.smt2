@@ -0,0 +1,22 @@
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 16))
+(declare-fun y () (_ BitVec 16))
+(push 1)
+(assert (= (bvmul (_ bv240 16) x) (_ bv8 16)))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (= (bvmul x (_ bv65535 16)) (_ bv3 16)))
+(check-sat)
+(assert (not (= x (_ bv65533 16))))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (= (bvadd (bvmul (_ bv32760 16) x) (bvmul (_ bv61455 16) y)) (_ bv1234 16)))
+(assert (bvult x (_ bv256 16)))
+(assert (bvult y (_ bv256 16)))
+(check-sat)
+(pop 1)
+(assert (= (bvmul (_ bv30583 16) x) (bvmul (_ bv30583 16) y)))
+(assert (not (= x y)))
+(check-sat)
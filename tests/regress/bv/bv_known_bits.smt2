@@ -0,0 +1,14 @@
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 16))
+(declare-fun y () (_ BitVec 16))
+(declare-fun z () (_ BitVec 8))
+(assert (bvuge x #x0100))
+(assert (bvule x #x01ff))
+(assert (= ((_ extract 1 0) x) #b00))
+(assert (bvult y x))
+(assert (bvuge y #x01fb))
+(assert (not (= z #x00)))
+(assert (bvule z #x01))
+(assert (= (bvadd x y ((_ zero_extend 8) z)) #x03f8))
+(check-sat)
+(get-value (x y z))
@@ -0,0 +1,10 @@
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 8))
+(declare-fun y () (_ BitVec 8))
+(assert (bvsge x #x05))
+(assert (bvsle x #x06))
+(assert (bvugt y x))
+(assert (= ((_ extract 0 0) y) #b1))
+(assert (not (= y #x07)))
+(assert (bvule y #x08))
+(check-sat)
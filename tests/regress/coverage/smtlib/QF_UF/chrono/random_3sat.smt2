@@ -0,0 +1,595 @@
+(set-logic QF_UF)
+(set-option :yices-chrono-backtrack true)
+(set-option :yices-chrono-threshold 0)
+(declare-fun x1 () Bool)
+(declare-fun x2 () Bool)
+(declare-fun x3 () Bool)
+(declare-fun x4 () Bool)
+(declare-fun x5 () Bool)
+(declare-fun x6 () Bool)
+(declare-fun x7 () Bool)
+(declare-fun x8 () Bool)
+(declare-fun x9 () Bool)
+(declare-fun x10 () Bool)
+(declare-fun x11 () Bool)
+(declare-fun x12 () Bool)
+(declare-fun x13 () Bool)
+(declare-fun x14 () Bool)
+(declare-fun x15 () Bool)
+(declare-fun x16 () Bool)
+(declare-fun x17 () Bool)
+(declare-fun x18 () Bool)
+(declare-fun x19 () Bool)
+(declare-fun x20 () Bool)
+(declare-fun x21 () Bool)
+(declare-fun x22 () Bool)
+(declare-fun x23 () Bool)
+(declare-fun x24 () Bool)
+(declare-fun x25 () Bool)
+(declare-fun x26 () Bool)
+(declare-fun x27 () Bool)
+(declare-fun x28 () Bool)
+(declare-fun x29 () Bool)
+(declare-fun x30 () Bool)
+(declare-fun x31 () Bool)
+(declare-fun x32 () Bool)
+(declare-fun x33 () Bool)
+(declare-fun x34 () Bool)
+(declare-fun x35 () Bool)
+(declare-fun x36 () Bool)
+(declare-fun x37 () Bool)
+(declare-fun x38 () Bool)
+(declare-fun x39 () Bool)
+(declare-fun x40 () Bool)
+(declare-fun x41 () Bool)
+(declare-fun x42 () Bool)
+(declare-fun x43 () Bool)
+(declare-fun x44 () Bool)
+(declare-fun x45 () Bool)
+(declare-fun x46 () Bool)
+(declare-fun x47 () Bool)
+(declare-fun x48 () Bool)
+(declare-fun x49 () Bool)
+(declare-fun x50 () Bool)
+(declare-fun x51 () Bool)
+(declare-fun x52 () Bool)
+(declare-fun x53 () Bool)
+(declare-fun x54 () Bool)
+(declare-fun x55 () Bool)
+(declare-fun x56 () Bool)
+(declare-fun x57 () Bool)
+(declare-fun x58 () Bool)
+(declare-fun x59 () Bool)
+(declare-fun x60 () Bool)
+(declare-fun x61 () Bool)
+(declare-fun x62 () Bool)
+(declare-fun x63 () Bool)
+(declare-fun x64 () Bool)
+(declare-fun x65 () Bool)
+(declare-fun x66 () Bool)
+(declare-fun x67 () Bool)
+(declare-fun x68 () Bool)
+(declare-fun x69 () Bool)
+(declare-fun x70 () Bool)
+(declare-fun x71 () Bool)
+(declare-fun x72 () Bool)
+(declare-fun x73 () Bool)
+(declare-fun x74 () Bool)
+(declare-fun x75 () Bool)
+(declare-fun x76 () Bool)
+(declare-fun x77 () Bool)
+(declare-fun x78 () Bool)
+(declare-fun x79 () Bool)
+(declare-fun x80 () Bool)
+(declare-fun x81 () Bool)
+(declare-fun x82 () Bool)
+(declare-fun x83 () Bool)
+(declare-fun x84 () Bool)
+(declare-fun x85 () Bool)
+(declare-fun x86 () Bool)
+(declare-fun x87 () Bool)
+(declare-fun x88 () Bool)
+(declare-fun x89 () Bool)
+(declare-fun x90 () Bool)
+(declare-fun x91 () Bool)
+(declare-fun x92 () Bool)
+(declare-fun x93 () Bool)
+(declare-fun x94 () Bool)
+(declare-fun x95 () Bool)
+(declare-fun x96 () Bool)
+(declare-fun x97 () Bool)
+(declare-fun x98 () Bool)
+(declare-fun x99 () Bool)
+(declare-fun x100 () Bool)
+(assert (or x84 x62 x90))
+(assert (or x33 (not x70) x43))
+(assert (or (not x32) (not x31) (not x63)))
+(assert (or (not x84) (not x11) (not x79)))
+(assert (or x85 (not x57) (not x45)))
+(assert (or (not x33) (not x18) x79))
+(assert (or (not x68) (not x19) (not x13)))
+(assert (or (not x5) x100 (not x88)))
+(assert (or x34 (not x70) x7))
+(assert (or (not x100) (not x20) x45))
+(assert (or x57 x60 x46))
+(assert (or x62 x46 x67))
+(assert (or x95 x63 x72))
+(assert (or x44 (not x82) (not x15)))
+(assert (or x11 (not x39) (not x59)))
+(assert (or x37 (not x28) (not x99)))
+(assert (or x16 (not x1) x76))
+(assert (or (not x79) x13 x5))
+(assert (or (not x1) (not x24) x46))
+(assert (or (not x25) (not x96) x43))
+(assert (or (not x6) x24 x9))
+(assert (or x60 (not x78) (not x62)))
+(assert (or x4 (not x85) x63))
+(assert (or x56 (not x39) x86))
+(assert (or (not x92) (not x43) x73))
+(assert (or x78 x79 x90))
+(assert (or (not x17) x14 x52))
+(assert (or (not x97) x70 (not x95)))
+(assert (or (not x7) (not x75) (not x77)))
+(assert (or x29 (not x36) (not x70)))
+(assert (or x99 (not x57) x47))
+(assert (or x25 (not x21) (not x2)))
+(assert (or x49 (not x61) (not x44)))
+(assert (or (not x94) x7 (not x90)))
+(assert (or x63 (not x70) x12))
+(assert (or (not x85) (not x74) (not x63)))
+(assert (or (not x70) (not x49) x44))
+(assert (or (not x47) (not x96) x62))
+(assert (or (not x84) (not x29) x68))
+(assert (or x94 x45 x14))
+(assert (or x52 x63 x35))
+(assert (or x68 x60 (not x69)))
+(assert (or x34 x13 (not x15)))
+(assert (or (not x91) (not x73) x56))
+(assert (or x6 x23 (not x83)))
+(assert (or (not x11) (not x100) x32))
+(assert (or (not x82) x20 x15))
+(assert (or x69 x33 (not x64)))
+(assert (or x69 x3 x48))
+(assert (or x79 x20 (not x23)))
+(assert (or (not x96) x6 (not x48)))
+(assert (or (not x43) (not x60) x44))
+(assert (or (not x43) (not x34) (not x25)))
+(assert (or (not x9) x56 (not x84)))
+(assert (or x76 (not x50) (not x44)))
+(assert (or x16 x18 (not x88)))
+(assert (or (not x37) x63 (not x66)))
+(assert (or x35 (not x43) x12))
+(assert (or (not x22) (not x54) (not x4)))
+(assert (or x2 (not x83) (not x24)))
+(assert (or (not x3) (not x40) (not x86)))
+(assert (or x64 x71 x89))
+(assert (or x42 x72 (not x32)))
+(assert (or x85 (not x58) (not x3)))
+(assert (or (not x8) (not x29) x93))
+(assert (or (not x71) x6 (not x65)))
+(assert (or (not x17) x65 (not x91)))
+(assert (or x71 (not x57) x63))
+(assert (or (not x27) x96 (not x62)))
+(assert (or x60 x80 x67))
+(assert (or x85 x97 (not x27)))
+(assert (or x80 x19 x89))
+(assert (or (not x59) (not x53) x72))
+(assert (or x19 x87 x40))
+(assert (or (not x64) (not x91) (not x87)))
+(assert (or (not x5) (not x71) (not x99)))
+(assert (or (not x1) x63 x11))
+(assert (or (not x76) (not x93) (not x64)))
+(assert (or (not x58) x87 (not x64)))
+(assert (or (not x87) (not x78) x70))
+(assert (or (not x32) x61 (not x3)))
+(assert (or (not x75) (not x94) (not x49)))
+(assert (or (not x34) x73 x92))
+(assert (or (not x47) x32 x54))
+(assert (or x28 x49 x21))
+(assert (or x8 x96 x43))
+(assert (or x19 (not x16) x63))
+(assert (or x45 (not x50) (not x67)))
+(assert (or (not x86) x1 x99))
+(assert (or (not x87) (not x92) x82))
+(assert (or (not x37) (not x85) x97))
+(assert (or (not x15) x72 x63))
+(assert (or (not x60) x59 (not x25)))
+(assert (or (not x72) x73 x91))
+(assert (or (not x29) (not x99) (not x36)))
+(assert (or x100 x20 x25))
+(assert (or (not x10) (not x13) (not x24)))
+(assert (or x39 x73 x7))
+(assert (or (not x70) x97 x24))
+(assert (or x15 x100 (not x7)))
+(assert (or (not x50) x19 x62))
+(assert (or (not x52) x81 (not x50)))
+(assert (or x92 x8 (not x2)))
+(assert (or x17 (not x24) (not x74)))
+(assert (or x24 x96 (not x95)))
+(assert (or (not x2) (not x57) (not x36)))
+(assert (or x27 (not x66) (not x65)))
+(assert (or (not x86) x40 (not x32)))
+(assert (or (not x76) x32 (not x66)))
+(assert (or x60 x21 x66))
+(assert (or x100 x32 (not x56)))
+(assert (or (not x19) x2 x4))
+(assert (or (not x93) x25 (not x38)))
+(assert (or x39 (not x33) (not x15)))
+(assert (or x92 x73 x91))
+(assert (or x13 (not x84) x22))
+(assert (or x69 x6 (not x22)))
+(assert (or (not x92) x66 x52))
+(assert (or (not x70) x20 x56))
+(assert (or x29 x27 (not x80)))
+(assert (or x76 x9 x91))
+(assert (or (not x60) (not x71) x37))
+(assert (or (not x20) (not x94) (not x99)))
+(assert (or x53 (not x96) (not x71)))
+(assert (or (not x76) (not x27) (not x70)))
+(assert (or x85 x10 x90))
+(assert (or x88 (not x10) (not x93)))
+(assert (or (not x95) x50 (not x68)))
+(assert (or (not x64) x74 (not x66)))
+(assert (or (not x22) (not x79) (not x69)))
+(assert (or x26 (not x28) x32))
+(assert (or x63 x21 (not x8)))
+(assert (or (not x76) (not x44) x88))
+(assert (or x72 x8 (not x19)))
+(assert (or (not x54) x1 x11))
+(assert (or x30 (not x8) x48))
+(assert (or x59 x98 (not x61)))
+(assert (or x17 x72 x59))
+(assert (or x65 (not x5) x6))
+(assert (or x95 (not x33) (not x2)))
+(assert (or (not x91) (not x16) (not x55)))
+(assert (or x30 x34 x98))
+(assert (or x22 (not x62) (not x11)))
+(assert (or x93 (not x91) x82))
+(assert (or x31 (not x49) (not x97)))
+(assert (or (not x34) x8 (not x22)))
+(assert (or (not x28) (not x40) x12))
+(assert (or (not x9) x14 x28))
+(assert (or x29 (not x38) x39))
+(assert (or (not x17) x99 x93))
+(assert (or (not x74) (not x88) (not x60)))
+(assert (or (not x11) (not x43) x47))
+(assert (or x89 (not x78) (not x96)))
+(assert (or (not x9) (not x84) x70))
+(assert (or (not x11) x68 x78))
+(assert (or (not x92) x83 (not x23)))
+(assert (or (not x77) (not x22) (not x95)))
+(assert (or x73 x71 (not x8)))
+(assert (or (not x47) (not x57) x17))
+(assert (or x57 (not x62) (not x26)))
+(assert (or x42 x54 x46))
+(assert (or x96 (not x64) x10))
+(assert (or x61 (not x88) x3))
+(assert (or x30 (not x43) x92))
+(assert (or x71 x57 x6))
+(assert (or x69 (not x2) (not x17)))
+(assert (or (not x87) x54 x40))
+(assert (or x18 x72 x45))
+(assert (or (not x22) (not x78) x10))
+(assert (or (not x51) (not x86) x70))
+(assert (or (not x95) x25 (not x89)))
+(assert (or x29 x9 x66))
+(assert (or (not x79) (not x91) x96))
+(assert (or (not x59) (not x38) (not x13)))
+(assert (or x48 x44 (not x24)))
+(assert (or x58 x53 (not x21)))
+(assert (or (not x65) x24 (not x18)))
+(assert (or (not x60) x66 (not x38)))
+(assert (or (not x79) x39 (not x91)))
+(assert (or (not x19) x69 (not x58)))
+(assert (or x18 x15 x7))
+(assert (or (not x26) (not x50) (not x61)))
+(assert (or x38 x58 x19))
+(assert (or x7 x31 (not x59)))
+(assert (or (not x23) (not x12) (not x60)))
+(assert (or (not x96) (not x41) (not x54)))
+(assert (or x53 x44 (not x42)))
+(assert (or x35 x64 (not x31)))
+(assert (or x82 x77 x99))
+(assert (or (not x11) x92 (not x23)))
+(assert (or (not x1) x32 (not x97)))
+(assert (or (not x28) (not x71) x3))
+(assert (or x42 x40 x25))
+(assert (or (not x74) (not x51) (not x85)))
+(assert (or x95 (not x29) (not x78)))
+(assert (or x50 (not x74) (not x15)))
+(assert (or x34 (not x77) (not x88)))
+(assert (or x73 (not x5) x61))
+(assert (or x57 x5 (not x13)))
+(assert (or x28 x69 (not x99)))
+(assert (or x22 (not x90) x79))
+(assert (or x26 (not x14) (not x50)))
+(assert (or x52 (not x37) (not x48)))
+(assert (or x98 x60 x42))
+(assert (or (not x99) x58 x84))
+(assert (or (not x54) (not x22) x63))
+(assert (or x86 x29 x77))
+(assert (or (not x100) x40 x17))
+(assert (or (not x39) (not x83) (not x25)))
+(assert (or x45 (not x12) (not x19)))
+(assert (or x52 x9 x11))
+(assert (or (not x7) (not x41) (not x61)))
+(assert (or (not x57) (not x24) (not x82)))
+(assert (or x69 x39 x87))
+(assert (or (not x38) (not x76) (not x54)))
+(assert (or x78 (not x72) x59))
+(assert (or x32 (not x38) (not x5)))
+(assert (or x29 x24 x73))
+(assert (or (not x26) x46 x66))
+(assert (or x60 (not x19) (not x32)))
+(assert (or (not x39) x63 x48))
+(assert (or x81 x51 x76))
+(assert (or (not x96) (not x30) (not x47)))
+(assert (or (not x83) (not x2) (not x20)))
+(assert (or x39 (not x66) (not x2)))
+(assert (or (not x50) (not x3) (not x69)))
+(assert (or (not x85) x86 x7))
+(assert (or (not x60) x72 (not x59)))
+(assert (or x25 (not x42) x93))
+(assert (or (not x48) x19 x56))
+(assert (or (not x83) (not x8) (not x90)))
+(assert (or (not x72) x93 x30))
+(assert (or (not x46) x56 x16))
+(assert (or x2 (not x88) (not x18)))
+(assert (or x42 (not x88) x76))
+(assert (or x29 (not x21) (not x40)))
+(assert (or (not x30) (not x50) (not x38)))
+(assert (or (not x42) x10 x35))
+(assert (or (not x64) x63 (not x76)))
+(assert (or (not x2) (not x16) (not x25)))
+(assert (or x63 (not x48) (not x68)))
+(assert (or (not x9) (not x19) (not x10)))
+(assert (or (not x79) (not x76) x15))
+(assert (or x61 (not x77) (not x56)))
+(assert (or x11 (not x29) x35))
+(assert (or x96 x25 (not x67)))
+(assert (or (not x68) x7 (not x83)))
+(assert (or (not x32) x67 x74))
+(assert (or x81 (not x32) (not x61)))
+(assert (or x95 x51 x10))
+(assert (or x71 x96 x80))
+(assert (or (not x98) x89 x16))
+(assert (or x70 x51 (not x11)))
+(assert (or x55 x80 x9))
+(assert (or (not x94) x61 (not x36)))
+(assert (or x77 x2 (not x82)))
+(assert (or (not x79) (not x65) (not x27)))
+(assert (or x34 (not x33) (not x68)))
+(assert (or (not x13) x11 (not x22)))
+(assert (or x79 (not x73) (not x77)))
+(assert (or (not x8) (not x52) x13))
+(assert (or x4 x25 x29))
+(assert (or (not x8) (not x58) (not x44)))
+(assert (or (not x60) (not x69) x21))
+(assert (or x11 (not x87) (not x82)))
+(assert (or x11 (not x53) (not x17)))
+(assert (or (not x33) x93 x100))
+(assert (or (not x14) x34 (not x74)))
+(assert (or (not x32) (not x86) (not x24)))
+(assert (or (not x11) (not x35) x30))
+(assert (or x28 (not x81) (not x56)))
+(assert (or (not x2) (not x35) (not x74)))
+(assert (or (not x83) x44 x41))
+(assert (or (not x62) x84 x29))
+(assert (or x25 x6 x41))
+(assert (or x100 (not x47) (not x6)))
+(assert (or (not x20) x27 (not x96)))
+(assert (or x78 (not x89) (not x81)))
+(assert (or x96 x83 (not x4)))
+(assert (or x94 (not x4) (not x34)))
+(assert (or (not x89) x83 x79))
+(assert (or x62 (not x84) (not x11)))
+(assert (or x65 x91 x27))
+(assert (or x6 (not x12) x57))
+(assert (or x88 (not x3) x56))
+(assert (or x26 (not x17) (not x60)))
+(assert (or x26 x50 (not x72)))
+(assert (or (not x75) (not x64) (not x67)))
+(assert (or x92 x97 (not x59)))
+(assert (or x84 (not x64) x62))
+(assert (or (not x13) x78 (not x20)))
+(assert (or (not x68) (not x99) (not x95)))
+(assert (or x8 (not x92) (not x12)))
+(assert (or x32 x65 x24))
+(assert (or x4 x9 (not x37)))
+(assert (or x100 (not x3) (not x7)))
+(assert (or (not x1) x31 x22))
+(assert (or x16 x15 x33))
+(assert (or x76 x47 (not x16)))
+(assert (or x85 (not x67) (not x51)))
+(assert (or (not x59) (not x26) (not x7)))
+(assert (or (not x95) (not x50) x8))
+(assert (or (not x28) (not x8) (not x59)))
+(assert (or x57 (not x2) (not x18)))
+(assert (or (not x38) x96 x9))
+(assert (or (not x17) x24 (not x66)))
+(assert (or (not x79) x31 x69))
+(assert (or (not x45) x65 (not x57)))
+(assert (or x10 x37 (not x82)))
+(assert (or x69 x90 (not x59)))
+(assert (or (not x52) (not x8) x74))
+(assert (or (not x31) (not x67) x27))
+(assert (or (not x70) x96 (not x78)))
+(assert (or x55 (not x56) x41))
+(assert (or (not x61) x9 x82))
+(assert (or x100 (not x3) (not x22)))
+(assert (or x1 x22 (not x58)))
+(assert (or (not x29) (not x19) (not x88)))
+(assert (or (not x39) x10 x66))
+(assert (or (not x51) (not x42) x9))
+(assert (or x6 x33 (not x34)))
+(assert (or x37 x52 x79))
+(assert (or (not x52) x59 x12))
+(assert (or x33 (not x27) x16))
+(assert (or x89 x95 (not x82)))
+(assert (or (not x27) (not x65) x20))
+(assert (or x13 (not x38) x63))
+(assert (or (not x37) (not x15) (not x93)))
+(assert (or (not x26) (not x46) x42))
+(assert (or x54 x61 (not x65)))
+(assert (or x28 x15 x8))
+(assert (or x16 x62 x24))
+(assert (or (not x71) x57 (not x32)))
+(assert (or x44 x41 x3))
+(assert (or (not x30) (not x67) x63))
+(assert (or x25 (not x80) x4))
+(assert (or (not x25) (not x64) (not x55)))
+(assert (or (not x77) (not x70) x9))
+(assert (or (not x100) (not x70) (not x39)))
+(assert (or x94 x57 (not x9)))
+(assert (or (not x4) (not x14) x75))
+(assert (or x81 x32 (not x99)))
+(assert (or (not x5) x75 (not x96)))
+(assert (or (not x75) x2 (not x94)))
+(assert (or x13 x45 (not x22)))
+(assert (or (not x54) x15 (not x46)))
+(assert (or x90 x43 (not x56)))
+(assert (or x23 (not x94) x88))
+(assert (or (not x100) (not x72) x93))
+(assert (or (not x99) (not x41) (not x11)))
+(assert (or (not x88) x80 (not x3)))
+(assert (or (not x69) (not x93) (not x56)))
+(assert (or x88 x97 x36))
+(assert (or x26 x89 x67))
+(assert (or (not x98) (not x13) (not x26)))
+(assert (or x52 x90 x15))
+(assert (or x2 x82 (not x91)))
+(assert (or x83 (not x10) x68))
+(assert (or (not x95) (not x43) x89))
+(assert (or (not x39) x17 (not x45)))
+(assert (or (not x97) x55 x52))
+(assert (or x83 (not x28) x59))
+(assert (or x38 x28 (not x95)))
+(assert (or (not x83) (not x71) x98))
+(assert (or (not x6) x92 x18))
+(assert (or x10 (not x33) x43))
+(assert (or (not x78) (not x60) x31))
+(assert (or x84 x5 x94))
+(assert (or (not x13) x71 x37))
+(assert (or (not x30) (not x21) (not x3)))
+(assert (or (not x62) (not x17) x98))
+(assert (or (not x5) (not x78) x94))
+(assert (or (not x81) (not x9) x50))
+(assert (or x95 x87 x55))
+(assert (or (not x37) x36 (not x53)))
+(assert (or (not x30) x56 (not x97)))
+(assert (or (not x4) x84 x54))
+(assert (or (not x72) (not x15) (not x32)))
+(assert (or x39 x15 x43))
+(assert (or x47 (not x53) (not x66)))
+(assert (or (not x97) x100 x31))
+(assert (or x37 x89 (not x93)))
+(assert (or x83 x19 x86))
+(assert (or (not x42) (not x93) x84))
+(assert (or (not x52) x44 x24))
+(assert (or (not x68) (not x12) x44))
+(assert (or x14 (not x63) x99))
+(assert (or x40 x31 x47))
+(assert (or (not x63) x43 x62))
+(assert (or x15 (not x94) (not x18)))
+(assert (or x87 (not x3) (not x46)))
+(assert (or x94 (not x7) (not x88)))
+(assert (or x15 x38 (not x11)))
+(assert (or (not x75) x35 (not x38)))
+(assert (or (not x93) (not x12) (not x48)))
+(assert (or (not x74) (not x5) x42))
+(assert (or (not x91) (not x89) x53))
+(assert (or (not x79) x57 (not x64)))
+(assert (or x37 x70 (not x39)))
+(assert (or (not x5) (not x17) (not x23)))
+(assert (or (not x63) x26 x24))
+(assert (or (not x62) x17 x29))
+(assert (or (not x83) (not x74) x53))
+(assert (or x78 (not x6) x65))
+(assert (or (not x73) (not x95) x20))
+(assert (or x33 (not x9) x16))
+(assert (or (not x67) (not x30) x29))
+(assert (or x79 x61 x52))
+(assert (or x24 (not x61) x2))
+(assert (or x38 x46 x39))
+(check-sat)
+(push 1)
+(assert (or (not x96) (not x14) (not x69)))
+(assert (or (not x27) (not x94) x57))
+(assert (or (not x12) x90 (not x67)))
+(assert (or (not x35) x9 (not x81)))
+(assert (or x24 (not x94) x58))
+(assert (or (not x26) x47 (not x70)))
+(assert (or (not x59) (not x43) x46))
+(assert (or x12 (not x77) x41))
+(assert (or (not x24) (not x59) x75))
+(assert (or x34 x99 (not x31)))
+(assert (or x43 x8 x22))
+(assert (or (not x51) (not x11) x39))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (or x9 x70 x38))
+(assert (or x60 x47 (not x49)))
+(assert (or x47 (not x17) (not x24)))
+(assert (or x61 x91 (not x36)))
+(assert (or (not x69) x83 x49))
+(assert (or x48 (not x90) (not x9)))
+(assert (or x57 x50 x19))
+(assert (or (not x57) x36 x95))
+(assert (or (not x57) (not x15) (not x90)))
+(assert (or x75 (not x50) (not x56)))
+(assert (or (not x57) (not x55) x93))
+(assert (or x65 (not x86) x39))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (or x81 (not x70) (not x8)))
+(assert (or (not x67) (not x15) x100))
+(assert (or (not x28) (not x3) (not x88)))
+(assert (or (not x79) (not x43) (not x67)))
+(assert (or (not x100) x96 (not x91)))
+(assert (or (not x17) (not x24) (not x10)))
+(assert (or (not x82) x92 (not x57)))
+(assert (or (not x2) x35 x14))
+(assert (or x48 x39 (not x12)))
+(assert (or x72 x73 x54))
+(assert (or (not x83) (not x97) (not x51)))
+(assert (or (not x19) x7 (not x3)))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (or x100 x43 x49))
+(assert (or x3 x62 (not x80)))
+(assert (or (not x84) (not x14) x59))
+(assert (or (not x80) x67 (not x64)))
+(assert (or (not x72) (not x30) (not x60)))
+(assert (or (not x24) (not x7) (not x59)))
+(assert (or x92 x82 x24))
+(assert (or (not x84) (not x13) x88))
+(assert (or x31 x12 (not x60)))
+(assert (or (not x93) x28 (not x13)))
+(assert (or (not x68) (not x13) (not x87)))
+(assert (or (not x52) (not x69) x29))
+(check-sat)
+(pop 1)
+(assert (or x30 (not x29) x24))
+(assert (or (not x30) (not x64) (not x33)))
+(assert (or x55 x67 x62))
+(assert (or x3 (not x87) x17))
+(assert (or x27 x95 x10))
+(assert (or x47 (not x9) (not x24)))
+(assert (or (not x19) x13 (not x94)))
+(assert (or (not x13) (not x7) x33))
+(assert (or x69 x59 (not x39)))
+(assert (or (not x1) x3 x77))
+(assert (or x42 x22 (not x82)))
+(assert (or x62 (not x68) x48))
+(assert (or x11 (not x19) (not x18)))
+(assert (or (not x2) x62 x39))
+(assert (or x7 (not x74) (not x100)))
+(assert (or (not x20) (not x10) x76))
+(assert (or (not x25) (not x35) x39))
+(assert (or x99 x80 x16))
+(assert (or x94 x57 x71))
+(assert (or x83 x18 x45))
+(check-sat)
@@ -0,0 +1,24 @@
+104
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(assert (> x 2))
+(assert (< x 4))
+(check-sat)
+(get-value (x))
+80
+(set-logic QF_LIA)
+(declare-fun x () Bool)
+(assert (and x (not x)))
+(check-sat)
+41
+(set-logic QF_UF)
+(assert y)
+(check-sat)
+0
+84
+(set-logic QF_UF)
+(declare-fun y () Bool)
+(assert y)
+(check-sat)
+(exit)
+(check-sat)
@@ -0,0 +1,163 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * TEST BULK TERM CONSTRUCTION AND VALUE EXTRACTION
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+#include "yices.h"
+
+static void check(bool cond, const char *msg) {
+  if (!cond) {
+    fprintf(stderr, "FAILED: %s\n", msg);
+    fflush(stderr);
+    exit(1);
+  }
+}
+
+/*
+ * Build (and (> x 0) (< x 10) (= (bvadd b 0x0001) c)) with yices_build_terms
+ * and compare with the terms built directly.
+ */
+static void test_build(term_t x, term_t b, term_t c) {
+  int32_t buffer[] = {
+    YICES_OP_INT_CONST, 1, 0,          // node 0: 0
+    YICES_OP_ARITH_GT, 2, x, -1,       // node 1: (> x 0)
+    YICES_OP_INT_CONST, 1, 10,         // node 2: 10
+    YICES_OP_ARITH_LT, 2, x, -3,       // node 3: (< x 10)
+    YICES_OP_BV_CONST, 3, 16, 1, 0,    // node 4: 0x0001
+    YICES_OP_BV_ADD, 2, b, -5,         // node 5: (bvadd b 0x0001)
+    YICES_OP_EQ, 2, -6, c,             // node 6: (= ... c)
+    YICES_OP_BV_EXTRACT, 3, -6, 0, 7,  // node 7: low byte of node 5
+    YICES_OP_AND, 3, -2, -4, -7,       // node 8: conjunction
+  };
+  term_t t[9];
+  term_t expected, args[3];
+  int32_t n;
+
+  n = yices_build_terms(sizeof(buffer)/sizeof(int32_t), buffer, 9, t);
+  check(n == 9, "yices_build_terms: number of nodes");
+
+  args[0] = yices_arith_gt_atom(x, yices_zero());
+  args[1] = yices_arith_lt_atom(x, yices_int32(10));
+  args[2] = yices_eq(yices_bvadd(b, yices_bvconst_uint64(16, 1)), c);
+  expected = yices_and(3, args);
+  check(t[8] == expected, "yices_build_terms: wrong term");
+  check(t[7] == yices_bvextract(t[5], 0, 7), "yices_build_terms: wrong extract");
+
+  // too many nodes
+  n = yices_build_terms(sizeof(buffer)/sizeof(int32_t), buffer, 8, t);
+  check(n < 0 && yices_error_code() == INVALID_TERM_OP, "yices_build_terms: too many nodes");
+
+  // forward reference
+  buffer[5] = -3;
+  n = yices_build_terms(7, buffer, 9, t);
+  check(n < 0 && yices_error_code() == INVALID_TERM, "yices_build_terms: forward reference");
+  buffer[5] = x;
+
+  // wrong number of operands
+  buffer[1] = 2;
+  n = yices_build_terms(4, buffer, 9, t);
+  check(n < 0 && yices_error_code() == WRONG_NUMBER_OF_ARGUMENTS, "yices_build_terms: arity");
+  buffer[1] = 1;
+
+  // truncated node
+  n = yices_build_terms(6, buffer, 9, t);
+  check(n < 0 && yices_error_code() == INVALID_TERM_OP, "yices_build_terms: truncated node");
+
+  // type error from the constructor
+  buffer[5] = b;
+  n = yices_build_terms(7, buffer, 9, t);
+  check(n < 0 && yices_error_code() == ARITHTERM_REQUIRED, "yices_build_terms: type error");
+  buffer[5] = x;
+
+  yices_clear_error();
+}
+
+/*
+ * Values in a model built from a map
+ */
+static void test_values(term_t x, term_t b, term_t c, term_t p) {
+  term_t vars[4], map[4], a[4];
+  int32_t bval[2];
+  int64_t ival[2];
+  double dval[2];
+  uint64_t bvval[2];
+  model_t *mdl;
+  int32_t code;
+
+  vars[0] = x; map[0] = yices_int32(7);
+  vars[1] = b; map[1] = yices_bvconst_uint64(16, 0xfffe);
+  vars[2] = c; map[2] = yices_bvconst_uint64(16, 0xffff);
+  vars[3] = p; map[3] = yices_true();
+  mdl = yices_model_from_map(4, vars, map);
+  check(mdl != NULL, "model construction");
+
+  a[0] = p;
+  a[1] = yices_eq(yices_bvadd(b, yices_bvconst_uint64(16, 1)), c);
+  code = yices_get_bool_value_array(mdl, 2, a, bval);
+  check(code == 0 && bval[0] == 1 && bval[1] == 1, "yices_get_bool_value_array");
+
+  a[0] = x;
+  a[1] = yices_mul(x, yices_int32(-3));
+  code = yices_get_int64_value_array(mdl, 2, a, ival);
+  check(code == 0 && ival[0] == 7 && ival[1] == -21, "yices_get_int64_value_array");
+
+  a[1] = yices_division(x, yices_int32(2));
+  code = yices_get_double_value_array(mdl, 2, a, dval);
+  check(code == 0 && dval[0] == 7.0 && dval[1] == 3.5, "yices_get_double_value_array");
+
+  code = yices_get_int64_value_array(mdl, 2, a, ival);
+  check(code < 0 && yices_error_code() == EVAL_OVERFLOW, "yices_get_int64_value_array: not an integer");
+
+  a[0] = b;
+  a[1] = c;
+  code = yices_get_bv64_value_array(mdl, 2, a, bvval);
+  check(code == 0 && bvval[0] == 0xfffe && bvval[1] == 0xffff, "yices_get_bv64_value_array");
+
+  a[0] = p;
+  code = yices_get_bv64_value_array(mdl, 2, a, bvval);
+  check(code < 0 && yices_error_code() == BITVECTOR_REQUIRED, "yices_get_bv64_value_array: type error");
+
+  yices_free_model(mdl);
+  yices_clear_error();
+}
+
+int main(void) {
+  term_t x, b, c, p;
+
+  yices_init();
+
+  x = yices_new_uninterpreted_term(yices_int_type());
+  b = yices_new_uninterpreted_term(yices_bv_type(16));
+  c = yices_new_uninterpreted_term(yices_bv_type(16));
+  p = yices_new_uninterpreted_term(yices_bool_type());
+
+  test_build(x, b, c);
+  test_values(x, b, c, p);
+
+  printf("All tests passed\n");
+  yices_exit();
+
+  return 0;
+}
@@ -0,0 +1,177 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * TEST PROJECTED MODEL ENUMERATION
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+#include "yices.h"
+
+static void check(bool cond, const char *msg) {
+  if (!cond) {
+    fprintf(stderr, "FAILED: %s\n", msg);
+    fflush(stderr);
+    exit(1);
+  }
+}
+
+/*
+ * Check that the models in v are pairwise distinct
+ * - v contains k models of n values each
+ */
+static void check_distinct(term_vector_t *v, uint32_t n, const char *msg) {
+  uint32_t i, j, k, l;
+  bool same;
+
+  k = v->size / n;
+  for (i=0; i<k; i++) {
+    for (j=i+1; j<k; j++) {
+      same = true;
+      for (l=0; l<n; l++) {
+        same &= (v->data[i * n + l] == v->data[j * n + l]);
+      }
+      check(!same, msg);
+    }
+  }
+}
+
+/*
+ * (or p q r) projected on p and q: three models
+ */
+static void test_bool(void) {
+  context_t *ctx;
+  term_vector_t v;
+  term_t p, q, r, a[3];
+  smt_status_t stat;
+
+  p = yices_new_uninterpreted_term(yices_bool_type());
+  q = yices_new_uninterpreted_term(yices_bool_type());
+  r = yices_new_uninterpreted_term(yices_bool_type());
+  a[0] = p; a[1] = q; a[2] = r;
+
+  ctx = yices_new_context(NULL);
+  yices_assert_formula(ctx, yices_or(3, a));
+  yices_init_term_vector(&v);
+
+  // projected on p and q: all four combinations are possible
+  yices_push(ctx);
+  stat = yices_enumerate_models(ctx, NULL, 2, a, 0, &v);
+  check(stat == STATUS_UNSAT && v.size == 8, "bool enumeration: four models");
+  check_distinct(&v, 2, "bool enumeration: duplicate model");
+  yices_pop(ctx);
+
+  // with (not r): three models
+  yices_assert_formula(ctx, yices_not(r));
+  stat = yices_enumerate_models(ctx, NULL, 2, a, 0, &v);
+  check(stat == STATUS_UNSAT && v.size == 6, "bool enumeration: three models");
+  check_distinct(&v, 2, "bool enumeration: duplicate model");
+
+  yices_delete_term_vector(&v);
+  yices_free_context(ctx);
+}
+
+/*
+ * 0 <= x < 5 and 0 <= y < 3 projected on x: five models
+ * then bitvector b with b < 6 (unsigned), enumerated two at a time
+ */
+static void test_theories(void) {
+  context_t *ctx;
+  term_vector_t v;
+  term_t x, y, b;
+  smt_status_t stat;
+  uint32_t total;
+  int32_t i, val;
+  uint64_t seen;
+
+  x = yices_new_uninterpreted_term(yices_int_type());
+  y = yices_new_uninterpreted_term(yices_int_type());
+  b = yices_new_uninterpreted_term(yices_bv_type(8));
+
+  ctx = yices_new_context(NULL);
+  yices_assert_formula(ctx, yices_arith_geq0_atom(x));
+  yices_assert_formula(ctx, yices_arith_lt_atom(x, yices_int32(5)));
+  yices_assert_formula(ctx, yices_arith_geq0_atom(y));
+  yices_assert_formula(ctx, yices_arith_lt_atom(y, yices_int32(3)));
+  yices_assert_formula(ctx, yices_bvlt_atom(b, yices_bvconst_uint32(8, 6)));
+  yices_init_term_vector(&v);
+
+  yices_push(ctx);
+  stat = yices_enumerate_models(ctx, NULL, 1, &x, 0, &v);
+  check(stat == STATUS_UNSAT && v.size == 5, "arith enumeration: five models");
+  seen = 0;
+  for (i=0; i<5; i++) {
+    for (val=0; val<5; val++) {
+      if (v.data[i] == yices_int32(val)) break;
+    }
+    check(val < 5 && (seen & (1 << val)) == 0, "arith enumeration: wrong value");
+    seen |= 1 << val;
+  }
+  yices_pop(ctx);
+
+  // two models at a time: the enumeration continues where it stopped
+  total = 0;
+  for (;;) {
+    stat = yices_enumerate_models(ctx, NULL, 1, &b, 2, &v);
+    total += v.size;
+    if (stat != STATUS_SAT) break;
+    check(v.size == 2, "bv enumeration: two models");
+  }
+  check(stat == STATUS_UNSAT && total == 6, "bv enumeration: six models");
+
+  yices_delete_term_vector(&v);
+  yices_free_context(ctx);
+}
+
+/*
+ * Errors
+ */
+static void test_errors(void) {
+  context_t *ctx;
+  term_vector_t v;
+  term_t u;
+  smt_status_t stat;
+
+  u = yices_new_uninterpreted_term(yices_new_uninterpreted_type());
+  ctx = yices_new_context(NULL);
+  yices_init_term_vector(&v);
+
+  stat = yices_enumerate_models(ctx, NULL, 1, &u, 0, &v);
+  check(stat == STATUS_ERROR && yices_error_code() == TYPE_MISMATCH, "enumeration: bad type");
+
+  yices_clear_error();
+  yices_delete_term_vector(&v);
+  yices_free_context(ctx);
+}
+
+int main(void) {
+  yices_init();
+
+  test_bool();
+  test_theories();
+  test_errors();
+
+  printf("All tests passed\n");
+  yices_exit();
+
+  return 0;
+}
@@ -0,0 +1,151 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * TEST THE STATISTICS API
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "yices.h"
+
+static void check(bool cond, const char *msg) {
+  if (!cond) {
+    fprintf(stderr, "FAILED: %s\n", msg);
+    fflush(stderr);
+    exit(1);
+  }
+}
+
+/*
+ * Check that the JSON string contains "name": value
+ */
+static void check_json(const char *json, const char *name, uint64_t value) {
+  char buffer[100];
+
+  snprintf(buffer, sizeof(buffer), "\"%s\": %"PRIu64, name, value);
+  check(strstr(json, buffer) != NULL, buffer);
+}
+
+/*
+ * Pigeon-hole problem with 4 pigeons and 3 holes: needs some search
+ */
+static void test_core(void) {
+  ctx_config_t *config;
+  context_t *ctx;
+  term_t p[4][3], a[3];
+  uint64_t conflicts, decisions, v;
+  uint32_t i, j, k;
+  char *json;
+
+  config = yices_new_config();
+  yices_default_config_for_logic(config, "QF_UF");
+  ctx = yices_new_context(config);
+  yices_free_config(config);
+  for (i=0; i<4; i++) {
+    for (j=0; j<3; j++) {
+      p[i][j] = yices_new_uninterpreted_term(yices_bool_type());
+    }
+    yices_assert_formula(ctx, yices_or(3, p[i]));
+  }
+  for (j=0; j<3; j++) {
+    for (i=0; i<4; i++) {
+      for (k=i+1; k<4; k++) {
+        a[0] = yices_not(p[i][j]);
+        a[1] = yices_not(p[k][j]);
+        yices_assert_formula(ctx, yices_or(2, a));
+      }
+    }
+  }
+  check(yices_check_context(ctx, NULL) == STATUS_UNSAT, "pigeon-hole");
+
+  check(yices_get_statistic(ctx, "core.conflicts", &conflicts) == 0, "core.conflicts");
+  check(yices_get_statistic(ctx, "core.decisions", &decisions) == 0, "core.decisions");
+  check(conflicts > 0 && decisions > 0, "search statistics");
+  check(yices_get_statistic(ctx, "core.boolean-variables", &v) == 0 && v >= 12, "core.boolean-variables");
+
+  check(yices_get_statistic(ctx, "core.no-such-counter", &v) < 0 &&
+        yices_error_code() == CTX_UNKNOWN_PARAMETER, "unknown statistic");
+  yices_clear_error();
+
+  // no simplex solver in this context
+  check(yices_get_statistic(ctx, "simplex.pivots", &v) < 0, "simplex.pivots in QF_UF");
+  yices_clear_error();
+
+  json = yices_statistics_to_string(ctx);
+  check(json != NULL && json[0] == '{' && json[strlen(json) - 1] == '}', "json");
+  check_json(json, "core.conflicts", conflicts);
+  check_json(json, "core.decisions", decisions);
+  yices_free_string(json);
+
+  // statistics are reset with the context
+  yices_reset_context(ctx);
+  check(yices_get_statistic(ctx, "core.conflicts", &v) == 0 && v == 0, "reset");
+
+  yices_free_context(ctx);
+}
+
+/*
+ * Theory solvers
+ */
+static void test_theories(void) {
+  ctx_config_t *config;
+  context_t *ctx;
+  term_t x, y, b;
+  uint64_t v;
+
+  config = yices_new_config();
+  yices_default_config_for_logic(config, "QF_LRA");
+  ctx = yices_new_context(config);
+  yices_free_config(config);
+  x = yices_new_uninterpreted_term(yices_real_type());
+  y = yices_new_uninterpreted_term(yices_real_type());
+  yices_assert_formula(ctx, yices_arith_lt_atom(x, y));
+  yices_assert_formula(ctx, yices_arith_lt_atom(y, yices_add(x, yices_int32(1))));
+  check(yices_check_context(ctx, NULL) == STATUS_SAT, "lra");
+  check(yices_get_statistic(ctx, "simplex.pivots", &v) == 0, "simplex.pivots");
+  check(yices_get_statistic(ctx, "bv.atoms", &v) < 0, "bv.atoms in QF_LRA");
+  yices_clear_error();
+  yices_free_context(ctx);
+
+  config = yices_new_config();
+  yices_default_config_for_logic(config, "QF_BV");
+  ctx = yices_new_context(config);
+  yices_free_config(config);
+  b = yices_new_uninterpreted_term(yices_bv_type(8));
+  yices_assert_formula(ctx, yices_bvgt_atom(b, yices_bvconst_uint32(8, 10)));
+  check(yices_check_context(ctx, NULL) == STATUS_SAT, "bv");
+  check(yices_get_statistic(ctx, "bv.vars", &v) == 0, "bv.vars");
+  yices_free_context(ctx);
+}
+
+int main(void) {
+  yices_init();
+
+  test_core();
+  test_theories();
+
+  printf("All tests passed\n");
+  yices_exit();
+
+  return 0;
+}
@@ -0,0 +1,202 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * TEST THE EVENT TRACE
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "yices.h"
+#include "utils/event_trace.h"
+
+static void check(bool cond, const char *msg) {
+  if (!cond) {
+    fprintf(stderr, "FAILED: %s\n", msg);
+    fflush(stderr);
+    exit(1);
+  }
+}
+
+
+/*
+ * Dump the trace of ctx, then read it back
+ * - the events are stored in *events (must be freed by the caller)
+ * - return the number of events
+ */
+static uint32_t read_trace(context_t *ctx, etrace_header_t *header, etrace_event_t **events) {
+  FILE *f;
+  uint32_t n;
+
+  f = tmpfile();
+  check(f != NULL, "tmpfile");
+  check(yices_dump_event_trace(ctx, f) == 0, "dump");
+  rewind(f);
+
+  check(fread(header, sizeof(etrace_header_t), 1, f) == 1, "read header");
+  check(memcmp(header->magic, ETRACE_MAGIC, 4) == 0, "magic");
+  check(header->version == ETRACE_VERSION, "version");
+  check(header->event_size == sizeof(etrace_event_t), "event size");
+  check(header->nevents <= header->capacity && header->nevents <= header->total, "event count");
+
+  n = header->nevents;
+  *events = (etrace_event_t *) malloc((n + 1) * sizeof(etrace_event_t));
+  check(*events != NULL, "malloc");
+  check(fread(*events, sizeof(etrace_event_t), n, f) == n, "read events");
+  check(fgetc(f) == EOF, "end of file");
+  fclose(f);
+
+  return n;
+}
+
+static uint32_t count_kind(etrace_event_t *e, uint32_t n, etrace_kind_t kind) {
+  uint32_t i, c;
+
+  c = 0;
+  for (i=0; i<n; i++) {
+    if (e[i].kind == kind) c ++;
+  }
+  return c;
+}
+
+
+/*
+ * Pigeon-hole problem with 5 pigeons and 4 holes
+ */
+static void test_core(void) {
+  ctx_config_t *config;
+  context_t *ctx;
+  etrace_header_t header;
+  etrace_event_t *e;
+  term_t p[5][4], a[4];
+  uint64_t conflicts;
+  uint32_t i, j, k, n;
+
+  config = yices_new_config();
+  yices_default_config_for_logic(config, "QF_UF");
+  ctx = yices_new_context(config);
+  yices_free_config(config);
+  for (i=0; i<5; i++) {
+    for (j=0; j<4; j++) {
+      p[i][j] = yices_new_uninterpreted_term(yices_bool_type());
+    }
+    yices_assert_formula(ctx, yices_or(4, p[i]));
+  }
+  for (j=0; j<4; j++) {
+    for (i=0; i<5; i++) {
+      for (k=i+1; k<5; k++) {
+        a[0] = yices_not(p[i][j]);
+        a[1] = yices_not(p[k][j]);
+        yices_assert_formula(ctx, yices_or(2, a));
+      }
+    }
+  }
+
+  // nothing logged yet
+  n = read_trace(ctx, &header, &e);
+  check(n == 0 && header.total == 0, "empty trace");
+  free(e);
+
+  check(yices_check_context(ctx, NULL) == STATUS_UNSAT, "pigeon-hole");
+  check(yices_get_statistic(ctx, "core.conflicts", &conflicts) == 0, "core.conflicts");
+
+  n = read_trace(ctx, &header, &e);
+  check(n > 0 && e[0].kind == ETRACE_START_SEARCH, "first event");
+  check(e[n-1].kind == ETRACE_END_SEARCH && e[n-1].arg8 == STATUS_UNSAT, "last event");
+  if (header.total == n) {
+    check(count_kind(e, n, ETRACE_CONFLICT) > 0, "conflict events");
+  }
+  for (i=0; i<n; i++) {
+    check(e[i].kind < NUM_ETRACE_KINDS, "event kind");
+    if (i > 0) {
+      check(e[i].stamp >= e[i-1].stamp || e[i].kind == ETRACE_START_SEARCH, "stamps");
+    }
+    if (e[i].kind == ETRACE_CONFLICT) {
+      check(e[i].arg16 >= 1 && e[i].arg16 <= e[i].arg32, "lbd <= size");
+    }
+  }
+  check(e[n-1].stamp == conflicts, "final stamp");
+  free(e);
+
+  // the trace is cleared by reset
+  yices_reset_context(ctx);
+  n = read_trace(ctx, &header, &e);
+  check(n == 0 && header.total == 0, "reset");
+  free(e);
+
+  yices_free_context(ctx);
+}
+
+
+/*
+ * Theory conflicts: x < y, y < z, z < x in QF_LRA
+ */
+static void test_theory(void) {
+  ctx_config_t *config;
+  context_t *ctx;
+  etrace_header_t header;
+  etrace_event_t *e;
+  term_t x, y, z, b;
+  uint32_t i, n;
+  bool found;
+
+  config = yices_new_config();
+  yices_default_config_for_logic(config, "QF_LRA");
+  ctx = yices_new_context(config);
+  yices_free_config(config);
+  x = yices_new_uninterpreted_term(yices_real_type());
+  y = yices_new_uninterpreted_term(yices_real_type());
+  z = yices_new_uninterpreted_term(yices_real_type());
+  b = yices_new_uninterpreted_term(yices_bool_type());
+  yices_assert_formula(ctx, yices_arith_lt_atom(x, y));
+  yices_assert_formula(ctx, yices_implies(b, yices_arith_lt_atom(y, z)));
+  yices_assert_formula(ctx, yices_implies(b, yices_arith_lt_atom(z, x)));
+  check(yices_check_context(ctx, NULL) == STATUS_SAT, "lra sat");
+  check(yices_assert_formula(ctx, b) == 0, "assert b");
+  check(yices_check_context(ctx, NULL) == STATUS_UNSAT, "lra unsat");
+
+  n = read_trace(ctx, &header, &e);
+  check(count_kind(e, n, ETRACE_START_SEARCH) >= 1, "start-search");
+  found = false;
+  for (i=0; i<n; i++) {
+    if (e[i].kind == ETRACE_TH_CONFLICT) {
+      check(e[i].arg8 == ETRACE_SIMPLEX, "theory conflict from simplex");
+      found = true;
+    }
+  }
+  check(found, "theory conflict");
+  free(e);
+
+  yices_free_context(ctx);
+}
+
+int main(void) {
+  yices_init();
+
+  test_core();
+  test_theory();
+
+  printf("All tests passed\n");
+  yices_exit();
+
+  return 0;
+}
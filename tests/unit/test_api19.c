@@ -0,0 +1,155 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * TEST THE MEMORY STATISTICS AND THE MEMORY LIMIT
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "yices.h"
+
+static void check(bool cond, const char *msg) {
+  if (!cond) {
+    fprintf(stderr, "FAILED: %s\n", msg);
+    fflush(stderr);
+    exit(1);
+  }
+}
+
+static uint64_t get_stat(context_t *ctx, const char *name) {
+  uint64_t v;
+
+  check(yices_get_statistic(ctx, name, &v) == 0, name);
+  return v;
+}
+
+
+/*
+ * Random 3-SAT problem with n variables and 4.26 * n clauses
+ * - this is hard enough for the solver to restart a few times
+ */
+static void random_3sat(context_t *ctx, uint32_t n) {
+  term_t *x, c[3];
+  uint32_t i, j, m, seed;
+
+  x = (term_t *) malloc(n * sizeof(term_t));
+  check(x != NULL, "malloc");
+  for (i=0; i<n; i++) {
+    x[i] = yices_new_uninterpreted_term(yices_bool_type());
+  }
+
+  seed = 12345;
+  m = (uint32_t) (4.26 * n);
+  for (i=0; i<m; i++) {
+    for (j=0; j<3; j++) {
+      seed = seed * 1664525 + 1013904223;
+      c[j] = x[(seed >> 8) % n];
+      if (seed & 0x10) c[j] = yices_not(c[j]);
+    }
+    check(yices_assert_formula(ctx, yices_or(3, c)) == 0, "assert clause");
+  }
+
+  free(x);
+}
+
+
+/*
+ * Memory statistics in a QF_LRA context
+ */
+static void test_mem_stats(void) {
+  ctx_config_t *config;
+  context_t *ctx;
+  term_t x, y;
+  uint64_t core, total;
+
+  config = yices_new_config();
+  yices_default_config_for_logic(config, "QF_UFLRA");
+  ctx = yices_new_context(config);
+  yices_free_config(config);
+  x = yices_new_uninterpreted_term(yices_real_type());
+  y = yices_new_uninterpreted_term(yices_real_type());
+  yices_assert_formula(ctx, yices_arith_lt_atom(x, y));
+  yices_assert_formula(ctx, yices_or2(yices_arith_lt_atom(y, x), yices_arith_eq0_atom(x)));
+  check(yices_check_context(ctx, NULL) == STATUS_SAT, "sat");
+
+  core = get_stat(ctx, "mem.core");
+  total = get_stat(ctx, "mem.context");
+  check(core > 0, "mem.core");
+  check(get_stat(ctx, "mem.egraph") > 0, "mem.egraph");
+  check(get_stat(ctx, "mem.simplex") > 0, "mem.simplex");
+  check(get_stat(ctx, "mem.bv") == 0, "mem.bv");
+  check(get_stat(ctx, "mem.terms") > 0, "mem.terms");
+  check(total == core + get_stat(ctx, "mem.egraph") + get_stat(ctx, "mem.simplex") +
+        get_stat(ctx, "mem.bv") + get_stat(ctx, "mem.bitblaster") + get_stat(ctx, "mem.cache"), "mem.context");
+  check(get_stat(ctx, "mem.limit-reached") == 0, "no limit");
+
+  yices_free_context(ctx);
+}
+
+
+/*
+ * Memory limit: the search stops with STATUS_UNKNOWN
+ */
+static void test_mem_limit(void) {
+  ctx_config_t *config;
+  context_t *ctx;
+  param_t *params;
+  smt_status_t stat;
+
+  config = yices_new_config();
+  yices_default_config_for_logic(config, "QF_UF");
+  ctx = yices_new_context(config);
+  yices_free_config(config);
+  random_3sat(ctx, 20000);
+  check(get_stat(ctx, "mem.core") > (1 << 20), "problem size");
+
+  params = yices_new_param_record();
+  yices_default_params_for_context(ctx, params);
+  check(yices_set_param(params, "memory-limit", "-1") < 0, "bad limit");
+  check(yices_set_param(params, "memory-limit", "1") == 0, "set limit");
+
+  stat = yices_check_context(ctx, params);
+  check(stat == STATUS_UNKNOWN, "unknown");
+  check(get_stat(ctx, "mem.limit-reached") == 1, "limit reached");
+  check(get_stat(ctx, "core.learned-clauses") == 0, "learned clauses deleted");
+
+  yices_free_param_record(params);
+
+  // the flag is cleared by reset
+  yices_reset_context(ctx);
+  check(get_stat(ctx, "mem.limit-reached") == 0, "reset");
+
+  yices_free_context(ctx);
+}
+
+int main(void) {
+  yices_init();
+
+  test_mem_stats();
+  test_mem_limit();
+
+  printf("All tests passed\n");
+  yices_exit();
+
+  return 0;
+}
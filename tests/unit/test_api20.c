@@ -0,0 +1,240 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * TEST CUBE AND CONQUER
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <signal.h>
+
+#include "yices.h"
+
+static void check(bool cond, const char *msg) {
+  if (!cond) {
+    fprintf(stderr, "FAILED: %s\n", msg);
+    fflush(stderr);
+    exit(1);
+  }
+}
+
+
+/*
+ * Pigeon-hole problem: n+1 pigeons, n holes
+ */
+static void assert_pigeon_hole(context_t *ctx, uint32_t n) {
+  term_t p[8][7], a[7], b[2];
+  uint32_t i, j, k;
+
+  for (i=0; i<=n; i++) {
+    for (j=0; j<n; j++) {
+      p[i][j] = yices_new_uninterpreted_term(yices_bool_type());
+      a[j] = p[i][j];
+    }
+    yices_assert_formula(ctx, yices_or(n, a));
+  }
+  for (j=0; j<n; j++) {
+    for (i=0; i<=n; i++) {
+      for (k=i+1; k<=n; k++) {
+        b[0] = yices_not(p[i][j]);
+        b[1] = yices_not(p[k][j]);
+        yices_assert_formula(ctx, yices_or(2, b));
+      }
+    }
+  }
+}
+
+static void test_pigeon_hole(uint32_t nworkers) {
+  context_t *ctx;
+  model_t *mdl;
+  smt_status_t stat;
+
+  ctx = yices_new_context(NULL);
+  assert_pigeon_hole(ctx, 6);
+
+  mdl = NULL;
+  // small budget: hard cubes are split again
+  stat = yices_check_context_with_cubes(ctx, NULL, 3, nworkers, 100, &mdl);
+  check(stat == STATUS_UNSAT && mdl == NULL, "pigeon-hole: unsat");
+  check(yices_context_status(ctx) == STATUS_IDLE, "pigeon-hole: idle");
+  check(yices_check_context(ctx, NULL) == STATUS_UNSAT, "pigeon-hole: check");
+
+  yices_free_context(ctx);
+}
+
+
+/*
+ * Value of a 16-bit term t in mdl
+ */
+static uint32_t bv16_value(model_t *mdl, term_t t) {
+  int32_t bits[16];
+  uint32_t i, v;
+
+  check(yices_get_bv_value(mdl, t, bits) == 0, "bv value");
+  v = 0;
+  for (i=0; i<16; i++) {
+    v |= ((uint32_t) bits[i]) << i;
+  }
+  return v;
+}
+
+/*
+ * Factoring in QF_BV: x * y = 143, 1 < x <= y < 256
+ */
+static void test_bv_factor(uint32_t nworkers) {
+  context_t *ctx;
+  model_t *mdl;
+  term_t x, y;
+  smt_status_t stat;
+
+  ctx = yices_new_context(NULL);
+  x = yices_new_uninterpreted_term(yices_bv_type(16));
+  y = yices_new_uninterpreted_term(yices_bv_type(16));
+  yices_assert_formula(ctx, yices_bveq_atom(yices_bvmul(x, y), yices_bvconst_uint32(16, 143)));
+  yices_assert_formula(ctx, yices_bvgt_atom(x, yices_bvconst_uint32(16, 1)));
+  yices_assert_formula(ctx, yices_bvle_atom(x, y));
+  yices_assert_formula(ctx, yices_bvlt_atom(y, yices_bvconst_uint32(16, 256)));
+
+  mdl = NULL;
+  stat = yices_check_context_with_cubes(ctx, NULL, 4, nworkers, 0, &mdl);
+  check(stat == STATUS_SAT && mdl != NULL, "bv: sat");
+  check(yices_context_status(ctx) == STATUS_IDLE, "bv: idle");
+  check(bv16_value(mdl, x) == 11 && bv16_value(mdl, y) == 13, "bv: factors");
+  yices_free_model(mdl);
+
+  // unsat: x can't be 3
+  yices_push(ctx);
+  yices_assert_formula(ctx, yices_eq(x, yices_bvconst_uint32(16, 3)));
+  stat = yices_check_context_with_cubes(ctx, NULL, 4, nworkers, 0, NULL);
+  check(stat == STATUS_UNSAT, "bv: unsat");
+  yices_pop(ctx);
+
+  // the context is unchanged: same result with a small budget
+  mdl = NULL;
+  stat = yices_check_context_with_cubes(ctx, NULL, 2, nworkers, 10, &mdl);
+  check(stat == STATUS_SAT && mdl != NULL, "bv: sat again");
+  check(bv16_value(mdl, x) == 11 && bv16_value(mdl, y) == 13, "bv: factors again");
+  yices_free_model(mdl);
+
+  yices_free_context(ctx);
+}
+
+
+/*
+ * Random 3-SAT with a planted solution (all variables true in the
+ * planted solution: each clause has at least one positive literal)
+ */
+static uint32_t seed = 12345;
+
+static uint32_t random_index(uint32_t n) {
+  seed = seed * 1103515245 + 12345;
+  return (seed >> 8) % n;
+}
+
+static void test_planted_sat(uint32_t nworkers) {
+  context_t *ctx;
+  model_t *mdl;
+  term_t x[200], a[3];
+  term_t *clauses;
+  uint32_t i, j, n, m;
+  smt_status_t stat;
+
+  n = 200;
+  m = 850;
+  ctx = yices_new_context(NULL);
+  for (i=0; i<n; i++) {
+    x[i] = yices_new_uninterpreted_term(yices_bool_type());
+  }
+  clauses = (term_t *) malloc(m * sizeof(term_t));
+  check(clauses != NULL, "malloc");
+  for (i=0; i<m; i++) {
+    for (j=0; j<3; j++) {
+      a[j] = x[random_index(n)];
+      if (j > 0 && random_index(2) == 0) a[j] = yices_not(a[j]);
+    }
+    clauses[i] = yices_or(3, a);
+    yices_assert_formula(ctx, clauses[i]);
+  }
+
+  mdl = NULL;
+  stat = yices_check_context_with_cubes(ctx, NULL, 5, nworkers, 50, &mdl);
+  check(stat == STATUS_SAT && mdl != NULL, "planted: sat");
+  check(yices_formulas_true_in_model(mdl, m, clauses) == 1, "planted: model");
+  yices_free_model(mdl);
+
+  free(clauses);
+  yices_free_context(ctx);
+}
+
+
+/*
+ * Unsat by propagation at the base level, and errors
+ */
+static void test_base_level(void) {
+  ctx_config_t *config;
+  context_t *ctx;
+  term_t p, q;
+
+  ctx = yices_new_context(NULL);
+  p = yices_new_uninterpreted_term(yices_bool_type());
+  q = yices_new_uninterpreted_term(yices_bool_type());
+  yices_assert_formula(ctx, yices_implies(p, q));
+  yices_assert_formula(ctx, p);
+  yices_assert_formula(ctx, yices_not(q));
+  check(yices_check_context_with_cubes(ctx, NULL, 3, 1, 0, NULL) == STATUS_UNSAT, "base: unsat");
+  check(yices_context_status(ctx) == STATUS_UNSAT, "base: status");
+  yices_free_context(ctx);
+
+  config = yices_new_config();
+  yices_default_config_for_logic(config, "QF_UF");
+  yices_set_config(config, "mode", "one-shot");
+  ctx = yices_new_context(config);
+  yices_free_config(config);
+  check(yices_check_context_with_cubes(ctx, NULL, 3, 1, 0, NULL) == STATUS_ERROR, "one-shot: error");
+  check(yices_error_code() == CTX_OPERATION_NOT_SUPPORTED, "one-shot: error code");
+  yices_free_context(ctx);
+}
+
+
+int main(void) {
+  yices_init();
+
+  test_pigeon_hole(1);
+  test_pigeon_hole(4);
+  test_bv_factor(1);
+  test_bv_factor(3);
+  test_planted_sat(1);
+  test_planted_sat(4);
+  test_base_level();
+
+  // the workers must be collected even if the children are reaped automatically
+#ifndef MINGW
+  signal(SIGCHLD, SIG_IGN);
+  test_bv_factor(3);
+  test_pigeon_hole(4);
+  signal(SIGCHLD, SIG_DFL);
+#endif
+
+  printf("All tests passed\n");
+  yices_exit();
+
+  return 0;
+}
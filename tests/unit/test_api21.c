@@ -0,0 +1,283 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * TEST INTEGER REASONING IN SIMPLEX: PRESOLVE, CUBE TEST, BRANCHING
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+#include "yices.h"
+
+static void check(bool cond, const char *msg) {
+  if (!cond) {
+    fprintf(stderr, "FAILED: %s\n", msg);
+    fflush(stderr);
+    exit(1);
+  }
+}
+
+static uint64_t stat_value(context_t *ctx, const char *name) {
+  uint64_t v;
+
+  check(yices_get_statistic(ctx, name, &v) == 0, name);
+  return v;
+}
+
+
+/*
+ * Random constraints: sum_i a[i] * x[i] <= b
+ * - NVARS variables in [LO, HI]
+ */
+#define NVARS 3
+#define NCONSTRAINTS 3
+#define LO (-4)
+#define HI 4
+
+static uint32_t seed = 4321;
+
+static int32_t random_int(int32_t lo, int32_t hi) {
+  seed = seed * 1103515245 + 12345;
+  return lo + (int32_t) ((seed >> 8) % (uint32_t) (hi - lo + 1));
+}
+
+typedef struct {
+  int32_t a[NVARS];
+  int32_t b;
+} constraint_t;
+
+static bool satisfies(constraint_t *c, int32_t *v) {
+  int32_t i, s;
+
+  s = 0;
+  for (i=0; i<NVARS; i++) {
+    s += c->a[i] * v[i];
+  }
+  return s <= c->b;
+}
+
+// brute force
+static bool has_solution(constraint_t *c, uint32_t n) {
+  int32_t v[NVARS];
+  uint32_t i;
+  bool ok;
+
+  for (v[0]=LO; v[0]<=HI; v[0]++) {
+    for (v[1]=LO; v[1]<=HI; v[1]++) {
+      for (v[2]=LO; v[2]<=HI; v[2]++) {
+        ok = true;
+        for (i=0; i<n && ok; i++) {
+          ok = satisfies(c + i, v);
+        }
+        if (ok) return true;
+      }
+    }
+  }
+  return false;
+}
+
+static term_t constraint_term(constraint_t *c, term_t *x) {
+  int32_t a[NVARS];
+  uint32_t i;
+
+  for (i=0; i<NVARS; i++) {
+    a[i] = c->a[i];
+  }
+  return yices_arith_leq_atom(yices_poly_int32(NVARS, a, x), yices_int32(c->b));
+}
+
+/*
+ * Compare with brute force on random problems
+ * - the constraints are asserted in a push/pop scope so the presolve
+ *   also runs at a base level > 0
+ */
+static void test_random(uint32_t n) {
+  context_t *ctx;
+  model_t *mdl;
+  constraint_t c[NCONSTRAINTS];
+  term_t x[NVARS];
+  int32_t v[NVARS];
+  uint32_t i, j, k;
+  smt_status_t stat;
+  bool sat;
+
+  ctx = yices_new_context(NULL);
+  for (i=0; i<NVARS; i++) {
+    x[i] = yices_new_uninterpreted_term(yices_int_type());
+    yices_assert_formula(ctx, yices_arith_geq_atom(x[i], yices_int32(LO)));
+    yices_assert_formula(ctx, yices_arith_leq_atom(x[i], yices_int32(HI)));
+  }
+
+  for (k=0; k<n; k++) {
+    for (i=0; i<NCONSTRAINTS; i++) {
+      for (j=0; j<NVARS; j++) {
+        c[i].a[j] = random_int(-9, 9);
+      }
+      c[i].b = random_int(-12, 12);
+    }
+    sat = has_solution(c, NCONSTRAINTS);
+
+    check(yices_push(ctx) == 0, "push");
+    for (i=0; i<NCONSTRAINTS; i++) {
+      yices_assert_formula(ctx, constraint_term(c + i, x));
+    }
+    stat = yices_check_context(ctx, NULL);
+    check(stat == (sat ? STATUS_SAT : STATUS_UNSAT), "random: status");
+    if (stat == STATUS_SAT) {
+      mdl = yices_get_model(ctx, true);
+      check(mdl != NULL, "random: model");
+      for (i=0; i<NVARS; i++) {
+        check(yices_get_int32_value(mdl, x[i], v + i) == 0, "random: value");
+        check(LO <= v[i] && v[i] <= HI, "random: bounds");
+      }
+      for (i=0; i<NCONSTRAINTS; i++) {
+        check(satisfies(c + i, v), "random: constraint");
+      }
+      yices_free_model(mdl);
+    }
+    check(yices_pop(ctx) == 0, "pop");
+  }
+
+  yices_free_context(ctx);
+}
+
+
+/*
+ * Presolve: the bounds on x and y are tightened by propagation
+ * (x + y >= 19 with x, y <= 10 implies x, y >= 9). Then we add
+ * 3x + 3y = 3z + 1, which has no integer solution.
+ */
+static void test_presolve(void) {
+  context_t *ctx;
+  term_t x, y, z, t;
+
+  ctx = yices_new_context(NULL);
+  x = yices_new_uninterpreted_term(yices_int_type());
+  y = yices_new_uninterpreted_term(yices_int_type());
+  z = yices_new_uninterpreted_term(yices_int_type());
+
+  // x <= 10, y <= 10, x + y >= 19, x - y <= 0
+  yices_assert_formula(ctx, yices_arith_leq_atom(x, yices_int32(10)));
+  yices_assert_formula(ctx, yices_arith_leq_atom(y, yices_int32(10)));
+  yices_assert_formula(ctx, yices_arith_geq_atom(yices_add(x, y), yices_int32(19)));
+  yices_assert_formula(ctx, yices_arith_leq_atom(yices_sub(x, y), yices_zero()));
+  check(yices_check_context(ctx, NULL) == STATUS_SAT, "presolve: sat");
+  check(stat_value(ctx, "simplex.presolve-bounds") > 0, "presolve: new bounds");
+
+  // 3x + 3y = 3z + 1
+  t = yices_add(yices_mul(yices_int32(3), yices_sub(yices_add(x, y), z)), yices_int32(-1));
+  yices_assert_formula(ctx, yices_arith_eq0_atom(t));
+  check(yices_check_context(ctx, NULL) == STATUS_UNSAT, "presolve: unsat");
+
+  yices_free_context(ctx);
+}
+
+
+/*
+ * Branching: 11x + 13y = 7z + 1000 with all variables in [0, 100]
+ * requires branch & bound. Check the statistics.
+ */
+static void test_branching(void) {
+  context_t *ctx;
+  model_t *mdl;
+  term_t x, y, z, zero, hundred;
+  int32_t vx, vy, vz;
+  int32_t a[3];
+  term_t v[3];
+
+  ctx = yices_new_context(NULL);
+  x = yices_new_uninterpreted_term(yices_int_type());
+  y = yices_new_uninterpreted_term(yices_int_type());
+  z = yices_new_uninterpreted_term(yices_int_type());
+  zero = yices_zero();
+  hundred = yices_int32(100);
+  v[0] = x; v[1] = y; v[2] = z;
+  a[0] = 11; a[1] = 13; a[2] = -7;
+  yices_assert_formula(ctx, yices_arith_eq_atom(yices_poly_int32(3, a, v), yices_int32(1000)));
+  yices_assert_formula(ctx, yices_arith_geq_atom(x, zero));
+  yices_assert_formula(ctx, yices_arith_geq_atom(y, zero));
+  yices_assert_formula(ctx, yices_arith_geq_atom(z, zero));
+  yices_assert_formula(ctx, yices_arith_leq_atom(x, hundred));
+  yices_assert_formula(ctx, yices_arith_leq_atom(y, hundred));
+  yices_assert_formula(ctx, yices_arith_leq_atom(z, hundred));
+  yices_assert_formula(ctx, yices_arith_geq_atom(yices_sub(x, y), yices_int32(17)));
+
+  check(yices_check_context(ctx, NULL) == STATUS_SAT, "branching: sat");
+  mdl = yices_get_model(ctx, true);
+  check(mdl != NULL, "branching: model");
+  check(yices_get_int32_value(mdl, x, &vx) == 0 && yices_get_int32_value(mdl, y, &vy) == 0 &&
+        yices_get_int32_value(mdl, z, &vz) == 0, "branching: values");
+  check(11 * vx + 13 * vy - 7 * vz == 1000 && vx - vy >= 17, "branching: equation");
+  check(0 <= vx && vx <= 100 && 0 <= vy && vy <= 100 && 0 <= vz && vz <= 100, "branching: bounds");
+  yices_free_model(mdl);
+
+  check(stat_value(ctx, "simplex.make-integer-feasible") > 0, "branching: make integer feasible");
+  check(stat_value(ctx, "simplex.branch-nodes") <= stat_value(ctx, "simplex.make-integer-feasible"), "branching: nodes");
+  check(stat_value(ctx, "simplex.cube-successes") <= stat_value(ctx, "simplex.cube-tests"), "branching: cube test");
+  check(stat_value(ctx, "simplex.pcost-branches") <= stat_value(ctx, "simplex.branch-nodes"), "branching: pseudo-costs");
+  check(stat_value(ctx, "simplex.strengthen-rounds") > 0, "branching: strengthening");
+
+  yices_free_context(ctx);
+}
+
+
+/*
+ * Constraints with fractional vertices: 2x + 2y >= 1, 2x - 2y <= 1,
+ * x + 2y <= 40. The integer solution must satisfy all of them.
+ */
+static void test_cube(void) {
+  context_t *ctx;
+  model_t *mdl;
+  term_t x, y, two;
+  int32_t vx, vy;
+
+  ctx = yices_new_context(NULL);
+  x = yices_new_uninterpreted_term(yices_int_type());
+  y = yices_new_uninterpreted_term(yices_int_type());
+  two = yices_int32(2);
+  yices_assert_formula(ctx, yices_arith_geq_atom(yices_add(yices_mul(two, x), yices_mul(two, y)), yices_int32(1)));
+  yices_assert_formula(ctx, yices_arith_leq_atom(yices_sub(yices_mul(two, x), yices_mul(two, y)), yices_int32(1)));
+  yices_assert_formula(ctx, yices_arith_leq_atom(yices_add(x, yices_mul(two, y)), yices_int32(40)));
+
+  check(yices_check_context(ctx, NULL) == STATUS_SAT, "cube: sat");
+  mdl = yices_get_model(ctx, true);
+  check(mdl != NULL, "cube: model");
+  check(yices_get_int32_value(mdl, x, &vx) == 0 && yices_get_int32_value(mdl, y, &vy) == 0, "cube: values");
+  check(2 * vx + 2 * vy >= 1 && 2 * vx - 2 * vy <= 1 && vx + 2 * vy <= 40, "cube: constraints");
+  yices_free_model(mdl);
+
+  yices_free_context(ctx);
+}
+
+
+int main(void) {
+  yices_init();
+
+  test_presolve();
+  test_cube();
+  test_branching();
+  test_random(300);
+
+  printf("All tests passed\n");
+  yices_exit();
+
+  return 0;
+}
@@ -0,0 +1,331 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * TEST BOOLEAN PREPROCESSING IN THE SMT CORE
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+#include "yices.h"
+
+static void check(bool cond, const char *msg) {
+  if (!cond) {
+    fprintf(stderr, "FAILED: %s\n", msg);
+    fflush(stderr);
+    exit(1);
+  }
+}
+
+/*
+ * QF_UF context in the given mode (the Boolean preprocessing is
+ * done only in one-shot and multi-checks modes)
+ */
+static context_t *uf_context(const char *mode) {
+  ctx_config_t *config;
+  context_t *ctx;
+
+  config = yices_new_config();
+  yices_default_config_for_logic(config, "QF_UF");
+  yices_set_config(config, "mode", mode);
+  ctx = yices_new_context(config);
+  yices_free_config(config);
+
+  return ctx;
+}
+
+/*
+ * Assert the n formulas f[0 ... n-1] then check with or without preprocessing
+ * - if the result is sat, check that all formulas are true in the model
+ */
+static smt_status_t check_formulas(context_t *ctx, uint32_t n, term_t *f, bool preprocess) {
+  param_t *params;
+  model_t *mdl;
+  smt_status_t stat;
+
+  check(yices_assert_formulas(ctx, n, f) == 0, "assert");
+  params = yices_new_param_record();
+  yices_default_params_for_context(ctx, params);
+  check(yices_set_param(params, "bool-preprocess", preprocess ? "true" : "false") == 0, "set param");
+  stat = yices_check_context(ctx, params);
+  yices_free_param_record(params);
+
+  if (stat == STATUS_SAT) {
+    mdl = yices_get_model(ctx, true);
+    check(mdl != NULL, "model");
+    check(yices_formulas_true_in_model(mdl, n, f) == 1, "model satisfies the formulas");
+    yices_free_model(mdl);
+  }
+
+  return stat;
+}
+
+
+/*
+ * Pseudo random numbers
+ */
+static uint32_t seed = 2468;
+
+static uint32_t random_index(uint32_t n) {
+  seed = seed * 1103515245 + 12345;
+  return (seed >> 8) % n;
+}
+
+static term_t random_literal(term_t *x, uint32_t n) {
+  term_t t;
+
+  t = x[random_index(n)];
+  return random_index(2) == 0 ? yices_not(t) : t;
+}
+
+static void new_bool_vars(term_t *x, uint32_t n) {
+  uint32_t i;
+
+  for (i=0; i<n; i++) {
+    x[i] = yices_new_uninterpreted_term(yices_bool_type());
+  }
+}
+
+
+/*
+ * Equivalences: x[0] => x[1] => ... => x[9] => x[0] and random
+ * ternary clauses.
+ */
+static void test_equivalences(void) {
+  context_t *ctx;
+  term_t x[30], f[60], a[3];
+  uint32_t i, j;
+  uint64_t v;
+
+  ctx = uf_context("one-shot");
+  new_bool_vars(x, 30);
+  for (i=0; i<10; i++) {
+    f[i] = yices_implies(x[i], x[(i + 1) % 10]);
+  }
+  for (i=10; i<60; i++) {
+    for (j=0; j<3; j++) {
+      a[j] = random_literal(x, 30);
+    }
+    // satisfied if x[0] ... x[9] are true
+    a[0] = x[random_index(10)];
+    f[i] = yices_or(3, a);
+  }
+
+  check(check_formulas(ctx, 60, f, true) == STATUS_SAT, "equivalences: sat");
+  check(yices_get_statistic(ctx, "core.substituted-vars", &v) == 0 && v >= 9, "equivalences: substitution");
+
+  yices_free_context(ctx);
+}
+
+
+/*
+ * Random 3-SAT with a planted solution: all variables are true
+ * - some variables occur only positively so they can be eliminated
+ */
+static void test_planted(void) {
+  context_t *ctx;
+  term_t x[300], a[3];
+  term_t *f;
+  uint32_t i, j, m;
+  uint64_t v;
+
+  m = 850;
+  f = (term_t *) malloc(m * sizeof(term_t));
+  check(f != NULL, "malloc");
+
+  ctx = uf_context("one-shot");
+  new_bool_vars(x, 300);
+  for (i=0; i<m; i++) {
+    for (j=0; j<3; j++) {
+      a[j] = random_literal(x, 300);
+    }
+    a[0] = x[random_index(300)];
+    f[i] = yices_or(3, a);
+  }
+
+  check(check_formulas(ctx, m, f, true) == STATUS_SAT, "planted: sat");
+  check(yices_get_statistic(ctx, "core.eliminated-vars", &v) == 0 && v > 0, "planted: elimination");
+
+  yices_free_context(ctx);
+  free(f);
+}
+
+
+/*
+ * Random 3-SAT near the threshold: compare the results with and
+ * without preprocessing.
+ */
+static void test_random(uint32_t n) {
+  context_t *ctx;
+  term_t x[50], f[215], a[3];
+  uint32_t i, j, k;
+  smt_status_t stat1, stat2;
+
+  for (k=0; k<n; k++) {
+    new_bool_vars(x, 50);
+    for (i=0; i<215; i++) {
+      for (j=0; j<3; j++) {
+        a[j] = random_literal(x, 50);
+      }
+      f[i] = yices_or(3, a);
+    }
+
+    ctx = uf_context("one-shot");
+    stat1 = check_formulas(ctx, 215, f, false);
+    yices_free_context(ctx);
+
+    ctx = uf_context("one-shot");
+    stat2 = check_formulas(ctx, 215, f, true);
+    yices_free_context(ctx);
+
+    check((stat1 == STATUS_SAT || stat1 == STATUS_UNSAT) && stat1 == stat2, "random: same result");
+  }
+}
+
+
+/*
+ * Pigeon-hole problem: 6 pigeons, 5 holes
+ */
+static void test_pigeon_hole(void) {
+  context_t *ctx;
+  term_t p[6][5], a[5], b[2];
+  uint32_t i, j, k;
+
+  ctx = uf_context("one-shot");
+  for (i=0; i<6; i++) {
+    new_bool_vars(p[i], 5);
+    for (j=0; j<5; j++) {
+      a[j] = p[i][j];
+    }
+    yices_assert_formula(ctx, yices_or(5, a));
+  }
+  for (j=0; j<5; j++) {
+    for (i=0; i<6; i++) {
+      for (k=i+1; k<6; k++) {
+        b[0] = yices_not(p[i][j]);
+        b[1] = yices_not(p[k][j]);
+        yices_assert_formula(ctx, yices_or(2, b));
+      }
+    }
+  }
+
+  check(check_formulas(ctx, 0, NULL, true) == STATUS_UNSAT, "pigeon-hole: unsat");
+  yices_free_context(ctx);
+}
+
+
+/*
+ * Multiple checks: the formulas asserted after the first check
+ * refer to eliminated variables. These variables must be restored.
+ */
+static void test_multichecks(void) {
+  context_t *ctx;
+  term_t x[40], f[120], a[3];
+  uint32_t i, j, k;
+  smt_status_t stat;
+  uint64_t v;
+
+  ctx = uf_context("multi-checks");
+  new_bool_vars(x, 40);
+  for (i=0; i<100; i++) {
+    for (j=0; j<3; j++) {
+      a[j] = random_literal(x, 40);
+    }
+    a[0] = x[random_index(40)];
+    f[i] = yices_or(3, a);
+  }
+  check(check_formulas(ctx, 100, f, true) == STATUS_SAT, "multichecks: sat");
+
+  // add negative binary clauses: this may force some variables to false
+  k = 100;
+  for (i=0; i<20; i++) {
+    a[0] = yices_not(x[random_index(40)]);
+    a[1] = yices_not(x[random_index(40)]);
+    f[k] = yices_or(2, a);
+    stat = check_formulas(ctx, 1, f + k, true);
+    check(stat == STATUS_SAT || stat == STATUS_UNSAT, "multichecks: status");
+    k ++;
+    if (stat == STATUS_UNSAT) break;
+    // all formulas so far must be true
+    check(check_formulas(ctx, k, f, true) == STATUS_SAT, "multichecks: recheck");
+  }
+
+  if (stat == STATUS_SAT) {
+    check(yices_get_statistic(ctx, "core.restored-vars", &v) == 0 && v > 0, "multichecks: restored variables");
+  }
+
+  yices_free_context(ctx);
+}
+
+
+/*
+ * Boolean terms used as arguments of uninterpreted functions
+ * are attached to atoms: they must not be eliminated.
+ */
+static void test_uf(void) {
+  context_t *ctx;
+  type_t tau, ftype;
+  term_t f, p[10], c[10], g[40], a[3];
+  uint32_t i, j;
+
+  ctx = uf_context("one-shot");
+  tau = yices_new_uninterpreted_type();
+  ftype = yices_function_type1(yices_bool_type(), tau);
+  f = yices_new_uninterpreted_term(ftype);
+  new_bool_vars(p, 10);
+  for (i=0; i<10; i++) {
+    c[i] = yices_new_uninterpreted_term(tau);
+  }
+
+  for (i=0; i<10; i++) {
+    g[i] = yices_implies(p[i], yices_eq(yices_application1(f, p[i]), c[i]));
+  }
+  g[10] = yices_neq(c[0], c[1]);
+  g[11] = yices_neq(c[2], c[3]);
+  for (i=12; i<40; i++) {
+    for (j=0; j<3; j++) {
+      a[j] = random_literal(p, 10);
+    }
+    f = yices_application1(yices_new_uninterpreted_term(ftype), a[0]);
+    a[0] = yices_eq(f, c[random_index(10)]);
+    g[i] = yices_or(3, a);
+  }
+
+  check(check_formulas(ctx, 40, g, true) == STATUS_SAT, "uf: sat");
+  yices_free_context(ctx);
+}
+
+
+int main(void) {
+  yices_init();
+
+  test_equivalences();
+  test_planted();
+  test_pigeon_hole();
+  test_random(100);
+  test_multichecks();
+  test_uf();
+
+  printf("All tests passed\n");
+  yices_exit();
+
+  return 0;
+}
@@ -0,0 +1,186 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * TEST CONTEXT CLONING
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+#include "yices.h"
+
+/*
+ * Print an error message then exit
+ */
+static void print_error(void) {
+  char *s;
+
+  s = yices_error_string();
+  fprintf(stderr, "Yices error: %s\n", s);
+  yices_free_string(s);
+  exit(1);
+}
+
+static void check_status(context_t *ctx, smt_status_t expected, const char *msg) {
+  smt_status_t stat;
+
+  stat = yices_check_context(ctx, NULL);
+  printf("%s: status = %d\n", msg, (int) stat);
+  if (stat != expected) {
+    printf("BUG: expected status %d\n", (int) expected);
+    exit(1);
+  }
+}
+
+static void assert_formula(context_t *ctx, term_t f) {
+  if (yices_assert_formula(ctx, f) < 0) print_error();
+}
+
+static context_t *clone(context_t *ctx) {
+  context_t *c;
+
+  c = yices_clone_context(ctx);
+  if (c == NULL) print_error();
+  return c;
+}
+
+// cloning must fail because ctx has constraints that are not logged
+static void check_no_clone(context_t *ctx, const char *msg) {
+  if (yices_clone_context(ctx) != NULL || yices_error_code() != CTX_INVALID_OPERATION) {
+    printf("BUG: %s: clone should fail\n", msg);
+    exit(1);
+  }
+  yices_clear_error();
+}
+
+/*
+ * Contexts with constraints outside the assertion log can't be cloned
+ */
+static void test_unlogged(term_t x, term_t y) {
+  context_t *ctx, *c;
+
+  // no assertion-log option
+  ctx = yices_new_context(NULL);
+  c = clone(ctx);
+  yices_free_context(c);
+  assert_formula(ctx, yices_arith_gt_atom(x, y));
+  check_no_clone(ctx, "no log");
+  yices_free_context(ctx);
+
+  // blocking clause
+  ctx = yices_new_context(NULL);
+  if (yices_context_enable_option(ctx, "assertion-log") < 0) print_error();
+  assert_formula(ctx, yices_arith_gt_atom(x, y));
+  yices_push(ctx);
+  assert_formula(ctx, yices_arith_lt_atom(x, yices_int32(2)));
+  check_status(ctx, STATUS_SAT, "before blocking clause");
+  if (yices_assert_blocking_clause(ctx) < 0) print_error();
+  check_no_clone(ctx, "blocking clause");
+
+  // the blocking clause is removed by pop
+  if (yices_pop(ctx) < 0) print_error();
+  c = clone(ctx);
+  check_status(c, STATUS_SAT, "clone after pop");
+  yices_free_context(c);
+  yices_free_context(ctx);
+}
+
+int main(void) {
+  context_t *ctx, *c1, *c2, *c3;
+  term_t x, y;
+  int32_t v;
+  model_t *mdl;
+
+  yices_init();
+
+  x = yices_new_uninterpreted_term(yices_int_type());
+  y = yices_new_uninterpreted_term(yices_int_type());
+
+  // x > y; push; y > 3; push; x < 2 --> unsat
+  ctx = yices_new_context(NULL);
+  if (yices_context_enable_option(ctx, "assertion-log") < 0) print_error();
+  assert_formula(ctx, yices_arith_gt_atom(x, y));
+  yices_push(ctx);
+  assert_formula(ctx, yices_arith_gt_atom(y, yices_int32(3)));
+  yices_push(ctx);
+  assert_formula(ctx, yices_arith_lt_atom(x, yices_int32(2)));
+  check_status(ctx, STATUS_UNSAT, "ctx");
+
+  // the clone must be unsat and it must keep the push levels
+  c1 = clone(ctx);
+  if (yices_context_status(c1) != STATUS_UNSAT) {
+    printf("BUG: clone of an unsat context should be unsat\n");
+    exit(1);
+  }
+
+  // the clone's assertions must survive garbage collection
+  yices_garbage_collect(NULL, 0, NULL, 0, false);
+
+  if (yices_pop(c1) < 0) print_error();
+  check_status(c1, STATUS_SAT, "c1 after pop");
+  mdl = yices_get_model(c1, true);
+  if (mdl == NULL) print_error();
+  if (yices_get_int32_value(mdl, y, &v) < 0) print_error();
+  if (v <= 3) {
+    printf("BUG: wrong model\n");
+    exit(1);
+  }
+  yices_free_model(mdl);
+
+  // popping the clone must not affect ctx
+  if (yices_context_status(ctx) != STATUS_UNSAT) {
+    printf("BUG: ctx was modified\n");
+    exit(1);
+  }
+
+  // clone of a sat context: assertions in the clone are independent
+  if (yices_pop(ctx) < 0 || yices_pop(ctx) < 0) print_error();
+  check_status(ctx, STATUS_SAT, "ctx at level 0");
+  c2 = clone(ctx);
+  if (yices_context_status(c2) != STATUS_IDLE) {
+    printf("BUG: clone should be idle\n");
+    exit(1);
+  }
+  assert_formula(c2, yices_arith_eq_atom(x, y));
+  check_status(c2, STATUS_UNSAT, "c2");
+  check_status(ctx, STATUS_SAT, "ctx");
+
+  // clone of a clone: c1 and c3 are at level 1
+  c3 = clone(c1);
+  check_status(c3, STATUS_SAT, "c3");
+  if (yices_pop(c3) < 0) print_error();
+  if (yices_pop(c3) == 0) {
+    printf("BUG: c3 should be at level 0\n");
+    exit(1);
+  }
+
+  yices_free_context(c3);
+  yices_free_context(c2);
+  yices_free_context(c1);
+  yices_free_context(ctx);
+
+  test_unlogged(x, y);
+  yices_exit();
+
+  printf("all tests passed\n");
+
+  return 0;
+}
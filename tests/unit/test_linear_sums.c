@@ -0,0 +1,220 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * TEST BULK CONSTRUCTION OF LARGE LINEAR SUMS
+ *
+ * Sums of many terms are built by sorting and merging monomials in a flat
+ * array. The result must be the same term as the one obtained by adding
+ * the terms one by one.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+#include "yices.h"
+
+#define NVARS 40
+#define MAX_N 400
+
+static term_t var[NVARS];
+static term_t rvar[NVARS];
+
+static void check(bool cond, const char *msg) {
+  if (!cond) {
+    fprintf(stderr, "FAILED: %s\n", msg);
+    fflush(stderr);
+    exit(1);
+  }
+}
+
+/*
+ * Random arithmetic term: variable, constant, product of a variable by a
+ * constant, or small polynomial
+ */
+static term_t random_term(bool real) {
+  term_t *v;
+  term_t a[3];
+
+  v = real ? rvar : var;
+  switch (random() % 6) {
+  case 0:
+    return yices_int32(random() % 21 - 10);
+
+  case 1:
+    return yices_mul(yices_int32(random() % 7 - 3), v[random() % NVARS]);
+
+  case 2:
+    a[0] = v[random() % NVARS];
+    a[1] = yices_int32(random() % 5);
+    a[2] = yices_neg(v[random() % NVARS]);
+    return yices_sum(3, a);
+
+  default:
+    return v[random() % NVARS];
+  }
+}
+
+/*
+ * Sum built incrementally: t[0] + ... + t[n-1]
+ */
+static term_t incremental_sum(uint32_t n, const term_t t[]) {
+  term_t s;
+  uint32_t i;
+
+  s = yices_zero();
+  for (i=0; i<n; i++) {
+    s = yices_add(s, t[i]);
+  }
+  return s;
+}
+
+static void test_random_sums(uint32_t n, bool real) {
+  term_t t[MAX_N];
+  int32_t a[MAX_N];
+  term_t s1, s2, p;
+  uint32_t i;
+
+  for (i=0; i<n; i++) {
+    t[i] = random_term(real);
+    a[i] = random() % 9 - 4;
+  }
+
+  s1 = yices_sum(n, t);
+  s2 = incremental_sum(n, t);
+  check(s1 != NULL_TERM && s1 == s2, "yices_sum");
+
+  // poly: same thing with coefficients
+  s1 = yices_poly_int32(n, a, t);
+  s2 = yices_zero();
+  for (i=0; i<n; i++) {
+    p = yices_mul(yices_int32(a[i]), t[i]);
+    s2 = yices_add(s2, p);
+  }
+  check(s1 != NULL_TERM && s1 == s2, "yices_poly_int32");
+}
+
+/*
+ * Sums that simplify to zero, a constant, or a variable
+ */
+static void test_simplifications(void) {
+  term_t t[2 * NVARS + 1];
+  uint32_t i;
+
+  for (i=0; i<NVARS; i++) {
+    t[2*i] = var[i];
+    t[2*i+1] = yices_neg(var[i]);
+  }
+  check(yices_sum(2 * NVARS, t) == yices_zero(), "sum: zero");
+
+  t[2 * NVARS] = yices_int32(5);
+  check(yices_sum(2 * NVARS + 1, t) == yices_int32(5), "sum: constant");
+
+  t[2 * NVARS] = var[0];
+  check(yices_sum(2 * NVARS + 1, t) == var[0], "sum: variable");
+}
+
+/*
+ * Variables with large indices: the radix sort needs several passes
+ * - the sum includes the small variables and repeated terms
+ */
+#define NBIG 70000
+
+static void test_large_indices(void) {
+  term_t *big, t[MAX_N];
+  uint32_t i, n;
+
+  big = (term_t *) malloc(NBIG * sizeof(term_t));
+  check(big != NULL, "malloc");
+  for (i=0; i<NBIG; i++) {
+    big[i] = yices_new_uninterpreted_term(yices_int_type());
+  }
+
+  for (n=50; n<MAX_N; n += 70) {
+    for (i=0; i<n; i++) {
+      t[i] = (i % 4 == 0) ? random_term(false) : big[random() % NBIG];
+    }
+    t[n-1] = t[0];
+    check(yices_sum(n, t) == incremental_sum(n, t), "sum: large indices");
+  }
+
+  free(big);
+}
+
+/*
+ * Non-linear terms: the rba_buffer path is used
+ */
+static void test_nonlinear(void) {
+  term_t t[MAX_N];
+  uint32_t i;
+
+  for (i=0; i<100; i++) {
+    t[i] = random_term(false);
+  }
+  t[50] = yices_mul(var[0], var[1]);
+  check(yices_sum(100, t) == incremental_sum(100, t), "non-linear sum");
+}
+
+/*
+ * Parser fast path
+ */
+static void test_parser(void) {
+  char buffer[8192];
+  term_t t[NVARS], s;
+  uint32_t i, k;
+
+  k = sprintf(buffer, "(+");
+  for (i=0; i<NVARS; i++) {
+    k += sprintf(buffer + k, " (* %d v%"PRIu32") 1/2", (int) (i % 5) - 2, i % 7);
+    t[i] = yices_add(yices_mul(yices_int32((int) (i % 5) - 2), var[i % 7]), yices_rational32(1, 2));
+  }
+  sprintf(buffer + k, ")");
+
+  s = yices_parse_term(buffer);
+  check(s != NULL_TERM && s == incremental_sum(NVARS, t), "parser");
+}
+
+int main(void) {
+  char name[20];
+  uint32_t i, n;
+
+  yices_init();
+
+  for (i=0; i<NVARS; i++) {
+    var[i] = yices_new_uninterpreted_term(yices_int_type());
+    sprintf(name, "v%"PRIu32, i);
+    yices_set_term_name(var[i], name);
+    rvar[i] = yices_new_uninterpreted_term(yices_real_type());
+  }
+
+  for (n=1; n<MAX_N; n += 13) {
+    test_random_sums(n, false);
+    test_random_sums(n, true);
+  }
+  test_simplifications();
+  test_large_indices();
+  test_nonlinear();
+  test_parser();
+
+  printf("All tests passed\n");
+  yices_exit();
+
+  return 0;
+}
@@ -0,0 +1,386 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * TEST OPTIMIZATION OF ARITHMETIC AND BITVECTOR OBJECTIVES
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+#include "yices.h"
+
+static void check(bool cond, const char *msg) {
+  if (!cond) {
+    fprintf(stderr, "FAILED: %s\n", msg);
+    fflush(stderr);
+    exit(1);
+  }
+}
+
+static context_t *new_context(const char *logic, const char *mode) {
+  ctx_config_t *config;
+  context_t *ctx;
+
+  config = yices_new_config();
+  yices_default_config_for_logic(config, logic);
+  yices_set_config(config, "mode", mode);
+  ctx = yices_new_context(config);
+  yices_free_config(config);
+  check(ctx != NULL, "context construction");
+
+  return ctx;
+}
+
+static uint64_t stat_value(context_t *ctx, const char *name) {
+  uint64_t v;
+
+  check(yices_get_statistic(ctx, name, &v) == 0, name);
+  return v;
+}
+
+static term_t new_var(type_t tau) {
+  return yices_new_uninterpreted_term(tau);
+}
+
+static term_t num(int32_t k) {
+  return yices_int32(k);
+}
+
+/*
+ * Check that t has value num/den in mdl
+ */
+static void check_rational_value(model_t *mdl, term_t t, int64_t num, uint64_t den, const char *msg) {
+  int64_t a;
+  uint64_t b;
+
+  check(yices_get_rational64_value(mdl, t, &a, &b) == 0, msg);
+  check(a == num && b == den, msg);
+}
+
+static void check_bv_value(model_t *mdl, term_t t, uint32_t n, uint32_t v, const char *msg) {
+  int32_t bits[32];
+  uint32_t i, x;
+
+  check(yices_get_bv_value(mdl, t, bits) == 0, msg);
+  x = 0;
+  for (i=0; i<n; i++) {
+    x |= ((uint32_t) bits[i]) << i;
+  }
+  check(x == v, msg);
+}
+
+
+/*
+ * Maximize x + y subject to x + 2y <= 4, 3x + y <= 6, x, y >= 0.
+ * - over the reals, the optimum is 14/5 (x = 8/5, y = 6/5)
+ * - over the integers, the maximum of 3x + 2y is 6 (x = 2, y = 0)
+ */
+static void assert_polytope(context_t *ctx, term_t x, term_t y) {
+  yices_assert_formula(ctx, yices_arith_leq_atom(yices_add(x, yices_mul(num(2), y)), num(4)));
+  yices_assert_formula(ctx, yices_arith_leq_atom(yices_add(yices_mul(num(3), x), y), num(6)));
+  yices_assert_formula(ctx, yices_arith_geq0_atom(x));
+  yices_assert_formula(ctx, yices_arith_geq0_atom(y));
+}
+
+static void test_real(void) {
+  context_t *ctx;
+  model_t *mdl;
+  term_t x, y, obj;
+  int32_t max;
+  objective_status_t result;
+
+  ctx = new_context("QF_LRA", "push-pop");
+  x = new_var(yices_real_type());
+  y = new_var(yices_real_type());
+  assert_polytope(ctx, x, y);
+
+  obj = yices_add(x, y);
+  max = 1;
+  mdl = NULL;
+  check(yices_optimize_context(ctx, NULL, 1, &obj, &max, &result, &mdl) == STATUS_SAT, "real: sat");
+  check(result == OBJECTIVE_OPTIMAL, "real: optimal");
+  check(mdl != NULL, "real: model");
+  check_rational_value(mdl, obj, 14, 5, "real: optimum");
+  check_rational_value(mdl, x, 8, 5, "real: x");
+  check_rational_value(mdl, y, 6, 5, "real: y");
+  yices_free_model(mdl);
+
+  // minimize x - y: optimum is -2 (x = 0, y = 2)
+  obj = yices_sub(x, y);
+  max = 0;
+  mdl = NULL;
+  check(yices_optimize_context(ctx, NULL, 1, &obj, &max, &result, &mdl) == STATUS_SAT, "real min: sat");
+  check(result == OBJECTIVE_OPTIMAL, "real min: optimal");
+  check_rational_value(mdl, obj, -2, 1, "real min: optimum");
+  yices_free_model(mdl);
+
+  yices_free_context(ctx);
+}
+
+static void test_integer(void) {
+  context_t *ctx;
+  model_t *mdl;
+  term_t x, y, obj;
+  int32_t max;
+  objective_status_t result;
+
+  ctx = new_context("QF_LIA", "push-pop");
+  x = new_var(yices_int_type());
+  y = new_var(yices_int_type());
+  assert_polytope(ctx, x, y);
+
+  obj = yices_add(yices_mul(num(3), x), yices_mul(num(2), y));
+  max = 1;
+  mdl = NULL;
+  check(yices_optimize_context(ctx, NULL, 1, &obj, &max, &result, &mdl) == STATUS_SAT, "integer: sat");
+  check(result == OBJECTIVE_OPTIMAL, "integer: optimal");
+  check_rational_value(mdl, obj, 6, 1, "integer: optimum");
+  check_rational_value(mdl, x, 2, 1, "integer: x");
+  check_rational_value(mdl, y, 0, 1, "integer: y");
+  yices_free_model(mdl);
+
+  yices_free_context(ctx);
+}
+
+
+/*
+ * Unbounded and not attained objectives
+ */
+static void test_unbounded(void) {
+  context_t *ctx;
+  term_t x, y, obj[2];
+  int32_t max[2];
+  objective_status_t result[2];
+
+  ctx = new_context("QF_LRA", "push-pop");
+  x = new_var(yices_real_type());
+  y = new_var(yices_real_type());
+  yices_assert_formula(ctx, yices_arith_geq_atom(x, y));
+  yices_assert_formula(ctx, yices_arith_lt_atom(y, num(1)));
+
+  // max x is unbounded: y is not optimized
+  obj[0] = x;
+  obj[1] = y;
+  max[0] = 1;
+  max[1] = 1;
+  check(yices_optimize_context(ctx, NULL, 2, obj, max, result, NULL) == STATUS_SAT, "unbounded: sat");
+  check(result[0] == OBJECTIVE_UNBOUNDED, "unbounded: status");
+  check(result[1] == OBJECTIVE_UNKNOWN, "unbounded: next objective");
+
+  // sup y = 1 is not attained
+  check(yices_optimize_context(ctx, NULL, 1, &y, max, result, NULL) == STATUS_SAT, "not attained: sat");
+  check(result[0] == OBJECTIVE_NOT_ATTAINED, "not attained: status");
+
+  // min y is unbounded
+  max[0] = 0;
+  check(yices_optimize_context(ctx, NULL, 1, &y, max, result, NULL) == STATUS_SAT, "unbounded min: sat");
+  check(result[0] == OBJECTIVE_UNBOUNDED, "unbounded min: status");
+
+  yices_free_context(ctx);
+
+  // integer objective: unbounded
+  ctx = new_context("QF_LIA", "push-pop");
+  x = new_var(yices_int_type());
+  yices_assert_formula(ctx, yices_arith_leq_atom(x, num(3)));
+  max[0] = 0;
+  check(yices_optimize_context(ctx, NULL, 1, &x, max, result, NULL) == STATUS_SAT, "int unbounded: sat");
+  check(result[0] == OBJECTIVE_UNBOUNDED, "int unbounded: status");
+  yices_free_context(ctx);
+}
+
+
+/*
+ * Bitvector objectives (unsigned)
+ */
+static void test_bitvector(void) {
+  context_t *ctx;
+  model_t *mdl;
+  term_t x, obj;
+  int32_t max;
+  objective_status_t result;
+
+  ctx = new_context("QF_BV", "push-pop");
+  x = new_var(yices_bv_type(8));
+  // x mod 7 = 3 and x <= 100
+  yices_assert_formula(ctx, yices_bveq_atom(yices_bvrem(x, yices_bvconst_uint32(8, 7)), yices_bvconst_uint32(8, 3)));
+  yices_assert_formula(ctx, yices_bvle_atom(x, yices_bvconst_uint32(8, 100)));
+
+  max = 1;
+  mdl = NULL;
+  check(yices_optimize_context(ctx, NULL, 1, &x, &max, &result, &mdl) == STATUS_SAT, "bv max: sat");
+  check(result == OBJECTIVE_OPTIMAL, "bv max: optimal");
+  check_bv_value(mdl, x, 8, 94, "bv max: optimum");
+  yices_free_model(mdl);
+
+  max = 0;
+  mdl = NULL;
+  check(yices_optimize_context(ctx, NULL, 1, &x, &max, &result, &mdl) == STATUS_SAT, "bv min: sat");
+  check(result == OBJECTIVE_OPTIMAL, "bv min: optimal");
+  check_bv_value(mdl, x, 8, 3, "bv min: optimum");
+  yices_free_model(mdl);
+
+  // objective defined by a term: x + 200 (mod 256)
+  obj = yices_bvadd(x, yices_bvconst_uint32(8, 200));
+  max = 1;
+  mdl = NULL;
+  check(yices_optimize_context(ctx, NULL, 1, &obj, &max, &result, &mdl) == STATUS_SAT, "bv term: sat");
+  check(result == OBJECTIVE_OPTIMAL, "bv term: optimal");
+  check_bv_value(mdl, obj, 8, 252, "bv term: optimum");
+  check_bv_value(mdl, x, 8, 52, "bv term: x");
+  yices_free_model(mdl);
+
+  yices_free_context(ctx);
+}
+
+
+/*
+ * Lexicographic objectives: maximize x then minimize y subject to
+ * x + y <= 10, x <= 7, y >= x - 5. The optimum is x = 7, y = 2.
+ */
+static void test_lexicographic(void) {
+  context_t *ctx;
+  model_t *mdl;
+  term_t x, y, obj[2];
+  int32_t max[2];
+  objective_status_t result[2];
+
+  ctx = new_context("QF_LIA", "push-pop");
+  x = new_var(yices_int_type());
+  y = new_var(yices_int_type());
+  yices_assert_formula(ctx, yices_arith_leq_atom(yices_add(x, y), num(10)));
+  yices_assert_formula(ctx, yices_arith_leq_atom(x, num(7)));
+  yices_assert_formula(ctx, yices_arith_geq_atom(y, yices_sub(x, num(5))));
+
+  obj[0] = x;
+  obj[1] = y;
+  max[0] = 1;
+  max[1] = 0;
+  mdl = NULL;
+  check(yices_optimize_context(ctx, NULL, 2, obj, max, result, &mdl) == STATUS_SAT, "lex: sat");
+  check(result[0] == OBJECTIVE_OPTIMAL && result[1] == OBJECTIVE_OPTIMAL, "lex: optimal");
+  check_rational_value(mdl, x, 7, 1, "lex: x");
+  check_rational_value(mdl, y, 2, 1, "lex: y");
+  yices_free_model(mdl);
+
+  // reverse order: minimize y first (unbounded below)
+  obj[0] = y;
+  obj[1] = x;
+  max[0] = 0;
+  max[1] = 1;
+  check(yices_optimize_context(ctx, NULL, 2, obj, max, result, NULL) == STATUS_SAT, "lex 2: sat");
+  check(result[0] == OBJECTIVE_OPTIMAL || result[0] == OBJECTIVE_UNBOUNDED, "lex 2: status");
+
+  yices_free_context(ctx);
+}
+
+
+/*
+ * The context is unchanged after optimization: the objective's
+ * definitions are removed, and the status is IDLE.
+ */
+static void test_context_state(void) {
+  context_t *ctx;
+  model_t *mdl;
+  term_t p, x, y, obj;
+  int32_t max;
+  objective_status_t result;
+  uint64_t nvars;
+
+  ctx = new_context("QF_LIA", "push-pop");
+  p = new_var(yices_bool_type());
+  x = new_var(yices_int_type());
+  y = new_var(yices_int_type());
+  yices_assert_formula(ctx, yices_arith_leq_atom(x, num(5)));
+  yices_assert_formula(ctx, yices_arith_leq_atom(y, num(8)));
+  yices_assert_formula(ctx, yices_arith_geq0_atom(x));
+  yices_assert_formula(ctx, yices_arith_geq0_atom(y));
+  check(yices_check_context(ctx, NULL) == STATUS_SAT, "state: check");
+  nvars = stat_value(ctx, "core.boolean-variables");
+
+  // the objective introduces new atoms and variables
+  obj = yices_ite(p, yices_add(x, num(1)), yices_mul(num(2), y));
+  max = 1;
+  mdl = NULL;
+  check(yices_optimize_context(ctx, NULL, 1, &obj, &max, &result, &mdl) == STATUS_SAT, "state: sat");
+  check(result == OBJECTIVE_OPTIMAL, "state: optimal");
+  check_rational_value(mdl, obj, 16, 1, "state: optimum");
+  yices_free_model(mdl);
+
+  check(yices_context_status(ctx) == STATUS_IDLE, "state: idle");
+  check(stat_value(ctx, "core.boolean-variables") == nvars, "state: definitions removed");
+
+  // the same objective again
+  mdl = NULL;
+  check(yices_optimize_context(ctx, NULL, 1, &obj, &max, &result, &mdl) == STATUS_SAT, "state: sat again");
+  check_rational_value(mdl, obj, 16, 1, "state: optimum again");
+  yices_free_model(mdl);
+
+  // unsat assertions
+  yices_push(ctx);
+  yices_assert_formula(ctx, yices_arith_gt_atom(x, num(5)));
+  check(yices_optimize_context(ctx, NULL, 1, &obj, &max, &result, NULL) == STATUS_UNSAT, "state: unsat");
+  check(yices_pop(ctx) == 0, "state: pop");
+  check(yices_check_context(ctx, NULL) == STATUS_SAT, "state: sat after pop");
+
+  yices_free_context(ctx);
+}
+
+
+/*
+ * Errors
+ */
+static void test_errors(void) {
+  context_t *ctx;
+  term_t x, p;
+  int32_t max;
+  objective_status_t result;
+
+  max = 1;
+  ctx = new_context("QF_LIA", "one-shot");
+  x = new_var(yices_int_type());
+  check(yices_optimize_context(ctx, NULL, 1, &x, &max, &result, NULL) == STATUS_ERROR, "one-shot: error");
+  check(yices_error_code() == CTX_OPERATION_NOT_SUPPORTED, "one-shot: error code");
+  yices_free_context(ctx);
+
+  ctx = new_context("QF_LIA", "push-pop");
+  p = new_var(yices_bool_type());
+  check(yices_optimize_context(ctx, NULL, 1, &p, &max, &result, NULL) == STATUS_ERROR, "bool: error");
+  check(yices_error_code() == ARITHTERM_REQUIRED, "bool: error code");
+  yices_free_context(ctx);
+}
+
+
+int main(void) {
+  yices_init();
+
+  test_real();
+  test_integer();
+  test_unbounded();
+  test_bitvector();
+  test_lexicographic();
+  test_context_state();
+  test_errors();
+
+  printf("All tests passed\n");
+  yices_exit();
+
+  return 0;
+}
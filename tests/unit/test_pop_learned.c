@@ -0,0 +1,178 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * TEST LEARNED CLAUSES KEPT ACROSS POP
+ *
+ * Random push/pop/check sequences on 3-SAT problems. The result of
+ * each check is compared with the result of a fresh context that
+ * contains the same assertions, and the models are checked.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+#include "yices.h"
+
+#define NVARS 80
+#define MAX_FORMULAS 10000
+#define MAX_LEVELS 40
+
+static term_t var[NVARS];
+
+// asserted formulas and start of each push level
+static term_t formula[MAX_FORMULAS];
+static uint32_t nformulas;
+static uint32_t level_start[MAX_LEVELS];
+static uint32_t nlevels;
+
+
+static void print_error(void) {
+  char *s;
+
+  s = yices_error_string();
+  fprintf(stderr, "Yices error: %s\n", s);
+  yices_free_string(s);
+  exit(1);
+}
+
+static term_t random_clause(uint32_t len) {
+  term_t a[3];
+  uint32_t i;
+
+  for (i=0; i<len; i++) {
+    a[i] = var[random() % NVARS];
+    if (random() & 1) a[i] = yices_not(a[i]);
+  }
+  return yices_or(len, a);
+}
+
+static void add_formula(context_t *ctx, term_t f) {
+  if (nformulas == MAX_FORMULAS) {
+    fprintf(stderr, "too many formulas\n");
+    exit(1);
+  }
+  if (yices_assert_formula(ctx, f) < 0) print_error();
+  formula[nformulas] = f;
+  nformulas ++;
+}
+
+/*
+ * Check ctx and compare with a fresh context
+ */
+static void check(context_t *ctx, const char *mode) {
+  ctx_config_t *config;
+  context_t *fresh;
+  smt_status_t s1, s2;
+  model_t *mdl;
+  uint32_t i;
+
+  s1 = yices_check_context(ctx, NULL);
+
+  config = yices_new_config();
+  yices_set_config(config, "mode", "one-shot");
+  fresh = yices_new_context(config);
+  yices_free_config(config);
+  if (yices_assert_formulas(fresh, nformulas, formula) < 0) print_error();
+  s2 = yices_check_context(fresh, NULL);
+  yices_free_context(fresh);
+
+  if (s1 != s2) {
+    printf("BUG (%s mode): status = %d, expected %d\n", mode, (int) s1, (int) s2);
+    exit(1);
+  }
+
+  if (s1 == STATUS_SAT) {
+    mdl = yices_get_model(ctx, true);
+    if (mdl == NULL) print_error();
+    for (i=0; i<nformulas; i++) {
+      if (yices_formula_true_in_model(mdl, formula[i]) != 1) {
+        printf("BUG (%s mode): incorrect model\n", mode);
+        exit(1);
+      }
+    }
+    yices_free_model(mdl);
+  }
+}
+
+static void test_sequence(uint32_t seed, const char *mode) {
+  ctx_config_t *config;
+  context_t *ctx;
+  uint32_t i, j, r;
+
+  srandom(seed);
+
+  config = yices_new_config();
+  yices_set_config(config, "mode", mode);
+  ctx = yices_new_context(config);
+  yices_free_config(config);
+
+  nformulas = 0;
+  nlevels = 0;
+  for (i=0; i<4*NVARS; i++) {
+    add_formula(ctx, random_clause(3));
+  }
+
+  for (i=0; i<120; i++) {
+    r = random() % 4;
+    if (yices_context_status(ctx) == STATUS_UNSAT) {
+      if (nlevels == 0) break;
+      r = 2;
+    }
+    if (r < 2 && nlevels < MAX_LEVELS) {
+      if (yices_push(ctx) < 0) print_error();
+      level_start[nlevels] = nformulas;
+      nlevels ++;
+      for (j = random() % 4; j>0; j--) {
+        add_formula(ctx, random_clause(1 + random() % 3));
+      }
+    } else if (r == 2 && nlevels > 0) {
+      if (yices_pop(ctx) < 0) print_error();
+      nlevels --;
+      nformulas = level_start[nlevels];
+    } else {
+      add_formula(ctx, random_clause(2 + random() % 2));
+    }
+    check(ctx, mode);
+  }
+
+  yices_free_context(ctx);
+}
+
+int main(void) {
+  uint32_t i, seed;
+
+  yices_init();
+  for (i=0; i<NVARS; i++) {
+    var[i] = yices_new_uninterpreted_term(yices_bool_type());
+  }
+
+  for (seed=1; seed<=10; seed++) {
+    test_sequence(seed, "push-pop");
+    test_sequence(seed, "interactive");
+    printf("seed %"PRIu32": ok\n", seed);
+    fflush(stdout);
+  }
+
+  yices_exit();
+  printf("all tests passed\n");
+
+  return 0;
+}
@@ -0,0 +1,266 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * TEST THE QUERY CACHE
+ *
+ * The results must be the same with and without the cache. The test
+ * can't see whether a result came from the cache, but it exercises
+ * the exact and subsumption paths and the operations that must
+ * invalidate a cached answer.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+#include "yices.h"
+
+static void check(bool cond, const char *msg) {
+  if (!cond) {
+    fprintf(stderr, "FAILED: %s\n", msg);
+    fflush(stderr);
+    exit(1);
+  }
+}
+
+/*
+ * Check the current model against formulas f[0 ... n-1]
+ */
+static void check_model(context_t *ctx, uint32_t n, const term_t *f, const char *msg) {
+  model_t *mdl;
+  uint32_t i;
+
+  mdl = yices_get_model(ctx, true);
+  check(mdl != NULL, msg);
+  for (i=0; i<n; i++) {
+    check(yices_formula_true_in_model(mdl, f[i]) == 1, msg);
+  }
+  yices_free_model(mdl);
+}
+
+/*
+ * Check f[0 ... n-1] in a new scope
+ */
+static smt_status_t check_scope(context_t *ctx, uint32_t n, const term_t *f) {
+  smt_status_t stat;
+
+  yices_push(ctx);
+  yices_assert_formulas(ctx, n, f);
+  stat = yices_check_context(ctx, NULL);
+  if (stat == STATUS_SAT) {
+    check_model(ctx, n, f, "model");
+  }
+  yices_pop(ctx);
+
+  return stat;
+}
+
+/*
+ * Exact hits and subsumption
+ * - a: x > 2, b: x < 10, c: y = x + 1, d: x < 1
+ */
+static void test_queries(void) {
+  context_t *ctx;
+  term_t x, y;
+  term_t a, b, c, d, f[4];
+
+  x = yices_new_uninterpreted_term(yices_int_type());
+  y = yices_new_uninterpreted_term(yices_int_type());
+  a = yices_arith_gt_atom(x, yices_int32(2));
+  b = yices_arith_lt_atom(x, yices_int32(10));
+  c = yices_arith_eq_atom(y, yices_add(x, yices_int32(1)));
+  d = yices_arith_lt_atom(x, yices_int32(1));
+
+  ctx = yices_new_context(NULL);
+  check(yices_context_enable_option(ctx, "query-cache") == 0, "enable query-cache");
+
+  // exact: the same query twice
+  f[0] = a; f[1] = b; f[2] = c;
+  check(check_scope(ctx, 3, f) == STATUS_SAT, "sat query");
+  check(check_scope(ctx, 3, f) == STATUS_SAT, "sat query (cached)");
+
+  // order and duplicates don't matter
+  f[0] = c; f[1] = a; f[2] = b; f[3] = a;
+  check(check_scope(ctx, 4, f) == STATUS_SAT, "permuted sat query");
+
+  // subset of a SAT query: SAT with the cached model
+  f[0] = a; f[1] = c;
+  check(check_scope(ctx, 2, f) == STATUS_SAT, "subset of a sat query");
+
+  // UNSAT then superset of an UNSAT query
+  f[0] = a; f[1] = d;
+  check(check_scope(ctx, 2, f) == STATUS_UNSAT, "unsat query");
+  f[2] = b; f[3] = c;
+  check(check_scope(ctx, 4, f) == STATUS_UNSAT, "superset of an unsat query");
+
+  // the assertions at level 0 are part of the key
+  yices_assert_formula(ctx, d);
+  f[0] = b;
+  check(check_scope(ctx, 1, f) == STATUS_SAT, "level 0 + b");
+  f[0] = a;
+  check(check_scope(ctx, 1, f) == STATUS_UNSAT, "level 0 + a");
+  check(yices_check_context(ctx, NULL) == STATUS_SAT, "level 0 only");
+  f[0] = d;
+  check_model(ctx, 1, f, "level 0 model");
+
+  yices_free_context(ctx);
+}
+
+/*
+ * Blocking clauses after a cached SAT result: they must apply to
+ * a real assignment and the cache must not be used while they're present.
+ * - (or p q): at most three models, all distinct
+ */
+static void test_blocking(void) {
+  context_t *ctx;
+  model_t *mdl;
+  term_t p, q, f;
+  smt_status_t stat;
+  uint32_t count, seen, k;
+
+  p = yices_new_uninterpreted_term(yices_bool_type());
+  q = yices_new_uninterpreted_term(yices_bool_type());
+  f = yices_or2(p, q);
+
+  ctx = yices_new_context(NULL);
+  check(yices_context_enable_option(ctx, "query-cache") == 0, "enable query-cache");
+  check(check_scope(ctx, 1, &f) == STATUS_SAT, "disjunction");
+
+  yices_push(ctx);
+  yices_assert_formula(ctx, f);
+  count = 0;
+  seen = 0;
+  for (;;) {
+    stat = yices_check_context(ctx, NULL);
+    if (stat != STATUS_SAT) break;
+    mdl = yices_get_model(ctx, true);
+    check(mdl != NULL && yices_formula_true_in_model(mdl, f) == 1, "model");
+    k = yices_formula_true_in_model(mdl, p) + 2 * yices_formula_true_in_model(mdl, q);
+    check((seen & (1 << k)) == 0, "duplicate model");
+    seen |= 1 << k;
+    yices_free_model(mdl);
+    count ++;
+    check(count <= 3, "too many models");
+    check(yices_assert_blocking_clause(ctx) == 0, "blocking clause");
+  }
+  check(stat == STATUS_UNSAT, "enumeration");
+  yices_pop(ctx);
+
+  // the blocking clauses are gone
+  check(check_scope(ctx, 1, &f) == STATUS_SAT, "disjunction after pop");
+
+  yices_free_context(ctx);
+}
+
+/*
+ * Function symbols
+ * - the cache must work when the term table contains function symbols,
+ *   whether they occur in the queries or not
+ * - a: f(x) > 2, b: x = y + 1, c: f(y) < f(x), d: f(x) = f(y)
+ */
+static void test_uf(void) {
+  context_t *ctx;
+  type_t tau;
+  term_t f, x, y, fx, fy;
+  term_t a, b, c, d, h[4];
+  uint64_t hits, subsumed, v;
+
+  tau = yices_function_type1(yices_int_type(), yices_int_type());
+  f = yices_new_uninterpreted_term(tau);
+  yices_new_uninterpreted_term(tau); // never used
+  x = yices_new_uninterpreted_term(yices_int_type());
+  y = yices_new_uninterpreted_term(yices_int_type());
+  fx = yices_application1(f, x);
+  fy = yices_application1(f, y);
+  a = yices_arith_gt_atom(fx, yices_int32(2));
+  b = yices_arith_eq_atom(x, yices_add(y, yices_int32(1)));
+  c = yices_arith_lt_atom(fy, fx);
+  d = yices_arith_eq_atom(fx, fy);
+
+  ctx = yices_new_context(NULL);
+  check(yices_context_enable_option(ctx, "query-cache") == 0, "enable query-cache");
+
+  // queries on x and y only must still be cached
+  h[0] = b;
+  h[1] = yices_arith_gt_atom(y, yices_int32(4));
+  check(check_scope(ctx, 2, h) == STATUS_SAT, "arith query");
+  check(check_scope(ctx, 2, h) == STATUS_SAT, "arith query (cached)");
+  check(yices_get_statistic(ctx, "cache.hits", &hits) == 0 && hits == 1, "arith query: hit");
+
+  // f in the query: the model is recomputed by check_scope
+  h[0] = a; h[1] = b; h[2] = c;
+  check(check_scope(ctx, 3, h) == STATUS_SAT, "uf query");
+  check(check_scope(ctx, 3, h) == STATUS_SAT, "uf query (cached)");
+  check(yices_get_statistic(ctx, "cache.hits", &v) == 0 && v == hits + 1, "uf query: hit");
+
+  // subset of the previous query
+  check(yices_get_statistic(ctx, "cache.subsumed", &subsumed) == 0, "cache.subsumed");
+  check(check_scope(ctx, 2, h) == STATUS_SAT, "uf subset");
+  check(yices_get_statistic(ctx, "cache.subsumed", &v) == 0 && v == subsumed + 1, "uf subset: subsumed");
+
+  // x = y + 1 and f(x) = f(y) is sat, but not with f(y) < f(x)
+  h[0] = b; h[1] = d;
+  check(check_scope(ctx, 2, h) == STATUS_SAT, "uf query 2");
+  h[2] = c;
+  check(check_scope(ctx, 3, h) == STATUS_UNSAT, "uf unsat query");
+  h[3] = a;
+  check(check_scope(ctx, 4, h) == STATUS_UNSAT, "uf superset of an unsat query");
+
+  yices_free_context(ctx);
+}
+
+/*
+ * Cached terms survive garbage collection
+ */
+static void test_gc(void) {
+  context_t *ctx;
+  term_t p, q, f[2];
+
+  p = yices_new_uninterpreted_term(yices_bool_type());
+  q = yices_new_uninterpreted_term(yices_bool_type());
+  f[0] = yices_or2(p, q);
+  f[1] = yices_not(p);
+
+  ctx = yices_new_context(NULL);
+  check(yices_context_enable_option(ctx, "query-cache") == 0, "enable query-cache");
+  check(check_scope(ctx, 2, f) == STATUS_SAT, "bool query");
+  yices_garbage_collect(f, 2, NULL, 0, false);
+  check(check_scope(ctx, 2, f) == STATUS_SAT, "bool query after gc");
+
+  // disabling the cache
+  check(yices_context_disable_option(ctx, "query-cache") == 0, "disable query-cache");
+  check(check_scope(ctx, 2, f) == STATUS_SAT, "bool query without cache");
+
+  yices_free_context(ctx);
+}
+
+int main(void) {
+  yices_init();
+
+  test_queries();
+  test_blocking();
+  test_uf();
+  test_gc();
+
+  printf("All tests passed\n");
+  yices_exit();
+
+  return 0;
+}
@@ -0,0 +1,144 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Test of the ProbSAT walker on random 3-SAT problems with a
+ * planted solution.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <stdbool.h>
+
+#include "solvers/cdcl/sls_walker.h"
+#include "utils/memalloc.h"
+
+
+#define NVARS 200
+#define NCLAUSES 800
+
+
+static int32_t clause[NCLAUSES][3];
+static uint8_t planted[NVARS];
+
+
+/*
+ * Random clause that's true in the planted assignment
+ */
+static void random_clause(int32_t *a) {
+  uint32_t i, x, s;
+  bool sat;
+
+  do {
+    sat = false;
+    for (i=0; i<3; i++) {
+      x = random() % NVARS;
+      s = random() & 1;
+      a[i] = (x << 1) | s;
+      sat |= (planted[x] ^ s) != 0;
+    }
+  } while (!sat);
+}
+
+/*
+ * Number of false clauses in the walker's best assignment
+ */
+static uint32_t num_false_clauses(sls_walker_t *w) {
+  uint32_t i, j, n;
+  int32_t l;
+  bool sat;
+
+  n = 0;
+  for (i=0; i<NCLAUSES; i++) {
+    sat = false;
+    for (j=0; j<3; j++) {
+      l = clause[i][j];
+      sat |= (sls_walker_best_value(w, l >> 1) ^ (l & 1)) != 0;
+    }
+    n += !sat;
+  }
+  return n;
+}
+
+static void test_planted(uint32_t seed) {
+  sls_walker_t w;
+  uint32_t i, r;
+
+  srandom(seed);
+  for (i=0; i<NVARS; i++) {
+    planted[i] = random() & 1;
+  }
+  for (i=0; i<NCLAUSES; i++) {
+    random_clause(clause[i]);
+  }
+
+  init_sls_walker(&w, NVARS);
+  sls_walker_set_seed(&w, seed);
+  for (i=0; i<NCLAUSES; i++) {
+    sls_walker_add_clause(&w, 3, clause[i]);
+  }
+  r = sls_walk(&w, 1000000);
+  printf("seed %"PRIu32": %"PRIu32" false clauses after %"PRIu64" flips\n", seed, r, w.flips);
+  if (r != num_false_clauses(&w)) {
+    printf("BUG: incorrect best assignment\n");
+    exit(1);
+  }
+  if (r != 0) {
+    printf("BUG: failed to find a model\n");
+    exit(1);
+  }
+  delete_sls_walker(&w);
+}
+
+/*
+ * Unsatisfiable problem: (x0 or x1) (not x0) (not x1)
+ */
+static void test_unsat(void) {
+  sls_walker_t w;
+  int32_t a[2];
+  uint32_t r;
+
+  init_sls_walker(&w, 2);
+  a[0] = 0; a[1] = 2;
+  sls_walker_add_clause(&w, 2, a);
+  a[0] = 1;
+  sls_walker_add_clause(&w, 1, a);
+  a[0] = 3;
+  sls_walker_add_clause(&w, 1, a);
+  r = sls_walk(&w, 1000);
+  printf("unsat problem: %"PRIu32" false clauses after %"PRIu64" flips\n", r, w.flips);
+  if (r != 1 || w.flips != 1000) {
+    printf("BUG: unexpected result\n");
+    exit(1);
+  }
+  delete_sls_walker(&w);
+}
+
+int main(void) {
+  uint32_t i;
+
+  for (i=1; i<=20; i++) {
+    test_planted(i);
+  }
+  test_unsat();
+  printf("all tests passed\n");
+
+  return 0;
+}
@@ -0,0 +1,288 @@
+/*
+ * This file is part of the Yices SMT Solver.
+ * Copyright (C) 2017 SRI International.
+ *
+ * Yices is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Yices is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Yices.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Decoder for the binary event traces written by yices_dump_event_trace
+ * or by 'yices_smt2 --event-trace=<file>'.
+ *
+ * Usage: decode_events [-s] <filename>
+ *
+ * Prints one line per event, then a summary. With option -s, only
+ * the summary is printed.
+ *
+ * Compile with: gcc -O2 -o decode_events decode_events.c
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+/*
+ * We try to make this self-contained and independent of
+ * the rest of the source. The following definitions must
+ * match src/utils/event_trace.h.
+ */
+typedef struct etrace_event_s {
+  uint64_t time;
+  uint64_t stamp;
+  uint32_t arg32;
+  uint16_t arg16;
+  uint8_t arg8;
+  uint8_t kind;
+} etrace_event_t;
+
+typedef struct etrace_header_s {
+  char magic[4];
+  uint32_t version;
+  uint32_t event_size;
+  uint32_t clock;
+  uint32_t capacity;
+  uint32_t nevents;
+  uint64_t total;
+} etrace_header_t;
+
+#define ETRACE_MAGIC "YEVT"
+#define ETRACE_VERSION 1
+
+enum {
+  ETRACE_START_SEARCH,
+  ETRACE_END_SEARCH,
+  ETRACE_RESTART,
+  ETRACE_REDUCE,
+  ETRACE_SIMPLIFY,
+  ETRACE_CONFLICT,
+  ETRACE_TH_CONFLICT,
+  ETRACE_FINAL_CHECK,
+  ETRACE_GC,
+  NUM_ETRACE_KINDS,
+};
+
+static const char * const kind_name[NUM_ETRACE_KINDS] = {
+  "start-search",
+  "end-search",
+  "restart",
+  "reduce",
+  "simplify",
+  "conflict",
+  "theory-conflict",
+  "final-check",
+  "gc",
+};
+
+#define NUM_SOLVERS 5
+
+static const char * const solver_name[NUM_SOLVERS] = {
+  "egraph", "simplex", "idl", "rdl", "bv",
+};
+
+// smt_status_t in yices_types.h
+#define NUM_STATUS 7
+
+static const char * const status_name[NUM_STATUS] = {
+  "idle", "searching", "unknown", "sat", "unsat", "interrupted", "error",
+};
+
+// fcheck_code_t in smt_core.h
+#define NUM_FCHECK_CODES 3
+
+static const char * const fcheck_name[NUM_FCHECK_CODES] = {
+  "continue", "sat", "unknown",
+};
+
+static const char *name_of(const char * const *names, uint32_t n, uint32_t i) {
+  return i < n ? names[i] : "???";
+}
+
+
+/*
+ * Summary
+ * - number of events of each kind
+ * - number of theory conflicts per solver and their total size
+ * - total LBD and size of the learned clauses
+ */
+typedef struct summary_s {
+  uint64_t count[NUM_ETRACE_KINDS];
+  uint64_t th_count[NUM_SOLVERS];
+  uint64_t th_size[NUM_SOLVERS];
+  uint64_t lbd;
+  uint64_t size;
+} summary_t;
+
+
+/*
+ * Print event e
+ * - t0 = time of the first event
+ */
+static void print_event(FILE *f, uint32_t i, const etrace_event_t *e, uint64_t t0) {
+  fprintf(f, "%8"PRIu32" %14"PRIu64" %10"PRIu64"  %-16s", i, e->time - t0, e->stamp,
+	  name_of(kind_name, NUM_ETRACE_KINDS, e->kind));
+
+  switch (e->kind) {
+  case ETRACE_START_SEARCH:
+    fprintf(f, "vars=%"PRIu32, e->arg32);
+    break;
+  case ETRACE_END_SEARCH:
+    fprintf(f, "status=%s", name_of(status_name, NUM_STATUS, e->arg8));
+    break;
+  case ETRACE_RESTART:
+    fprintf(f, "level=%"PRIu32, e->arg32);
+    break;
+  case ETRACE_REDUCE:
+    fprintf(f, "learned=%"PRIu32, e->arg32);
+    break;
+  case ETRACE_SIMPLIFY:
+    fprintf(f, "clauses=%"PRIu32, e->arg32);
+    break;
+  case ETRACE_CONFLICT:
+    fprintf(f, "lbd=%"PRIu16" size=%"PRIu32, e->arg16, e->arg32);
+    break;
+  case ETRACE_TH_CONFLICT:
+    fprintf(f, "solver=%s size=%"PRIu32, name_of(solver_name, NUM_SOLVERS, e->arg8), e->arg32);
+    break;
+  case ETRACE_FINAL_CHECK:
+    fprintf(f, "result=%s", name_of(fcheck_name, NUM_FCHECK_CODES, e->arg8));
+    break;
+  case ETRACE_GC:
+    fprintf(f, "removed-vars=%"PRIu32, e->arg32);
+    break;
+  default:
+    break;
+  }
+  fprintf(f, "\n");
+}
+
+static void add_to_summary(summary_t *s, const etrace_event_t *e) {
+  if (e->kind < NUM_ETRACE_KINDS) {
+    s->count[e->kind] ++;
+    if (e->kind == ETRACE_CONFLICT) {
+      s->lbd += e->arg16;
+      s->size += e->arg32;
+    } else if (e->kind == ETRACE_TH_CONFLICT && e->arg8 < NUM_SOLVERS) {
+      s->th_count[e->arg8] ++;
+      s->th_size[e->arg8] += e->arg32;
+    }
+  }
+}
+
+static void print_summary(FILE *f, const summary_t *s, const etrace_header_t *h, uint64_t elapsed) {
+  uint32_t i;
+
+  fprintf(f, "\nevents: %"PRIu32" (of %"PRIu64" logged, buffer size = %"PRIu32")\n",
+	  h->nevents, h->total, h->capacity);
+  fprintf(f, "elapsed: %"PRIu64" %s\n", elapsed, h->clock == 0 ? "cycles" : "ns");
+  for (i=0; i<NUM_ETRACE_KINDS; i++) {
+    if (s->count[i] > 0) {
+      fprintf(f, "  %-16s %12"PRIu64"\n", kind_name[i], s->count[i]);
+    }
+  }
+  if (s->count[ETRACE_CONFLICT] > 0) {
+    fprintf(f, "learned clauses: mean lbd = %.2f, mean size = %.2f\n",
+	    (double) s->lbd/s->count[ETRACE_CONFLICT], (double) s->size/s->count[ETRACE_CONFLICT]);
+  }
+  for (i=0; i<NUM_SOLVERS; i++) {
+    if (s->th_count[i] > 0) {
+      fprintf(f, "theory conflicts (%s): %"PRIu64", mean size = %.2f\n",
+	      solver_name[i], s->th_count[i], (double) s->th_size[i]/s->th_count[i]);
+    }
+  }
+}
+
+
+/*
+ * Read and print all events from f
+ * - return true if no error was detected
+ */
+static bool decode(FILE *f, bool summary_only) {
+  etrace_header_t header;
+  etrace_event_t e;
+  summary_t summary;
+  uint64_t t0, t;
+  uint32_t i;
+
+  if (fread(&header, sizeof(header), 1, f) != 1) {
+    fprintf(stderr, "Failed to read the header\n");
+    return false;
+  }
+  if (memcmp(header.magic, ETRACE_MAGIC, 4) != 0) {
+    fprintf(stderr, "Not an event trace (bad magic number)\n");
+    return false;
+  }
+  if (header.version != ETRACE_VERSION || header.event_size != sizeof(etrace_event_t)) {
+    fprintf(stderr, "Unsupported format (version %"PRIu32", event size %"PRIu32")\n",
+	    header.version, header.event_size);
+    return false;
+  }
+
+  memset(&summary, 0, sizeof(summary));
+  t0 = 0;
+  t = 0;
+
+  if (! summary_only) {
+    printf("%8s %14s %10s  %-16s%s\n", "event", header.clock == 0 ? "cycles" : "ns", "conflicts", "kind", "data");
+  }
+
+  for (i=0; i<header.nevents; i++) {
+    if (fread(&e, sizeof(e), 1, f) != 1) {
+      fprintf(stderr, "Missing events: file may be truncated\n");
+      return false;
+    }
+    if (i == 0) t0 = e.time;
+    t = e.time;
+    if (! summary_only) {
+      print_event(stdout, i, &e, t0);
+    }
+    add_to_summary(&summary, &e);
+  }
+
+  print_summary(stdout, &summary, &header, t - t0);
+
+  return true;
+}
+
+
+int main(int argc, char *argv[]) {
+  FILE *f;
+  const char *filename;
+  bool summary_only;
+  bool ok;
+
+  summary_only = false;
+  if (argc == 3 && strcmp(argv[1], "-s") == 0) {
+    summary_only = true;
+    filename = argv[2];
+  } else if (argc == 2) {
+    filename = argv[1];
+  } else {
+    fprintf(stderr, "Usage: %s [-s] <filename>\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  f = fopen(filename, "rb");
+  if (f == NULL) {
+    perror(filename);
+    return EXIT_FAILURE;
+  }
+
+  ok = decode(f, summary_only);
+  fclose(f);
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}